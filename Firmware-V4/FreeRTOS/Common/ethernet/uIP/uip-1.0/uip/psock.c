@@ -213,6 +213,20 @@ PT_THREAD(psock_send(register struct psock *s, const char *buf,
   PT_END(&s->psockpt);
 }
 /*---------------------------------------------------------------------------*/
+static char
+generate_again(register struct psock *s,
+	       unsigned short (*generate)(void *), void *arg)
+{
+  /* A retransmission resumes the protothread inside the wait below and
+     may come with another frame buffer than the one the data was first
+     generated in, so the data is generated again where it is sent from. */
+  if(uip_rexmit()) {
+    generate(arg);
+    s->sendptr = uip_appdata;
+  }
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
 PT_THREAD(psock_generator_send(register struct psock *s,
 			       unsigned short (*generate)(void *), void *arg))
 {
@@ -230,13 +244,10 @@ PT_THREAD(psock_generator_send(register struct psock *s,
 
   s->state = STATE_NONE;  
   do {
-    /* Call the generator function again if we are called to perform a
-       retransmission. */
-    if(uip_rexmit()) {
-      generate(arg);
-    }
     /* Wait until all data is sent and acknowledged. */
-    PT_WAIT_UNTIL(&s->psockpt, data_acked(s) & send_data(s));
+    PT_WAIT_UNTIL(&s->psockpt,
+		  (generate_again(s, generate, arg),
+		   data_acked(s) & send_data(s)));
   } while(s->sendlen > 0);
   
   s->state = STATE_NONE;
@@ -132,6 +132,9 @@ NVIC value of 255. */
 #define configNET_MASK2		255
 #define configNET_MASK3		0
 
+/* Reported to the discovery service. */
+#define configFW_VERSION	"0.1"
+
 
 /*-----------------------------------------------------------
  * Macros required to setup the timer for the run time stats.
@@ -0,0 +1,113 @@
+#include <math.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "dev_parser.h"
+
+//-------------------------------------------------------------------------
+enum { VMETER_WAIT_HEAD=0, VMETER_BODY };
+
+void vmeter_parser_init(VMETER_PARSER* p)
+{
+	memset(p,0,sizeof(VMETER_PARSER));
+}
+
+//one field is mantissa digit, tenth digit, exponent sign, exponent digit,
+//'?' or '-' in place of a digit means the gauge has no reading
+static int32_t vmeter_decode(const uint8_t* f,float* v)
+{
+	if ( f[0] < '0' || f[0] > '9' || f[1] < '0' || f[1] > '9' || f[3] < '0' || f[3] > '9' )
+		return -1;
+
+	*v = (f[0] - '0') + (float)(f[1] - '0')/10;
+	if ( f[2] == '+' )
+		*v *= pow(10,(f[3]-'0'));
+	else if ( f[2] == '-' )
+		*v *= pow(10,-(f[3]-'0'));
+	return 0;
+}
+
+int32_t vmeter_parse(VMETER_PARSER* p,uint8_t ch,VMETER_EVENT* ev)
+{
+	//the head never shows up inside a body, so it always starts a new frame
+	if ( ch == VMETER_HEAD ){
+		p->state = VMETER_BODY;
+		p->pos = 0;
+		return PARSE_NONE;
+	}
+	if ( p->state != VMETER_BODY )
+		return PARSE_NONE;
+
+	p->body[p->pos++] = ch;
+	if ( p->pos < VMETER_BODY_LEN )
+		return PARSE_NONE;
+	p->state = VMETER_WAIT_HEAD;
+
+	//as long as the ion gauge reads, its value wins
+	if ( p->body[4+1] != '-' && vmeter_decode(p->body+4,&ev->pressure) == 0 ){
+		ev->source = VMETER_SRC_ION;
+	} else if ( vmeter_decode(p->body,&ev->pressure) == 0 ){
+		ev->source = VMETER_SRC_PIRANI;
+	} else {
+		p->errors++;
+		return PARSE_ERROR;
+	}
+	p->frames++;
+	return PARSE_EVENT;
+}
+
+//-------------------------------------------------------------------------
+enum { MPUMP_WAIT_HEAD=0, MPUMP_CMD, MPUMP_LEN, MPUMP_DATA, MPUMP_XOR };
+
+void mpump_parser_init(MPUMP_PARSER* p)
+{
+	memset(p,0,sizeof(MPUMP_PARSER));
+}
+
+int32_t mpump_parse(MPUMP_PARSER* p,uint8_t ch,MPUMP_EVENT* ev)
+{
+	switch ( p->state ){
+	case MPUMP_WAIT_HEAD:
+		if ( ch == FD110A_FRAME_HEAD )
+			p->state = MPUMP_CMD;
+		break;
+	case MPUMP_CMD:
+		//replies to other commands are skipped, a head byte restarts the match
+		if ( ch == FD110A_STATUS_CMD ){
+			p->xor = ch;
+			p->state = MPUMP_LEN;
+		} else if ( ch != FD110A_FRAME_HEAD )
+			p->state = MPUMP_WAIT_HEAD;
+		break;
+	case MPUMP_LEN:
+		if ( ch == FD110A_STATUS_LEN ){
+			p->xor ^= ch;
+			p->pos = 0;
+			p->state = MPUMP_DATA;
+		} else 
+			p->state = ( ch == FD110A_FRAME_HEAD ) ? MPUMP_CMD : MPUMP_WAIT_HEAD;
+		break;
+	case MPUMP_DATA:
+		p->xor ^= ch;
+		p->data[p->pos++] = ch;
+		if ( p->pos >= FD110A_STATUS_LEN )
+			p->state = MPUMP_XOR;
+		break;
+	case MPUMP_XOR:
+		p->state = MPUMP_WAIT_HEAD;
+		if ( ch != p->xor ){
+			p->errors++;
+			return PARSE_ERROR;
+		}
+		ev->st 		= p->data[0];
+		ev->freq 	= p->data[1]*100 + p->data[2];
+		ev->vol 	= p->data[3]*100 + p->data[4];
+		ev->cur 	= p->data[5]*100 + p->data[6];
+		p->frames++;
+		return PARSE_EVENT;
+	default:
+		p->state = MPUMP_WAIT_HEAD;
+		break;
+	}
+	return PARSE_NONE;
+}
@@ -0,0 +1,66 @@
+#ifndef __DEV_PARSER_H__
+#define __DEV_PARSER_H__
+
+#include "stdint.h"
+
+//-------------------------------------------------------------------------
+//byte-at-a-time frame parsers for the serial devices, a frame is decoded
+//the moment its last byte arrives, no rescanning of old bytes
+
+#define PARSE_NONE		0		//need more bytes
+#define PARSE_EVENT		1		//a frame was decoded into the event
+#define PARSE_ERROR		-1		//a frame was dropped, bad checksum or content
+
+//vacuum gauge, '*' followed by two 4 char fields "MDsE", pirani then ion gauge
+#define VMETER_HEAD			0x2A
+#define VMETER_BODY_LEN		8
+
+#define VMETER_SRC_PIRANI	0
+#define VMETER_SRC_ION		1
+
+typedef struct
+{
+	float pressure;
+	uint8_t source;
+} VMETER_EVENT;
+
+typedef struct
+{
+	uint8_t state;
+	uint8_t pos;
+	uint8_t body[VMETER_BODY_LEN];
+	uint32_t frames;
+	uint32_t errors;
+} VMETER_PARSER;
+
+//FD110A status, 0xAB 0x91 0x07 st f1 f0 v1 v0 c1 c0 xor, xor over cmd..data
+#define FD110A_FRAME_HEAD			0xAB
+#define FD110A_STATUS_CMD	0x91
+#define FD110A_STATUS_LEN	0x07
+
+typedef struct
+{
+	uint8_t st;
+	uint16_t freq;
+	uint16_t vol;
+	uint16_t cur;
+} MPUMP_EVENT;
+
+typedef struct
+{
+	uint8_t state;
+	uint8_t pos;
+	uint8_t xor;
+	uint8_t data[FD110A_STATUS_LEN];
+	uint32_t frames;
+	uint32_t errors;
+} MPUMP_PARSER;
+
+//-------------------------------------------------------------------------
+void vmeter_parser_init(VMETER_PARSER* p);
+int32_t vmeter_parse(VMETER_PARSER* p,uint8_t ch,VMETER_EVENT* ev);
+
+void mpump_parser_init(MPUMP_PARSER* p);
+int32_t mpump_parse(MPUMP_PARSER* p,uint8_t ch,MPUMP_EVENT* ev);
+
+#endif
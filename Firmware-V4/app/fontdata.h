@@ -0,0 +1,1155 @@
+/* Generated by makefont from the ascii*.h and hzk*.h font tables, do not edit. */
+
+static const uint16_t Ascii08x16_Offset[] = {
+	0,2,14,27,46,75,104,134,143,159,
+	175,195,207,215,220,227,249,265,277,298,
+	322,346,369,393,409,431,455,467,477,498,
+	507,528,550,578,603,625,644,660,685,707,
+	730,748,758,769,798,811,830,857,873,889,
+	912,936,959,973,985,1010,1035,1059,1078,1101,
+	1108,1128,1135,1142,1145,1151,1168,1191,1206,1227,
+	1244,1260,1278,1298,1313,1329,1355,1365,1378,1393,
+	1404,1422,1439,1453,1470,1483,1498,1516,1538,1555,
+	1574,1591,1602,1605,1617,
+};
+
+static const uint8_t Ascii08x16_Rle[] = {
+	0x80,0x0e,0x80,0x01,0x31,0x40,0x05,0x80,0x00,0x32,0x30,0x00,0x80,0x00,0x83,0x12,
+	0x11,0x22,0x12,0x12,0x12,0x12,0x11,0x21,0x38,0x00,0x90,0x80,0x01,0x21,0x21,0x20,
+	0x01,0x07,0x11,0x12,0x13,0x00,0x10,0x71,0x11,0x21,0x30,0x01,0x80,0x00,0x80,0x00,
+	0x31,0x42,0x33,0x11,0x11,0x11,0x20,0x00,0x11,0x11,0x42,0x24,0x32,0x33,0x11,0x12,
+	0x00,0x01,0x11,0x11,0x12,0x00,0x02,0x33,0x31,0x40,0x00,0x80,0x01,0x11,0x31,0x20,
+	0x11,0x12,0x12,0x01,0x11,0x11,0x30,0x01,0x11,0x11,0x11,0x23,0x21,0x11,0x21,0x11,
+	0x11,0x10,0x01,0x11,0x31,0x28,0x00,0x00,0x80,0x01,0x22,0x41,0x12,0x13,0x00,0x11,
+	0x11,0x14,0x12,0x13,0x10,0x11,0x12,0x12,0x01,0x21,0x11,0x20,0x13,0x13,0x01,0x31,
+	0x21,0x13,0x12,0x18,0x00,0x00,0x81,0x25,0x00,0x02,0x15,0x02,0x68,0x00,0x90,0x86,
+	0x11,0x51,0x24,0x13,0x00,0x03,0x14,0x00,0x44,0x13,0x00,0x05,0x12,0x61,0x18,0x81,
+	0x16,0x21,0x53,0x14,0x00,0x04,0x13,0x00,0x43,0x14,0x00,0x02,0x15,0x11,0x68,0x80,
+	0x02,0x31,0x40,0x00,0x02,0x11,0x12,0x12,0x33,0x00,0x00,0x21,0x11,0x21,0x31,0x40,
+	0x00,0x80,0x02,0x80,0x02,0x31,0x40,0x02,0x07,0x13,0x14,0x00,0x28,0x00,0x10,0x80,
+	0x0a,0x12,0x50,0x00,0x21,0x50,0x26,0x80,0x06,0x17,0x80,0x05,0x80,0x0a,0x12,0x50,
+	0x00,0x80,0x00,0x80,0x00,0x71,0x61,0x10,0x00,0x51,0x20,0x00,0x41,0x30,0x00,0x31,
+	0x40,0x00,0x21,0x50,0x00,0x11,0x60,0x00,0x80,0x80,0x01,0x32,0x32,0x12,0x12,0x11,
+	0x41,0x10,0x05,0x21,0x21,0x23,0x23,0x80,0x00,0x80,0x01,0x31,0x41,0x34,0x31,0x40,
+	0x06,0x15,0x28,0x00,0x00,0x80,0x01,0x24,0x21,0x14,0x11,0x00,0x15,0x12,0x00,0x04,
+	0x13,0x31,0x42,0x15,0x11,0x41,0x11,0x61,0x80,0x00,0x80,0x01,0x24,0x21,0x14,0x11,
+	0x00,0x05,0x12,0x32,0x35,0x12,0x61,0x10,0x00,0x11,0x41,0x11,0x13,0x12,0x23,0x38,
+	0x00,0x00,0x80,0x01,0x51,0x24,0x22,0x31,0x11,0x22,0x12,0x12,0x00,0x01,0x13,0x12,
+	0x00,0x01,0x61,0x51,0x20,0x00,0x34,0x18,0x00,0x00,0x80,0x01,0x16,0x11,0x16,0x00,
+	0x11,0x11,0x23,0x12,0x21,0x26,0x11,0x00,0x01,0x14,0x11,0x11,0x31,0x22,0x33,0x80,
+	0x00,0x80,0x01,0x33,0x22,0x12,0x12,0x11,0x60,0x00,0x11,0x12,0x31,0x22,0x12,0x11,
+	0x41,0x10,0x01,0x21,0x21,0x23,0x23,0x80,0x00,0x80,0x01,0x16,0x11,0x13,0x12,0x00,
+	0x04,0x13,0x00,0x03,0x14,0x00,0x48,0x00,0x00,0x80,0x01,0x24,0x21,0x14,0x11,0x00,
+	0x12,0x12,0x12,0x32,0x32,0x12,0x12,0x11,0x41,0x10,0x01,0x24,0x28,0x00,0x00,0x80,
+	0x01,0x32,0x32,0x12,0x12,0x11,0x41,0x10,0x01,0x21,0x22,0x13,0x21,0x11,0x61,0x10,
+	0x00,0x21,0x21,0x22,0x33,0x80,0x00,0x80,0x04,0x32,0x30,0x00,0x80,0x02,0x32,0x30,
+	0x00,0x80,0x00,0x80,0x05,0x31,0x48,0x00,0x33,0x14,0x00,0x02,0x15,0x80,0x01,0x61,
+	0x15,0x12,0x41,0x33,0x14,0x21,0x51,0x16,0x21,0x53,0x14,0x41,0x35,0x12,0x61,0x18,
+	0x00,0x00,0x80,0x04,0x07,0x18,0x00,0x10,0x71,0x80,0x03,0x80,0x01,0x11,0x62,0x15,
+	0x31,0x44,0x13,0x51,0x26,0x11,0x51,0x24,0x13,0x31,0x42,0x15,0x11,0x68,0x00,0x00,
+	0x80,0x01,0x24,0x21,0x14,0x11,0x00,0x01,0x23,0x11,0x61,0x15,0x12,0x41,0x30,0x00,
+	0x83,0x23,0x00,0x08,0x00,0x00,0x80,0x01,0x23,0x31,0x13,0x12,0x11,0x12,0x11,0x10,
+	0x11,0x11,0x11,0x11,0x00,0x20,0x11,0x21,0x12,0x11,0x41,0x11,0x13,0x12,0x23,0x38,
+	0x00,0x00,0x80,0x01,0x31,0x40,0x00,0x32,0x32,0x11,0x13,0x00,0x02,0x12,0x12,0x24,
+	0x21,0x13,0x12,0x11,0x41,0x10,0x00,0x03,0x23,0x80,0x00,0x80,0x01,0x05,0x31,0x13,
+	0x12,0x00,0x11,0x43,0x11,0x31,0x21,0x14,0x11,0x00,0x11,0x13,0x12,0x05,0x38,0x00,
+	0x00,0x80,0x01,0x25,0x11,0x14,0x11,0x00,0x00,0x17,0x00,0x31,0x14,0x11,0x11,0x31,
+	0x22,0x33,0x80,0x00,0x80,0x01,0x05,0x31,0x13,0x12,0x11,0x41,0x10,0x05,0x11,0x31,
+	0x20,0x53,0x80,0x00,0x80,0x01,0x06,0x21,0x14,0x11,0x11,0x21,0x30,0x00,0x14,0x31,
+	0x12,0x13,0x00,0x01,0x16,0x11,0x41,0x10,0x00,0x06,0x28,0x00,0x00,0x80,0x01,0x06,
+	0x21,0x14,0x11,0x11,0x21,0x30,0x00,0x14,0x31,0x12,0x13,0x00,0x01,0x16,0x00,0x10,
+	0x35,0x80,0x00,0x80,0x01,0x24,0x21,0x13,0x12,0x00,0x00,0x17,0x00,0x10,0x13,0x31,
+	0x01,0x41,0x21,0x13,0x12,0x00,0x02,0x33,0x80,0x00,0x80,0x01,0x03,0x23,0x11,0x41,
+	0x10,0x02,0x16,0x11,0x14,0x11,0x00,0x20,0x32,0x38,0x00,0x00,0x80,0x01,0x15,0x23,
+	0x14,0x00,0x71,0x52,0x80,0x00,0x80,0x01,0x25,0x14,0x13,0x00,0x80,0x13,0x13,0x04,
+	0x40,0x80,0x01,0x03,0x13,0x11,0x13,0x12,0x11,0x21,0x31,0x11,0x14,0x13,0x41,0x11,
+	0x14,0x11,0x21,0x30,0x00,0x11,0x31,0x20,0x00,0x03,0x13,0x18,0x00,0x00,0x80,0x01,
+	0x03,0x51,0x16,0x00,0x61,0x14,0x11,0x07,0x18,0x00,0x00,0x80,0x01,0x03,0x13,0x11,
+	0x21,0x22,0x00,0x21,0x11,0x11,0x12,0x00,0x30,0x21,0x11,0x21,0x80,0x00,0x80,0x01,
+	0x02,0x33,0x12,0x31,0x10,0x00,0x11,0x11,0x21,0x10,0x00,0x11,0x21,0x11,0x10,0x01,
+	0x11,0x32,0x10,0x00,0x03,0x31,0x18,0x00,0x00,0x80,0x01,0x23,0x31,0x13,0x12,0x01,
+	0x51,0x10,0x05,0x11,0x31,0x22,0x33,0x80,0x00,0x80,0x01,0x06,0x21,0x14,0x11,0x00,
+	0x21,0x52,0x11,0x60,0x02,0x03,0x58,0x00,0x00,0x80,0x01,0x23,0x31,0x13,0x12,0x01,
+	0x51,0x10,0x03,0x01,0x12,0x21,0x10,0x22,0x11,0x11,0x11,0x22,0x22,0x33,0x52,0x18,
+	0x80,0x01,0x06,0x21,0x14,0x11,0x00,0x11,0x52,0x11,0x21,0x30,0x00,0x11,0x31,0x20,
+	0x00,0x11,0x41,0x10,0x33,0x28,0x00,0x00,0x80,0x01,0x25,0x11,0x14,0x11,0x00,0x01,
+	0x16,0x21,0x53,0x23,0x51,0x26,0x11,0x11,0x41,0x10,0x00,0x15,0x28,0x00,0x00,0x80,
+	0x01,0x07,0x10,0x12,0x12,0x11,0x31,0x40,0x06,0x23,0x38,0x00,0x00,0x80,0x01,0x03,
+	0x23,0x11,0x41,0x10,0x07,0x24,0x28,0x00,0x00,0x80,0x01,0x03,0x23,0x11,0x41,0x10,
+	0x00,0x11,0x31,0x22,0x12,0x12,0x00,0x02,0x11,0x13,0x00,0x03,0x23,0x31,0x40,0x00,
+	0x80,0x00,0x80,0x01,0x02,0x11,0x12,0x10,0x12,0x12,0x11,0x00,0x20,0x11,0x11,0x11,
+	0x11,0x00,0x01,0x21,0x22,0x11,0x31,0x20,0x01,0x80,0x00,0x80,0x01,0x03,0x23,0x11,
+	0x41,0x12,0x12,0x12,0x00,0x03,0x23,0x00,0x12,0x12,0x12,0x00,0x01,0x14,0x11,0x03,
+	0x23,0x80,0x00,0x80,0x01,0x03,0x13,0x11,0x13,0x12,0x00,0x02,0x11,0x13,0x00,0x03,
+	0x14,0x00,0x32,0x33,0x80,0x00,0x80,0x01,0x16,0x10,0x14,0x12,0x51,0x24,0x13,0x00,
+	0x03,0x14,0x21,0x50,0x00,0x11,0x41,0x10,0x00,0x06,0x28,0x00,0x00,0x83,0x41,0x31,
+	0x40,0x0a,0x34,0x18,0x80,0x00,0x11,0x60,0x00,0x21,0x50,0x00,0x31,0x40,0x01,0x41,
+	0x30,0x00,0x51,0x20,0x01,0x61,0x10,0x00,0x81,0x43,0x41,0x30,0x0a,0x14,0x38,0x83,
+	0x32,0x21,0x31,0x18,0x00,0xb0,0x80,0x0d,0x08,0x81,0x25,0x31,0x48,0x00,0xb0,0x80,
+	0x05,0x24,0x21,0x14,0x11,0x34,0x12,0x13,0x11,0x11,0x41,0x10,0x00,0x26,0x80,0x00,
+	0x80,0x01,0x02,0x61,0x16,0x00,0x11,0x11,0x23,0x12,0x21,0x21,0x14,0x11,0x00,0x11,
+	0x22,0x12,0x11,0x12,0x38,0x00,0x00,0x80,0x05,0x33,0x22,0x13,0x11,0x11,0x60,0x01,
+	0x21,0x31,0x13,0x32,0x80,0x00,0x80,0x01,0x52,0x16,0x11,0x00,0x13,0x41,0x21,0x31,
+	0x11,0x14,0x11,0x00,0x12,0x12,0x21,0x32,0x12,0x80,0x00,0x80,0x05,0x24,0x21,0x14,
+	0x11,0x16,0x11,0x16,0x00,0x01,0x14,0x11,0x24,0x28,0x00,0x00,0x80,0x01,0x44,0x31,
+	0x31,0x31,0x40,0x00,0x16,0x13,0x14,0x00,0x31,0x52,0x80,0x00,0x80,0x05,0x25,0x11,
+	0x13,0x12,0x00,0x02,0x33,0x11,0x62,0x42,0x11,0x41,0x10,0x00,0x24,0x20,0x80,0x01,
+	0x02,0x61,0x16,0x00,0x11,0x11,0x32,0x12,0x31,0x11,0x14,0x11,0x00,0x20,0x32,0x38,
+	0x00,0x00,0x80,0x01,0x22,0x40,0x00,0x80,0x00,0x13,0x43,0x14,0x00,0x31,0x52,0x80,
+	0x00,0x80,0x01,0x42,0x20,0x00,0x80,0x00,0x33,0x25,0x12,0x00,0x41,0x13,0x12,0x14,
+	0x30,0x80,0x01,0x02,0x61,0x16,0x00,0x11,0x12,0x31,0x11,0x21,0x31,0x11,0x14,0x12,
+	0x11,0x31,0x12,0x13,0x11,0x31,0x20,0x31,0x31,0x80,0x00,0x80,0x01,0x13,0x43,0x14,
+	0x00,0x71,0x52,0x80,0x00,0x80,0x05,0x07,0x11,0x12,0x12,0x10,0x03,0x03,0x12,0x11,
+	0x80,0x00,0x80,0x05,0x02,0x13,0x21,0x23,0x11,0x11,0x41,0x10,0x02,0x03,0x23,0x80,
+	0x00,0x80,0x05,0x24,0x21,0x14,0x11,0x00,0x32,0x42,0x80,0x00,0x80,0x05,0x02,0x12,
+	0x31,0x22,0x12,0x11,0x41,0x10,0x01,0x11,0x31,0x21,0x43,0x11,0x60,0x35,0x80,0x05,
+	0x34,0x12,0x13,0x11,0x11,0x41,0x10,0x01,0x21,0x31,0x13,0x41,0x61,0x15,0x30,0x80,
+	0x05,0x03,0x13,0x12,0x22,0x11,0x21,0x50,0x02,0x05,0x38,0x00,0x00,0x80,0x05,0x25,
+	0x11,0x14,0x11,0x11,0x62,0x42,0x61,0x11,0x14,0x11,0x15,0x28,0x00,0x00,0x80,0x03,
+	0x31,0x40,0x00,0x15,0x23,0x14,0x00,0x34,0x22,0x80,0x00,0x80,0x05,0x02,0x32,0x11,
+	0x14,0x11,0x00,0x21,0x13,0x21,0x23,0x12,0x80,0x00,0x80,0x05,0x03,0x23,0x11,0x41,
+	0x12,0x12,0x12,0x00,0x02,0x11,0x13,0x31,0x40,0x00,0x80,0x00,0x80,0x05,0x02,0x11,
+	0x13,0x01,0x21,0x21,0x10,0x00,0x01,0x11,0x11,0x11,0x10,0x00,0x11,0x31,0x20,0x00,
+	0x80,0x00,0x80,0x05,0x12,0x13,0x12,0x12,0x12,0x32,0x30,0x01,0x21,0x21,0x21,0x31,
+	0x21,0x80,0x00,0x80,0x05,0x03,0x23,0x11,0x41,0x12,0x12,0x12,0x00,0x02,0x11,0x13,
+	0x32,0x33,0x14,0x00,0x00,0x35,0x80,0x05,0x16,0x11,0x13,0x12,0x41,0x33,0x14,0x00,
+	0x02,0x13,0x11,0x16,0x18,0x00,0x00,0x86,0x25,0x12,0x00,0x34,0x13,0x51,0x20,0x04,
+	0x62,0x80,0x41,0x30,0x0e,0x81,0x25,0x31,0x40,0x03,0x41,0x33,0x14,0x00,0x41,0x25,
+	0x80,0x22,0x41,0x12,0x22,0x11,0x42,0x80,0x0b,
+};
+
+static const uint16_t Ascii10x20_Offset[] = {
+	0,4,19,33,59,97,132,167,177,196,
+	215,240,252,262,267,274,302,321,333,359,
+	387,415,440,469,489,516,545,557,566,590,
+	599,623,649,694,720,744,769,790,820,845,
+	875,894,904,918,952,967,992,1023,1044,1065,
+	1092,1124,1154,1169,1184,1207,1233,1266,1288,1316,
+	1325,1349,1358,1367,1372,1378,1401,1424,1444,1467,
+	1489,1506,1526,1546,1561,1577,1608,1618,1632,1648,
+	1664,1685,1706,1722,1746,1762,1778,1798,1821,1843,
+	1867,1889,1904,1909,1924,
+};
+
+static const uint8_t Ascii10x20_Rle[] = {
+	0xa0,0x0f,0x00,0x20,0xa0,0x01,0x42,0x40,0x03,0x51,0x40,0x03,0xa0,0x00,0x42,0x40,
+	0x00,0xa0,0x01,0xa3,0x21,0x22,0x00,0x02,0x21,0x23,0x21,0x21,0x41,0x12,0x15,0xa0,
+	0x0c,0xa0,0x02,0x21,0x41,0x20,0x01,0x09,0x12,0x14,0x12,0x00,0x01,0x23,0x22,0x11,
+	0x41,0x30,0x00,0x09,0x11,0x14,0x13,0x00,0x1a,0x00,0x10,0xa0,0x01,0x51,0x43,0x52,
+	0x21,0x21,0x21,0x10,0x00,0x21,0x21,0x12,0x13,0x11,0x14,0x42,0x45,0x23,0x51,0x11,
+	0x25,0x12,0x11,0x22,0x11,0x21,0x12,0x12,0x12,0x11,0x00,0x03,0x52,0x51,0x40,0x00,
+	0xa0,0xa0,0x02,0x12,0x41,0x20,0x12,0x12,0x13,0x00,0x00,0x12,0x11,0x14,0x00,0x00,
+	0x12,0x25,0x12,0x11,0x12,0x23,0x11,0x12,0x11,0x00,0x12,0x12,0x12,0x11,0x00,0x01,
+	0x14,0x22,0xa0,0x01,0xa0,0x02,0x22,0x61,0x12,0x15,0x00,0x11,0x11,0x11,0x32,0x12,
+	0x31,0x30,0x00,0x01,0x11,0x21,0x40,0x12,0x11,0x14,0x01,0x23,0x40,0x13,0x15,0x11,
+	0x22,0x21,0x12,0x22,0x22,0xa0,0x01,0xa1,0x27,0x00,0x02,0x17,0x11,0x80,0x19,0xa0,
+	0x0c,0xa8,0x11,0x71,0x26,0x13,0x51,0x40,0x01,0x41,0x50,0x04,0x51,0x40,0x01,0x61,
+	0x37,0x12,0x81,0x1a,0xa0,0x19,0x11,0x82,0x17,0x31,0x60,0x01,0x41,0x50,0x04,0x31,
+	0x60,0x01,0x21,0x71,0x18,0x01,0x9a,0xa0,0x03,0x51,0x40,0x00,0x12,0x21,0x22,0x13,
+	0x11,0x13,0x43,0x30,0x00,0x13,0x11,0x13,0x12,0x21,0x22,0x51,0x40,0x00,0xa0,0x03,
+	0xa0,0x03,0x41,0x50,0x02,0x09,0x14,0x15,0x00,0x2a,0x00,0x40,0xa0,0x0d,0x12,0x70,
+	0x00,0x21,0x71,0x18,0x01,0x90,0xa0,0x07,0x19,0xa0,0x08,0xa0,0x0d,0x12,0x70,0x00,
+	0xa0,0x01,0xa9,0x18,0x11,0x00,0x07,0x12,0x00,0x06,0x22,0x61,0x35,0x23,0x51,0x44,
+	0x24,0x41,0x53,0x25,0x31,0x60,0x00,0x21,0x70,0x00,0x11,0x8a,0x00,0x00,0xa0,0x02,
+	0x34,0x32,0x14,0x12,0x00,0x01,0x16,0x11,0x00,0x52,0x14,0x12,0x00,0x03,0x43,0xa0,
+	0x01,0xa0,0x02,0x41,0x52,0x35,0x41,0x50,0x08,0x25,0x3a,0x00,0x10,0xa0,0x02,0x25,
+	0x31,0x15,0x12,0x11,0x61,0x10,0x01,0x71,0x26,0x13,0x51,0x44,0x15,0x31,0x62,0x15,
+	0x11,0x11,0x61,0x11,0x81,0xa0,0x01,0xa0,0x02,0x24,0x41,0x14,0x13,0x11,0x51,0x20,
+	0x00,0x61,0x34,0x33,0x71,0x28,0x11,0x00,0x01,0x16,0x11,0x00,0x01,0x15,0x12,0x25,
+	0x3a,0x00,0x10,0xa0,0x01,0x61,0x30,0x00,0x52,0x34,0x11,0x13,0x31,0x21,0x30,0x00,
+	0x21,0x31,0x31,0x14,0x13,0x00,0x01,0x81,0x61,0x30,0x01,0x45,0x1a,0x00,0x10,0xa0,
+	0x02,0x27,0x12,0x17,0x00,0x22,0x11,0x33,0x22,0x31,0x28,0x11,0x00,0x01,0x16,0x11,
+	0x00,0x01,0x15,0x12,0x25,0x3a,0x00,0x10,0xa0,0x02,0x44,0x23,0x14,0x11,0x21,0x51,
+	0x12,0x17,0x11,0x81,0x11,0x43,0x12,0x41,0x21,0x16,0x11,0x00,0x12,0x15,0x11,0x21,
+	0x41,0x23,0x43,0xa0,0x01,0xa0,0x02,0x18,0x11,0x15,0x12,0x11,0x41,0x36,0x13,0x51,
+	0x44,0x15,0x00,0x03,0x16,0x00,0x4a,0x00,0x10,0xa0,0x02,0x34,0x32,0x14,0x12,0x11,
+	0x61,0x10,0x01,0x21,0x41,0x23,0x43,0x21,0x41,0x21,0x16,0x11,0x00,0x12,0x14,0x12,
+	0x34,0x3a,0x00,0x10,0xa0,0x02,0x34,0x32,0x14,0x12,0x11,0x51,0x21,0x16,0x11,0x00,
+	0x12,0x14,0x21,0x34,0x11,0x18,0x11,0x71,0x21,0x15,0x12,0x11,0x41,0x32,0x44,0xa0,
+	0x01,0xa0,0x05,0x42,0x40,0x00,0xa0,0x04,0x42,0x40,0x00,0xa0,0x01,0xa0,0x06,0x41,
+	0x5a,0x00,0x54,0x15,0x00,0x20,0xa0,0x01,0x71,0x26,0x13,0x51,0x44,0x15,0x31,0x62,
+	0x17,0x11,0x82,0x17,0x31,0x64,0x15,0x51,0x46,0x13,0x71,0x2a,0x00,0x20,0xa0,0x05,
+	0x09,0x1a,0x00,0x10,0x91,0xa0,0x06,0xa0,0x01,0x11,0x82,0x17,0x31,0x64,0x15,0x51,
+	0x46,0x13,0x71,0x26,0x13,0x51,0x44,0x15,0x31,0x62,0x17,0x11,0x8a,0x00,0x20,0xa0,
+	0x01,0x34,0x32,0x14,0x12,0x11,0x61,0x11,0x25,0x11,0x00,0x08,0x11,0x71,0x26,0x13,
+	0x51,0x40,0x01,0xa4,0x24,0x00,0x0a,0x00,0x10,0xa0,0x02,0x34,0x32,0x13,0x22,0x11,
+	0x25,0x10,0x12,0x21,0x11,0x11,0x01,0x21,0x21,0x11,0x10,0x11,0x13,0x11,0x11,0x01,
+	0x11,0x21,0x21,0x10,0x00,0x01,0x11,0x21,0x11,0x20,0x12,0x21,0x22,0x11,0x61,0x12,
+	0x14,0x12,0x34,0x3a,0x00,0x10,0xa0,0x02,0x41,0x50,0x00,0x31,0x11,0x40,0x02,0x21,
+	0x31,0x30,0x00,0x25,0x32,0x13,0x13,0x11,0x51,0x20,0x00,0x03,0x33,0x1a,0x00,0x10,
+	0xa0,0x02,0x06,0x41,0x14,0x13,0x00,0x11,0x13,0x14,0x15,0x41,0x14,0x13,0x11,0x51,
+	0x20,0x02,0x11,0x41,0x30,0x64,0xa0,0x01,0xa0,0x02,0x34,0x11,0x12,0x14,0x21,0x11,
+	0x61,0x10,0x00,0x01,0x90,0x03,0x01,0x71,0x11,0x16,0x11,0x12,0x41,0x23,0x43,0xa0,
+	0x01,0xa0,0x02,0x06,0x41,0x14,0x22,0x11,0x51,0x21,0x16,0x11,0x00,0x51,0x15,0x12,
+	0x11,0x41,0x30,0x64,0xa0,0x01,0xa0,0x02,0x08,0x21,0x15,0x12,0x11,0x61,0x11,0x14,
+	0x13,0x00,0x01,0x63,0x11,0x41,0x30,0x00,0x11,0x80,0x00,0x11,0x61,0x11,0x15,0x12,
+	0x08,0x2a,0x00,0x10,0xa0,0x02,0x08,0x21,0x15,0x12,0x11,0x61,0x11,0x14,0x13,0x00,
+	0x01,0x63,0x11,0x41,0x30,0x00,0x11,0x80,0x02,0x03,0x7a,0x00,0x10,0xa0,0x02,0x43,
+	0x11,0x13,0x13,0x21,0x21,0x51,0x11,0x16,0x11,0x11,0x80,0x01,0x11,0x53,0x11,0x61,
+	0x10,0x00,0x21,0x51,0x12,0x24,0x11,0x44,0x2a,0x00,0x10,0xa0,0x02,0x03,0x33,0x11,
+	0x15,0x12,0x00,0x31,0x72,0x11,0x51,0x20,0x03,0x03,0x33,0x1a,0x00,0x10,0xa0,0x02,
+	0x17,0x24,0x15,0x00,0x91,0x72,0xa0,0x01,0xa0,0x02,0x27,0x15,0x14,0x00,0x90,0x14,
+	0x14,0x01,0x31,0x51,0x36,0xa0,0xa0,0x02,0x03,0x24,0x11,0x14,0x13,0x11,0x31,0x40,
+	0x00,0x11,0x21,0x51,0x11,0x25,0x12,0x11,0x51,0x13,0x14,0x00,0x01,0x14,0x13,0x00,
+	0x01,0x15,0x12,0x03,0x33,0x1a,0x00,0x10,0xa0,0x02,0x03,0x71,0x18,0x00,0x71,0x16,
+	0x11,0x11,0x51,0x20,0x82,0xa0,0x01,0xa0,0x02,0x03,0x33,0x11,0x23,0x22,0x00,0x11,
+	0x11,0x11,0x11,0x12,0x00,0x31,0x12,0x12,0x12,0x00,0x10,0x31,0x11,0x31,0xa0,0x01,
+	0xa0,0x02,0x03,0x33,0x11,0x24,0x12,0x11,0x11,0x31,0x20,0x01,0x11,0x21,0x21,0x20,
+	0x00,0x11,0x31,0x11,0x20,0x00,0x11,0x42,0x20,0x01,0x03,0x41,0x2a,0x00,0x10,0xa0,
+	0x02,0x33,0x41,0x23,0x22,0x11,0x51,0x20,0x17,0x11,0x00,0x51,0x15,0x12,0x12,0x32,
+	0x23,0x34,0xa0,0x01,0xa0,0x02,0x07,0x31,0x15,0x12,0x11,0x61,0x10,0x01,0x11,0x51,
+	0x21,0x63,0x11,0x80,0x03,0x03,0x7a,0x00,0x10,0xa0,0x02,0x33,0x41,0x23,0x22,0x11,
+	0x51,0x20,0x17,0x11,0x00,0x40,0x12,0x23,0x11,0x12,0x21,0x11,0x20,0x00,0x34,0x36,
+	0x11,0x11,0x62,0x2a,0xa0,0x02,0x06,0x41,0x14,0x13,0x11,0x51,0x20,0x00,0x11,0x41,
+	0x31,0x54,0x11,0x21,0x51,0x13,0x14,0x00,0x01,0x14,0x13,0x00,0x01,0x15,0x12,0x03,
+	0x42,0x1a,0x00,0x10,0xa0,0x02,0x34,0x11,0x12,0x14,0x21,0x11,0x61,0x11,0x18,0x00,
+	0x02,0x26,0x43,0x37,0x12,0x81,0x11,0x16,0x11,0x00,0x01,0x24,0x12,0x11,0x14,0x3a,
+	0x00,0x10,0xa0,0x02,0x17,0x20,0x13,0x13,0x11,0x00,0x04,0x15,0x00,0x73,0x34,0xa0,
+	0x01,0xa0,0x02,0x03,0x33,0x11,0x15,0x12,0x00,0x82,0x13,0x13,0x33,0x4a,0x00,0x10,
+	0xa0,0x02,0x03,0x33,0x11,0x15,0x12,0x00,0x02,0x13,0x13,0x00,0x23,0x11,0x14,0x00,
+	0x13,0x34,0x41,0x50,0x00,0xa0,0x01,0xa0,0x02,0x02,0x13,0x12,0x11,0x12,0x12,0x12,
+	0x00,0x21,0x11,0x11,0x11,0x12,0x00,0x11,0x11,0x11,0x23,0x21,0x31,0x30,0x02,0xa0,
+	0x01,0xa0,0x02,0x13,0x23,0x12,0x14,0x12,0x21,0x31,0x33,0x12,0x13,0x31,0x11,0x44,
+	0x24,0x41,0x54,0x24,0x31,0x11,0x43,0x12,0x13,0x00,0x02,0x14,0x12,0x13,0x23,0x1a,
+	0x00,0x10,0xa0,0x02,0x03,0x33,0x11,0x15,0x12,0x21,0x31,0x30,0x00,0x31,0x11,0x40,
+	0x00,0x41,0x50,0x04,0x33,0x4a,0x00,0x10,0xa0,0x02,0x27,0x12,0x14,0x12,0x11,0x51,
+	0x26,0x13,0x00,0x05,0x14,0x41,0x50,0x00,0x31,0x60,0x00,0x21,0x51,0x12,0x14,0x12,
+	0x17,0x2a,0x00,0x10,0xa4,0x51,0x41,0x50,0x0d,0x45,0x1a,0x00,0x00,0xa0,0x00,0x11,
+	0x82,0x17,0x00,0x03,0x16,0x00,0x14,0x15,0x00,0x05,0x14,0x00,0x16,0x13,0x00,0x07,
+	0x12,0x00,0x18,0x11,0xa0,0xa1,0x54,0x51,0x40,0x0d,0x15,0x4a,0x00,0x00,0xa3,0x34,
+	0x31,0x11,0x42,0x13,0x13,0xa0,0x0e,0xa0,0x0f,0x00,0x10,0xa0,0xa3,0x25,0x51,0x4a,
+	0x00,0xf0,0xa0,0x06,0x25,0x31,0x15,0x12,0x00,0x04,0x42,0x22,0x31,0x21,0x15,0x12,
+	0x00,0x01,0x14,0x21,0x12,0x41,0x3a,0x00,0x10,0xa0,0x02,0x02,0x81,0x18,0x00,0x11,
+	0x11,0x34,0x12,0x31,0x31,0x15,0x12,0x00,0x31,0x23,0x13,0x11,0x13,0x4a,0x00,0x10,
+	0xa0,0x06,0x34,0x32,0x14,0x12,0x11,0x51,0x21,0x18,0x00,0x11,0x16,0x11,0x21,0x41,
+	0x23,0x43,0xa0,0x01,0xa0,0x02,0x62,0x27,0x12,0x00,0x13,0x31,0x12,0x21,0x32,0x21,
+	0x15,0x12,0x00,0x32,0x13,0x22,0x33,0x12,0x1a,0x00,0x10,0xa0,0x06,0x34,0x32,0x14,
+	0x12,0x11,0x61,0x11,0x81,0x11,0x80,0x00,0x11,0x61,0x12,0x14,0x12,0x34,0x3a,0x00,
+	0x10,0xa0,0x02,0x54,0x14,0x14,0x14,0x15,0x00,0x02,0x62,0x41,0x50,0x05,0x26,0x2a,
+	0x00,0x10,0xa0,0x06,0x36,0x12,0x14,0x12,0x00,0x23,0x43,0x21,0x72,0x53,0x21,0x42,
+	0x11,0x16,0x11,0x00,0x02,0x62,0xa0,0x02,0x02,0x81,0x18,0x00,0x11,0x11,0x43,0x12,
+	0x41,0x21,0x15,0x12,0x00,0x40,0x33,0x31,0xa0,0x01,0xa0,0x02,0x32,0x50,0x00,0xa0,
+	0x00,0x23,0x54,0x15,0x00,0x52,0x53,0xa0,0x01,0xa0,0x02,0x52,0x30,0x00,0xa0,0x00,
+	0x43,0x36,0x13,0x00,0x71,0x13,0x14,0x14,0x50,0xa0,0x02,0x02,0x81,0x18,0x00,0x11,
+	0x13,0x32,0x11,0x31,0x41,0x12,0x15,0x11,0x11,0x61,0x21,0x15,0x11,0x31,0x41,0x14,
+	0x13,0x11,0x51,0x20,0x33,0x31,0xa0,0x01,0xa0,0x02,0x14,0x54,0x15,0x00,0x91,0x72,
+	0xa0,0x01,0xa0,0x06,0x07,0x31,0x12,0x12,0x12,0x00,0x50,0x31,0x21,0x21,0xa0,0x01,
+	0xa0,0x06,0x02,0x14,0x31,0x24,0x12,0x11,0x51,0x20,0x04,0x03,0x33,0x1a,0x00,0x10,
+	0xa0,0x06,0x34,0x32,0x14,0x12,0x11,0x61,0x10,0x03,0x21,0x41,0x23,0x43,0xa0,0x01,
+	0xa0,0x06,0x02,0x13,0x41,0x23,0x13,0x11,0x51,0x20,0x03,0x12,0x31,0x31,0x11,0x34,
+	0x11,0x80,0x00,0x03,0x70,0xa0,0x06,0x33,0x11,0x22,0x13,0x22,0x11,0x51,0x20,0x03,
+	0x21,0x32,0x23,0x31,0x12,0x71,0x20,0x00,0x63,0x10,0xa0,0x06,0x13,0x23,0x13,0x11,
+	0x12,0x11,0x32,0x53,0x16,0x00,0x31,0x54,0xa0,0x01,0xa0,0x06,0x24,0x11,0x21,0x14,
+	0x22,0x11,0x51,0x21,0x27,0x33,0x46,0x22,0x11,0x51,0x21,0x24,0x12,0x11,0x14,0x3a,
+	0x00,0x10,0xa0,0x03,0x41,0x50,0x01,0x26,0x24,0x15,0x00,0x44,0x12,0x12,0x52,0x3a,
+	0x00,0x10,0xa0,0x06,0x02,0x42,0x21,0x15,0x12,0x00,0x41,0x14,0x22,0x24,0x12,0x1a,
+	0x00,0x10,0xa0,0x06,0x03,0x33,0x11,0x15,0x12,0x21,0x31,0x30,0x01,0x31,0x11,0x40,
+	0x00,0x41,0x50,0x00,0xa0,0x01,0xa0,0x06,0x02,0x13,0x12,0x11,0x12,0x12,0x12,0x00,
+	0x11,0x11,0x11,0x11,0x12,0x00,0x02,0x13,0x13,0x00,0x1a,0x00,0x10,0xa0,0x06,0x13,
+	0x23,0x12,0x14,0x12,0x31,0x21,0x34,0x24,0x00,0x13,0x12,0x13,0x21,0x41,0x21,0x32,
+	0x31,0xa0,0x01,0xa0,0x06,0x13,0x14,0x12,0x14,0x12,0x31,0x31,0x23,0x12,0x13,0x00,
+	0x04,0x11,0x13,0x42,0x45,0x14,0x41,0x50,0x01,0x22,0x60,0xa0,0x06,0x17,0x21,0x14,
+	0x13,0x11,0x31,0x45,0x14,0x41,0x53,0x16,0x21,0x41,0x21,0x15,0x12,0x17,0x2a,0x00,
+	0x10,0xa7,0x21,0x61,0x30,0x04,0x52,0x34,0x15,0x52,0x36,0x13,0x00,0x57,0x21,0xa0,
+	0x51,0x40,0x0f,0x00,0x20,0xa1,0x27,0x31,0x60,0x04,0x32,0x55,0x14,0x32,0x53,0x16,
+	0x00,0x51,0x27,0xa0,0x23,0x51,0x22,0x13,0x11,0x13,0x12,0x26,0x31,0xa0,0x0e,
+};
+
+static const uint16_t Ascii12x24_Offset[] = {
+	0,4,19,37,63,105,158,201,214,241,
+	268,294,305,318,324,333,367,391,404,438,
+	467,499,530,567,591,623,660,672,686,716,
+	725,755,784,834,866,895,923,947,981,1009,
+	1041,1059,1069,1082,1124,1141,1175,1218,1244,1265,
+	1297,1330,1365,1383,1397,1425,1461,1500,1528,1561,
+	1571,1597,1607,1619,1624,1633,1658,1687,1711,1740,
+	1764,1784,1812,1834,1849,1865,1901,1913,1932,1948,
+	1968,1991,2017,2033,2058,2078,2096,2117,2148,2177,
+	2204,2230,2249,2254,2273,
+};
+
+static const uint8_t Ascii12x24_Rle[] = {
+	0xc0,0x0f,0x00,0x60,0xc0,0x02,0x53,0x40,0x03,0x61,0x50,0x04,0xc0,0x01,0x53,0x40,
+	0x01,0xc0,0x01,0xc0,0x00,0x52,0x22,0x10,0x00,0x42,0x22,0x23,0x22,0x23,0x31,0x31,
+	0x42,0x13,0x15,0xc0,0x0e,0xc0,0x03,0x31,0x51,0x20,0x02,0x1a,0x10,0x00,0x31,0x51,
+	0x20,0x00,0x21,0x51,0x30,0x00,0x1a,0x10,0x00,0x21,0x51,0x30,0x02,0xc0,0x01,0xc0,
+	0x01,0x61,0x50,0x00,0x45,0x33,0x21,0x11,0x22,0x22,0x21,0x12,0x20,0x00,0x22,0x21,
+	0x53,0x21,0x15,0x43,0x55,0x34,0x63,0x30,0x00,0x61,0x12,0x22,0x22,0x11,0x22,0x00,
+	0x13,0x12,0x11,0x13,0x44,0x46,0x15,0x00,0x0c,0xc0,0x03,0x13,0x42,0x21,0x11,0x14,
+	0x13,0x01,0x31,0x31,0x30,0x13,0x12,0x14,0x00,0x00,0x13,0x11,0x24,0x01,0x31,0x11,
+	0x51,0x11,0x72,0x13,0x11,0x11,0x11,0x25,0x23,0x11,0x41,0x11,0x31,0x10,0x00,0x32,
+	0x11,0x31,0x13,0x12,0x13,0x11,0x31,0x31,0x11,0x22,0x14,0x32,0xc0,0x01,0xc0,0x03,
+	0x33,0x62,0x12,0x25,0x00,0x22,0x12,0x11,0x32,0x23,0x31,0x32,0x24,0x13,0x11,0x12,
+	0x31,0x31,0x12,0x12,0x14,0x02,0x22,0x11,0x40,0x23,0x34,0x02,0x32,0x50,0x24,0x24,
+	0x12,0x21,0x11,0x21,0x12,0x33,0x22,0xc0,0x01,0xc0,0x00,0x22,0x82,0x37,0x41,0x70,
+	0x00,0x31,0x81,0x29,0xc0,0x0e,0xc0,0x00,0xa1,0x19,0x12,0x81,0x37,0x23,0x71,0x46,
+	0x24,0x00,0x05,0x25,0x00,0x56,0x24,0x00,0x07,0x14,0x72,0x38,0x13,0x91,0x2a,0x11,
+	0xc0,0xc0,0x00,0x11,0xa2,0x19,0x31,0x83,0x27,0x41,0x74,0x26,0x00,0x05,0x25,0x00,
+	0x54,0x26,0x00,0x04,0x17,0x32,0x73,0x18,0x21,0x91,0x1a,0xc0,0xc0,0x04,0x61,0x50,
+	0x01,0x13,0x21,0x23,0x23,0x11,0x13,0x14,0x53,0x00,0x02,0x31,0x11,0x31,0x13,0x21,
+	0x23,0x61,0x50,0x01,0xc0,0x04,0xc0,0x05,0x61,0x50,0x03,0x1b,0x61,0x50,0x03,0xc0,
+	0x04,0xc0,0x0f,0x00,0x02,0x28,0x23,0x74,0x17,0x00,0x03,0x18,0x12,0x90,0xc0,0x0a,
+	0x1a,0x1c,0x00,0x90,0xc0,0x0f,0x00,0x02,0x37,0x00,0x1c,0x00,0x10,0xc0,0x00,0xa1,
+	0x19,0x21,0x91,0x28,0x22,0x81,0x30,0x00,0x71,0x40,0x00,0x61,0x50,0x00,0x52,0x55,
+	0x16,0x00,0x04,0x17,0x00,0x03,0x18,0x00,0x02,0x28,0x21,0x91,0x29,0x11,0xac,0xc0,
+	0x03,0x44,0x43,0x22,0x23,0x22,0x42,0x20,0x00,0x12,0x62,0x10,0x06,0x22,0x42,0x20,
+	0x00,0x32,0x22,0x34,0x44,0xc0,0x01,0xc0,0x03,0x61,0x55,0x25,0x25,0x55,0x25,0x00,
+	0xa2,0x82,0xc0,0x01,0xc0,0x03,0x35,0x42,0x14,0x23,0x11,0x62,0x21,0x25,0x22,0x00,
+	0x08,0x22,0x72,0x30,0x00,0x62,0x45,0x16,0x41,0x73,0x15,0x12,0x21,0x61,0x21,0x17,
+	0x12,0x19,0x20,0x00,0xc0,0x01,0xc0,0x03,0x34,0x52,0x13,0x24,0x12,0x42,0x30,0x01,
+	0x72,0x36,0x24,0x43,0x57,0x23,0x81,0x38,0x22,0x12,0x52,0x20,0x01,0x21,0x42,0x33,
+	0x54,0xc0,0x01,0xc0,0x02,0x81,0x37,0x23,0x63,0x30,0x00,0x51,0x12,0x34,0x12,0x23,
+	0x00,0x03,0x13,0x23,0x21,0x42,0x30,0x00,0x11,0x52,0x31,0xa1,0x72,0x30,0x02,0x56,
+	0x1c,0x00,0x10,0xc0,0x03,0x28,0x20,0x00,0x21,0x90,0x02,0x21,0x14,0x42,0x23,0x23,
+	0x21,0x52,0x28,0x22,0x00,0x01,0x25,0x22,0x00,0x01,0x15,0x23,0x21,0x42,0x33,0x54,
+	0xc0,0x01,0xc0,0x03,0x54,0x33,0x23,0x22,0x22,0x42,0x22,0x28,0x21,0x91,0x29,0x12,
+	0x24,0x31,0x21,0x13,0x22,0x13,0x52,0x11,0x26,0x21,0x00,0x12,0x16,0x21,0x22,0x51,
+	0x23,0x23,0x22,0x44,0x4c,0x00,0x10,0xc0,0x03,0x38,0x12,0x91,0x22,0x51,0x22,0x15,
+	0x13,0x00,0x08,0x13,0x71,0x40,0x00,0x61,0x50,0x01,0x52,0x50,0x03,0xc0,0x01,0xc0,
+	0x03,0x36,0x32,0x24,0x22,0x12,0x62,0x10,0x01,0x13,0x51,0x22,0x42,0x22,0x44,0x42,
+	0x22,0x33,0x21,0x52,0x21,0x26,0x21,0x00,0x22,0x24,0x22,0x45,0x3c,0x00,0x10,0xc0,
+	0x03,0x44,0x42,0x24,0x13,0x22,0x42,0x21,0x26,0x12,0x12,0x62,0x10,0x01,0x12,0x53,
+	0x12,0x23,0x11,0x21,0x34,0x22,0x19,0x21,0x82,0x20,0x00,0x22,0x41,0x32,0x23,0x23,
+	0x34,0x5c,0x00,0x10,0xc0,0x07,0x53,0x40,0x01,0xc0,0x04,0x53,0x40,0x01,0xc0,0x01,
+	0xc0,0x08,0x52,0x50,0x00,0xc0,0x05,0x52,0x50,0x00,0x61,0x55,0x16,0xc0,0xc0,0x02,
+	0xa1,0x19,0x12,0x81,0x37,0x14,0x61,0x55,0x16,0x41,0x73,0x18,0x21,0x93,0x18,0x41,
+	0x75,0x16,0x61,0x57,0x14,0x81,0x39,0x12,0xa1,0x1c,0x00,0x10,0xc0,0x08,0x1a,0x1c,
+	0x00,0x21,0xa1,0xc0,0x06,0xc0,0x02,0x21,0x93,0x18,0x41,0x75,0x16,0x61,0x57,0x14,
+	0x81,0x39,0x12,0xa1,0x19,0x12,0x81,0x37,0x14,0x61,0x55,0x16,0x41,0x73,0x18,0x21,
+	0x9c,0x00,0x10,0xc0,0x02,0x45,0x32,0x24,0x22,0x11,0x72,0x10,0x00,0x12,0x62,0x10,
+	0x00,0x82,0x27,0x23,0x52,0x55,0x16,0x00,0x1c,0x00,0x04,0x35,0x00,0x1c,0x00,0x10,
+	0xc0,0x03,0x54,0x33,0x33,0x21,0x31,0x61,0x12,0x22,0x21,0x11,0x12,0x12,0x21,0x21,
+	0x11,0x22,0x12,0x12,0x10,0x00,0x12,0x11,0x31,0x21,0x00,0x01,0x21,0x12,0x22,0x11,
+	0x21,0x12,0x21,0x11,0x12,0x22,0x12,0x22,0x27,0x12,0x26,0x11,0x32,0x41,0x25,0x43,
+	0xc0,0x01,0xc0,0x03,0x52,0x50,0x00,0x43,0x54,0x11,0x24,0x00,0x03,0x12,0x24,0x31,
+	0x32,0x30,0x01,0x36,0x32,0x15,0x22,0x00,0x12,0x16,0x21,0x12,0x62,0x10,0x44,0x4c,
+	0x00,0x10,0xc0,0x03,0x08,0x41,0x24,0x23,0x12,0x52,0x20,0x02,0x12,0x42,0x31,0x74,
+	0x12,0x52,0x21,0x26,0x12,0x12,0x62,0x10,0x02,0x12,0x52,0x20,0x93,0xc0,0x01,0xc0,
+	0x03,0x56,0x13,0x24,0x21,0x22,0x61,0x10,0x00,0x21,0x91,0x29,0x00,0x41,0x27,0x11,
+	0x22,0x61,0x12,0x25,0x12,0x32,0x31,0x34,0x44,0xc0,0x01,0xc0,0x03,0x07,0x51,0x24,
+	0x23,0x12,0x52,0x20,0x00,0x12,0x62,0x10,0x06,0x12,0x52,0x20,0x00,0x12,0x33,0x30,
+	0x75,0xc0,0x01,0xc0,0x03,0x0a,0x21,0x26,0x12,0x12,0x71,0x11,0x29,0x00,0x01,0x24,
+	0x14,0x00,0x01,0x74,0x12,0x41,0x40,0x00,0x12,0x90,0x00,0x12,0x71,0x10,0x00,0x12,
+	0x61,0x20,0xa2,0xc0,0x01,0xc0,0x03,0x0a,0x21,0x25,0x22,0x12,0x71,0x10,0x00,0x12,
+	0x91,0x24,0x14,0x00,0x01,0x74,0x12,0x41,0x40,0x00,0x12,0x90,0x03,0x04,0x8c,0x00,
+	0x10,0xc0,0x03,0x44,0x11,0x23,0x23,0x22,0x22,0x51,0x20,0x00,0x21,0x91,0x29,0x00,
+	0x21,0x23,0x61,0x25,0x22,0x00,0x02,0x24,0x22,0x00,0x03,0x23,0x22,0x44,0x4c,0x00,
+	0x10,0xc0,0x03,0x04,0x44,0x12,0x62,0x10,0x04,0x1a,0x11,0x26,0x21,0x00,0x50,0x44,
+	0x4c,0x00,0x10,0xc0,0x03,0x28,0x25,0x25,0x00,0xc2,0x82,0xc0,0x01,0xc0,0x03,0x48,
+	0x72,0x30,0x0d,0x12,0x42,0x31,0x23,0x24,0x25,0x50,0xc0,0x03,0x04,0x25,0x11,0x25,
+	0x13,0x12,0x41,0x41,0x23,0x15,0x00,0x01,0x22,0x16,0x12,0x12,0x61,0x56,0x13,0x12,
+	0x51,0x22,0x34,0x12,0x32,0x41,0x23,0x33,0x12,0x42,0x31,0x25,0x22,0x12,0x53,0x10,
+	0x43,0x5c,0x00,0x10,0xc0,0x03,0x04,0x81,0x29,0x00,0x91,0x27,0x11,0x00,0x01,0x26,
+	0x12,0x0a,0x2c,0x00,0x10,0xc0,0x03,0x04,0x44,0x13,0x43,0x10,0x01,0x11,0x12,0x21,
+	0x12,0x10,0x02,0x11,0x12,0x11,0x22,0x11,0x12,0x32,0x21,0x00,0x21,0x13,0x13,0x21,
+	0x00,0x00,0x32,0x12,0x4c,0x00,0x10,0xc0,0x03,0x03,0x63,0x13,0x61,0x10,0x00,0x11,
+	0x12,0x51,0x10,0x00,0x11,0x22,0x41,0x11,0x13,0x23,0x11,0x00,0x01,0x14,0x22,0x11,
+	0x00,0x01,0x15,0x21,0x11,0x11,0x63,0x10,0x00,0x11,0x72,0x10,0x00,0x03,0x71,0x1c,
+	0x00,0x10,0xc0,0x03,0x44,0x43,0x22,0x23,0x22,0x42,0x22,0x25,0x12,0x12,0x62,0x10,
+	0x06,0x22,0x51,0x22,0x24,0x22,0x32,0x22,0x34,0x44,0xc0,0x01,0xc0,0x03,0x09,0x31,
+	0x25,0x22,0x12,0x62,0x10,0x03,0x12,0x52,0x21,0x83,0x12,0x90,0x04,0x04,0x8c,0x00,
+	0x10,0xc0,0x03,0x44,0x43,0x22,0x23,0x22,0x42,0x22,0x25,0x12,0x12,0x62,0x10,0x05,
+	0x12,0x13,0x22,0x12,0x22,0x12,0x12,0x22,0x33,0x23,0x13,0x23,0x45,0x37,0x41,0x82,
+	0x2c,0xc0,0x03,0x09,0x31,0x25,0x22,0x12,0x62,0x10,0x02,0x12,0x52,0x21,0x74,0x12,
+	0x22,0x51,0x23,0x24,0x00,0x01,0x24,0x23,0x00,0x01,0x25,0x22,0x00,0x00,0x45,0x3c,
+	0x00,0x10,0xc0,0x03,0x35,0x21,0x12,0x24,0x31,0x12,0x71,0x10,0x00,0x12,0x91,0x38,
+	0x24,0x64,0x44,0x64,0x28,0x22,0x92,0x11,0x17,0x21,0x00,0x01,0x26,0x21,0x13,0x42,
+	0x21,0x12,0x53,0xc0,0x01,0xc0,0x03,0x1a,0x11,0x13,0x23,0x11,0x01,0x42,0x41,0x00,
+	0x05,0x25,0x00,0x94,0x44,0xc0,0x01,0xc0,0x03,0x04,0x53,0x12,0x71,0x10,0x0b,0x22,
+	0x51,0x23,0x63,0xc0,0x01,0xc0,0x03,0x05,0x34,0x13,0x52,0x12,0x25,0x12,0x00,0x12,
+	0x24,0x13,0x32,0x31,0x30,0x02,0x42,0x11,0x40,0x01,0x44,0x45,0x25,0x00,0x0c,0x00,
+	0x10,0xc0,0x03,0x04,0x13,0x13,0x12,0x22,0x31,0x10,0x00,0x12,0x22,0x21,0x20,0x00,
+	0x12,0x23,0x11,0x22,0x21,0x31,0x12,0x00,0x02,0x31,0x33,0x00,0x22,0x32,0x23,0x31,
+	0x31,0x40,0x01,0xc0,0x01,0xc0,0x03,0x14,0x24,0x12,0x24,0x22,0x32,0x31,0x30,0x00,
+	0x32,0x21,0x44,0x21,0x14,0x43,0x55,0x25,0x00,0x05,0x34,0x41,0x12,0x44,0x11,0x33,
+	0x32,0x22,0x33,0x13,0x23,0x22,0x42,0x21,0x42,0x41,0xc0,0x01,0xc0,0x03,0x05,0x34,
+	0x13,0x52,0x12,0x25,0x12,0x22,0x41,0x33,0x23,0x13,0x00,0x04,0x21,0x14,0x00,0x04,
+	0x35,0x52,0x50,0x04,0x36,0x3c,0x00,0x10,0xc0,0x03,0x29,0x12,0x15,0x22,0x11,0x53,
+	0x27,0x23,0x63,0x36,0x24,0x00,0x05,0x25,0x00,0x04,0x26,0x00,0x03,0x27,0x32,0x51,
+	0x12,0x35,0x11,0x22,0x51,0x21,0x92,0xc0,0x01,0xc0,0x00,0x56,0x15,0x16,0x00,0xf0,
+	0x01,0x56,0x1c,0xc0,0x02,0x21,0x93,0x18,0x00,0x14,0x17,0x00,0x05,0x16,0x00,0x16,
+	0x15,0x00,0x07,0x14,0x00,0x18,0x13,0x00,0x09,0x12,0x00,0x1a,0x11,0xc0,0x00,0x26,
+	0x47,0x14,0x00,0xf0,0x01,0x26,0x4c,0xc0,0x00,0x53,0x44,0x21,0x23,0x31,0x51,0x2c,
+	0x00,0xf0,0x01,0xc0,0x0f,0x00,0x50,0xc0,0xc0,0x00,0x32,0x75,0x25,0xc0,0x0f,0x00,
+	0x20,0xc0,0x08,0x45,0x32,0x24,0x22,0x00,0x05,0x52,0x33,0x22,0x22,0x24,0x22,0x12,
+	0x52,0x20,0x01,0x13,0x33,0x11,0x25,0x14,0xc0,0x01,0xc0,0x02,0x31,0x81,0x38,0x22,
+	0x80,0x02,0x22,0x23,0x32,0x42,0x22,0x23,0x42,0x12,0x25,0x21,0x00,0x32,0x25,0x12,
+	0x23,0x32,0x22,0x11,0x53,0xc0,0x01,0xc0,0x08,0x44,0x42,0x23,0x23,0x00,0x01,0x24,
+	0x23,0x12,0x90,0x01,0x12,0x61,0x22,0x25,0x12,0x22,0x41,0x34,0x44,0xc0,0x01,0xc0,
+	0x02,0x91,0x27,0x32,0x82,0x20,0x02,0x34,0x12,0x22,0x23,0x32,0x22,0x42,0x21,0x25,
+	0x22,0x00,0x32,0x15,0x22,0x22,0x34,0x13,0x41,0x13,0xc0,0x01,0xc0,0x08,0x54,0x33,
+	0x23,0x22,0x31,0x52,0x12,0x25,0x21,0x29,0x12,0x28,0x00,0x13,0x25,0x11,0x33,0x31,
+	0x25,0x43,0xc0,0x01,0xc0,0x03,0x64,0x25,0x22,0x21,0x42,0x32,0x14,0x26,0x00,0x01,
+	0x92,0x42,0x60,0x07,0x27,0x3c,0x00,0x10,0xc0,0x08,0x44,0x13,0x32,0x22,0x21,0x22,
+	0x42,0x20,0x01,0x32,0x22,0x33,0x54,0x22,0x82,0x55,0x37,0x21,0x26,0x21,0x00,0x01,
+	0x34,0x31,0x36,0x30,0xc0,0x02,0x31,0x81,0x38,0x22,0x80,0x02,0x22,0x14,0x32,0x33,
+	0x22,0x22,0x42,0x20,0x06,0x14,0x24,0x1c,0x00,0x10,0xc0,0x03,0x52,0x50,0x00,0xc0,
+	0x01,0x25,0x55,0x25,0x00,0x72,0x82,0xc0,0x01,0xc0,0x03,0x72,0x30,0x00,0xc0,0x01,
+	0x45,0x37,0x23,0x00,0x92,0x22,0x24,0x25,0x50,0xc0,0x02,0x31,0x81,0x38,0x22,0x80,
+	0x02,0x22,0x24,0x22,0x23,0x14,0x22,0x22,0x42,0x22,0x15,0x22,0x12,0x52,0x55,0x23,
+	0x12,0x42,0x22,0x24,0x22,0x32,0x30,0x00,0x14,0x24,0x1c,0x00,0x10,0xc0,0x02,0x61,
+	0x52,0x55,0x52,0x50,0x0c,0x28,0x2c,0x00,0x10,0xc0,0x08,0x03,0x13,0x13,0x11,0x31,
+	0x31,0x21,0x12,0x22,0x22,0x10,0x06,0x04,0x13,0x13,0xc0,0x01,0xc0,0x08,0x13,0x23,
+	0x32,0x42,0x22,0x22,0x42,0x20,0x06,0x14,0x24,0x1c,0x00,0x10,0xc0,0x08,0x44,0x43,
+	0x22,0x23,0x22,0x42,0x21,0x26,0x21,0x00,0x32,0x24,0x22,0x00,0x04,0x44,0xc0,0x01,
+	0xc0,0x08,0x13,0x14,0x32,0x33,0x22,0x22,0x52,0x10,0x04,0x22,0x42,0x22,0x33,0x22,
+	0x22,0x14,0x32,0x28,0x00,0x01,0x56,0xc0,0x08,0x34,0x21,0x22,0x23,0x32,0x22,0x42,
+	0x21,0x25,0x22,0x00,0x32,0x15,0x22,0x22,0x33,0x23,0x41,0x22,0x82,0x20,0x00,0x65,
+	0x10,0xc0,0x08,0x05,0x24,0x13,0x21,0x12,0x21,0x33,0x63,0x27,0x00,0x50,0x84,0xc0,
+	0x01,0xc0,0x08,0x47,0x13,0x24,0x21,0x22,0x61,0x12,0x28,0x33,0x64,0x53,0x73,0x22,
+	0x16,0x21,0x00,0x02,0x24,0x22,0x27,0x3c,0x00,0x10,0xc0,0x04,0x51,0x60,0x00,0x42,
+	0x60,0x00,0x18,0x34,0x26,0x00,0x54,0x23,0x12,0x00,0x05,0x43,0xc0,0x01,0xc0,0x07,
+	0x31,0x51,0x21,0x33,0x32,0x22,0x42,0x20,0x06,0x23,0x24,0x13,0x41,0x13,0xc0,0x01,
+	0xc0,0x08,0x15,0x24,0x23,0x42,0x13,0x24,0x12,0x00,0x04,0x22,0x13,0x00,0x15,0x34,
+	0x00,0x16,0x15,0xc0,0x01,0xc0,0x08,0x04,0x14,0x12,0x12,0x32,0x21,0x10,0x00,0x12,
+	0x23,0x21,0x12,0x21,0x32,0x11,0x22,0x11,0x13,0x22,0x32,0x32,0x00,0x13,0x14,0x13,
+	0x00,0x0c,0x00,0x10,0xc0,0x08,0x15,0x14,0x13,0x23,0x13,0x32,0x22,0x34,0x21,0x14,
+	0x43,0x55,0x25,0x53,0x44,0x11,0x24,0x32,0x22,0x33,0x13,0x32,0x14,0x15,0x1c,0x00,
+	0x10,0xc0,0x08,0x15,0x14,0x12,0x33,0x13,0x32,0x31,0x30,0x00,0x42,0x11,0x40,0x01,
+	0x52,0x50,0x00,0x61,0x55,0x16,0x00,0x02,0x11,0x17,0x23,0x70,0xc0,0x08,0x28,0x22,
+	0x14,0x23,0x21,0x33,0x36,0x24,0x53,0x45,0x25,0x43,0x54,0x24,0x11,0x33,0x41,0x13,
+	0x24,0x21,0x28,0x2c,0x00,0x10,0xc0,0x00,0x82,0x27,0x23,0x71,0x40,0x05,0x62,0x45,
+	0x16,0x62,0x47,0x14,0x00,0x57,0x23,0x82,0x2c,0x61,0x50,0x0f,0x00,0x60,0xc0,0x00,
+	0x22,0x83,0x27,0x41,0x70,0x05,0x42,0x66,0x15,0x42,0x64,0x17,0x00,0x53,0x27,0x22,
+	0x8c,0xc2,0x37,0x21,0x21,0x61,0x14,0x14,0x11,0x15,0x12,0x11,0x83,0x1c,0x00,0xf0,
+	0x00,
+};
+
+static const uint16_t Ascii16x32_Offset[] = {
+	0,4,24,50,73,137,206,263,282,316,
+	350,393,406,422,429,442,488,523,539,584,
+	626,665,705,752,784,829,874,894,912,952,
+	963,1003,1041,1111,1153,1193,1230,1263,1309,1345,
+	1387,1407,1420,1438,1493,1513,1569,1633,1669,1696,
+	1744,1792,1838,1861,1879,1911,1971,2020,2058,2103,
+	2116,2159,2172,2188,2194,2205,2242,2278,2308,2343,
+	2375,2397,2435,2461,2479,2500,2546,2560,2582,2603,
+	2629,2663,2694,2718,2752,2776,2798,2831,2870,2907,
+	2942,2975,2995,3000,3020,
+};
+
+static const uint8_t Ascii16x32_Rle[] = {
+	0xf1,0x00,0xf0,0x0e,0xf1,0x00,0x36,0x37,0x00,0x57,0x18,0x00,0x5f,0x10,0x02,0x72,
+	0x76,0x46,0x00,0x07,0x27,0xf1,0x00,0x30,0xf1,0x00,0x15,0x32,0x33,0x00,0x04,0x41,
+	0x43,0x43,0x23,0x43,0x32,0x35,0x32,0x32,0x63,0x14,0x17,0x21,0x41,0x8f,0x10,0x0f,
+	0x00,0x30,0xf1,0x00,0x45,0x16,0x13,0x00,0x31,0xe1,0x00,0x04,0x16,0x14,0x00,0x51,
+	0xe1,0x00,0x03,0x16,0x15,0x00,0x3f,0x10,0x03,0xf1,0x00,0x28,0x17,0x00,0x06,0x55,
+	0x52,0x11,0x22,0x34,0x13,0x13,0x22,0x32,0x31,0x32,0x23,0x23,0x12,0x32,0x00,0x03,
+	0x32,0x17,0x43,0x11,0x75,0x47,0x64,0x67,0x45,0x84,0x48,0x11,0x33,0x81,0x23,0x28,
+	0x13,0x22,0x23,0x31,0x32,0x20,0x00,0x22,0x41,0x32,0x22,0x24,0x13,0x13,0x32,0x31,
+	0x12,0x45,0x65,0x81,0x70,0x01,0xf1,0x00,0x00,0xf1,0x00,0x42,0x37,0x13,0x12,0x12,
+	0x52,0x30,0x23,0x24,0x14,0x02,0x32,0x32,0x40,0x23,0x23,0x15,0x00,0x00,0x23,0x22,
+	0x16,0x00,0x00,0x23,0x21,0x17,0x12,0x12,0x21,0x13,0x32,0x32,0x41,0x22,0x71,0x11,
+	0x31,0x27,0x33,0x21,0x61,0x12,0x32,0x10,0x00,0x51,0x22,0x32,0x10,0x00,0x42,0x22,
+	0x32,0x14,0x14,0x13,0x12,0x32,0x42,0x12,0x23,0x16,0x33,0xf1,0x00,0x30,0xf1,0x00,
+	0x44,0x48,0x32,0x22,0x72,0x23,0x27,0x00,0x22,0x23,0x18,0x22,0x22,0x83,0x49,0x32,
+	0x45,0x22,0x36,0x14,0x12,0x12,0x51,0x41,0x12,0x25,0x14,0x02,0x32,0x31,0x50,0x00,
+	0x02,0x42,0x21,0x50,0x24,0x46,0x02,0x53,0x41,0x11,0x25,0x24,0x11,0x13,0x31,0x12,
+	0x21,0x23,0x43,0x33,0xf1,0x00,0x30,0xf1,0x00,0x12,0x3b,0x24,0xa0,0x00,0x42,0xa0,
+	0x00,0x41,0xb2,0x2c,0x12,0xdf,0x10,0x0f,0x00,0x30,0xf1,0x00,0x1e,0x11,0xd1,0x2c,
+	0x13,0xb1,0x4a,0x24,0xa1,0x59,0x25,0x82,0x60,0x01,0x72,0x70,0x06,0x82,0x60,0x01,
+	0x92,0x50,0x00,0xa2,0x4b,0x14,0xc1,0x3d,0x12,0xe1,0x1f,0x10,0xf1,0x00,0x11,0x1e,
+	0x21,0xd3,0x1c,0x41,0xb4,0x2a,0x51,0xa5,0x29,0x62,0x80,0x01,0x72,0x70,0x06,0x62,
+	0x80,0x01,0x52,0x90,0x00,0x42,0xa4,0x1b,0x31,0xc2,0x1d,0x11,0xef,0x10,0xf1,0x00,
+	0x68,0x17,0x73,0x60,0x00,0x81,0x72,0x33,0x13,0x31,0x24,0x21,0x24,0x13,0x41,0x11,
+	0x42,0x65,0x58,0x17,0x65,0x53,0x41,0x11,0x42,0x24,0x21,0x24,0x12,0x33,0x13,0x31,
+	0x81,0x77,0x36,0x00,0x07,0x27,0xf1,0x00,0x50,0xf1,0x00,0x78,0x17,0x00,0x52,0xd1,
+	0x81,0x70,0x05,0xf1,0x00,0x60,0xf1,0x00,0xf0,0x06,0x23,0xb2,0x4a,0x00,0x04,0x2a,
+	0x00,0x04,0x1b,0x22,0xc1,0x2d,0xf1,0x00,0xe1,0xe1,0xf1,0x00,0xd0,0xf1,0x00,0xf0,
+	0x05,0x32,0xb2,0x4a,0x00,0x03,0x2b,0xf1,0x00,0x30,0xf1,0x00,0x1e,0x11,0xd2,0x1d,
+	0x12,0xc2,0x2c,0x13,0xb2,0x3b,0x14,0xa2,0x4a,0x15,0x92,0x59,0x16,0x82,0x68,0x17,
+	0x72,0x77,0x18,0x62,0x86,0x19,0x52,0x95,0x1a,0x42,0xa4,0x1b,0x32,0xb3,0x1c,0x22,
+	0xc2,0x1d,0x12,0xd1,0x1e,0xf1,0x00,0x00,0xf1,0x00,0x46,0x55,0x52,0x32,0x44,0x25,
+	0x23,0x32,0x72,0x20,0x00,0x32,0x81,0x22,0x29,0x21,0x00,0x73,0x28,0x12,0x32,0x72,
+	0x20,0x00,0x42,0x52,0x35,0x23,0x24,0x65,0x5f,0x10,0x03,0xf1,0x00,0x48,0x17,0x72,
+	0x73,0x67,0x72,0x70,0x0e,0x64,0x63,0xa3,0xf1,0x00,0x30,0xf1,0x00,0x45,0x65,0x41,
+	0x53,0x33,0x17,0x23,0x21,0x92,0x20,0x00,0x22,0x82,0x20,0x00,0xc2,0x2b,0x23,0xb1,
+	0x4a,0x15,0x91,0x68,0x17,0x71,0x86,0x19,0x51,0x71,0x24,0x18,0x12,0x31,0x91,0x22,
+	0x19,0x22,0x2b,0x30,0x00,0xf1,0x00,0x30,0xf1,0x00,0x45,0x56,0x32,0x43,0x42,0x26,
+	0x24,0x22,0x72,0x30,0x01,0xb2,0x3a,0x24,0x92,0x56,0x46,0x93,0x4b,0x23,0xc1,0x3c,
+	0x22,0x00,0x02,0x28,0x22,0x00,0x02,0x28,0x13,0x22,0x72,0x33,0x25,0x24,0x55,0x6f,
+	0x10,0x03,0xf1,0x00,0x4a,0x24,0x93,0x40,0x00,0x84,0x47,0x11,0x34,0x00,0x06,0x12,
+	0x34,0x52,0x23,0x45,0x13,0x34,0x41,0x43,0x40,0x00,0x31,0x53,0x42,0x16,0x34,0x00,
+	0x01,0xe1,0x93,0x40,0x04,0x69,0x1f,0x10,0x02,0xf1,0x00,0x44,0xa2,0x00,0x04,0x1b,
+	0x00,0x13,0x1c,0x00,0x03,0x12,0x55,0x31,0x11,0x42,0x43,0x26,0x23,0x31,0x81,0x3c,
+	0x22,0x00,0x22,0x28,0x22,0x00,0x02,0x18,0x23,0x00,0x03,0x16,0x24,0x46,0x6f,0x10,
+	0x03,0xf1,0x00,0x47,0x54,0x62,0x41,0x35,0x16,0x22,0x41,0x72,0x23,0x2b,0x00,0x03,
+	0x1c,0x22,0xc2,0x23,0x54,0x22,0x12,0x42,0x32,0x46,0x22,0x23,0x82,0x12,0x29,0x21,
+	0x00,0x23,0x28,0x21,0x32,0x81,0x24,0x26,0x22,0x52,0x42,0x36,0x55,0xf1,0x00,0x30,
+	0xf1,0x00,0x43,0xb2,0x00,0x02,0x37,0x13,0x22,0x71,0x42,0x18,0x14,0x21,0x71,0x5a,
+	0x15,0x91,0x60,0x00,0x81,0x70,0x01,0x71,0x80,0x01,0x62,0x80,0x04,0xf1,0x00,0x30,
+	0xf1,0x00,0x45,0x65,0x42,0x42,0x43,0x26,0x23,0x22,0x82,0x20,0x01,0x23,0x72,0x23,
+	0x35,0x23,0x43,0x41,0x45,0x65,0x42,0x14,0x53,0x24,0x34,0x22,0x63,0x31,0x28,0x32,
+	0x12,0x92,0x20,0x02,0x22,0x72,0x33,0x25,0x24,0x55,0x6f,0x10,0x03,0xf1,0x00,0x45,
+	0x56,0x32,0x51,0x52,0x27,0x14,0x22,0x72,0x31,0x29,0x13,0x12,0x92,0x20,0x02,0x12,
+	0x83,0x22,0x26,0x42,0x32,0x42,0x12,0x24,0x53,0x22,0xc2,0x2b,0x23,0x00,0x12,0x26,
+	0x24,0x22,0x52,0x52,0x24,0x26,0x45,0x7f,0x10,0x03,0xf1,0x00,0xb7,0x27,0x64,0x60,
+	0x00,0x72,0x7f,0x10,0x04,0x72,0x76,0x46,0x00,0x07,0x27,0xf1,0x00,0x30,0xf1,0x00,
+	0xb6,0x28,0x00,0x0f,0x10,0x08,0x62,0x80,0x00,0x71,0x80,0x00,0x61,0x90,0x00,0xf1,
+	0xf1,0x00,0x3d,0x12,0xc1,0x3b,0x14,0xa1,0x59,0x25,0x82,0x67,0x27,0x62,0x85,0x29,
+	0x42,0xa3,0x2b,0x22,0xc3,0x2b,0x42,0xa5,0x29,0x62,0x87,0x27,0x82,0x69,0x25,0xa1,
+	0x5b,0x14,0xc1,0x3d,0x12,0xf1,0x00,0x20,0xf1,0x00,0xb1,0xe1,0xf1,0x00,0x31,0xe1,
+	0xf1,0x00,0xa0,0xf1,0x00,0x32,0x1d,0x31,0xc4,0x1b,0x51,0xa5,0x29,0x62,0x87,0x27,
+	0x82,0x69,0x25,0xa2,0x4b,0x23,0xc2,0x2b,0x23,0xa2,0x49,0x25,0x82,0x67,0x27,0x62,
+	0x85,0x29,0x51,0xa4,0x1b,0x31,0xc2,0x1d,0xf1,0x00,0x20,0xf1,0x00,0x36,0x55,0x42,
+	0x52,0x33,0x18,0x22,0x31,0x92,0x12,0x29,0x21,0x23,0x82,0x10,0x01,0xc2,0x2a,0x33,
+	0x92,0x58,0x17,0x71,0x80,0x02,0xf1,0x00,0x07,0x27,0x64,0x60,0x00,0x72,0x7f,0x10,
+	0x03,0xf1,0x00,0x46,0x55,0x52,0x42,0x34,0x17,0x22,0x32,0x81,0x22,0x24,0x41,0x12,
+	0x22,0x32,0x12,0x21,0x11,0x24,0x12,0x22,0x11,0x12,0x32,0x22,0x21,0x10,0x00,0x12,
+	0x22,0x32,0x21,0x11,0x22,0x23,0x13,0x11,0x00,0x01,0x22,0x22,0x22,0x12,0x00,0x01,
+	0x22,0x21,0x11,0x11,0x13,0x22,0x22,0x23,0x32,0x2a,0x11,0x31,0x91,0x23,0x27,0x22,
+	0x42,0x52,0x36,0x55,0xf1,0x00,0x30,0xf1,0x00,0x38,0x17,0x63,0x70,0x01,0x61,0x11,
+	0x75,0x21,0x26,0x51,0x22,0x60,0x01,0x42,0x32,0x54,0x14,0x25,0x00,0x13,0x94,0x31,
+	0x62,0x40,0x01,0x22,0x62,0x42,0x18,0x23,0x00,0x01,0x28,0x23,0x05,0x55,0x1f,0x10,
+	0x03,0xf1,0x00,0x41,0xa5,0x32,0x53,0x33,0x26,0x32,0x32,0x72,0x20,0x02,0x32,0x62,
+	0x33,0x25,0x24,0x38,0x53,0x26,0x23,0x32,0x72,0x23,0x28,0x12,0x32,0x82,0x10,0x03,
+	0x32,0x72,0x23,0x26,0x23,0x1b,0x4f,0x10,0x03,0xf1,0x00,0x46,0x52,0x12,0x52,0x43,
+	0x24,0x17,0x22,0x32,0x81,0x22,0x2a,0x11,0x00,0x02,0x1d,0x12,0xd0,0x06,0x22,0xa1,
+	0x10,0x00,0x22,0x91,0x23,0x27,0x22,0x42,0x52,0x36,0x55,0xf1,0x00,0x30,0xf1,0x00,
+	0x41,0x96,0x32,0x43,0x43,0x26,0x23,0x32,0x72,0x20,0x01,0x32,0x82,0x10,0x07,0x32,
+	0x72,0x20,0x00,0x32,0x71,0x33,0x26,0x23,0x32,0x43,0x41,0x96,0xf1,0x00,0x30,0xf1,
+	0x00,0x41,0xd2,0x32,0x72,0x23,0x28,0x12,0x32,0x82,0x13,0x29,0x11,0x32,0xb3,0x26,
+	0x14,0x00,0x03,0x25,0x24,0x39,0x43,0x25,0x24,0x32,0x61,0x40,0x00,0x32,0xb0,0x01,
+	0x32,0x91,0x10,0x00,0x32,0x81,0x23,0x27,0x22,0x1d,0x2f,0x10,0x03,0xf1,0x00,0x41,
+	0xe1,0x32,0x73,0x13,0x29,0x11,0x32,0x92,0x32,0xa1,0x32,0xb3,0x27,0x13,0x00,0x03,
+	0x26,0x23,0x3a,0x33,0x26,0x23,0x32,0x71,0x30,0x00,0x32,0xb0,0x05,0x16,0x9f,0x10,
+	0x03,0xf1,0x00,0x46,0x42,0x13,0x43,0x33,0x34,0x17,0x13,0x32,0x71,0x32,0x29,0x12,
+	0x00,0x02,0x1d,0x12,0xd0,0x03,0x12,0x76,0x12,0x92,0x20,0x00,0x22,0x82,0x20,0x00,
+	0x32,0x72,0x20,0x00,0x42,0x51,0x46,0x55,0xf1,0x00,0x30,0xf1,0x00,0x40,0x63,0x61,
+	0x22,0x72,0x30,0x07,0x2b,0x32,0x27,0x23,0x00,0x70,0x63,0x61,0xf1,0x00,0x30,0xf1,
+	0x00,0x43,0xa3,0x72,0x70,0x0f,0x00,0x13,0xa3,0xf1,0x00,0x30,0xf1,0x00,0x45,0xa1,
+	0x92,0x50,0x0f,0x00,0x31,0x35,0x25,0x13,0x42,0x61,0x33,0x27,0x26,0x80,0xf1,0x00,
+	0x41,0x63,0x51,0x32,0x62,0x33,0x26,0x14,0x32,0x51,0x53,0x24,0x25,0x32,0x41,0x63,
+	0x23,0x17,0x32,0x22,0x70,0x00,0x32,0x13,0x73,0x31,0x36,0x33,0x22,0x63,0x23,0x35,
+	0x32,0x42,0x53,0x24,0x34,0x32,0x52,0x43,0x25,0x33,0x32,0x62,0x33,0x27,0x22,0x00,
+	0x01,0x63,0x6f,0x10,0x03,0xf1,0x00,0x41,0x69,0x32,0xb0,0x0d,0x32,0x91,0x10,0x00,
+	0x32,0x81,0x23,0x27,0x22,0x1d,0x2f,0x10,0x03,0xf1,0x00,0x40,0x56,0x52,0x36,0x32,
+	0x00,0x12,0x35,0x42,0x21,0x12,0x41,0x12,0x20,0x01,0x21,0x12,0x32,0x12,0x22,0x11,
+	0x32,0x12,0x22,0x21,0x22,0x21,0x22,0x20,0x01,0x21,0x22,0x11,0x32,0x22,0x13,0x33,
+	0x22,0x00,0x12,0x13,0x24,0x22,0x00,0x02,0x14,0x14,0x22,0x05,0x21,0x26,0xf1,0x00,
+	0x30,0xf1,0x00,0x40,0x55,0x51,0x23,0x71,0x32,0x46,0x13,0x21,0x12,0x61,0x30,0x00,
+	0x21,0x13,0x51,0x32,0x12,0x25,0x13,0x21,0x23,0x41,0x32,0x13,0x24,0x13,0x21,0x33,
+	0x31,0x32,0x14,0x23,0x13,0x21,0x43,0x21,0x32,0x15,0x22,0x13,0x21,0x53,0x11,0x32,
+	0x16,0x21,0x13,0x21,0x64,0x32,0x17,0x33,0x00,0x12,0x18,0x23,0x05,0x62,0x3f,0x10,
+	0x03,0xf1,0x00,0x46,0x46,0x42,0x42,0x43,0x26,0x23,0x31,0x81,0x32,0x28,0x22,0x00,
+	0x01,0x2a,0x21,0x00,0x72,0x29,0x12,0x22,0x82,0x23,0x18,0x13,0x32,0x62,0x34,0x24,
+	0x24,0x64,0x6f,0x10,0x03,0xf1,0x00,0x41,0xb4,0x32,0x62,0x33,0x27,0x22,0x32,0x82,
+	0x10,0x03,0x32,0x72,0x23,0x26,0x23,0x39,0x43,0x2b,0x00,0x71,0x69,0xf1,0x00,0x30,
+	0xf1,0x00,0x46,0x46,0x42,0x42,0x43,0x26,0x23,0x22,0x81,0x32,0x28,0x22,0x22,0x91,
+	0x21,0x2a,0x21,0x00,0x72,0x12,0x44,0x21,0x22,0x11,0x22,0x22,0x22,0x34,0x12,0x22,
+	0x32,0x42,0x11,0x34,0x23,0x34,0x65,0x5a,0x22,0x11,0xa5,0x1b,0x32,0xf1,0x00,0x00,
+	0xf1,0x00,0x41,0xa5,0x32,0x53,0x33,0x26,0x32,0x32,0x72,0x20,0x02,0x32,0x62,0x33,
+	0x25,0x24,0x38,0x53,0x22,0x36,0x32,0x32,0x63,0x23,0x35,0x32,0x42,0x50,0x00,0x32,
+	0x43,0x43,0x25,0x24,0x00,0x03,0x25,0x33,0x32,0x62,0x31,0x64,0x41,0xf1,0x00,0x30,
+	0xf1,0x00,0x45,0x62,0x12,0x42,0x53,0x23,0x27,0x22,0x22,0x91,0x20,0x00,0x22,0xc0,
+	0x00,0x32,0xb3,0x49,0x55,0x67,0x54,0x94,0x3b,0x32,0xc3,0x1d,0x21,0x21,0xa2,0x10,
+	0x00,0x31,0x92,0x13,0x27,0x22,0x33,0x52,0x33,0x12,0x64,0xf1,0x00,0x30,0xf1,0x00,
+	0x42,0xc2,0x22,0x32,0x41,0x22,0x14,0x24,0x21,0x11,0x52,0x51,0x10,0x00,0x72,0x70,
+	0x0d,0x56,0x5f,0x10,0x03,0xf1,0x00,0x40,0x64,0x51,0x22,0x81,0x30,0x0f,0x31,0x71,
+	0x43,0x34,0x15,0x55,0x6f,0x10,0x03,0xf1,0x00,0x41,0x55,0x53,0x28,0x12,0x00,0x14,
+	0x26,0x13,0x00,0x25,0x24,0x14,0x00,0x15,0x32,0x24,0x62,0x21,0x50,0x01,0x73,0x60,
+	0x02,0x81,0x70,0x00,0xf1,0x00,0x30,0xf1,0x00,0x40,0x51,0x42,0x41,0x24,0x24,0x21,
+	0x12,0x42,0x41,0x20,0x00,0x22,0x32,0x41,0x22,0x24,0x14,0x12,0x22,0x33,0x31,0x22,
+	0x23,0x32,0x13,0x00,0x12,0x22,0x11,0x22,0x13,0x32,0x11,0x21,0x21,0x33,0x21,0x12,
+	0x21,0x13,0x32,0x11,0x23,0x43,0x33,0x34,0x00,0x14,0x24,0x24,0x41,0x51,0x50,0x01,
+	0xf1,0x00,0x30,0xf1,0x00,0x41,0x62,0x52,0x32,0x61,0x43,0x35,0x14,0x42,0x41,0x50,
+	0x00,0x43,0x21,0x65,0x22,0x16,0x54,0x76,0x37,0x00,0x07,0x27,0x73,0x66,0x11,0x26,
+	0x61,0x13,0x55,0x13,0x25,0x00,0x04,0x15,0x24,0x00,0x03,0x17,0x23,0x00,0x01,0x54,
+	0x51,0xf1,0x00,0x30,0xf1,0x00,0x41,0x63,0x51,0x23,0x71,0x33,0x27,0x13,0x32,0x61,
+	0x44,0x25,0x14,0x42,0x42,0x44,0x33,0x15,0x52,0x31,0x55,0x22,0x16,0x62,0x11,0x60,
+	0x00,0x63,0x77,0x27,0x00,0x65,0x65,0xf1,0x00,0x30,0xf1,0x00,0x43,0xb2,0x32,0x62,
+	0x33,0x17,0x23,0x21,0x72,0x42,0x16,0x34,0x92,0x58,0x35,0x82,0x67,0x36,0x72,0x76,
+	0x37,0x62,0x85,0x38,0x52,0x94,0x39,0x42,0xa3,0x37,0x12,0x32,0x81,0x22,0x37,0x13,
+	0x22,0x72,0x31,0xc3,0xf1,0x00,0x30,0xf1,0x00,0x16,0x82,0x61,0x90,0x0f,0x00,0x76,
+	0x82,0xf1,0x00,0x00,0xf1,0x00,0x33,0x1c,0x32,0xb0,0x00,0x41,0xb4,0x2a,0x51,0xa5,
+	0x29,0x00,0x06,0x19,0x62,0x87,0x18,0x72,0x70,0x00,0x81,0x78,0x26,0x91,0x69,0x25,
+	0x00,0x0a,0x15,0xa2,0x4b,0x14,0xb2,0x30,0x00,0xc1,0x3c,0x22,0xd1,0x2f,0x10,0xf1,
+	0x00,0x12,0x86,0x91,0x60,0x0f,0x00,0x72,0x86,0xf1,0x00,0x00,0xf1,0x00,0x17,0x45,
+	0x62,0x12,0x55,0x15,0x14,0x41,0x71,0x3f,0x10,0x0f,0x00,0x70,0xf1,0x00,0xf0,0x0d,
+	0x0f,0x10,0xf1,0x00,0x13,0x49,0x62,0x88,0x17,0xf1,0x00,0xf0,0x08,0xf1,0x00,0xb4,
+	0x66,0x32,0x42,0x52,0x26,0x24,0x00,0x0a,0x24,0x75,0x44,0x33,0x24,0x23,0x52,0x42,
+	0x26,0x24,0x12,0x72,0x40,0x00,0x12,0x72,0x21,0x12,0x24,0x42,0x11,0x35,0x33,0x2f,
+	0x10,0x03,0xf1,0x00,0x34,0x1b,0x14,0xb3,0x2b,0x00,0x43,0x23,0x44,0x32,0x12,0x32,
+	0x33,0x36,0x22,0x33,0x72,0x13,0x28,0x21,0x00,0x43,0x28,0x12,0x33,0x62,0x23,0x44,
+	0x23,0x31,0x25,0x5f,0x10,0x03,0xf1,0x00,0xb6,0x55,0x43,0x32,0x43,0x26,0x23,0x00,
+	0x02,0x27,0x23,0x22,0xc0,0x02,0x22,0x91,0x23,0x28,0x12,0x32,0x71,0x34,0x25,0x14,
+	0x65,0x5f,0x10,0x03,0xf1,0x00,0x3c,0x13,0x94,0x3b,0x23,0x00,0x45,0x51,0x23,0x42,
+	0x43,0x33,0x26,0x23,0x00,0x02,0x27,0x23,0x00,0x43,0x17,0x23,0x32,0x53,0x34,0x23,
+	0x11,0x41,0x54,0x21,0x4f,0x10,0x03,0xf1,0x00,0xb6,0x55,0x42,0x42,0x43,0x26,0x23,
+	0x31,0x81,0x32,0x28,0x22,0x00,0x02,0xc2,0x22,0xc0,0x01,0x32,0x81,0x23,0x27,0x13,
+	0x43,0x42,0x36,0x55,0xf1,0x00,0x30,0xf1,0x00,0x49,0x52,0x73,0x42,0x71,0x62,0x62,
+	0x62,0x62,0x80,0x01,0x2b,0x36,0x28,0x00,0xa3,0x94,0xf1,0x00,0x30,0xf1,0x00,0xb6,
+	0x51,0x31,0x42,0x42,0x12,0x14,0x16,0x23,0x32,0x62,0x30,0x01,0x41,0x62,0x34,0x24,
+	0x24,0x47,0x53,0x2b,0x00,0x04,0x84,0x4a,0x23,0x18,0x31,0x22,0x92,0x10,0x01,0x33,
+	0x53,0x25,0x74,0xf1,0x00,0x34,0x1b,0x14,0xb3,0x2b,0x00,0x43,0x22,0x54,0x32,0x12,
+	0x32,0x33,0x36,0x22,0x32,0x72,0x20,0x08,0x16,0x36,0xf1,0x00,0x30,0xf1,0x00,0x47,
+	0x36,0x00,0x1f,0x10,0x01,0x81,0x73,0x67,0x72,0x70,0x0a,0x3a,0x3f,0x10,0x03,0xf1,
+	0x00,0x4b,0x32,0x00,0x1f,0x10,0x01,0xc1,0x37,0x63,0xb2,0x30,0x0d,0x32,0x52,0x43,
+	0x24,0x25,0x46,0x60,0xf1,0x00,0x34,0x1b,0x14,0xb3,0x2b,0x00,0x43,0x24,0x52,0x32,
+	0x52,0x43,0x24,0x25,0x32,0x32,0x63,0x23,0x17,0x32,0x22,0x73,0x21,0x37,0x33,0x22,
+	0x63,0x23,0x35,0x32,0x42,0x53,0x25,0x24,0x32,0x53,0x33,0x26,0x23,0x16,0x35,0x1f,
+	0x10,0x03,0xf1,0x00,0x38,0x17,0x36,0x77,0x27,0x00,0xf0,0x01,0x3a,0x3f,0x10,0x03,
+	0xf1,0x00,0xa3,0x1c,0x13,0x13,0x23,0x32,0x32,0x32,0x22,0x22,0x32,0x32,0x20,0x09,
+	0x14,0x14,0x14,0x1f,0x10,0x03,0xf1,0x00,0xa4,0x1b,0x14,0x34,0x43,0x21,0x23,0x23,
+	0x33,0x62,0x23,0x27,0x22,0x00,0x81,0x63,0x6f,0x10,0x03,0xf1,0x00,0xb6,0x55,0x43,
+	0x33,0x34,0x17,0x22,0x32,0x72,0x22,0x29,0x21,0x00,0x43,0x27,0x22,0x00,0x04,0x25,
+	0x23,0x65,0x5f,0x10,0x03,0xf1,0x00,0xa4,0x1b,0x14,0x25,0x43,0x21,0x14,0x23,0x33,
+	0x62,0x23,0x28,0x12,0x32,0x82,0x10,0x04,0x32,0x72,0x23,0x36,0x22,0x34,0x42,0x33,
+	0x22,0x45,0x32,0xb0,0x02,0x16,0x90,0xf1,0x00,0xb6,0x43,0x12,0x42,0x44,0x23,0x26,
+	0x32,0x32,0x72,0x22,0x28,0x22,0x00,0x43,0x18,0x22,0x32,0x63,0x24,0x24,0x42,0x55,
+	0x22,0x2c,0x22,0x00,0x2a,0x60,0xf1,0x00,0xa5,0x29,0x16,0x34,0x25,0x22,0x22,0x21,
+	0x52,0x11,0x42,0x15,0x38,0x00,0x05,0x29,0x00,0x61,0xa5,0xf1,0x00,0x30,0xf1,0x00,
+	0xb5,0x62,0x12,0x42,0x53,0x23,0x27,0x22,0x32,0x81,0x23,0x2b,0x43,0x95,0x56,0x75,
+	0x4a,0x33,0x21,0x92,0x20,0x00,0x22,0x82,0x22,0x36,0x23,0x22,0x17,0x4f,0x10,0x03,
+	0xf1,0x00,0x67,0x18,0x00,0x16,0x28,0x53,0x82,0xb3,0x62,0x80,0x07,0x62,0x51,0x20,
+	0x00,0x72,0x31,0x38,0x44,0xf1,0x00,0x30,0xf1,0x00,0xa4,0x18,0x12,0x14,0x54,0x23,
+	0x27,0x22,0x00,0x83,0x26,0x32,0x42,0x41,0x14,0x55,0x21,0x3f,0x10,0x03,0xf1,0x00,
+	0xb1,0x63,0x42,0x32,0x62,0x33,0x26,0x14,0x33,0x51,0x44,0x24,0x15,0x00,0x04,0x32,
+	0x16,0x52,0x21,0x60,0x00,0x54,0x76,0x37,0x00,0x06,0x28,0x71,0x8f,0x10,0x03,0xf1,
+	0x00,0xb0,0x51,0x51,0x41,0x33,0x33,0x21,0x22,0x42,0x31,0x22,0x23,0x33,0x12,0x00,
+	0x03,0x22,0x32,0x13,0x00,0x03,0x21,0x12,0x21,0x13,0x00,0x04,0x32,0x34,0x00,0x15,
+	0x14,0x15,0x00,0x0f,0x10,0x03,0xf1,0x00,0xb2,0x61,0x52,0x43,0x41,0x44,0x33,0x15,
+	0x53,0x21,0x56,0x21,0x16,0x63,0x77,0x36,0x00,0x06,0x11,0x35,0x52,0x22,0x55,0x14,
+	0x24,0x41,0x52,0x43,0x26,0x23,0x15,0x36,0x1f,0x10,0x03,0xf1,0x00,0xb1,0x63,0x51,
+	0x32,0x62,0x33,0x26,0x14,0x42,0x51,0x40,0x00,0x42,0x41,0x55,0x23,0x15,0x00,0x06,
+	0x21,0x16,0x00,0x17,0x27,0x00,0x17,0x18,0x00,0x12,0x22,0x19,0x24,0xa0,0xf1,0x00,
+	0xb2,0xb3,0x22,0x62,0x42,0x16,0x34,0x21,0x62,0x58,0x26,0x73,0x67,0x27,0x62,0x85,
+	0x38,0x43,0x61,0x24,0x27,0x12,0x33,0x62,0x22,0x36,0x23,0x2b,0x3f,0x10,0x03,0xf1,
+	0x00,0x1c,0x22,0xb1,0x4a,0x15,0x00,0x89,0x16,0x72,0x79,0x16,0xa1,0x50,0x09,0xb1,
+	0x4c,0x22,0xf1,0x81,0x70,0x0f,0x00,0xe0,0xf1,0x00,0x12,0x2c,0x41,0xb5,0x1a,0x00,
+	0x86,0x19,0x72,0x76,0x19,0x51,0xa0,0x09,0x41,0xb2,0x2c,0xf1,0xf1,0x33,0xa2,0x13,
+	0x28,0x12,0x41,0x61,0x11,0x16,0x14,0x21,0x91,0x31,0x2a,0x33,0xf1,0x00,0xf0,0x07,
+};
+
+static const uint16_t GB_16_Offset[] = {
+	0,
+};
+
+static const uint8_t GB_16_Rle[] = {
+	0xf1,0x00,0xe0,
+};
+
+static const sHZINDEX GB_16_Index[] = {
+	{0xffff, 0},
+};
+#define GB_16_COUNT 0
+
+static const uint16_t GB_20_Offset[] = {
+	0,
+};
+
+static const uint8_t GB_20_Rle[] = {
+	0xf5,0x00,0xf0,0x02,
+};
+
+static const sHZINDEX GB_20_Index[] = {
+	{0xffff, 0},
+};
+#define GB_20_COUNT 0
+
+static const uint16_t GB_24_Offset[] = {
+	0,
+};
+
+static const uint8_t GB_24_Rle[] = {
+	0xf9,0x00,0xf0,0x06,
+};
+
+static const sHZINDEX GB_24_Index[] = {
+	{0xffff, 0},
+};
+#define GB_24_COUNT 0
+
+static const uint16_t GB_32_Offset[] = {
+	0,5,62,74,190,263,404,472,545,642,
+	725,766,870,916,1021,1123,1193,1308,1383,1469,
+	1553,1641,1722,1832,1883,1952,2070,2142,2207,2296,
+	2385,2464,2598,2677,2748,2852,2902,2989,3067,3138,
+	3185,3297,3364,3437,3504,3608,3695,3792,3860,3982,
+	4061,4138,4214,4266,4346,4456,4533,4624,4691,4745,
+	4829,4918,4946,5005,5107,5199,5236,5307,5402,5527,
+	5635,5729,5799,5909,6017,6108,6192,6274,
+};
+
+static const uint8_t GB_32_Rle[] = {
+	0xff,0x20,0x0f,0x00,0xe0,0xff,0x20,0x01,0xfb,0x24,0xfa,0x43,0x3f,0x77,0xf0,0x2f,
+	0x00,0x01,0x72,0x62,0x62,0x77,0x11,0xf1,0x77,0x17,0x26,0x27,0x00,0x27,0xf3,0x77,
+	0x17,0x26,0x27,0x00,0x17,0x17,0x26,0x22,0x23,0x71,0x72,0x62,0x14,0x23,0xc2,0x96,
+	0x71,0xf0,0x27,0x00,0x47,0x1b,0x67,0x71,0xd3,0x87,0x1e,0x19,0xff,0x20,0xff,0x20,
+	0x0b,0xfd,0x13,0xfc,0x32,0x2f,0xa5,0xff,0x20,0x0e,0xff,0x20,0x00,0xf0,0x18,0x17,
+	0x62,0x82,0x62,0x66,0x29,0x24,0x27,0x62,0x92,0x41,0x86,0x24,0x14,0x23,0x19,0x62,
+	0x51,0x71,0x52,0x36,0x25,0x81,0x73,0x62,0x51,0x61,0x62,0x36,0x22,0x12,0x11,0x14,
+	0x13,0x12,0x23,0x2a,0x11,0x21,0x31,0x32,0x12,0x36,0x25,0x12,0x22,0x13,0x11,0x33,
+	0x62,0x51,0x22,0x21,0x21,0x32,0x36,0x25,0x13,0x12,0x11,0x14,0x23,0x62,0x51,0x61,
+	0x62,0x30,0x00,0x62,0x57,0x18,0x36,0x24,0x1d,0x15,0x62,0x61,0xa2,0x56,0x26,0xe4,
+	0x62,0x31,0x22,0x92,0x56,0x53,0x29,0x25,0x44,0x62,0x92,0x52,0x48,0xd5,0x22,0xa2,
+	0x92,0x5e,0x29,0x25,0x00,0x0e,0xd5,0xe2,0x92,0x5e,0x29,0x16,0xff,0x20,0xff,0x20,
+	0x00,0x81,0xf8,0x82,0xf7,0x81,0xf8,0x00,0x28,0x1a,0x17,0x23,0x2e,0x3a,0x38,0x15,
+	0x23,0x17,0x23,0x00,0x47,0x25,0x23,0x17,0x23,0x00,0x27,0x16,0x14,0x17,0x23,0x00,
+	0x06,0x26,0x14,0x17,0x23,0x61,0x71,0x41,0x72,0x35,0x26,0x24,0x17,0x23,0x51,0x72,
+	0x41,0x72,0x34,0x27,0x24,0xa3,0x41,0x36,0x51,0x72,0x33,0x16,0x45,0x17,0x23,0x21,
+	0x81,0x71,0x72,0x32,0x1f,0xef,0xf2,0xff,0x20,0x00,0xf6,0x12,0x17,0xf6,0x31,0x25,
+	0x21,0xf3,0x23,0x24,0x32,0xf1,0x23,0x24,0x33,0xf0,0x24,0x14,0x43,0x31,0xa2,0x42,
+	0x35,0x23,0xf5,0x25,0x14,0x29,0x29,0x81,0x12,0x92,0x97,0x12,0x29,0x29,0x71,0x22,
+	0x62,0x12,0x41,0x47,0x12,0xa1,0x24,0x23,0x61,0x32,0x92,0x33,0x36,0x13,0x29,0x23,
+	0x24,0x51,0x42,0x92,0x32,0x45,0x14,0x12,0x71,0x22,0x25,0x11,0x22,0x41,0x22,0x32,
+	0x12,0x22,0x52,0x34,0x22,0x23,0x13,0x12,0x16,0x32,0x42,0x22,0x31,0x31,0x12,0x63,
+	0x24,0x22,0x23,0x13,0x37,0x32,0x42,0x22,0x32,0x23,0x73,0x24,0x13,0x23,0x22,0x28,
+	0x32,0x32,0x37,0x14,0x41,0x23,0x23,0x14,0x23,0x12,0x12,0x23,0x12,0x32,0x22,0x42,
+	0x51,0x32,0x31,0x27,0x1b,0x15,0x21,0x22,0x61,0xa2,0x74,0x25,0x1a,0x1a,0x32,0x41,
+	0xa1,0xd2,0x1f,0xf2,0xff,0x20,0x00,0xf0,0x1f,0x1f,0x03,0xef,0x02,0xf0,0x00,0x59,
+	0x24,0x24,0x1a,0x93,0x32,0x51,0x99,0x24,0x25,0x28,0x82,0x52,0x62,0x78,0x25,0x27,
+	0x26,0x72,0x62,0x82,0x57,0x17,0x28,0x34,0x62,0x72,0x93,0x35,0x28,0x29,0x33,0x42,
+	0x92,0xa2,0x34,0x1a,0x2a,0x23,0x31,0xb2,0xa2,0x3f,0x02,0xf0,0x00,0x2a,0x14,0x2f,
+	0x0b,0x6f,0x0d,0x4f,0x0e,0x2f,0x1f,0xf2,0xff,0x20,0x00,0xf0,0x1f,0x1f,0x02,0xf0,
+	0xf1,0x2e,0x00,0x07,0x18,0x18,0x16,0x79,0x1a,0x57,0x2f,0x11,0x60,0x03,0x7f,0x46,
+	0x72,0xf1,0x16,0x72,0xf8,0x71,0xf9,0x00,0x07,0x13,0x2b,0x26,0x62,0x3f,0x06,0x62,
+	0x32,0xb2,0x60,0x00,0x61,0x42,0xb2,0x60,0x00,0x52,0x42,0xb2,0x65,0x15,0x2b,0x26,
+	0x42,0x52,0xb2,0x64,0x16,0xf0,0x63,0x17,0x2b,0x26,0x21,0x82,0xb2,0x6f,0xf2,0x00,
+	0x00,0xff,0x20,0x00,0xf5,0x1b,0xf5,0x39,0xf5,0x2a,0x00,0x0c,0x26,0x2a,0x39,0x82,
+	0xaf,0x52,0xaf,0x52,0x51,0x4f,0x1d,0x3f,0x52,0x52,0x3e,0x24,0x25,0x23,0x2c,0x62,
+	0x52,0x37,0x3a,0x25,0x23,0x00,0x07,0x2b,0x16,0x23,0x62,0xc1,0x62,0x36,0x14,0x17,
+	0x26,0x23,0x52,0x51,0x62,0x62,0x35,0x16,0x25,0x26,0x23,0x41,0x82,0x32,0x72,0x33,
+	0x19,0x23,0x27,0x14,0x22,0x27,0x12,0x21,0x81,0x42,0x66,0x21,0x28,0x14,0x31,0xa1,
+	0x12,0x82,0x4f,0x02,0x92,0x4f,0x01,0xa2,0x4e,0x16,0x65,0xc2,0x94,0x5b,0x1c,0x17,
+	0xff,0x20,0xff,0x20,0x00,0xf2,0x1e,0x73,0x82,0xc7,0x29,0x2c,0x72,0xa1,0x71,0x46,
+	0x21,0xf5,0x36,0x2f,0x96,0x16,0x1f,0x35,0x27,0xc6,0x52,0x71,0x91,0x74,0x37,0x19,
+	0x17,0x00,0x04,0x11,0x17,0xb7,0x31,0x21,0x71,0x91,0x72,0x13,0x13,0x1f,0x62,0x13,
+	0x13,0xf4,0x36,0x13,0x1f,0x12,0x36,0x12,0x2f,0x01,0x56,0x12,0x2e,0x16,0x61,0x21,
+	0xe3,0x56,0x15,0xc8,0x61,0xc2,0xb0,0x03,0x52,0xc2,0xb5,0x27,0x23,0x2b,0x52,0x94,
+	0xc5,0x2a,0x3c,0xff,0x20,0xff,0x20,0x01,0xf1,0x1f,0x0f,0x13,0xdf,0x12,0xe0,0x04,
+	0x72,0x72,0xe7,0x36,0x28,0x15,0x72,0x72,0x73,0x47,0x27,0x97,0x72,0x72,0xe0,0x0a,
+	0x72,0x72,0xa1,0x37,0x27,0x29,0x32,0x25,0x27,0x29,0x5f,0xf2,0x00,0x00,0xff,0x20,
+	0x00,0xe2,0xf1,0xf0,0x2f,0x0f,0x03,0x91,0x4f,0x11,0x93,0x33,0xd1,0x96,0xff,0x27,
+	0x22,0x25,0x23,0x27,0x72,0x42,0x22,0x42,0x77,0x26,0x26,0x27,0x72,0x52,0x13,0x32,
+	0x77,0x24,0x23,0x32,0x27,0x72,0x22,0x62,0x22,0x77,0x49,0x12,0x27,0x7f,0x37,0x72,
+	0x62,0x62,0x7f,0x03,0xe4,0x19,0x2a,0x24,0x4f,0x94,0x42,0x72,0xb1,0x54,0x26,0x23,
+	0x18,0x15,0x42,0x61,0x52,0x61,0x54,0x25,0x17,0x34,0x15,0x42,0x3e,0x31,0x54,0x23,
+	0x57,0x23,0x15,0x42,0xf0,0x14,0x15,0x42,0xf5,0x15,0x42,0xf0,0x23,0x15,0x42,0xf2,
+	0x45,0x42,0xf4,0x25,0xff,0x20,0xff,0x20,0x01,0xfa,0x16,0x5f,0x75,0xf8,0x54,0xf7,
+	0x37,0xf6,0x29,0xf5,0x1b,0xf3,0x2c,0xf0,0x3e,0x00,0x0f,0x02,0xf0,0xf0,0x2a,0x14,
+	0xf0,0x29,0x33,0x2f,0xd2,0xf0,0x2f,0x00,0x09,0xa1,0x42,0xf0,0xb6,0xf0,0xd4,0xf0,
+	0xe2,0xf1,0xff,0x20,0xff,0x20,0x00,0xb2,0x71,0xbb,0x27,0x2a,0xb2,0x71,0x71,0x3b,
+	0x27,0x16,0x32,0x4f,0x85,0xb2,0x71,0x22,0x74,0x25,0x16,0x24,0x26,0x52,0xb3,0x31,
+	0x21,0x46,0x23,0xf3,0x36,0x1c,0x1c,0xc1,0x61,0xc2,0x16,0x12,0xf0,0x53,0x23,0x13,
+	0x25,0x15,0x25,0x42,0x21,0x32,0x51,0x52,0x54,0x22,0x13,0xf0,0x57,0x14,0x25,0x15,
+	0x25,0x00,0x06,0x24,0xf0,0x56,0x15,0x25,0x15,0x25,0x52,0x51,0x61,0x32,0x72,0x5f,
+	0x12,0x31,0x34,0x32,0xf6,0x25,0x17,0x19,0x18,0x51,0x82,0x71,0x85,0x19,0x26,0x18,
+	0x43,0x81,0x71,0x84,0x3b,0x13,0x28,0x43,0xc5,0x8f,0x62,0x9f,0xf2,0xff,0x20,0x00,
+	0x91,0xf7,0x93,0x51,0xe8,0x36,0x2d,0x82,0x82,0xc0,0x00,0x72,0xa2,0x41,0x67,0x2a,
+	0x23,0x44,0x71,0x51,0x52,0x33,0x56,0x26,0x19,0x26,0x63,0x51,0x92,0x65,0x45,0x18,
+	0x27,0x51,0x11,0x71,0x72,0x74,0x12,0x17,0x17,0x18,0x41,0x21,0x72,0x52,0x83,0x13,
+	0x18,0x15,0x28,0x21,0x41,0x82,0x32,0x97,0x19,0x13,0x29,0x71,0x92,0x12,0xa7,0x1a,
+	0x11,0x2a,0x71,0xa3,0xb7,0x1b,0x2b,0x71,0xa4,0xa7,0x19,0x22,0x29,0x72,0x72,0x42,
+	0x87,0x26,0x26,0x36,0x72,0x52,0x84,0x47,0x23,0x2b,0x61,0x72,0x22,0xd3,0x37,0x11,
+	0x2f,0x6f,0xf2,0xff,0x20,0x00,0xd1,0xf3,0xd3,0xf1,0xd2,0xf2,0x00,0x0c,0x2d,0x14,
+	0xc2,0xc3,0x33,0xfc,0x2c,0x2f,0x3c,0x1f,0x4b,0x2f,0x40,0x00,0xb1,0xf5,0xa2,0xf5,
+	0x00,0x0a,0x1e,0x25,0x9f,0x44,0x91,0x81,0xd8,0x19,0x1d,0x72,0x91,0xd7,0x1a,0x1d,
+	0x61,0xb1,0xd5,0x2b,0x1d,0x42,0xc1,0xd4,0x1d,0x1d,0x31,0xe1,0xd2,0x1f,0x01,0x91,
+	0x3f,0x31,0x83,0x25,0xd1,0x85,0xff,0x20,0x00,0xff,0x20,0x00,0x71,0xb1,0xc7,0x29,
+	0x4a,0x71,0xa3,0xb0,0x00,0x71,0x92,0x21,0xa7,0x19,0x22,0x29,0x71,0x31,0x42,0x42,
+	0x87,0x12,0x24,0x25,0x27,0x2b,0x22,0x63,0x66,0x27,0x18,0x35,0x62,0x61,0xa4,0x36,
+	0x25,0x1c,0x51,0x63,0x31,0x21,0x72,0x31,0x35,0x31,0x33,0xb6,0x53,0x22,0x32,0x62,
+	0x75,0x11,0x12,0x23,0x26,0x27,0x42,0x11,0x31,0x32,0x62,0x74,0x12,0x13,0x13,0x26,
+	0x27,0x32,0x21,0x72,0x62,0x73,0x13,0x17,0x26,0x27,0x21,0x41,0x72,0x21,0x32,0x72,
+	0x14,0x17,0x23,0x57,0x11,0x51,0x72,0x51,0x41,0x47,0x17,0x2a,0x14,0x71,0x72,0xb1,
+	0x30,0x00,0x71,0x72,0xa3,0x27,0x17,0xe3,0x71,0xf9,0xff,0x20,0xff,0x20,0x00,0xe1,
+	0xf2,0xe3,0xf0,0x00,0x0e,0x2f,0x10,0x00,0xd2,0xc2,0x32,0xfd,0x2d,0x1f,0x3c,0x2f,
+	0x3c,0x1f,0x4b,0x2f,0x40,0x00,0xa2,0xf5,0x00,0x09,0x3c,0x17,0x82,0x1f,0x15,0x81,
+	0x21,0xc2,0x67,0x22,0x1c,0x26,0x62,0x31,0xc2,0x65,0x24,0x1c,0x26,0x42,0x51,0xc2,
+	0x63,0x26,0x1c,0x26,0x21,0x72,0xc2,0x61,0x18,0x2c,0x26,0xa2,0xc2,0x6a,0xf1,0x6a,
+	0x2c,0x26,0xa2,0xf5,0xff,0x20,0x00,0xff,0x20,0x01,0x52,0x81,0x63,0x76,0x27,0x98,
+	0x72,0x62,0x52,0x80,0x01,0xf0,0x16,0x28,0xe2,0x62,0x8e,0x26,0x32,0x23,0xe1,0x87,
+	0x27,0x24,0x2f,0x23,0x63,0x2f,0x37,0x22,0x1c,0x26,0x74,0x2e,0x57,0x26,0x18,0x26,
+	0x72,0x71,0x62,0x70,0x00,0x72,0x72,0x52,0x77,0x28,0x14,0x28,0x72,0x31,0x42,0x22,
+	0x97,0x22,0x16,0x12,0x29,0x72,0x12,0x64,0xa7,0x48,0x2b,0x73,0x85,0x97,0x28,0x22,
+	0x38,0x72,0x63,0x45,0x5d,0x38,0x62,0xb3,0xc2,0x48,0x3f,0x6f,0xf2,0xff,0x20,0x00,
+	0xe1,0xf2,0xe2,0xf1,0xf0,0x2f,0x0f,0x03,0xef,0x11,0xf0,0x51,0xf5,0x24,0x5f,0x93,
+	0x42,0xf5,0x15,0x42,0xf4,0x16,0x33,0xf3,0x17,0xfa,0x16,0xf9,0x35,0x5f,0x48,0xf0,
+	0x2f,0x00,0x00,0x81,0x62,0xf0,0x83,0x42,0xf0,0x82,0x52,0x62,0x77,0x35,0x25,0x46,
+	0x72,0x67,0xa7,0x26,0x2f,0x07,0x35,0x2f,0x06,0x22,0x14,0x2f,0x06,0x23,0x13,0x2f,
+	0x05,0x25,0x21,0x2f,0x05,0x17,0x4f,0x04,0x28,0xf1,0x23,0x2c,0xb4,0x21,0xfe,0xff,
+	0x20,0xff,0x20,0x00,0x91,0x81,0xd9,0x27,0x3b,0x83,0x72,0xc8,0x28,0x27,0x14,0x72,
+	0x92,0x63,0x37,0x22,0xf0,0x67,0x1a,0x2c,0x62,0xa2,0xc6,0x16,0x14,0x25,0x16,0x53,
+	0x5e,0x55,0x35,0x29,0x26,0x44,0x52,0x92,0x64,0x11,0x25,0x29,0x26,0x31,0x22,0x52,
+	0x92,0x62,0x13,0x25,0xd6,0x11,0x42,0x52,0x92,0x66,0x25,0x29,0x26,0x00,0x06,0x25,
+	0xd6,0x62,0x52,0x92,0x60,0x02,0x62,0x5d,0x66,0x25,0x29,0x26,0x00,0x06,0x25,0x29,
+	0x22,0x13,0x6f,0x92,0x62,0x11,0xf7,0xff,0x20,0xff,0x20,0x00,0xe2,0xf1,0xf0,0x2f,
+	0x0f,0x03,0xef,0x12,0xe5,0x1a,0x1a,0x14,0x5f,0x93,0x42,0xf5,0x42,0x42,0xf5,0x24,
+	0x33,0x32,0x62,0x61,0x63,0x34,0x34,0x3c,0xb3,0x32,0xdc,0x23,0x2d,0x00,0x07,0x28,
+	0x2d,0x82,0x72,0xd9,0x26,0x2d,0x92,0x61,0xea,0x15,0x28,0x24,0xf1,0x27,0x43,0x3f,
+	0x77,0xf1,0x2e,0xf0,0x2f,0x0f,0x05,0xce,0x23,0x3a,0xd2,0x64,0x7c,0x29,0x36,0xa2,
+	0xc3,0x57,0x3f,0x02,0x54,0x3f,0x41,0x53,0x1f,0xd0,0xff,0x20,0x01,0xfb,0x15,0x41,
+	0x52,0xd3,0x44,0x92,0xa7,0x41,0x51,0xf6,0x41,0x42,0xf6,0x41,0x41,0xf7,0x00,0x04,
+	0x13,0x1f,0x84,0x13,0x1f,0x41,0x34,0x12,0x14,0xf3,0x24,0x13,0x1b,0x1b,0x00,0x04,
+	0x14,0x1a,0x1b,0x41,0x51,0x41,0x41,0xb4,0x15,0x14,0x32,0x12,0x18,0x41,0x52,0x32,
+	0x31,0x31,0x74,0x15,0x22,0x24,0x14,0x16,0x41,0x52,0x22,0x41,0x51,0x54,0x41,0x31,
+	0x25,0x15,0x24,0x41,0x24,0x21,0x61,0x53,0x34,0x13,0x13,0x26,0x16,0x23,0x41,0x71,
+	0x71,0x62,0x34,0x16,0x18,0x16,0x23,0x41,0x61,0x81,0xb4,0x15,0x14,0x14,0x1b,0x41,
+	0xb5,0xb4,0x1d,0x3b,0x41,0xd1,0xdf,0xf2,0xff,0x20,0x00,0xe1,0xf2,0xe3,0xf0,0xe2,
+	0xf1,0x00,0x25,0x27,0x28,0x26,0x5f,0x66,0x52,0x72,0x82,0x60,0x03,0x5f,0x66,0x52,
+	0x72,0x82,0x60,0x03,0x5f,0x66,0x52,0x72,0x82,0x65,0x27,0x2f,0x1e,0x2b,0x14,0xe2,
+	0xc1,0x30,0x01,0xe2,0xb3,0x2f,0x0e,0x3f,0xf2,0x00,0x00,0xff,0x20,0x01,0xfc,0x14,
+	0x61,0xf4,0x33,0x6f,0x56,0x61,0xfa,0x61,0x92,0xe0,0x05,0x61,0x92,0x62,0x66,0x21,
+	0xf3,0x56,0x28,0x2e,0x61,0x92,0xe0,0x00,0x61,0x92,0x32,0x95,0x29,0x24,0x37,0x52,
+	0x92,0x53,0x65,0x29,0x26,0x26,0x51,0xa2,0x62,0x65,0x1a,0x27,0x16,0x42,0xa2,0xe4,
+	0x1b,0x2a,0x13,0x31,0xc2,0x93,0x23,0x12,0xa2,0x95,0x21,0xfe,0x11,0xff,0x0f,0xf2,
+	0xff,0x20,0x00,0xf2,0x1e,0xf2,0x3c,0x51,0xc2,0xc6,0x2b,0x16,0x24,0x63,0x2f,0x33,
+	0x72,0x83,0xc7,0x19,0x2d,0xf1,0x24,0x19,0xa1,0x42,0x61,0x82,0x17,0x13,0x28,0x26,
+	0x32,0x41,0x32,0x93,0x53,0x33,0x12,0xf0,0x54,0x22,0x13,0x3a,0x25,0x42,0x21,0xf8,
+	0x81,0x41,0x41,0x42,0x77,0x15,0x23,0x23,0x27,0x71,0x51,0x41,0x41,0x86,0x25,0x14,
+	0x14,0x18,0x61,0x61,0x41,0x41,0x85,0x25,0x24,0x14,0x18,0x25,0x52,0x41,0x41,0x84,
+	0x35,0x24,0x14,0x18,0x51,0x62,0x41,0x41,0x41,0x35,0x15,0x25,0x14,0x14,0x13,0x42,
+	0x51,0x61,0x41,0x41,0x34,0x24,0x26,0x14,0x23,0x22,0x42,0x31,0x81,0x47,0x24,0x22,
+	0x19,0x15,0x53,0xff,0x20,0x00,0xff,0x20,0x00,0xf0,0x1f,0x1f,0x02,0xf0,0xe3,0x91,
+	0x5e,0x29,0x34,0x4f,0x67,0xe2,0xf1,0xe2,0x61,0x98,0xf1,0x88,0x2b,0x38,0x82,0xb2,
+	0x90,0x00,0x8f,0x09,0x82,0xb2,0x90,0x01,0x8f,0x09,0x82,0xb2,0x90,0x00,0x8f,0x09,
+	0x82,0xb2,0x51,0x30,0x00,0x82,0xb2,0x43,0x22,0x62,0xb2,0x45,0xb2,0x52,0xca,0x46,
+	0x39,0x84,0xa4,0x67,0x3d,0x45,0x52,0xf3,0x34,0x32,0xf6,0x24,0xff,0x20,0xff,0x20,
+	0x00,0xe1,0xf2,0xf0,0x2f,0x0f,0x03,0xe5,0x1a,0x2e,0x51,0xa1,0xa2,0x35,0xb1,0xd2,
+	0x42,0xf6,0x14,0x42,0xf5,0x15,0x33,0x52,0x62,0x41,0x6a,0x46,0x39,0x93,0xa4,0x68,
+	0x3c,0x45,0x72,0xf1,0x34,0x62,0xf3,0x24,0x42,0xf1,0x22,0x24,0x31,0x4f,0x27,0xf0,
+	0x2f,0x00,0x07,0xf0,0x2a,0x14,0xf0,0x29,0x33,0x3c,0x29,0x6f,0xf2,0x00,0x00,0xff,
+	0x20,0x01,0xfc,0x14,0x2f,0xc3,0xc2,0xf3,0xb2,0xf4,0xa2,0xf5,0xa1,0xc2,0x79,0xf2,
+	0x67,0x4c,0x27,0x62,0x12,0xc2,0x75,0x22,0x2c,0x27,0x32,0x42,0xc2,0x72,0x16,0xf1,
+	0x79,0x24,0x17,0x27,0x91,0x53,0xef,0x02,0x82,0x5f,0x02,0x74,0x4b,0x22,0x35,0x36,
+	0x49,0x23,0x32,0x9a,0x23,0x21,0x11,0x1b,0xa2,0x32,0x21,0xc9,0x24,0x22,0x2b,0x82,
+	0x52,0x32,0xa7,0x26,0x24,0x38,0x62,0x72,0x54,0x65,0x28,0x27,0x62,0x41,0x53,0x22,
+	0x93,0x32,0x28,0x5f,0x0e,0x2f,0x1f,0xf2,0xff,0x20,0x00,0xf0,0x2f,0x0f,0x12,0xe0,
+	0x00,0x51,0xb1,0x92,0x35,0xfa,0x25,0x25,0x17,0x1b,0x52,0x62,0x62,0x90,0x00,0x52,
+	0x61,0x72,0x41,0x45,0x26,0x18,0x13,0x33,0x5f,0x66,0x52,0x61,0x81,0x90,0x01,0x52,
+	0x6a,0x95,0x17,0x1f,0x35,0x1f,0x21,0x85,0x14,0xf0,0x74,0x27,0x18,0x37,0x42,0x81,
+	0x63,0x84,0x28,0x25,0x29,0x41,0xa2,0x32,0xa4,0x1b,0x21,0x2b,0x32,0xc3,0xc3,0x1c,
+	0x4c,0x31,0xb2,0x24,0x92,0x1a,0x26,0x65,0x21,0x73,0xa6,0x31,0x14,0x4f,0x12,0x4f,
+	0xf2,0xff,0x20,0x00,0xf3,0x1d,0xc1,0x52,0xcb,0x35,0x1c,0xb2,0x61,0xca,0x36,0x2b,
+	0xa2,0x81,0xb9,0x29,0x2a,0x92,0xa1,0xa8,0x2b,0x29,0x72,0xd2,0x87,0x1f,0x02,0x76,
+	0x2f,0x04,0x55,0x2f,0x01,0x24,0x34,0x12,0xf2,0x24,0x23,0x19,0x26,0x24,0x14,0x21,
+	0xa2,0x62,0x9c,0x27,0x29,0x00,0x1c,0x18,0x29,0xb2,0x82,0x90,0x00,0xa2,0x92,0x9a,
+	0x1a,0x29,0x92,0x92,0xa8,0x2a,0x2a,0x71,0x86,0xa5,0x2a,0x4b,0x32,0xd2,0xcf,0xf2,
+	0xff,0x20,0x00,0x91,0xf3,0x13,0x92,0xf1,0x32,0x91,0x5c,0x59,0x1c,0x19,0x52,0x21,
+	0xb2,0x95,0x22,0x13,0x26,0x1a,0x51,0x34,0x81,0xa5,0x13,0x17,0x22,0x15,0x32,0x51,
+	0x31,0x74,0x17,0x35,0x13,0x17,0x28,0x23,0x51,0x31,0x41,0x22,0x82,0x32,0xe1,0x23,
+	0x23,0x23,0x91,0x72,0x32,0x32,0x39,0x26,0x23,0x23,0x23,0x51,0x31,0x72,0x32,0x32,
+	0x35,0x22,0x17,0x23,0x23,0x23,0x52,0x21,0x41,0x22,0x32,0x32,0x35,0x13,0x13,0x31,
+	0x23,0x23,0x23,0x42,0x31,0x32,0x22,0x32,0x32,0x34,0x14,0x12,0x23,0x23,0x14,0x23,
+	0x31,0x51,0x21,0x42,0x31,0x42,0x32,0x18,0x24,0x13,0x24,0x14,0x21,0x72,0x94,0x79,
+	0x29,0x23,0x25,0x82,0x92,0x53,0x37,0x29,0x27,0x32,0x61,0xa2,0x92,0x24,0x29,0x2b,
+	0x22,0x22,0x92,0xf2,0xff,0x20,0xff,0x20,0x00,0xe1,0xf2,0xe2,0xf1,0xf0,0x2f,0x0f,
+	0x02,0x91,0x53,0xfa,0x4e,0x2f,0x10,0x00,0x42,0x72,0x41,0x42,0x65,0x34,0x24,0x33,
+	0x26,0x62,0x32,0x52,0x32,0x77,0x12,0x93,0x28,0x71,0x23,0x32,0x31,0xaf,0x02,0xf0,
+	0xe2,0x61,0x98,0x23,0x23,0x23,0x36,0x62,0x41,0x62,0x33,0x54,0x33,0xc3,0x34,0x33,
+	0x44,0x11,0x41,0x52,0x44,0x1a,0x23,0x1b,0xf0,0x2f,0x0f,0x02,0xa2,0x32,0xfd,0x2f,
+	0x02,0xf0,0x00,0x5f,0xf2,0xff,0x20,0x00,0xf0,0x2f,0x00,0x04,0xf0,0x29,0x24,0x3f,
+	0xb3,0xe3,0x11,0xdd,0x41,0x1d,0x00,0x0c,0x21,0x22,0x1c,0xc2,0x12,0x22,0xbb,0x22,
+	0x23,0x1b,0xa3,0x22,0x32,0xaa,0x23,0x24,0x29,0x92,0x42,0x52,0x88,0x25,0x25,0x37,
+	0x72,0x62,0x63,0x67,0x17,0x27,0x35,0x61,0x82,0x42,0x24,0x34,0x22,0xf1,0x23,0x33,
+	0x2a,0x2a,0x14,0x21,0xc2,0xf0,0xf0,0x2f,0x00,0x03,0xff,0x20,0xff,0x20,0x00,0xf2,
+	0x1e,0xf1,0x3d,0x42,0xa3,0xd5,0x29,0x2e,0x62,0x82,0xe6,0x23,0x13,0x2f,0x06,0x22,
+	0x14,0x2a,0x14,0x71,0x21,0x4e,0x39,0x14,0x2a,0x33,0x91,0x41,0x31,0x72,0x49,0x13,
+	0x23,0x34,0x25,0x81,0x41,0x43,0x41,0x68,0x13,0x15,0x33,0x17,0x81,0x31,0x53,0xb7,
+	0x13,0x16,0x3b,0x71,0x21,0x73,0xb6,0x1b,0x12,0x1a,0x52,0xa2,0x21,0xa3,0x4a,0x22,
+	0x1a,0x43,0xa2,0x31,0x95,0x29,0x24,0x19,0x52,0x92,0x42,0x85,0x28,0x26,0x27,0x52,
+	0x81,0x73,0x64,0x37,0x19,0x35,0x43,0x61,0xb3,0x45,0x24,0x2d,0x42,0xa2,0xf0,0x23,
+	0x82,0xf7,0xff,0x20,0xff,0x20,0x02,0xf9,0x17,0xf8,0x36,0x6f,0x56,0xf8,0x27,0x00,
+	0x26,0x1f,0x12,0x76,0x2f,0x02,0x76,0x1f,0x12,0x76,0xf4,0x76,0x1f,0x12,0x76,0x1f,
+	0x11,0x86,0x1f,0xa0,0x02,0x61,0xf5,0x14,0x00,0x26,0x1f,0x52,0x30,0x00,0x62,0xf3,
+	0x42,0x6f,0x83,0xff,0x20,0x01,0xff,0x20,0x01,0x72,0xf0,0x17,0x73,0xd3,0x67,0x25,
+	0xc6,0x62,0xe2,0x86,0x1f,0x02,0x85,0x25,0x27,0x29,0x51,0x63,0x52,0xa4,0x16,0x35,
+	0x2b,0x32,0x62,0x52,0x13,0x82,0x26,0x25,0x24,0x36,0x29,0x52,0x73,0x43,0x15,0x15,
+	0x29,0x33,0x81,0x42,0xc2,0x37,0x14,0x1f,0x01,0x36,0x1f,0xa5,0x1f,0x42,0x54,0x25,
+	0x21,0xe4,0x38,0x82,0xb3,0x4c,0x2b,0x41,0xe2,0xbf,0x42,0xbd,0x15,0x2b,0x85,0x62,
+	0xb4,0x5a,0x2b,0x24,0xd2,0x71,0x33,0x17,0xf4,0x2f,0xf2,0x00,0x10,0xff,0x20,0x00,
+	0xf8,0x18,0xf8,0x36,0xf8,0x27,0x31,0xf4,0x27,0x32,0x52,0xb2,0x73,0xaa,0x27,0x32,
+	0x52,0xb2,0x73,0x25,0x2b,0x22,0x23,0x32,0x5f,0x52,0x32,0x52,0xb2,0x70,0x01,0x32,
+	0x52,0x31,0x72,0x73,0x94,0x16,0x27,0x32,0x52,0x42,0x52,0x73,0x25,0x25,0x24,0x27,
+	0x00,0x13,0x25,0x2b,0x27,0x00,0x23,0x9b,0x27,0x32,0x52,0xb2,0x73,0x25,0x1c,0x27,
+	0x31,0xf4,0x27,0xf4,0x67,0xf6,0x38,0xf7,0x19,0xff,0x20,0xff,0x20,0x00,0x61,0xfa,
+	0x71,0xf9,0x72,0xf2,0x24,0x82,0x2f,0x23,0x41,0x32,0xf1,0x24,0x43,0x21,0xf1,0x24,
+	0x42,0xf5,0x24,0x00,0x04,0x25,0x17,0x25,0x24,0x42,0x5b,0x42,0x44,0x25,0x17,0x25,
+	0x24,0x00,0x34,0x25,0xa5,0x24,0x42,0x51,0x72,0x52,0x40,0x03,0x42,0x5a,0x52,0x44,
+	0x25,0x17,0x16,0x24,0x42,0xf5,0x24,0x00,0x14,0x2f,0x07,0x44,0x2f,0x33,0x5f,0xa1,
+	0x6f,0xf2,0xff,0x20,0x00,0xe2,0xf1,0x00,0x0e,0x1f,0x2d,0x2f,0x27,0x15,0x1f,0x38,
+	0x13,0x1b,0x26,0x84,0x1d,0x68,0x1f,0x02,0x60,0x03,0x8f,0x36,0x81,0xf0,0x26,0x00,
+	0x48,0xf3,0x68,0x1f,0x02,0x60,0x04,0x8f,0x36,0x81,0xf0,0x26,0x81,0xf0,0x17,0xff,
+	0x20,0xff,0x20,0x00,0x72,0xf8,0x00,0x07,0x26,0x18,0x17,0x72,0x6b,0x67,0x26,0x26,
+	0x27,0x00,0x17,0x22,0x22,0x26,0x27,0x29,0x42,0x62,0x77,0x26,0x26,0x27,0x63,0x62,
+	0x62,0x70,0x00,0x64,0x52,0x62,0x76,0x31,0x23,0x26,0x27,0x54,0x22,0x22,0x62,0x75,
+	0x11,0x22,0x31,0x26,0x27,0x51,0x12,0x31,0x22,0x62,0x74,0x21,0x26,0x26,0x27,0x41,
+	0x22,0x62,0x62,0x73,0x13,0x26,0x26,0x27,0x31,0x32,0x61,0x72,0x72,0x14,0x25,0x27,
+	0x27,0x11,0x52,0x52,0x72,0x31,0x31,0x15,0x24,0x28,0x23,0x13,0x72,0x41,0x92,0x32,
+	0x27,0x23,0x29,0x23,0x22,0x72,0x31,0xa7,0x27,0x22,0x1c,0x53,0x72,0x11,0xf6,0xff,
+	0x20,0xff,0x20,0x01,0xb3,0x42,0xcb,0x25,0x2c,0x00,0x3b,0x25,0x27,0x14,0xb2,0x52,
+	0x63,0x3b,0x25,0x25,0x34,0x3a,0x52,0x42,0x6b,0x25,0x22,0x28,0xb2,0x54,0xab,0x25,
+	0x2c,0x00,0x4b,0x25,0x28,0x13,0x00,0x08,0x55,0x28,0x13,0x53,0x32,0x52,0x81,0x32,
+	0x45,0x25,0x28,0x13,0x32,0x62,0x52,0x81,0x3b,0x25,0x27,0x32,0xb2,0x5c,0x2b,0x27,
+	0x84,0xff,0x20,0x00,0xff,0x20,0x00,0xe1,0xf2,0xe3,0xf0,0xf0,0x2f,0x0f,0x03,0xef,
+	0x11,0x93,0x32,0xfd,0x2f,0xf2,0x00,0x0f,0x81,0x88,0x2c,0x37,0x8e,0x12,0x78,0x2d,
+	0x18,0x00,0x38,0xf1,0x88,0x25,0x26,0x18,0x81,0x62,0xf0,0xf0,0x2f,0x09,0x24,0x24,
+	0x1a,0x93,0x32,0x52,0x88,0x25,0x26,0x27,0x72,0x62,0x64,0x56,0x27,0x27,0x35,0x52,
+	0x82,0x83,0x44,0x15,0x79,0x15,0x22,0x94,0x91,0x5e,0x2f,0x1f,0xf2,0xff,0x20,0x00,
+	0xb1,0x71,0xcb,0x35,0x3a,0xb2,0x62,0xb0,0x00,0xb2,0x62,0x62,0x32,0xfd,0x2b,0x27,
+	0x1b,0x00,0x2b,0x1f,0x59,0x1c,0x28,0xa1,0xa3,0x8a,0x1a,0x29,0xb1,0x82,0xa0,0x00,
+	0xc1,0x62,0xbc,0x25,0x2b,0xd1,0x42,0xcd,0x22,0x2d,0xe4,0xef,0x03,0xee,0x4e,0xd2,
+	0x23,0xcb,0x35,0x49,0xa2,0x86,0x67,0x3c,0x82,0x52,0xf3,0x43,0x23,0xfc,0xff,0x20,
+	0xff,0x20,0x00,0x51,0xd1,0x21,0x95,0x3b,0x22,0x27,0x52,0xc1,0x42,0x65,0x2c,0x15,
+	0x16,0x52,0xc1,0x72,0x35,0x24,0xf1,0x55,0x2c,0x1c,0x52,0x51,0x61,0x52,0x55,0x22,
+	0x12,0xf0,0x52,0x91,0x16,0x15,0x25,0x52,0x51,0x61,0x52,0x50,0x00,0x52,0x5f,0x05,
+	0x52,0x51,0x61,0x52,0x50,0x00,0x52,0x5f,0x05,0x52,0x51,0x61,0x52,0x55,0x25,0x16,
+	0x14,0x17,0x52,0x51,0xb2,0x65,0x2f,0x21,0x31,0x35,0x22,0xf6,0x25,0x25,0x1b,0x17,
+	0x52,0x62,0x91,0x75,0x27,0x28,0x17,0x52,0x82,0x71,0x75,0x28,0x18,0x17,0x52,0xf2,
+	0x17,0x52,0xd5,0x75,0x1f,0x12,0x8f,0xf2,0xff,0x20,0x00,0x71,0xf9,0x72,0xf8,0x72,
+	0xf3,0x14,0x62,0x62,0x32,0x53,0x36,0x85,0x71,0x14,0x52,0x32,0x72,0x61,0x45,0x14,
+	0x27,0x26,0x14,0x41,0x52,0x41,0x22,0x61,0x42,0xf1,0x12,0x61,0x49,0x28,0x26,0x14,
+	0x93,0x72,0x61,0x49,0x21,0x25,0x26,0x14,0x82,0x33,0x39,0x47,0x25,0x32,0x26,0x14,
+	0x62,0x72,0x22,0xb5,0x2f,0xa4,0x14,0x1d,0x27,0x22,0x5f,0x17,0x91,0xd2,0x70,0x02,
+	0x9f,0x17,0x91,0xd2,0x70,0x01,0x9f,0x17,0x91,0xd2,0x79,0x1d,0x18,0xff,0x20,0xff,
+	0x20,0x01,0xc1,0x53,0xbc,0x24,0x3b,0xc1,0x52,0xc0,0x00,0xc1,0x61,0xc0,0x00,0xc1,
+	0x61,0x61,0x53,0x18,0x16,0x16,0x24,0x32,0x71,0x61,0x63,0x34,0x17,0x16,0x16,0x24,
+	0x42,0x61,0x61,0x53,0x45,0x25,0x16,0x15,0x25,0x53,0x41,0x61,0x42,0x66,0x24,0x16,
+	0x14,0x26,0x63,0x31,0x61,0x41,0x77,0x23,0x16,0x13,0x27,0x73,0x21,0x61,0x22,0x87,
+	0x32,0x16,0x12,0x19,0x72,0x31,0x61,0x11,0xa8,0x13,0x16,0x11,0x1a,0xc1,0x62,0xbc,
+	0x16,0x1c,0x00,0x0c,0x16,0x18,0x13,0xc1,0x61,0x73,0x22,0xfe,0x1f,0xf2,0x00,0x10,
+	0xff,0x20,0x00,0xe2,0xf1,0xe3,0xf0,0xe2,0xf1,0xd3,0xb1,0x4d,0x2b,0x33,0x2f,0xd2,
+	0xc2,0xf3,0xb2,0xf4,0x00,0x0a,0x2b,0x18,0x9f,0x17,0x92,0xc1,0x88,0x3c,0x18,0x71,
+	0x12,0xc1,0x85,0x22,0x2c,0x18,0x42,0x3f,0x08,0x31,0x52,0xc1,0x82,0x16,0x2c,0x18,
+	0x92,0xc1,0x80,0x00,0x9f,0x08,0x92,0xc1,0x80,0x03,0x92,0x73,0x12,0x89,0x29,0x48,
+	0x91,0xb2,0x9f,0xf2,0xff,0x20,0x01,0x41,0x61,0x21,0xf2,0x49,0x1d,0x54,0x24,0x22,
+	0x29,0x25,0x42,0x41,0x32,0x92,0x54,0x23,0x23,0x29,0x25,0x42,0x31,0x42,0x92,0x50,
+	0x00,0x42,0x21,0x5d,0x54,0x22,0x15,0x29,0x25,0x42,0x11,0x62,0x92,0x54,0x22,0x15,
+	0x29,0x25,0x42,0x31,0x42,0x92,0x54,0x24,0x13,0xd5,0x42,0x42,0x22,0x21,0x61,0x64,
+	0x25,0x12,0x23,0x16,0x15,0x42,0x52,0x12,0x31,0x53,0x44,0x25,0x21,0x23,0x14,0x35,
+	0x42,0x52,0x12,0x32,0x22,0x74,0x33,0x22,0x24,0x11,0x19,0x42,0x15,0x22,0x42,0xa4,
+	0x23,0x23,0x25,0x1a,0x42,0x82,0x52,0x94,0x28,0x24,0x11,0x28,0x42,0x82,0x22,0x33,
+	0x64,0x28,0x55,0x53,0x42,0x84,0x83,0x34,0x29,0x1f,0x10,0x00,0xff,0x20,0xff,0x20,
+	0x00,0xf0,0x2f,0x00,0x00,0xf0,0x29,0x15,0x4f,0x94,0xf1,0x1f,0x00,0x00,0xf1,0x18,
+	0x25,0x5f,0x84,0xf1,0x1f,0x0f,0x11,0xb1,0x3f,0x11,0xa3,0x23,0xd1,0xa5,0xff,0x28,
+	0x1e,0x27,0x8f,0x36,0x82,0xd2,0x78,0x25,0x17,0x27,0x82,0x53,0x52,0x78,0x25,0x26,
+	0x27,0x00,0x18,0x25,0x17,0x27,0x82,0x42,0x72,0x78,0x24,0x21,0x15,0x18,0xd2,0x34,
+	0xac,0x27,0x47,0xa3,0xa3,0x68,0x3d,0x35,0x54,0xf1,0x16,0x41,0xfc,0xff,0x20,0x00,
+	0x92,0xf6,0x93,0xf5,0x92,0xe2,0x59,0x2c,0x54,0x82,0x87,0x78,0x22,0x61,0x2b,0x72,
+	0xa2,0xb0,0x00,0x62,0xb2,0xb6,0x3a,0x2b,0x54,0xa2,0xb5,0x11,0x1b,0x2b,0x42,0x11,
+	0xb2,0xb4,0x12,0x1b,0x27,0x13,0x31,0x31,0xb2,0x63,0x22,0x14,0x13,0xf1,0x51,0x15,
+	0x1b,0x2b,0x00,0x07,0x1b,0x2b,0x00,0x37,0x2a,0x2b,0x00,0x07,0x2a,0x26,0x14,0x72,
+	0xa2,0x53,0x37,0x23,0x72,0x56,0x71,0xf9,0xff,0x20,0xff,0x20,0x01,0xf3,0x2c,0xb3,
+	0x41,0xdb,0x35,0x1c,0xb2,0x61,0xca,0x27,0x1c,0xa2,0x81,0xb9,0x29,0x2a,0x92,0xa1,
+	0xa8,0x2b,0x29,0x81,0xd2,0x87,0x1f,0x02,0x76,0x27,0x17,0x36,0x52,0x74,0x64,0x44,
+	0x28,0x29,0x52,0x31,0x93,0xa2,0x42,0x1a,0x2f,0x2c,0x2f,0x30,0x00,0xb2,0x61,0xca,
+	0x28,0x1b,0xa1,0x92,0xa9,0x1b,0x29,0x82,0xc2,0x87,0x2d,0x37,0x6f,0x47,0x66,0xb3,
+	0x6f,0x92,0x6f,0x91,0x7f,0xf2,0xff,0x20,0x01,0xfa,0x16,0x5f,0x75,0xfa,0x25,0x00,
+	0x2f,0x42,0x42,0x53,0xf4,0x32,0x5f,0xa2,0x50,0x01,0x71,0x91,0x72,0x57,0xc6,0x25,
+	0x71,0x92,0x62,0x50,0x04,0x7c,0x62,0x57,0x19,0x26,0x25,0x00,0x0f,0xa2,0x50,0x00,
+	0xf9,0x35,0xf6,0x56,0xf8,0x36,0xf9,0x17,0xff,0x20,0xff,0x20,0x00,0xd2,0xf2,0xe3,
+	0xf0,0xf0,0x2f,0x05,0x1a,0x1a,0x14,0x51,0x91,0xa3,0x34,0xb1,0xe2,0x42,0x52,0xd2,
+	0x43,0x35,0x3b,0x25,0x32,0x53,0x81,0xaa,0x21,0xa9,0x92,0x11,0x72,0xa8,0x23,0x15,
+	0x2b,0x72,0x42,0x32,0xc6,0x26,0x21,0x2d,0x52,0x83,0xe4,0x1a,0x4d,0xd2,0x33,0xbb,
+	0x36,0x48,0xa2,0xa8,0x27,0x3c,0x11,0x53,0x43,0x2f,0x12,0x14,0x22,0x51,0xc2,0x89,
+	0x1c,0x28,0x00,0x39,0xf0,0x89,0x1c,0x19,0xff,0x20,0xff,0x20,0x01,0xc1,0x31,0x91,
+	0x55,0x92,0xc4,0x51,0x61,0x32,0x72,0x50,0x04,0x58,0x32,0x35,0x65,0x16,0x13,0x25,
+	0x36,0x51,0x61,0x32,0xe5,0x16,0x13,0x29,0x14,0x51,0x61,0x3d,0x35,0x16,0x13,0x21,
+	0x16,0x24,0x51,0x61,0x32,0x21,0x52,0x45,0x83,0x22,0x14,0x25,0x51,0x61,0x32,0x21,
+	0x42,0x55,0x16,0x13,0x23,0x13,0x16,0x51,0x61,0x32,0x31,0x22,0x64,0x26,0x13,0x24,
+	0x11,0x26,0x42,0x61,0x32,0x43,0x74,0x26,0x13,0x25,0x27,0x41,0x71,0x32,0x44,0x64,
+	0x17,0x13,0x23,0x13,0x25,0x31,0x72,0x32,0x21,0x53,0x33,0x13,0x63,0x47,0x32,0x21,
+	0x73,0x32,0xa1,0x31,0x1e,0x1f,0x0f,0xf2,0xff,0x20,0x00,0xfb,0x15,0x51,0xf3,0x35,
+	0x62,0xc8,0x46,0x35,0x8a,0x72,0xb2,0xa0,0x00,0xf5,0x2a,0x00,0x1f,0x52,0x61,0x3c,
+	0xf3,0x21,0x8b,0x2a,0x72,0xb2,0xa7,0x1c,0x2a,0x00,0x17,0x1c,0x24,0x15,0x71,0x7d,
+	0x47,0x17,0x1a,0x15,0x00,0x17,0x15,0x11,0x1a,0x15,0x71,0x32,0x21,0xa1,0x57,0x12,
+	0x23,0x1a,0x15,0x71,0x12,0x41,0xa1,0x57,0x35,0x1a,0x15,0x72,0x6c,0x5f,0x01,0xa1,
+	0x5f,0x01,0xf1,0xff,0x20,0xff,0x20,0x00,0xf4,0x1c,0x41,0xe2,0xb5,0x2c,0x26,0x14,
+	0x62,0xb2,0x53,0x36,0x23,0xf4,0x27,0x1b,0x2b,0xf4,0x2b,0xf4,0x24,0x25,0xeb,0x76,
+	0x1c,0x2b,0x53,0xb2,0x62,0x32,0x31,0x23,0xf4,0x26,0x1f,0xa0,0x00,0x61,0x71,0xa2,
+	0x56,0x17,0xd5,0x61,0x71,0xa1,0x60,0x00,0x61,0x7c,0x66,0x14,0x12,0x1a,0x16,0x61,
+	0x31,0x31,0xa1,0x66,0x12,0x14,0x1a,0x16,0x61,0x12,0x4c,0x66,0x35,0x1a,0x16,0x53,
+	0x61,0xa1,0x66,0x26,0x1a,0x16,0x61,0x71,0x56,0x6e,0x18,0x36,0xe1,0x91,0x7f,0xf2,
+	0xff,0x20,0x00,0xf0,0x1f,0x1f,0x02,0xf0,0xf0,0x1f,0x10,0x00,0xf0,0x19,0x25,0xf0,
+	0xd4,0xf0,0x1f,0x10,0x02,0x72,0x61,0x72,0x77,0x81,0xa6,0x72,0xe2,0x70,0x05,0x7f,
+	0x37,0x72,0xe2,0x76,0x1f,0xa6,0x14,0x1d,0x16,0x61,0x51,0x52,0x52,0x56,0x15,0x25,
+	0x25,0x24,0x52,0x52,0x52,0x53,0x34,0x27,0x24,0x26,0x23,0x33,0x71,0x61,0x62,0x34,
+	0x1f,0xcf,0xf2,0xff,0x20,0x00,0xf0,0x1f,0x1f,0x03,0xef,0x02,0xf0,0x00,0x1f,0x02,
+	0x82,0x5f,0x02,0x74,0x44,0xf5,0x8f,0x02,0xf0,0x00,0x2f,0x02,0xb1,0x3f,0x02,0xa3,
+	0x22,0xfa,0x5f,0x02,0xf0,0x52,0x82,0x81,0x65,0x37,0x28,0x25,0x52,0x82,0x81,0x60,
+	0x06,0x5a,0x29,0x6f,0xa1,0x60,0x00,0xff,0x20,0xff,0x20,0x01,0x61,0xf4,0x15,0x6f,
+	0x74,0x61,0xf4,0x15,0x00,0x06,0x1f,0x42,0x46,0xf7,0x46,0x1f,0x42,0x46,0x16,0x18,
+	0x19,0x61,0x62,0x63,0x86,0x17,0x25,0x29,0x61,0x81,0x51,0xa6,0x18,0x14,0x14,0x25,
+	0x61,0x2f,0x44,0x52,0x71,0x62,0x90,0x02,0x51,0x81,0x62,0x42,0x35,0x12,0xf7,0x25,
+	0x18,0x16,0x29,0x42,0x72,0x62,0x94,0x18,0x26,0x29,0x00,0x03,0x18,0x27,0x29,0x31,
+	0x81,0x82,0x92,0x18,0x19,0x29,0x11,0x72,0xa2,0x98,0x1f,0x8f,0xf2,0xff,0x20,0x00,
+	0xc2,0x52,0xb0,0x00,0xc1,0x61,0x72,0x33,0xf9,0x5c,0x16,0x1c,0xb1,0x71,0x31,0x88,
+	0xf2,0x78,0x1d,0x28,0x00,0x08,0xf1,0x88,0x1d,0x28,0x00,0x08,0xf1,0x88,0x14,0x27,
+	0x28,0xc3,0xd1,0x3b,0x3d,0x32,0x3a,0x1d,0x59,0x24,0x15,0x1a,0x82,0x52,0x52,0x86,
+	0x27,0x25,0x46,0x52,0x1f,0x11,0x61,0x32,0x32,0x52,0x51,0x42,0x31,0x25,0x25,0x25,
+	0x19,0x82,0x52,0x51,0x90,0x00,0x82,0x52,0x11,0x31,0x98,0x25,0x23,0x39,0x81,0x62,
+	0x42,0x9f,0x02,0xf0,0xff,0x20,0xff,0x20,0x00,0xf0,0x1f,0x1f,0x03,0xef,0x02,0xf0,
+	0x00,0x6f,0x02,0xb1,0x3f,0x02,0xa3,0x22,0xfa,0x5f,0x02,0xf0,0x00,0xdf,0x01,0xf1,
+	0xff,0x20,0xff,0x20,0x00,0xe2,0xf1,0xf0,0x2f,0x0f,0x03,0xef,0x11,0x91,0x55,0xf8,
+	0x45,0x1f,0x43,0x44,0x2f,0x41,0x64,0x2f,0x31,0x73,0x2f,0x21,0x9f,0x63,0x86,0xf4,
+	0x7f,0x52,0xaf,0x41,0xcf,0x31,0xdf,0x01,0x11,0xef,0x03,0x91,0x4f,0x02,0x93,0x32,
+	0xfd,0x2f,0x02,0xf0,0x00,0x6b,0x6f,0x0d,0x3f,0x1e,0x1f,0x2f,0xf2,0xff,0x20,0x00,
+	0xf2,0x2d,0x72,0x83,0xc7,0x29,0x13,0x28,0x62,0xa1,0x42,0x76,0x2a,0x15,0x26,0x61,
+	0xb1,0x52,0x65,0x24,0x16,0x1d,0x51,0x52,0x51,0x72,0x44,0x15,0x35,0x11,0x75,0x32,
+	0x52,0x17,0xc3,0x14,0x37,0x2c,0x26,0x11,0x82,0xc3,0x14,0x19,0x26,0x24,0x72,0x92,
+	0x37,0x26,0x25,0xa9,0x61,0x51,0x52,0xc5,0x1c,0x25,0x16,0x32,0x53,0x52,0x43,0x53,
+	0x79,0x13,0x36,0x33,0xd2,0x13,0x7f,0x45,0x8f,0x53,0x9c,0x25,0x3a,0x75,0x53,0x12,
+	0x51,0x32,0x59,0x32,0x34,0x13,0x22,0xa3,0x53,0x31,0x3c,0x29,0x63,0xa2,0xd4,0x3f,
+	0xc2,0x3f,0xf2,0xff,0x20,0x00,0x81,0xb1,0xb8,0x39,0x2a,0x82,0x93,0xa8,0x1a,0x2b,
+	0x00,0x07,0x1a,0x2c,0x42,0x11,0x42,0x42,0x72,0x34,0x31,0x64,0x11,0x93,0x42,0x62,
+	0x32,0x72,0x44,0x26,0x23,0x18,0x24,0x42,0x62,0x21,0x92,0x44,0x26,0x21,0x1a,0x24,
+	0x00,0x04,0x26,0x33,0x17,0x24,0x42,0x62,0x42,0x62,0x44,0xa5,0x25,0x24,0x42,0x62,
+	0x52,0x52,0x44,0x26,0x26,0x24,0x24,0x42,0x62,0x61,0x52,0x44,0x26,0x2c,0x24,0x00,
+	0x44,0xa6,0x14,0x34,0x42,0x62,0x76,0x54,0x26,0x1a,0x36,0xf9,0x17,0xff,0x20,0xff,
+	0x20,0x00,0xf0,0x1f,0x1f,0x02,0xf0,0xf0,0x1f,0x10,0x02,0x41,0xa1,0xa1,0x54,0xf9,
+	0x44,0x29,0x1a,0x15,0x00,0x64,0xf8,0x54,0x29,0x29,0x15,0x41,0xa2,0xf0,0xf0,0x2f,
+	0x00,0x08,0xff,0x20,0xff,0x20,0x02,0xf0,0x1f,0x1f,0x02,0xf0,0xf1,0x2e,0xf2,0x2d,
+	0xf2,0x3c,0xa2,0x62,0xca,0x35,0x2c,0xa2,0x62,0xca,0x2f,0x5a,0x2d,0x16,0xa2,0xd2,
+	0x55,0x14,0x2e,0x24,0x00,0x05,0x14,0x2f,0x02,0x34,0x24,0x2f,0x03,0x20,0x00,0x33,
+	0x42,0xb1,0x33,0x22,0x35,0x2b,0x14,0x13,0x23,0x52,0xb1,0x8a,0x2b,0x18,0x00,0x0a,
+	0x2a,0x28,0xa2,0xa3,0x7a,0xf0,0x7b,0xc9,0xff,0x20,0x01,0xff,0x20,0x01,0xf8,0x27,
+	0xf8,0x36,0xf8,0x27,0xc2,0x92,0x73,0xc8,0x27,0xc2,0x92,0x7b,0x2a,0x23,0x13,0x31,
+	0x72,0xa2,0x23,0x24,0x16,0xc1,0x35,0x51,0x42,0xc1,0x76,0x13,0x2c,0x17,0x62,0x22,
+	0x31,0x81,0x77,0x45,0x26,0x17,0x83,0x61,0x61,0x79,0x17,0x25,0x17,0x83,0x63,0x41,
+	0x78,0x11,0x25,0x34,0x17,0x72,0x12,0x61,0x51,0x76,0x23,0x2b,0x17,0x61,0x42,0xb1,
+	0x75,0x24,0x3a,0x17,0x42,0x62,0xa1,0x73,0x27,0x2a,0x17,0x31,0x82,0xa1,0x72,0x1f,
+	0x52,0x71,0x1f,0x17,0x7f,0x64,0x7f,0x72,0x8f,0xf2,0xff,0x20,0x00,0x72,0xf8,0x73,
+	0xc2,0x87,0x2d,0x28,0x62,0xe2,0x86,0x23,0x29,0x28,0x52,0x16,0x82,0x85,0x24,0x1a,
+	0x28,0x42,0x41,0xb2,0x84,0x14,0x13,0x13,0xc3,0x3c,0x22,0x32,0x32,0x32,0x11,0x23,
+	0x13,0x13,0x23,0x23,0x23,0x11,0x22,0x31,0x31,0x32,0x32,0x32,0x34,0x23,0x13,0x13,
+	0x23,0x23,0x23,0x00,0x04,0xa3,0x23,0x23,0x23,0x42,0x31,0x31,0x32,0x32,0x32,0x30,
+	0x01,0x42,0x31,0x31,0x3c,0x34,0xa3,0x23,0x23,0x14,0x42,0x31,0x31,0x82,0x84,0x14,
+	0x13,0x18,0x28,0x41,0x41,0x31,0x82,0x21,0x54,0x14,0x13,0x18,0x23,0x14,0x32,0x41,
+	0x31,0x82,0x41,0x33,0x15,0x13,0x16,0xa2,0x21,0x61,0x13,0x26,0x62,0x22,0x15,0x13,
+	0x22,0x2b,0x12,0x11,0xff,0x0f,0xf2,0xff,0x20,0x00,0x71,0x82,0x42,0x87,0x27,0x33,
+	0x37,0x71,0x82,0x42,0x87,0x18,0x24,0x23,0x14,0x71,0x3f,0x33,0x71,0x82,0x42,0x87,
+	0x12,0x24,0x24,0x28,0x2b,0x32,0x42,0x87,0x15,0x1b,0x25,0x71,0x5f,0x04,0x71,0x52,
+	0xa2,0x57,0x14,0x3a,0x25,0x71,0x22,0x1e,0x57,0x33,0x2a,0x25,0x63,0x42,0xa2,0x53,
+	0x55,0x2a,0x25,0x23,0x21,0x5e,0x52,0x23,0x15,0x23,0x25,0x25,0x71,0x51,0x42,0xc7,
+	0x1a,0x28,0x13,0x71,0x2f,0x52,0x71,0xa3,0xb7,0x19,0x22,0x1a,0x71,0x92,0x31,0x97,
+	0x18,0x24,0x28,0x71,0x72,0x63,0x63,0x56,0x28,0x44,0x53,0x42,0xb5,0x25,0x13,0x3f,
+	0x01,0x4f,0xf2,0xff,0x20,0x01,0xf1,0x24,0x28,0x52,0x92,0x42,0x86,0x28,0x15,0x28,
+	0x63,0x71,0x52,0x87,0x27,0x15,0x28,0x72,0x71,0x52,0x22,0x4b,0xf3,0x3f,0x11,0x52,
+	0x80,0x00,0x71,0x81,0x52,0x86,0x37,0x15,0x28,0x26,0x81,0x52,0x86,0x28,0x15,0x28,
+	0x62,0x81,0x52,0x32,0x36,0x22,0xf2,0x56,0x28,0x15,0x28,0x62,0x72,0x52,0x80,0x00,
+	0x62,0x71,0x62,0x86,0x26,0x26,0x28,0x62,0x61,0x72,0x86,0x25,0x18,0x28,0x42,0x21,
+	0x31,0x92,0x82,0x34,0x3a,0x28,0x13,0x62,0x91,0xa2,0x18,0xf4,0x2e,0xe4,0xff,0x20,
+	0x00,0xff,0x20,0x00,0x91,0xf7,0x92,0xf0,0x15,0x83,0xe3,0x47,0x35,0xa7,0x72,0xf8,
+	0x61,0xfa,0x51,0x41,0xf6,0x41,0x52,0xf5,0x22,0x53,0xf5,0x92,0xf1,0x23,0x82,0x2f,
+	0x32,0x72,0xc2,0x90,0x00,0x64,0xb2,0x95,0x21,0x1c,0x29,0x42,0x21,0xc2,0x94,0x13,
+	0x1c,0x29,0x31,0x41,0xc2,0x91,0x25,0x1c,0x29,0x81,0xc2,0x90,0x05,0x81,0x64,0x13,
+	0x98,0x19,0x59,0x71,0xb3,0xaf,0xf2,0xff,0x20,0x00,0x62,0x92,0xd6,0x39,0x2c,0x62,
+	0xb2,0xb6,0x2b,0x3a,0x62,0xc1,0xb6,0x2c,0x16,0x23,0x62,0x39,0x16,0x52,0xbf,0x46,
+	0x29,0x14,0x19,0x62,0x92,0x42,0x76,0x46,0x26,0x35,0x62,0x12,0x42,0x83,0x45,0x32,
+	0x23,0x1a,0x33,0x53,0x22,0x21,0x81,0x32,0x35,0x35,0x11,0x17,0x31,0x14,0x44,0x41,
+	0x21,0x72,0x74,0x11,0x28,0x16,0x27,0x32,0x12,0x81,0x52,0x83,0x12,0x29,0x14,0x28,
+	0x21,0x32,0x91,0x32,0x92,0x13,0x2a,0x12,0x29,0x11,0x42,0xa4,0xa6,0x2b,0x2b,0x62,
+	0xa4,0xa6,0x29,0x22,0x29,0x62,0x82,0x44,0x66,0x26,0x27,0x72,0x62,0x42,0xb5,0x26,
+	0x22,0x2f,0x11,0x3f,0xf2,0xff,0x20,0x00,0xf0,0x13,0x1c,0x21,0xc3,0x22,0xa2,0x2a,
+	0x33,0x39,0x32,0x51,0x32,0x52,0x94,0x23,0x14,0x16,0x24,0x14,0x43,0x21,0x32,0x61,
+	0x43,0x35,0x22,0x13,0xf2,0x25,0x12,0x13,0x36,0x1a,0x81,0x33,0x61,0xa8,0x12,0x46,
+	0x1a,0x71,0x31,0x12,0x61,0xa7,0x12,0x12,0x26,0x14,0x24,0x62,0x12,0x2d,0x66,0x12,
+	0x13,0x26,0x1a,0x52,0x11,0x42,0x61,0xa5,0x26,0x26,0x1a,0x42,0x72,0x61,0xa2,0x47,
+	0x26,0x15,0x14,0x42,0x72,0x61,0x43,0x34,0x27,0xd6,0x42,0x72,0x61,0xa0,0x00,0x33,
+	0x72,0x61,0xa0,0x00,0x33,0x72,0x61,0x52,0x33,0x37,0xf2,0x2d,0x2f,0x20,0x01,0xff,
+	0x20,0xff,0x20,0x00,0xf3,0x1d,0x41,0xd2,0xc5,0x2b,0x17,0x15,0x62,0xa1,0x63,0x46,
+	0x22,0xf4,0x37,0x1a,0x1d,0xf3,0x16,0x16,0xcf,0x05,0x11,0x61,0x91,0xd2,0x24,0x19,
+	0x1d,0x32,0x31,0x91,0x82,0x33,0x31,0x11,0xf6,0x24,0x21,0x1f,0x94,0x12,0x1f,0x21,
+	0x67,0x14,0x2a,0x35,0x61,0x5c,0x12,0x56,0x15,0x2b,0x16,0x00,0x05,0x25,0xe6,0x51,
+	0x62,0xb1,0x61,0x56,0x2b,0x16,0x42,0x62,0xb1,0x64,0x26,0xe6,0x42,0x62,0xb1,0x60,
+	0x01,0x42,0x62,0x66,0x65,0x16,0x29,0x36,0xc1,0xb2,0x6f,0xf2,0xff,0x20,0x00,0xf4,
+	0x1c,0xf4,0x3a,0x52,0xc2,0xb6,0x2b,0x2b,0x72,0xa2,0xb0,0x00,0x71,0xb2,0x72,0x2b,
+	0xf5,0x1f,0x42,0xb2,0x26,0x18,0x2b,0x32,0x51,0x82,0xb4,0x23,0x19,0x2b,0x42,0x31,
+	0x92,0x52,0x45,0x12,0x13,0xf2,0x38,0x1f,0x80,0x00,0x71,0xf9,0x71,0x52,0xa2,0x56,
+	0x25,0xf0,0x46,0x16,0x2a,0x25,0x25,0x62,0xa2,0x54,0x36,0x2a,0x25,0x52,0x62,0xa2,
+	0x50,0x01,0x43,0x6e,0x54,0x36,0x2a,0x25,0x52,0x62,0xa2,0x5d,0x1b,0x16,0xff,0x20,
+	0xff,0x20,0x00,0x72,0xb1,0xb7,0x3a,0x39,0x72,0xb2,0xa0,0x02,0x72,0x31,0x72,0x52,
+	0x32,0xfd,0x27,0x2b,0x2a,0x00,0x27,0x24,0x16,0x24,0x15,0x72,0x13,0x1e,0x47,0x36,
+	0x18,0x25,0x45,0x71,0x82,0x52,0x41,0x28,0x16,0x26,0x22,0x32,0x81,0x62,0x67,0x29,
+	0x14,0x27,0x00,0x07,0x29,0x22,0x28,0x72,0xa4,0x97,0x2b,0x39,0x72,0xa3,0xa7,0x29,
+	0x21,0x38,0x72,0x82,0x34,0x64,0x56,0x27,0x53,0x54,0x42,0xa5,0x26,0x13,0x3e,0x23,
+	0xff,0x20,0xff,0x20,0x00,0xf0,0x1f,0x1f,0x03,0xef,0x02,0x33,0x9f,0x02,0x44,0x7f,
+	0x02,0x62,0x7f,0x02,0x71,0x7f,0x02,0xf0,0xf0,0x2a,0x14,0xf0,0x29,0x33,0x3f,0x86,
+	0xd5,0xed,0x41,0x1d,0xc5,0x11,0xdc,0x21,0x21,0x2c,0xb2,0x22,0x21,0xcb,0x22,0x22,
+	0x2b,0xa2,0x32,0x32,0xa9,0x24,0x23,0x2a,0x82,0x52,0x42,0x98,0x16,0x25,0x37,0x71,
+	0x72,0x63,0x66,0x18,0x27,0x44,0x51,0x92,0x85,0x24,0x1a,0x29,0x33,0x22,0xb2,0xf0,
+	0xf0,0x2f,0x00,0x02,0xff,0x20,
+};
+
+static const sHZINDEX GB_32_Index[] = {
+	{0xb0ac,  43},	/*  */
+	{0xb1a1,  13},	/*  */
+	{0xb1b1,  41},	/*  */
+	{0xb1be,  33},	/*  */
+	{0xb1c3,  28},	/*  */
+	{0xb2a9,  44},	/*  */
+	{0xb4a5,  68},	/*  */
+	{0xb4ce,  34},	/*  */
+	{0xb5c4,  64},	/*  */
+	{0xb5e3,  57},	/*  */
+	{0xb5e7,  23},	/*  */
+	{0xb6a8,  19},	/*  */
+	{0xb6af,   8},	/*  */
+	{0xb6c8,  29},	/*  */
+	{0xb6d4,  67},	/*  */
+	{0xb7d6,  30},	/*  */
+	{0xb7fe,  54},	/*  */
+	{0xb9ab,  51},	/*  */
+	{0xbbb0,  55},	/*  */
+	{0xbbf7,  58},	/*  */
+	{0xbbfa,  40},	/*  */
+	{0xbcbc,  76},	/*  */
+	{0xbcca,  22},	/*  */
+	{0xbcd3,   4},	/*  */
+	{0xbce4,  38},	/*  */
+	{0xbcf5,   5},	/*  */
+	{0xbde0,  75},	/*  */
+	{0xbdf8,  70},	/*  */
+	{0xbea9,  42},	/*  */
+	{0xbead,  36},	/*  */
+	{0xbfcd,  53},	/*  */
+	{0xbfd5,  27},	/*  */
+	{0xc0eb,  11},	/*  */
+	{0xc1f7,  25},	/*  */
+	{0xc2ca,  32},	/*  */
+	{0xc3fe,  69},	/*  */
+	{0xc4bb,  60},	/* Ļ */
+	{0xc6b5,  31},	/* Ƶ */
+	{0xc6c1,  59},	/*  */
+	{0xc6f4,   7},	/*  */
+	{0xc7b9,  16},	/* ǹ */
+	{0xc7e5,  74},	/*  */
+	{0xc7eb,  56},	/*  */
+	{0xc8ce,  50},	/*  */
+	{0xc9e8,  18},	/*  */
+	{0xcaae,  61},	/* ʮ */
+	{0xcab1,  37},	/* ʱ */
+	{0xcab5,  21},	/* ʵ */
+	{0xcaf5,  77},	/*  */
+	{0xcbbe,  52},	/* ˾ */
+	{0xcda3,   9},	/* ͣ */
+	{0xcfde,  48},	/*  */
+	{0xcfdf,  63},	/*  */
+	{0xd0a1,   6},	/* С */
+	{0xd0a3,  72},	/* У */
+	{0xd0c4,  66},	/*  */
+	{0xd0d0,  71},	/*  */
+	{0xd1b9,  24},	/* ѹ */
+	{0xd2b5,  46},	/* ҵ */
+	{0xd2bb,   2},	/* һ */
+	{0xd2c7,  14},	/*  */
+	{0xd2d1,  35},	/*  */
+	{0xd3d0,  47},	/*  */
+	{0xd3d2,  17},	/*  */
+	{0xd4d9,   1},	/*  */
+	{0xd4f0,  49},	/*  */
+	{0xd4f6,   3},	/*  */
+	{0xd5e6,  26},	/*  */
+	{0xd6b5,  20},	/* ֵ */
+	{0xd6b9,  10},	/* ֹ */
+	{0xd6c7,  45},	/*  */
+	{0xd6d0,  65},	/*  */
+	{0xd7bc,  73},	/* ׼ */
+	{0xd7d3,  12},	/*  */
+	{0xd7d4,  39},	/*  */
+	{0xd7d6,  62},	/*  */
+	{0xd7f3,  15},	/*  */
+};
+#define GB_32_COUNT 77
+
@@ -22,14 +22,7 @@
 /* Includes ------------------------------------------------------------------*/
 #include "fonts.h"
 
-#include "ascii0816.h"
-#include "ascii1020.h"
-#include "ascii1224.h"
-#include "ascii1632.h"
-#include "hzk1616.h"
-#include "hzk2020.h"
-#include "hzk2424.h"
-#include "hzk3232.h"
+#include "fontdata.h"
 
 
 /** @addtogroup Utilities
@@ -78,51 +71,67 @@
   */
 
 sFONT EN_Font8x16 = {
-  nAsciiDot08x16,
+  Ascii08x16_Rle,
   8, /* Width */
   16, /* Height */
+  Ascii08x16_Offset,
 };
 
 sFONT EN_Font10x20 = {
-  nAsciiDot10x20,
+  Ascii10x20_Rle,
   10, /* Width */
   20, /* Height */
+  Ascii10x20_Offset,
 };
    
 sFONT EN_Font12x24 = {
-  nAsciiDot12x24,
+  Ascii12x24_Rle,
   12, /* Width */
   24, /* Height */
+  Ascii12x24_Offset,
 };
    
 sFONT EN_Font16x32 = {
-  nAsciiDot16x32,
+  Ascii16x32_Rle,
   16, /* Width */
   32, /* Height */
+  Ascii16x32_Offset,
 };   
 
 sFONT CH_Font16x16 = {
-  (const uint8_t*)GB_16,
+  GB_16_Rle,
   16, /* Width */
   16, /* Height */
+  GB_16_Offset,
+  GB_16_Index,
+  GB_16_COUNT,
 };
 
 sFONT CH_Font20x20 = {
-  (const uint8_t*)GB_20,
+  GB_20_Rle,
   20, /* Width */
   20, /* Height */
+  GB_20_Offset,
+  GB_20_Index,
+  GB_20_COUNT,
 };
 
 sFONT CH_Font24x24 = {
-  (const uint8_t*)GB_24,
+  GB_24_Rle,
   24, /* Width */
   24, /* Height */
+  GB_24_Offset,
+  GB_24_Index,
+  GB_24_COUNT,
 };
 
 sFONT CH_Font32x32 = {
-  (const uint8_t*)GB_32,
+  GB_32_Rle,
   32, /* Width */
   32, /* Height */
+  GB_32_Offset,
+  GB_32_Index,
+  GB_32_COUNT,
 };
 
 
@@ -30,11 +30,23 @@
 /* Includes ------------------------------------------------------------------*/
 #include <stdint.h>
 
+/* A GB2312 code, first byte in the high byte, and its glyph in the table. */
+typedef struct _tHzIndex
+{
+  uint16_t Code;
+  uint16_t Glyph;
+} sHZINDEX;
+
+/* The glyphs are run length encoded by makefont, glyph n starts at
+   table + offset[n].  EN fonts start at ' '. */
 typedef struct _tFont
 {    
   const uint8_t *table;
   uint16_t Width;
   uint16_t Height;
+  const uint16_t *offset;
+  const sHZINDEX *index;	/* CH fonts: sorted by code, made by makefont */
+  uint16_t count;
   
 } sFONT;
 
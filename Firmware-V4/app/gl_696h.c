@@ -12,11 +12,15 @@
 
 #include "gl_696h.h"
 #include "adc.h"
+#include "filter.h"
 #include "gpio.h"
 #include "pwm_dac.h"
 #include "serials.h"
+#include "dev_parser.h"
+#include "job_sched.h"
 #include "mb_reg_map.h"
 #include "modbus.h"
+#include "httpd-api.h"
 //#include "gsm.h"
 
 //----------------------------------------------------------------
@@ -45,6 +49,17 @@
 #define VOL_DAC_FULL	5000
 #define CUR_DAC_FULL	5000
 
+//default PI gains, 1/256, tuned on the supply model in test/test_hv.c
+#define HV_VOL_KP		128
+#define HV_VOL_KI		96
+#define HV_VOL_KFF		850		//1/1000, a little low so the output approaches from below
+#define HV_CUR_KP		128
+#define HV_CUR_KI		32
+//the current PI runs on its own period, the step interval paces the ladder
+#define HV_CUR_PI_INTERVAL	200		//mS
+//in PI mode one update moves the output by at most this many steps
+#define HV_SLEW_STEPS	50
+
 //----------------------------------------------------------------
 #define DO_RELAY_ON 	pdLOW
 #define DO_RELAY_OFF 	pdHIGH
@@ -71,7 +86,6 @@ sTIMEOUT hvl_cur_set_to,hvl_cur_check_to;
 
 sTIMEOUT hvr_vol_set_to,hvr_vol_check_to;
 sTIMEOUT hvr_cur_set_to,hvr_cur_check_to;
-sTIMEOUT sec_to;
 //----------------------------------------------------------------
 //ռƿضʱеô20Sռƣеùرǰȹرռ
 sTIMEOUT led_to;
@@ -95,8 +109,65 @@ uint16_t sample_buf[SAMPLE_ADC_FILTER_SIZE];
 //uint16_t usRegInputBuf[64];
 
 void hvs_update_to_modbus(HVS* hvs);
+void hvs_set_to_modbus(HVS* hvs);
 void hv_enbale(HVS* hvs,int32_t st);
-void hvs_update_from_modbus(HVS* hvs);
+
+//-----------------------------------------------------------------------------------
+//control jobs, the table order is also the order of the MB_SCHED_STAT registers
+enum { JOB_HVL=0, JOB_HVR, JOB_ADC, JOB_TELEM, JOB_SEQ, JOB_STAT, JOB_MPUMP, JOB_MOTOR };
+
+static void hvl_job(void);
+static void hvr_job(void);
+static void adc_job(void);
+static void telem_job(void);
+static void seq_job(void);
+static void stat_job(void);
+static void mpump_job(void);
+static void motor_job(void);
+
+static SCHED_JOB sched_jobs[SCHED_STAT_JOBS] = {
+	//name		func		period	deadline	trigger
+	{ "hvl",	hvl_job,	10,		10,			SCHED_PERIODIC },
+	{ "hvr",	hvr_job,	10,		10,			SCHED_PERIODIC },
+	{ "adc",	adc_job,	10,		10,			SCHED_PERIODIC },
+	{ "telem",	telem_job,	10,		20,			SCHED_PERIODIC },
+	{ "seq",	seq_job,	1000,	500,		SCHED_PERIODIC | SCHED_EVENT },
+	{ "stat",	stat_job,	1000,	100,		SCHED_PERIODIC },
+	{ "mpump",	mpump_job,	2000,	500,		SCHED_PERIODIC | SCHED_EVENT },
+	{ "motor",	motor_job,	60000,	100,		SCHED_PERIODIC },
+};
+
+//ctl runs the gun loops in the GL696H task, io and slow run below it so a
+//blocking serial exchange never holds up the HV regulation. seq and mpump
+//send pump commands that sleep on the line, they stay off io where telem
+//runs and take turns on the pump line
+static SCHED_LANE ctl_lane,io_lane,slow_lane;
+static SCHED_LANE* const sched_job_lane[SCHED_STAT_JOBS] = {
+	&ctl_lane, &ctl_lane, &ctl_lane, &io_lane, &slow_lane, &io_lane, &slow_lane, &slow_lane
+};
+void hvs_update_from_modbus(HVS* hvs,const ULONG* dirty);
+
+//holding register watches, a gun reloads the parameters the host wrote and
+//the auto sequence runs as soon as a command lands. The loops publish their
+//set points with local writes, which mark nothing
+static void seq_notify(void* arg);
+
+//the gun parameters, MB_CUR_PI_INTERVAL sits behind the pump registers
+#define HV_WATCH_NREGS	(MB_CUR_PI_INTERVAL - MB_VOL_MAX + 1)
+static xMBRegWatch hvl_watch = { MB_VOL_MAX, HV_WATCH_NREGS, NULL, NULL };
+static xMBRegWatch hvr_watch = { MB_VOL_MAX, HV_WATCH_NREGS, NULL, NULL };
+static xMBRegWatch seq_watch = { MB_SYS_AUTOCTL, 1, seq_notify, NULL };
+
+//the auto sequence runs on slow_lane under the gun loops and never writes a
+//gun itself. It posts a command here, the gun's job applies it on ctl_lane
+//at the start of its next pass. A newer enable or off replaces the other
+#define HV_CMD_ENABLE	(1UL<<0)
+#define HV_CMD_SET_ZERO	(1UL<<1)	//set points to 0, back to the host too
+#define HV_CMD_OFF		(1UL<<2)	//current DAC to 0, power off and disable
+static volatile uint32_t hvl_cmd = 0;
+static volatile uint32_t hvr_cmd = 0;
+static void hv_cmd_post(HVS* hvs,uint32_t cmd);
+static void hv_cmd_apply(HVS* hvs);
 //-----------------------------------------------------------------------
 QUEUE vol_queue_l;
 QUEUE vol_queue_r;
@@ -105,36 +176,17 @@ QUEUE cur_queue_r;
 
 QUEUE sample_queue;
 
-void init_queue(pQUEUE q,uint16_t *buf,uint8_t size)
-{
-	q->queue = buf;
-	q->size  = size;
-	q->front = q->rear = 0;
-}
-
-uint8_t enqueue(pQUEUE q,uint16_t da)
-{
-	q->queue[q->rear++] = da;
-	if (q->rear == q->size)
-		q->rear = 0;
-
-	if (q->rear == q->front){
-		q->front ++;
-		if (q->front == q->size)
-			q->front = 0;
-		return 1;
-	}
-
-	return 0;
-}
-
 //-----------------------------------------------------------------------------------
 void vmeter_set_reg(float v)
 {
+	uint16_t reg[2];
+
 	vmeter = v;
 	
-	eMBRegInput_Write(MB_VMETER0,(((uint8_t*)&vmeter)[3]<<8) | ((uint8_t*)&vmeter)[2]);
-	eMBRegInput_Write(MB_VMETER1,(((uint8_t*)&vmeter)[1]<<8) | ((uint8_t*)&vmeter)[0]);
+	//both halves of the float are published together
+	reg[0] = (((uint8_t*)&vmeter)[3]<<8) | ((uint8_t*)&vmeter)[2];
+	reg[1] = (((uint8_t*)&vmeter)[1]<<8) | ((uint8_t*)&vmeter)[0];
+	eMBRegInput_WriteBlock(MB_VMETER0,reg,2);
 }
 
 //ռƵԴ
@@ -169,50 +221,23 @@ void vmeter_init(void)
 //УusRegInputBuf[MB_VMETER0]Ϊbit31-16,usRegInputBuf[MB_VMETER1]Ϊbit15-0
 int32_t vmeter_task()
 {
-	static uint8_t buf[32];
-	static int32_t rx_len=0;
-	float vmeter;
-	int32_t i;
+	static VMETER_PARSER parser;
+	VMETER_EVENT ev;
+	const uint8_t* p;
+	uint16_t i,len;
   	
 	if ( eMBRegInput_Read(MB_VMETER_ST) & VMETER_PWR_OFF )
 		return 0;
 	
-	if ( rx_len + 9 > sizeof(buf) )
-		rx_len = 0;
-
-	i = xSerialGet(vmeter_Port,buf+rx_len,sizeof(buf)-rx_len,configTICK_RATE_HZ/100);
-	if ( i == 0 )
-		return 0;
-	/*
-	buf[0] = 0x2A;
-	memcpy(buf+1,"2313----",8);
-	*/
-	
-	rx_len += i;
-	for ( i=0; rx_len-i>=9; i++ ){
-		if ( buf[i] == 0x2A ){
-			rx_len = 0;
-			buf[i+9] = '\0';
-			//usart_printf(DBGU,"\r\nռ:%s,",buf+i+1);
-			
-			if ( buf[i+2+4] != '-' )//ֻҪݣЩΪ׼ 
-				i += 4;
-			else if ( buf[i+2] == '?' || buf[i+2] == '-'){
-				rx_len=0 ;
-				break;
-			}
-				
-			vmeter = buf[i+1] - '0';
-			vmeter += (float)(buf[i+2] - '0')/10;
-			if ( buf[i+3] == '+' )
-				vmeter *= pow(10,(buf[i+4]-'0'));
-			else if ( buf[i+3] == '-' )
-				vmeter *= pow(10,-(buf[i+4]-'0'));
-
-			vmeter_set_reg(vmeter);
-			break;
+	//parse straight out of the receive ring, the reading is published
+	//as soon as the last byte of its frame is in
+	while ( (len = xSerialReadSpan(vmeter_Port,&p,0)) != 0 ){
+		for ( i=0; i<len; i++ ){
+			if ( vmeter_parse(&parser,p[i],&ev) == PARSE_EVENT )
+				vmeter_set_reg(ev.pressure);
 		}
-	}	
+		vSerialReadSpanDone(vmeter_Port,len);
+	}
 	return 0;
 }
 
@@ -225,13 +250,17 @@ void powerpump_init(void)
 
 int32_t powerpump_ctl(int32_t cmd)
 {
+	uint16_t reg;
+
 	if ( cmd & POWER_OFF ) {
 		eMBRegInput_Write(MB_SYS_AUTOCTL_ST,0);
-		eMBRegHolding_Write(MB_SYS_AUTOCTL,SYS_AUTO_OFF);
+		reg = SYS_AUTO_OFF;
+		eMBRegHolding_WriteNotify(MB_SYS_AUTOCTL,&reg,1);
 	} else if ( cmd & POWER_ON ) {
 		eMBRegInput_Write(MB_SYS_AUTOCTL_ST,0);
-		eMBRegHolding_Write(MB_SYS_AUTOCTL,SYS_AUTO_ON);
 		auto_st_end = 1;
+		reg = SYS_AUTO_ON;
+		eMBRegHolding_WriteNotify(MB_SYS_AUTOCTL,&reg,1);
 	}
 	return 0;
 }
@@ -321,45 +350,32 @@ void mpump_ctl_from_com(int32_t cmd)
 
 int32_t mpump_task()
 {
-	static uint8_t buf[64];
-	static int32_t rx_len=0;
-	int32_t i;
-	//uint8_t xor;
-
-	if ( xSerialIsArrive(FD110A_Port) == pdFALSE )
-		return 0;
-		
-	if ( rx_len + 11 > sizeof(buf) )
-		rx_len = 0;
-		
-	i = xSerialGet(FD110A_Port,buf+rx_len,sizeof(buf)-rx_len,configTICK_RATE_HZ/100);
-	rx_len += i;
-	
-	for ( i=0; rx_len-i>=11; i++ ){
-		if ( buf[i] == 0xAB && buf[i+1] == 0x91 && buf[i+2] == 0x07 ){
-			//for(xor=0,j=1;j<buf[i+2]+2;j++)
-			//	xor ^= buf[i+j];
-			//if ( xor != buf[10] ){
-			//	rx_len = 0;
-			//	return 0;
-			//}
-			
-			eMBRegInput_Write(MB_MPUMP_ST	,buf[i+3]);//ӵ8λ״̬
-			eMBRegInput_Write(MB_MPUMP_FREQ	,buf[i+4]*100 + buf[i+5]);
-			eMBRegInput_Write(MB_MPUMP_VOL	,buf[i+6]*100 + buf[i+7]);
-			eMBRegInput_Write(MB_MPUMP_CUR	,buf[i+8]*100 + buf[i+9]);
-			if ( eMBRegInput_Read(MB_MPUMP_FREQ) > 999 )
-				eMBRegInput_Write(MB_MPUMP_FREQ,999);
-			rx_len = 0;
-			break;
+	static MPUMP_PARSER parser;
+	MPUMP_EVENT ev;
+	const uint8_t* p;
+	uint16_t i,len;
+	uint16_t reg[4];
+
+	while ( (len = xSerialReadSpan(FD110A_Port,&p,0)) != 0 ){
+		for ( i=0; i<len; i++ ){
+			if ( mpump_parse(&parser,p[i],&ev) != PARSE_EVENT )
+				continue;
+			//the pump reports the low 8 bits, the power bits are ours
+			reg[MB_MPUMP_ST   - MB_MPUMP_ST] = (eMBRegInput_Read(MB_MPUMP_ST) & 0xFF00) | ev.st;
+			reg[MB_MPUMP_FREQ - MB_MPUMP_ST] = ev.freq > 999 ? 999 : ev.freq;
+			reg[MB_MPUMP_VOL  - MB_MPUMP_ST] = ev.vol;
+			reg[MB_MPUMP_CUR  - MB_MPUMP_ST] = ev.cur;
+			eMBRegInput_WriteBlock(MB_MPUMP_ST,reg,4);
 		}
-	}	
+		vSerialReadSpanDone(FD110A_Port,len);
+	}
 	return 0;		
 }
 
 void mpump_init(void)
 {
 	float vmeter_set0 = 8.0e0;
+	uint16_t reg[2];
 	
 	eMBRegInput_Write( MB_MPUMP_ST	,0);
 	eMBRegInput_Write( MB_MPUMP_FREQ,0);
@@ -368,8 +384,9 @@ void mpump_init(void)
 	
 	eMBRegHolding_Write( MB_MPUMP_PWR_OFF_FREQ	,10);
 
-	eMBRegHolding_Write( MB_VMETER_SET0	,(((uint8_t*)&vmeter_set0)[0]<<8)|(((uint8_t*)&vmeter_set0)[1]));
-	eMBRegHolding_Write( MB_VMETER_SET1	,(((uint8_t*)&vmeter_set0)[2]<<8)|(((uint8_t*)&vmeter_set0)[3]));
+	reg[0] = (((uint8_t*)&vmeter_set0)[0]<<8)|(((uint8_t*)&vmeter_set0)[1]);
+	reg[1] = (((uint8_t*)&vmeter_set0)[2]<<8)|(((uint8_t*)&vmeter_set0)[3]);
+	eMBRegHolding_WriteBlock( MB_VMETER_SET0, reg, 2 );
   
 	FD110A_Port = xSerialPortInit( serCOM2, ser4800, serNO_PARITY, serBITS_8, serSTOP_1, 256 );
 	mpump_ctl(POWER_OFF | MPUMP_STOP);
@@ -378,6 +395,7 @@ void mpump_init(void)
 int32_t mpump_ctl( uint16_t cmd )
 {	
 	uint8_t vmeter_set[4];
+	uint16_t set_reg[2];
 	uint16_t reg;
 	
 	if ( cmd & MPUMP_PWR_OFF ){
@@ -425,10 +443,11 @@ int32_t mpump_ctl( uint16_t cmd )
 		eMBRegInput_Write(MB_MPUMP_ST,( reg & ~MPUMP_RUN));
 	} else if ( cmd & MPUMP_RUN ) {
 		//նȴﲻ8.0e0򲻿Կӱ
-		vmeter_set[0] = eMBRegHolding_Read(MB_VMETER_SET0)>>8;
-		vmeter_set[1] = eMBRegHolding_Read(MB_VMETER_SET0);
-		vmeter_set[2] = eMBRegHolding_Read(MB_VMETER_SET1)>>8;
-		vmeter_set[3] = eMBRegHolding_Read(MB_VMETER_SET1);
+		eMBRegHolding_ReadBlock(MB_VMETER_SET0,set_reg,2);
+		vmeter_set[0] = set_reg[0]>>8;
+		vmeter_set[1] = set_reg[0];
+		vmeter_set[2] = set_reg[1]>>8;
+		vmeter_set[3] = set_reg[1];
 		
 		if ( vmeter > *(float*)vmeter_set ){
 			return -4;
@@ -448,7 +467,11 @@ int32_t auto_ctl_task(void)
 	int32_t auto_st;
 	static int32_t timer = 0;
 	static sTIMEOUT vmeter_to;
-	uint16_t reg = eMBRegHolding_Read(MB_SYS_AUTOCTL);
+	uint16_t reg;
+
+	//this run sees every command written so far
+	eMBRegHolding_TakeDirty(&seq_watch,MB_SYS_AUTOCTL,1);
+	reg = eMBRegHolding_Read(MB_SYS_AUTOCTL);
 
 	if ( reg & SYS_AUTO_ON ){
 		auto_st = (eMBRegInput_Read(MB_SYS_AUTOCTL_ST) >> SYS_AUTO_ON_ST) & 0x0F;
@@ -463,8 +486,8 @@ int32_t auto_ctl_task(void)
 	
 			//ȿеãӳٿռ
 			start_timeout(&vmeter_to,eMBRegHolding_Read(VMETER_START_DELAY));
-			hv_enbale(&hvsl,ENABLE);
-			hv_enbale(&hvsr,ENABLE);
+			hv_cmd_post(&hvsl,HV_CMD_ENABLE);
+			hv_cmd_post(&hvsr,HV_CMD_ENABLE);
 			auto_st ++;
 			break;
 		case 1:
@@ -486,12 +509,12 @@ int32_t auto_ctl_task(void)
 				auto_st++;
 			break;
 		case 5:
-			hv_enbale(&hvsl,ENABLE);
-			hv_enbale(&hvsr,ENABLE);
+			hv_cmd_post(&hvsl,HV_CMD_ENABLE);
+			hv_cmd_post(&hvsr,HV_CMD_ENABLE);
 			auto_st++;
 			break;
 		case 6:
-			eMBRegHolding_Write(MB_SYS_AUTOCTL,reg & ~SYS_AUTO_ON);
+			reg &= ~SYS_AUTO_ON;
 			auto_st = 0x0F;
 			break;
 		default :
@@ -503,38 +526,22 @@ int32_t auto_ctl_task(void)
 		auto_st = (eMBRegInput_Read(MB_SYS_AUTOCTL_ST) >> SYS_AUTO_OFF_ST) & 0x0F;
 		switch( auto_st ){
 		case 0:
-			hvsl.vol_set = 0;
-			hvsr.vol_set = 0;
-			hvsl.cur_set = 0;
-			hvsr.cur_set = 0;
-			hvs_update_to_modbus(&hvsl);
-			hvs_update_to_modbus(&hvsr);
+			hv_cmd_post(&hvsl,HV_CMD_SET_ZERO);
+			hv_cmd_post(&hvsr,HV_CMD_SET_ZERO);
 			auto_st ++;
 			timer = 0;
 			break;
 		case 1:
 			if ( hvsl.vol_fb < 1000 && hvsr.vol_fb < 1000 || timer ++ > 5){
-				PWM_DAC_SetmV( HVL_CUR_DAC_CH, 0 );//ر
-				PWM_DAC_SetmV( HVR_CUR_DAC_CH, 0 );//ر
-				DIO_Write(hvsl.power_ch,DO_POWER_OFF);	
-				DIO_Write(hvsr.power_ch,DO_POWER_OFF);	
-				hv_enbale(&hvsl,DISABLE);
-				hv_enbale(&hvsr,DISABLE);
-				hvsl.vol_ctl = 0;
-				hvsr.vol_ctl = 0;
-				hvsl.cur_ctl = 0;
-				hvsr.cur_ctl = 0;
-				hvsl.vol_fb = 0;
-				hvsr.vol_fb = 0;
-				hvsl.cur_fb = 0;
-				hvsr.cur_fb = 0;
-				hvs_update_to_modbus(&hvsl);
-				hvs_update_to_modbus(&hvsr);
-
+				hv_cmd_post(&hvsl,HV_CMD_OFF);//ر
+				hv_cmd_post(&hvsr,HV_CMD_OFF);//ر
 				auto_st ++;
 			}
 			break;
 		case 2:
+			//the guns are off before the pump stops
+			if ( hvl_cmd | hvr_cmd )
+				break;
 			mpump_ctl( MPUMP_PWR_OFF | MPUMP_STOP );
 			auto_st ++;
 			break;
@@ -568,7 +575,8 @@ int32_t auto_ctl_task(void)
 		}
 		eMBRegInput_Write(MB_SYS_AUTOCTL_ST,(auto_st << SYS_AUTO_OFF_ST) | SYS_AUTO_OFF);
 	}
-	eMBRegHolding_Write(MB_SYS_AUTOCTL,reg);
+	if ( eMBRegHolding_Read(MB_SYS_AUTOCTL) != reg )
+		eMBRegHolding_Write(MB_SYS_AUTOCTL,reg);
 	return 0;
 }
 
@@ -623,6 +631,17 @@ void hv_init(void)
 	hvsr.cur_set	= 0;
 	hvsr.vol_set	= 0;
 	hvsr.cur_set	= 0;
+
+	//the host software does not know the PI gains yet, seed them so the
+	//PI control is active from power up, both guns share the registers
+	eMBRegHolding_Write(MB_VOL_KP,	HV_VOL_KP);
+	eMBRegHolding_Write(MB_VOL_KI,	HV_VOL_KI);
+	eMBRegHolding_Write(MB_VOL_KFF,	HV_VOL_KFF);
+	eMBRegHolding_Write(MB_CUR_KP,	HV_CUR_KP);
+	eMBRegHolding_Write(MB_CUR_KI,	HV_CUR_KI);
+	eMBRegHolding_Write(MB_CUR_PI_INTERVAL,	HV_CUR_PI_INTERVAL);
+	hvsl.vol_integ = hvsr.vol_integ = 0;
+	hvsl.cur_integ = hvsr.cur_integ = 0;
 	
 	hvsl.id 			= HVL;
 	hvsl.vol_ctl 		= 0;
@@ -642,8 +661,9 @@ void hv_init(void)
 	hvsl.vol_check_to 	= creat_timeout(&hvl_vol_check_to);
 	hvsl.cur_set_to 	= creat_timeout(&hvl_cur_set_to);
 	hvsl.cur_check_to 	= creat_timeout(&hvl_cur_check_to);
+	hvs_set_to_modbus(&hvsl);
 	hvs_update_to_modbus(&hvsl);
-	hvs_update_from_modbus(&hvsl);
+	hvs_update_from_modbus(&hvsl,NULL);
 	
 	hvsr.id 			= HVR;
 	hvsr.vol_ctl 		= 0;
@@ -663,9 +683,12 @@ void hv_init(void)
 	hvsr.vol_check_to 	= creat_timeout(&hvr_vol_check_to);	
 	hvsr.cur_set_to 	= creat_timeout(&hvr_cur_set_to);	
 	hvsr.cur_check_to 	= creat_timeout(&hvr_cur_check_to);
+	hvs_set_to_modbus(&hvsr);
 	hvs_update_to_modbus(&hvsr);
-	hvs_update_from_modbus(&hvsr);
+	hvs_update_from_modbus(&hvsr,NULL);
 
+	hvl_cmd = 0;
+	hvr_cmd = 0;
 	hv_enbale(&hvsl,ENABLE);
 	hv_enbale(&hvsr,ENABLE);
 
@@ -673,71 +696,95 @@ void hv_init(void)
 	DIO_Write(hvsr.power_ch,DO_POWER_OFF);
 }
 
-void hvs_update_from_modbus(HVS* hvs)
+//all parameters come from one snapshot, a host write can not be seen half applied
+void hvs_update_from_modbus(HVS* hvs,const ULONG* dirty)
 {
-
-	hvs->vol_max 			= eMBRegHolding_Read(MB_VOL_MAX);
-	hvs->vol_scale 			= eMBRegHolding_Read(MB_VOL_SCALE);
-	hvs->vol_err_rate		= eMBRegHolding_Read(MB_VOL_ERR_RATE);
-	hvs->vol_step 			= eMBRegHolding_Read(MB_VOL_STEP);
-	hvs->vol_step_interval	= eMBRegHolding_Read(MB_VOL_STEP_INTERVAL);
-	hvs->vol_step_timeout 	= eMBRegHolding_Read(MB_VOL_STEP_TIMEOUT);
-	hvs->vol_level1 		= eMBRegHolding_Read(MB_VOL_LEVEL1);
+	uint16_t reg[HV_WATCH_NREGS];
+	#define HVS_REG(addr)	reg[(addr) - MB_VOL_MAX]
+	//only what the host wrote, dirty NULL loads everything
+	#define HVS_LOAD(field,addr) \
+		if ( dirty == NULL || MB_REG_DIRTY(dirty,addr) ) hvs->field = HVS_REG(addr)
+
+	eMBRegHolding_ReadBlock(MB_VOL_MAX,reg,HV_WATCH_NREGS);
+
+	HVS_LOAD(vol_max,			MB_VOL_MAX);
+	HVS_LOAD(vol_scale,			MB_VOL_SCALE);
+	HVS_LOAD(vol_err_rate,		MB_VOL_ERR_RATE);
+	HVS_LOAD(vol_step,			MB_VOL_STEP);
+	HVS_LOAD(vol_step_interval,	MB_VOL_STEP_INTERVAL);
+	HVS_LOAD(vol_step_timeout,	MB_VOL_STEP_TIMEOUT);
+	HVS_LOAD(vol_level1,		MB_VOL_LEVEL1);
 	
-	hvs->cur_max 			= eMBRegHolding_Read(MB_CURRRENT_MAX);
-	hvs->cur_err_rate		= eMBRegHolding_Read(MB_CUR_ERR_RATE);
-	hvs->cur_scale 			= eMBRegHolding_Read(MB_CUR_SCALE);
-	hvs->cur_step 			= eMBRegHolding_Read(MB_CUR_STEP);
-	hvs->cur_step_interval	= eMBRegHolding_Read(MB_CUR_STEP_INTERVAL);
-	hvs->cur_step_timeout	= eMBRegHolding_Read(MB_CUR_STEP_TIMEOUT);
-	hvs->cur_ctl_start		= eMBRegHolding_Read(MB_CUR_CTL_START);
+	HVS_LOAD(cur_max,			MB_CURRRENT_MAX);
+	HVS_LOAD(cur_err_rate,		MB_CUR_ERR_RATE);
+	HVS_LOAD(cur_scale,			MB_CUR_SCALE);
+	HVS_LOAD(cur_step,			MB_CUR_STEP);
+	HVS_LOAD(cur_step_interval,	MB_CUR_STEP_INTERVAL);
+	HVS_LOAD(cur_step_timeout,	MB_CUR_STEP_TIMEOUT);
+	HVS_LOAD(cur_ctl_start,		MB_CUR_CTL_START);
+
+	HVS_LOAD(vol_kp,			MB_VOL_KP);
+	HVS_LOAD(vol_ki,			MB_VOL_KI);
+	HVS_LOAD(vol_kff,			MB_VOL_KFF);
+	HVS_LOAD(cur_kp,			MB_CUR_KP);
+	HVS_LOAD(cur_ki,			MB_CUR_KI);
+	HVS_LOAD(cur_pi_interval,	MB_CUR_PI_INTERVAL);
 
 	switch( hvs->id )	{
 	case HVL:
-		hvs->vol_set	= eMBRegHolding_Read(MB_VOL_SET_L);
-		hvs->cur_set	= eMBRegHolding_Read(MB_CUR_SET_L);
+		HVS_LOAD(vol_set,	MB_VOL_SET_L);
+		HVS_LOAD(cur_set,	MB_CUR_SET_L);
 		break;
 	case HVR:
-		hvs->vol_set	= eMBRegHolding_Read(MB_VOL_SET_R);
-		hvs->cur_set	= eMBRegHolding_Read(MB_CUR_SET_R);
+		HVS_LOAD(vol_set,	MB_VOL_SET_R);
+		HVS_LOAD(cur_set,	MB_CUR_SET_R);
 		break;
 	default:
 		break;
 	}	
+	#undef HVS_LOAD
+	#undef HVS_REG
 }
 
+//the state block of one gun is laid out as ST,VOL_FB,CUR_FB,VOL_CTL,CUR_CTL.
+//The set points are the host's, they go back to the holding registers only
+//through hvs_set_to_modbus when the firmware overrides them
 void hvs_update_to_modbus(HVS* hvs)
 {
+	uint16_t st[5];
+	uint16_t set[2];
+
+	st[MB_HV_ST_L	- MB_HV_ST_L] = hvs->st;
+	st[MB_VOL_FB_L	- MB_HV_ST_L] = hvs->vol_fb;
+	st[MB_CUR_FB_L	- MB_HV_ST_L] = hvs->cur_fb;
+	st[MB_VOL_CTL_L	- MB_HV_ST_L] = hvs->vol_ctl;
+	st[MB_CUR_CTL_L	- MB_HV_ST_L] = hvs->cur_ctl;
+	set[0] = hvs->vol_set;
+	set[1] = hvs->cur_set;
+
 	switch( hvs->id )	{
 		case HVL:
-			eMBRegHolding_Write	(MB_VOL_SET_L,hvs->vol_set);
-			eMBRegHolding_Write (MB_CUR_SET_L,hvs->cur_set);
-			
-			eMBRegInput_Write(MB_VOL_SET_L_ST	,hvs->vol_set);
-			eMBRegInput_Write(MB_CUR_SET_L_ST	,hvs->cur_set);
-			eMBRegInput_Write(MB_HV_ST_L	,hvs->st);
-			eMBRegInput_Write(MB_VOL_FB_L	,hvs->vol_fb);
-			eMBRegInput_Write(MB_VOL_CTL_L	,hvs->vol_ctl);
-			eMBRegInput_Write(MB_CUR_FB_L	,hvs->cur_fb);
-			eMBRegInput_Write(MB_CUR_CTL_L	,hvs->cur_ctl);
+			eMBRegInput_WriteBlock(MB_VOL_SET_L_ST,set,2);
+			eMBRegInput_WriteBlock(MB_HV_ST_L,st,5);
 			break;
 		case HVR:
-			eMBRegHolding_Write(MB_VOL_SET_R,hvs->vol_set);
-			eMBRegHolding_Write(MB_CUR_SET_R,hvs->cur_set);
-			
-			eMBRegInput_Write(MB_VOL_SET_R_ST	,hvs->vol_set);
-			eMBRegInput_Write(MB_CUR_SET_R_ST	,hvs->cur_set);
-			eMBRegInput_Write(MB_HV_ST_R	,hvs->st);
-			eMBRegInput_Write(MB_VOL_FB_R	,hvs->vol_fb);
-			eMBRegInput_Write(MB_VOL_CTL_R	,hvs->vol_ctl);
-			eMBRegInput_Write(MB_CUR_FB_R	,hvs->cur_fb);
-			eMBRegInput_Write(MB_CUR_CTL_R	,hvs->cur_ctl);
+			eMBRegInput_WriteBlock(MB_VOL_SET_R_ST,set,2);
+			eMBRegInput_WriteBlock(MB_HV_ST_R,st,5);
 			break;
 		default:
 			break;
 	}	
 }
 
+void hvs_set_to_modbus(HVS* hvs)
+{
+	uint16_t set[2];
+
+	set[0] = hvs->vol_set;
+	set[1] = hvs->cur_set;
+	eMBRegHolding_WriteBlock(hvs->id == HVL ? MB_VOL_SET_L : MB_VOL_SET_R,set,2);
+}
+
 void hv_enbale(HVS* hvs,int32_t st)
 {
 	if ( st == DISABLE )
@@ -746,9 +793,54 @@ void hv_enbale(HVS* hvs,int32_t st)
 		hvs->st |= HV_ENABLE;	
 }
 
+static void hv_cmd_post(HVS* hvs,uint32_t cmd)
+{
+	volatile uint32_t* req = hvs->id == HVL ? &hvl_cmd : &hvr_cmd;
+
+	vPortEnterCritical();
+	if ( cmd & HV_CMD_ENABLE )
+		*req &= ~HV_CMD_OFF;
+	if ( cmd & HV_CMD_OFF )
+		*req &= ~HV_CMD_ENABLE;
+	*req |= cmd;
+	vPortExitCritical();
+}
+
+//in the gun's job, nothing else writes the gun while it runs
+static void hv_cmd_apply(HVS* hvs)
+{
+	volatile uint32_t* req = hvs->id == HVL ? &hvl_cmd : &hvr_cmd;
+	uint32_t cmd;
+
+	vPortEnterCritical();
+	cmd = *req;
+	*req = 0;
+	vPortExitCritical();
+	if ( cmd == 0 )
+		return;
+
+	if ( cmd & HV_CMD_SET_ZERO ){
+		hvs->vol_set = 0;
+		hvs->cur_set = 0;
+		hvs_set_to_modbus(hvs);
+	}
+	if ( cmd & HV_CMD_OFF ){
+		PWM_DAC_SetmV( hvs->cur_dac_ch, 0 );
+		DIO_Write(hvs->power_ch,DO_POWER_OFF);
+		hv_enbale(hvs,DISABLE);
+		hvs->vol_ctl = 0;
+		hvs->cur_ctl = 0;
+		hvs->vol_fb = 0;
+		hvs->cur_fb = 0;
+	}
+	if ( cmd & HV_CMD_ENABLE )
+		hv_enbale(hvs,ENABLE);
+	hvs_update_to_modbus(hvs);
+}
+
 void hv_update_vol(HVS* hvs)
 { 
-	uint16_t adc[32];
+	uint16_t adc[ADC_BLOCK_SAMPLES];
 	uint32_t temp;
 	uint32_t i,sum,valid;
 	
@@ -763,9 +855,9 @@ void hv_update_vol(HVS* hvs)
 	}
 	
 	//update voltage	
-	ADC_Get(hvs->vol_adc_ch,adc,32);	
-	exchange_sort16(adc,32);
-	temp = get_average16(adc+8,32-2*8);
+	if ( ADC_GetBlock(ADC_CH_INDEX(hvs->vol_adc_ch),adc) == 0 )
+		return ;
+	temp = trimmed_mean16(adc,ADC_BLOCK_SAMPLES,4);
 //	enqueue(hvs->vol_queue,temp);
 //	exchange_sort16(hvs->vol_queue->queue,hvs->vol_queue->size);//sort the adc data
 //	for(i=1,sum=0,valid=0;i<hvs->vol_queue->size-1*2;i++){
@@ -785,9 +877,8 @@ void hv_update_vol(HVS* hvs)
 
 void hv_update_cur(HVS* hvs)
 { 
-	uint16_t adc[32];
+	uint16_t adc[ADC_BLOCK_SAMPLES];
 	uint32_t temp;
-	uint32_t i,sum,valid;
 
 	if ( hvs->id == HVR ){
 	} else if ( hvs->id == HVL ){
@@ -799,26 +890,57 @@ void hv_update_cur(HVS* hvs)
 		return ;
 	}
 	
-	ADC_Get(hvs->cur_adc_ch,adc,32);		
-	exchange_sort16(adc,32);
-	temp = get_average16(adc+0,32-2*0);
+	if ( ADC_GetBlock(ADC_CH_INDEX(hvs->cur_adc_ch),adc) == 0 )
+		return ;
+	temp = get_average16(adc,ADC_BLOCK_SAMPLES);
 	enqueue(hvs->cur_queue,temp);
-	exchange_sort16(hvs->cur_queue->queue,hvs->cur_queue->size);//sort the adc data
-	for(i=1,sum=0,valid=0;i<hvs->cur_queue->size-1*2;i++){
-  		//temp = (uint32_t)hvs->cur_queue->queue[i]*10 / hvs->cur_queue->queue[hvs->cur_queue->size/2];
-  		//if ( temp > 5 && temp < 20 )
-		{
-			sum += hvs->cur_queue->queue[i];
-			valid++;
-		}
-	}
-	temp = sum/valid;
+	//the ring stays in FIFO order, the filter works on a copy
+	temp = queue_trimmed_mean16(hvs->cur_queue,1);
 	
 	hvs->cur_fb = temp*2500*2/4095 * hvs->cur_scale;
 	if ( hvs->cur_fb < 150 )
 		hvs->cur_fb = 0;
 }
 	
+//-----------------------------------------------------------------------------------
+//discrete PI in Q8 with feed forward, out = ff + (kp*err + integ) / 256,
+//the output is slew and range limited, the integrator only takes the new
+//error while the output is not held at a limit in the same direction
+static int32_t hv_pi(int32_t err,int32_t ff,uint16_t kp,uint16_t ki,long* integ,
+					int32_t out_prev,int32_t out_min,int32_t out_max,int32_t slew)
+{
+	long i_new,i_max;
+	int32_t u,out;
+
+	i_max = (long)out_max << 8;
+	i_new = *integ + (long)ki * err;
+	if ( i_new > i_max )
+		i_new = i_max;
+	else if ( i_new < -i_max )
+		i_new = -i_max;
+
+	u = ff + (((long)kp * err + i_new) >> 8);
+	out = u;
+	if ( out > out_prev + slew )
+		out = out_prev + slew;
+	else if ( out < out_prev - slew )
+		out = out_prev - slew;
+	if ( out > out_max )
+		out = out_max;
+	if ( out < out_min )
+		out = out_min;
+
+	if ( out == u || (u > out) != (err > 0) )
+		*integ = i_new;
+	return out;
+}
+
+//the output was forced from outside, make the integrator match it
+static void hv_pi_track(int32_t out,int32_t err,int32_t ff,uint16_t kp,long* integ)
+{
+	*integ = ((long)(out - ff) << 8) - (long)kp * err;
+}
+
 void hv_vol_update(HVS* hvs)
 {
 	hvs->st &= ~HV_PWR;
@@ -830,20 +952,25 @@ int32_t hv_vol_task(HVS* hvs)
 	int32_t to_status;
 	uint16_t temp;
 	uint16_t step;
+	int32_t err,ff,out_max;
+	ULONG dirty[MB_REG_WATCH_WORDS];
 	
+	//a host write is picked up on the next 10mS pass, not the next step
+	if ( eMBRegHolding_TakeDirtyMap(hvs->id == HVL ? &hvl_watch : &hvr_watch,dirty) )
+		hvs_update_from_modbus(hvs,dirty);
+	hv_cmd_apply(hvs);
+
 	if ( (hvs->st & HV_ENABLE) == 0)
 		return 0;
 
 	hv_update_vol(hvs);		//µѹ״̬Ĵ
 	if ( (to_status = get_timeout(hvs->vol_check_to)) == TO_TIMEOUT ) {//ʱ
 		start_timeout(hvs->vol_check_to, hvs->vol_step_interval);
-		//--------------------------------------------------------------------------
-		hvs_update_from_modbus(hvs);
-		//--------------------------------------------------------------------------
 		
 		step = hvs->vol_step;
 		//ѹΧ
 		if ( hvs->vol_set == 0 /*&& hvs->vol_fb < 1000 */) {
+			hvs->vol_integ = 0;
 			hvs->st &= ~(HV_SET_TO | HV_INCTRL);	//״̬־
 			hvs->st &= ~(HV_SET_OK | HV_PWR);
 			PWM_DAC_SetmV( hvs->vol_dac_ch, (hvs->vol_ctl=0) );
@@ -856,6 +983,19 @@ int32_t hv_vol_task(HVS* hvs)
 			DIO_Write(hvs->power_ch,DO_POWER_ON);
 			hvs->st |= HV_PWR;
 
+			if ( hvs->vol_kp || hvs->vol_ki ){
+				err = (int32_t)hvs->vol_set - hvs->vol_fb;
+				ff = (int32_t)hvs->vol_set * hvs->vol_kff / 1000;
+				//the same limits as the protection below, so the PI knows them
+				out_max = hvs->vol_set + 3000;
+				if ( hvs->vol_fb < 1000 && out_max > 3000 )
+					out_max = 3000;
+				if ( (hvs->vol_set - hvs->vol_fb > 500) && (hvs->cur_fb > 100) )	//ŵ
+					hv_pi_track(hvs->vol_ctl,err,ff,hvs->vol_kp,&hvs->vol_integ);
+				else
+					hvs->vol_ctl = hv_pi(err,ff,hvs->vol_kp,hvs->vol_ki,&hvs->vol_integ,
+								hvs->vol_ctl,0,out_max,hvs->vol_step*HV_SLEW_STEPS);
+			} else {
 			//if ( hvs->st & HV_SET_OK ){
 				//start_timeout(hvs->vol_check_to, hvs->vol_step_interval*10);
 			//} else 
@@ -879,6 +1019,7 @@ int32_t hv_vol_task(HVS* hvs)
 				}	else 
 					hvs->vol_ctl += step;
 			}
+			}	//if ( hvs->vol_kp
 			
 			if ( hvs->vol_ctl - hvs->vol_set > 3000 )	//
 				hvs->vol_ctl = hvs->vol_set+3000;
@@ -900,18 +1041,23 @@ int32_t hv_cur_task(HVS* hvs)
 	uint32_t temp;
 	int32_t to_status;
 	uint32_t err;
+	int32_t pi_err;
+	int32_t pi;
 
 	if ( (hvs->st & HV_ENABLE) == 0)
 		return 0;
 		
 	hv_update_cur(hvs);
+	//no current to regulate on below 150, the ladder brings it up first
+	pi = (hvs->cur_kp || hvs->cur_ki) && hvs->cur_fb != 0;
   	if ( (to_status = get_timeout(hvs->cur_check_to)) == TO_TIMEOUT ){
-		start_timeout(hvs->cur_check_to, hvs->cur_step_interval);
-
 		step = hvs->cur_step;
-		interval = hvs->cur_step_interval;		
+		interval = pi ? hvs->cur_pi_interval : hvs->cur_step_interval;		
+		start_timeout(hvs->cur_check_to, interval);
 
+		pi_err = (int32_t)hvs->cur_set - hvs->cur_fb;
 		if ( hvs->cur_set == 0 ) {
+			hvs->cur_integ = 0;
 			PWM_DAC_SetmV( hvs->cur_dac_ch, (hvs->cur_ctl=0) );
 			//hvs_update_to_modbus(hvs);
 			return 0;
@@ -920,6 +1066,7 @@ int32_t hv_cur_task(HVS* hvs)
 				hvs->cur_ctl -= hvs->cur_step*50;
 			} else 
 				hvs->cur_ctl = 0;
+			hv_pi_track(hvs->cur_ctl,pi_err,0,hvs->cur_kp,&hvs->cur_integ);
 			PWM_DAC_SetmV( hvs->cur_dac_ch, hvs->cur_ctl );
 			return 0;
 		}
@@ -929,6 +1076,14 @@ int32_t hv_cur_task(HVS* hvs)
 		} else {
 			hvs->st &= ~HV_CUR_SET_OK;
 
+			if ( pi ){
+				hvs->cur_ctl = hv_pi(pi_err,0,hvs->cur_kp,hvs->cur_ki,&hvs->cur_integ,
+								hvs->cur_ctl,0,CUR_DAC_FULL,hvs->cur_step*HV_SLEW_STEPS);
+				PWM_DAC_SetmV( hvs->cur_dac_ch, hvs->cur_ctl );
+				hvs_update_to_modbus(hvs);
+				return 0;
+			}
+
 			err = temp*100 / hvs->cur_set;//%
 			if ( hvs->cur_fb < 150 ) {
 				step 		= hvs->cur_step*50;
@@ -957,6 +1112,8 @@ int32_t hv_cur_task(HVS* hvs)
 			}
 			PWM_DAC_SetmV( hvs->cur_dac_ch, hvs->cur_ctl );
 		    start_timeout(hvs->cur_check_to, interval);
+			//the PI takes over from where the ladder left the output
+			hv_pi_track(hvs->cur_ctl,pi_err,0,hvs->cur_kp,&hvs->cur_integ);
 		}	//if ( abs ...
 		
 		hvs_update_to_modbus(hvs);
@@ -969,20 +1126,22 @@ int32_t hv_cur_task(HVS* hvs)
 
 void update_adc_modbus()
 {
-	uint16_t buf16[32];
+	uint16_t buf16[ADC_BLOCK_SAMPLES];
 	uint16_t i;
 	
 	for(i=0;i<8;i++){
-		ADC_Get(ADC_Channel_8+i,buf16,32);	
-		exchange_sort16(buf16,32);
-		vPortEnterCritical();
-		eMBRegInput_Write(MB_ADC0+i,get_average16(buf16+6,32-2*6));
-		vPortExitCritical();
+		if ( ADC_GetBlock(ADC_CH_INDEX(ADC_Channel_8+i),buf16) == 0 )
+			continue;
+		eMBRegInput_Write(MB_ADC0+i,trimmed_mean16(buf16,ADC_BLOCK_SAMPLES,3));
 	}
 }
 
 int32_t gl_696h_init()
 {
+	eMBRegHolding_Watch(&hvl_watch);
+	eMBRegHolding_Watch(&hvr_watch);
+	eMBRegHolding_Watch(&seq_watch);
+
 	//relay_init();
 	//led_init();
 	DIO_Init();
@@ -997,87 +1156,122 @@ int32_t gl_696h_init()
 }
 
 
+//-----------------------------------------------------------------------------------
+static void hvl_job(void)
+{
+	//timeouts count in mS of the kernel tick
+	system_tick = xTaskGetTickCount() * portTICK_RATE_MS;
+
+	hv_vol_task(&hvsl);
+	hv_cur_task(&hvsl);
+}
+
+static void hvr_job(void)
+{
+	hv_vol_task(&hvsr);
+	hv_cur_task(&hvsr);
+}
+
+//last job of the ctl lane each period, the register image is complete
+static void adc_job(void)
+{
+	update_adc_modbus();
+	httpd_api_sample();
+}
+
+static void telem_job(void)
+{
+	vmeter_task();
+	mpump_task();
+}
+
+static void seq_job(void)
+{
+	auto_ctl_task();
+}
+
+//runs in the writer's task, only releases the job
+static void seq_notify(void* arg)
+{
+	(void)arg;
+	sched_trigger(&sched_jobs[JOB_SEQ]);
+}
+
+static void stat_job(void)
+{
+	uint16_t reg[SCHED_STAT_JOBS*SCHED_STAT_REGS];
+	uint32_t i;
+
+	for ( i=0; i<SCHED_STAT_JOBS; i++ ){
+		reg[i*SCHED_STAT_REGS + SCHED_STAT_JITTER]	= sched_jobs[i].jitter_max;
+		reg[i*SCHED_STAT_REGS + SCHED_STAT_OVERRUN]	= sched_jobs[i].overruns;
+	}
+	eMBRegInput_WriteBlock(MB_SCHED_STAT,reg,SCHED_STAT_JOBS*SCHED_STAT_REGS);
+}
+
+//a host write of MB_MPUMP_CTL, the pump commands sleep on the line so the
+//Modbus hook only leaves it here for the mpump job. A newer write replaces
+//one that has not run yet, as it does in the register
+#define MPUMP_REQ_PENDING	(1UL<<16)
+static volatile uint32_t mpump_req = 0;
+
+void mpump_ctl_post(uint16_t cmd)
+{
+	mpump_req = MPUMP_REQ_PENDING | cmd;
+	sched_trigger(&sched_jobs[JOB_MPUMP]);
+}
+
+static void mpump_job(void)
+{
+	uint32_t req;
+
+	vPortEnterCritical();
+	req = mpump_req;
+	mpump_req = 0;
+	vPortExitCritical();
+
+	if ( req & MPUMP_REQ_PENDING )
+		mpump_ctl((uint16_t)req);
+	else
+		mpump_ctl_from_com(FD110A_STATUS);
+}
+
+static void motor_job(void)
+{
+	static uint32_t motor = MOTOR_FORWARD;
+
+	if ( motor & MOTOR_FORWARD ){
+		motor = MOTOR_BACKWARD;
+		DIO_Write(RELAY0,DO_RELAY_ON);
+		DIO_Write(RELAY1,DO_RELAY_ON);
+	} else {
+		motor = MOTOR_FORWARD;
+		DIO_Write(RELAY0,DO_RELAY_OFF);
+		DIO_Write(RELAY1,DO_RELAY_OFF);
+	}
+}
+
 void vGL696H_Task( void *pvParameters )
 {
-	uint32_t i=0,j,motor = 0;
-	uint32_t sec=0;
-	uint32_t ret;
-	portTickType xLastWakeTime;
+	unsigned portBASE_TYPE prio = uxTaskPriorityGet(NULL);
+	uint32_t i;
 
 	(void)pvParameters;
 
 	gl_696h_init(); 
-	xLastWakeTime = xTaskGetTickCount ();
-	motor = MOTOR_FORWARD;
-	
-	while(1){
-		system_tick += 10;
-		
-	//	led_task();
-	  
-		//---------------------------------------------------------------------------------
-	    hv_vol_task(&hvsl);
-	    hv_cur_task(&hvsl);
-	    
-	    hv_vol_task(&hvsr);
-	    hv_cur_task(&hvsr);
-
-	    vmeter_task();
-		update_adc_modbus();
-
-	    //---------------------------------------------------------------------------------
-	    if ( (ret = get_timeout(&sec_to)) == TO_TIMEOUT) {
-			start_timeout(&sec_to,1000);
-			sec ++;
-	 
-			//usart_printf(DBGU, " adc : ");
-	    	/*for(j=0;j<8;j++){
-		    	ADC_Get(8+j,buf,32);
-		    	//usart_printf(DBGU, " %4dmV ,",adc_get_mv(buf[0]));
-		    }
-		    //usart_printf(DBGU, "\r\n");
-	   		
-			i = 1000;
-			PWM_DAC_SetmV(0,i);i += 100;
-			PWM_DAC_SetmV(1,i);i += 100;
-			PWM_DAC_SetmV(2,i);i += 100;
-			PWM_DAC_SetmV(3,i);i += 100;   
-			PWM_DAC_SetmV(4,i);i += 100;
-			PWM_DAC_SetmV(5,i);i += 100;
-			PWM_DAC_SetmV(6,i);i += 100;
-			PWM_DAC_SetmV(7,i);i += 100;   
-	  	    */
-	      	//----------Զ---------------------------------------------------------------
-	    	auto_ctl_task();
-	      
-	      	mpump_task();
-	      	if ( (sec % 2) == 0 ) {
-				mpump_ctl_from_com(FD110A_STATUS);
-	    	} 
-			
-			if ( (sec % 60 ) == 0 ){
-				i = eMBRegInput_Read(MB_MOTOR_ST);
-				i =  motor;
-				/*if ( (i & MOTOR_ENABLE) )*/ {
-					if ( i & MOTOR_FORWARD ){
-						motor = MOTOR_BACKWARD;
-						DIO_Write(RELAY0,DO_RELAY_ON);
-						DIO_Write(RELAY1,DO_RELAY_ON);
-					} else {
-						motor = MOTOR_FORWARD;
-						DIO_Write(RELAY0,DO_RELAY_OFF);
-						DIO_Write(RELAY1,DO_RELAY_OFF);
-					}
-				}
-			}
-	    } else if ( ret != TO_RUNING ){
-			start_timeout(&sec_to,1000);
-		}
 
-		//-----------------------------------------------------------------------------------
-		vTaskDelayUntil( &xLastWakeTime, configTICK_RATE_HZ/100 );
-	}//	while(1){
+	sched_lane_init(&ctl_lane);
+	sched_lane_init(&io_lane);
+	sched_lane_init(&slow_lane);
+	for ( i=0; i<SCHED_STAT_JOBS; i++ )
+		sched_add(sched_job_lane[i],&sched_jobs[i]);
+	//the first motor flip comes after a full period
+	sched_jobs[JOB_MOTOR].release += sched_jobs[JOB_MOTOR].period / portTICK_RATE_MS;
+
+	xTaskCreate( sched_lane_task, ( signed portCHAR * ) "GL-IO", configMINIMAL_STACK_SIZE*3, &io_lane, prio-1, NULL );
+	xTaskCreate( sched_lane_task, ( signed portCHAR * ) "GL-SLOW", configMINIMAL_STACK_SIZE*2, &slow_lane, prio-2, NULL );
 
+	sched_run(&ctl_lane);
 }
 
 
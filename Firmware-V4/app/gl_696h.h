@@ -3,16 +3,7 @@
 
 #include "timerout.h"
 #include "stdint.h"
-
-typedef struct 
-{
-  unsigned short * queue;
-  unsigned char size;
-  unsigned char front;
-  unsigned char rear;
-} QUEUE,*pQUEUE;
-
-
+#include "filter.h"
 
 typedef struct 
 {
@@ -41,6 +32,15 @@ typedef struct
 	unsigned short cur_step_timeout;	//ʱ,mS
 	unsigned short cur_ctl_start;		//ʼֵ
   
+	unsigned short vol_kp;				//ѹPI,1/256KPKIΪ0ʱʹò
+	unsigned short vol_ki;				//ѹPI,1/256
+	unsigned short vol_kff;				//ѹ趨ֵǰ,1
+	unsigned short cur_kp;				//PI,1/256
+	unsigned short cur_ki;				//PI,1/256
+	unsigned short cur_pi_interval;		//PI,mS
+	long vol_integ;						//ѹPI,Q8
+	long cur_integ;						//PI,Q8
+  
 	unsigned short vol_set;			//ѹ趨ֵ,V
 	unsigned short vol_fb;			//ѹʵʲֵ,V
 	unsigned short vol_ctl;			//Ƶѹֵ,V
@@ -72,5 +72,13 @@ extern float vmeter;
 
 void vGL696H_Task( void *pvParameters );
 
+int32_t vmeter_ctl(int32_t cmd);
+int32_t powerpump_ctl(int32_t cmd);
+int32_t bleed_valve_ctl(int32_t cmd);
+int32_t baffle_ctl(int32_t cmd);
+int32_t sample_led_ctl( int32_t cmd );
+int32_t mpump_ctl( uint16_t cmd );
+void mpump_ctl_post(uint16_t cmd);
+
 
 #endif
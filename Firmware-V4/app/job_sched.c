@@ -0,0 +1,121 @@
+#include <string.h>
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+#include "job_sched.h"
+
+//tick differences below half the range count as "now or in the past"
+#define SCHED_DUE(now,t)	((portTickType)((now) - (t)) < (portMAX_DELAY >> 1))
+#define SCHED_TICKS(ms)		((portTickType)(ms) / portTICK_RATE_MS)
+
+//-------------------------------------------------------------------------
+int32_t sched_lane_init(SCHED_LANE* lane)
+{
+	memset(lane,0,sizeof(SCHED_LANE));
+	vSemaphoreCreateBinary(lane->wake);
+	if ( lane->wake == NULL )
+		return -1;
+	//the semaphore is created given, the first pass does not need it
+	xSemaphoreTake(lane->wake,0);
+	return 0;
+}
+
+int32_t sched_add(SCHED_LANE* lane,SCHED_JOB* job)
+{
+	if ( lane->count >= SCHED_MAX_JOBS )
+		return -1;
+
+	job->lane 		= lane;
+	job->release 	= xTaskGetTickCount();
+	job->pending 	= 0;
+	job->jitter_max = 0;
+	job->overruns 	= 0;
+	job->runs 		= 0;
+	lane->jobs[lane->count++] = job;
+	return 0;
+}
+
+//release an event job now, may be called from any task
+void sched_trigger(SCHED_JOB* job)
+{
+	if ( job->lane == NULL )
+		return;
+	if ( !job->pending ){
+		job->event = xTaskGetTickCount();
+		job->pending = 1;
+	}
+	xSemaphoreGive(job->lane->wake);
+}
+
+//-------------------------------------------------------------------------
+static void sched_exec(SCHED_JOB* job,portTickType release)
+{
+	portTickType t;
+
+	t = (xTaskGetTickCount() - release) * portTICK_RATE_MS;
+	if ( t > job->jitter_max )
+		job->jitter_max = t > 0xFFFF ? 0xFFFF : t;
+
+	job->func();
+	job->runs++;
+
+	t = (xTaskGetTickCount() - release) * portTICK_RATE_MS;
+	if ( t > job->deadline )
+		job->overruns++;
+}
+
+void sched_run(SCHED_LANE* lane)
+{
+	SCHED_JOB* job;
+	portTickType now,wait,period,lost;
+	uint8_t i;
+
+	for(;;){
+		wait = portMAX_DELAY;
+
+		for ( i=0; i<lane->count; i++ ){
+			job = lane->jobs[i];
+
+			if ( job->pending ){
+				job->pending = 0;
+				sched_exec(job,job->event);
+			}
+
+			if ( !(job->trigger & SCHED_PERIODIC) )
+				continue;
+
+			now = xTaskGetTickCount();
+			period = SCHED_TICKS(job->period);
+			if ( SCHED_DUE(now,job->release) ){
+				sched_exec(job,job->release);
+				job->release += period;
+
+				//whole periods already gone are skipped, not run back to back
+				now = xTaskGetTickCount();
+				if ( SCHED_DUE(now,job->release) && (now - job->release) >= period ){
+					lost = (now - job->release) / period;
+					job->overruns += lost;
+					job->release += lost * period;
+				}
+			}
+
+			now = xTaskGetTickCount();
+			if ( SCHED_DUE(now,job->release) )
+				wait = 0;
+			else if ( job->release - now < wait )
+				wait = job->release - now;
+		}
+
+		if ( wait )
+			xSemaphoreTake(lane->wake,wait);
+	}
+}
+
+//task entry of a lane, pvParameters is the SCHED_LANE
+void sched_lane_task(void* pvParameters)
+{
+	sched_run((SCHED_LANE*)pvParameters);
+}
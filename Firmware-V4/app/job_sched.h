@@ -0,0 +1,53 @@
+#ifndef __JOB_SCHED_H__
+#define __JOB_SCHED_H__
+
+#include "stdint.h"
+
+#include "FreeRTOS.h"
+#include "semphr.h"
+
+//-------------------------------------------------------------------------
+//periodic/event job scheduler, a lane is one FreeRTOS task that runs its
+//jobs in table order, jobs that may block go to a lane of their own
+
+#define SCHED_MAX_JOBS		8		//per lane
+
+//trigger source
+#define SCHED_PERIODIC		(1<<0)	//released every period
+#define SCHED_EVENT			(1<<1)	//released by sched_trigger()
+
+struct SCHED_LANE_S;
+
+typedef struct
+{
+	const char* name;
+	void (*func)(void);
+	uint16_t period;		//mS, unused for event only jobs
+	uint16_t deadline;		//mS after release
+	uint8_t trigger;
+
+	//kept by the lane
+	struct SCHED_LANE_S* lane;
+	portTickType release;	//next periodic release
+	portTickType event;		//tick of the pending event
+	volatile uint8_t pending;
+	uint16_t jitter_max;	//mS, worst start delay after release
+	uint16_t overruns;		//finished after the deadline or lost a period
+	uint32_t runs;
+} SCHED_JOB,*pSCHED_JOB;
+
+typedef struct SCHED_LANE_S
+{
+	SCHED_JOB* jobs[SCHED_MAX_JOBS];
+	uint8_t count;
+	xSemaphoreHandle wake;
+} SCHED_LANE,*pSCHED_LANE;
+
+//-------------------------------------------------------------------------
+int32_t sched_lane_init(SCHED_LANE* lane);
+int32_t sched_add(SCHED_LANE* lane,SCHED_JOB* job);
+void sched_trigger(SCHED_JOB* job);
+void sched_run(SCHED_LANE* lane);
+void sched_lane_task(void* pvParameters);
+
+#endif
@@ -65,6 +65,34 @@
 #define LCD_RD_PIN		GPIO_Pin_10
 #define LCD_WR_PIN		GPIO_Pin_11
 
+/* The bus is driven through BSRR, the low half sets pins and the high half
+   resets them, so the other pins on GPIOD and GPIOE are never read back and
+   rewritten. */
+#define LCD_DATA_BSRR(b)	( ((uint32_t)(uint8_t)(b) << 8) | ((uint32_t)(uint8_t)~(b) << 24) )
+#define LCD_ADDR_BSRR(r)	( LCD_RD_PIN | (r) | ((uint32_t)((r) ^ (LCD_A0_PIN | LCD_A1_PIN)) << 16) )
+
+/* Every store to the bus pins goes through here.  The host tests build this
+   file with one that hands the stores to their panel model. */
+#ifndef LCD_BUS_STORE
+#define LCD_BUS_STORE(reg, v)	((reg) = (v))
+#endif
+
+/* A register write while CS is low already. */
+#define LCD_BUS_REG(r, v)	do {								\
+			LCD_BUS_STORE(GPIOE->BSRR, LCD_DATA_BSRR(v));	\
+			LCD_BUS_STORE(GPIOD->BSRR, LCD_ADDR_BSRR(r));	\
+			LCD_BUS_STORE(GPIOD->BRR, LCD_WR_PIN);			\
+			LCD_BUS_STORE(GPIOD->BSRR, LCD_WR_PIN);			\
+		} while(0)
+
+/* Page register: the pages from LCD_SET_PAGE() and the high address bits. */
+#define LCD_PAGE_REG(x, y)	( (LCD_page&0x18) | (((y)>>6)&0x04) | (((x)>>8)&0x03) )
+
+/* Pixels written per critical section by the burst functions.  Between
+   chunks interrupts are open and a task that became ready preempts the
+   drawing one, 32 pixels keep this to a few microseconds. */
+#define LCD_BURST_CHUNK	32
+
 //#define LCD_SET_PAGE(x)		LCD_page = x
 
 /*#define LCD_WriteRAM(RGB_Code) \
@@ -134,13 +162,12 @@ void LCD_CtrlLinesConfig(void)
 *******************************************************************************/
 void LCD_WriteReg(uint16_t LCD_Reg,uint8_t LCD_RegValue)
 { 
-	vu8 i;
-	
 	vPortEnterCritical();
-	GPIOE->ODR = (GPIOE->ODR&0x007F) | ((uint16_t)LCD_RegValue<<8); //for(i=0;i<5;i++);
-	GPIOD->ODR = (GPIOD->ODR&0xF0FF) | LCD_RD_PIN | LCD_Reg;	//for(i=0;i<5;i++);
-	GPIOD->ODR |= LCD_WR_PIN;	//for(i=0;i<5;i++);
-	GPIOE->ODR |= LCD_CS_PIN;
+	LCD_BUS_STORE(GPIOE->BSRR, LCD_DATA_BSRR(LCD_RegValue) | ((uint32_t)LCD_CS_PIN << 16));
+	LCD_BUS_STORE(GPIOD->BSRR, LCD_ADDR_BSRR(LCD_Reg));
+	LCD_BUS_STORE(GPIOD->BRR, LCD_WR_PIN);
+	LCD_BUS_STORE(GPIOD->BSRR, LCD_WR_PIN);
+	LCD_BUS_STORE(GPIOE->BSRR, LCD_CS_PIN);
 	vPortExitCritical();
 }
 
@@ -164,10 +191,89 @@ uint8_t LCD_ReadReg(uint8_t LCD_Reg)
 
 uint16_t  LCD_WriteRAM(uint16_t RGB_Code)
 {
-	LCD_WriteReg(LCD_ADDR_DAT,RGB_Code>>8);	
-	LCD_WriteReg(LCD_ADDR_DAT,RGB_Code);
+	LCD_WriteRAMBurst(&RGB_Code, 1);
 	return 0;	
 }
+
+/*******************************************************************************
+* Function Name  : LCD_WriteRAMBurst
+* Description    : Writes consecutive pixels to the LCD RAM at the cursor.
+*                  The bus is selected once per LCD_BURST_CHUNK pixels, then
+*                  each byte is a data write and a WR strobe.
+* Input          : - RGB_Code: the pixel colors RGB(5-6-5).
+*                  - Count: number of pixels.
+* Output         : None
+* Return         : None
+*******************************************************************************/
+void LCD_WriteRAMBurst(const uint16_t *RGB_Code, uint32_t Count)
+{
+	uint32_t n;
+
+	while ( Count > 0 ){
+		n = Count < LCD_BURST_CHUNK ? Count : LCD_BURST_CHUNK;
+		Count -= n;
+
+		vPortEnterCritical();
+		LCD_BUS_STORE(GPIOD->BSRR, LCD_ADDR_BSRR(LCD_ADDR_DAT));
+		LCD_BUS_STORE(GPIOE->BRR, LCD_CS_PIN);
+		do {
+			LCD_BUS_STORE(GPIOE->BSRR, LCD_DATA_BSRR(*RGB_Code >> 8));
+			LCD_BUS_STORE(GPIOD->BRR, LCD_WR_PIN);
+			LCD_BUS_STORE(GPIOD->BSRR, LCD_WR_PIN);
+			LCD_BUS_STORE(GPIOE->BSRR, LCD_DATA_BSRR(*RGB_Code));
+			LCD_BUS_STORE(GPIOD->BRR, LCD_WR_PIN);
+			LCD_BUS_STORE(GPIOD->BSRR, LCD_WR_PIN);
+			RGB_Code++;
+		} while ( --n );
+		LCD_BUS_STORE(GPIOE->BSRR, LCD_CS_PIN);
+		vPortExitCritical();
+	}
+}
+
+/*******************************************************************************
+* Function Name  : LCD_FillRun
+* Description    : Writes Count pixels of one color to the LCD RAM at the
+*                  cursor.  Both data bytes are set up once, when they are
+*                  equal the data lines do not change at all.
+* Input          : - RGB_Code: the color RGB(5-6-5).
+*                  - Count: number of pixels.
+* Output         : None
+* Return         : None
+*******************************************************************************/
+void LCD_FillRun(uint16_t RGB_Code, uint32_t Count)
+{
+	uint32_t n;
+	const uint32_t hi = LCD_DATA_BSRR(RGB_Code >> 8);
+	const uint32_t lo = LCD_DATA_BSRR(RGB_Code);
+
+	while ( Count > 0 ){
+		n = Count < LCD_BURST_CHUNK ? Count : LCD_BURST_CHUNK;
+		Count -= n;
+
+		vPortEnterCritical();
+		LCD_BUS_STORE(GPIOD->BSRR, LCD_ADDR_BSRR(LCD_ADDR_DAT));
+		LCD_BUS_STORE(GPIOE->BRR, LCD_CS_PIN);
+		if ( hi == lo ){
+			LCD_BUS_STORE(GPIOE->BSRR, lo);
+			n <<= 1;
+			do {
+				LCD_BUS_STORE(GPIOD->BRR, LCD_WR_PIN);
+				LCD_BUS_STORE(GPIOD->BSRR, LCD_WR_PIN);
+			} while ( --n );
+		} else {
+			do {
+				LCD_BUS_STORE(GPIOE->BSRR, hi);
+				LCD_BUS_STORE(GPIOD->BRR, LCD_WR_PIN);
+				LCD_BUS_STORE(GPIOD->BSRR, LCD_WR_PIN);
+				LCD_BUS_STORE(GPIOE->BSRR, lo);
+				LCD_BUS_STORE(GPIOD->BRR, LCD_WR_PIN);
+				LCD_BUS_STORE(GPIOD->BSRR, LCD_WR_PIN);
+			} while ( --n );
+		}
+		LCD_BUS_STORE(GPIOE->BSRR, LCD_CS_PIN);
+		vPortExitCritical();
+	}
+}
 /*******************************************************************************
 * Function Name  : LCD_ReadRAM
 * Description    : Reads the LCD RAM.
@@ -191,6 +297,53 @@ void LCD_SET_PAGE(uint8_t page)
 	LCD_SetCursor(LCD_CursorX, LCD_CursorY);
 }
 
+/*******************************************************************************
+* Function Name  : LCD_DrawHidden
+* Description    : Directs the drawing to the page that is not shown.
+* Input          : None
+* Output         : None
+* Return         : None
+*******************************************************************************/
+void LCD_DrawHidden(void)
+{
+	if ( LCD_page & LCD_DISPLAY_PAGE1 )
+		LCD_SET_PAGE(LCD_WRITE_PAGE0 | LCD_DISPLAY_PAGE1);
+	else
+		LCD_SET_PAGE(LCD_WRITE_PAGE1 | LCD_DISPLAY_PAGE0);
+}
+
+/*******************************************************************************
+* Function Name  : LCD_Flip
+* Description    : Shows the page being drawn and directs the drawing to the
+*                  one that was shown.  The page register is written once,
+*                  the panel switches between two whole frames.
+* Input          : None
+* Output         : None
+* Return         : None
+*******************************************************************************/
+void LCD_Flip(void)
+{
+	if ( LCD_page & LCD_WRITE_PAGE1 )
+		LCD_SET_PAGE(LCD_WRITE_PAGE0 | LCD_DISPLAY_PAGE1);
+	else
+		LCD_SET_PAGE(LCD_WRITE_PAGE1 | LCD_DISPLAY_PAGE0);
+}
+
+/*******************************************************************************
+* Function Name  : LCD_DrawShown
+* Description    : Directs the drawing to the page that is shown.
+* Input          : None
+* Output         : None
+* Return         : None
+*******************************************************************************/
+void LCD_DrawShown(void)
+{
+	if ( LCD_page & LCD_DISPLAY_PAGE1 )
+		LCD_SET_PAGE(LCD_WRITE_PAGE1 | LCD_DISPLAY_PAGE1);
+	else
+		LCD_SET_PAGE(LCD_WRITE_PAGE0 | LCD_DISPLAY_PAGE0);
+}
+
 /*******************************************************************************
 * Function Name  : LCD_PowerOn
 * Description    :
@@ -384,14 +537,12 @@ void LCD_ClearLine(uint8_t Line)
 *******************************************************************************/
 void LCD_Clear(void)
 {
-  	uint32_t i,j;
+  	uint32_t i;
 
-	for(i = 0; i < 480; i++)
+	for(i = 0; i < LCD_SCR_HIGH; i++)
 	{
 		LCD_SetCursor(0, i);
-		for(j=0;j<640;j++){
-			LCD_WriteRAM(LCD_BackColor);
-		}
+		LCD_FillRun(LCD_BackColor, LCD_SCR_WIDTH);
 	}
 	LCD_SetCursor(0,0);
 }
@@ -415,7 +566,7 @@ void LCD_SetCursor(uint16_t Xpos, uint16_t Ypos)
 		LCD_CursorY = LCD_CursorY - 1;
 
   	//диߵַ
-	LCD_WriteReg(LCD_ADDR_PAGE,(LCD_page&0x18) | ((LCD_CursorY>>6)&0x04) | ((LCD_CursorX>>8)&0X03));
+	LCD_WriteReg(LCD_ADDR_PAGE,LCD_PAGE_REG(LCD_CursorX, LCD_CursorY));
 	//де͵ַ
 	LCD_WriteReg(LCD_ADDR_ROW,LCD_CursorY);
 	//де͵ַ
@@ -450,34 +601,128 @@ void LCD_SetPixel(uint16_t x,uint16_t y,uint16_t color)
 }
 
 
+/*******************************************************************************
+* Function Name  : LCD_WriteRuns
+* Description    : Moves the LCD cursor to a row and writes runs of background
+*                  and text color there, all in one critical section.
+* Input          : - Xpos, Ypos: where the row starts.
+*                  - runs: run lengths, background first, LCD_BURST_CHUNK
+*                    pixels at most.
+*                  - n: number of runs.
+*                  - color: the background and text color bytes as BSRR words.
+* Output         : None
+* Return         : None
+*******************************************************************************/
+static void LCD_WriteRuns(uint16_t Xpos, uint16_t Ypos, const uint8_t *runs, uint8_t n, const uint32_t (*color)[2])
+{
+	uint8_t i, k;
+	uint32_t hi, lo;
+
+	vPortEnterCritical();
+	LCD_BUS_STORE(GPIOE->BRR, LCD_CS_PIN);
+	LCD_BUS_REG(LCD_ADDR_PAGE, LCD_PAGE_REG(Xpos, Ypos));
+	LCD_BUS_REG(LCD_ADDR_ROW, Ypos);
+	LCD_BUS_REG(LCD_ADDR_COL, Xpos);
+	LCD_BUS_STORE(GPIOD->BSRR, LCD_ADDR_BSRR(LCD_ADDR_DAT));
+	for(i = 0; i < n; i++){
+		if ( (k = runs[i]) == 0 )
+			continue;
+		hi = color[i & 1][0];
+		lo = color[i & 1][1];
+		if ( hi == lo ){
+			LCD_BUS_STORE(GPIOE->BSRR, lo);
+			k <<= 1;
+			do {
+				LCD_BUS_STORE(GPIOD->BRR, LCD_WR_PIN);
+				LCD_BUS_STORE(GPIOD->BSRR, LCD_WR_PIN);
+			} while ( --k );
+		} else {
+			do {
+				LCD_BUS_STORE(GPIOE->BSRR, hi);
+				LCD_BUS_STORE(GPIOD->BRR, LCD_WR_PIN);
+				LCD_BUS_STORE(GPIOD->BSRR, LCD_WR_PIN);
+				LCD_BUS_STORE(GPIOE->BSRR, lo);
+				LCD_BUS_STORE(GPIOD->BRR, LCD_WR_PIN);
+				LCD_BUS_STORE(GPIOD->BSRR, LCD_WR_PIN);
+			} while ( --k );
+		}
+	}
+	LCD_BUS_STORE(GPIOE->BSRR, LCD_CS_PIN);
+	vPortExitCritical();
+}
+
+/* The next 4 bit code of a glyph. */
+static uint8_t LCD_RleCode(const uint8_t **rle, uint8_t *half)
+{
+	uint8_t code;
+
+	if ( *half )
+		code = *(*rle)++ & 0x0F;
+	else
+		code = **rle >> 4;
+	*half ^= 1;
+	return code;
+}
+
+/* A run, a code of 15 goes on with the next one. */
+static uint8_t LCD_RleRun(const uint8_t **rle, uint8_t *half)
+{
+	uint8_t run = 0, code;
+
+	do {
+		code = LCD_RleCode(rle, half);
+		run += code;
+	} while ( code == 15 );
+	return run;
+}
+
 /*******************************************************************************
 * Function Name  : LCD_DrawChar
-* Description    : Draws a character on LCD.
-* Input          : - Xpos: the Line where to display the character shape.
-*                    This parameter can be one of the following values:
-*                       - Linex: where x can be 0..9
-*                  - Ypos: start column address.
-*                  - c: pointer to the character data.
+* Description    : Draws a character at the cursor, the first row one line
+*                  below it, and moves the cursor right by its width.  The
+*                  glyph is in the run length format makefont describes, its
+*                  runs go to the bus as they are.
+* Input          : - rle: the glyph.
+*                  - width: glyph width, LCD_BURST_CHUNK at most.
+*                  - height: glyph height.
 * Output         : None
 * Return         : None
 *******************************************************************************/
-void LCD_DrawChar(const char* mask, uint16_t width, uint16_t height)
+void LCD_DrawChar(const uint8_t* rle, uint16_t width, uint16_t height)
 {
-	uint32_t lindex = 0, pindex = 0;
-	uint32_t Yaddress = LCD_CursorY;
+	uint8_t runs[LCD_BURST_CHUNK+1];
+	uint8_t n = 0, half = 0, repeat = 0, first, second;
+	uint16_t Xaddress = LCD_CursorX, Yaddress = LCD_CursorY, y = LCD_CursorY, row, sum;
+	uint32_t color[2][2];
 
-	for(lindex = 0; lindex < height; lindex++)
+	color[0][0] = LCD_DATA_BSRR(LCD_BackColor >> 8);
+	color[0][1] = LCD_DATA_BSRR(LCD_BackColor);
+	color[1][0] = LCD_DATA_BSRR(LCD_TextColor >> 8);
+	color[1][1] = LCD_DATA_BSRR(LCD_TextColor);
+
+	for(row = 0; row < height; row++)
 	{
-		LCD_SetCursor(LCD_CursorX, LCD_CursorY+1);
-		for(pindex = 0; pindex < width; pindex++)
-		{
-			if( mask[lindex*((width+7)>>3) + (pindex>>3)] & (0x80 >> (pindex % 8)) )
-				LCD_WriteRAM(LCD_TextColor);
-			else 
-				LCD_WriteRAM(LCD_BackColor);
+		if ( repeat ){
+			repeat--;
+		} else {
+			first = LCD_RleRun(&rle, &half);
+			second = first < width ? LCD_RleRun(&rle, &half) : 0;
+			if ( first == 0 && second == 0 ){
+				/* the previous row again */
+				repeat = LCD_RleCode(&rle, &half);
+			} else {
+				runs[0] = first;
+				runs[1] = second;
+				n = first < width ? 2 : 1;
+				for(sum = first + second; sum < width; sum += runs[n++])
+					runs[n] = LCD_RleRun(&rle, &half);
+			}
 		}
+		if ( ++y >= LCD_SCR_HIGH )
+			y = LCD_SCR_HIGH - 1;
+		LCD_WriteRuns(Xaddress, y, runs, n, color);
 	}
-	LCD_SetCursor(LCD_CursorX+width, Yaddress);
+	LCD_SetCursor(Xaddress+width, Yaddress);
 }
 
 /*******************************************************************************
@@ -496,71 +741,43 @@ void LCD_DisplayAscii(int8_t Ascii)
 	sFONT* sfont = LCD_Currentfonts_EN;
 	
 	Ascii -= ' ';
-	LCD_DrawChar((const char*)&sfont->table[Ascii * ((sfont->Width+7)>>3)*sfont->Height],sfont->Width,sfont->Height);
+	LCD_DrawChar(&sfont->table[sfont->offset[Ascii]],sfont->Width,sfont->Height);
 }
 
 /*******************************************************************************
-* Function Name  : LCD_DrawChar
-* Description    : Draws a character on LCD.
-* Input          : - Xpos: the Line where to display the character shape.
-*                    This parameter can be one of the following values:
-*                       - Linex: where x can be 0..9
-*                  - Ypos: start column address.
-*                  - c: pointer to the character data.
+* Function Name  : LCD_GetHz
+* Description    : Finds the glyph of a GB2312 character, binary search in the
+*                  sorted index makefont builds.
+* Input          : - ch: the two bytes of the character.
+*                  - font: CH font.
 * Output         : None
-* Return         : None
+* Return         : The glyph number, 0 is blank and drawn for characters the
+*                  font does not have.
 *******************************************************************************/
-const char* LCD_GetHz(const char* ch, sFONT* font) 
+uint16_t LCD_GetHz(const char* ch, sFONT* font) 
 {
-	uint16_t i;
-	const char* hz = (const char*)font->table;
+	uint16_t code = ((uint16_t)(uint8_t)ch[0] << 8) | (uint8_t)ch[1];
+	uint16_t low = 0, high = font->count, mid;
 	
-	for(i=0;hz[0] != 0;i++){
-		hz = (const char*)font->table+(((font->Width+7)>>3)*font->Height + 2)*i;
-		if ( memcmp(ch, hz, 2) == 0 )
-			break;
-	}
-	return hz;
-}
-
-/*******************************************************************************
-* Function Name  : LCD_DrawChar
-* Description    : Draws a character on LCD.
-* Input          : - Xpos: the Line where to display the character shape.
-*                    This parameter can be one of the following values:
-*                       - Linex: where x can be 0..9
-*                  - Ypos: start column address.
-*                  - c: pointer to the character data.
-* Output         : None
-* Return         : None
-*******************************************************************************/
-/*const char* LCD_GetHz_2(u8* ch) 
-{
-	short bReturnResult;
-	u16 low=1,high=(sizeof(chinese_tab)/sizeof(Chinese_GB16) - 1),mid; //õǰϡ½ĳֵ
-	
-	while( low <= high ){ //ǰR[low..high]ǿ
+	while ( low < high ){
 		mid = ( low + high ) / 2;
-		
-		bReturnResult = memcmp(ch, chinese_tab[mid].index, 2); 
-		
-		if( bReturnResult == 0 ) 
-			return (const char*)chinese_tab[mid].mask; //ҳɹ
-		if( bReturnResult < 0 )
-			high = mid - 1; //R[low..mid-1]в
+		if ( font->index[mid].Code == code )
+			return font->index[mid].Glyph;
+		if ( font->index[mid].Code < code )
+			low = mid + 1;
 		else
-			low = mid + 1; //R[mid+1..high]в
+			high = mid;
 	}
-	return (const char*)chinese_tab[0].mask; //low>highʱʾΪգʧ
-}*/
+	return 0;
+}
 
 
 void LCD_DisplayHz( const char* hz)
 {
 	sFONT* sfont = LCD_Currentfonts_CH;
-	const char* mask = LCD_GetHz(hz,sfont);
+	uint16_t glyph = LCD_GetHz(hz,sfont);
 	
-	LCD_DrawChar(mask+2,sfont->Width,sfont->Height);
+	LCD_DrawChar(&sfont->table[sfont->offset[glyph]],sfont->Width,sfont->Height);
 }
 
 
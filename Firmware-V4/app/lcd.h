@@ -86,6 +86,9 @@ uint16_t LCD_GetBackColor( void );
 void LCD_ClearLine(uint8_t Line);
 void LCD_Clear(void);
 void LCD_SET_PAGE(uint8_t page);
+void LCD_DrawHidden(void);
+void LCD_Flip(void);
+void LCD_DrawShown(void);
 
 void LCD_SetFont_EN(sFONT *fonts);
 sFONT *LCD_GetFont_EN(void);
@@ -115,6 +118,8 @@ void LCD_DisplayOff(void);
 void LCD_CtrlLinesConfig(void);
 void LCD_CtrlLinesWrite(GPIO_TypeDef* GPIOx, uint16_t CtrlPins, BitAction BitVal);
 void LCD_SPIConfig(void);
+void LCD_WriteRAMBurst(const uint16_t *RGB_Code, uint32_t Count);
+void LCD_FillRun(uint16_t RGB_Code, uint32_t Count);
 
 #endif /* __LCD_H */
 
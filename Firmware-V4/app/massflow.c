@@ -9,11 +9,13 @@
 
 #include "gl_696h.h"
 #include "adc.h"
+#include "filter.h"
 #include "gpio.h"
 #include "pwm_dac.h"
 #include "serials.h"
 #include "mb_reg_map.h"
 #include "modbus.h"
+#include "mb_master.h"
 
 //----------------------------------------------------------------
 #define ON	1
@@ -49,87 +51,25 @@ int32_t hv_pwr_ctl(uint32_t ch,int32_t cmd)
 static xComPortHandle Temp_Port = NULL;
 #define MB_TEMP_CTL_ADDR	0x11
 
+//temperature controller on COM2, process values in, set points out, it
+//takes the set point write in its own 0x10 frame
+static MBM_MASTER temp_master;
+static MBM_REQ temp_polls[] =
+{
+	{ MB_TEMP_CTL_ADDR, MBM_READ_HOLDING,   0x0000, 4, MB_TEMP00,     200, 100, 2, 0 },
+	{ MB_TEMP_CTL_ADDR, MBM_WRITE_MULTIPLE, 0x0038, 4, MB_TEMP_SET00, 200, 100, 2, MBM_OPT_LEGACY_10 },
+};
+
 void temp_init(void)
 {  
-	Temp_Port = xSerialPortInit( serCOM2, ser19200, serNO_PARITY, serBITS_8, serSTOP_1, 256 );
-}
-
-
-void temp_read_write_reg(void)
-{
-	uint8_t buf[32];
-	uint16_t usCRC16;
-	uint16_t len;
-	static uint32_t read = 0;
-
-	vPortEnterCritical();
-	if ( read  ){
-		read = 0;
-		len = 0;
-		buf [len++] = MB_TEMP_CTL_ADDR;
-		buf [len++] = 0x03;
-		buf [len++] = 0x00;
-		buf [len++] = 0x00;
-		buf [len++] = 0x00;
-		buf [len++] = 0x04;
-	} else {
-		read = 1;
-		len = 0;
-		buf [len++] = MB_TEMP_CTL_ADDR;
-		buf [len++] = 0x10;
-		buf [len++] = 0x00;
-		buf [len++] = 0x38;
-		buf [len++] = 0x00;
-		buf [len++] = 0x04;
-		buf [len++] = usRegHoldingBuf[MB_TEMP_SET00];
-		buf [len++] = usRegHoldingBuf[MB_TEMP_SET00]>>8;
-		buf [len++] = usRegHoldingBuf[MB_TEMP_SET01];
-		buf [len++] = usRegHoldingBuf[MB_TEMP_SET01]>>8;
-		buf [len++] = usRegHoldingBuf[MB_TEMP_SET10];
-		buf [len++] = usRegHoldingBuf[MB_TEMP_SET10]>>8;
-		buf [len++] = usRegHoldingBuf[MB_TEMP_SET11];
-		buf [len++] = usRegHoldingBuf[MB_TEMP_SET11]>>8;
-	}		
-	vPortExitCritical();
-    /* Calculate CRC16 checksum for Modbus-Serial-Line-PDU. */
-    usCRC16 = usMBCRC16( ( UCHAR * ) buf, len );
-    buf [len++] = ( usCRC16 & 0xFF );
-    buf [len++] = ( usCRC16 >> 8 );
-	vSerialPut( Temp_Port, buf, len);
-	vTaskDelay( configTICK_RATE_HZ/10 );
-}
+	uint32_t i;
 
-int32_t temp_task()
-{
-	static uint8_t buf[64];
-	static int32_t rx_len=0;
-	static uint32_t time = 0;
-	int32_t i;
-
-	if ( xSerialIsArrive(Temp_Port) == pdTRUE ) {
-			
-		if ( rx_len + 7 > sizeof(buf) )
-			rx_len = 0;
-			
-		i = xSerialGet(Temp_Port,buf+rx_len,sizeof(buf)-rx_len,configTICK_RATE_HZ/10);
-		rx_len += i;
-		
-		for ( i=0; rx_len-i>=7; i++ ){
-			if ( buf[i] == MB_TEMP_CTL_ADDR && buf[i+1] == 0x03 && buf[i+2] >= 8 ){
-				rx_len = 0;
-				vPortEnterCritical();
-				usRegInputBuf[MB_TEMP00] = ((buf[i+3] << 8) | buf[i+4]);
-				usRegInputBuf[MB_TEMP01] = ((buf[i+5] << 8) | buf[i+6]);
-				usRegInputBuf[MB_TEMP10] = ((buf[i+7] << 8) | buf[i+8]);
-				usRegInputBuf[MB_TEMP11] = ((buf[i+9] << 8) | buf[i+10]);
-				vPortExitCritical();
-				break;
-			}
-		}	
-	} else if ( (time++ % 5) == 0 ){
-		temp_read_write_reg();
-	}
-	return 0;	
+	Temp_Port = xSerialPortInit( serCOM2, ser19200, serNO_PARITY, serBITS_8, serSTOP_1, 256 );
+	if ( mbm_init(&temp_master,Temp_Port,19200) != 0 )
+		return;
+	for ( i=0; i<sizeof(temp_polls)/sizeof(temp_polls[0]); i++ )
+		mbm_add_poll(&temp_master,&temp_polls[i]);
+	xTaskCreate( mbm_task, ( signed portCHAR * ) "TEMP-MB", configMINIMAL_STACK_SIZE*2, &temp_master, uxTaskPriorityGet(NULL), NULL );
 }
 
 //-----------------------------------------------------------------------------------
@@ -164,15 +104,13 @@ uint16_t adc_scale[8] =
 
 void update_adc_modbus()
 {
-	uint16_t buf16[32];
+	uint16_t buf16[ADC_BLOCK_SAMPLES];
 	uint16_t i;
 	
 	for(i=0;i<8;i++){
-		ADC_Get(ADC_Channel_8+i,buf16,32);	
-		exchange_sort16(buf16,32);
-		vPortEnterCritical();
-		usRegInputBuf[MB_ADC0+i] = get_average16(buf16+6,32-2*6)*1000/adc_scale[i];
-		vPortExitCritical();
+		if ( ADC_GetBlock(ADC_CH_INDEX(ADC_Channel_8+i),buf16) == 0 )
+			continue;
+		eMBRegInput_Write(MB_ADC0+i,trimmed_mean16(buf16,ADC_BLOCK_SAMPLES,3)*1000/adc_scale[i]);
 	}
 }
 
@@ -196,7 +134,6 @@ void vMassFlow_Task( void *pvParameters )
 		
 		//---------------------------------------------------------------------------------
 		update_adc_modbus();
-      	temp_task();
 
 		//-----------------------------------------------------------------------------------
 		vTaskDelayUntil( &xLastWakeTime, configTICK_RATE_HZ/100 );
@@ -0,0 +1,296 @@
+#include <string.h>
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+#include "serials.h"
+#include "modbus.h"
+#include "mbcrc.h"
+#include "mb_master.h"
+
+//tick differences below half the range count as "now or in the past"
+#define MBM_DUE(now,t)		((portTickType)((now) - (t)) < (portMAX_DELAY >> 1))
+#define MBM_TICKS(ms)		((portTickType)(ms) / portTICK_RATE_MS)
+#define MBM_US_TICKS(us)	((portTickType)(((us) * configTICK_RATE_HZ + 999999UL) / 1000000UL))
+
+//-------------------------------------------------------------------------
+static int32_t mbm_valid(MBM_REQ* req)
+{
+	if ( req->count == 0 || req->count > MBM_MAX_REGS )
+		return 0;
+	//nobody answers a broadcast, a read would come back with nothing in it
+	if ( req->slave == 0 && (req->func == MBM_READ_HOLDING || req->func == MBM_READ_INPUT) )
+		return 0;
+	return 1;
+}
+
+int32_t mbm_init(MBM_MASTER* m,xComPortHandle port,uint32_t baud)
+{
+	uint32_t char_us;
+
+	memset(m,0,sizeof(MBM_MASTER));
+	m->queue = xQueueCreate(MBM_QUEUE_LEN,sizeof(MBM_REQ*));
+	if ( port == NULL || m->queue == NULL )
+		return -1;
+	m->port = port;
+
+	//start, 8 data, parity or stop, stop
+	char_us = 11000000UL / baud;
+	m->char_time = MBM_US_TICKS(char_us);
+	//fixed 1750uS above 19200 as the spec asks, one extra tick covers a
+	//delay that starts just before a tick edge
+	m->t35 = MBM_US_TICKS(baud > 19200 ? 1750 : char_us*7/2) + 1;
+	m->idle = xTaskGetTickCount();
+	return 0;
+}
+
+int32_t mbm_add_poll(MBM_MASTER* m,MBM_REQ* req)
+{
+	if ( m->poll_count >= MBM_MAX_POLLS || !mbm_valid(req) )
+		return -1;
+	req->release = xTaskGetTickCount();
+	req->status = MBM_PENDING;
+	m->polls[m->poll_count++] = req;
+	return 0;
+}
+
+//queue a one-shot request, it goes ahead of the polls that are due
+int32_t mbm_submit(MBM_MASTER* m,MBM_REQ* req,portTickType block)
+{
+	if ( !mbm_valid(req) )
+		return -1;
+	req->status = MBM_PENDING;
+	if ( xQueueSend(m->queue,&req,block) != pdTRUE )
+		return -1;
+	return 0;
+}
+
+//-------------------------------------------------------------------------
+static uint16_t mbm_build(MBM_MASTER* m,MBM_REQ* req)
+{
+	uint16_t regs[MBM_MAX_REGS];
+	uint8_t* b = m->tx;
+	uint16_t len = 0, crc, i;
+
+	b[len++] = req->slave;
+	b[len++] = req->func;
+	b[len++] = req->addr >> 8;
+	b[len++] = req->addr;
+	switch ( req->func ){
+		case MBM_WRITE_SINGLE:
+			eMBRegHolding_ReadBlock(req->reg,regs,1);
+			b[len++] = regs[0] >> 8;
+			b[len++] = regs[0];
+			break;
+		case MBM_WRITE_MULTIPLE:
+			eMBRegHolding_ReadBlock(req->reg,regs,req->count);
+			b[len++] = req->count >> 8;
+			b[len++] = req->count;
+			if ( req->options & MBM_OPT_LEGACY_10 ){
+				//older controllers take the values as they sit in memory
+				for ( i=0; i<req->count; i++ ){
+					b[len++] = regs[i];
+					b[len++] = regs[i] >> 8;
+				}
+				break;
+			}
+			b[len++] = req->count * 2;
+			for ( i=0; i<req->count; i++ ){
+				b[len++] = regs[i] >> 8;
+				b[len++] = regs[i];
+			}
+			break;
+		default:
+			b[len++] = req->count >> 8;
+			b[len++] = req->count;
+			break;
+	}
+	crc = usMBCRC16(b,len);
+	b[len++] = crc;
+	b[len++] = crc >> 8;
+	return len;
+}
+
+static uint16_t mbm_reply_len(MBM_REQ* req)
+{
+	if ( req->func == MBM_READ_HOLDING || req->func == MBM_READ_INPUT )
+		return 5 + req->count * 2;
+	return 8;
+}
+
+//collect up to expect bytes, an exception reply cuts it to 5
+static uint16_t mbm_receive(MBM_MASTER* m,uint16_t expect,portTickType deadline)
+{
+	const uint8_t* p;
+	portTickType now;
+	uint16_t len = 0, n;
+
+	while ( len < expect ){
+		now = xTaskGetTickCount();
+		if ( MBM_DUE(now,deadline) )
+			break;
+		n = xSerialReadSpan(m->port,&p,deadline - now);
+		if ( n == 0 )
+			continue;
+		if ( n > expect - len )
+			n = expect - len;
+		memcpy(m->rx + len,p,n);
+		vSerialReadSpanDone(m->port,n);
+		len += n;
+		if ( len >= 2 && (m->rx[1] & 0x80) ){
+			expect = 5;
+			if ( len > expect )
+				len = expect;
+		}
+	}
+	return len;
+}
+
+//drop whatever a late or chatty slave left in the ring
+static void mbm_flush(MBM_MASTER* m)
+{
+	const uint8_t* p;
+	uint16_t n;
+
+	while ( (n = xSerialReadSpan(m->port,&p,0)) != 0 )
+		vSerialReadSpanDone(m->port,n);
+}
+
+static uint8_t mbm_check(MBM_MASTER* m,MBM_REQ* req,uint16_t len)
+{
+	uint8_t* r = m->rx;
+
+	if ( len < 5 )
+		return MBM_TIMEOUT;
+	if ( usMBCRC16Update(MB_CRC16_INIT,r,len) != 0 )
+		return MBM_CRC_ERR;
+	if ( r[0] != req->slave || (r[1] & 0x7F) != req->func )
+		return MBM_BAD_REPLY;
+	if ( r[1] & 0x80 ){
+		req->exception = r[2];
+		return MBM_EXCEPTION;
+	}
+	if ( len != mbm_reply_len(req) )
+		return MBM_BAD_REPLY;
+	if ( req->func == MBM_READ_HOLDING || req->func == MBM_READ_INPUT ){
+		if ( r[2] != req->count * 2 )
+			return MBM_BAD_REPLY;
+	} else if ( r[2] != m->tx[2] || r[3] != m->tx[3] ){
+		return MBM_BAD_REPLY;
+	}
+	return MBM_OK;
+}
+
+static void mbm_publish(MBM_MASTER* m,MBM_REQ* req)
+{
+	uint16_t regs[MBM_MAX_REGS];
+	uint16_t i;
+
+	if ( req->func != MBM_READ_HOLDING && req->func != MBM_READ_INPUT )
+		return;
+	for ( i=0; i<req->count; i++ )
+		regs[i] = (m->rx[3+i*2] << 8) | m->rx[4+i*2];
+	eMBRegInput_WriteBlock(req->reg,regs,req->count);
+}
+
+//run one request to completion with its retries, returns the final status
+int32_t mbm_transact(MBM_MASTER* m,MBM_REQ* req)
+{
+	portTickType now, out, timeout;
+	uint16_t len;
+	uint8_t i, st = MBM_TIMEOUT;
+
+	len = mbm_build(m,req);
+	timeout = MBM_TICKS(req->timeout ? req->timeout : MBM_TIMEOUT_DEF);
+
+	for ( i=0; i<=req->retries; i++ ){
+		//hold the line quiet for t3.5 after the last frame
+		now = xTaskGetTickCount();
+		if ( !MBM_DUE(now,m->idle + m->t35) )
+			vTaskDelay(m->idle + m->t35 - now);
+		mbm_flush(m);
+
+		vSerialPut(m->port,m->tx,len);
+		out = xTaskGetTickCount() + m->char_time * len;
+		m->transactions++;
+
+		if ( req->slave == 0 ){
+			//broadcast, nobody answers, the turnaround delay stands in
+			m->idle = out + timeout;
+			st = MBM_OK;
+			break;
+		}
+
+		st = mbm_check(m,req,mbm_receive(m,mbm_reply_len(req),out + timeout));
+		m->idle = xTaskGetTickCount();
+		if ( st == MBM_OK || st == MBM_EXCEPTION )
+			break;
+	}
+
+	if ( st == MBM_OK ){
+		mbm_publish(m,req);
+		req->ok++;
+	} else if ( st == MBM_TIMEOUT ){
+		req->timeouts++;
+	} else {
+		req->errors++;
+	}
+	req->status = st;
+	if ( req->done )
+		req->done(req);
+	return st;
+}
+
+//-------------------------------------------------------------------------
+//the next poll that is due, round robin so a slow slave cannot starve the rest
+static MBM_REQ* mbm_next_poll(MBM_MASTER* m,portTickType now,portTickType* wait)
+{
+	MBM_REQ* req;
+	portTickType left;
+	uint8_t i, k;
+
+	*wait = portMAX_DELAY;
+	for ( i=0; i<m->poll_count; i++ ){
+		k = (m->next + i) % m->poll_count;
+		req = m->polls[k];
+		if ( MBM_DUE(now,req->release) ){
+			m->next = (k + 1) % m->poll_count;
+			return req;
+		}
+		left = req->release - now;
+		if ( left < *wait )
+			*wait = left;
+	}
+	return NULL;
+}
+
+void mbm_task(void* pvParameters)
+{
+	MBM_MASTER* m = (MBM_MASTER*)pvParameters;
+	MBM_REQ* req;
+	portTickType now, wait;
+
+	for(;;){
+		//one-shot requests first, the queue also wakes us early
+		if ( xQueueReceive(m->queue,&req,0) == pdTRUE ){
+			mbm_transact(m,req);
+			continue;
+		}
+
+		now = xTaskGetTickCount();
+		req = mbm_next_poll(m,now,&wait);
+		if ( req == NULL ){
+			if ( xQueueReceive(m->queue,&req,wait) == pdTRUE )
+				mbm_transact(m,req);
+			continue;
+		}
+
+		//release from the schedule, not from now, and skip lost periods
+		req->release += MBM_TICKS(req->period);
+		if ( MBM_DUE(now,req->release) )
+			req->release = now + MBM_TICKS(req->period);
+		mbm_transact(m,req);
+	}
+}
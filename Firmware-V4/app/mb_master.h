@@ -0,0 +1,84 @@
+#ifndef __MB_MASTER_H__
+#define __MB_MASTER_H__
+
+#include "stdint.h"
+
+#include "FreeRTOS.h"
+#include "queue.h"
+
+#include "serials.h"
+
+//-------------------------------------------------------------------------
+//modbus RTU master for the downstream devices on one serial line, a single
+//task walks the poll table and a queue of one-shot requests, results go
+//straight into the local register image
+
+#define MBM_MAX_POLLS		8
+#define MBM_QUEUE_LEN		4
+#define MBM_MAX_REGS		16		//per request
+#define MBM_FRAME_MAX		(9 + MBM_MAX_REGS*2)
+
+#define MBM_TIMEOUT_DEF		100		//mS reply timeout when the request has none
+
+//function codes
+#define MBM_READ_HOLDING	0x03	//slave regs -> local input regs
+#define MBM_READ_INPUT		0x04	//slave regs -> local input regs
+#define MBM_WRITE_SINGLE	0x06	//local holding reg -> slave
+#define MBM_WRITE_MULTIPLE	0x10	//local holding regs -> slave
+
+//request status
+#define MBM_OK				0
+#define MBM_PENDING			1
+#define MBM_TIMEOUT			2
+#define MBM_CRC_ERR			3
+#define MBM_BAD_REPLY		4
+#define MBM_EXCEPTION		5		//code in exception
+
+//request options
+#define MBM_OPT_LEGACY_10	0x01	//0x10 without the byte count, values low byte first
+
+typedef struct MBM_REQ_S
+{
+	uint8_t slave;			//0 broadcast, writes only, reads are refused
+	uint8_t func;
+	uint16_t addr;			//register address on the slave
+	uint16_t count;
+	uint16_t reg;			//local register, input for reads, holding for writes
+	uint16_t period;		//mS between polls, 0 back to back, unused for one-shot
+	uint16_t timeout;		//mS reply timeout after the request is out, 0 default
+	uint8_t retries;		//on timeout or bad reply
+	uint8_t options;		//MBM_OPT_
+	void (*done)(struct MBM_REQ_S* req);	//optional, called from the master task
+
+	//kept by the master
+	portTickType release;	//next poll
+	volatile uint8_t status;
+	uint8_t exception;
+	uint32_t ok;
+	uint32_t errors;
+	uint32_t timeouts;
+} MBM_REQ,*pMBM_REQ;
+
+typedef struct
+{
+	xComPortHandle port;
+	portTickType char_time;	//ticks per 11 bit character, rounded up
+	portTickType t35;		//inter frame gap, ticks
+	portTickType idle;		//tick the line went quiet
+	MBM_REQ* polls[MBM_MAX_POLLS];
+	uint8_t poll_count;
+	uint8_t next;			//round robin start in the poll table
+	xQueueHandle queue;		//one-shot MBM_REQ*
+	uint8_t tx[MBM_FRAME_MAX];
+	uint8_t rx[MBM_FRAME_MAX];
+	uint32_t transactions;
+} MBM_MASTER,*pMBM_MASTER;
+
+//-------------------------------------------------------------------------
+int32_t mbm_init(MBM_MASTER* m,xComPortHandle port,uint32_t baud);
+int32_t mbm_add_poll(MBM_MASTER* m,MBM_REQ* req);
+int32_t mbm_submit(MBM_MASTER* m,MBM_REQ* req,portTickType block);
+int32_t mbm_transact(MBM_MASTER* m,MBM_REQ* req);
+void mbm_task(void* pvParameters);
+
+#endif
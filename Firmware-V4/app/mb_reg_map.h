@@ -166,6 +166,13 @@
 #define MB_TEMP01			37			//¶ȵ2¶
 #define MB_TEMP10			38			//¶ȵ1¶
 #define MB_TEMP11			39			//¶ȵ2¶
+
+//30041-30056	-	ͳƣÿ2Ĵ˳
+#define MB_SCHED_STAT		40
+	#define SCHED_STAT_JITTER	0		//ӳ٣λmS
+	#define SCHED_STAT_OVERRUN	1		//ֹʱʧڵĴ
+	#define SCHED_STAT_REGS		2
+	#define SCHED_STAT_JOBS		8
 	
 //10129-10136
 //ADC16λֵ
@@ -194,6 +201,7 @@
 #define MB_VOL_STEP_INTERVAL	5	//ѹ,16λλmS
 #define MB_VOL_STEP_TIMEOUT		6 	//ѹʱ,16λλmS
 #define MB_VOL_LEVEL1			7	//ѹֵ󣬿ʼӵԶģʽ16λλV
+#define MB_VOL_KP				8	//ѹPI,λ1/256KPKIΪ0ʱʹԭ
 
 #define MB_CURRRENT_MAX			9	//ֵ,16λλuA
 #define MB_CUR_SCALE			10	//ѹǹλuA/mV
@@ -202,12 +210,21 @@
 #define MB_CUR_STEP_INTERVAL	13
 #define MB_CUR_STEP_TIMEOUT		14	
 #define MB_CUR_CTL_START		15
+#define MB_CUR_KP				16	//PI,λ1/256KPKIΪ0ʱʹԭ
 
 #define MB_VOL_SET_L			17	//ѹ趨ֵ,16λλV
 #define MB_CUR_SET_L			18	//趨ֵ,16λλuA
 #define MB_VOL_SET_R			19	//ѹ趨ֵ,16λλV
 #define MB_CUR_SET_R			20	//趨ֵ,16λλuA
 
+//PI漰ǰҸѹǹ
+//40022	-	ѹPI,λ1/256ÿεۼ
+#define MB_VOL_KI				21
+//40023	-	PI,λ1/256ÿεۼ
+#define MB_CUR_KI				22
+//40024	-	ѹ趨ֵǰ,λ1룬=趨ֵ*KFF/1000+PI
+#define MB_VOL_KFF				23
+
 //е
 #define MB_POWERPUMP_CTL		24
 //	#define PWR_ON		(1<<0)
@@ -241,6 +258,9 @@
 #define MB_SAMPLE_START			36		//Ʒ⿪ʼʱ,xx֮ʼ
 #define MB_SAMPLE_INTERVAL		37		//Ʒʱ,
 
+//40039	-	PI,16λλmSֻڲ
+#define MB_CUR_PI_INTERVAL		38
+
 #define MB_SAMPLE_LED			40		//ƷLED״̬
 //	#define SLED_PWR_ON			POWER_ON	
 //	#define SLED_PWR_OFF		POWER_OFF	
@@ -394,4 +414,20 @@
 #define MB_DAC7			0xB7
 
 
+//----------------------------------------------------------------------
+//holding register regions with a side effect, sorted by start, no overlaps.
+//X( start, count, hook ): a write commits the whole block first, then every
+//region it touches gets one hook( first, count ) call for its part of the
+//block. Registers outside these regions are plain storage.
+#define MB_HOLDING_REGIONS( X ) \
+	X( MB_CUR_SET_L,		1,	prvMBHookCurSet )	\
+	X( MB_CUR_SET_R,		1,	prvMBHookCurSet )	\
+	X( MB_POWERPUMP_CTL,	1,	prvMBHookPowerPump )	\
+	X( MB_MPUMP_CTL,		1,	prvMBHookMPump )	\
+	X( MB_VMETER_CTL,		1,	prvMBHookVMeter )	\
+	X( MB_SAMPLE_LED,		1,	prvMBHookSampleLed )	\
+	X( MB_BAFFLE,			1,	prvMBHookBaffle )	\
+	X( MB_BLEED_VALVE,		1,	prvMBHookBleedValve )	\
+	X( MB_DAC0,				8,	prvMBHookDac )
+
 #endif
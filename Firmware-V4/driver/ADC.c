@@ -30,6 +30,7 @@
 
 #include "stm32f10x.h"
 #include "adc.h"
+#include "filter.h"
 #include "config.h"
 
 /* Private typedef -----------------------------------------------------------*/
@@ -39,6 +40,10 @@
 /* Private macro -------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
 volatile uint16_t ADC_ConvertedValueTab[ADC_SAMPLE_TIMES][ADC_CHANNEL];
+static volatile uint16_t ADC_FilteredTab[ADC_CHANNEL];
+static volatile uint32_t ADC_ReadyHalf = 0;
+static volatile uint32_t ADC_BlockSeq = 0;
+static pADC_BLOCK_HOOK ADC_BlockHook = NULL;
 psADC_CONFIG psADC_Config = NULL;
     
 /* Private function prototypes -----------------------------------------------*/
@@ -84,21 +89,26 @@ void ADC_GPIO_Configuration(void)
 
 /**
   * @brief   ADC_Init program
+  *			 ADC1 scans ADC_CHANNEL channels continuously, DMA1 channel1 moves
+  *			 the results into ADC_ConvertedValueTab in circular mode. The
+  *			 half/full transfer interrupts mark which half of the table is
+  *			 stable, so readers never wait for a conversion.
   * @param  None
   * @retval None
   */
 void ADC_InitChannel(void)
 {
 	ADC_InitTypeDef ADC_InitStructure;
-//  DMA_InitTypeDef DMA_InitStructure;
+	DMA_InitTypeDef DMA_InitStructure;
+	NVIC_InitTypeDef NVIC_InitStructure;
+	uint32_t i;
 	
 	/* System clocks configuration ---------------------------------------------*/
 	ADC_RCC_Configuration();
 	
 	/* GPIO configuration ------------------------------------------------------*/
 	ADC_GPIO_Configuration();
-#if 0
-  /* DMA1 channel1 configuration ----------------------------------------------*/
+
 	/* DMA1 channel1 configuration ----------------------------------------------*/
 	DMA_DeInit(DMA1_Channel1);
 	DMA_InitStructure.DMA_PeripheralBaseAddr 	= (uint32_t)ADC1_DR_Address;
@@ -114,30 +124,30 @@ void ADC_InitChannel(void)
 	DMA_InitStructure.DMA_M2M 				= DMA_M2M_Disable;
 	DMA_Init(DMA1_Channel1, &DMA_InitStructure);
 
+	NVIC_InitStructure.NVIC_IRQChannel = DMA1_Channel1_IRQn;
+	NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = configLIBRARY_KERNEL_INTERRUPT_PRIORITY;
+	NVIC_InitStructure.NVIC_IRQChannelSubPriority = 0;
+	NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
+	NVIC_Init( &NVIC_InitStructure );
+
+	DMA_ITConfig(DMA1_Channel1, DMA_IT_HT | DMA_IT_TC, ENABLE);
 	/* Enable DMA1 Channel1 */
 	DMA_Cmd(DMA1_Channel1, ENABLE);
-#endif
+
 	/* ADC1 configuration ------------------------------------------------------*/
 	ADC_InitStructure.ADC_Mode = ADC_Mode_Independent;
-	ADC_InitStructure.ADC_ScanConvMode = DISABLE;
-	ADC_InitStructure.ADC_ContinuousConvMode = DISABLE;
+	ADC_InitStructure.ADC_ScanConvMode = ENABLE;
+	ADC_InitStructure.ADC_ContinuousConvMode = ENABLE;
 	ADC_InitStructure.ADC_ExternalTrigConv = ADC_ExternalTrigConv_None;
 	ADC_InitStructure.ADC_DataAlign = ADC_DataAlign_Right;
-	ADC_InitStructure.ADC_NbrOfChannel = 1;
+	ADC_InitStructure.ADC_NbrOfChannel = ADC_CHANNEL;
 	ADC_Init(ADC1, &ADC_InitStructure);
-	/* ADC1 regular channels configuration */ 
-	ADC_RegularChannelConfig(ADC1, ADC_Channel_8,   1, ADC_SampleTime_239Cycles5);    
-	/*
-	ADC_RegularChannelConfig(ADC1, ADC_Channel_9,   2, ADC_SampleTime_239Cycles5);
-	ADC_RegularChannelConfig(ADC1, ADC_Channel_10,  3, ADC_SampleTime_239Cycles5);    
-	ADC_RegularChannelConfig(ADC1, ADC_Channel_11,  4, ADC_SampleTime_239Cycles5);
-	ADC_RegularChannelConfig(ADC1, ADC_Channel_12,  5, ADC_SampleTime_239Cycles5);    
-	ADC_RegularChannelConfig(ADC1, ADC_Channel_13,  6, ADC_SampleTime_239Cycles5);
-	ADC_RegularChannelConfig(ADC1, ADC_Channel_14,  7, ADC_SampleTime_239Cycles5);    
-	ADC_RegularChannelConfig(ADC1, ADC_Channel_15,  8, ADC_SampleTime_239Cycles5);
-	*/
+	/* ADC1 regular channels configuration, rank i+1 = ADC_SCAN_FIRST + i */ 
+	for(i=0;i<ADC_CHANNEL;i++)
+		ADC_RegularChannelConfig(ADC1, ADC_SCAN_FIRST + i, i + 1, ADC_SampleTime_239Cycles5);    
+
 	/* Enable ADC1 DMA */
-	//ADC_DMACmd(ADC1, ENABLE);
+	ADC_DMACmd(ADC1, ENABLE);
 	
 	/* Enable ADC1 */
 	ADC_Cmd(ADC1, ENABLE);
@@ -154,27 +164,119 @@ void ADC_InitChannel(void)
 	/* Check the end of ADC1 calibration */
 	while(ADC_GetCalibrationStatus(ADC1));
 	
-	/* Start ADC1 Software Conversion */ 
-	//ADC_SoftwareStartConvCmd(ADC1, ENABLE);
+	/* Start ADC1 Software Conversion, continuous mode keeps it running */ 
+	ADC_SoftwareStartConvCmd(ADC1, ENABLE);
+}
+
+/**
+  * @brief  DMA1 channel1 half/full transfer interrupt.
+  *			Marks the finished half as the latest block and updates the
+  *			per-channel filtered value (mean without min/max).
+  * @param  None
+  * @retval None
+  */
+void DMA1_Channel1_IRQHandler(void)
+{
+	uint32_t half,row,ch;
+	uint32_t sum;
+	uint16_t val,min,max;
+
+	if ( DMA_GetITStatus(DMA1_IT_TC1) != RESET ){
+		//a pending HT is stale here, the DMA is already refilling the first half
+		DMA_ClearITPendingBit(DMA1_IT_TC1 | DMA1_IT_HT1);
+		half = 1;
+	} else if ( DMA_GetITStatus(DMA1_IT_HT1) != RESET ){
+		DMA_ClearITPendingBit(DMA1_IT_HT1);
+		half = 0;
+	} else {
+		DMA_ClearITPendingBit(DMA1_IT_GL1);
+		return;
+	}
+
+	for(ch=0;ch<ADC_CHANNEL;ch++){
+		row = half*ADC_BLOCK_SAMPLES;
+		sum = min = max = ADC_ConvertedValueTab[row][ch];
+		for(row++;row<(half+1)*ADC_BLOCK_SAMPLES;row++){
+			val = ADC_ConvertedValueTab[row][ch];
+			sum += val;
+			if ( val < min )	min = val;
+			if ( val > max )	max = val;
+		}
+		ADC_FilteredTab[ch] = (sum - min - max)/(ADC_BLOCK_SAMPLES - 2);
+	}
+	
+	ADC_ReadyHalf = half;
+	ADC_BlockSeq ++;
+
+	if ( ADC_BlockHook != NULL )
+		ADC_BlockHook(half);
+}
+
+/**
+  * @brief  Copy the latest stable block of one scan channel, never blocks.
+  * @param  index: column of ADC_ConvertedValueTab, see ADC_CH_INDEX()
+  * @param  buf: ADC_BLOCK_SAMPLES samples
+  * @retval block sequence number, 0 if no block has been converted yet
+  */
+uint32_t ADC_GetBlock(uint32_t index,uint16_t* buf)
+{
+	uint32_t seq,row,i;
+
+	if ( index >= ADC_CHANNEL )
+		return 0;
+	
+	do {
+		seq = ADC_BlockSeq;
+		if ( seq == 0 )
+			return 0;
+		row = ADC_ReadyHalf * ADC_BLOCK_SAMPLES;
+		for(i=0;i<ADC_BLOCK_SAMPLES;i++)
+			buf[i] = ADC_ConvertedValueTab[row+i][index];
+	} while ( seq != ADC_BlockSeq );	//the DMA wrapped into this half while copying
 	
-	/* Test on DMA1 channel1 transfer complete flag */
-	//while(!DMA_GetFlagStatus(DMA1_FLAG_TC1));
-	/* Clear DMA1 channel1 transfer complete flag */
-	//DMA_ClearFlag(DMA1_FLAG_TC1);
+	return seq;
+}
+
+/**
+  * @brief  Filtered value of the latest block of one scan channel.
+  * @param  index: column of ADC_ConvertedValueTab, see ADC_CH_INDEX()
+  * @retval raw adc value
+  */
+uint16_t ADC_GetFiltered(uint32_t index)
+{
+	if ( index >= ADC_CHANNEL )
+		return 0;
+	return ADC_FilteredTab[index];
+}
+
+uint32_t ADC_GetBlockSeq(void)
+{
+	return ADC_BlockSeq;
+}
+
+void ADC_SetBlockHook(pADC_BLOCK_HOOK hook)
+{
+	ADC_BlockHook = hook;
 }
 
+/**
+  * @brief  Compatible with the old polling interface, the samples now come 
+  *			from the latest DMA block instead of blocking on EOC.
+  * @param  ch: ADC_Channel_x
+  * @retval number of samples copied
+  */
 uint16_t ADC_Get(uint8_t ch,uint16_t* buf,uint16_t count)
 {
+	uint16_t block[ADC_BLOCK_SAMPLES];
 	uint16_t i;
 	
-	ADC_RegularChannelConfig(ADC1, ch,1, ADC_SampleTime_239Cycles5);    
-	for(i=0;i<count;i++){
-		ADC_Cmd(ADC1, ENABLE);
-		while( ADC_GetFlagStatus(ADC1,ADC_FLAG_EOC) == RESET );
-		buf[i] = ADC_GetConversionValue(ADC1);
-	}
-	//ADC_Cmd(ADC1, DISABLE);
-	return 0;
+	if ( ADC_GetBlock(ADC_CH_INDEX(ch),block) == 0 )
+		return 0;
+	if ( count > ADC_BLOCK_SAMPLES )
+		count = ADC_BLOCK_SAMPLES;
+	for(i=0;i<count;i++)
+		buf[i] = block[i];
+	return count;
 }
 
 void exchange_sort16(uint16_t* pData,uint16_t Count)
@@ -212,18 +314,15 @@ void ADC_SetConfig(	psADC_CONFIG cfg)
 
 uint16_t ADC_GetAverage(uint32_t ch)
 {
-	uint16_t buf[ADC_SAMPLE_TIMES];
-	uint32_t i;
+	uint16_t buf[ADC_BLOCK_SAMPLES];
 	uint32_t sample;
 
 	if ( ch >= ADC_CHANNEL || psADC_Config == NULL )
 		return 0;
 	
-
-	for(i=0;i<ADC_SAMPLE_TIMES;i++)
-		buf[i] = ADC_ConvertedValueTab[i][ch];
-	exchange_sort16(buf,ADC_SAMPLE_TIMES);
-	sample = get_average16(buf + 4, ADC_SAMPLE_TIMES - 4*2);
+	if ( ADC_GetBlock(ch,buf) == 0 )
+		return 0;
+	sample = trimmed_mean16(buf, ADC_BLOCK_SAMPLES, 2);
 	return (sample*psADC_Config[ch].scale/10000);
 }
 
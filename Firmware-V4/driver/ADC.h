@@ -4,8 +4,15 @@
 #define ADC_BITS	12UL
 #define ADC_VREF	2500UL
 
-#define ADC_CHANNEL			12UL
+//scan sequence: rank1 = ch8 ... rank8 = ch15, rank9 = temp sensor(ch16), rank10 = Vrefint(ch17)
+#define ADC_SCAN_FIRST		8UL
+#define ADC_CHANNEL			10UL
 #define ADC_SAMPLE_TIMES	32UL
+//DMA fills one half of ADC_ConvertedValueTab while the other half is stable
+#define ADC_BLOCK_SAMPLES	(ADC_SAMPLE_TIMES/2)
+
+//column of ADC_ConvertedValueTab for an ADC_Channel_x
+#define ADC_CH_INDEX(ch)	((uint32_t)(ch) - ADC_SCAN_FIRST)
 
 #define ADC_GET_MV(adc)	(adc*2L*ADC_VREF/((1<<ADC_BITS)-1))
 
@@ -15,6 +22,9 @@ typedef struct _ADC_CONFIG_
 	uint32_t scale;
 }sADC_CONFIG,*psADC_CONFIG;
 
+//called from the DMA interrupt, half = 0 for half-transfer, 1 for transfer-complete
+typedef void (*pADC_BLOCK_HOOK)(uint32_t half);
+
 //-------------------------------------------------------------------------
 
 extern volatile uint16_t ADC_ConvertedValueTab[ADC_SAMPLE_TIMES][ADC_CHANNEL];
@@ -23,6 +33,10 @@ extern volatile uint16_t ADC_ConvertedValueTab[ADC_SAMPLE_TIMES][ADC_CHANNEL];
 void ADC_InitChannel(void);
 void ADC_SetConfig(psADC_CONFIG cfg);
 uint16_t ADC_Get(uint8_t ch,uint16_t* buf,uint16_t count);
+uint32_t ADC_GetBlock(uint32_t index,uint16_t* buf);
+uint16_t ADC_GetFiltered(uint32_t index);
+uint32_t ADC_GetBlockSeq(void);
+void ADC_SetBlockHook(pADC_BLOCK_HOOK hook);
 void exchange_sort16(uint16_t* pData,uint16_t Count);
 uint16_t get_average16(uint16_t* dat, uint16_t len);
 uint16_t ADC_GetAverage(uint32_t ch);
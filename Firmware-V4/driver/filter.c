@@ -0,0 +1,227 @@
+/*
+ *	filter.c
+ *	Sample filters for the ADC paths: partial selection trimmed mean,
+ *	sliding window median and exponential moving average. None of them
+ *	reorders the QUEUE ring, so enqueue() keeps its FIFO order.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "filter.h"
+
+//-----------------------------------------------------------------------
+void init_queue(pQUEUE q,uint16_t *buf,uint8_t size)
+{
+	q->queue = buf;
+	q->size  = size;
+	q->front = q->rear = 0;
+}
+
+uint8_t enqueue(pQUEUE q,uint16_t da)
+{
+	q->queue[q->rear++] = da;
+	if (q->rear == q->size)
+		q->rear = 0;
+
+	if (q->rear == q->front){
+		q->front ++;
+		if (q->front == q->size)
+			q->front = 0;
+		return 1;
+	}
+
+	return 0;
+}
+
+uint16_t queue_count(pQUEUE q)
+{
+	if ( q->rear >= q->front )
+		return q->rear - q->front;
+	return q->size - q->front + q->rear;
+}
+
+//copy the queued samples, oldest first, the queue is not modified
+uint16_t queue_copy16(pQUEUE q,uint16_t* buf,uint16_t max)
+{
+	uint16_t i,n,idx;
+
+	n = queue_count(q);
+	if ( n > max )
+		n = max;
+	//keep the newest samples when clamped
+	idx = q->rear + q->size - n;
+	for(i=0;i<n;i++){
+		if ( idx >= q->size )
+			idx -= q->size;
+		buf[i] = q->queue[idx++];
+	}
+	return n;
+}
+
+uint16_t queue_trimmed_mean16(pQUEUE q,uint16_t trim)
+{
+	uint16_t buf[FILTER_MAX_WINDOW];
+	uint16_t n;
+
+	n = queue_copy16(q,buf,FILTER_MAX_WINDOW);
+	return trimmed_mean16(buf,n,trim);
+}
+
+uint16_t queue_median16(pQUEUE q)
+{
+	uint16_t buf[FILTER_MAX_WINDOW];
+	uint16_t n;
+
+	n = queue_copy16(q,buf,FILTER_MAX_WINDOW);
+	if ( n == 0 )
+		return 0;
+	return select_nth16(buf,n,n/2);
+}
+
+//-----------------------------------------------------------------------
+/*
+ * function		: select_nth16
+ * description	: Hoare selection (nth_element), after return dat[k] holds
+ *				  the k-th smallest value, dat[0..k-1] <= dat[k] <= dat[k+1..].
+ *				  Average O(n), dat is reordered.
+ */
+uint16_t select_nth16(uint16_t* dat,uint16_t len,uint16_t k)
+{
+	int32_t left,right,i,j;
+	uint16_t pivot,temp;
+
+	if ( len == 0 )
+		return 0;
+	if ( k >= len )
+		k = len - 1;
+
+	left  = 0;
+	right = len - 1;
+	while ( left < right ){
+		pivot = dat[(left + right) >> 1];
+		i = left;
+		j = right;
+		do {
+			while ( dat[i] < pivot ) i++;
+			while ( pivot < dat[j] ) j--;
+			if ( i <= j ){
+				temp = dat[i];
+				dat[i] = dat[j];
+				dat[j] = temp;
+				i++;
+				j--;
+			}
+		} while ( i <= j );
+		if ( j < k )	left  = i;
+		if ( k < i )	right = j;
+	}
+	return dat[k];
+}
+
+/*
+ * function		: trimmed_mean16
+ * description	: mean of dat without the trim smallest and trim largest
+ *				  samples, same result as exchange_sort16 + get_average16 on
+ *				  the middle slice but two partial selections instead of a
+ *				  full sort. dat is reordered.
+ */
+uint16_t trimmed_mean16(uint16_t* dat,uint16_t len,uint16_t trim)
+{
+	uint32_t sum;
+	uint16_t i,n;
+
+	if ( len == 0 )
+		return 0;
+	if ( trim*2 >= len )
+		trim = (len - 1)/2;
+	n = len - 2*trim;
+
+	if ( trim ){
+		//lowest trim samples to the front
+		select_nth16(dat,len,trim);
+		//highest trim samples to the back of the rest
+		select_nth16(dat+trim,len-trim,n-1);
+	}
+	for(sum=0,i=trim;i<trim+n;i++)
+		sum += dat[i];
+	return sum/n;
+}
+
+//-----------------------------------------------------------------------
+void median_init(pMEDIAN_FILTER mf,uint16_t* ring,uint16_t* sorted,uint16_t size)
+{
+	mf->ring   = ring;
+	mf->sorted = sorted;
+	mf->size   = size;
+	mf->count  = 0;
+	mf->pos    = 0;
+}
+
+/*
+ * function		: median_update
+ * description	: push one sample, the oldest drops out once the window is
+ *				  full. The sorted copy is kept by removing the old value and
+ *				  inserting the new one, O(size) moves and no sort.
+ * return value	: median of the current window
+ */
+uint16_t median_update(pMEDIAN_FILTER mf,uint16_t da)
+{
+	uint16_t lo,hi,mid,old;
+
+	if ( mf->count == mf->size ){
+		old = mf->ring[mf->pos];
+		//find the old value and close the gap
+		lo = 0;
+		hi = mf->count - 1;
+		while ( lo < hi ){
+			mid = (lo + hi) >> 1;
+			if ( mf->sorted[mid] < old )
+				lo = mid + 1;
+			else
+				hi = mid;
+		}
+		memmove(mf->sorted+lo,mf->sorted+lo+1,(mf->count-lo-1)*sizeof(uint16_t));
+		mf->count --;
+	}
+	mf->ring[mf->pos++] = da;
+	if ( mf->pos == mf->size )
+		mf->pos = 0;
+
+	//insert the new value
+	lo = 0;
+	hi = mf->count;
+	while ( lo < hi ){
+		mid = (lo + hi) >> 1;
+		if ( mf->sorted[mid] <= da )
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	memmove(mf->sorted+lo+1,mf->sorted+lo,(mf->count-lo)*sizeof(uint16_t));
+	mf->sorted[lo] = da;
+	mf->count ++;
+
+	return mf->sorted[mf->count/2];
+}
+
+//-----------------------------------------------------------------------
+void ema_init(pEMA_FILTER ef,uint8_t shift)
+{
+	ef->acc   = 0;
+	ef->shift = shift;
+	ef->valid = 0;
+}
+
+uint16_t ema_update(pEMA_FILTER ef,uint16_t da)
+{
+	if ( ef->valid == 0 ){
+		//start from the first sample instead of ramping up from 0
+		ef->acc = (uint32_t)da << ef->shift;
+		ef->valid = 1;
+	} else {
+		ef->acc = ef->acc - (ef->acc >> ef->shift) + da;
+	}
+	return ef->acc >> ef->shift;
+}
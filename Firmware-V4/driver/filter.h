@@ -0,0 +1,54 @@
+#ifndef __FILTER_H__
+#define __FILTER_H__
+
+#include "stdint.h"
+
+//largest window the stack based filters copy, bigger queues are clamped
+#define FILTER_MAX_WINDOW	32
+
+//-------------------------------------------------------------------------
+//FIFO ring of samples, holds size-1 samples, oldest at front
+typedef struct 
+{
+  unsigned short * queue;
+  unsigned char size;
+  unsigned char front;
+  unsigned char rear;
+} QUEUE,*pQUEUE;
+
+//sliding window median, keeps the window in arrival order and sorted order
+typedef struct
+{
+	uint16_t* ring;		//samples in arrival order
+	uint16_t* sorted;	//the same samples in ascending order
+	uint16_t size;
+	uint16_t count;
+	uint16_t pos;
+} MEDIAN_FILTER,*pMEDIAN_FILTER;
+
+//exponential moving average, y += (x - y) / 2^shift, fixed point
+typedef struct
+{
+	uint32_t acc;		//y << shift
+	uint8_t  shift;
+	uint8_t  valid;
+} EMA_FILTER,*pEMA_FILTER;
+
+//-------------------------------------------------------------------------
+void init_queue(pQUEUE q,uint16_t *buf,uint8_t size);
+uint8_t enqueue(pQUEUE q,uint16_t da);
+uint16_t queue_count(pQUEUE q);
+uint16_t queue_copy16(pQUEUE q,uint16_t* buf,uint16_t max);
+uint16_t queue_trimmed_mean16(pQUEUE q,uint16_t trim);
+uint16_t queue_median16(pQUEUE q);
+
+uint16_t select_nth16(uint16_t* dat,uint16_t len,uint16_t k);
+uint16_t trimmed_mean16(uint16_t* dat,uint16_t len,uint16_t trim);
+
+void median_init(pMEDIAN_FILTER mf,uint16_t* ring,uint16_t* sorted,uint16_t size);
+uint16_t median_update(pMEDIAN_FILTER mf,uint16_t da);
+
+void ema_init(pEMA_FILTER ef,uint8_t shift);
+uint16_t ema_update(pEMA_FILTER ef,uint16_t da);
+
+#endif //__FILTER_H__
@@ -52,11 +52,18 @@
 */
 
 /*
-	BASIC INTERRUPT DRIVEN SERIAL PORT DRIVER FOR UART0.
+	SERIAL PORT DRIVER FOR USART1..3.
+
+	Received bytes land in a ring buffer, either written by a circular DMA
+	channel or by the RXNE interrupt.  The reading task is only woken on an
+	idle line, a half/full DMA buffer or a full ring, not once per byte.
+	Transmitted bytes are queued in a second ring that is drained by DMA,
+	one contiguous span per transfer, or by the TXE interrupt.
 */
 
 /* Scheduler includes. */
 #include "FreeRTOS.h"
+#include "task.h"
 #include "queue.h"
 #include "semphr.h"
 
@@ -248,58 +255,250 @@ signed portBASE_TYPE xSerialPortBaseInit( eCOMPort ePort, eBaud eWantedBaud, ePa
 }
 /*-----------------------------------------------------------*/
 
+/* Restart the transmitter on the next queued span.  Called with interrupts
+masked, either from a critical section or from the port ISRs. */
+static void prvTxStart( xComPort *pxPort )
+{
+unsigned portSHORT usHead = pxPort->usTxHead;
+unsigned portSHORT usTail = pxPort->usTxTail;
+
+	if( ( pxPort->usTxSpan != 0 ) || ( usHead == usTail ) )
+	{
+		return;
+	}
+
+	if( pxPort->xTxDMA != 0 )
+	{
+		/* DMA can not wrap, send up to the end of the buffer first. */
+		pxPort->usTxSpan = ( usHead > usTail ) ? ( usHead - usTail ) : ( pxPort->usTxSize - usTail );
+		DMA_Cmd( pxPort->xTxDMA, DISABLE );
+		pxPort->xTxDMA->CMAR = ( uint32_t ) ( pxPort->pucTxBuf + usTail );
+		pxPort->xTxDMA->CNDTR = pxPort->usTxSpan;
+		DMA_Cmd( pxPort->xTxDMA, ENABLE );
+	}
+	else
+	{
+		pxPort->usTxSpan = 1;
+		USART_ITConfig( pxPort->xUSART, USART_IT_TXE, ENABLE );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static unsigned portSHORT prvRxHead( xComPort *pxPort )
+{
+unsigned portSHORT usHead;
+
+	if( pxPort->xRxDMA != 0 )
+	{
+		usHead = pxPort->usRxSize - DMA_GetCurrDataCounter( pxPort->xRxDMA );
+		if( usHead >= pxPort->usRxSize )
+		{
+			usHead = 0;
+		}
+	}
+	else
+	{
+		usHead = pxPort->usRxHead;
+	}
+	return usHead;
+}
+/*-----------------------------------------------------------*/
+
+static portBASE_TYPE prvRxCopy( xComPort *pxPort, unsigned portCHAR *pcBuf, portBASE_TYPE xMax )
+{
+portBASE_TYPE i = 0;
+unsigned portSHORT usHead = prvRxHead( pxPort );
+unsigned portSHORT usTail = pxPort->usRxTail;
+
+	while( ( usTail != usHead ) && ( i < xMax ) )
+	{
+		pcBuf[ i++ ] = pxPort->pucRxBuf[ usTail ];
+		if( ++usTail >= pxPort->usRxSize )
+		{
+			usTail = 0;
+		}
+	}
+	pxPort->usRxTail = usTail;
+	pxPort->ulRxCount += i;
+	return i;
+}
+/*-----------------------------------------------------------*/
+
+static void prvDMAChannelInit( DMA_Channel_TypeDef *xChannel, USART_TypeDef *xUSART, unsigned portCHAR *pucBuf, unsigned portSHORT usSize, uint32_t ulDir, uint32_t ulMode, uint32_t ulIT, IRQn_Type xIRQ )
+{
+DMA_InitTypeDef DMA_InitStructure;
+NVIC_InitTypeDef NVIC_InitStructure;
+
+	DMA_DeInit( xChannel );
+	DMA_InitStructure.DMA_PeripheralBaseAddr = ( uint32_t ) &xUSART->DR;
+	DMA_InitStructure.DMA_MemoryBaseAddr = ( uint32_t ) pucBuf;
+	DMA_InitStructure.DMA_DIR = ulDir;
+	DMA_InitStructure.DMA_BufferSize = usSize;
+	DMA_InitStructure.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
+	DMA_InitStructure.DMA_MemoryInc = DMA_MemoryInc_Enable;
+	DMA_InitStructure.DMA_PeripheralDataSize = DMA_PeripheralDataSize_Byte;
+	DMA_InitStructure.DMA_MemoryDataSize = DMA_MemoryDataSize_Byte;
+	DMA_InitStructure.DMA_Mode = ulMode;
+	DMA_InitStructure.DMA_Priority = DMA_Priority_Medium;
+	DMA_InitStructure.DMA_M2M = DMA_M2M_Disable;
+	DMA_Init( xChannel, &DMA_InitStructure );
+	DMA_ITConfig( xChannel, ulIT, ENABLE );
+
+	NVIC_InitStructure.NVIC_IRQChannel = xIRQ;
+	NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = configLIBRARY_KERNEL_INTERRUPT_PRIORITY;
+	NVIC_InitStructure.NVIC_IRQChannelSubPriority = 0;
+	NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
+	NVIC_Init( &NVIC_InitStructure );
+}
+/*-----------------------------------------------------------*/
+
 xComPortHandle xSerialPortInit( eCOMPort ePort, eBaud eWantedBaud, eParity eWantedParity, eDataBits eWantedDataBits, eStopBits eWantedStopBits, unsigned portBASE_TYPE uxBufferLength )
 {
-	if ( xSerialPortBaseInit(ePort, eWantedBaud, eWantedParity, eWantedDataBits, eWantedStopBits ) == pdTRUE ){
-		/* Create the queues used to hold Rx/Tx characters. */
-		xPorts[ePort].xRxedChars = xQueueCreate( uxBufferLength, ( unsigned portBASE_TYPE ) sizeof( unsigned portCHAR ) );
-		xPorts[ePort].xCharsForTx = xQueueCreate( uxBufferLength + 1, ( unsigned portBASE_TYPE ) sizeof( unsigned portCHAR ) );
-		switch ( ePort ){
-		case 0:	xPorts[ePort].xUSART = USART1;	break;
-		case 1:	xPorts[ePort].xUSART = USART2;	break;
-		case 2:	xPorts[ePort].xUSART = USART3;	break;
-		default: return ( xComPortHandle ) 0;
-		}	
-		return (( xComPortHandle )&xPorts[ePort]);
-	} else
+xComPort *pxPort;
+DMA_Channel_TypeDef *xRxDMA = 0, *xTxDMA = 0;
+IRQn_Type xRxIRQ = DMA1_Channel5_IRQn, xTxIRQ = DMA1_Channel4_IRQn;
+
+	if( ePort >= serMAX_PORTS )
+	{
+		return ( xComPortHandle ) 0;
+	}
+
+	if ( xSerialPortBaseInit(ePort, eWantedBaud, eWantedParity, eWantedDataBits, eWantedStopBits ) != pdTRUE )
+	{
 		return ( xComPortHandle ) 0;
+	}
+
+	pxPort = &xPorts[ ePort ];
+	switch ( ePort ){
+	case 0:
+		/* DMA1 channel 4/5 are also SPI2's, webserver/enc28j60.c takes them
+		while USE_USART1 is off. */
+		pxPort->xUSART = USART1;
+		xRxDMA = DMA1_Channel5;	xRxIRQ = DMA1_Channel5_IRQn;
+		xTxDMA = DMA1_Channel4;	xTxIRQ = DMA1_Channel4_IRQn;
+		break;
+	case 1:
+		pxPort->xUSART = USART2;
+		xRxDMA = DMA1_Channel6;	xRxIRQ = DMA1_Channel6_IRQn;
+		xTxDMA = DMA1_Channel7;	xTxIRQ = DMA1_Channel7_IRQn;
+		break;
+	case 2:
+		/* DMA1 channel 2/3 are shared with SPI1, this slow port keeps
+		using the RXNE/TXE interrupts. */
+		pxPort->xUSART = USART3;
+		break;
+	default:
+		return ( xComPortHandle ) 0;
+	}
+
+	USART_ITConfig( pxPort->xUSART, USART_IT_RXNE, DISABLE );
+
+	/* Buffers are kept on re-init, the lengths are fixed by the first call. */
+	if( pxPort->pucRxBuf == 0 )
+	{
+		pxPort->pucRxBuf = ( unsigned portCHAR * ) pvPortMalloc( uxBufferLength );
+		pxPort->pucTxBuf = ( unsigned portCHAR * ) pvPortMalloc( uxBufferLength );
+		vSemaphoreCreateBinary( pxPort->xRxEvent );
+		if( ( pxPort->pucRxBuf == 0 ) || ( pxPort->pucTxBuf == 0 ) || ( pxPort->xRxEvent == 0 ) )
+		{
+			return ( xComPortHandle ) 0;
+		}
+		pxPort->usRxSize = uxBufferLength;
+		pxPort->usTxSize = uxBufferLength;
+	}
+	pxPort->usRxHead = pxPort->usRxTail = 0;
+	pxPort->usTxHead = pxPort->usTxTail = 0;
+	pxPort->usTxSpan = 0;
+	pxPort->xRxDMA = xRxDMA;
+	pxPort->xTxDMA = xTxDMA;
+
+	if( xRxDMA != 0 )
+	{
+		RCC_AHBPeriphClockCmd( RCC_AHBPeriph_DMA1, ENABLE );
+		prvDMAChannelInit( xRxDMA, pxPort->xUSART, pxPort->pucRxBuf, pxPort->usRxSize, DMA_DIR_PeripheralSRC, DMA_Mode_Circular, DMA_IT_HT | DMA_IT_TC, xRxIRQ );
+		prvDMAChannelInit( xTxDMA, pxPort->xUSART, pxPort->pucTxBuf, 0, DMA_DIR_PeripheralDST, DMA_Mode_Normal, DMA_IT_TC, xTxIRQ );
+		USART_DMACmd( pxPort->xUSART, USART_DMAReq_Rx | USART_DMAReq_Tx, ENABLE );
+		DMA_Cmd( xRxDMA, ENABLE );
+	}
+	else
+	{
+		USART_ITConfig( pxPort->xUSART, USART_IT_RXNE, ENABLE );
+	}
+	USART_ITConfig( pxPort->xUSART, USART_IT_IDLE, ENABLE );
+
+	return ( xComPortHandle ) pxPort;
 }
 /*-----------------------------------------------------------*/
 
 signed portBASE_TYPE xSerialGetChar( xComPortHandle pxPort, signed portCHAR *pcRxedChar, portTickType xBlockTime )
 {
-	/* The port handle is not required as this driver only supports one port. */
-	//( void ) pxPort;
-
 	/* Get the next character from the buffer.  Return false if no characters
 	are available, or arrive before xBlockTime expires. */
-	if( xQueueReceive( pxPort->xRxedChars, pcRxedChar, xBlockTime ) )
+	if( prvRxCopy( pxPort, ( unsigned portCHAR * ) pcRxedChar, 1 ) == 1 )
 	{
 		return pdTRUE;
 	}
-	else
+	if( xSemaphoreTake( pxPort->xRxEvent, xBlockTime ) == pdTRUE )
 	{
-		return pdFALSE;
+		return ( prvRxCopy( pxPort, ( unsigned portCHAR * ) pcRxedChar, 1 ) == 1 ) ? pdTRUE : pdFALSE;
 	}
+	return pdFALSE;
 }
 
+/* Copy up to max_size bytes.  Returns once the buffer is full or no further
+data arrived within xBlockTime, as the byte queue version did. */
 signed portBASE_TYPE xSerialGet( xComPortHandle pxPort, unsigned portCHAR *pcBuf, portBASE_TYPE max_size, portTickType xBlockTime )
 {
 	portBASE_TYPE i = 0;
 
 	while( i < max_size ){
-		if( xQueueReceive( pxPort->xRxedChars, pcBuf+i, xBlockTime ) == pdFALSE )
+		i += prvRxCopy( pxPort, pcBuf+i, max_size-i );
+		if( i >= max_size )
+			break;
+		if( xSemaphoreTake( pxPort->xRxEvent, xBlockTime ) == pdFALSE ){
+			i += prvRxCopy( pxPort, pcBuf+i, max_size-i );
 			break;
-		i++;
+		}
 	}
 	return i;
 }
 
-signed portBASE_TYPE xSerialIsArrive( xComPortHandle pxPort )
+/* Return the longest contiguous run of received bytes without copying it.
+The bytes stay valid until vSerialReadSpanDone() releases them; a ring that
+is not drained in time is overwritten by the DMA. */
+unsigned portSHORT xSerialReadSpan( xComPortHandle pxPort, const unsigned portCHAR **ppucData, portTickType xBlockTime )
 {
-	signed portCHAR cRxedChar;
+unsigned portSHORT usHead = prvRxHead( pxPort );
+unsigned portSHORT usTail = pxPort->usRxTail;
 
-	if( xQueuePeek( pxPort->xRxedChars, &cRxedChar, 0 ) )
+	if( usHead == usTail )
+	{
+		if( xSemaphoreTake( pxPort->xRxEvent, xBlockTime ) == pdFALSE )
+		{
+			return 0;
+		}
+		usHead = prvRxHead( pxPort );
+	}
+
+	*ppucData = pxPort->pucRxBuf + usTail;
+	return ( usHead >= usTail ) ? ( usHead - usTail ) : ( pxPort->usRxSize - usTail );
+}
+
+void vSerialReadSpanDone( xComPortHandle pxPort, unsigned portSHORT usLength )
+{
+unsigned portSHORT usTail = pxPort->usRxTail + usLength;
+
+	if( usTail >= pxPort->usRxSize )
+	{
+		usTail -= pxPort->usRxSize;
+	}
+	pxPort->usRxTail = usTail;
+	pxPort->ulRxCount += usLength;
+}
+
+signed portBASE_TYPE xSerialIsArrive( xComPortHandle pxPort )
+{
+	if( prvRxHead( pxPort ) != pxPort->usRxTail )
 	{
 		return pdTRUE;
 	}
@@ -312,51 +511,58 @@ signed portBASE_TYPE xSerialIsArrive( xComPortHandle pxPort )
 /*-----------------------------------------------------------*/
 void vSerialPut( xComPortHandle pxPort, const unsigned portCHAR * const pcBuf, unsigned portSHORT usLength )
 {
-signed portSHORT i;
+unsigned portSHORT i, usHead, usNext;
 
-	/* NOTE: This implementation does not handle the queue being full as no
-	block time is used! */
-	for(i=0;i<usLength;i++)
+	/* NOTE: Bytes that do not fit in the ring are dropped, as no block time
+	is used! */
+	vTaskSuspendAll();
+	usHead = pxPort->usTxHead;
+	for( i = 0; i < usLength; i++ )
 	{
-		xSerialPutChar( pxPort, pcBuf[i], serNO_BLOCK );
+		usNext = usHead + 1;
+		if( usNext >= pxPort->usTxSize )
+		{
+			usNext = 0;
+		}
+		if( usNext == pxPort->usTxTail )
+		{
+			break;
+		}
+		pxPort->pucTxBuf[ usHead ] = pcBuf[ i ];
+		usHead = usNext;
 	}
+	pxPort->ulTxCount += i;
+
+	portENTER_CRITICAL();
+	pxPort->usTxHead = usHead;
+	prvTxStart( pxPort );
+	portEXIT_CRITICAL();
+	xTaskResumeAll();
 }
 
 void vSerialPutString( xComPortHandle pxPort, const unsigned portCHAR * const pcString, unsigned portSHORT usStringLength )
 {
-signed portCHAR *pxNext;
+const unsigned portCHAR *pxNext = pcString;
 
 	/* A couple of parameters that this port does not use. */
 	( void ) usStringLength;
 
-	/* NOTE: This implementation does not handle the queue being full as no
-	block time is used! */
-
-	/* Send each character in the string, one at a time. */
-	pxNext = ( signed portCHAR * ) pcString;
 	while( *pxNext )
 	{
-		xSerialPutChar( pxPort, *pxNext, serNO_BLOCK );
 		pxNext++;
 	}
+	vSerialPut( pxPort, pcString, pxNext - pcString );
 }
 /*-----------------------------------------------------------*/
 
 signed portBASE_TYPE xSerialPutChar( xComPortHandle pxPort, unsigned portCHAR cOutChar, portTickType xBlockTime )
 {
-signed portBASE_TYPE xReturn;
+unsigned portLONG ulCount = pxPort->ulTxCount;
 
-	if( xQueueSend( pxPort->xCharsForTx, &cOutChar, xBlockTime ) == pdPASS )
-	{
-		xReturn = pdPASS;
-		USART_ITConfig( pxPort->xUSART, USART_IT_TXE, ENABLE );
-	}
-	else
-	{
-		xReturn = pdFAIL;
-	}
+	( void ) xBlockTime;
 
-	return xReturn;
+	vSerialPut( pxPort, &cOutChar, 1 );
+	return ( pxPort->ulTxCount != ulCount ) ? pdPASS : pdFAIL;
 }
 /*-----------------------------------------------------------*/
 
@@ -365,107 +571,142 @@ void vSerialClose( xComPortHandle xPort )
 	/* Not supported as not required by the demo application. */
 }
 /*-----------------------------------------------------------*/
-#ifdef USE_USART1
-void USART1_IRQHandler( void )
+
+static void prvUSARTHandler( xComPort *pxPort, portBASE_TYPE *pxHigherPriorityTaskWoken )
 {
-portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
-portCHAR cChar;
+USART_TypeDef *xUSART = pxPort->xUSART;
+unsigned portCHAR cChar;
+unsigned portSHORT usNext;
 
-	if( USART_GetITStatus( USART1, USART_IT_TXE ) == SET )
+	pxPort->ulIrqCount++;
+
+	if( USART_GetITStatus( xUSART, USART_IT_TXE ) == SET )
 	{
-		/* The interrupt was caused by the THR becoming empty.  Are there any
-		more characters to transmit? */
-		if( xQueueReceiveFromISR( xPorts[serCOM1].xCharsForTx, &cChar, &xHigherPriorityTaskWoken ) == pdTRUE )
+		if( pxPort->usTxTail != pxPort->usTxHead )
 		{
-			/* A character was retrieved from the queue so can be sent to the
-			THR now. */
-			USART_SendData( USART1, cChar );
+			USART_SendData( xUSART, pxPort->pucTxBuf[ pxPort->usTxTail ] );
+			usNext = pxPort->usTxTail + 1;
+			pxPort->usTxTail = ( usNext >= pxPort->usTxSize ) ? 0 : usNext;
 		}
 		else
 		{
-			USART_ITConfig( USART1, USART_IT_TXE, DISABLE );		
-		}		
+			USART_ITConfig( xUSART, USART_IT_TXE, DISABLE );
+			pxPort->usTxSpan = 0;
+		}
 	}
-	
-	if( USART_GetITStatus( USART1, USART_IT_RXNE ) == SET )
-	{
-		cChar = USART_ReceiveData( USART1 );
-		xQueueSendFromISR( xPorts[serCOM1].xRxedChars, &cChar, &xHigherPriorityTaskWoken );
-	}	
-	
-	portEND_SWITCHING_ISR( xHigherPriorityTaskWoken );
-}
-#endif 
-
-#ifdef USE_USART2
-void USART2_IRQHandler( void )
-{
-portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
-portCHAR cChar;
 
-	if( USART_GetITStatus( USART2, USART_IT_TXE ) == SET )
+	if( USART_GetITStatus( xUSART, USART_IT_RXNE ) == SET )
 	{
-		/* The interrupt was caused by the THR becoming empty.  Are there any
-		more characters to transmit? */
-		if( xQueueReceiveFromISR( xPorts[serCOM2].xCharsForTx, &cChar, &xHigherPriorityTaskWoken ) == pdTRUE )
+		cChar = USART_ReceiveData( xUSART );
+		if( pxPort->pucRxBuf != 0 )
 		{
-			/* A character was retrieved from the queue so can be sent to the
-			THR now. */
-			USART_SendData( USART2, cChar );
+			usNext = pxPort->usRxHead + 1;
+			if( usNext >= pxPort->usRxSize )
+			{
+				usNext = 0;
+			}
+			if( usNext != pxPort->usRxTail )
+			{
+				pxPort->pucRxBuf[ pxPort->usRxHead ] = cChar;
+				pxPort->usRxHead = usNext;
+
+				/* Half full, wake the reader as the DMA HT does, a long
+				burst would overrun the ring before the idle line. */
+				if( ( ( usNext + pxPort->usRxSize - pxPort->usRxTail ) % pxPort->usRxSize ) == pxPort->usRxSize / 2 )
+				{
+					xSemaphoreGiveFromISR( pxPort->xRxEvent, pxHigherPriorityTaskWoken );
+				}
+			}
+			else
+			{
+				/* Ring full, wake the reader now rather than at idle. */
+				xSemaphoreGiveFromISR( pxPort->xRxEvent, pxHigherPriorityTaskWoken );
+			}
 		}
-		else
-		{
-			USART_ITConfig( USART2, USART_IT_TXE, DISABLE );		
-		}		
 	}
-	
-	if( USART_GetITStatus( USART2, USART_IT_RXNE ) == SET )
+
+	if( USART_GetITStatus( xUSART, USART_IT_IDLE ) == SET )
 	{
-		cChar = USART_ReceiveData( USART2 );
-		xQueueSendFromISR( xPorts[serCOM2].xRxedChars, &cChar, &xHigherPriorityTaskWoken );
-	}	
-	
-	portEND_SWITCHING_ISR( xHigherPriorityTaskWoken );
+		/* IDLE is cleared by reading SR then DR. */
+		( void ) USART_ReceiveData( xUSART );
+		xSemaphoreGiveFromISR( pxPort->xRxEvent, pxHigherPriorityTaskWoken );
+	}
 }
-#endif 
 
+static void prvRxDMAHandler( xComPort *pxPort, uint32_t ulFlags, portBASE_TYPE *pxHigherPriorityTaskWoken )
+{
+	pxPort->ulIrqCount++;
+	DMA_ClearITPendingBit( ulFlags );
+	xSemaphoreGiveFromISR( pxPort->xRxEvent, pxHigherPriorityTaskWoken );
+}
 
-#ifdef USE_USART3
-void USART3_IRQHandler( void )
+static void prvTxDMAHandler( xComPort *pxPort, uint32_t ulFlags )
+{
+unsigned portSHORT usTail;
+
+	pxPort->ulIrqCount++;
+	DMA_ClearITPendingBit( ulFlags );
+
+	usTail = pxPort->usTxTail + pxPort->usTxSpan;
+	pxPort->usTxTail = ( usTail >= pxPort->usTxSize ) ? ( usTail - pxPort->usTxSize ) : usTail;
+	pxPort->usTxSpan = 0;
+	prvTxStart( pxPort );
+}
+/*-----------------------------------------------------------*/
+
+#ifdef USE_USART1
+void USART1_IRQHandler( void )
 {
 portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
-portCHAR cChar;
 
-	if( USART_GetITStatus( USART3, USART_IT_TXE ) == SET )
-	{
-		/* The interrupt was caused by the THR becoming empty.  Are there any
-		more characters to transmit? */
-		if( xQueueReceiveFromISR( xPorts[serCOM3].xCharsForTx, &cChar, &xHigherPriorityTaskWoken ) == pdTRUE )
-		{
-			/* A character was retrieved from the queue so can be sent to the
-			THR now. */
-			USART_SendData( USART3, cChar );
-		}
-		else
-		{
-			USART_ITConfig( USART3, USART_IT_TXE, DISABLE );		
-		}		
-	}
-	
-	if( USART_GetITStatus( USART3, USART_IT_RXNE ) == SET )
-	{
-		cChar = USART_ReceiveData( USART3 );
-		xQueueSendFromISR( xPorts[serCOM3].xRxedChars, &cChar, &xHigherPriorityTaskWoken );
-	}	
-	
+	prvUSARTHandler( &xPorts[serCOM1], &xHigherPriorityTaskWoken );
 	portEND_SWITCHING_ISR( xHigherPriorityTaskWoken );
 }
+
+void DMA1_Channel5_IRQHandler( void )
+{
+portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+
+	prvRxDMAHandler( &xPorts[serCOM1], DMA1_IT_GL5, &xHigherPriorityTaskWoken );
+	portEND_SWITCHING_ISR( xHigherPriorityTaskWoken );
+}
+
+void DMA1_Channel4_IRQHandler( void )
+{
+	prvTxDMAHandler( &xPorts[serCOM1], DMA1_IT_GL4 );
+}
 #endif 
 
+#ifdef USE_USART2
+void USART2_IRQHandler( void )
+{
+portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
 
+	prvUSARTHandler( &xPorts[serCOM2], &xHigherPriorityTaskWoken );
+	portEND_SWITCHING_ISR( xHigherPriorityTaskWoken );
+}
 
+void DMA1_Channel6_IRQHandler( void )
+{
+portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
 
+	prvRxDMAHandler( &xPorts[serCOM2], DMA1_IT_GL6, &xHigherPriorityTaskWoken );
+	portEND_SWITCHING_ISR( xHigherPriorityTaskWoken );
+}
 
+void DMA1_Channel7_IRQHandler( void )
+{
+	prvTxDMAHandler( &xPorts[serCOM2], DMA1_IT_GL7 );
+}
+#endif 
 
 
-	
+#ifdef USE_USART3
+void USART3_IRQHandler( void )
+{
+portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+
+	prvUSARTHandler( &xPorts[serCOM3], &xHigherPriorityTaskWoken );
+	portEND_SWITCHING_ISR( xHigherPriorityTaskWoken );
+}
+#endif
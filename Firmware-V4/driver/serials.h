@@ -56,14 +56,30 @@
 
 #include "FreeRTOS.h"
 #include "queue.h"
+#include "semphr.h"
 
 #include "stm32f10x.h"
 
 typedef struct 
 {
 	USART_TypeDef* xUSART;
-	xQueueHandle xRxedChars;
-	xQueueHandle xCharsForTx;
+	DMA_Channel_TypeDef* xRxDMA;			// 0 if fed by RXNE
+	DMA_Channel_TypeDef* xTxDMA;			// 0 if drained by TXE
+	unsigned portCHAR* pucRxBuf;
+	unsigned portCHAR* pucTxBuf;
+	unsigned portSHORT usRxSize;
+	unsigned portSHORT usTxSize;
+	volatile unsigned portSHORT usRxHead;	// RXNE mode only, DMA mode reads CNDTR
+	volatile unsigned portSHORT usRxTail;
+	volatile unsigned portSHORT usTxHead;
+	volatile unsigned portSHORT usTxTail;
+	volatile unsigned portSHORT usTxSpan;	// bytes in flight, 0 when idle
+	xSemaphoreHandle xRxEvent;				// given on idle line, DMA HT/TC, full ring
+
+	// statistics, interrupts per KB = ulIrqCount * 1024 / (ulRxCount + ulTxCount)
+	volatile unsigned portLONG ulIrqCount;
+	unsigned portLONG ulRxCount;
+	unsigned portLONG ulTxCount;
 } xComPort;
 
 typedef xComPort * xComPortHandle;
@@ -132,6 +148,8 @@ void vSerialPut( xComPortHandle pxPort, const unsigned portCHAR * const pcBuf, u
 signed portBASE_TYPE xSerialIsArrive( xComPortHandle pxPort );
 signed portBASE_TYPE xSerialGetChar( xComPortHandle pxPort, signed char *pcRxedChar, portTickType xBlockTime );
 signed portBASE_TYPE xSerialGet( xComPortHandle pxPort, unsigned portCHAR *pcBuf, portBASE_TYPE max_size, portTickType xBlockTime );
+unsigned portSHORT xSerialReadSpan( xComPortHandle pxPort, const unsigned portCHAR **ppucData, portTickType xBlockTime );
+void vSerialReadSpanDone( xComPortHandle pxPort, unsigned portSHORT usLength );
 signed portBASE_TYPE xSerialPutChar( xComPortHandle pxPort, unsigned char cOutChar, portTickType xBlockTime );
 portBASE_TYPE xSerialWaitForSemaphore( xComPortHandle xPort );
 void vSerialClose( xComPortHandle xPort );
@@ -128,12 +128,16 @@ typedef enum
     STATE_NOT_INITIALIZED
 } eMBCTRLState;
 
+#include "mbconfig.h"
 #include "mbframe.h"
 
-typedef struct 
+/* Everything one Modbus instance needs. Instances share nothing but the
+ * register callbacks, so RTU and TCP slaves can be polled side by side. */
+typedef struct sMBControl_s
 {
 	eMBMode			eMBCurrentMode;
 	UCHAR    		ucMBAddress;
+	UCHAR			ucPort;				/* serial port, RTU/ASCII only */
 	eMBCTRLState	eMBState;
 	xQueueHandle	xMBEventQueue;
 	pvMBFrameStart 	pvMBFrameStartCur;
@@ -141,9 +145,21 @@ typedef struct
 	peMBFrameSend	peMBFrameSendCur;
 	peMBFrameReceive peMBFrameReceiveCur;
 	pvMBFrameClose 	pvMBFrameCloseCur;
-//	BOOL( *pxMBFrameCBByteReceived ) ( void );
-//	BOOL( *pxMBFrameCBTransmitterEmpty ) ( void );
-//	BOOL( *pxMBPortCBTimerExpired ) ( void );
+	pxMBFrameCB		pxMBFrameCBByteReceived;
+	pxMBFrameCB		pxMBFrameCBTransmitterEmpty;
+	pxMBFrameCB		pxMBPortCBTimerExpired;
+
+	/* The request being served, kept from EV_FRAME_RECEIVED to EV_EXECUTE. */
+	UCHAR		   *pucMBFrame;
+	UCHAR			ucRcvAddress;
+	UCHAR			ucFunctionCode;
+	USHORT			usLength;
+	eMBException	eException;
+
+	xMBFunctionHandler xFuncHandlers[MB_FUNC_HANDLERS_MAX];
+	/* Slot in xFuncHandlers plus one for each function code, 0 if none. */
+	UCHAR			ucFuncIndex[MB_FUNC_CODES];
+	sMBSerialFrame	xSerial;
 } sMBControl;
 
 
@@ -270,12 +286,14 @@ eMBErrorCode    eMBSetSlaveID( UCHAR ucSlaveID, BOOL xIsRunning,
 /*! \ingroup modbus
  * \brief Registers a callback handler for a given function code.
  *
- * This function registers a new callback handler for a given function code.
+ * This function registers a new callback handler for a given function code
+ * in the handler table of one instance.
  * The callback handler supplied is responsible for interpreting the Modbus PDU and
  * the creation of an appropriate response. In case of an error it should return
  * one of the possible Modbus exceptions which results in a Modbus exception frame
  * sent by the protocol stack. 
  *
+ * \param sMBC The instance the handler is registered for.
  * \param ucFunctionCode The Modbus function code for which this handler should
  *   be registers. Valid function codes are in the range 1 to 127.
  * \param pxHandler The function handler which should be called in case
@@ -287,9 +305,26 @@ eMBErrorCode    eMBSetSlaveID( UCHAR ucSlaveID, BOOL xIsRunning,
  *   case the values in mbconfig.h should be adjusted. If the argument was not
  *   valid it returns eMBErrorCode::MB_EINVAL.
  */
-eMBErrorCode    eMBRegisterCB( UCHAR ucFunctionCode, 
+eMBErrorCode    eMBRegisterCB( sMBControl* sMBC, UCHAR ucFunctionCode, 
                                pxMBFunctionHandler pxHandler );
 
+/*! \ingroup modbus
+ * \brief Run the registered handler for a Modbus PDU.
+ *
+ * The handler answers in place, so the buffer must have room for a
+ * response of MB_PDU_SIZE_MAX bytes. It does not build the exception
+ * frame; the caller does that if the request was not a broadcast.
+ *
+ * \param sMBC The instance whose handler table is used.
+ * \param pucFrame The PDU, starting with the function code.
+ * \param pusLength Length of the request in, of the response out.
+ *
+ * \return eMBException::MB_EX_NONE on success,
+ *   eMBException::MB_EX_ILLEGAL_FUNCTION if no handler is registered,
+ *   otherwise the exception returned by the handler.
+ */
+eMBException    eMBFuncExecute( sMBControl* sMBC, UCHAR * pucFrame, USHORT * pusLength );
+
 /* ----------------------- Callback -----------------------------------------*/
 
 /*! \defgroup modbus_registers Modbus Registers
@@ -66,20 +66,45 @@ PR_BEGIN_EXTERN_C
 #define MB_PDU_FUNC_OFF     0   /*!< Offset of function code in PDU. */
 #define MB_PDU_DATA_OFF     1   /*!< Offset for response data in PDU. */
 
+#define MB_SER_PDU_SIZE_MAX 256 /*!< Maximum size of a serial line frame. */
+
+/* ----------------------- Type definitions ---------------------------------*/
+struct sMBControl_s;
+
+/*! \brief State of a serial line frame layer.
+ *
+ * Every Modbus instance carries its own copy, so several serial slaves
+ * can receive and send at the same time.
+ */
+typedef struct
+{
+    volatile UCHAR  eRcvState;          /*!< Receiver state of the frame layer. */
+    volatile UCHAR  eSndState;          /*!< Transmitter state of the frame layer. */
+    volatile USHORT usRcvBufferPos;
+    volatile USHORT usRcvCRC16;         /*!< CRC of the bytes received so far. */
+    volatile UCHAR *pucSndBufferCur;
+    volatile USHORT usSndBufferCount;
+    volatile UCHAR  ucBuf[MB_SER_PDU_SIZE_MAX];
+} sMBSerialFrame;
+
 /* ----------------------- Prototypes  0-------------------------------------*/
-typedef void    ( *pvMBFrameStart ) ( void );
+typedef void    ( *pvMBFrameStart ) ( struct sMBControl_s * sMBC );
 
-typedef void    ( *pvMBFrameStop ) ( void );
+typedef void    ( *pvMBFrameStop ) ( struct sMBControl_s * sMBC );
 
-typedef eMBErrorCode( *peMBFrameReceive ) ( UCHAR * pucRcvAddress,
+typedef eMBErrorCode( *peMBFrameReceive ) ( struct sMBControl_s * sMBC,
+                                            UCHAR * pucRcvAddress,
                                             UCHAR ** pucFrame,
                                             USHORT * pusLength );
 
-typedef eMBErrorCode( *peMBFrameSend ) ( UCHAR slaveAddress,
+typedef eMBErrorCode( *peMBFrameSend ) ( struct sMBControl_s * sMBC,
+                                         UCHAR slaveAddress,
                                          const UCHAR * pucFrame,
                                          USHORT usLength );
 
-typedef void( *pvMBFrameClose ) ( void );
+typedef void( *pvMBFrameClose ) ( struct sMBControl_s * sMBC );
+
+typedef BOOL( *pxMBFrameCB ) ( struct sMBControl_s * sMBC );
 
 #ifdef __cplusplus
 PR_END_EXTERN_C
@@ -71,58 +71,51 @@ BOOL            xMBPortEventGet( xQueueHandle queue, eMBEventType * eEvent );
 void            vMBPortEventClose( xQueueHandle queue );
 
 /* ----------------------- Serial port functions ----------------------------*/
-extern xQueueHandle xMBSerialEventQueue;
+struct sMBControl_s;
 
-BOOL            xMBPortSerialInit( UCHAR ucPort, ULONG ulBaudRate,
-                                   UCHAR ucDataBits, eMBParity eParity );
+/* The serial and timer functions take the port index given to eMBInit( ).
+ * xMBPortSerialInit( ) binds the port to its instance, the port interrupts
+ * then call the frame callbacks of that instance.
+ */
+BOOL            xMBPortSerialInit( struct sMBControl_s * sMBC, UCHAR ucPort,
+                                   ULONG ulBaudRate, UCHAR ucDataBits,
+                                   eMBParity eParity );
 
-void            vMBPortClose( void );
+void            vMBPortClose( struct sMBControl_s * sMBC );
 
-void            xMBPortSerialClose( void );
+void            xMBPortSerialClose( UCHAR ucPort );
 
-void            vMBPortSerialEnable( BOOL xRxEnable, BOOL xTxEnable );
+void            vMBPortSerialEnable( UCHAR ucPort, BOOL xRxEnable, BOOL xTxEnable );
 
-BOOL            xMBPortSerialGetByte( CHAR * pucByte );
+BOOL            xMBPortSerialGetByte( UCHAR ucPort, CHAR * pucByte );
 
-BOOL            xMBPortSerialPutByte( CHAR ucByte );
+BOOL            xMBPortSerialPutByte( UCHAR ucPort, CHAR ucByte );
 
 /* ----------------------- Timers functions ---------------------------------*/
-BOOL            xMBPortTimersInit( USHORT usTimeOut50us );
+BOOL            xMBPortTimersInit( struct sMBControl_s * sMBC, USHORT usTimeOut50us );
 
-void            xMBPortTimersClose( void );
+void            xMBPortTimersClose( UCHAR ucPort );
 
-void            vMBPortTimersEnable( void );
+void            vMBPortTimersEnable( UCHAR ucPort );
 
-void            vMBPortTimersDisable( void );
+void            vMBPortTimersDisable( UCHAR ucPort );
 
 void            vMBPortTimersDelay( USHORT usTimeOutMS );
 
 /* ----------------------- Callback for the protocol stack ------------------*/
 
-/*!
- * \brief Callback function for the porting layer when a new byte is
- *   available.
- *
- * Depending upon the mode this callback function is used by the RTU or
- * ASCII transmission layers. In any case a call to xMBPortSerialGetByte()
- * must immediately return a new character.
- *
- * \return <code>TRUE</code> if a event was posted to the queue because
- *   a new byte was received. The port implementation should wake up the
- *   tasks which are currently blocked on the eventqueue.
+/* The frame callbacks live in sMBControl: pxMBFrameCBByteReceived when a
+ * new byte is available ( a call to xMBPortSerialGetByte( ) must then
+ * return it immediately ), pxMBFrameCBTransmitterEmpty when the next byte
+ * can be sent and pxMBPortCBTimerExpired when the port timer fires. They
+ * return <code>TRUE</code> if an event was posted and the port should wake
+ * up the task blocked on the event queue.
  */
-extern          BOOL( *pxMBFrameCBByteReceived ) ( void );
-
-extern          BOOL( *pxMBFrameCBTransmitterEmpty ) ( void );
-
-extern          BOOL( *pxMBPortCBTimerExpired ) ( void );
 
 /* ----------------------- TCP port functions -------------------------------*/
-extern xQueueHandle xMBTCPEventQueue;
-
 BOOL            xMBTCPPortInit( USHORT usTCPPort );
 
-void            vMBTCPPortClose( void );
+void            vMBTCPPortClose( struct sMBControl_s * sMBC );
 
 void            vMBTCPPortDisable( void );
 
@@ -54,6 +54,7 @@ PR_BEGIN_EXTERN_C
 #define MB_FUNC_DIAG_GET_COM_EVENT_LOG        ( 12 )
 #define MB_FUNC_OTHER_REPORT_SLAVEID          ( 17 )
 #define MB_FUNC_ERROR                         ( 128 )
+#define MB_FUNC_CODES                         ( 128 ) /*! Function codes 1..127. */
 /* ----------------------- Type definitions ---------------------------------*/
     typedef enum
 {
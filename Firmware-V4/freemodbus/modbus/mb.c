@@ -77,22 +77,11 @@ static pvMBFrameStop 	pvMBFrameStopCur;
 static peMBFrameReceive peMBFrameReceiveCur;
 static pvMBFrameClose 	pvMBFrameCloseCur;
 */
-/* Callback functions required by the porting layer. They are called when
- * an external event has happend which includes a timeout or the reception
- * or transmission of a character.
+/* The default Modbus functions handlers which associates Modbus function
+ * codes with implementing functions. Every instance starts with a copy and
+ * may change its own with eMBRegisterCB( ).
  */
-
-BOOL( *pxMBFrameCBByteReceived ) ( void );
-BOOL( *pxMBFrameCBTransmitterEmpty ) ( void );
-BOOL( *pxMBPortCBTimerExpired ) ( void );
-
-BOOL( *pxMBFrameCBReceiveFSMCur ) ( void );
-BOOL( *pxMBFrameCBTransmitFSMCur ) ( void );
-
-/* An array of Modbus functions handlers which associates Modbus function
- * codes with implementing functions.
- */
-static xMBFunctionHandler xFuncHandlers[MB_FUNC_HANDLERS_MAX] = {
+static const xMBFunctionHandler xFuncHandlersDefault[MB_FUNC_HANDLERS_MAX] = {
 #if MB_FUNC_OTHER_REP_SLAVEID_ENABLED > 0
     {MB_FUNC_OTHER_REPORT_SLAVEID, eMBFuncReportSlaveID},
 #endif
@@ -125,6 +114,26 @@ static xMBFunctionHandler xFuncHandlers[MB_FUNC_HANDLERS_MAX] = {
 #endif
 };
 
+/* ----------------------- Static functions ---------------------------------*/
+static void
+prvvMBInstanceInit( sMBControl* sMBC )
+{
+    int             i;
+
+    memcpy( sMBC->xFuncHandlers, xFuncHandlersDefault, sizeof( sMBC->xFuncHandlers ) );
+    memset( sMBC->ucFuncIndex, 0, sizeof( sMBC->ucFuncIndex ) );
+    for( i = 0; i < MB_FUNC_HANDLERS_MAX; i++ )
+    {
+        if( sMBC->xFuncHandlers[i].pxHandler != NULL )
+        {
+            sMBC->ucFuncIndex[sMBC->xFuncHandlers[i].ucFunctionCode] = ( UCHAR )( i + 1 );
+        }
+    }
+    sMBC->pucMBFrame = NULL;
+    sMBC->usLength = 0;
+    sMBC->eException = MB_EX_NONE;
+}
+
 /* ----------------------- Start implementation -----------------------------*/
 eMBErrorCode
 eMBInit( sMBControl* sMBC, eMBMode eMode, UCHAR ucSlaveAddress, UCHAR ucPort, ULONG ulBaudRate, eMBParity eParity )
@@ -139,6 +148,8 @@ eMBInit( sMBControl* sMBC, eMBMode eMode, UCHAR ucSlaveAddress, UCHAR ucPort, UL
     }
     else
     {
+        prvvMBInstanceInit( sMBC );
+        sMBC->ucMBAddress = ucSlaveAddress;
         switch ( eMode )
         {
 #if MB_RTU_ENABLED > 0
@@ -148,11 +159,11 @@ eMBInit( sMBControl* sMBC, eMBMode eMode, UCHAR ucSlaveAddress, UCHAR ucPort, UL
             sMBC->peMBFrameSendCur		= eMBRTUSend;
             sMBC->peMBFrameReceiveCur	= eMBRTUReceive;
             sMBC->pvMBFrameCloseCur		= MB_PORT_HAS_CLOSE ? vMBPortClose : NULL;
-            pxMBFrameCBByteReceived		= xMBRTUReceiveFSM;
-            pxMBFrameCBTransmitterEmpty	= xMBRTUTransmitFSM;
-            pxMBPortCBTimerExpired 		= xMBRTUTimerT35Expired;
+            sMBC->pxMBFrameCBByteReceived		= xMBRTUReceiveFSM;
+            sMBC->pxMBFrameCBTransmitterEmpty	= xMBRTUTransmitFSM;
+            sMBC->pxMBPortCBTimerExpired 		= xMBRTUTimerT35Expired;
 
-            eStatus = eMBRTUInit( sMBC->ucMBAddress, ucPort, ulBaudRate, eParity );
+            eStatus = eMBRTUInit( sMBC, sMBC->ucMBAddress, ucPort, ulBaudRate, eParity );
             break;
 #endif
 #if MB_ASCII_ENABLED > 0
@@ -162,9 +173,9 @@ eMBInit( sMBControl* sMBC, eMBMode eMode, UCHAR ucSlaveAddress, UCHAR ucPort, UL
             sMBC->peMBFrameSendCur		= eMBASCIISend;
             sMBC->peMBFrameReceiveCur	= eMBASCIIReceive;
             sMBC->pvMBFrameCloserCur	= MB_PORT_HAS_CLOSE ? vMBPortClose : NULL;
-            pxMBFrameCBByteReceived		= xMBASCIIReceiveFSM;
-            pxMBFrameCBTransmitterEmpty = xMBASCIITransmitFSM;
-            pxMBPortCBTimerExpired 		= xMBASCIITimerT1SExpired;
+            sMBC->pxMBFrameCBByteReceived		= xMBASCIIReceiveFSM;
+            sMBC->pxMBFrameCBTransmitterEmpty = xMBASCIITransmitFSM;
+            sMBC->pxMBPortCBTimerExpired 		= xMBASCIITimerT1SExpired;
 
             eStatus = eMBASCIIInit( sMBC->ucMBAddress, ucPort, ulBaudRate, eParity );
             break;
@@ -182,8 +193,6 @@ eMBInit( sMBControl* sMBC, eMBMode eMode, UCHAR ucSlaveAddress, UCHAR ucPort, UL
             }
             else
             {
-				xMBSerialEventQueue		= sMBC->xMBEventQueue;
-				sMBC->ucMBAddress 		= ucSlaveAddress;
                 sMBC->eMBCurrentMode 	= eMode;
                 sMBC->eMBState 			= STATE_DISABLED;
             }
@@ -198,6 +207,7 @@ eMBTCPInit( sMBControl* sMBC, USHORT ucTCPPort )
 {
     eMBErrorCode    eStatus = MB_ENOERR;
 
+    prvvMBInstanceInit( sMBC );
     if( ( eStatus = eMBTCPDoInit( ucTCPPort ) ) != MB_ENOERR )
     {
         sMBC->eMBState = STATE_DISABLED;
@@ -217,14 +227,13 @@ eMBTCPInit( sMBControl* sMBC, USHORT ucTCPPort )
         sMBC->ucMBAddress 			= MB_TCP_PSEUDO_ADDRESS;
         sMBC->eMBCurrentMode		= MB_TCP;
         sMBC->eMBState 				= STATE_DISABLED;
-		xMBTCPEventQueue			= sMBC->xMBEventQueue;
     }
     return eStatus;
 }
 #endif
 
 eMBErrorCode
-eMBRegisterCB( UCHAR ucFunctionCode, pxMBFunctionHandler pxHandler )
+eMBRegisterCB( sMBControl* sMBC, UCHAR ucFunctionCode, pxMBFunctionHandler pxHandler )
 {
     int             i;
     eMBErrorCode    eStatus;
@@ -232,30 +241,39 @@ eMBRegisterCB( UCHAR ucFunctionCode, pxMBFunctionHandler pxHandler )
     if( ( 0 < ucFunctionCode ) && ( ucFunctionCode <= 127 ) )
     {
         ENTER_CRITICAL_SECTION(  );
+        i = sMBC->ucFuncIndex[ucFunctionCode] - 1;
         if( pxHandler != NULL )
         {
-            for( i = 0; i < MB_FUNC_HANDLERS_MAX; i++ )
+            /* A code that is already registered keeps its slot. */
+            if( i < 0 )
             {
-                if( ( xFuncHandlers[i].pxHandler == NULL ) ||
-                    ( xFuncHandlers[i].pxHandler == pxHandler ) )
+                for( i = 0; i < MB_FUNC_HANDLERS_MAX; i++ )
                 {
-                    xFuncHandlers[i].ucFunctionCode = ucFunctionCode;
-                    xFuncHandlers[i].pxHandler = pxHandler;
-                    break;
+                    if( sMBC->xFuncHandlers[i].pxHandler == NULL )
+                    {
+                        break;
+                    }
                 }
             }
-            eStatus = ( i != MB_FUNC_HANDLERS_MAX ) ? MB_ENOERR : MB_ENORES;
+            if( i != MB_FUNC_HANDLERS_MAX )
+            {
+                sMBC->xFuncHandlers[i].ucFunctionCode = ucFunctionCode;
+                sMBC->xFuncHandlers[i].pxHandler = pxHandler;
+                sMBC->ucFuncIndex[ucFunctionCode] = ( UCHAR )( i + 1 );
+                eStatus = MB_ENOERR;
+            }
+            else
+            {
+                eStatus = MB_ENORES;
+            }
         }
         else
         {
-            for( i = 0; i < MB_FUNC_HANDLERS_MAX; i++ )
+            if( i >= 0 )
             {
-                if( xFuncHandlers[i].ucFunctionCode == ucFunctionCode )
-                {
-                    xFuncHandlers[i].ucFunctionCode = 0;
-                    xFuncHandlers[i].pxHandler = NULL;
-                    break;
-                }
+                sMBC->xFuncHandlers[i].ucFunctionCode = 0;
+                sMBC->xFuncHandlers[i].pxHandler = NULL;
+                sMBC->ucFuncIndex[ucFunctionCode] = 0;
             }
             /* Remove can't fail. */
             eStatus = MB_ENOERR;
@@ -269,6 +287,20 @@ eMBRegisterCB( UCHAR ucFunctionCode, pxMBFunctionHandler pxHandler )
     return eStatus;
 }
 
+eMBException
+eMBFuncExecute( sMBControl* sMBC, UCHAR * pucFrame, USHORT * pusLength )
+{
+    UCHAR           ucFunctionCode = pucFrame[MB_PDU_FUNC_OFF];
+    UCHAR           ucSlot;
+
+    /* Direct lookup by code, codes with the error bit set never match. */
+    if( ( ucFunctionCode < MB_FUNC_CODES ) &&
+        ( ( ucSlot = sMBC->ucFuncIndex[ucFunctionCode] ) != 0 ) )
+    {
+        return sMBC->xFuncHandlers[ucSlot - 1].pxHandler( pucFrame, pusLength );
+    }
+    return MB_EX_ILLEGAL_FUNCTION;
+}
 
 eMBErrorCode
 eMBClose( sMBControl* sMBC )
@@ -279,7 +311,7 @@ eMBClose( sMBControl* sMBC )
     {
         if( sMBC->pvMBFrameCloseCur != NULL )
         {
-            sMBC->pvMBFrameCloseCur(  );
+            sMBC->pvMBFrameCloseCur( sMBC );
         }
     }
     else
@@ -297,7 +329,7 @@ eMBEnable( sMBControl* sMBC )
     if( sMBC->eMBState == STATE_DISABLED )
     {
         /* Activate the protocol stack. */
-        sMBC->pvMBFrameStartCur(  );
+        sMBC->pvMBFrameStartCur( sMBC );
         sMBC->eMBState = STATE_ENABLED;
     }
     else
@@ -314,7 +346,7 @@ eMBDisable( sMBControl* sMBC )
 
     if( sMBC->eMBState == STATE_ENABLED )
     {
-        sMBC->pvMBFrameStopCur(  );
+        sMBC->pvMBFrameStopCur( sMBC );
         sMBC->eMBState = STATE_DISABLED;
         eStatus = MB_ENOERR;
     }
@@ -332,13 +364,6 @@ eMBDisable( sMBControl* sMBC )
 eMBErrorCode
 eMBPoll( sMBControl* sMBC )
 {
-    static UCHAR   *ucMBFrame;
-    static UCHAR    ucRcvAddress;
-    static UCHAR    ucFunctionCode;
-    static USHORT   usLength;
-    static eMBException eException;
-
-    int             i;
     eMBErrorCode    eStatus = MB_ENOERR;
     eMBEventType    eEvent;
 
@@ -358,11 +383,11 @@ eMBPoll( sMBControl* sMBC )
             break;
 
         case EV_FRAME_RECEIVED:
-            eStatus = sMBC->peMBFrameReceiveCur( &ucRcvAddress, &ucMBFrame, &usLength );
+            eStatus = sMBC->peMBFrameReceiveCur( sMBC, &sMBC->ucRcvAddress, &sMBC->pucMBFrame, &sMBC->usLength );
             if( eStatus == MB_ENOERR )
             {
                 /* Check if the frame is for us. If not ignore the frame. */
-                if( ( ucRcvAddress == sMBC->ucMBAddress ) || ( ucRcvAddress == MB_ADDRESS_BROADCAST ) )
+                if( ( sMBC->ucRcvAddress == sMBC->ucMBAddress ) || ( sMBC->ucRcvAddress == MB_ADDRESS_BROADCAST ) )
                 {
                     ( void )xMBPortEventPost( sMBC->xMBEventQueue, EV_EXECUTE );
                 }
@@ -370,38 +395,25 @@ eMBPoll( sMBControl* sMBC )
             break;
 
         case EV_EXECUTE:
-            ucFunctionCode = ucMBFrame[MB_PDU_FUNC_OFF];
-            eException = MB_EX_ILLEGAL_FUNCTION;
-            for( i = 0; i < MB_FUNC_HANDLERS_MAX; i++ )
-            {
-                /* No more function handlers registered. Abort. */
-                if( xFuncHandlers[i].ucFunctionCode == 0 )
-                {
-                    break;
-                }
-                else if( xFuncHandlers[i].ucFunctionCode == ucFunctionCode )
-                {
-                    eException = xFuncHandlers[i].pxHandler( ucMBFrame, &usLength );
-                    break;
-                }
-            }
+            sMBC->ucFunctionCode = sMBC->pucMBFrame[MB_PDU_FUNC_OFF];
+            sMBC->eException = eMBFuncExecute( sMBC, sMBC->pucMBFrame, &sMBC->usLength );
 
             /* If the request was not sent to the broadcast address we
              * return a reply. */
-            if( ucRcvAddress != MB_ADDRESS_BROADCAST )
+            if( sMBC->ucRcvAddress != MB_ADDRESS_BROADCAST )
             {
-                if( eException != MB_EX_NONE )
+                if( sMBC->eException != MB_EX_NONE )
                 {
                     /* An exception occured. Build an error frame. */
-                    usLength = 0;
-                    ucMBFrame[usLength++] = ( UCHAR )( ucFunctionCode | MB_FUNC_ERROR );
-                    ucMBFrame[usLength++] = eException;
+                    sMBC->usLength = 0;
+                    sMBC->pucMBFrame[sMBC->usLength++] = ( UCHAR )( sMBC->ucFunctionCode | MB_FUNC_ERROR );
+                    sMBC->pucMBFrame[sMBC->usLength++] = sMBC->eException;
                 }
                 if( ( sMBC->eMBCurrentMode == MB_ASCII ) && MB_ASCII_TIMEOUT_WAIT_BEFORE_SEND_MS )
                 {
                     vMBPortTimersDelay( MB_ASCII_TIMEOUT_WAIT_BEFORE_SEND_MS );
                 }                
-                eStatus = sMBC->peMBFrameSendCur( sMBC->ucMBAddress, ucMBFrame, usLength );
+                eStatus = sMBC->peMBFrameSendCur( sMBC, sMBC->ucMBAddress, sMBC->pucMBFrame, sMBC->usLength );
             }
             break;
 
@@ -31,6 +31,23 @@
 #ifndef _MB_CRC_H
 #define _MB_CRC_H
 
+/* ----------------------- Defines ------------------------------------------*/
+#define MB_CRC16_INIT           ( 0xFFFF )
+
+/* Fold one byte into a running CRC. Cheap enough for the receive ISR. */
+#define MB_CRC16_BYTE( usCRC, ucByte ) \
+    ( ( USHORT )( ( ( usCRC ) >> 8 ) ^ ausMBCRC16Table[0][( ( usCRC ) ^ ( ucByte ) ) & 0xFF] ) )
+
+/* ----------------------- Variables ----------------------------------------*/
+extern const USHORT ausMBCRC16Table[4][256];
+
+/* ----------------------- Function prototypes ------------------------------*/
+
+/* Continue a CRC over usLen more bytes. Start with MB_CRC16_INIT; a frame
+ * that carries its own CRC (low byte first) folds to 0.
+ */
+USHORT          usMBCRC16Update( USHORT usCRC, const UCHAR * pucFrame, USHORT usLen );
+
 USHORT          usMBCRC16( UCHAR * pucFrame, USHORT usLen );
 
 #endif
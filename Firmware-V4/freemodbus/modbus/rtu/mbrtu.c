@@ -48,7 +48,6 @@
 
 /* ----------------------- Defines ------------------------------------------*/
 #define MB_SER_PDU_SIZE_MIN     4       /*!< Minimum size of a Modbus RTU frame. */
-#define MB_SER_PDU_SIZE_MAX     256     /*!< Maximum size of a Modbus RTU frame. */
 #define MB_SER_PDU_SIZE_CRC     2       /*!< Size of CRC field in PDU. */
 #define MB_SER_PDU_ADDR_OFF     0       /*!< Offset of slave address in Ser-PDU. */
 #define MB_SER_PDU_PDU_OFF      1       /*!< Offset of Modbus-PDU in Ser-PDU. */
@@ -68,21 +67,9 @@ typedef enum
     STATE_TX_XMIT               /*!< Transmitter is in transfer state. */
 } eMBSndState;
 
-/* ----------------------- Static variables ---------------------------------*/
-static volatile eMBSndState eSndState;
-static volatile eMBRcvState eRcvState;
-
-volatile UCHAR  ucRTUBuf[MB_SER_PDU_SIZE_MAX];
-
-static volatile UCHAR *pucSndBufferCur;
-static volatile USHORT usSndBufferCount;
-
-static volatile USHORT usRcvBufferPos;
-
-xQueueHandle xMBSerialEventQueue;
 /* ----------------------- Start implementation -----------------------------*/
 eMBErrorCode
-eMBRTUInit( UCHAR ucSlaveAddress, UCHAR ucPort, ULONG ulBaudRate, eMBParity eParity )
+eMBRTUInit( sMBControl * sMBC, UCHAR ucSlaveAddress, UCHAR ucPort, ULONG ulBaudRate, eMBParity eParity )
 {
     eMBErrorCode    eStatus = MB_ENOERR;
     ULONG           usTimerT35_50us;
@@ -91,7 +78,10 @@ eMBRTUInit( UCHAR ucSlaveAddress, UCHAR ucPort, ULONG ulBaudRate, eMBParity ePar
     ENTER_CRITICAL_SECTION(  );
 
     /* Modbus RTU uses 8 Databits. */
-    if( xMBPortSerialInit( ucPort, ulBaudRate, 8, eParity ) != TRUE )
+    sMBC->ucPort = ucPort;
+    sMBC->xSerial.eRcvState = STATE_RX_INIT;
+    sMBC->xSerial.eSndState = STATE_TX_IDLE;
+    if( xMBPortSerialInit( sMBC, ucPort, ulBaudRate, 8, eParity ) != TRUE )
     {
         eStatus = MB_EPORTERR;
     }
@@ -116,7 +106,7 @@ eMBRTUInit( UCHAR ucSlaveAddress, UCHAR ucPort, ULONG ulBaudRate, eMBParity ePar
              */
             usTimerT35_50us = ( 7UL * 220000UL ) / ( 2UL * ulBaudRate );
         }
-        if( xMBPortTimersInit( ( USHORT ) usTimerT35_50us ) != TRUE )
+        if( xMBPortTimersInit( sMBC, ( USHORT ) usTimerT35_50us ) != TRUE )
         {
             eStatus = MB_EPORTERR;
         }
@@ -127,55 +117,58 @@ eMBRTUInit( UCHAR ucSlaveAddress, UCHAR ucPort, ULONG ulBaudRate, eMBParity ePar
 }
 
 void
-eMBRTUStart( void )
+eMBRTUStart( sMBControl * sMBC )
 {
+    sMBSerialFrame *pxSer = &sMBC->xSerial;
     ENTER_CRITICAL_SECTION(  );
     /* Initially the receiver is in the state STATE_RX_INIT. we start
      * the timer and if no character is received within t3.5 we change
      * to STATE_RX_IDLE. This makes sure that we delay startup of the
      * modbus protocol stack until the bus is free.
      */
-    eRcvState = STATE_RX_INIT;
-    vMBPortSerialEnable( TRUE, FALSE );
-    vMBPortTimersEnable(  );
+    pxSer->eRcvState = STATE_RX_INIT;
+    vMBPortSerialEnable( sMBC->ucPort, TRUE, FALSE );
+    vMBPortTimersEnable( sMBC->ucPort );
 
     EXIT_CRITICAL_SECTION(  );
 }
 
 void
-eMBRTUStop( void )
+eMBRTUStop( sMBControl * sMBC )
 {
     ENTER_CRITICAL_SECTION(  );
-    vMBPortSerialEnable( FALSE, FALSE );
-    vMBPortTimersDisable(  );
+    vMBPortSerialEnable( sMBC->ucPort, FALSE, FALSE );
+    vMBPortTimersDisable( sMBC->ucPort );
     EXIT_CRITICAL_SECTION(  );
 }
 
 eMBErrorCode
-eMBRTUReceive( UCHAR * pucRcvAddress, UCHAR ** pucFrame, USHORT * pusLength )
+eMBRTUReceive( sMBControl * sMBC, UCHAR * pucRcvAddress, UCHAR ** pucFrame, USHORT * pusLength )
 {
+    sMBSerialFrame *pxSer = &sMBC->xSerial;
     BOOL            xFrameReceived = FALSE;
     eMBErrorCode    eStatus = MB_ENOERR;
 
     ENTER_CRITICAL_SECTION(  );
-    assert_param( usRcvBufferPos < MB_SER_PDU_SIZE_MAX );
+    assert_param( pxSer->usRcvBufferPos < MB_SER_PDU_SIZE_MAX );
 
-    /* Length and CRC check */
-    if( ( usRcvBufferPos >= MB_SER_PDU_SIZE_MIN )
-        && ( usMBCRC16( ( UCHAR * ) ucRTUBuf, usRcvBufferPos ) == 0 ) )
+    /* Length and CRC check. The CRC is folded in by xMBRTUReceiveFSM as
+     * the bytes arrive; a frame including its own CRC leaves zero.
+     */
+    if( ( pxSer->usRcvBufferPos >= MB_SER_PDU_SIZE_MIN ) && ( pxSer->usRcvCRC16 == 0 ) )
     {
         /* Save the address field. All frames are passed to the upper layed
          * and the decision if a frame is used is done there.
          */
-        *pucRcvAddress = ucRTUBuf[MB_SER_PDU_ADDR_OFF];
+        *pucRcvAddress = pxSer->ucBuf[MB_SER_PDU_ADDR_OFF];
 
         /* Total length of Modbus-PDU is Modbus-Serial-Line-PDU minus
          * size of address field and CRC checksum.
          */
-        *pusLength = ( USHORT )( usRcvBufferPos - MB_SER_PDU_PDU_OFF - MB_SER_PDU_SIZE_CRC );
+        *pusLength = ( USHORT )( pxSer->usRcvBufferPos - MB_SER_PDU_PDU_OFF - MB_SER_PDU_SIZE_CRC );
 
         /* Return the start of the Modbus PDU to the caller. */
-        *pucFrame = ( UCHAR * ) & ucRTUBuf[MB_SER_PDU_PDU_OFF];
+        *pucFrame = ( UCHAR * ) & pxSer->ucBuf[MB_SER_PDU_PDU_OFF];
         xFrameReceived = TRUE;
     }
     else
@@ -188,8 +181,9 @@ eMBRTUReceive( UCHAR * pucRcvAddress, UCHAR ** pucFrame, USHORT * pusLength )
 }
 
 eMBErrorCode
-eMBRTUSend( UCHAR ucSlaveAddress, const UCHAR * pucFrame, USHORT usLength )
+eMBRTUSend( sMBControl * sMBC, UCHAR ucSlaveAddress, const UCHAR * pucFrame, USHORT usLength )
 {
+    sMBSerialFrame *pxSer = &sMBC->xSerial;
     eMBErrorCode    eStatus = MB_ENOERR;
     USHORT          usCRC16;
 
@@ -199,24 +193,24 @@ eMBRTUSend( UCHAR ucSlaveAddress, const UCHAR * pucFrame, USHORT usLength )
      * slow with processing the received frame and the master sent another
      * frame on the network. We have to abort sending the frame.
      */
-    if( eRcvState == STATE_RX_IDLE )
+    if( pxSer->eRcvState == STATE_RX_IDLE )
     {
         /* First byte before the Modbus-PDU is the slave address. */
-        pucSndBufferCur = ( UCHAR * ) pucFrame - 1;
-        usSndBufferCount = 1;
+        pxSer->pucSndBufferCur = ( UCHAR * ) pucFrame - 1;
+        pxSer->usSndBufferCount = 1;
 
         /* Now copy the Modbus-PDU into the Modbus-Serial-Line-PDU. */
-        pucSndBufferCur[MB_SER_PDU_ADDR_OFF] = ucSlaveAddress;
-        usSndBufferCount += usLength;
+        pxSer->pucSndBufferCur[MB_SER_PDU_ADDR_OFF] = ucSlaveAddress;
+        pxSer->usSndBufferCount += usLength;
 
         /* Calculate CRC16 checksum for Modbus-Serial-Line-PDU. */
-        usCRC16 = usMBCRC16( ( UCHAR * ) pucSndBufferCur, usSndBufferCount );
-        ucRTUBuf[usSndBufferCount++] = ( UCHAR )( usCRC16 & 0xFF );
-        ucRTUBuf[usSndBufferCount++] = ( UCHAR )( usCRC16 >> 8 );
+        usCRC16 = usMBCRC16( ( UCHAR * ) pxSer->pucSndBufferCur, pxSer->usSndBufferCount );
+        pxSer->ucBuf[pxSer->usSndBufferCount++] = ( UCHAR )( usCRC16 & 0xFF );
+        pxSer->ucBuf[pxSer->usSndBufferCount++] = ( UCHAR )( usCRC16 >> 8 );
 
         /* Activate the transmitter. */
-        eSndState = STATE_TX_XMIT;
-        vMBPortSerialEnable( FALSE, TRUE );
+        pxSer->eSndState = STATE_TX_XMIT;
+        vMBPortSerialEnable( sMBC->ucPort, FALSE, TRUE );
     }
     else
     {
@@ -227,30 +221,31 @@ eMBRTUSend( UCHAR ucSlaveAddress, const UCHAR * pucFrame, USHORT usLength )
 }
 
 BOOL
-xMBRTUReceiveFSM( void )
+xMBRTUReceiveFSM( sMBControl * sMBC )
 {
+    sMBSerialFrame *pxSer = &sMBC->xSerial;
     BOOL            xTaskNeedSwitch = FALSE;
     UCHAR           ucByte;
 
-    assert_param( eSndState == STATE_TX_IDLE );
+    assert_param( pxSer->eSndState == STATE_TX_IDLE );
 
     /* Always read the character. */
-    ( void )xMBPortSerialGetByte( ( CHAR * ) & ucByte );
+    ( void )xMBPortSerialGetByte( sMBC->ucPort, ( CHAR * ) & ucByte );
 
-    switch ( eRcvState )
+    switch ( pxSer->eRcvState )
     {
         /* If we have received a character in the init state we have to
          * wait until the frame is finished.
          */
     case STATE_RX_INIT:
-        vMBPortTimersEnable(  );
+        vMBPortTimersEnable( sMBC->ucPort );
         break;
 
         /* In the error state we wait until all characters in the
          * damaged frame are transmitted.
          */
     case STATE_RX_ERROR:
-        vMBPortTimersEnable(  );
+        vMBPortTimersEnable( sMBC->ucPort );
         break;
 
         /* In the idle state we wait for a new character. If a character
@@ -258,12 +253,13 @@ xMBRTUReceiveFSM( void )
          * receiver is in the state STATE_RX_RECEIVCE.
          */
     case STATE_RX_IDLE:
-        usRcvBufferPos = 0;
-        ucRTUBuf[usRcvBufferPos++] = ucByte;
-        eRcvState = STATE_RX_RCV;
+        pxSer->usRcvBufferPos = 0;
+        pxSer->ucBuf[pxSer->usRcvBufferPos++] = ucByte;
+        pxSer->usRcvCRC16 = MB_CRC16_BYTE( MB_CRC16_INIT, ucByte );
+        pxSer->eRcvState = STATE_RX_RCV;
 
         /* Enable t3.5 timers. */
-        vMBPortTimersEnable(  );
+        vMBPortTimersEnable( sMBC->ucPort );
         break;
 
         /* We are currently receiving a frame. Reset the timer after
@@ -272,51 +268,53 @@ xMBRTUReceiveFSM( void )
          * ignored.
          */
     case STATE_RX_RCV:
-        if( usRcvBufferPos < MB_SER_PDU_SIZE_MAX )
+        if( pxSer->usRcvBufferPos < MB_SER_PDU_SIZE_MAX )
         {
-            ucRTUBuf[usRcvBufferPos++] = ucByte;
+            pxSer->ucBuf[pxSer->usRcvBufferPos++] = ucByte;
+            pxSer->usRcvCRC16 = MB_CRC16_BYTE( pxSer->usRcvCRC16, ucByte );
         }
         else
         {
-            eRcvState = STATE_RX_ERROR;
+            pxSer->eRcvState = STATE_RX_ERROR;
         }
-        vMBPortTimersEnable(  );
+        vMBPortTimersEnable( sMBC->ucPort );
         break;
     }
     return xTaskNeedSwitch;
 }
 
 BOOL
-xMBRTUTransmitFSM( void )
+xMBRTUTransmitFSM( sMBControl * sMBC )
 {
+    sMBSerialFrame *pxSer = &sMBC->xSerial;
     BOOL            xNeedPoll = FALSE;
 
-    assert_param( eRcvState == STATE_RX_IDLE );
+    assert_param( pxSer->eRcvState == STATE_RX_IDLE );
 
-    switch ( eSndState )
+    switch ( pxSer->eSndState )
     {
         /* We should not get a transmitter event if the transmitter is in
          * idle state.  */
     case STATE_TX_IDLE:
         /* enable receiver/disable transmitter. */
-        vMBPortSerialEnable( TRUE, FALSE );
+        vMBPortSerialEnable( sMBC->ucPort, TRUE, FALSE );
         break;
 
     case STATE_TX_XMIT:
         /* check if we are finished. */
-        if( usSndBufferCount != 0 )
+        if( pxSer->usSndBufferCount != 0 )
         {
-            xMBPortSerialPutByte( ( CHAR )*pucSndBufferCur );
-            pucSndBufferCur++;  /* next byte in sendbuffer. */
-            usSndBufferCount--;
+            xMBPortSerialPutByte( sMBC->ucPort, ( CHAR )*pxSer->pucSndBufferCur );
+            pxSer->pucSndBufferCur++;  /* next byte in sendbuffer. */
+            pxSer->usSndBufferCount--;
         }
         else
         {
-            xNeedPoll = xMBPortEventPost( xMBSerialEventQueue, EV_FRAME_SENT );
+            xNeedPoll = xMBPortEventPost( sMBC->xMBEventQueue, EV_FRAME_SENT );
             /* Disable transmitter. This prevents another transmit buffer
              * empty interrupt. */
-            vMBPortSerialEnable( TRUE, FALSE );
-            eSndState = STATE_TX_IDLE;
+            vMBPortSerialEnable( sMBC->ucPort, TRUE, FALSE );
+            pxSer->eSndState = STATE_TX_IDLE;
         }
         break;
     }
@@ -325,21 +323,22 @@ xMBRTUTransmitFSM( void )
 }
 
 BOOL
-xMBRTUTimerT35Expired( void )
+xMBRTUTimerT35Expired( sMBControl * sMBC )
 {
+    sMBSerialFrame *pxSer = &sMBC->xSerial;
     BOOL            xNeedPoll = FALSE;
 
-    switch ( eRcvState )
+    switch ( pxSer->eRcvState )
     {
         /* Timer t35 expired. Startup phase is finished. */
     case STATE_RX_INIT:
-        xNeedPoll = xMBPortEventPost( xMBSerialEventQueue, EV_READY );
+        xNeedPoll = xMBPortEventPost( sMBC->xMBEventQueue, EV_READY );
         break;
 
         /* A frame was received and t35 expired. Notify the listener that
          * a new frame was received. */
     case STATE_RX_RCV:
-        xNeedPoll = xMBPortEventPost( xMBSerialEventQueue, EV_FRAME_RECEIVED );
+        xNeedPoll = xMBPortEventPost( sMBC->xMBEventQueue, EV_FRAME_RECEIVED );
         break;
 
         /* An error occured while receiving the frame. */
@@ -348,12 +347,12 @@ xMBRTUTimerT35Expired( void )
 
         /* Function called in an illegal state. */
     default:
-        assert_param( ( eRcvState == STATE_RX_INIT ) ||
-                ( eRcvState == STATE_RX_RCV ) || ( eRcvState == STATE_RX_ERROR ) );
+        assert_param( ( pxSer->eRcvState == STATE_RX_INIT ) ||
+                ( pxSer->eRcvState == STATE_RX_RCV ) || ( pxSer->eRcvState == STATE_RX_ERROR ) );
     }
 
-    vMBPortTimersDisable(  );
-    eRcvState = STATE_RX_IDLE;
+    vMBPortTimersDisable( sMBC->ucPort );
+    pxSer->eRcvState = STATE_RX_IDLE;
 
     return xNeedPoll;
 }
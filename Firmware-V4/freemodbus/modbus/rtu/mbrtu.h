@@ -35,16 +35,18 @@
 PR_BEGIN_EXTERN_C
 #endif
 
-    eMBErrorCode eMBRTUInit( UCHAR slaveAddress, UCHAR ucPort, ULONG ulBaudRate,
-                             eMBParity eParity );
-void            eMBRTUStart( void );
-void            eMBRTUStop( void );
-eMBErrorCode    eMBRTUReceive( UCHAR * pucRcvAddress, UCHAR ** pucFrame, USHORT * pusLength );
-eMBErrorCode    eMBRTUSend( UCHAR slaveAddress, const UCHAR * pucFrame, USHORT usLength );
-BOOL            xMBRTUReceiveFSM( void );
-BOOL            xMBRTUTransmitFSM( void );
-BOOL            xMBRTUTimerT15Expired( void );
-BOOL            xMBRTUTimerT35Expired( void );
+    eMBErrorCode eMBRTUInit( sMBControl * sMBC, UCHAR slaveAddress, UCHAR ucPort,
+                             ULONG ulBaudRate, eMBParity eParity );
+void            eMBRTUStart( sMBControl * sMBC );
+void            eMBRTUStop( sMBControl * sMBC );
+eMBErrorCode    eMBRTUReceive( sMBControl * sMBC, UCHAR * pucRcvAddress,
+                               UCHAR ** pucFrame, USHORT * pusLength );
+eMBErrorCode    eMBRTUSend( sMBControl * sMBC, UCHAR slaveAddress,
+                            const UCHAR * pucFrame, USHORT usLength );
+BOOL            xMBRTUReceiveFSM( sMBControl * sMBC );
+BOOL            xMBRTUTransmitFSM( sMBControl * sMBC );
+BOOL            xMBRTUTimerT15Expired( sMBControl * sMBC );
+BOOL            xMBRTUTimerT35Expired( sMBControl * sMBC );
 
 #ifdef __cplusplus
 PR_END_EXTERN_C
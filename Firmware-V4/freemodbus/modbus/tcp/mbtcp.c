@@ -90,19 +90,21 @@ eMBTCPDoInit( USHORT ucTCPPort )
 }
 
 void
-eMBTCPStart( void )
+eMBTCPStart( sMBControl * sMBC )
 {
+    ( void )sMBC;
 }
 
 void
-eMBTCPStop( void )
+eMBTCPStop( sMBControl * sMBC )
 {
+    ( void )sMBC;
     /* Make sure that no more clients are connected. */
     vMBTCPPortDisable( );
 }
 
 eMBErrorCode
-eMBTCPReceive( UCHAR * pucRcvAddress, UCHAR ** ppucFrame, USHORT * pusLength )
+eMBTCPReceive( sMBControl * sMBC, UCHAR * pucRcvAddress, UCHAR ** ppucFrame, USHORT * pusLength )
 {
     eMBErrorCode    eStatus = MB_EIO;
     UCHAR          *pucMBTCPFrame;
@@ -134,7 +136,7 @@ eMBTCPReceive( UCHAR * pucRcvAddress, UCHAR ** ppucFrame, USHORT * pusLength )
 }
 
 eMBErrorCode
-eMBTCPSend( UCHAR _unused, const UCHAR * pucFrame, USHORT usLength )
+eMBTCPSend( sMBControl * sMBC, UCHAR _unused, const UCHAR * pucFrame, USHORT usLength )
 {
     eMBErrorCode    eStatus = MB_ENOERR;
     UCHAR          *pucMBTCPFrame = ( UCHAR * ) pucFrame - MB_TCP_FUNC;
@@ -40,12 +40,12 @@ PR_BEGIN_EXTERN_C
 
 /* ----------------------- Function prototypes ------------------------------*/
 eMBErrorCode eMBTCPDoInit( USHORT ucTCPPort );
-void            eMBTCPStart( void );
-void            eMBTCPStop( void );
-eMBErrorCode    eMBTCPReceive( UCHAR * pucRcvAddress, UCHAR ** pucFrame,
-                               USHORT * pusLength );
-eMBErrorCode    eMBTCPSend( UCHAR _unused, const UCHAR * pucFrame,
-                            USHORT usLength );
+void            eMBTCPStart( sMBControl * sMBC );
+void            eMBTCPStop( sMBControl * sMBC );
+eMBErrorCode    eMBTCPReceive( sMBControl * sMBC, UCHAR * pucRcvAddress,
+                               UCHAR ** pucFrame, USHORT * pusLength );
+eMBErrorCode    eMBTCPSend( sMBControl * sMBC, UCHAR _unused,
+                            const UCHAR * pucFrame, USHORT usLength );
 
 #ifdef __cplusplus
 PR_END_EXTERN_C
@@ -44,6 +44,17 @@ PR_BEGIN_EXTERN_C
 
 #define MB_PORT_HAS_CLOSE 						(  1 )
 
+/*! \brief Serial ports whose interrupt is served by the Modbus port.
+ *
+ * Port 0 is USART1, port 1 USART2 and port 2 USART3. Each port runs its own
+ * RTU instance with its own timer ( TIM2, TIM6 and TIM7 ). USART2 and USART3
+ * are owned by driver/serial.c by default; undefine USE_USART2 or USE_USART3
+ * there before enabling them here.
+ */
+#define MB_PORT_USART1_ENABLED                  (  1 )
+#define MB_PORT_USART2_ENABLED                  (  0 )
+#define MB_PORT_USART3_ENABLED                  (  0 )
+
 /*! \brief The character timeout value for Modbus ASCII.
  *
  * The character timeout value is not fixed for Modbus ASCII and is therefore
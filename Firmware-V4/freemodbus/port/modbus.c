@@ -14,10 +14,10 @@
 #include "mb.h"
 #include "modbus.h"
 /* ------------------------ Project includes ------------------------------ */
+#include "gl_696h.h"
 
 /* ------------------------ Defines --------------------------------------- */
 #define MB_COM_PORT			0		//com0
-#define MB_SLAVE_MODE		MB_RTU
 #define MB_SLAVE_ADDRESS	0x11
 #define MB_COM_BAUD_RATE	115200
 #define MB_PARITY_MODE		MB_PAR_NONE
@@ -29,7 +29,24 @@ static USHORT   usRegInputStart = REG_INPUT_START;
 /*static*/ volatile USHORT   usRegInputBuf[REG_INPUT_NREGS];
 static USHORT   usRegHoldingStart = REG_HOLDING_START;
 /*static*/ volatile USHORT   usRegHoldingBuf[REG_HOLDING_NREGS];
-static xSemaphoreHandle xSemaphore_MB;
+
+/* Commit counters of the register images. A writer bumps the counter
+ * inside a short critical section, a reader copies without any lock and
+ * retries if the counter moved while it was copying. */
+static volatile ULONG ulRegInputSeq = 0;
+static volatile ULONG ulRegHoldingSeq = 0;
+
+static xMBRegWatch *pxMBRegWatches[MB_REG_WATCH_MAX];
+static UCHAR    ucMBRegWatchCount = 0;
+
+/* ------------------------ Type definitions ------------------------------ */
+/* A run of holding registers with a side effect on write. */
+typedef struct
+{
+	USHORT	usStart;
+	USHORT	usNRegs;
+	void	( *pxWrite )( USHORT usReg, USHORT usNRegs );
+} xMBRegRegion;
 
 /* ------------------------ Static functions ------------------------------ */
 
@@ -37,172 +54,390 @@ static xSemaphoreHandle xSemaphore_MB;
 
 /*---------------------------------------------------------------------------*/
 
+/* The slave vMBRTUSlaveTask( ) serves when it is created without one. */
+static xMBRTUSlave xMBRTUDefault = {
+	MB_COM_PORT, MB_SLAVE_ADDRESS, MB_COM_BAUD_RATE, MB_PARITY_MODE
+};
+
 void
-vMBTCPSlaveTask( void *pvParameters )
+vMBRTUSlaveTask( void *pvParameters )
 {
+    const unsigned char ucSlaveIDAdditonal[] = { 0xAA, 0xBB, 0xCC };
     eMBErrorCode    xStatus;
-	u8 i;
-	sMBControl sMBCTcp;
+	xMBRTUSlave    *pxSlave = pvParameters ? ( xMBRTUSlave * )pvParameters : &xMBRTUDefault;
+	sMBControl     *sMBC = &pxSlave->xMBC;
 
-//	vTaskDelay( configTICK_RATE_HZ*3 );
-	
     for( ;; )
     {
-		if ( xSemaphore_MB == NULL ){
-			vSemaphoreCreateBinary( xSemaphore_MB );
-		    if( xSemaphore_MB == NULL ){
-				vTaskDelay( configTICK_RATE_HZ*3 );
-				continue;
-			}
-		}
-
-        if( eMBTCPInit( &sMBCTcp, MB_TCP_PORT_USE_DEFAULT ) != MB_ENOERR ) {
-            //fprintf( stderr, "%s: can't initialize modbus stack!\r\n", PROG );
-        } else if( eMBEnable( &sMBCTcp ) != MB_ENOERR ) {
+		if ( eMBInit( sMBC, MB_RTU, pxSlave->ucAddress, pxSlave->ucPort, pxSlave->ulBaudRate, pxSlave->eParity ) != MB_ENOERR ) {
+		} else if( eMBSetSlaveID( 44, TRUE, ucSlaveIDAdditonal, 3 ) != MB_ENOERR ) {
+        } else if( eMBEnable( sMBC ) != MB_ENOERR ) {
             //fprintf( stderr, "%s: can't enable modbus stack!\r\n", PROG );
         } else {
             do
             {
-                xStatus = eMBPoll( &sMBCTcp );
+                xStatus = eMBPoll( sMBC );
+		        //usRegInputBuf[0]++;
             }
             while( xStatus == MB_ENOERR );
         }
         /* An error occured. Maybe we can restart. */
-        ( void )eMBDisable( &sMBCTcp );
-        ( void )eMBClose( &sMBCTcp );
+        ( void )eMBDisable( sMBC );
+        ( void )eMBClose( sMBC );
 		vTaskDelay( configTICK_RATE_HZ*3 );
-    }
+   }
 }
 
 /*---------------------------------------------------------------------------*/
+static void
+prvMBRegCommit( volatile USHORT * pusImage, volatile ULONG * pulSeq,
+                int iRegIndex, const USHORT * pusRegs, USHORT usNRegs )
+{
+	/* Writers are serialised by the critical section, the whole block
+	 * becomes visible with one counter update. */
+	vPortEnterCritical();
+	( *pulSeq )++;
+	while( usNRegs > 0 )
+	{
+		pusImage[iRegIndex++] = *pusRegs++;
+		usNRegs--;
+	}
+	( *pulSeq )++;
+	vPortExitCritical();
+}
 
-void
-vMBRTUSlaveTask( void *pvParameters )
+static void
+prvMBRegSnapshot( volatile USHORT * pusImage, volatile ULONG * pulSeq,
+                  int iRegIndex, USHORT * pusRegs, USHORT usNRegs )
 {
-    const unsigned char ucSlaveIDAdditonal[] = { 0xAA, 0xBB, 0xCC };
-    eMBErrorCode    xStatus;
-	u8 i;
-	sMBControl sMBCRtu;
+	ULONG ulSeq;
+	USHORT i;
+
+	/* Never blocks, a commit that preempts the copy makes it start over.
+	 * An odd counter is a commit still in progress. */
+	do
+	{
+		ulSeq = *pulSeq;
+		for( i = 0; i < usNRegs; i++ )
+			pusRegs[i] = pusImage[iRegIndex + i];
+	}
+	while( ( ulSeq & 1 ) || ulSeq != *pulSeq );
+}
 
-    for( ;; )
-    {
-		if ( xSemaphore_MB == NULL ){
-			vSemaphoreCreateBinary( xSemaphore_MB );
-		    if( xSemaphore_MB == NULL ) {
-				vTaskDelay( configTICK_RATE_HZ*3 );
-				continue;
-			}
+static void
+prvMBRegSnapshotBytes( volatile USHORT * pusImage, volatile ULONG * pulSeq,
+                       int iRegIndex, UCHAR * pucRegBuffer, USHORT usNRegs )
+{
+	ULONG ulSeq;
+	USHORT i;
+	USHORT usRegVal;
+
+	do
+	{
+		ulSeq = *pulSeq;
+		for( i = 0; i < usNRegs; i++ )
+		{
+			usRegVal = pusImage[iRegIndex + i];
+			pucRegBuffer[i * 2] = ( UCHAR )( usRegVal >> 8 );
+			pucRegBuffer[i * 2 + 1] = ( UCHAR )( usRegVal & 0xFF );
 		}
+	}
+	while( ( ulSeq & 1 ) || ulSeq != *pulSeq );
+}
 
-		if ( eMBInit( &sMBCRtu,MB_SLAVE_MODE, MB_SLAVE_ADDRESS, MB_COM_PORT, MB_COM_BAUD_RATE, MB_PARITY_MODE ) != MB_ENOERR ) {
-		} else if( eMBSetSlaveID( 44, TRUE, ucSlaveIDAdditonal, 3 ) != MB_ENOERR ) {
-        } else if( eMBEnable( &sMBCRtu ) != MB_ENOERR ) {
-            //fprintf( stderr, "%s: can't enable modbus stack!\r\n", PROG );
-        } else {
-            do
-            {
-                xStatus = eMBPoll( &sMBCRtu );
-		        //usRegInputBuf[0]++;
-            }
-            while( xStatus == MB_ENOERR );
-        }
-        /* An error occured. Maybe we can restart. */
-        ( void )eMBDisable( &sMBCRtu );
-        ( void )eMBClose( &sMBCRtu );
-		vTaskDelay( configTICK_RATE_HZ*3 );
-   }
+/*---------------------------------------------------------------------------*/
+BOOL
+eMBRegHolding_Watch( xMBRegWatch * pxWatch )
+{
+	BOOL xOk = FALSE;
+	UCHAR i;
+
+	if( pxWatch->usStart + pxWatch->usNRegs > REG_HOLDING_NREGS )
+		return FALSE;
+
+	/* Everything counts as written once, the first take loads it all. */
+	memset( ( void * )pxWatch->ulDirty, 0xFF, sizeof( pxWatch->ulDirty ) );
+	vPortEnterCritical();
+	/* a restarted owner registers the same watch again */
+	for( i = 0; i < ucMBRegWatchCount; i++ )
+	{
+		if( pxMBRegWatches[i] == pxWatch )
+			xOk = TRUE;
+	}
+	if( !xOk && ucMBRegWatchCount < MB_REG_WATCH_MAX )
+	{
+		pxMBRegWatches[ucMBRegWatchCount++] = pxWatch;
+		xOk = TRUE;
+	}
+	vPortExitCritical();
+	return xOk;
+}
+
+/* TRUE if a register in the range was written since the last take, the
+ * range is marked clean again. */
+BOOL
+eMBRegHolding_TakeDirty( xMBRegWatch * pxWatch, USHORT usAddress, USHORT usNRegs )
+{
+	ULONG ulDirty = 0;
+	ULONG ulMask;
+	USHORT usBit;
+
+	vPortEnterCritical();
+	while( usNRegs > 0 )
+	{
+		usBit = usAddress & 31;
+		ulMask = ( usNRegs >= 32 - usBit ) ? ( 0xFFFFFFFFUL << usBit ) :
+				 ( ( ( 1UL << usNRegs ) - 1 ) << usBit );
+		ulDirty |= pxWatch->ulDirty[usAddress >> 5] & ulMask;
+		pxWatch->ulDirty[usAddress >> 5] &= ~ulMask;
+		usBit = 32 - usBit;
+		if( usBit > usNRegs )
+			usBit = usNRegs;
+		usAddress += usBit;
+		usNRegs -= usBit;
+	}
+	vPortExitCritical();
+	return ulDirty != 0;
+}
+
+/* Copy the whole bitmap to pulDirty[MB_REG_WATCH_WORDS] and mark it clean,
+ * for an owner that reloads register by register. TRUE if any was set. */
+BOOL
+eMBRegHolding_TakeDirtyMap( xMBRegWatch * pxWatch, ULONG * pulDirty )
+{
+	ULONG ulAny = 0;
+	UCHAR i;
+
+	vPortEnterCritical();
+	for( i = 0; i < MB_REG_WATCH_WORDS; i++ )
+	{
+		pulDirty[i] = pxWatch->ulDirty[i];
+		pxWatch->ulDirty[i] = 0;
+		ulAny |= pulDirty[i];
+	}
+	vPortExitCritical();
+	return ulAny != 0;
+}
+
+/* Mark a block the host committed in every watch it touches and wake the
+ * owners. */
+static void
+prvMBRegNotify( USHORT usAddress, USHORT usNRegs )
+{
+	xMBRegWatch *pxWatch;
+	USHORT usFirst, usLast;
+	UCHAR i;
+
+	for( i = 0; i < ucMBRegWatchCount; i++ )
+	{
+		pxWatch = pxMBRegWatches[i];
+		usFirst = usAddress > pxWatch->usStart ? usAddress : pxWatch->usStart;
+		usLast = usAddress + usNRegs < pxWatch->usStart + pxWatch->usNRegs ?
+				 usAddress + usNRegs : pxWatch->usStart + pxWatch->usNRegs;
+		if( usFirst >= usLast )
+			continue;
+
+		vPortEnterCritical();
+		for( ; usFirst < usLast; usFirst++ )
+			pxWatch->ulDirty[usFirst >> 5] |= 1UL << ( usFirst & 31 );
+		vPortExitCritical();
+
+		if( pxWatch->pxNotify != NULL )
+			pxWatch->pxNotify( pxWatch->pvArg );
+	}
 }
 
 /*---------------------------------------------------------------------------*/
-USHORT
-eMBRegHolding_Read( USHORT usAddress )
+static void
+prvMBRegCommitBytes( volatile USHORT * pusImage, volatile ULONG * pulSeq,
+                     int iRegIndex, const UCHAR * pucRegBuffer, USHORT usNRegs )
+{
+	/* Same as prvMBRegCommit(), swapping straight from the frame. */
+	vPortEnterCritical();
+	( *pulSeq )++;
+	while( usNRegs > 0 )
+	{
+		pusImage[iRegIndex++] = ( USHORT )( ( pucRegBuffer[0] << 8 ) | pucRegBuffer[1] );
+		pucRegBuffer += 2;
+		usNRegs--;
+	}
+	( *pulSeq )++;
+	vPortExitCritical();
+}
+
+/*---------------------------------------------------------------------------*/
+/* Side effects of the holding registers, see MB_HOLDING_REGIONS. Each gets
+ * the first register written in its region and how many were written.
+ * They run in the Modbus or the uIP task and must not block: GPIO, DAC and
+ * register writes are done here, a pump command is handed to its job. */
+static void
+prvMBHookCurSet( USHORT usReg, USHORT usNRegs )
 {
-    int iRegIndex;
-	USHORT RegVal;
+	/* A new current set point clears the controller flags of that gun. */
+	USHORT usSt = ( usReg == MB_CUR_SET_L ) ? MB_HV_ST_L : MB_HV_ST_R;
 
-	while ( xSemaphore_MB == NULL )
-		vTaskDelay( configTICK_RATE_HZ );
+	eMBRegInput_Write( usSt, eMBRegInput_Read( usSt ) & 0xFF );
+}
+
+static void
+prvMBHookPowerPump( USHORT usReg, USHORT usNRegs )
+{
+	powerpump_ctl( usRegHoldingBuf[usReg] );
+}
+
+static void
+prvMBHookMPump( USHORT usReg, USHORT usNRegs )
+{
+	mpump_ctl_post( usRegHoldingBuf[usReg] );
+}
 
-	usAddress ++;
-    if( ( usAddress < REG_HOLDING_START ) || \
-        ( usAddress > REG_HOLDING_START + REG_HOLDING_NREGS ) )
+static void
+prvMBHookVMeter( USHORT usReg, USHORT usNRegs )
+{
+	vmeter_ctl( usRegHoldingBuf[usReg] );
+}
+
+static void
+prvMBHookSampleLed( USHORT usReg, USHORT usNRegs )
+{
+	sample_led_ctl( usRegHoldingBuf[usReg] );
+}
+
+static void
+prvMBHookBaffle( USHORT usReg, USHORT usNRegs )
+{
+	baffle_ctl( usRegHoldingBuf[usReg] );
+}
+
+static void
+prvMBHookBleedValve( USHORT usReg, USHORT usNRegs )
+{
+	bleed_valve_ctl( usRegHoldingBuf[usReg] );
+}
+
+static void
+prvMBHookDac( USHORT usReg, USHORT usNRegs )
+{
+	while( usNRegs-- > 0 )
+	{
+		PWM_DAC_Set( usReg - MB_DAC0, usRegHoldingBuf[usReg] );
+		usReg++;
+	}
+}
+
+#define MB_REG_REGION( start, count, hook )	{ start, count, hook },
+
+static const xMBRegRegion xMBHoldingRegions[] = {
+	MB_HOLDING_REGIONS( MB_REG_REGION )
+};
+
+#define MB_HOLDING_NREGIONS ( sizeof( xMBHoldingRegions ) / sizeof( xMBHoldingRegions[0] ) )
+
+/* Run the side effects of a committed block, once per region it touches. */
+static void
+prvMBRegHooks( USHORT usAddress, USHORT usNRegs )
+{
+	const xMBRegRegion *pxRegion;
+	USHORT			usFirst, usLast;
+
+	for( pxRegion = xMBHoldingRegions;
+		 pxRegion < xMBHoldingRegions + MB_HOLDING_NREGIONS; pxRegion++ )
+	{
+		if( pxRegion->usStart >= usAddress + usNRegs )
+			break;
+		if( pxRegion->usStart + pxRegion->usNRegs <= usAddress )
+			continue;
+		usFirst = pxRegion->usStart > usAddress ? pxRegion->usStart : usAddress;
+		usLast = pxRegion->usStart + pxRegion->usNRegs < usAddress + usNRegs ?
+				 pxRegion->usStart + pxRegion->usNRegs : usAddress + usNRegs;
+		pxRegion->pxWrite( usFirst, usLast - usFirst );
+	}
+}
+
+/*---------------------------------------------------------------------------*/
+USHORT
+eMBRegHolding_Read( USHORT usAddress )
+{
+    if( usAddress >= REG_HOLDING_NREGS )
     	return 0;
 
-	iRegIndex = ( int )( usAddress - usRegHoldingStart );
-	xSemaphoreTake( xSemaphore_MB, portMAX_DELAY );
-	
-	RegVal = usRegHoldingBuf[iRegIndex];
-	
-	xSemaphoreGive( xSemaphore_MB );
-    return RegVal;
+	/* A single 16-bit load can not be torn. */
+    return usRegHoldingBuf[usAddress];
 }
 /*---------------------------------------------------------------------------*/
 void
 eMBRegHolding_Write( USHORT usAddress, USHORT usRegVal )
 {
-    int iRegIndex;
-	USHORT RegVal;
+	eMBRegHolding_WriteBlock( usAddress, &usRegVal, 1 );
+}
+/*---------------------------------------------------------------------------*/
+BOOL
+eMBRegHolding_ReadBlock( USHORT usAddress, USHORT * pusRegs, USHORT usNRegs )
+{
+    if( usAddress + usNRegs > REG_HOLDING_NREGS )
+    	return FALSE;
 
-	while ( xSemaphore_MB == NULL )
-		vTaskDelay( configTICK_RATE_HZ );
-	
-	usAddress ++;
-    if( ( usAddress < REG_HOLDING_START ) || \
-        ( usAddress > REG_HOLDING_START + REG_HOLDING_NREGS ) )
-    	return;
+	prvMBRegSnapshot( usRegHoldingBuf, &ulRegHoldingSeq, usAddress, pusRegs, usNRegs );
+	return TRUE;
+}
+/*---------------------------------------------------------------------------*/
+BOOL
+eMBRegHolding_WriteBlock( USHORT usAddress, const USHORT * pusRegs, USHORT usNRegs )
+{
+    if( usAddress + usNRegs > REG_HOLDING_NREGS )
+    	return FALSE;
 
-	iRegIndex = ( int )( usAddress - usRegHoldingStart );
-	xSemaphoreTake( xSemaphore_MB, portMAX_DELAY );
-	
-    usRegHoldingBuf[iRegIndex]  = usRegVal;
-	
-	xSemaphoreGive( xSemaphore_MB );
+	prvMBRegCommit( usRegHoldingBuf, &ulRegHoldingSeq, usAddress, pusRegs, usNRegs );
+	return TRUE;
+}
+/*---------------------------------------------------------------------------*/
+/* A write on the operator's behalf, the same as one from the host: the
+ * watches are marked and the side effects run, in the caller's task. */
+BOOL
+eMBRegHolding_WriteNotify( USHORT usAddress, const USHORT * pusRegs, USHORT usNRegs )
+{
+    if( usAddress + usNRegs > REG_HOLDING_NREGS )
+    	return FALSE;
+
+	prvMBRegCommit( usRegHoldingBuf, &ulRegHoldingSeq, usAddress, pusRegs, usNRegs );
+	prvMBRegNotify( usAddress, usNRegs );
+	prvMBRegHooks( usAddress, usNRegs );
+	return TRUE;
 }
 /*---------------------------------------------------------------------------*/
 USHORT
 eMBRegInput_Read( USHORT usAddress )
 {
-    int iRegIndex;
-	USHORT RegVal;
-
-	while ( xSemaphore_MB == NULL )
-		vTaskDelay( configTICK_RATE_HZ );
-
-	usAddress ++;
-    if( ( usAddress < REG_INPUT_START ) || \
-        ( usAddress > REG_INPUT_START + REG_INPUT_NREGS ) )
+    if( usAddress >= REG_INPUT_NREGS )
     	return 0;
 
-	iRegIndex = ( int )( usAddress - usRegInputStart );
-	xSemaphoreTake( xSemaphore_MB, portMAX_DELAY );
-	
-	RegVal = usRegInputBuf[iRegIndex];
-	
-	xSemaphoreGive( xSemaphore_MB );
-    return RegVal;
+    return usRegInputBuf[usAddress];
 }
 /*---------------------------------------------------------------------------*/
 void
 eMBRegInput_Write( USHORT usAddress, USHORT usRegVal )
 {
-    int iRegIndex;
-	USHORT RegVal;
-
-	while ( xSemaphore_MB == NULL )
-		vTaskDelay( configTICK_RATE_HZ );
+	eMBRegInput_WriteBlock( usAddress, &usRegVal, 1 );
+}
+/*---------------------------------------------------------------------------*/
+BOOL
+eMBRegInput_ReadBlock( USHORT usAddress, USHORT * pusRegs, USHORT usNRegs )
+{
+    if( usAddress + usNRegs > REG_INPUT_NREGS )
+    	return FALSE;
 
-	usAddress ++;
-    if( ( usAddress < REG_INPUT_START ) || \
-        ( usAddress > REG_INPUT_START + REG_INPUT_NREGS ) )
-    	return ;
+	prvMBRegSnapshot( usRegInputBuf, &ulRegInputSeq, usAddress, pusRegs, usNRegs );
+	return TRUE;
+}
+/*---------------------------------------------------------------------------*/
+BOOL
+eMBRegInput_WriteBlock( USHORT usAddress, const USHORT * pusRegs, USHORT usNRegs )
+{
+    if( usAddress + usNRegs > REG_INPUT_NREGS )
+    	return FALSE;
 
-	iRegIndex = ( int )( usAddress - usRegInputStart );
-	xSemaphoreTake( xSemaphore_MB, portMAX_DELAY );
-	
-    usRegInputBuf[iRegIndex]  = usRegVal;
-	
-	xSemaphoreGive( xSemaphore_MB );
-    return ;
+	prvMBRegCommit( usRegInputBuf, &ulRegInputSeq, usAddress, pusRegs, usNRegs );
+	return TRUE;
 }
 /*---------------------------------------------------------------------------*/
 
@@ -216,17 +451,7 @@ eMBRegInputCB( UCHAR * pucRegBuffer, USHORT usAddress, USHORT usNRegs )
         && ( usAddress + usNRegs <= REG_INPUT_START + REG_INPUT_NREGS ) )
     {
         iRegIndex = ( int )( usAddress - usRegInputStart );
-        while( usNRegs > 0 )
-        {
-			vPortEnterCritical();
-			
-            *pucRegBuffer++ = ( unsigned char )( usRegInputBuf[iRegIndex] >> 8 );
-            *pucRegBuffer++ = ( unsigned char )( usRegInputBuf[iRegIndex] & 0xFF );
-			
-			vPortExitCritical();
-            iRegIndex++;
-            usNRegs--;
-        }
+		prvMBRegSnapshotBytes( usRegInputBuf, &ulRegInputSeq, iRegIndex, pucRegBuffer, usNRegs );
     }
     else
     {
@@ -242,7 +467,6 @@ eMBRegHoldingCB( UCHAR * pucRegBuffer, USHORT usAddress, USHORT usNRegs, eMBRegi
 {
     eMBErrorCode    eStatus = MB_ENOERR;
     int             iRegIndex;
-	char str[4];
 	
     if( ( usAddress >= REG_HOLDING_START ) &&
         ( usAddress + usNRegs <= REG_HOLDING_START + REG_HOLDING_NREGS ) )
@@ -252,277 +476,18 @@ eMBRegHoldingCB( UCHAR * pucRegBuffer, USHORT usAddress, USHORT usNRegs, eMBRegi
         {
             /* Pass current register values to the protocol stack. */
         case MB_REG_READ:
-			while( usNRegs > 0 )
-            {
-				vPortEnterCritical();
-				
-                *pucRegBuffer++ = ( UCHAR ) ( usRegHoldingBuf[iRegIndex] >> 8 );
-                *pucRegBuffer++ = ( UCHAR ) ( usRegHoldingBuf[iRegIndex] & 0xFF );
-				
-				vPortExitCritical();
-                iRegIndex++;
-                usNRegs--;
-            }
+			prvMBRegSnapshotBytes( usRegHoldingBuf, &ulRegHoldingSeq, iRegIndex, pucRegBuffer, usNRegs );
             break;
 
             /* Update current register values with new values from the
              * protocol stack. */
         case MB_REG_WRITE:
-            while( usNRegs > 0 )
-            {
-				vPortEnterCritical();
-				
-                usRegHoldingBuf[iRegIndex]  = *pucRegBuffer++ << 8;
-                usRegHoldingBuf[iRegIndex] |= *pucRegBuffer++;
-				
-				switch ( iRegIndex ){
-/*				case MB_DAC0:		
-				case MB_DAC1:		
-				case MB_DAC2:		
-				case MB_DAC3:		
-					PWM_DAC_SetmV(iRegIndex - MB_DAC0,usRegHoldingBuf[iRegIndex]);
-					break;
-				case MB_MF_VMETER_CTL:
-					//hv_pwr_ctl(2,(usRegHoldingBuf[iRegIndex]&0x01)?POWER_ON:POWER_OFF);
-					break;
-				case MB_MF_RELAY_CTL:
-					hv_pwr_ctl(0,(usRegHoldingBuf[iRegIndex]&0x01)?POWER_ON:POWER_OFF);
-					hv_pwr_ctl(1,(usRegHoldingBuf[iRegIndex]&0x02)?POWER_ON:POWER_OFF);
-					//hv_pwr_ctl(3,(usRegHoldingBuf[iRegIndex]&0x04)?POWER_ON:POWER_OFF);
-					break;
-				default :
-					break;*/
-					case MB_VOL_MAX :
-					case MB_VOL_SCALE:
-					case MB_VOL_ERR_RATE:
-					case MB_VOL_STEP:
-					case MB_VOL_STEP_INTERVAL:
-					case MB_VOL_STEP_TIMEOUT:
-					case MB_VOL_LEVEL1:
-						
-					case MB_CURRRENT_MAX :
-					case MB_CUR_SCALE:
-					case MB_CUR_ERR_RATE:
-					case MB_CUR_STEP:
-					case MB_CUR_STEP_INTERVAL:
-					case MB_CUR_STEP_TIMEOUT:
-					case MB_CUR_CTL_START:
-						
-					case MB_VOL_SET_L:
-					case MB_VOL_SET_R:
-						
-					case VMETER_START_DELAY:
-					case VMETER_STOP_DELAY:
-					case MB_MPUMP_PWR_OFF_FREQ:
-						break;
-					case MB_CUR_SET_L:
-						usRegInputBuf[MB_HV_ST_L] &= 0xFF;
-						break;
-					case MB_CUR_SET_R:
-						usRegInputBuf[MB_HV_ST_R] &= 0xFF;
-						break;
-					case MB_POWERPUMP_CTL:
-						powerpump_ctl(usRegHoldingBuf[iRegIndex]);
-						break;
-					case MB_MPUMP_CTL:
-						mpump_ctl(usRegHoldingBuf[iRegIndex]);
-						break;
-					case MB_VMETER_CTL:
-						vmeter_ctl( usRegHoldingBuf[iRegIndex] );
-						break;
-					case MB_VMETER_ERR_RATE:
-					case MB_VMETER_SET0:
-					case MB_VMETER_SET1:
-					case MB_VMETER_SET2:
-					case MB_VMETER_SET3:
-						break;
-					case MB_SAMPLE_ANGLE_SET:
-						//sample_moto_ctl( usRegHoldingBuf[iRegIndex] );
-						break;
-					case MB_SAMPLE_CTL	:
-						//sample_monitor_ctl(usRegHoldingBuf[iRegIndex]);
-						break;
-					case MB_SAMPLE_HOLE0:
-						break;
-					case MB_SAMPLE_START:
-						//sample_monitor_start(usRegHoldingBuf[iRegIndex]);
-						break;
-					case MB_SAMPLE_INTERVAL:
-						//sample_monitor_interval(usRegHoldingBuf[iRegIndex]);
-						break;
-					case MB_SAMPLE_LED :
-						sample_led_ctl( usRegHoldingBuf[iRegIndex] );
-						break;
-					case MB_BAFFLE:
-						baffle_ctl( usRegHoldingBuf[iRegIndex] );
-						break;
-					case MB_BLEED_VALVE:
-						bleed_valve_ctl(usRegHoldingBuf[iRegIndex]);
-						break;
-					case MB_BAFFLE_INTERVAL:
-						//sample_baffle_interval();
-						break;
-					case MB_SYS_AUTOCTL:
-						break;
-					case MB_MOTOR_CTRL:
-						//motor_ctrl(usRegHoldingBuf[iRegIndex]);
-						break;
-					//-----------------------------------------------------------				
-					/*case MB_RELAY_SET:
-						mb_bit_fun ( usRegHoldingBuf[iRegIndex], ON, relay_set_ch );
-						reg_count ++;
-						break;
-					case MB_RELAY_CLR:
-						mb_bit_fun ( usRegHoldingBuf[iRegIndex], OFF, relay_set_ch );
-						reg_count ++;
-						break;
-					case MB_DO_SET:
-						//mb_bit_fun ( usRegHoldingBuf[iRegIndex], ON, io_set_ch );
-						reg_count ++;
-						break;
-					case MB_DO_CLR:
-						//mb_bit_fun ( usRegHoldingBuf[iRegIndex], OFF, io_set_ch );
-						reg_count ++;
-						break;*/
-					case MB_SMS_SERVER:
-					case MB_SMS_SERVER1:
-					case MB_SMS_SERVER2:
-					case MB_SMS_SERVER3:
-					case MB_SMS_SERVER4:
-					case MB_SMS_SERVER5:
-					case MB_SMS_SERVER6:
-					case MB_SMS_SERVER7:
-					case MB_SMS_SERVER8:
-					case MB_SMS_SERVER9:
-						//sms_center[2*(reg_addr-MB_SMS_SERVER)  ] = usRegHoldingBuf[iRegIndex]>>8;
-						//sms_center[2*(reg_addr-MB_SMS_SERVER)+1] = usRegHoldingBuf[iRegIndex];
-						break;
-					case MB_SMS_PHONE:
-					case MB_SMS_PHONE1:
-					case MB_SMS_PHONE2:
-					case MB_SMS_PHONE3:
-					case MB_SMS_PHONE4:
-					case MB_SMS_PHONE5:
-					case MB_SMS_PHONE6:
-					case MB_SMS_PHONE7:
-					case MB_SMS_PHONE8:
-					case MB_SMS_PHONE9:
-						//sms_phone[2*(reg_addr-MB_SMS_PHONE)  ] = usRegHoldingBuf[iRegIndex]>>8;
-						//sms_phone[2*(reg_addr-MB_SMS_PHONE)+1] = usRegHoldingBuf[iRegIndex];
-						break;
-					case MB_SMS_TEXT:
-					case MB_SMS_TEXT1:
-					case MB_SMS_TEXT2:
-					case MB_SMS_TEXT3:
-					case MB_SMS_TEXT4:
-					case MB_SMS_TEXT5:
-					case MB_SMS_TEXT6:
-					case MB_SMS_TEXT7:
-					case MB_SMS_TEXT8:
-					case MB_SMS_TEXT9:
-					case MB_SMS_TEXT10:
-					case MB_SMS_TEXT11:
-					case MB_SMS_TEXT12:
-					case MB_SMS_TEXT13:
-					case MB_SMS_TEXT14:
-					case MB_SMS_TEXT15:
-					case MB_SMS_TEXT16:
-					case MB_SMS_TEXT17:
-					case MB_SMS_TEXT18:
-					case MB_SMS_TEXT19:
-					case MB_SMS_TEXT20:
-					case MB_SMS_TEXT21:
-					case MB_SMS_TEXT22:
-					case MB_SMS_TEXT23:
-					case MB_SMS_TEXT24:
-					case MB_SMS_TEXT25:
-					case MB_SMS_TEXT26:
-					case MB_SMS_TEXT27:
-					case MB_SMS_TEXT28:
-					case MB_SMS_TEXT29:
-					case MB_SMS_TEXT30:
-					case MB_SMS_TEXT31:
-					case MB_SMS_TEXT32:
-					case MB_SMS_TEXT33:
-					case MB_SMS_TEXT34:
-					case MB_SMS_TEXT35:
-					case MB_SMS_TEXT36:
-					case MB_SMS_TEXT37:
-					case MB_SMS_TEXT38:
-					case MB_SMS_TEXT39:
-					case MB_SMS_TEXT40:
-					case MB_SMS_TEXT41:
-					case MB_SMS_TEXT42:
-					case MB_SMS_TEXT43:
-					case MB_SMS_TEXT44:
-					case MB_SMS_TEXT45:
-					case MB_SMS_TEXT46:
-					case MB_SMS_TEXT47:
-					case MB_SMS_TEXT48:
-					case MB_SMS_TEXT49:
-					case MB_SMS_TEXT50:
-					case MB_SMS_TEXT51:
-					case MB_SMS_TEXT52:
-					case MB_SMS_TEXT53:
-					case MB_SMS_TEXT54:
-					case MB_SMS_TEXT55:
-					case MB_SMS_TEXT56:
-					case MB_SMS_TEXT57:
-					case MB_SMS_TEXT58:
-					case MB_SMS_TEXT59:
-					case MB_SMS_TEXT60:
-					case MB_SMS_TEXT61:
-					case MB_SMS_TEXT62:
-					case MB_SMS_TEXT63:
-						//sms_text[2*(reg_addr-MB_SMS_TEXT)  ] = usRegHoldingBuf[iRegIndex]>>8;
-						//sms_text[2*(reg_addr-MB_SMS_TEXT)+1] = usRegHoldingBuf[iRegIndex];
-						break;
-					case MB_SMS_CMD:
-						if ( usRegHoldingBuf[iRegIndex] & MB_SMS_SEND ){
-							//usart_printf(DBGU,"debug>sms_center:%s\r\n",sms_center);	
-							//usart_printf(DBGU,"debug>sms_phone:%s\r\n",sms_phone);	
-							//usart_printf(DBGU,"debug>sms_text:%s\r\n",sms_text);	
-							//gsmSendMessage(&sm_param,sms_text);
-							//gsmSendMessage(&sm_param,"AL-900系统信息\r\n您所制备的样品已经完成，系统将进入自动停机程序?);
-						}
-						break;
-					case MB_DAC0:
-					case MB_DAC1:
-					case MB_DAC2:
-					case MB_DAC3:
-					case MB_DAC4:
-					case MB_DAC5:
-					case MB_DAC6:
-					case MB_DAC7:
-						PWM_DAC_Set(iRegIndex - MB_DAC0, usRegHoldingBuf[iRegIndex]);
-						break;
-		/*			case MB_FD110A:
-						FD110A_ctl(usRegHoldingBuf[iRegIndex]);
-						//reg_count ++;
-						break;
-					case MB_BEEP_ON:
-						reg_count ++;
-						beep_set(usRegHoldingBuf[iRegIndex], (reg_buf[reg_count*2]<<8) | reg_buf[reg_count*2 + 1] );
-						//reg_count ++;
-						break;
-					case MB_LED_ON:
-					case MB_LED_OFF:
-						led(usRegHoldingBuf[iRegIndex]);
-						//reg_count ++;
-						break;
-					case MB_L298_CTL:
-						l298n(usRegHoldingBuf[iRegIndex]>>8, usRegHoldingBuf[iRegIndex]&0x0F);
-						//reg_count ++;
-						break;
-				*/	case MB_GSM_CTL:
-						//uartswSendStr(usRegHoldingBuf[iRegIndex]);
-					default :
-						break;				}		
-				
- 				vPortExitCritical();
-                iRegIndex++;
-                usNRegs--;
-            }
+			/* Commit the whole block first, the side effects below run
+			 * outside of any critical section, once per region. */
+			prvMBRegCommitBytes( usRegHoldingBuf, &ulRegHoldingSeq, iRegIndex, pucRegBuffer, usNRegs );
+			prvMBRegNotify( iRegIndex, usNRegs );
+			prvMBRegHooks( iRegIndex, usNRegs );
+            break;
         }
     }
     else
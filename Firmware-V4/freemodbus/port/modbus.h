@@ -37,12 +37,60 @@ extern volatile USHORT   usRegHoldingBuf[REG_HOLDING_NREGS];
 void modbus_tcp_appcall(void);
 void modbus_tcp_init(void);
 
+// Modbus/UDP on port 502, MBAP framed like TCP, needs UIP_CONF_UDP
+void modbus_udp_appcall(void);
+void modbus_udp_init(void);
+
 USHORT eMBRegHolding_Read( USHORT usAddress );
 void eMBRegHolding_Write( USHORT usAddress, USHORT usRegVal );
 USHORT eMBRegInput_Read( USHORT usAddress );
 void eMBRegInput_Write( USHORT usAddress, USHORT usRegVal );
 
-void vMBTCPSlaveTask( void *pvParameters );
+// block access, a block is committed and read back as one consistent snapshot
+BOOL eMBRegHolding_ReadBlock( USHORT usAddress, USHORT * pusRegs, USHORT usNRegs );
+BOOL eMBRegHolding_WriteBlock( USHORT usAddress, const USHORT * pusRegs, USHORT usNRegs );
+BOOL eMBRegInput_ReadBlock( USHORT usAddress, USHORT * pusRegs, USHORT usNRegs );
+BOOL eMBRegInput_WriteBlock( USHORT usAddress, const USHORT * pusRegs, USHORT usNRegs );
+
+// holding register write notification. A watch collects the addresses the
+// host wrote in its range in a dirty bitmap and calls pxNotify from the
+// writer (Modbus or uIP task), pxNotify must not block. FreeRTOS 6 has no
+// task notifications or event groups, so the subscriber is woken by the
+// callback, e.g. with sched_trigger() or xSemaphoreGive().
+// eMBRegHolding_Write/WriteBlock are local writes, the firmware publishing
+// its own state, they mark nothing. Writes the operator makes on the panel
+// go through eMBRegHolding_WriteNotify, which is handled as a host write:
+// it marks the watches and runs the register side effects.
+#define MB_REG_WATCH_MAX	4
+#define MB_REG_WATCH_WORDS	( ( REG_HOLDING_NREGS + 31 ) / 32 )
+
+typedef struct
+{
+	USHORT		usStart;		// watched holding range
+	USHORT		usNRegs;
+	void		( *pxNotify )( void *pvArg );	// optional
+	void	   *pvArg;
+	volatile ULONG ulDirty[MB_REG_WATCH_WORDS];	// by holding address
+} xMBRegWatch;
+
+BOOL eMBRegHolding_Watch( xMBRegWatch * pxWatch );
+BOOL eMBRegHolding_TakeDirty( xMBRegWatch * pxWatch, USHORT usAddress, USHORT usNRegs );
+BOOL eMBRegHolding_TakeDirtyMap( xMBRegWatch * pxWatch, ULONG * pulDirty );
+BOOL eMBRegHolding_WriteNotify( USHORT usAddress, const USHORT * pusRegs, USHORT usNRegs );
+#define MB_REG_DIRTY( pulDirty, usAddress ) \
+	( ( ( pulDirty )[( usAddress ) >> 5] >> ( ( usAddress ) & 31 ) ) & 1 )
+
+// one RTU slave per serial port, each task gets its own, NULL runs the
+// default slave on USART1
+typedef struct
+{
+	UCHAR		ucPort;			// 0 USART1, 1 USART2, 2 USART3
+	UCHAR		ucAddress;
+	ULONG		ulBaudRate;
+	eMBParity	eParity;
+	sMBControl	xMBC;			// instance state, kept off the task stack
+} xMBRTUSlave;
+
 void vMBRTUSlaveTask( void *pvParameters );
 
 #endif
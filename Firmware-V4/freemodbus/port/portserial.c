@@ -32,14 +32,17 @@
 #include "serials.h"
 
 /* ----------------------- Defines ------------------------------------------*/
+#define MB_SERIAL_PORTS         ( 3 )
 
-/* ----------------------- Start implementation -----------------------------*/
-USART_TypeDef* MB_UART_Dev;
+/* ----------------------- Static variables ---------------------------------*/
+static USART_TypeDef * const xMBUartDev[MB_SERIAL_PORTS] = { USART1, USART2, USART3 };
 
-/* ----------------------- -------------------- -----------------------------*/
+/* The instance each port was bound to by xMBPortSerialInit( ). */
+static sMBControl *pxMBSerialInstance[MB_SERIAL_PORTS];
 
+/* ----------------------- Start implementation -----------------------------*/
 BOOL
-xMBPortSerialInit( UCHAR ucPort, ULONG ulBaudRate, UCHAR ucDataBits, eMBParity Parity )
+xMBPortSerialInit( sMBControl * sMBC, UCHAR ucPort, ULONG ulBaudRate, UCHAR ucDataBits, eMBParity Parity )
 {
 	eCOMPort ePort;
 	eBaud eWantedBaud;
@@ -49,10 +52,10 @@ xMBPortSerialInit( UCHAR ucPort, ULONG ulBaudRate, UCHAR ucDataBits, eMBParity P
 	BOOL ret;
 
     switch ( ucPort ){
-		case 0: 	ePort = serCOM1;MB_UART_Dev = USART1; break;
-		case 1: 	ePort = serCOM2;MB_UART_Dev = USART2; break;
-		case 2: 	ePort = serCOM3;MB_UART_Dev = USART3; break;
-		default :	ePort = serCOM1;MB_UART_Dev = USART1; break;
+		case 0: 	ePort = serCOM1; break;
+		case 1: 	ePort = serCOM2; break;
+		case 2: 	ePort = serCOM3; break;
+		default :	return FALSE;
 	}
 	
 	switch ( ulBaudRate ){
@@ -80,78 +83,98 @@ xMBPortSerialInit( UCHAR ucPort, ULONG ulBaudRate, UCHAR ucDataBits, eMBParity P
 	    default:eWantedDataBits = serBITS_8; break;
     }
 
+	pxMBSerialInstance[ucPort] = sMBC;
 	ret = xSerialPortBaseInit( ePort, eWantedBaud, eWantedParity, eWantedDataBits, eWantedStopBits );
-	vMBPortSerialEnable( FALSE, FALSE );
+	vMBPortSerialEnable( ucPort, FALSE, FALSE );
 	
 	return ret;
 }
 
 void
-vMBPortSerialEnable( BOOL xRxEnable, BOOL xTxEnable )
+vMBPortSerialEnable( UCHAR ucPort, BOOL xRxEnable, BOOL xTxEnable )
 {
+	USART_TypeDef *pxDev = xMBUartDev[ucPort];
+
     if( xRxEnable )
-		USART_ITConfig( MB_UART_Dev, USART_IT_RXNE, ENABLE );
+		USART_ITConfig( pxDev, USART_IT_RXNE, ENABLE );
     else
-		USART_ITConfig( MB_UART_Dev, USART_IT_RXNE, DISABLE );
+		USART_ITConfig( pxDev, USART_IT_RXNE, DISABLE );
 
     if( xTxEnable )
-		USART_ITConfig( MB_UART_Dev, USART_IT_TXE, ENABLE );		
+		USART_ITConfig( pxDev, USART_IT_TXE, ENABLE );		
     else
-		USART_ITConfig( MB_UART_Dev, USART_IT_TXE, DISABLE );		
+		USART_ITConfig( pxDev, USART_IT_TXE, DISABLE );		
 }
 
 BOOL
-xMBPortSerialPutByte( CHAR ucByte )
+xMBPortSerialPutByte( UCHAR ucPort, CHAR ucByte )
 {
-	USART_SendData( MB_UART_Dev, ucByte );
+	USART_SendData( xMBUartDev[ucPort], ucByte );
     return TRUE;
 }
 
 BOOL
-xMBPortSerialGetByte( CHAR * pucByte )
+xMBPortSerialGetByte( UCHAR ucPort, CHAR * pucByte )
 {
-	*pucByte = USART_ReceiveData( MB_UART_Dev );
+	*pucByte = USART_ReceiveData( xMBUartDev[ucPort] );
     return TRUE;
 }
 
-BOOL
-prvMBPortTXIsEnabled(  )
-{
-	return (BOOL)(MB_UART_Dev->CR1 & (1<<7) );
-}
-
-BOOL
-prvMBPortRXIsEnabled(  )
-{
-	return (BOOL)(MB_UART_Dev->CR1 & (1<<5) );
-}
-#if 1
-void
-USART1_IRQHandler( void )
+/* Common body of the USART interrupts. Only the instance bound to the
+ * port is touched, so slaves on other ports keep running undisturbed.
+ */
+static void
+prvvMBPortSerialISR( UCHAR ucPort )
 {
-    static BOOL     xTaskWokenReceive = FALSE;
-    static BOOL     xTaskWokenTransmit = FALSE;
-	
-    portENTER_SWITCHING_ISR(  );
+	USART_TypeDef *pxDev = xMBUartDev[ucPort];
+	sMBControl *sMBC = pxMBSerialInstance[ucPort];
+    portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
 
-    if( prvMBPortTXIsEnabled(  ) && USART_GetITStatus( MB_UART_Dev, USART_IT_TXE ) )
+    if( ( pxDev->CR1 & USART_CR1_TXEIE ) && USART_GetITStatus( pxDev, USART_IT_TXE ) )
     {
-        xTaskWokenTransmit = pxMBFrameCBTransmitterEmpty(  );
+        if( sMBC->pxMBFrameCBTransmitterEmpty( sMBC ) )
+            xHigherPriorityTaskWoken = pdTRUE;
     }
-    if( prvMBPortRXIsEnabled(  ) && USART_GetITStatus( MB_UART_Dev, USART_IT_RXNE ) )
+    if( ( pxDev->CR1 & USART_CR1_RXNEIE ) && USART_GetITStatus( pxDev, USART_IT_RXNE ) )
     {
-        xTaskWokenReceive = pxMBFrameCBByteReceived(  );
+        if( sMBC->pxMBFrameCBByteReceived( sMBC ) )
+            xHigherPriorityTaskWoken = pdTRUE;
     }
 
-    portEXIT_SWITCHING_ISR( ( xTaskWokenReceive
-                              || xTaskWokenTransmit ) ? pdTRUE : pdFALSE );
+    portEND_SWITCHING_ISR( xHigherPriorityTaskWoken );
+}
+
+#if MB_PORT_USART1_ENABLED > 0
+void
+USART1_IRQHandler( void )
+{
+	prvvMBPortSerialISR( 0 );
 }
 #endif
+
+#if MB_PORT_USART2_ENABLED > 0
 void
-vMBPortClose(  )
+USART2_IRQHandler( void )
 {
-    /* Release resources for the event queue. */
-    vMBPortEventClose( xMBSerialEventQueue );
+	prvvMBPortSerialISR( 1 );
 }
+#endif
 
+#if MB_PORT_USART3_ENABLED > 0
+void
+USART3_IRQHandler( void )
+{
+	prvvMBPortSerialISR( 2 );
+}
+#endif
 
+void
+vMBPortClose( sMBControl * sMBC )
+{
+	vMBPortSerialEnable( sMBC->ucPort, FALSE, FALSE );
+	vMBPortTimersDisable( sMBC->ucPort );
+	pxMBSerialInstance[sMBC->ucPort] = NULL;
+
+    /* Release resources for the event queue. */
+    vMBPortEventClose( sMBC->xMBEventQueue );
+}
@@ -37,51 +37,77 @@
 #include "mbport.h"
 
 /* ----------------------- MBAP Header --------------------------------------*/
-#define MB_TCP_UID          6
+#define MB_TCP_TID          0
+#define MB_TCP_PID          2
 #define MB_TCP_LEN          4
+#define MB_TCP_UID          6
 #define MB_TCP_FUNC         7
 
 /* ----------------------- Defines  -----------------------------------------*/
 #define MB_TCP_DEFAULT_PORT 502 /* TCP listening port. */
 #define MB_TCP_BUF_SIZE     ( 256 + 7 ) /* Must hold a complete Modbus TCP frame. */
 
-#define uxModbusQueueLength	1
+/* uIP has ACKed a segment by the time it is delivered, so what is held back
+ * of it has to fit whole: a split request and one segment of the size we
+ * advertise. Once the held requests leave less room than that the
+ * connection is stopped and uIP takes no more until it is restarted. */
+#define MB_TCP_RX_SIZE      ( MB_TCP_BUF_SIZE + UIP_TCP_MSS )
+
+/* Response buffers are shared by all connections and taken only while a
+ * connection has answers queued or in flight. One buffer holds several
+ * pipelined answers; a new request is only taken on while there is room
+ * for a full size answer. */
+#define MB_TCP_POOL_SIZE    3
+#define MB_TCP_TX_SIZE      ( 3 * MB_TCP_BUF_SIZE )
+
+#if UIP_CONNS > 8
+#error "ucMBTCPPoolWait has a bit per connection"
+#endif
 
 typedef struct
 {
-  unsigned short len;
-  char 	buf[MB_TCP_BUF_SIZE];
-} xModbusMessage;
-
+    UCHAR          *pucTxBuf;   /* From the pool, NULL when nothing is queued. */
+    USHORT          usTxLen;    /* Answers queued, the ones in flight first. */
+    USHORT          usTxSent;   /* In flight, sent again as is on rexmit. */
+    USHORT          usRxLen;    /* A split request or requests held back. */
+    BOOL            xBlocked;   /* A complete request waits for buffer room. */
+    UCHAR           aucRxBuf[MB_TCP_RX_SIZE];
+} xMBTCPConn;
 
 /* ----------------------- Prototypes ---------------------------------------*/
 void            vMBPortLog( eMBPortLogLevel eLevel, const CHAR * szModule,
                             const CHAR * szFmt, ... );
 
 /* ----------------------- Static variables ---------------------------------*/
-/* The queue used to send messages to the modbus task. */
-xQueueHandle xModbusTCPRxQueue, xModbusTCPTxQueue;
-xQueueHandle xMBTCPEventQueue;
-xModbusMessage xMessage;
+/* The TCP slave instance. Requests are answered from the uIP task, so only
+ * its function handler table is used. */
+static sMBControl xMBTCPControl;
+
+static xMBTCPConn xMBTCPConns[UIP_CONNS];
+static UCHAR    aucMBTCPPool[MB_TCP_POOL_SIZE][MB_TCP_TX_SIZE];
+static UCHAR    ucMBTCPPoolUsed;
+static UCHAR    ucMBTCPPoolWait;    /* Connections blocked on an empty pool. */
 
 /* ----------------------- Static functions ---------------------------------*/
+static UCHAR   *prvMBTCPPoolGet( xMBTCPConn * pxConn );
+static void     prvMBTCPPoolPut( UCHAR * pucBuf );
+static void     prvMBTCPReset( xMBTCPConn * pxConn );
+static USHORT   prvMBTCPExecute( UCHAR * pucFrame, USHORT usFrameLen );
+static int      prvMBTCPConsume( xMBTCPConn * pxConn, const UCHAR * pucData, USHORT usLen );
+static BOOL     prvMBTCPReceive( xMBTCPConn * pxConn, const UCHAR * pucData, USHORT usLen );
 
 /* ----------------------- Begin implementation -----------------------------*/
 BOOL
 xMBTCPPortInit( USHORT usTCPPort )
 {
-	/* Create the queues used to hold Rx/Tx Msg. */
-	xModbusTCPRxQueue = xQueueCreate( uxModbusQueueLength, ( unsigned portBASE_TYPE ) sizeof( xModbusMessage ) );
-	xModbusTCPTxQueue = xQueueCreate( uxModbusQueueLength, ( unsigned portBASE_TYPE ) sizeof( xModbusMessage ) );
-	
-	return TRUE;
+    return TRUE;
 }
 
 void
-vMBTCPPortClose(  )
+vMBTCPPortClose( sMBControl * sMBC )
 {
     /* Release resources for the event queue. */
-    vMBPortEventClose( xMBTCPEventQueue );
+    vMBPortEventClose( sMBC->xMBEventQueue );
 }
 
 void
@@ -89,113 +115,318 @@ vMBTCPPortDisable( void )
 {
 }
 
-
+/* Frames never go through the Modbus task, modbus_tcp_appcall() parses and
+ * answers them inside the uIP task. */
 BOOL
 xMBTCPPortGetRequest( UCHAR ** ppucMBTCPFrame, USHORT * usTCPLength )
 {
-	if ( xQueueReceive( xModbusTCPRxQueue, &xMessage, 10/portTICK_RATE_MS ) == pdTRUE ){
-	    *ppucMBTCPFrame = (UCHAR*)xMessage.buf;
-	    *usTCPLength = xMessage.len;
-	
-	    return TRUE;
-	}
-	return FALSE;
+    return FALSE;
 }
 
 BOOL
 xMBTCPPortSendResponse( const UCHAR * pucMBTCPFrame, USHORT usTCPLength )
 {
-    BOOL bFrameSent = FALSE;
+    return FALSE;
+}
+
+/*---------------------------------------------------------------------------*/
+/* While some connection waits for a buffer, a freed one goes to a waiting
+ * connection and not to whichever busy client gets its next segment in
+ * first, so a blocked connection is not starved by the others. */
+static UCHAR   *
+prvMBTCPPoolGet( xMBTCPConn * pxConn )
+{
+    UCHAR           ucMask = 1 << ( pxConn - xMBTCPConns );
+    UCHAR           i;
+
+    if( ( ucMBTCPPoolWait == 0 ) || ( ucMBTCPPoolWait & ucMask ) )
+    {
+        for( i = 0; i < MB_TCP_POOL_SIZE; i++ )
+        {
+            if( ( ucMBTCPPoolUsed & ( 1 << i ) ) == 0 )
+            {
+                ucMBTCPPoolUsed |= 1 << i;
+                ucMBTCPPoolWait &= ~ucMask;
+                return aucMBTCPPool[i];
+            }
+        }
+    }
+    ucMBTCPPoolWait |= ucMask;
+    return NULL;
+}
+
+static void
+prvMBTCPPoolPut( UCHAR * pucBuf )
+{
+    ucMBTCPPoolUsed &= ~( 1 << ( ( pucBuf - aucMBTCPPool[0] ) / MB_TCP_TX_SIZE ) );
+}
+
+static void
+prvMBTCPReset( xMBTCPConn * pxConn )
+{
+    if( pxConn->pucTxBuf != NULL )
+    {
+        prvMBTCPPoolPut( pxConn->pucTxBuf );
+    }
+    pxConn->pucTxBuf = NULL;
+    pxConn->usTxLen = 0;
+    pxConn->usTxSent = 0;
+    pxConn->usRxLen = 0;
+    pxConn->xBlocked = FALSE;
+    ucMBTCPPoolWait &= ~( 1 << ( pxConn - xMBTCPConns ) );
+}
+
+/* Answer the request in pucFrame in place, the frame must have room for a
+ * full size answer. Returns the length of the answer with its MBAP header. */
+static USHORT
+prvMBTCPExecute( UCHAR * pucFrame, USHORT usFrameLen )
+{
+    USHORT          usLength = usFrameLen - MB_TCP_FUNC;
+    UCHAR           ucFunctionCode = pucFrame[MB_TCP_FUNC];
+    eMBException    eException;
 
-	if( xQueueSend( xModbusTCPTxQueue, pucMBTCPFrame, configTICK_RATE_HZ*10 ) == pdPASS )
-	{
-		bFrameSent = TRUE;
-	#ifdef MB_TCP_DEBUG
-	//	prvvMBTCPLogFrame( "MBTCP-SENT", xMessage.buf, usTCPLength );
-	#endif
-	}
-    return bFrameSent;
+    eException = eMBFuncExecute( &xMBTCPControl, &pucFrame[MB_TCP_FUNC], &usLength );
+    if( eException != MB_EX_NONE )
+    {
+        usLength = 0;
+        pucFrame[MB_TCP_FUNC + usLength++] = ucFunctionCode | MB_FUNC_ERROR;
+        pucFrame[MB_TCP_FUNC + usLength++] = eException;
+    }
+
+    /* The length field counts the unit identifier and the PDU. */
+    pucFrame[MB_TCP_LEN] = ( usLength + 1 ) >> 8U;
+    pucFrame[MB_TCP_LEN + 1] = ( usLength + 1 ) & 0xFF;
+    return MB_TCP_FUNC + usLength;
 }
 
+/* Answer the complete requests at the front of the data, in order, so the
+ * answers carry their transaction IDs back in the order they were asked.
+ * Each request is copied once into the response buffer and the handler
+ * answers it there. Stops at a split request or when the buffer may not
+ * hold another answer. Returns the bytes used, -1 on a bad MBAP header. */
+static int
+prvMBTCPConsume( xMBTCPConn * pxConn, const UCHAR * pucData, USHORT usLen )
+{
+    USHORT          usUsed = 0;
+    USHORT          usFrameLen;
+    UCHAR          *pucFrame;
+
+    pxConn->xBlocked = FALSE;
+    while( usLen - usUsed >= MB_TCP_FUNC )
+    {
+        usFrameLen = MB_TCP_UID + ( ( pucData[usUsed + MB_TCP_LEN] << 8U ) | pucData[usUsed + MB_TCP_LEN + 1] );
+        if( ( usFrameLen <= MB_TCP_FUNC ) || ( usFrameLen > MB_TCP_BUF_SIZE ) )
+        {
+            return -1;
+        }
+        if( usLen - usUsed < usFrameLen )
+        {
+            break;
+        }
+
+        if( pxConn->pucTxBuf == NULL )
+        {
+            pxConn->pucTxBuf = prvMBTCPPoolGet( pxConn );
+        }
+        if( ( pxConn->pucTxBuf == NULL ) || ( MB_TCP_TX_SIZE - pxConn->usTxLen < MB_TCP_BUF_SIZE ) ||
+            ( ( pxConn->usTxSent > 0 ) && ( ucMBTCPPoolWait & ~( 1 << ( pxConn - xMBTCPConns ) ) ) ) )
+        {
+            /* Also once answers are in flight while another connection
+             * waits for a buffer: this one drains and goes back to the pool
+             * instead of being topped up for as long as the client asks. */
+            pxConn->xBlocked = TRUE;
+            break;
+        }
+
+        /* Only protocol 0 is Modbus, anything else is dropped. */
+        if( ( pucData[usUsed + MB_TCP_PID] | pucData[usUsed + MB_TCP_PID + 1] ) == 0 )
+        {
+            pucFrame = pxConn->pucTxBuf + pxConn->usTxLen;
+            memcpy( pucFrame, pucData + usUsed, usFrameLen );
+            pxConn->usTxLen += prvMBTCPExecute( pucFrame, usFrameLen );
+        }
+        usUsed += usFrameLen;
+    }
+    return usUsed;
+}
+
+/* Take new stream data. Whole requests are answered straight from the uIP
+ * buffer; only a split request or the requests left when the response
+ * buffer is full are kept in the connection. Returns FALSE if the data
+ * cannot be kept, only a peer sending past the MSS we advertised does that. */
+static BOOL
+prvMBTCPReceive( xMBTCPConn * pxConn, const UCHAR * pucData, USHORT usLen )
+{
+    int             iUsed;
+    USHORT          usCopy;
+
+    for( ;; )
+    {
+        if( pxConn->usRxLen > 0 )
+        {
+            if( ( iUsed = prvMBTCPConsume( pxConn, pxConn->aucRxBuf, pxConn->usRxLen ) ) < 0 )
+            {
+                return FALSE;
+            }
+            pxConn->usRxLen -= iUsed;
+            memmove( pxConn->aucRxBuf, pxConn->aucRxBuf + iUsed, pxConn->usRxLen );
+        }
+        if( ( pxConn->usRxLen == 0 ) && ( usLen > 0 ) )
+        {
+            if( ( iUsed = prvMBTCPConsume( pxConn, pucData, usLen ) ) < 0 )
+            {
+                return FALSE;
+            }
+            pucData += iUsed;
+            usLen -= iUsed;
+        }
+        if( usLen == 0 )
+        {
+            break;
+        }
+
+        usCopy = sizeof( pxConn->aucRxBuf ) - pxConn->usRxLen;
+        if( usCopy == 0 )
+        {
+            return FALSE;
+        }
+        if( usCopy > usLen )
+        {
+            usCopy = usLen;
+        }
+        memcpy( pxConn->aucRxBuf + pxConn->usRxLen, pucData, usCopy );
+        pxConn->usRxLen += usCopy;
+        pucData += usCopy;
+        usLen -= usCopy;
+    }
+    return TRUE;
+}
 
 /*---------------------------------------------------------------------------*/
-//static struct modbus_tcp_state s;
-#if 1 
 void
 modbus_tcp_init(void)
 {
-  	uip_listen(HTONS(502));
+    UCHAR           i;
+
+    for( i = 0; i < UIP_CONNS; i++ )
+    {
+        xMBTCPConns[i].pucTxBuf = NULL;
+        prvMBTCPReset( &xMBTCPConns[i] );
+    }
+    ucMBTCPPoolUsed = 0;
+    ucMBTCPPoolWait = 0;
+    ( void )eMBTCPInit( &xMBTCPControl, MB_TCP_DEFAULT_PORT );
+  	uip_listen(HTONS(MB_TCP_DEFAULT_PORT));
 }
 
 /*---------------------------------------------------------------------------*/
-static void
-senddata(void)
+void
+modbus_tcp_appcall(void)
 {
-	if ( xQueueReceive( xModbusTCPTxQueue, uip_appdata, 10/portTICK_RATE_MS ) == pdPASS ){
-		uip_send(uip_appdata, ((((u8_t*)uip_appdata)[MB_TCP_LEN]<<8) | ((u8_t*)uip_appdata)[MB_TCP_LEN+1])-1+MB_TCP_FUNC );
-	}
+    xMBTCPConn     *pxConn = &xMBTCPConns[uip_conn - uip_conns];
+    USHORT          usSend;
+
+    if( uip_connected() )
+    {
+        prvMBTCPReset( pxConn );
+    }
+
+    if( uip_closed() || uip_aborted() || uip_timedout() )
+    {
+        prvMBTCPReset( pxConn );
+        return;
+    }
+
+    if( uip_acked() && ( pxConn->usTxSent > 0 ) )
+    {
+        pxConn->usTxLen -= pxConn->usTxSent;
+        memmove( pxConn->pucTxBuf, pxConn->pucTxBuf + pxConn->usTxSent, pxConn->usTxLen );
+        pxConn->usTxSent = 0;
+        if( pxConn->usTxLen == 0 )
+        {
+            /* Drained, new requests take a buffer in turn with the others. */
+            prvMBTCPPoolPut( pxConn->pucTxBuf );
+            pxConn->pucTxBuf = NULL;
+        }
+    }
+
+    if( uip_newdata() && !prvMBTCPReceive( pxConn, uip_appdata, uip_datalen() ) )
+    {
+        /* A broken header, or a segment larger than we said we take. */
+        prvMBTCPReset( pxConn );
+        uip_abort();
+        return;
+    }
+
+    /* Requests held back for buffer room go first once there is some. */
+    if( pxConn->xBlocked && ( pxConn->usRxLen > 0 ) )
+    {
+        ( void )prvMBTCPReceive( pxConn, NULL, 0 );
+    }
+    if( pxConn->xBlocked || ( sizeof( pxConn->aucRxBuf ) - pxConn->usRxLen < UIP_TCP_MSS ) )
+    {
+        uip_stop();
+    }
+    else if( uip_stopped( uip_conn ) )
+    {
+        uip_restart();
+    }
+
+    if( uip_rexmit() )
+    {
+        uip_send( pxConn->pucTxBuf, pxConn->usTxSent );
+    }
+    else if( ( pxConn->usTxSent == 0 ) && ( pxConn->usTxLen > 0 ) )
+    {
+        usSend = pxConn->usTxLen;
+        if( usSend > uip_mss() )
+        {
+            usSend = uip_mss();
+        }
+        uip_send( pxConn->pucTxBuf, usSend );
+        pxConn->usTxSent = usSend;
+    }
+
+    if( ( pxConn->usTxLen == 0 ) && ( pxConn->pucTxBuf != NULL ) )
+    {
+        prvMBTCPPoolPut( pxConn->pucTxBuf );
+        pxConn->pucTxBuf = NULL;
+    }
 }
+
+#if UIP_UDP
 /*---------------------------------------------------------------------------*/
-static void
-newdata(void)
-{
-	u16_t len,usLength;
-
-	len = uip_datalen();	
-    if( len >= MB_TCP_FUNC )
-    {
-        /* Length is a byte count of Modbus PDU (function code + data) and the
-         * unit identifier. */
-        usLength  = ((u8_t*)uip_appdata)[MB_TCP_LEN] << 8U;
-        usLength |= ((u8_t*)uip_appdata)[MB_TCP_LEN + 1];
-
-        /* Is the frame already complete. */
-        if( len >= ( MB_TCP_UID + usLength ) ) {
-			*((u8_t*)uip_appdata - 2) = len;
-			if( xQueueSend( xModbusTCPRxQueue, (u8_t*)uip_appdata-2, 1000/portTICK_RATE_MS ) == pdPASS ){
-				if ( xMBTCPEventQueue )
-					( void )xMBPortEventPost( xMBTCPEventQueue, EV_FRAME_RECEIVED );
-			}
-		}
-	}
+/* Modbus/UDP: the same MBAP frames as TCP, one request per datagram and the
+ * answer goes back in the same buffer. Nothing is kept between datagrams,
+ * a lost answer is asked again by the master. */
+void
+modbus_udp_init( void )
+{
+    struct uip_udp_conn *pxUDP;
+
+    pxUDP = uip_udp_new( NULL, 0 );
+    if( pxUDP != NULL )
+    {
+        uip_udp_bind( pxUDP, HTONS( MB_TCP_DEFAULT_PORT ) );
+    }
 }
-/*---------------------------------------------------------------------------*/
 
 void
-modbus_tcp_appcall(void)
+modbus_udp_appcall( void )
 {
-  //struct modbus_tcp_state *s = (struct modbus_tcp_state *)&(uip_conn->appstate);
-  
-  if(uip_connected()) {
-    /*    tcp_markconn(uip_conn, &s);*/
-    //s->state = STATE_NORMAL;
-  }
-
-  //if(s->state == STATE_CLOSE) {
-    //s->state = STATE_NORMAL;
-  //  uip_close();
-  //  return;
-  //}
-  
-  if(uip_closed() ||
-     uip_aborted() ||
-     uip_timedout()) {
-  }
-  
-  if(uip_acked()) {
-  }
-  
-  if(uip_newdata()) {
-    newdata();
-  }
-  
-  if(uip_rexmit() ||
-     uip_newdata() ||
-     uip_acked() ||
-     uip_connected() ||
-     uip_poll()) {
-    senddata();
-  }
+    UCHAR          *pucFrame = uip_appdata;
+    USHORT          usFrameLen;
+
+    if( !uip_newdata(  ) || ( uip_datalen(  ) <= MB_TCP_FUNC ) || ( uip_datalen(  ) > MB_TCP_BUF_SIZE ) )
+    {
+        return;
+    }
+    usFrameLen = MB_TCP_UID + ( ( pucFrame[MB_TCP_LEN] << 8U ) | pucFrame[MB_TCP_LEN + 1] );
+    if( ( usFrameLen != uip_datalen(  ) ) || ( ( pucFrame[MB_TCP_PID] | pucFrame[MB_TCP_PID + 1] ) != 0 ) )
+    {
+        return;
+    }
+
+    uip_udp_send( prvMBTCPExecute( pucFrame, usFrameLen ) );
 }
 #endif
-
@@ -36,7 +36,7 @@
 #include "mbport.h"
 
 /* ----------------------- Defines ------------------------------------------*/
-#define MB_TIMER_DEV            ( TIM2 )
+#define MB_TIMER_PORTS          ( 3 )
 #define MB_TIMER_PRESCALER      ( 255UL )
 #define MB_IRQ_PRIORITY         ( configLIBRARY_KERNEL_INTERRUPT_PRIORITY )
 
@@ -45,98 +45,134 @@
  */
 #define MB_TIMER_TICKS          ( 20000UL )
 
+/* ----------------------- Type definitions ---------------------------------*/
+typedef struct
+{
+    TIM_TypeDef    *pxDev;
+    uint32_t        ulRCC;
+    IRQn_Type       xIRQ;
+} xMBTimerDev;
 
 /* ----------------------- Static variables ---------------------------------*/
-static USHORT   usTimerDeltaOCRA;
+/* One timer per serial port, port 0 keeps TIM2. All sit on APB1. */
+static const xMBTimerDev xMBTimers[MB_TIMER_PORTS] = {
+    { TIM2, RCC_APB1Periph_TIM2, TIM2_IRQn },
+    { TIM6, RCC_APB1Periph_TIM6, TIM6_IRQn },
+    { TIM7, RCC_APB1Periph_TIM7, TIM7_IRQn },
+};
+
+static USHORT   usTimerDeltaOCRA[MB_TIMER_PORTS];
+static sMBControl *pxMBTimerInstance[MB_TIMER_PORTS];
 
 
 /* ----------------------- Start implementation -----------------------------*/
 BOOL
-xMBPortTimersInit( USHORT usTim1Timerout50us )
+xMBPortTimersInit( sMBControl * sMBC, USHORT usTim1Timerout50us )
 {
-
-//	unsigned long ulFrequency;
 	TIM_TimeBaseInitTypeDef TIM_TimeBaseStructure;
 	NVIC_InitTypeDef 		NVIC_InitStructure;
-//	TIM_OCInitTypeDef  		TIM_OCInitStructure;
+	TIM_TypeDef			   *pxDev;
+	UCHAR					ucPort = sMBC->ucPort;
 
-    /* Calculate output compare value for timer1. */
-    usTimerDeltaOCRA =
+	if( ucPort >= MB_TIMER_PORTS )
+		return FALSE;
+	pxDev = xMBTimers[ucPort].pxDev;
+
+    /* Calculate output compare value for the timer. */
+    usTimerDeltaOCRA[ucPort] =
         ( ( configCPU_CLOCK_HZ / ( MB_TIMER_PRESCALER + 1 ) ) *
           usTim1Timerout50us ) / ( MB_TIMER_TICKS );
 
 	/* Enable timer clocks */
-	RCC_APB1PeriphClockCmd( RCC_APB1Periph_TIM2, ENABLE );
+	RCC_APB1PeriphClockCmd( xMBTimers[ucPort].ulRCC, ENABLE );
 
 	/* Initialise data. */
-	TIM_DeInit( MB_TIMER_DEV );
+	TIM_DeInit( pxDev );
 	TIM_TimeBaseStructInit( &TIM_TimeBaseStructure );
 
-	/* Time base configuration for timer 2. */
-	TIM_TimeBaseStructure.TIM_Period = usTimerDeltaOCRA;
+	/* Time base configuration. */
+	TIM_TimeBaseStructure.TIM_Period = usTimerDeltaOCRA[ucPort];
 	TIM_TimeBaseStructure.TIM_Prescaler = MB_TIMER_PRESCALER;
 	TIM_TimeBaseStructure.TIM_ClockDivision = 0;
 	TIM_TimeBaseStructure.TIM_CounterMode = TIM_CounterMode_Up;
-	TIM_TimeBaseInit( MB_TIMER_DEV, &TIM_TimeBaseStructure );
-	TIM_ARRPreloadConfig( MB_TIMER_DEV, DISABLE );
+	TIM_TimeBaseInit( pxDev, &TIM_TimeBaseStructure );
+	TIM_ARRPreloadConfig( pxDev, DISABLE );
 	
-	/* PWM1 Mode configuration: Channel1 */
-/*	TIM_OCInitStructure.TIM_OCMode = TIM_OCMode_Timing;
-	TIM_OCInitStructure.TIM_OutputState = TIM_OutputState_Disable;
-	TIM_OCInitStructure.TIM_Pulse = usTimerDeltaOCRA;
-	TIM_OCInitStructure.TIM_OCPolarity = TIM_OCPolarity_High;
-	TIM_OC1Init(MB_TIMER_DEV, &TIM_OCInitStructure);
-	TIM_OC1PreloadConfig(MB_TIMER_DEV, TIM_OCPreload_Enable);
-*/		
-	/* Enable TIM2 IT. */
-	NVIC_InitStructure.NVIC_IRQChannel = TIM2_IRQn;
+	/* Enable the timer IT. */
+	NVIC_InitStructure.NVIC_IRQChannel = xMBTimers[ucPort].xIRQ;
 	NVIC_InitStructure.NVIC_IRQChannelSubPriority = 0;
 	NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = MB_IRQ_PRIORITY;
 	NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
 	NVIC_Init( &NVIC_InitStructure );	
-	//TIM_ITConfig( MB_TIMER_DEV, TIM_IT_Update, ENABLE );
 
-	/* Finally, enable timers. */
-	//TIM_Cmd( MB_TIMER_DEV, ENABLE );
-	
-    vMBPortTimersDisable(  );
+    vMBPortTimersDisable( ucPort );
+	pxMBTimerInstance[ucPort] = sMBC;
 
     return TRUE;
 }
 
-void
-TIM2_IRQHandler( void )
+/* Common body of the timer interrupts, see prvvMBPortSerialISR( ). */
+static void
+prvvMBPortTimerISR( UCHAR ucPort )
 {
-    static portBASE_TYPE xTaskSwitch = pdFALSE;
-
-    portENTER_SWITCHING_ISR(  );
+	TIM_TypeDef *pxDev = xMBTimers[ucPort].pxDev;
+	sMBControl *sMBC = pxMBTimerInstance[ucPort];
+    portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
 
-    if( ( usTimerDeltaOCRA > 0 ) && ( TIM_GetITStatus( MB_TIMER_DEV, TIM_IT_Update ) ) )
+    if( ( sMBC != NULL ) && ( usTimerDeltaOCRA[ucPort] > 0 ) &&
+        ( TIM_GetITStatus( pxDev, TIM_IT_Update ) ) )
     {
-        xTaskSwitch = pxMBPortCBTimerExpired(  );
+        if( sMBC->pxMBPortCBTimerExpired( sMBC ) )
+            xHigherPriorityTaskWoken = pdTRUE;
     }
 
-   	TIM_ClearFlag( MB_TIMER_DEV, TIM_IT_Update );
-    portEXIT_SWITCHING_ISR( xTaskSwitch );
+   	TIM_ClearFlag( pxDev, TIM_IT_Update );
+    portEND_SWITCHING_ISR( xHigherPriorityTaskWoken );
 }
 
 void
-vMBPortTimersEnable(  )
+TIM2_IRQHandler( void )
 {
-	if( usTimerDeltaOCRA > 0 )
+	prvvMBPortTimerISR( 0 );
+}
+
+#if MB_PORT_USART2_ENABLED > 0
+void
+TIM6_IRQHandler( void )
+{
+	prvvMBPortTimerISR( 1 );
+}
+#endif
+
+#if MB_PORT_USART3_ENABLED > 0
+void
+TIM7_IRQHandler( void )
+{
+	prvvMBPortTimerISR( 2 );
+}
+#endif
+
+void
+vMBPortTimersEnable( UCHAR ucPort )
+{
+	TIM_TypeDef *pxDev = xMBTimers[ucPort].pxDev;
+
+	if( usTimerDeltaOCRA[ucPort] > 0 )
     {
-		TIM_SetCounter( MB_TIMER_DEV, 0 );
-		TIM_ClearFlag( MB_TIMER_DEV, TIM_FLAG_Update );
-		TIM_ITConfig ( MB_TIMER_DEV, TIM_IT_Update, ENABLE );
-		TIM_Cmd( MB_TIMER_DEV, ENABLE );
+		TIM_SetCounter( pxDev, 0 );
+		TIM_ClearFlag( pxDev, TIM_FLAG_Update );
+		TIM_ITConfig ( pxDev, TIM_IT_Update, ENABLE );
+		TIM_Cmd( pxDev, ENABLE );
     }
 }
 
 void
-vMBPortTimersDisable(  )
+vMBPortTimersDisable( UCHAR ucPort )
 {
+	TIM_TypeDef *pxDev = xMBTimers[ucPort].pxDev;
+
     /* We can always clear both flags. This improves performance. */
-    TIM_ClearFlag( MB_TIMER_DEV, TIM_FLAG_Update );
-    TIM_ITConfig ( MB_TIMER_DEV, TIM_IT_Update, DISABLE );
-	TIM_Cmd( MB_TIMER_DEV, DISABLE );
+    TIM_ClearFlag( pxDev, TIM_FLAG_Update );
+    TIM_ITConfig ( pxDev, TIM_IT_Update, DISABLE );
+	TIM_Cmd( pxDev, DISABLE );
 }
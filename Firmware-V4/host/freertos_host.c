@@ -0,0 +1,643 @@
+/*
+ * FreeRTOS stand-ins for the host build, see host.h.  Tasks are ucontext
+ * coroutines, queues and semaphores are plain ring buffers.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ucontext.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+
+#include "host.h"
+
+/* A wait on portMAX_DELAY from the test that no task or hook ends within
+this many ticks is a hung test, not a slow one. */
+#define hostMAX_WAIT		( ( portTickType ) 3600000 )
+
+#define hostMAX_HOOKS		16
+#define hostMAX_TASKS		16
+#define hostSTACK_SIZE		( 256 * 1024 )
+
+/* xA is xB or later, ticks wrap. */
+#define hostREACHED( xA, xB )	( ( portTickType ) ( ( xA ) - ( xB ) ) < ( portMAX_DELAY >> 1 ) )
+
+typedef struct
+{
+	unsigned portBASE_TYPE uxLength;
+	unsigned portBASE_TYPE uxItemSize;
+	unsigned portBASE_TYPE uxWaiting;
+	unsigned portBASE_TYPE uxHead;
+	unsigned char *pucItems;
+} xHostQueue;
+
+typedef enum
+{
+	eHostReady,
+	eHostBlocked,
+	eHostDeleted
+} eHostTaskState;
+
+typedef struct
+{
+	const char *pcName;
+	pdTASK_CODE pvTaskCode;
+	void *pvParameters;
+	unsigned portBASE_TYPE uxPriority;
+	eHostTaskState eState;
+	xHostQueue *pxWaitQueue;		/* NULL while only delayed */
+	portBASE_TYPE xTimed;
+	portTickType xFrom;				/* timed: ready at xFrom + xTicks */
+	portTickType xTicks;
+	ucontext_t xContext;
+} xHostTCB;
+
+xHostKernelStats xHostStats;
+unsigned long ulRunTimeStatsClock;
+
+static portTickType xTick;
+static pdHOST_HOOK pxHooks[ hostMAX_HOOKS ];
+static unsigned portBASE_TYPE uxHooks;
+static xHostTCB *pxTasks[ hostMAX_TASKS ];
+/* Static, not malloc()ed, to stay below 4 GB like the rest of the image. */
+static unsigned char ucStacks[ hostMAX_TASKS ][ hostSTACK_SIZE ] __attribute__( ( aligned( 16 ) ) );
+static unsigned portBASE_TYPE uxTasks;
+static unsigned portBASE_TYPE uxLastRun;
+static xHostTCB *pxCurrentTCB;
+static ucontext_t xMainContext;
+static unsigned portBASE_TYPE uxCriticalNesting;
+static unsigned portBASE_TYPE uxSuspended;
+
+/*-----------------------------------------------------------
+ * Scheduling.
+ *----------------------------------------------------------*/
+
+void vHostReset( void )
+{
+	unsigned portBASE_TYPE ux;
+
+	if( pxCurrentTCB != NULL )
+	{
+		fprintf( stderr, "host: vHostReset() from a task\n" );
+		abort();
+	}
+	for( ux = 0; ux < uxTasks; ux++ )
+	{
+		free( pxTasks[ ux ] );
+	}
+	uxTasks = 0;
+	uxLastRun = 0;
+	xTick = 0;
+	uxHooks = 0;
+	uxCriticalNesting = 0;
+	uxSuspended = 0;
+	memset( &xHostStats, 0, sizeof( xHostStats ) );
+}
+
+void vHostAddTickHook( pdHOST_HOOK pxHook )
+{
+	if( uxHooks >= hostMAX_HOOKS )
+	{
+		fprintf( stderr, "host: more than %d tick hooks\n", hostMAX_HOOKS );
+		abort();
+	}
+	pxHooks[ uxHooks++ ] = pxHook;
+}
+
+/* The highest priority ready task, equal ones in turn. */
+static xHostTCB *prvNextReady( void )
+{
+	xHostTCB *pxBest = NULL;
+	unsigned portBASE_TYPE ux, uxIndex, uxBest = 0;
+
+	for( ux = 1; ux <= uxTasks; ux++ )
+	{
+		uxIndex = ( uxLastRun + ux ) % uxTasks;
+		if( pxTasks[ uxIndex ]->eState == eHostReady &&
+			( pxBest == NULL || pxTasks[ uxIndex ]->uxPriority > pxBest->uxPriority ) )
+		{
+			pxBest = pxTasks[ uxIndex ];
+			uxBest = uxIndex;
+		}
+	}
+	if( pxBest != NULL )
+	{
+		uxLastRun = uxBest;
+	}
+	return pxBest;
+}
+
+/* Run tasks until every one is blocked. */
+static void prvRunReady( void )
+{
+	xHostTCB *pxTCB;
+
+	while( ( pxTCB = prvNextReady() ) != NULL )
+	{
+		pxCurrentTCB = pxTCB;
+		xHostStats.ulSwitches++;
+		swapcontext( &xMainContext, &pxTCB->xContext );
+		pxCurrentTCB = NULL;
+	}
+}
+
+/* One tick: the hooks, then the tasks whose delay or timeout ended. */
+static void prvTickStep( void )
+{
+	unsigned portBASE_TYPE ux;
+
+	xTick++;
+	ulRunTimeStatsClock++;
+	for( ux = 0; ux < uxHooks; ux++ )
+	{
+		pxHooks[ ux ]();
+	}
+	for( ux = 0; ux < uxTasks; ux++ )
+	{
+		if( pxTasks[ ux ]->eState == eHostBlocked && pxTasks[ ux ]->xTimed &&
+			( portTickType ) ( xTick - pxTasks[ ux ]->xFrom ) >= pxTasks[ ux ]->xTicks )
+		{
+			pxTasks[ ux ]->eState = eHostReady;
+		}
+	}
+}
+
+void vHostRun( portTickType xTicks )
+{
+	portTickType xEnd = xTick + xTicks;
+
+	if( pxCurrentTCB != NULL )
+	{
+		fprintf( stderr, "host: vHostRun() from a task\n" );
+		abort();
+	}
+	prvRunReady();
+	while( xTick != xEnd )
+	{
+		prvTickStep();
+		prvRunReady();
+	}
+}
+
+/* Give the CPU back to the scheduler until the task is ready again. */
+static void prvSwitchOut( void )
+{
+	xHostTCB *pxTCB = pxCurrentTCB;
+
+	swapcontext( &pxTCB->xContext, &xMainContext );
+}
+
+static void prvBlock( xHostQueue *pxQueue, portBASE_TYPE xTimed, portTickType xTicks )
+{
+	pxCurrentTCB->pxWaitQueue = pxQueue;
+	pxCurrentTCB->xTimed = xTimed;
+	pxCurrentTCB->xFrom = xTick;
+	pxCurrentTCB->xTicks = xTicks;
+	pxCurrentTCB->eState = eHostBlocked;
+	prvSwitchOut();
+}
+
+/* Let a task above the running one have the CPU. */
+static void prvPreempt( void )
+{
+	unsigned portBASE_TYPE ux;
+
+	if( pxCurrentTCB == NULL || uxSuspended > 0 )
+	{
+		return;
+	}
+	for( ux = 0; ux < uxTasks; ux++ )
+	{
+		if( pxTasks[ ux ]->eState == eHostReady && pxTasks[ ux ]->uxPriority > pxCurrentTCB->uxPriority )
+		{
+			prvSwitchOut();
+			return;
+		}
+	}
+}
+
+/* The queue changed, its waiters look again. */
+static void prvWakeWaiters( xHostQueue *pxQueue )
+{
+	unsigned portBASE_TYPE ux;
+
+	for( ux = 0; ux < uxTasks; ux++ )
+	{
+		if( pxTasks[ ux ]->eState == eHostBlocked && pxTasks[ ux ]->pxWaitQueue == pxQueue )
+		{
+			pxTasks[ ux ]->eState = eHostReady;
+		}
+	}
+}
+
+/* Wait until xReady( pxQueue ) holds or xTicksToWait have gone by. */
+static signed portBASE_TYPE prvWait( xHostQueue *pxQueue, portBASE_TYPE ( *xReady )( xHostQueue * ), portTickType xTicksToWait )
+{
+	portTickType xFrom = xTick, xLimit = xTicksToWait, xGone;
+	portBASE_TYPE xTimed = ( xTicksToWait != portMAX_DELAY );
+
+	if( xReady( pxQueue ) )
+	{
+		return pdTRUE;
+	}
+	if( xTicksToWait == 0 )
+	{
+		return pdFALSE;
+	}
+
+	xHostStats.ulBlocked++;
+	if( !xTimed && pxCurrentTCB == NULL )
+	{
+		xTimed = pdTRUE;
+		xLimit = hostMAX_WAIT;
+	}
+	for( ;; )
+	{
+		if( pxCurrentTCB != NULL )
+		{
+			prvBlock( pxQueue, xTimed, xLimit - ( xTick - xFrom ) );
+		}
+		else
+		{
+			prvRunReady();
+		}
+		if( xReady( pxQueue ) )
+		{
+			return pdTRUE;
+		}
+		xGone = xTick - xFrom;
+		if( xTimed && xGone >= xLimit )
+		{
+			if( pxCurrentTCB == NULL && xTicksToWait == portMAX_DELAY )
+			{
+				fprintf( stderr, "host: the test blocked forever at tick %u\n", ( unsigned ) xTick );
+				abort();
+			}
+			xHostStats.ulTimeouts++;
+			return pdFALSE;
+		}
+		if( pxCurrentTCB == NULL )
+		{
+			prvTickStep();
+		}
+	}
+}
+
+static portBASE_TYPE prvHasItem( xHostQueue *pxQueue )
+{
+	return pxQueue->uxWaiting > 0;
+}
+
+static portBASE_TYPE prvHasRoom( xHostQueue *pxQueue )
+{
+	return pxQueue->uxWaiting < pxQueue->uxLength;
+}
+
+/*-----------------------------------------------------------
+ * Tasks.
+ *----------------------------------------------------------*/
+
+static void prvTaskEntry( void )
+{
+	xHostTCB *pxTCB = pxCurrentTCB;
+
+	pxTCB->pvTaskCode( pxTCB->pvParameters );
+
+	/* A task function must not return, on the target this is a fault. */
+	fprintf( stderr, "host: task %s returned\n", pxTCB->pcName );
+	abort();
+}
+
+signed portBASE_TYPE xTaskGenericCreate( pdTASK_CODE pvTaskCode, const signed char * const pcName, unsigned short usStackDepth, void *pvParameters, unsigned portBASE_TYPE uxPriority, xTaskHandle *pxCreatedTask, portSTACK_TYPE *puxStackBuffer, const xMemoryRegion * const xRegions )
+{
+	xHostTCB *pxTCB;
+
+	( void ) usStackDepth;
+	( void ) puxStackBuffer;
+	( void ) xRegions;
+
+	if( uxTasks >= hostMAX_TASKS )
+	{
+		return errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
+	}
+	pxTCB = calloc( 1, sizeof( xHostTCB ) );
+	pxTCB->pcName = ( const char * ) pcName;
+	pxTCB->pvTaskCode = pvTaskCode;
+	pxTCB->pvParameters = pvParameters;
+	pxTCB->uxPriority = uxPriority < configMAX_PRIORITIES ? uxPriority : configMAX_PRIORITIES - 1;
+	pxTCB->eState = eHostReady;
+
+	getcontext( &pxTCB->xContext );
+	pxTCB->xContext.uc_stack.ss_sp = ucStacks[ uxTasks ];
+	pxTCB->xContext.uc_stack.ss_size = hostSTACK_SIZE;
+	pxTCB->xContext.uc_link = NULL;
+	makecontext( &pxTCB->xContext, prvTaskEntry, 0 );
+
+	pxTasks[ uxTasks++ ] = pxTCB;
+	if( pxCreatedTask != NULL )
+	{
+		*pxCreatedTask = pxTCB;
+	}
+	prvPreempt();
+	return pdPASS;
+}
+
+void vTaskDelete( xTaskHandle pxTask )
+{
+	xHostTCB *pxTCB = ( pxTask != NULL ) ? pxTask : pxCurrentTCB;
+
+	pxTCB->eState = eHostDeleted;
+	if( pxTCB == pxCurrentTCB )
+	{
+		prvSwitchOut();
+	}
+}
+
+xTaskHandle xTaskGetCurrentTaskHandle( void )
+{
+	return pxCurrentTCB;
+}
+
+unsigned portBASE_TYPE uxTaskPriorityGet( xTaskHandle pxTask )
+{
+	xHostTCB *pxTCB = ( pxTask != NULL ) ? pxTask : pxCurrentTCB;
+
+	return pxTCB != NULL ? pxTCB->uxPriority : tskIDLE_PRIORITY;
+}
+
+portTickType xTaskGetTickCount( void )
+{
+	return xTick;
+}
+
+static void prvDelay( portTickType xTicks )
+{
+	if( pxCurrentTCB != NULL )
+	{
+		prvBlock( NULL, pdTRUE, xTicks );
+	}
+	else
+	{
+		vHostRun( xTicks );
+	}
+}
+
+void vTaskDelay( portTickType xTicksToDelay )
+{
+	if( xTicksToDelay == 0 )
+	{
+		prvPreempt();
+		return;
+	}
+	prvDelay( xTicksToDelay );
+}
+
+void vTaskDelayUntil( portTickType * const pxPreviousWakeTime, portTickType xTimeIncrement )
+{
+	portTickType xWake = *pxPreviousWakeTime + xTimeIncrement;
+
+	*pxPreviousWakeTime = xWake;
+	if( !hostREACHED( xTick, xWake ) )
+	{
+		prvDelay( xWake - xTick );
+	}
+}
+
+void vTaskList( signed char *pcWriteBuffer )
+{
+	unsigned portBASE_TYPE ux;
+
+	*pcWriteBuffer = 0;
+	for( ux = 0; ux < uxTasks; ux++ )
+	{
+		sprintf( ( char * ) pcWriteBuffer + strlen( ( char * ) pcWriteBuffer ), "%s\t%u\r\n",
+				 pxTasks[ ux ]->pcName, ( unsigned ) pxTasks[ ux ]->uxPriority );
+	}
+}
+
+void vTaskGetRunTimeStats( signed char *pcWriteBuffer )
+{
+	vTaskList( pcWriteBuffer );
+}
+
+void vTaskSuspendAll( void )
+{
+	uxSuspended++;
+	xHostStats.ulSuspendAll++;
+}
+
+signed portBASE_TYPE xTaskResumeAll( void )
+{
+	if( uxSuspended > 0 && --uxSuspended == 0 )
+	{
+		prvPreempt();
+	}
+	return pdFALSE;
+}
+
+/*-----------------------------------------------------------
+ * Port layer.
+ *----------------------------------------------------------*/
+
+void vPortYieldFromISR( void )
+{
+	xHostStats.ulYields++;
+	prvPreempt();
+}
+
+void vPortSetInterruptMask( void )
+{
+}
+
+void vPortClearInterruptMask( void )
+{
+}
+
+void vPortEnterCritical( void )
+{
+	if( uxCriticalNesting++ == 0 )
+	{
+		xHostStats.ulCritical++;
+	}
+	if( uxCriticalNesting > xHostStats.ulCriticalMax )
+	{
+		xHostStats.ulCriticalMax = uxCriticalNesting;
+	}
+}
+
+void vPortExitCritical( void )
+{
+	if( uxCriticalNesting > 0 )
+	{
+		uxCriticalNesting--;
+	}
+}
+
+unsigned portBASE_TYPE uxHostCriticalNesting( void )
+{
+	return uxCriticalNesting;
+}
+
+void *pvPortMalloc( size_t xSize )
+{
+	return malloc( xSize );
+}
+
+void vPortFree( void *pv )
+{
+	free( pv );
+}
+
+/*-----------------------------------------------------------
+ * Queues and semaphores.
+ *----------------------------------------------------------*/
+
+xQueueHandle xQueueCreate( unsigned portBASE_TYPE uxQueueLength, unsigned portBASE_TYPE uxItemSize )
+{
+	xHostQueue *pxQueue;
+
+	pxQueue = calloc( 1, sizeof( xHostQueue ) );
+	if( pxQueue == NULL )
+	{
+		return NULL;
+	}
+	pxQueue->uxLength = uxQueueLength;
+	pxQueue->uxItemSize = uxItemSize;
+	pxQueue->pucItems = calloc( uxQueueLength, uxItemSize ? uxItemSize : 1 );
+	return pxQueue;
+}
+
+void vQueueDelete( xQueueHandle xQueue )
+{
+	xHostQueue *pxQueue = xQueue;
+
+	free( pxQueue->pucItems );
+	free( pxQueue );
+}
+
+xQueueHandle xQueueCreateMutex( void )
+{
+	xHostQueue *pxQueue = xQueueCreate( 1, 0 );
+
+	pxQueue->uxWaiting = 1;
+	return pxQueue;
+}
+
+xQueueHandle xQueueCreateCountingSemaphore( unsigned portBASE_TYPE uxCountValue, unsigned portBASE_TYPE uxInitialCount )
+{
+	xHostQueue *pxQueue = xQueueCreate( uxCountValue, 0 );
+
+	pxQueue->uxWaiting = uxInitialCount;
+	return pxQueue;
+}
+
+static void prvCopyIn( xHostQueue *pxQueue, const void *pvItem, portBASE_TYPE xPosition )
+{
+	unsigned portBASE_TYPE uxSlot;
+
+	if( xPosition == queueSEND_TO_FRONT )
+	{
+		pxQueue->uxHead = ( pxQueue->uxHead + pxQueue->uxLength - 1 ) % pxQueue->uxLength;
+		uxSlot = pxQueue->uxHead;
+	}
+	else
+	{
+		uxSlot = ( pxQueue->uxHead + pxQueue->uxWaiting ) % pxQueue->uxLength;
+	}
+	if( pxQueue->uxItemSize > 0 )
+	{
+		memcpy( pxQueue->pucItems + uxSlot * pxQueue->uxItemSize, pvItem, pxQueue->uxItemSize );
+	}
+	pxQueue->uxWaiting++;
+	prvWakeWaiters( pxQueue );
+}
+
+static void prvCopyOut( xHostQueue *pxQueue, void *pvBuffer, portBASE_TYPE xJustPeek )
+{
+	if( pxQueue->uxItemSize > 0 )
+	{
+		memcpy( pvBuffer, pxQueue->pucItems + pxQueue->uxHead * pxQueue->uxItemSize, pxQueue->uxItemSize );
+	}
+	if( !xJustPeek )
+	{
+		pxQueue->uxHead = ( pxQueue->uxHead + 1 ) % pxQueue->uxLength;
+		pxQueue->uxWaiting--;
+		prvWakeWaiters( pxQueue );
+	}
+}
+
+signed portBASE_TYPE xQueueGenericSend( xQueueHandle xQueue, const void * const pvItemToQueue, portTickType xTicksToWait, portBASE_TYPE xCopyPosition )
+{
+	xHostQueue *pxQueue = xQueue;
+
+	if( !prvWait( pxQueue, prvHasRoom, xTicksToWait ) )
+	{
+		return errQUEUE_FULL;
+	}
+	prvCopyIn( pxQueue, pvItemToQueue, xCopyPosition );
+	prvPreempt();
+	return pdPASS;
+}
+
+signed portBASE_TYPE xQueueGenericReceive( xQueueHandle xQueue, void * const pvBuffer, portTickType xTicksToWait, portBASE_TYPE xJustPeek )
+{
+	xHostQueue *pxQueue = xQueue;
+
+	if( !prvWait( pxQueue, prvHasItem, xTicksToWait ) )
+	{
+		return errQUEUE_EMPTY;
+	}
+	prvCopyOut( pxQueue, pvBuffer, xJustPeek );
+	prvPreempt();
+	return pdPASS;
+}
+
+signed portBASE_TYPE xQueueGenericSendFromISR( xQueueHandle pxQueue, const void * const pvItemToQueue, signed portBASE_TYPE *pxHigherPriorityTaskWoken, portBASE_TYPE xCopyPosition )
+{
+	if( !prvHasRoom( pxQueue ) )
+	{
+		return errQUEUE_FULL;
+	}
+	prvCopyIn( pxQueue, pvItemToQueue, xCopyPosition );
+	if( pxHigherPriorityTaskWoken != NULL )
+	{
+		*pxHigherPriorityTaskWoken = pdTRUE;
+	}
+	return pdPASS;
+}
+
+signed portBASE_TYPE xQueueReceiveFromISR( xQueueHandle pxQueue, void * const pvBuffer, signed portBASE_TYPE *pxTaskWoken )
+{
+	( void ) pxTaskWoken;
+
+	if( !prvHasItem( pxQueue ) )
+	{
+		return pdFAIL;
+	}
+	prvCopyOut( pxQueue, pvBuffer, pdFALSE );
+	return pdPASS;
+}
+
+unsigned portBASE_TYPE uxQueueMessagesWaiting( const xQueueHandle xQueue )
+{
+	return ( ( const xHostQueue * ) xQueue )->uxWaiting;
+}
+
+unsigned portBASE_TYPE uxQueueMessagesWaitingFromISR( const xQueueHandle xQueue )
+{
+	return ( ( const xHostQueue * ) xQueue )->uxWaiting;
+}
+
+signed portBASE_TYPE xQueueIsQueueEmptyFromISR( const xQueueHandle pxQueue )
+{
+	return ( ( const xHostQueue * ) pxQueue )->uxWaiting == 0;
+}
+
+signed portBASE_TYPE xQueueIsQueueFullFromISR( const xQueueHandle pxQueue )
+{
+	return !prvHasRoom( ( xHostQueue * ) pxQueue );
+}
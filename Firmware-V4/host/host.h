@@ -0,0 +1,54 @@
+#ifndef HOST_H
+#define HOST_H
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/*
+ * Simulated time for the host build.
+ *
+ * Tasks made with xTaskCreate() run as coroutines on the test's thread, each
+ * on its own stack.  The highest priority task that is ready runs until it
+ * blocks, delays or wakes a task above it; code takes no simulated time.
+ * When every task is blocked the tick steps by one, the tick hooks run and
+ * the tasks whose delay or timeout ended become ready again.  The hooks are
+ * where the peripheral models and the peers on the serial lines and the
+ * network act, they may call the FromISR functions like an interrupt does.
+ * Time runs as fast as the host can step it.
+ *
+ * The test itself is not a task.  vHostRun() lets the tasks run for a number
+ * of ticks and returns with them suspended where they were.  A kernel call
+ * from the test that has to wait runs the tasks and the ticks until it can go
+ * on, or until its timeout ends, as it would on the target.
+ */
+
+typedef void ( *pdHOST_HOOK )( void );
+
+/* Tick 0, no tasks, no hooks and all counters cleared. */
+void vHostReset( void );
+
+/* Call pxHook after every tick, in the order added. */
+void vHostAddTickHook( pdHOST_HOOK pxHook );
+
+/* Run the tasks for xTicks ticks. */
+void vHostRun( portTickType xTicks );
+
+/* Critical sections the caller is in, for the models that check what the
+   code does inside one. */
+unsigned portBASE_TYPE uxHostCriticalNesting( void );
+
+/* What the code under test did with the kernel. */
+typedef struct
+{
+	unsigned long ulSwitches;		/* times a task was resumed */
+	unsigned long ulCritical;		/* taskENTER_CRITICAL() sections */
+	unsigned long ulCriticalMax;	/* most nested */
+	unsigned long ulSuspendAll;		/* vTaskSuspendAll() calls */
+	unsigned long ulBlocked;		/* calls that had to wait */
+	unsigned long ulTimeouts;		/* calls whose timeout ran out */
+	unsigned long ulYields;			/* yields asked for from an ISR */
+} xHostKernelStats;
+
+extern xHostKernelStats xHostStats;
+
+#endif
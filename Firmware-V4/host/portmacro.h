@@ -0,0 +1,59 @@
+#ifndef PORTMACRO_H
+#define PORTMACRO_H
+
+/*
+ * FreeRTOS port macros for the host build.  The types have the widths of the
+ * Cortex-M3 port so tick arithmetic wraps as on the target, the scheduler
+ * calls go to the stand-ins in host/freertos_host.c.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define portCHAR		char
+#define portFLOAT		float
+#define portDOUBLE		double
+#define portLONG		int
+#define portSHORT		short
+#define portSTACK_TYPE	unsigned portLONG
+#define portBASE_TYPE	long
+
+#if( configUSE_16_BIT_TICKS == 1 )
+	typedef unsigned portSHORT portTickType;
+	#define portMAX_DELAY ( portTickType ) 0xffff
+#else
+	typedef unsigned portLONG portTickType;
+	#define portMAX_DELAY ( portTickType ) 0xffffffff
+#endif
+
+#define portSTACK_GROWTH			( -1 )
+#define portTICK_RATE_MS			( ( portTickType ) 1000 / configTICK_RATE_HZ )
+#define portBYTE_ALIGNMENT			8
+
+extern void vPortYieldFromISR( void );
+extern void vPortSetInterruptMask( void );
+extern void vPortClearInterruptMask( void );
+extern void vPortEnterCritical( void );
+extern void vPortExitCritical( void );
+
+#define portYIELD()					vPortYieldFromISR()
+#define portEND_SWITCHING_ISR( xSwitchRequired ) if( xSwitchRequired ) vPortYieldFromISR()
+
+#define portDISABLE_INTERRUPTS()				vPortSetInterruptMask()
+#define portENABLE_INTERRUPTS()					vPortClearInterruptMask()
+#define portENTER_CRITICAL()					vPortEnterCritical()
+#define portEXIT_CRITICAL()						vPortExitCritical()
+#define portSET_INTERRUPT_MASK_FROM_ISR()		0;vPortSetInterruptMask()
+#define portCLEAR_INTERRUPT_MASK_FROM_ISR(x)	vPortClearInterruptMask();(void)x
+
+#define portTASK_FUNCTION_PROTO( vFunction, pvParameters ) void vFunction( void *pvParameters )
+#define portTASK_FUNCTION( vFunction, pvParameters ) void vFunction( void *pvParameters )
+
+#define portNOP()
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PORTMACRO_H */
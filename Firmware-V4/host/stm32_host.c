@@ -0,0 +1,19 @@
+/*
+ * Register memory for the host build, see stm32f10x.h.
+ */
+
+#include <string.h>
+
+#include "stm32f10x.h"
+
+uint32_t ulHostPeriph[ HOST_PERIPH_SIZE / 4 ];
+uint32_t ulHostScs[ HOST_SCS_SIZE / 4 ];
+
+/* system_stm32f10x.c is not built, the clock is the one SystemInit() sets. */
+uint32_t SystemCoreClock = 72000000;
+
+void vHostPeriphReset( void )
+{
+	memset( ulHostPeriph, 0, sizeof( ulHostPeriph ) );
+	memset( ulHostScs, 0, sizeof( ulHostScs ) );
+}
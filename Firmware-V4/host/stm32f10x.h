@@ -0,0 +1,31 @@
+#ifndef __STM32F10X_HOST_H
+#define __STM32F10X_HOST_H
+
+/*
+ * The device header for the host build.  The CMSIS header and the StdPeriph
+ * drivers are used as they are, only the peripheral and core register blocks
+ * move from their fixed addresses into host memory (host/stm32_host.c).  The
+ * registers are plain memory: nothing changes a status bit unless a test or
+ * a peripheral model in test/ does.
+ */
+
+#include <stdint.h>
+#include "../STM32F10x_StdPeriph_Lib_V3.3.0/Libraries/CMSIS/CM3/DeviceSupport/ST/STM32F10x/stm32f10x.h"
+
+/* 0x40000000 - 0x4002FFFF, APB1, APB2 and AHB */
+#define HOST_PERIPH_SIZE	0x30000
+/* 0xE000E000 - 0xE000EFFF, SysTick, NVIC and SCB */
+#define HOST_SCS_SIZE		0x1000
+
+extern uint32_t ulHostPeriph[ HOST_PERIPH_SIZE / 4 ];
+extern uint32_t ulHostScs[ HOST_SCS_SIZE / 4 ];
+
+#undef PERIPH_BASE
+#define PERIPH_BASE			( ( uintptr_t ) ulHostPeriph )
+#undef SCS_BASE
+#define SCS_BASE			( ( uintptr_t ) ulHostScs )
+
+/* Clears every register block. */
+void vHostPeriphReset( void );
+
+#endif
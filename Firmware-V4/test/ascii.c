@@ -0,0 +1,13 @@
+/*
+ * The ASCII tables makefont reads, for test_rle.  Built with the firmware's
+ * options like gb32.c.
+ */
+
+#include "ascii0816.h"
+#include "ascii1020.h"
+#include "ascii1224.h"
+#include "ascii1632.h"
+
+const unsigned char *const pucAscii[ 4 ] = { nAsciiDot08x16, nAsciiDot10x20, nAsciiDot12x24, nAsciiDot16x32 };
+const unsigned uAsciiSize[ 4 ] = { sizeof( nAsciiDot08x16 ), sizeof( nAsciiDot10x20 ), sizeof( nAsciiDot12x24 ),
+								   sizeof( nAsciiDot16x32 ) };
@@ -0,0 +1,367 @@
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "stm32f10x.h"
+#include "SPI.h"
+
+#include "enc_model.h"
+
+void DMA1_Channel4_IRQHandler( void );
+void EXTI3_IRQHandler( void );
+
+xEncModel xEnc;
+
+/* bank 0 */
+#define ERDPT			0x00
+#define EWRPT			0x02
+#define ETXST			0x04
+#define ETXND			0x06
+#define ERXST			0x08
+#define ERXND			0x0A
+#define ERXRDPT			0x0C
+/* bank 1 */
+#define EPKTCNT			0x19
+/* bank 2 */
+#define MICMD			0x12
+#define MIREGADR		0x14
+#define MIWRH			0x17
+#define MIRD			0x18
+/* common */
+#define EIE				0x1B
+#define EIR				0x1C
+#define ESTAT			0x1D
+#define ECON2			0x1E
+#define ECON1			0x1F
+
+#define EIE_INTIE		0x80
+#define ECON1_RXRST		0x40
+#define ECON1_TXRTS		0x08
+#define ECON1_RXEN		0x04
+#define ECON2_PKTDEC	0x40
+#define EIR_PKTIF		0x40
+#define EIR_TXIF		0x08
+#define EIR_RXERIF		0x01
+#define ESTAT_CLKRDY	0x01
+
+#define DMA_CCR_EN_		( 1UL << 0 )
+#define DMA_CCR_TCIE_	( 1UL << 1 )
+#define DMA_CCR_MINC_	( 1UL << 7 )
+#define DMA_TCIF4		( 3UL << 12 )	/* GIF4 and TCIF4 */
+#define SPI_CR2_DMAEN	( 3U )			/* RXDMAEN and TXDMAEN */
+
+static uint8_t *prvReg( int iBank, int iAddr )
+{
+	return &xEnc.ucReg[ iAddr >= EIE ? 0 : iBank ][ iAddr ];
+}
+
+static int prvBank( void )
+{
+	return xEnc.ucReg[ 0 ][ ECON1 ] & 3;
+}
+
+static uint16_t prvRd16( int iBank, int iAddr )
+{
+	return *prvReg( iBank, iAddr ) | ( *prvReg( iBank, iAddr + 1 ) << 8 );
+}
+
+static void prvWr16( int iBank, int iAddr, uint16_t usVal )
+{
+	*prvReg( iBank, iAddr ) = ( uint8_t ) usVal;
+	*prvReg( iBank, iAddr + 1 ) = ( uint8_t ) ( usVal >> 8 );
+}
+
+static void prvSoftReset( void )
+{
+	memset( xEnc.ucReg, 0, sizeof( xEnc.ucReg ) );
+	xEnc.ucReg[ 0 ][ ESTAT ] = ESTAT_CLKRDY;
+	prvWr16( 0, ERXND, 0x1FFF );
+	xEnc.usWrPt = 0;
+}
+
+/* INT is active low and edge triggered at the MCU. */
+static void prvIntUpdate( void )
+{
+	int iInt = ( xEnc.ucReg[ 0 ][ EIE ] & EIE_INTIE ) &&
+		( xEnc.ucReg[ 0 ][ EIR ] & xEnc.ucReg[ 0 ][ EIE ] & ~EIE_INTIE );
+
+	if( iInt && !xEnc.iInt )
+	{
+		xEnc.iIntEdge = 1;
+	}
+	xEnc.iInt = iInt;
+}
+
+/* The frame between ETXST and ETXND goes out, the control byte first. */
+static void prvTransmit( void )
+{
+	uint16_t usSt = prvRd16( 0, ETXST ), usNd = prvRd16( 0, ETXND );
+
+	xEnc.uTxLen = usNd > usSt ? usNd - usSt : 0;
+	memcpy( xEnc.ucTx, xEnc.ucMem + usSt + 1, xEnc.uTxLen );
+	xEnc.ulTxFrames++;
+	xEnc.ucReg[ 0 ][ ECON1 ] &= ~ECON1_TXRTS;
+	xEnc.ucReg[ 0 ][ EIR ] |= EIR_TXIF;
+	if( xEnc.pxOnTx != NULL )
+	{
+		xEnc.pxOnTx( xEnc.ucTx, xEnc.uTxLen );
+	}
+}
+
+/* One byte on the bus, what comes back on MISO. */
+static uint8_t prvByte( uint8_t ucOut )
+{
+	int iBank = prvBank();
+	uint8_t ucIn = 0xFF, *pucReg;
+	uint16_t usPt;
+
+	if( !xEnc.iCs )
+	{
+		xEnc.ulErrors++;
+		return ucIn;
+	}
+	if( xEnc.iIdx++ == 0 )
+	{
+		xEnc.iOp = ucOut >> 5;
+		xEnc.iArg = ucOut & 0x1F;
+		if( ucOut == 0xFF )
+		{
+			prvSoftReset();
+		}
+		return ucIn;
+	}
+
+	pucReg = prvReg( iBank, xEnc.iArg );
+	switch( xEnc.iOp )
+	{
+		case 0:		/* RCR, MAC and MII registers send a dummy byte first */
+			if( xEnc.iIdx == 2 && ( ( iBank == 2 && xEnc.iArg <= 0x1A ) ||
+				( iBank == 3 && ( xEnc.iArg <= 0x05 || xEnc.iArg == 0x0A ) ) ) )
+			{
+				ucIn = 0;
+			}
+			else
+			{
+				ucIn = *pucReg;
+			}
+			break;
+		case 1:		/* RBM, ERDPT wraps inside the receive ring */
+			usPt = prvRd16( 0, ERDPT );
+			ucIn = xEnc.ucMem[ usPt ];
+			prvWr16( 0, ERDPT, usPt == prvRd16( 0, ERXND ) ? prvRd16( 0, ERXST ) : ( usPt + 1 ) & 0x1FFF );
+			break;
+		case 2:		/* WCR */
+			if( xEnc.iIdx != 2 )
+			{
+				break;
+			}
+			*pucReg = ucOut;
+			if( iBank == 2 && xEnc.iArg == MICMD && ( ucOut & 1 ) )
+			{
+				prvWr16( 2, MIRD, xEnc.usPhy[ xEnc.ucReg[ 2 ][ MIREGADR ] & 0x1F ] );
+			}
+			else if( iBank == 2 && xEnc.iArg == MIWRH )
+			{
+				xEnc.usPhy[ xEnc.ucReg[ 2 ][ MIREGADR ] & 0x1F ] = prvRd16( 2, MIWRH - 1 );
+			}
+			break;
+		case 3:		/* WBM */
+			usPt = prvRd16( 0, EWRPT );
+			xEnc.ucMem[ usPt ] = ucOut;
+			prvWr16( 0, EWRPT, ( usPt + 1 ) & 0x1FFF );
+			break;
+		case 4:		/* BFS */
+			if( xEnc.iIdx != 2 )
+			{
+				break;
+			}
+			*pucReg |= ucOut;
+			if( xEnc.iArg == ECON2 && ( ucOut & ECON2_PKTDEC ) )
+			{
+				*pucReg &= ~ECON2_PKTDEC;
+				if( xEnc.ucReg[ 1 ][ EPKTCNT ] == 0 )
+				{
+					xEnc.ulErrors++;
+				}
+				else if( --xEnc.ucReg[ 1 ][ EPKTCNT ] == 0 )
+				{
+					xEnc.ucReg[ 0 ][ EIR ] &= ~EIR_PKTIF;
+				}
+			}
+			if( xEnc.iArg == ECON1 && ( ucOut & ECON1_TXRTS ) )
+			{
+				prvTransmit();
+			}
+			break;
+		case 5:		/* BFC, the ring starts over as the receiver leaves reset */
+			if( xEnc.iIdx != 2 )
+			{
+				break;
+			}
+			if( xEnc.iArg == ECON1 && ( ucOut & ECON1_RXRST ) && ( *pucReg & ECON1_RXRST ) )
+			{
+				xEnc.usWrPt = prvRd16( 0, ERXST );
+			}
+			*pucReg &= ~ucOut;
+			if( xEnc.iArg == EIR && xEnc.ucReg[ 1 ][ EPKTCNT ] != 0 )
+			{
+				*pucReg |= EIR_PKTIF;
+			}
+			break;
+		default:
+			break;
+	}
+	prvIntUpdate();
+	return ucIn;
+}
+
+signed portBASE_TYPE SPI_Take( SPI_TypeDef *SPIx, portTickType delay )
+{
+	( void ) SPIx;
+	( void ) delay;
+	xEnc.iCs = 1;
+	xEnc.iIdx = 0;
+	xEnc.ulWindows++;
+	return pdTRUE;
+}
+
+signed portBASE_TYPE SPI_Give( SPI_TypeDef *SPIx )
+{
+	( void ) SPIx;
+	xEnc.iCs = 0;
+	return pdTRUE;
+}
+
+uint16_t SPI_Send( SPI_TypeDef *SPIx, uint16_t dat )
+{
+	( void ) SPIx;
+	return prvByte( ( uint8_t ) dat );
+}
+
+void vEncModelInit( void )
+{
+	memset( &xEnc, 0, sizeof( xEnc ) );
+	prvSoftReset();
+	xEnc.usPhy[ 2 ] = 0x0083;		/* PHID1 */
+	xEnc.usPhy[ 3 ] = 0x1400;		/* PHID2 */
+	xEnc.usPhy[ 1 ] = 0x0004;		/* PHSTAT1, link up */
+}
+
+int iEncModelReceive( const uint8_t *pucFrame, unsigned uLen )
+{
+	uint16_t usSt = prvRd16( 0, ERXST ), usNd = prvRd16( 0, ERXND );
+	uint16_t usRd = prvRd16( 0, ERXRDPT ), usPt = xEnc.usWrPt, usNext;
+	unsigned uRing = usNd - usSt + 1, uFree, i;
+	uint8_t ucHdr[ 6 ];
+
+	if( ( xEnc.ucReg[ 0 ][ ECON1 ] & ( ECON1_RXEN | ECON1_RXRST ) ) != ECON1_RXEN )
+	{
+		xEnc.ulRxDropped++;
+		return 0;
+	}
+	/* up to ERXRDPT, which stands just behind the next frame to read */
+	uFree = usRd == usPt ? uRing : ( usRd + uRing - usPt ) % uRing;
+	if( uLen + 8 >= uFree )
+	{
+		xEnc.ucReg[ 0 ][ EIR ] |= EIR_RXERIF;
+		xEnc.ulRxDropped++;
+		prvIntUpdate();
+		return 0;
+	}
+
+	/* frames start on an even address */
+	usNext = usPt + 6 + uLen + ( ( usPt + 6 + uLen ) & 1 );
+	if( usNext > usNd )
+	{
+		usNext -= uRing;
+	}
+	ucHdr[ 0 ] = ( uint8_t ) usNext;
+	ucHdr[ 1 ] = ( uint8_t ) ( usNext >> 8 );
+	ucHdr[ 2 ] = ( uint8_t ) uLen;
+	ucHdr[ 3 ] = ( uint8_t ) ( uLen >> 8 );
+	ucHdr[ 4 ] = 0x80;				/* received ok */
+	ucHdr[ 5 ] = 0;
+	for( i = 0; i < 6 + uLen; i++ )
+	{
+		xEnc.ucMem[ usPt ] = i < 6 ? ucHdr[ i ] : pucFrame[ i - 6 ];
+		usPt = usPt == usNd ? usSt : usPt + 1;
+	}
+	xEnc.usWrPt = usNext;
+	xEnc.ucReg[ 1 ][ EPKTCNT ]++;
+	xEnc.ucReg[ 0 ][ EIR ] |= EIR_PKTIF;
+	prvIntUpdate();
+	return 1;
+}
+
+int iEncModelInject( unsigned uLen, uint8_t ucSeed )
+{
+	static uint8_t ucFrame[ ENC_MODEL_MEM ];
+	unsigned i;
+
+	for( i = 0; i < uLen; i++ )
+	{
+		ucFrame[ i ] = ( uint8_t ) ( ucSeed + i );
+	}
+	return iEncModelReceive( ucFrame, uLen );
+}
+
+static void prvDmaIrq( void )
+{
+	DMA1->ISR |= DMA_TCIF4;
+	DMA1_Channel4_IRQHandler();
+	DMA1->ISR &= ~DMA1->IFCR;
+	DMA1->IFCR = 0;
+}
+
+void vEncModelTick( void )
+{
+	DMA_Channel_TypeDef *pxTx = DMA1_Channel5, *pxRx = DMA1_Channel4;
+	uint8_t *pucTx, *pucRx, ucIn;
+	unsigned uLen, i;
+
+	if( xEnc.iIntEdge )
+	{
+		xEnc.iIntEdge = 0;
+		EXTI3_IRQHandler();
+	}
+	if( xEnc.iStalled )
+	{
+		/* the driver took the channels back */
+		if( !( pxRx->CCR & DMA_CCR_EN_ ) )
+		{
+			xEnc.iStalled = 0;
+			if( xEnc.iLateIrq )
+			{
+				prvDmaIrq();
+			}
+		}
+		return;
+	}
+	if( ( SPI2->CR2 & SPI_CR2_DMAEN ) != SPI_CR2_DMAEN || !( pxTx->CCR & DMA_CCR_EN_ ) ||
+		!( pxRx->CCR & DMA_CCR_EN_ ) || pxTx->CNDTR == 0 )
+	{
+		return;
+	}
+
+	uLen = pxTx->CNDTR;
+	if( xEnc.uStall )
+	{
+		xEnc.uStall--;
+		xEnc.iStalled = 1;
+		uLen /= 2;
+	}
+	pucTx = ( uint8_t * ) ( uintptr_t ) pxTx->CMAR;
+	pucRx = ( uint8_t * ) ( uintptr_t ) pxRx->CMAR;
+	for( i = 0; i < uLen; i++ )
+	{
+		ucIn = prvByte( pucTx[ ( pxTx->CCR & DMA_CCR_MINC_ ) ? i : 0 ] );
+		pucRx[ ( pxRx->CCR & DMA_CCR_MINC_ ) ? i : 0 ] = ucIn;
+	}
+	pxTx->CNDTR -= uLen;
+	pxRx->CNDTR -= uLen;
+	xEnc.ulBursts++;
+
+	if( !xEnc.iStalled && ( pxRx->CCR & DMA_CCR_TCIE_ ) )
+	{
+		prvDmaIrq();
+	}
+}
@@ -0,0 +1,72 @@
+#ifndef ENC_MODEL_H
+#define ENC_MODEL_H
+
+/*
+ * An ENC28J60 on SPI2, for webserver/enc28j60.c.  The control registers,
+ * the PHY registers behind the MII and the 8k buffer memory answer the
+ * RCR/WCR/RBM/WBM/BFS/BFC opcodes byte by byte.  A CS window is one
+ * SPI_Take()..SPI_Give() of the driver; the model stands in for those and
+ * SPI_Send(), whose flag polling a plain register block never ends, so
+ * driver/SPI.C stays out of a test that links it.
+ *
+ * Bursts through DMA1 channel 5 (TX) and 4 (RX) are clocked from the tick
+ * hook and end with the channel 4 transfer complete interrupt.  uStall makes
+ * the next bursts stop halfway, iLateIrq raises their interrupt after the
+ * driver gave up on them, as a completion that lost the race with the
+ * timeout does.
+ *
+ * INT falls when an enabled flag in EIR comes up while INTIE is set; the
+ * tick hook passes the edge on to EXTI3_IRQHandler().  PKTIF follows
+ * EPKTCNT as on the chip, clearing it by hand does nothing.
+ */
+
+#include <stdint.h>
+
+#define ENC_MODEL_MEM		8192
+
+typedef struct xENC_MODEL xEncModel;
+
+struct xENC_MODEL
+{
+	/* faults, set by the test */
+	unsigned uStall;				/* DMA bursts left to stall */
+	int iLateIrq;					/* and complete them late */
+
+	/* the cable, set by the test: every frame sent, without control byte */
+	void ( *pxOnTx )( const uint8_t *pucFrame, unsigned uLen );
+
+	/* read only for the tests */
+	unsigned long ulWindows;		/* CS windows */
+	unsigned long ulBursts;			/* DMA bursts clocked */
+	unsigned long ulErrors;			/* SPI without CS, PKTDEC at 0 */
+	unsigned long ulTxFrames;		/* TXRTS set */
+	unsigned long ulRxDropped;		/* frames that found the ring full or
+									the receiver off */
+	uint8_t ucTx[ ENC_MODEL_MEM ];	/* the last frame sent, no control byte */
+	unsigned uTxLen;
+
+	/* model state */
+	uint8_t ucReg[ 4 ][ 32 ];
+	uint8_t ucMem[ ENC_MODEL_MEM ];
+	uint16_t usPhy[ 32 ];
+	uint16_t usWrPt;				/* ERXWRPT */
+	int iCs, iIdx, iOp, iArg;
+	int iStalled;
+	int iInt, iIntEdge;				/* INT asserted, and fell since the tick */
+};
+
+extern xEncModel xEnc;
+
+/* Power on state, before eth_init(). */
+void vEncModelInit( void );
+
+/* A frame from the wire, 0 if it found no room or the receiver off. */
+int iEncModelReceive( const uint8_t *pucFrame, unsigned uLen );
+
+/* A frame of uLen bytes seed, seed + 1, ...  0 if dropped. */
+int iEncModelInject( unsigned uLen, uint8_t ucSeed );
+
+/* From a tick hook. */
+void vEncModelTick( void );
+
+#endif
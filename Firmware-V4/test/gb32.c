@@ -0,0 +1,9 @@
+/*
+ * The 32x32 GB2312 table makefont reads, for test_hz.  hzk3232.h is built
+ * with the firmware's options, it does not compile clean with -Wall.
+ */
+
+#include "hzk3232.h"
+
+const struct typFNT_GB32 *const pxGB_32 = GB_32;
+const unsigned uGB_32Entries = sizeof( GB_32 ) / sizeof( GB_32[ 0 ] );
@@ -0,0 +1,161 @@
+/*
+ * The LCD panel on GPIOD/GPIOE, see lcd_model.h.
+ */
+
+#include <string.h>
+
+#include "stm32f10x.h"
+#include "FreeRTOS.h"
+
+#include "host.h"
+#include "lcd_model.h"
+
+#define PIN_CS				( 1UL << 7 )
+#define PIN_RD				( 1UL << 10 )
+#define PIN_WR				( 1UL << 11 )
+
+xLcdModel xLcd;
+
+void vLcdModelReset( uint16_t usFill )
+{
+	unsigned i;
+
+	memset( &xLcd, 0, sizeof( xLcd ) );
+	for( i = 0; i < 2 * LCD_MODEL_HEIGHT * LCD_MODEL_WIDTH; i++ )
+	{
+		( &xLcd.usPage[ 0 ][ 0 ][ 0 ] )[ i ] = usFill;
+	}
+	xLcd.ulPinsD = PIN_RD | PIN_WR;
+	xLcd.ulPinsE = PIN_CS;
+}
+
+void vLcdModelCount( void )
+{
+	xLcd.ulStores = 0;
+	xLcd.ulStrobes = 0;
+	xLcd.ulPixels = 0;
+	xLcd.ulShownPixels = 0;
+	xLcd.ulSections = 0;
+	xLcd.ulSectionMax = 0;
+	xLcd.ulOutside = 0;
+	xLcd.ulOffPanel = 0;
+	xLcd.ulErrors = 0;
+}
+
+unsigned long ulLcdModelNs( void )
+{
+	return ( xLcd.ulStores * LCD_MODEL_STORE_CYCLES + xLcd.ulSections * LCD_MODEL_SECTION_CYCLES ) * 1000UL /
+		   LCD_MODEL_MHZ;
+}
+
+unsigned long ulLcdModelSectionNs( void )
+{
+	return ( xLcd.ulSectionMax * LCD_MODEL_STORE_CYCLES + LCD_MODEL_SECTION_CYCLES ) * 1000UL / LCD_MODEL_MHZ;
+}
+
+static void prvStrobe( void )
+{
+	uint8_t ucData = ( uint8_t ) ( xLcd.ulPinsE >> 8 );
+	unsigned uPage;
+
+	xLcd.ulStrobes++;
+	if( ( xLcd.ulPinsE & PIN_CS ) != 0 || ( xLcd.ulPinsD & PIN_RD ) == 0 )
+	{
+		xLcd.ulErrors++;
+		return;
+	}
+	switch( ( xLcd.ulPinsD >> 8 ) & 3 )
+	{
+		case 3:
+			xLcd.ucPageReg = ucData;
+			xLcd.iLowByte = 0;
+			break;
+
+		case 1:
+			xLcd.uRow = ucData | ( ( xLcd.ucPageReg & 0x04 ) << 6 );
+			xLcd.iLowByte = 0;
+			break;
+
+		case 2:
+			xLcd.uCol = ucData | ( ( xLcd.ucPageReg & 0x03 ) << 8 );
+			xLcd.iLowByte = 0;
+			break;
+
+		default:
+			if( !xLcd.iLowByte )
+			{
+				xLcd.ucHigh = ucData;
+				xLcd.iLowByte = 1;
+				break;
+			}
+			xLcd.iLowByte = 0;
+			uPage = ( xLcd.ucPageReg >> 3 ) & 1;
+			xLcd.ulPixels++;
+			if( uPage == LCD_MODEL_SHOWN() )
+			{
+				xLcd.ulShownPixels++;
+			}
+			if( xLcd.uRow < LCD_MODEL_HEIGHT && xLcd.uCol < LCD_MODEL_WIDTH )
+			{
+				xLcd.usPage[ uPage ][ xLcd.uRow ][ xLcd.uCol ] = ( uint16_t ) ( ( xLcd.ucHigh << 8 ) | ucData );
+			}
+			else
+			{
+				xLcd.ulOffPanel++;
+			}
+			xLcd.uCol++;
+			break;
+	}
+}
+
+void vLcdBusStore( volatile uint32_t *pulReg, uint32_t ulValue )
+{
+	uint32_t *pulPins, ulWas;
+
+	*pulReg = ulValue;
+	if( pulReg == &GPIOD->BSRR || pulReg == &GPIOD->BRR )
+	{
+		pulPins = &xLcd.ulPinsD;
+	}
+	else if( pulReg == &GPIOE->BSRR || pulReg == &GPIOE->BRR )
+	{
+		pulPins = &xLcd.ulPinsE;
+	}
+	else
+	{
+		return;
+	}
+
+	xLcd.ulStores++;
+	if( uxHostCriticalNesting() == 0 )
+	{
+		xLcd.ulOutside++;
+	}
+	else
+	{
+		if( xHostStats.ulCritical != xLcd.ulSection )
+		{
+			xLcd.ulSection = xHostStats.ulCritical;
+			xLcd.ulSectionStores = 0;
+			xLcd.ulSections++;
+		}
+		if( ++xLcd.ulSectionStores > xLcd.ulSectionMax )
+		{
+			xLcd.ulSectionMax = xLcd.ulSectionStores;
+		}
+	}
+
+	ulWas = *pulPins;
+	if( pulReg == &GPIOD->BRR || pulReg == &GPIOE->BRR )
+	{
+		*pulPins &= ~ulValue & 0xFFFF;
+	}
+	else
+	{
+		*pulPins = ( ( *pulPins & ~( ulValue >> 16 ) ) | ulValue ) & 0xFFFF;
+	}
+	if( pulPins == &xLcd.ulPinsD && ( ulWas & PIN_WR ) == 0 && ( xLcd.ulPinsD & PIN_WR ) != 0 )
+	{
+		prvStrobe();
+	}
+}
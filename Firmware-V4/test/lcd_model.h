@@ -0,0 +1,80 @@
+#ifndef LCD_MODEL_H
+#define LCD_MODEL_H
+
+/*
+ * The 640x480 panel on the bus of app/lcd.c: data on PE8..PE15, CS on PE7,
+ * A0/A1 on PD8/PD9, RD on PD10 and WR on PD11.  The test build of lcd.c
+ * hands every store to the BSRR and BRR of GPIOD and GPIOE to
+ * vLcdBusStore() (LCD_BUS_STORE below, the file is included ahead of it).
+ * The model keeps the pins and takes a byte on each rising edge of WR:
+ *
+ *   A1A0 3  page register: bit 3 the page written, bit 4 the page shown,
+ *           bit 2 row bit 8 and bits 0..1 column bits 8..9
+ *        1  row bits 0..7
+ *        2  column bits 0..7
+ *        0  pixel data, high byte then low byte; the pixel goes into the
+ *           page written and the column steps on
+ *
+ * A strobe with CS high or RD low is an error.  Every store has to be made
+ * in a critical section of the driver, the model counts the ones that are
+ * not and the stores in the longest section.  Bus time is estimated from
+ * the stores and the sections as on the target, see ulLcdModelNs().
+ */
+
+#include <stdint.h>
+
+#define LCD_MODEL_WIDTH			640
+#define LCD_MODEL_HEIGHT		480
+
+/* Cortex-M3 at 72 MHz: a store to an APB2 port goes through the write
+   buffer in about 2 cycles, entering and leaving a critical section takes
+   about 20.  Loop and call overhead are left out. */
+#define LCD_MODEL_MHZ			72
+#define LCD_MODEL_STORE_CYCLES	2
+#define LCD_MODEL_SECTION_CYCLES	20
+
+typedef struct
+{
+	/* read only for the tests, vLcdModelCount() clears them */
+	unsigned long ulStores;			/* stores to the bus pins */
+	unsigned long ulStrobes;		/* WR rising edges */
+	unsigned long ulPixels;			/* pixels written */
+	unsigned long ulShownPixels;	/* of them into the page shown */
+	unsigned long ulSections;		/* critical sections with bus stores */
+	unsigned long ulSectionMax;		/* stores in the longest */
+	unsigned long ulOutside;		/* stores outside of a critical section */
+	unsigned long ulOffPanel;		/* pixels past the last row or column */
+	unsigned long ulErrors;			/* strobes with CS high or RD low */
+
+	/* the panel, read only for the tests */
+	uint16_t usPage[ 2 ][ LCD_MODEL_HEIGHT ][ LCD_MODEL_WIDTH ];
+	uint8_t ucPageReg;
+
+	/* model state */
+	uint32_t ulPinsD, ulPinsE;
+	unsigned uRow, uCol;
+	int iLowByte;
+	uint8_t ucHigh;
+	unsigned long ulSection, ulSectionStores;
+} xLcdModel;
+
+extern xLcdModel xLcd;
+
+/* Power on: the pins idle, the registers 0 and both pages usFill. */
+void vLcdModelReset( uint16_t usFill );
+
+/* Clear the counters. */
+void vLcdModelCount( void );
+
+/* Bus time of what was counted, in ns and in the longest section. */
+unsigned long ulLcdModelNs( void );
+unsigned long ulLcdModelSectionNs( void );
+
+/* The page shown, 0 or 1. */
+#define LCD_MODEL_SHOWN()		( ( xLcd.ucPageReg >> 4 ) & 1 )
+
+void vLcdBusStore( volatile uint32_t *pulReg, uint32_t ulValue );
+
+#define LCD_BUS_STORE( reg, v )	vLcdBusStore( &( reg ), ( v ) )
+
+#endif
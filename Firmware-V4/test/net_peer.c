@@ -0,0 +1,619 @@
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "stm32f10x.h"
+#include "netbuf.h"
+
+#include "host.h"
+#include "enc_model.h"
+#include "net_peer.h"
+
+extern void vuIP_Task( void *pvParameters );
+
+/* As main.c creates it. */
+#define peerUIP_PRIORITY	( tskIDLE_PRIORITY + 5 )
+#define peerUIP_STACK		( configMINIMAL_STACK_SIZE * 3 )
+
+#define peerREXMIT			300
+#define peerWINDOW			8192
+#define peerINBOX			32
+
+/* Ethernet II, IPv4 without options and what follows, as offsets into the
+frame. */
+#define ETH_DST				0
+#define ETH_SRC				6
+#define ETH_TYPE			12
+#define IP_VHL				14
+#define IP_LEN				16
+#define IP_ID				18
+#define IP_OFF				20
+#define IP_TTL				22
+#define IP_PROTO			23
+#define IP_SUM				24
+#define IP_SRC				26
+#define IP_DST				30
+#define L4					34
+#define TCP_SEQ				( L4 + 4 )
+#define TCP_ACK				( L4 + 8 )
+#define TCP_OFF				( L4 + 12 )
+#define TCP_FLAGS			( L4 + 13 )
+#define TCP_WND				( L4 + 14 )
+#define TCP_SUM				( L4 + 16 )
+#define UDP_LEN				( L4 + 4 )
+#define UDP_SUM				( L4 + 6 )
+#define ARP_OP				20
+#define ARP_SHA				22
+#define ARP_SPA				28
+#define ARP_THA				32
+#define ARP_TPA				38
+
+#define PROTO_ICMP			1
+#define PROTO_TCP			6
+#define PROTO_UDP			17
+
+#define TCP_FIN				0x01
+#define TCP_SYN				0x02
+#define TCP_RST				0x04
+#define TCP_PSH				0x08
+#define TCP_ACKF			0x10
+
+xNetPeer xPeer;
+
+static const uint8_t ucPeerMac[ 6 ] = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x01 };
+static const uint8_t ucPeerIp[ 4 ] = { configIP_ADDR0, configIP_ADDR1, configIP_ADDR2, 100 };
+static const uint8_t ucDevMac[ 6 ] = { configMAC_ADDR0, configMAC_ADDR1, configMAC_ADDR2,
+									   configMAC_ADDR3, configMAC_ADDR4, configMAC_ADDR5 };
+static const uint8_t ucDevIp[ 4 ] = { configIP_ADDR0, configIP_ADDR1, configIP_ADDR2, configIP_ADDR3 };
+
+static xPeerTcp *pxConns;
+static uint16_t usNextLocal;
+static uint16_t usIpId;
+static xPeerDatagram xInbox[ peerINBOX ];
+static unsigned uInboxHead, uInboxCount;
+
+/*-----------------------------------------------------------*/
+
+static uint16_t prvGet16( const uint8_t *p )
+{
+	return ( uint16_t ) ( ( p[ 0 ] << 8 ) | p[ 1 ] );
+}
+
+static uint32_t prvGet32( const uint8_t *p )
+{
+	return ( ( uint32_t ) prvGet16( p ) << 16 ) | prvGet16( p + 2 );
+}
+
+static void prvPut16( uint8_t *p, unsigned uVal )
+{
+	p[ 0 ] = ( uint8_t ) ( uVal >> 8 );
+	p[ 1 ] = ( uint8_t ) uVal;
+}
+
+static void prvPut32( uint8_t *p, uint32_t ulVal )
+{
+	prvPut16( p, ulVal >> 16 );
+	prvPut16( p + 2, ulVal );
+}
+
+static uint32_t prvSum( uint32_t ulSum, const uint8_t *p, unsigned uLen )
+{
+	unsigned i;
+
+	for( i = 0; i + 1 < uLen; i += 2 )
+	{
+		ulSum += prvGet16( p + i );
+	}
+	if( uLen & 1 )
+	{
+		ulSum += p[ uLen - 1 ] << 8;
+	}
+	return ulSum;
+}
+
+static uint16_t prvFold( uint32_t ulSum )
+{
+	while( ulSum >> 16 )
+	{
+		ulSum = ( ulSum & 0xFFFF ) + ( ulSum >> 16 );
+	}
+	return ( uint16_t ) ulSum;
+}
+
+/* Over the pseudo header and uLen bytes of transport header and data. */
+static uint16_t prvL4Sum( const uint8_t *pucFrame, unsigned uLen )
+{
+	uint32_t ulSum = prvSum( 0, pucFrame + IP_SRC, 8 );
+
+	ulSum += pucFrame[ IP_PROTO ] + uLen;
+	return prvFold( prvSum( ulSum, pucFrame + L4, uLen ) );
+}
+
+/* Sequence numbers wrap. */
+static int prvAfter( uint32_t ulA, uint32_t ulB )
+{
+	return ( int32_t ) ( ulA - ulB ) > 0;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Onto the wire, padded to the minimum and with room for the CRC the
+controller keeps in the ring. */
+static void prvWire( uint8_t *pucFrame, unsigned uLen )
+{
+	if( uLen < 60 )
+	{
+		memset( pucFrame + uLen, 0, 60 - uLen );
+		uLen = 60;
+	}
+	memset( pucFrame + uLen, 0, 4 );
+	xPeer.ulFramesOut++;
+	if( !iEncModelReceive( pucFrame, uLen + 4 ) )
+	{
+		xPeer.ulDropped++;
+	}
+}
+
+static void prvIpHeader( uint8_t *pucFrame, uint8_t ucProto, unsigned uL4Len, int iBroadcast )
+{
+	if( iBroadcast )
+	{
+		memset( pucFrame + ETH_DST, 0xFF, 6 );
+		memset( pucFrame + IP_DST, 0xFF, 4 );
+	}
+	else
+	{
+		memcpy( pucFrame + ETH_DST, ucDevMac, 6 );
+		memcpy( pucFrame + IP_DST, ucDevIp, 4 );
+	}
+	memcpy( pucFrame + ETH_SRC, ucPeerMac, 6 );
+	prvPut16( pucFrame + ETH_TYPE, 0x0800 );
+	pucFrame[ IP_VHL ] = 0x45;
+	pucFrame[ IP_VHL + 1 ] = 0;
+	prvPut16( pucFrame + IP_LEN, 20 + uL4Len );
+	prvPut16( pucFrame + IP_ID, usIpId++ );
+	prvPut16( pucFrame + IP_OFF, 0x4000 );
+	pucFrame[ IP_TTL ] = 64;
+	pucFrame[ IP_PROTO ] = ucProto;
+	memcpy( pucFrame + IP_SRC, ucPeerIp, 4 );
+	prvPut16( pucFrame + IP_SUM, 0 );
+	prvPut16( pucFrame + IP_SUM, ~prvFold( prvSum( 0, pucFrame + IP_VHL, 20 ) ) );
+}
+
+static void prvTcpOut( xPeerTcp *pxConn, uint8_t ucFlags, uint32_t ulSeq, const void *pvData, unsigned uLen )
+{
+	static uint8_t ucFrame[ 1600 ];
+	unsigned uHdr = ( ucFlags & TCP_SYN ) ? 24 : 20;
+
+	prvPut16( ucFrame + L4, pxConn->usLocal );
+	prvPut16( ucFrame + L4 + 2, pxConn->usPort );
+	prvPut32( ucFrame + TCP_SEQ, ulSeq );
+	prvPut32( ucFrame + TCP_ACK, ( ucFlags & TCP_ACKF ) ? pxConn->ulRcvNxt : 0 );
+	ucFrame[ TCP_OFF ] = ( uint8_t ) ( ( uHdr / 4 ) << 4 );
+	ucFrame[ TCP_FLAGS ] = ucFlags;
+	prvPut16( ucFrame + TCP_WND, peerWINDOW );
+	prvPut16( ucFrame + TCP_SUM, 0 );
+	prvPut16( ucFrame + L4 + 18, 0 );
+	if( ucFlags & TCP_SYN )
+	{
+		ucFrame[ L4 + 20 ] = 2;
+		ucFrame[ L4 + 21 ] = 4;
+		prvPut16( ucFrame + L4 + 22, pxConn->usMss ? pxConn->usMss : PEER_MSS );
+	}
+	memcpy( ucFrame + L4 + uHdr, pvData, uLen );
+	prvIpHeader( ucFrame, PROTO_TCP, uHdr + uLen, 0 );
+	prvPut16( ucFrame + TCP_SUM, ~prvL4Sum( ucFrame, uHdr + uLen ) );
+	prvWire( ucFrame, L4 + uHdr + uLen );
+}
+
+static void prvAck( xPeerTcp *pxConn )
+{
+	prvTcpOut( pxConn, TCP_ACKF, pxConn->ulSndNxt, NULL, 0 );
+	pxConn->iUnacked = 0;
+	pxConn->ulAcks++;
+}
+
+/*-----------------------------------------------------------*/
+
+static void prvArpIn( const uint8_t *pucFrame )
+{
+	uint8_t ucReply[ 64 ];
+
+	if( prvGet16( pucFrame + ARP_OP ) != 1 || memcmp( pucFrame + ARP_TPA, ucPeerIp, 4 ) != 0 )
+	{
+		return;
+	}
+	xPeer.ulArpRequests++;
+	memcpy( ucReply, pucFrame, 42 );
+	memcpy( ucReply + ETH_DST, pucFrame + ETH_SRC, 6 );
+	memcpy( ucReply + ETH_SRC, ucPeerMac, 6 );
+	prvPut16( ucReply + ARP_OP, 2 );
+	memcpy( ucReply + ARP_SHA, ucPeerMac, 6 );
+	memcpy( ucReply + ARP_SPA, ucPeerIp, 4 );
+	memcpy( ucReply + ARP_THA, pucFrame + ARP_SHA, 6 );
+	memcpy( ucReply + ARP_TPA, pucFrame + ARP_SPA, 4 );
+	prvWire( ucReply, 42 );
+}
+
+static void prvUdpIn( const uint8_t *pucFrame, unsigned uL4Len )
+{
+	xPeerDatagram *pxDatagram;
+
+	if( prvGet16( pucFrame + UDP_LEN ) != uL4Len ||
+		( prvGet16( pucFrame + UDP_SUM ) != 0 && prvL4Sum( pucFrame, uL4Len ) != 0xFFFF ) )
+	{
+		xPeer.ulBadFrames++;
+		return;
+	}
+	if( uInboxCount == peerINBOX )
+	{
+		xPeer.ulUdpLost++;
+		return;
+	}
+	pxDatagram = &xInbox[ ( uInboxHead + uInboxCount++ ) % peerINBOX ];
+	pxDatagram->usSrcPort = prvGet16( pucFrame + L4 );
+	pxDatagram->usDstPort = prvGet16( pucFrame + L4 + 2 );
+	pxDatagram->iBroadcast = prvGet32( pucFrame + IP_DST ) == 0xFFFFFFFFUL;
+	pxDatagram->uLen = uL4Len - 8;
+	memcpy( pxDatagram->ucData, pucFrame + L4 + 8, pxDatagram->uLen );
+}
+
+static void prvTcpIn( const uint8_t *pucFrame, unsigned uL4Len )
+{
+	xPeerTcp *pxConn;
+	uint8_t ucFlags = pucFrame[ TCP_FLAGS ];
+	unsigned uHdr = ( pucFrame[ TCP_OFF ] >> 4 ) * 4, uLen = uL4Len - uHdr, uCopy;
+	uint32_t ulSeq = prvGet32( pucFrame + TCP_SEQ ), ulAck = prvGet32( pucFrame + TCP_ACK );
+	portTickType xNow = xTaskGetTickCount();
+
+	if( prvL4Sum( pucFrame, uL4Len ) != 0xFFFF || uHdr < 20 || uHdr > uL4Len )
+	{
+		xPeer.ulBadFrames++;
+		return;
+	}
+	for( pxConn = pxConns; pxConn != NULL; pxConn = pxConn->pxNext )
+	{
+		if( pxConn->usLocal == prvGet16( pucFrame + L4 + 2 ) && pxConn->usPort == prvGet16( pucFrame + L4 ) )
+		{
+			break;
+		}
+	}
+	if( pxConn == NULL || pxConn->iState == PEER_CLOSED || pxConn->iState == PEER_RESET )
+	{
+		return;
+	}
+	if( ucFlags & TCP_RST )
+	{
+		pxConn->iState = PEER_RESET;
+		return;
+	}
+	if( pxConn->iState == PEER_SYN_SENT )
+	{
+		if( ( ucFlags & ( TCP_SYN | TCP_ACKF ) ) == ( TCP_SYN | TCP_ACKF ) && ulAck == pxConn->ulSndNxt )
+		{
+			pxConn->ulRcvNxt = ulSeq + 1;
+			pxConn->ulSndUna = ulAck;
+			pxConn->iState = PEER_OPEN;
+			prvAck( pxConn );
+		}
+		return;
+	}
+
+	/* as if it never arrived, ACK and all */
+	if( uLen > 0 && ulSeq == pxConn->ulRcvNxt && pxConn->ulLose == pxConn->ulSegments + 1 )
+	{
+		pxConn->ulLose = 0;
+		return;
+	}
+
+	if( ( ucFlags & TCP_ACKF ) && prvAfter( ulAck, pxConn->ulSndUna ) && !prvAfter( ulAck, pxConn->ulSndNxt ) )
+	{
+		pxConn->ulSndUna = ulAck;
+		if( ulAck == pxConn->ulSndNxt )
+		{
+			pxConn->uOutLen = 0;
+		}
+	}
+
+	if( uLen > 0 )
+	{
+		if( ulSeq != pxConn->ulRcvNxt )
+		{
+			pxConn->ulDupes++;
+			prvAck( pxConn );
+			return;
+		}
+		uCopy = uLen;
+		if( pxConn->pucRx != NULL )
+		{
+			if( pxConn->ulRxBytes + uCopy > pxConn->uRxMax )
+			{
+				uCopy = pxConn->ulRxBytes < pxConn->uRxMax ? pxConn->uRxMax - pxConn->ulRxBytes : 0;
+			}
+			memcpy( pxConn->pucRx + pxConn->ulRxBytes, pucFrame + L4 + uHdr, uCopy );
+		}
+		if( pxConn->ulSegments++ == 0 )
+		{
+			pxConn->xFirst = xNow;
+		}
+		pxConn->xLast = xNow;
+		if( uLen > pxConn->uMaxSegment )
+		{
+			pxConn->uMaxSegment = uLen;
+		}
+		pxConn->ulRxBytes += uLen;
+		pxConn->ulRcvNxt += uLen;
+		if( ++pxConn->iUnacked == 1 )
+		{
+			pxConn->xAckDue = xNow + pxConn->xAckDelay;
+		}
+	}
+
+	if( ucFlags & TCP_FIN )
+	{
+		if( ulSeq + uLen == pxConn->ulRcvNxt && pxConn->iState == PEER_OPEN )
+		{
+			pxConn->ulRcvNxt++;
+			pxConn->iState = PEER_FIN;
+			prvTcpOut( pxConn, TCP_FIN | TCP_ACKF, pxConn->ulSndNxt++, NULL, 0 );
+			pxConn->iUnacked = 0;
+			pxConn->ulAcks++;
+		}
+		else
+		{
+			prvAck( pxConn );
+		}
+		return;
+	}
+	if( pxConn->iUnacked > 0 && ( pxConn->xAckDelay == 0 || pxConn->iUnacked >= 2 ) )
+	{
+		prvAck( pxConn );
+	}
+}
+
+/* Everything the controller sends, as it goes out. */
+static void prvFromDevice( const uint8_t *pucFrame, unsigned uLen )
+{
+	unsigned uIpLen;
+
+	xPeer.ulFramesIn++;
+	xPeer.ulBytesIn += uLen;
+	if( uLen < 14 )
+	{
+		xPeer.ulBadFrames++;
+		return;
+	}
+	if( prvGet16( pucFrame + ETH_TYPE ) == 0x0806 )
+	{
+		prvArpIn( pucFrame );
+		return;
+	}
+	if( prvGet16( pucFrame + ETH_TYPE ) != 0x0800 )
+	{
+		return;
+	}
+	uIpLen = prvGet16( pucFrame + IP_LEN );
+	if( pucFrame[ IP_VHL ] != 0x45 || uIpLen < 20 || 14 + uIpLen > uLen ||
+		prvFold( prvSum( 0, pucFrame + IP_VHL, 20 ) ) != 0xFFFF ||
+		memcmp( pucFrame + IP_SRC, ucDevIp, 4 ) != 0 )
+	{
+		xPeer.ulBadFrames++;
+		return;
+	}
+	switch( pucFrame[ IP_PROTO ] )
+	{
+		case PROTO_TCP:
+			prvTcpIn( pucFrame, uIpLen - 20 );
+			break;
+		case PROTO_UDP:
+			prvUdpIn( pucFrame, uIpLen - 20 );
+			break;
+		case PROTO_ICMP:
+			if( pucFrame[ L4 ] == 0 )
+			{
+				xPeer.ulPingReplies++;
+			}
+			break;
+		default:
+			break;
+	}
+}
+
+/* Delayed ACKs and the peer's own retransmissions. */
+static void prvPeerTick( void )
+{
+	portTickType xNow = xTaskGetTickCount();
+	xPeerTcp *pxConn;
+
+	for( pxConn = pxConns; pxConn != NULL; pxConn = pxConn->pxNext )
+	{
+		if( pxConn->iState != PEER_OPEN )
+		{
+			continue;
+		}
+		if( pxConn->iUnacked > 0 && ( portTickType ) ( xNow - pxConn->xAckDue ) < portMAX_DELAY / 2 )
+		{
+			prvAck( pxConn );
+		}
+		if( pxConn->uOutLen > 0 && xNow - pxConn->xSentAt >= peerREXMIT )
+		{
+			prvTcpOut( pxConn, TCP_PSH | TCP_ACKF, pxConn->ulSndUna, pxConn->ucOut, pxConn->uOutLen );
+			pxConn->xSentAt = xNow;
+		}
+	}
+}
+
+/*-----------------------------------------------------------*/
+
+void vPeerStart( void )
+{
+	uint8_t ucArp[ 64 ];
+
+	vHostReset();
+	vHostPeriphReset();
+	vEncModelInit();
+	memset( &xPeer, 0, sizeof( xPeer ) );
+	memset( &xNetStats, 0, sizeof( xNetStats ) );
+	pxConns = NULL;
+	usNextLocal = 40000;
+	uInboxHead = uInboxCount = 0;
+	xEnc.pxOnTx = prvFromDevice;
+	vHostAddTickHook( vEncModelTick );
+	vHostAddTickHook( prvPeerTick );
+	xTaskCreate( vuIP_Task, ( signed char * ) "uIP", peerUIP_STACK, NULL, peerUIP_PRIORITY, NULL );
+
+	/* reset, link and the second the driver task gives the PHY */
+	vHostRun( 1500 );
+
+	/* who has the device, so its ARP table knows us */
+	memset( ucArp + ETH_DST, 0xFF, 6 );
+	memcpy( ucArp + ETH_SRC, ucPeerMac, 6 );
+	prvPut16( ucArp + ETH_TYPE, 0x0806 );
+	prvPut16( ucArp + 14, 1 );
+	prvPut16( ucArp + 16, 0x0800 );
+	ucArp[ 18 ] = 6;
+	ucArp[ 19 ] = 4;
+	prvPut16( ucArp + ARP_OP, 1 );
+	memcpy( ucArp + ARP_SHA, ucPeerMac, 6 );
+	memcpy( ucArp + ARP_SPA, ucPeerIp, 4 );
+	memset( ucArp + ARP_THA, 0, 6 );
+	memcpy( ucArp + ARP_TPA, ucDevIp, 4 );
+	prvWire( ucArp, 42 );
+	vHostRun( 10 );
+}
+
+int iPeerConnect( xPeerTcp *pxConn, uint16_t usPort )
+{
+	portTickType xStart = xTaskGetTickCount();
+
+	pxConn->iState = PEER_SYN_SENT;
+	pxConn->ulRxBytes = pxConn->ulSegments = pxConn->ulDupes = pxConn->ulAcks = 0;
+	pxConn->uMaxSegment = 0;
+	pxConn->usPort = usPort;
+	pxConn->usLocal = usNextLocal++;
+	pxConn->ulSndUna = pxConn->ulSndNxt = 0x10000UL * pxConn->usLocal;
+	pxConn->iUnacked = 0;
+	pxConn->uOutLen = 0;
+	pxConn->pxNext = pxConns;
+	pxConns = pxConn;
+
+	prvTcpOut( pxConn, TCP_SYN, pxConn->ulSndNxt++, NULL, 0 );
+	while( pxConn->iState == PEER_SYN_SENT && xTaskGetTickCount() - xStart < 3000 )
+	{
+		vHostRun( 1 );
+	}
+	return pxConn->iState == PEER_OPEN;
+}
+
+void vPeerTcpSend( xPeerTcp *pxConn, const void *pvData, unsigned uLen )
+{
+	portTickType xStart = xTaskGetTickCount();
+
+	/* one segment of ours in flight */
+	while( pxConn->uOutLen > 0 && pxConn->iState == PEER_OPEN && xTaskGetTickCount() - xStart < 3000 )
+	{
+		vHostRun( 1 );
+	}
+	if( uLen > PEER_MSS )
+	{
+		uLen = PEER_MSS;
+	}
+	memcpy( pxConn->ucOut, pvData, uLen );
+	pxConn->uOutLen = uLen;
+	pxConn->ulSndNxt = pxConn->ulSndUna + uLen;
+	pxConn->xSentAt = xTaskGetTickCount();
+	prvTcpOut( pxConn, TCP_PSH | TCP_ACKF, pxConn->ulSndUna, pvData, uLen );
+	pxConn->iUnacked = 0;
+}
+
+int iPeerTcpWait( xPeerTcp *pxConn, portTickType xTicks )
+{
+	portTickType xStart = xTaskGetTickCount();
+
+	while( pxConn->iState == PEER_OPEN && xTaskGetTickCount() - xStart < xTicks )
+	{
+		vHostRun( 1 );
+	}
+	return pxConn->iState == PEER_FIN;
+}
+
+void vPeerTcpAbort( xPeerTcp *pxConn )
+{
+	xPeerTcp **ppxConn;
+
+	if( pxConn->iState == PEER_OPEN )
+	{
+		prvTcpOut( pxConn, TCP_RST | TCP_ACKF, pxConn->ulSndNxt, NULL, 0 );
+	}
+	pxConn->iState = PEER_CLOSED;
+	for( ppxConn = &pxConns; *ppxConn != NULL; ppxConn = &( *ppxConn )->pxNext )
+	{
+		if( *ppxConn == pxConn )
+		{
+			*ppxConn = pxConn->pxNext;
+			break;
+		}
+	}
+}
+
+static void prvUdpOut( const uint8_t *pucSrcIp, uint16_t usSrcPort, uint16_t usDstPort, int iBroadcast, const void *pvData, unsigned uLen )
+{
+	static uint8_t ucFrame[ 1600 ];
+
+	prvPut16( ucFrame + L4, usSrcPort );
+	prvPut16( ucFrame + L4 + 2, usDstPort );
+	prvPut16( ucFrame + UDP_LEN, 8 + uLen );
+	prvPut16( ucFrame + UDP_SUM, 0 );
+	memcpy( ucFrame + L4 + 8, pvData, uLen );
+	prvIpHeader( ucFrame, PROTO_UDP, 8 + uLen, iBroadcast );
+	if( pucSrcIp != ucPeerIp )
+	{
+		memcpy( ucFrame + IP_SRC, pucSrcIp, 4 );
+		prvPut16( ucFrame + IP_SUM, 0 );
+		prvPut16( ucFrame + IP_SUM, ~prvFold( prvSum( 0, ucFrame + IP_VHL, 20 ) ) );
+	}
+	prvPut16( ucFrame + UDP_SUM, ~prvL4Sum( ucFrame, 8 + uLen ) );
+	prvWire( ucFrame, L4 + 8 + uLen );
+}
+
+void vPeerUdpSend( uint16_t usSrcPort, uint16_t usDstPort, int iBroadcast, const void *pvData, unsigned uLen )
+{
+	prvUdpOut( ucPeerIp, usSrcPort, usDstPort, iBroadcast, pvData, uLen );
+}
+
+void vPeerUdpBroadcastFrom( const uint8_t *pucSrcIp, uint16_t usSrcPort, uint16_t usDstPort, const void *pvData, unsigned uLen )
+{
+	prvUdpOut( pucSrcIp, usSrcPort, usDstPort, 1, pvData, uLen );
+}
+
+int iPeerUdpRecv( xPeerDatagram *pxDatagram )
+{
+	if( uInboxCount == 0 )
+	{
+		return 0;
+	}
+	*pxDatagram = xInbox[ uInboxHead ];
+	uInboxHead = ( uInboxHead + 1 ) % peerINBOX;
+	uInboxCount--;
+	return 1;
+}
+
+void vPeerPing( uint16_t usSeq, unsigned uLen )
+{
+	static uint8_t ucFrame[ 1600 ];
+	unsigned i;
+
+	ucFrame[ L4 ] = 8;
+	ucFrame[ L4 + 1 ] = 0;
+	prvPut16( ucFrame + L4 + 2, 0 );
+	prvPut16( ucFrame + L4 + 4, 0x6969 );
+	prvPut16( ucFrame + L4 + 6, usSeq );
+	for( i = 0; i < uLen; i++ )
+	{
+		ucFrame[ L4 + 8 + i ] = ( uint8_t ) ( usSeq + i );
+	}
+	prvIpHeader( ucFrame, PROTO_ICMP, 8 + uLen, 0 );
+	prvPut16( ucFrame + L4 + 2, ~prvFold( prvSum( 0, ucFrame + L4, 8 + uLen ) ) );
+	prvWire( ucFrame, L4 + 8 + uLen );
+}
@@ -0,0 +1,116 @@
+#ifndef NET_PEER_H
+#define NET_PEER_H
+
+/*
+ * The PC at the other end of the ENC28J60 model's cable, for the tests that
+ * run vuIP_Task as main() would.  Frames the controller sends reach the
+ * peer as TXRTS is set; what the peer sends goes into the receive ring and
+ * INT tells the driver on the next tick.
+ *
+ * The peer answers ARP and pings, talks UDP and keeps TCP connections from
+ * PEER_IP.  A connection ACKs every in-order segment at once, or with
+ * xAckDelay set like a Windows host: every second segment at once and a
+ * lone one after xAckDelay ticks.  Every frame from the controller has its
+ * checksums verified.
+ */
+
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+
+#define PEER_MSS			1460
+
+typedef struct xPEER_TCP xPeerTcp;
+
+enum
+{
+	PEER_CLOSED = 0,
+	PEER_SYN_SENT,
+	PEER_OPEN,
+	PEER_FIN,						/* the device closed, we followed */
+	PEER_RESET						/* the device sent RST */
+};
+
+struct xPEER_TCP
+{
+	/* set by the test before iPeerConnect() */
+	portTickType xAckDelay;
+	uint16_t usMss;					/* offered in the SYN, 0 for PEER_MSS */
+	uint8_t *pucRx;					/* stream from the device, NULL to count only */
+	unsigned uRxMax;
+	unsigned long ulLose;			/* lose the data segment with this number, 1 for the first */
+
+	/* read only for the tests */
+	int iState;
+	unsigned long ulRxBytes;
+	unsigned long ulSegments;		/* data segments taken in order */
+	unsigned uMaxSegment;			/* longest of them */
+	unsigned long ulDupes;			/* out of order or sent again */
+	unsigned long ulAcks;
+	portTickType xFirst, xLast;		/* ticks of the first and last data */
+
+	/* peer state */
+	uint16_t usPort, usLocal;
+	uint32_t ulSndNxt, ulSndUna, ulRcvNxt;
+	int iUnacked;
+	portTickType xAckDue;
+	uint8_t ucOut[ PEER_MSS ];
+	unsigned uOutLen;
+	portTickType xSentAt;
+	xPeerTcp *pxNext;
+};
+
+/* A UDP datagram the device sent. */
+typedef struct
+{
+	uint16_t usSrcPort, usDstPort;
+	int iBroadcast;					/* sent to 255.255.255.255 */
+	unsigned uLen;
+	uint8_t ucData[ PEER_MSS ];
+} xPeerDatagram;
+
+typedef struct
+{
+	unsigned long ulFramesIn;		/* from the controller */
+	unsigned long ulBytesIn;
+	unsigned long ulFramesOut;		/* into the receive ring */
+	unsigned long ulDropped;		/* of those, the ring had no room */
+	unsigned long ulBadFrames;		/* checksum or length wrong */
+	unsigned long ulArpRequests;
+	unsigned long ulPingReplies;
+	unsigned long ulUdpLost;		/* the inbox was full */
+} xNetPeer;
+
+extern xNetPeer xPeer;
+
+/* Reset time and the controller, boot the uIP task and wait until it
+ * answers on the wire. */
+void vPeerStart( void );
+
+/* Open a connection to usPort on the device, 1 when it is up. */
+int iPeerConnect( xPeerTcp *pxConn, uint16_t usPort );
+
+/* One segment of data, at most PEER_MSS bytes.  It goes again every 300
+ * ticks until the device ACKs it. */
+void vPeerTcpSend( xPeerTcp *pxConn, const void *pvData, unsigned uLen );
+
+/* Run until the device closes the connection, at most xTicks; 1 if it did. */
+int iPeerTcpWait( xPeerTcp *pxConn, portTickType xTicks );
+
+/* Reset the connection and forget it. */
+void vPeerTcpAbort( xPeerTcp *pxConn );
+
+/* A datagram to the device, or to everyone with iBroadcast. */
+void vPeerUdpSend( uint16_t usSrcPort, uint16_t usDstPort, int iBroadcast, const void *pvData, unsigned uLen );
+
+/* A datagram to everyone from pucSrcIp, which need not be on the device's
+ * subnet, like a tool that has no address of its own yet. */
+void vPeerUdpBroadcastFrom( const uint8_t *pucSrcIp, uint16_t usSrcPort, uint16_t usDstPort, const void *pvData, unsigned uLen );
+
+/* The oldest datagram from the device, 0 when there is none. */
+int iPeerUdpRecv( xPeerDatagram *pxDatagram );
+
+/* An echo request with uLen bytes of data. */
+void vPeerPing( uint16_t usSeq, unsigned uLen );
+
+#endif
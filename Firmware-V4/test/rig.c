@@ -0,0 +1,119 @@
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "stm32f10x.h"
+#include "gl_696h.h"
+#include "mb_reg_map.h"
+#include "modbus.h"
+
+#include "host.h"
+#include "rig.h"
+
+/* FD110A commands, see gl_696h.c */
+#define PUMP_STOP		0x80
+#define PUMP_START		0x81
+#define PUMP_HIGH_SP	0x83
+#define PUMP_STATUS		0x84
+
+xRig xBench;
+
+/* The pump follows start, stop and high speed at once and answers a status
+request with its state. */
+static void prvPumpPeer( xUartModel *pxUart, const uint8_t *pucFrame, unsigned uLen )
+{
+	uint8_t ucReply[ 11 ], ucXor = 0;
+	unsigned i;
+
+	for( i = 0; i + 4 <= uLen; i += 4 )
+	{
+		if( pucFrame[ i ] != 0xAB )
+		{
+			continue;
+		}
+		xBench.ulPumpCmds[ pucFrame[ i + 1 ] ]++;
+		xBench.ulPumpCmdTick[ pucFrame[ i + 1 ] ] = xTaskGetTickCount();
+		switch( pucFrame[ i + 1 ] )
+		{
+			case PUMP_STOP:
+				xBench.ucPumpSt &= ~( MPUMP_RUN | MPUMP_HIGH_SP );
+				xBench.usPumpFreq = 0;
+				continue;
+			case PUMP_START:
+				xBench.ucPumpSt |= MPUMP_RUN;
+				xBench.usPumpFreq = 600;
+				continue;
+			case PUMP_HIGH_SP:
+				xBench.ucPumpSt |= MPUMP_HIGH_SP;
+				continue;
+			case PUMP_STATUS:
+				break;
+			default:
+				continue;
+		}
+		ucReply[ 0 ] = 0xAB;
+		ucReply[ 1 ] = 0x91;
+		ucReply[ 2 ] = 0x07;
+		ucReply[ 3 ] = xBench.ucPumpSt;
+		ucReply[ 4 ] = xBench.usPumpFreq / 100;
+		ucReply[ 5 ] = xBench.usPumpFreq % 100;
+		ucReply[ 6 ] = 0;
+		ucReply[ 7 ] = 24;
+		ucReply[ 8 ] = 0;
+		ucReply[ 9 ] = 50;
+		for( ucXor = 0, i = 1; i < 10; i++ )
+		{
+			ucXor ^= ucReply[ i ];
+		}
+		ucReply[ 10 ] = ucXor;
+		vUartModelSend( pxUart, ucReply, sizeof( ucReply ) );
+		break;
+	}
+}
+
+static void prvTick( void )
+{
+	vUartModelTick( &xBench.xPumpLine );
+	vUartModelTick( &xBench.xGaugeLine );
+
+	if( xBench.pcGaugeFrame != NULL && xTaskGetTickCount() % 500 == 0 )
+	{
+		vUartModelSend( &xBench.xGaugeLine, xBench.pcGaugeFrame, strlen( xBench.pcGaugeFrame ) );
+	}
+}
+
+void vRigStart( void )
+{
+	vHostReset();
+	vHostPeriphReset();
+	memset( &xBench, 0, sizeof( xBench ) );
+	vUartModelInit( &xBench.xPumpLine, serCOM2, 4800 );
+	vUartModelInit( &xBench.xGaugeLine, serCOM3, 1200 );
+	xBench.xPumpLine.pxPeer = prvPumpPeer;
+	xBench.pcGaugeFrame = "*10-1----";
+	vHostAddTickHook( prvTick );
+
+	/* main()'s priority, the kernel caps it at configMAX_PRIORITIES - 1 */
+	xTaskCreate( vGL696H_Task, ( signed char * ) "GL696H", 256, NULL, tskIDLE_PRIORITY + 5, NULL );
+	vHostRun( 1 );
+}
+
+uint16_t usRigOverruns( uint32_t ulJob )
+{
+	return eMBRegInput_Read( MB_SCHED_STAT + ulJob * SCHED_STAT_REGS + SCHED_STAT_OVERRUN );
+}
+
+uint16_t usRigJitter( uint32_t ulJob )
+{
+	return eMBRegInput_Read( MB_SCHED_STAT + ulJob * SCHED_STAT_REGS + SCHED_STAT_JITTER );
+}
+
+void vRigWriteHolding( uint16_t usReg, uint16_t usVal )
+{
+	UCHAR ucFrame[ 2 ];
+
+	ucFrame[ 0 ] = ( UCHAR ) ( usVal >> 8 );
+	ucFrame[ 1 ] = ( UCHAR ) usVal;
+	eMBRegHoldingCB( ucFrame, REG_HOLDING_START + usReg, 1, MB_REG_WRITE );
+}
@@ -0,0 +1,40 @@
+#ifndef RIG_H
+#define RIG_H
+
+/*
+ * The GL696H controller on the bench: vGL696H_Task booted as main() does,
+ * an FD110A pump driver on COM2 and the vacuum gauge on COM3.
+ */
+
+#include <stdint.h>
+
+#include "uart_model.h"
+
+typedef struct
+{
+	xUartModel xPumpLine;
+	xUartModel xGaugeLine;
+
+	/* FD110A: commands seen by code, the state its status frames report */
+	unsigned long ulPumpCmds[ 256 ];
+	unsigned long ulPumpCmdTick[ 256 ];		/* tick of the last one */
+	uint8_t ucPumpSt;
+	uint16_t usPumpFreq;
+
+	/* gauge: sends a reading every 500 ms while powered */
+	const char *pcGaugeFrame;
+} xRig;
+
+extern xRig xBench;
+
+/* Reset time and the peripherals, start the controller and its peers. */
+void vRigStart( void );
+
+/* The counters the stat job publishes, for job index ulJob. */
+uint16_t usRigOverruns( uint32_t ulJob );
+uint16_t usRigJitter( uint32_t ulJob );
+
+/* A host write of one holding register, through the Modbus callback. */
+void vRigWriteHolding( uint16_t usReg, uint16_t usVal );
+
+#endif
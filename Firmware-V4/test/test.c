@@ -0,0 +1,20 @@
+#include "test.h"
+
+int iTestFailures;
+
+static unsigned long ulState = 1;
+
+void vTestSeed( unsigned long ulSeed )
+{
+	ulState = ulSeed ? ulSeed : 1;
+}
+
+/* xorshift32 */
+unsigned long ulTestRand( void )
+{
+	ulState &= 0xffffffffUL;
+	ulState ^= ( ulState << 13 ) & 0xffffffffUL;
+	ulState ^= ulState >> 17;
+	ulState ^= ( ulState << 5 ) & 0xffffffffUL;
+	return ulState;
+}
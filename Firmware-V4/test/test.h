@@ -0,0 +1,37 @@
+#ifndef TEST_H
+#define TEST_H
+
+/*
+ * Checks for the host tests.  A failed check prints where and goes on, the
+ * test's main() returns TEST_RESULT() so ctest sees the failures.
+ */
+
+#include <stdio.h>
+
+extern int iTestFailures;
+
+#define CHECK( x )																\
+	do {																		\
+		if( !( x ) ) {															\
+			fprintf( stderr, "%s:%d: CHECK( %s ) failed\n", __FILE__, __LINE__, #x );	\
+			iTestFailures++;													\
+		}																		\
+	} while( 0 )
+
+#define CHECK_EQ( a, b )														\
+	do {																		\
+		long long llA = ( long long ) ( a ), llB = ( long long ) ( b );			\
+		if( llA != llB ) {														\
+			fprintf( stderr, "%s:%d: %s == %s failed, %lld != %lld\n",			\
+					 __FILE__, __LINE__, #a, #b, llA, llB );					\
+			iTestFailures++;													\
+		}																		\
+	} while( 0 )
+
+#define TEST_RESULT()	( iTestFailures ? ( fprintf( stderr, "%d failed\n", iTestFailures ), 1 ) : 0 )
+
+/* Deterministic pseudo random numbers, the same on every run. */
+void vTestSeed( unsigned long ulSeed );
+unsigned long ulTestRand( void );
+
+#endif
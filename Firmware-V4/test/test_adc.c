@@ -0,0 +1,139 @@
+/*
+ * The ADC1 scan table and its DMA half/full transfer interrupt.  The test
+ * plays the DMA: it fills one half of ADC_ConvertedValueTab, raises the flag
+ * and runs the handler the vector table would.
+ */
+
+#include <string.h>
+
+#include "stm32f10x.h"
+#include "adc.h"
+
+#include "test.h"
+
+void DMA1_Channel1_IRQHandler( void );
+
+static uint16_t usSample( uint32_t ulHalf, uint32_t ulRow, uint32_t ulCh )
+{
+	return ( uint16_t ) ( ( ulHalf * 1000 + ulCh * 100 + ulRow * 3 ) & 0xfff );
+}
+
+/* One half of the table converted, then the interrupt for it. */
+static void prvFillHalf( uint32_t ulHalf, uint32_t ulFlags )
+{
+	uint32_t ulRow, ulCh;
+
+	for( ulRow = 0; ulRow < ADC_BLOCK_SAMPLES; ulRow++ )
+	{
+		for( ulCh = 0; ulCh < ADC_CHANNEL; ulCh++ )
+		{
+			ADC_ConvertedValueTab[ ulHalf * ADC_BLOCK_SAMPLES + ulRow ][ ulCh ] = usSample( ulHalf, ulRow, ulCh );
+		}
+	}
+	/* an outlier either way in channel 0, the filter drops both */
+	ADC_ConvertedValueTab[ ulHalf * ADC_BLOCK_SAMPLES + 2 ][ 0 ] = 4095;
+	ADC_ConvertedValueTab[ ulHalf * ADC_BLOCK_SAMPLES + 5 ][ 0 ] = 0;
+
+	DMA1->ISR |= ulFlags;
+	DMA1_Channel1_IRQHandler();
+	/* IFCR is write-1-to-clear */
+	DMA1->ISR &= ~DMA1->IFCR;
+	DMA1->IFCR = 0;
+}
+
+static uint16_t usMean( uint32_t ulHalf, uint32_t ulCh )
+{
+	uint32_t ulRow, ulSum = 0, ulN = 0;
+
+	for( ulRow = 0; ulRow < ADC_BLOCK_SAMPLES; ulRow++ )
+	{
+		if( ulCh == 0 && ( ulRow == 2 || ulRow == 5 ) )
+		{
+			continue;
+		}
+		ulSum += usSample( ulHalf, ulRow, ulCh );
+		ulN++;
+	}
+	if( ulCh != 0 )
+	{
+		/* no outliers, the first and last sample are the min and max */
+		ulSum -= usSample( ulHalf, 0, ulCh ) + usSample( ulHalf, ADC_BLOCK_SAMPLES - 1, ulCh );
+		ulN -= 2;
+	}
+	return ( uint16_t ) ( ulSum / ulN );
+}
+
+static void test_before_first_block( void )
+{
+	uint16_t usBuf[ ADC_BLOCK_SAMPLES ];
+
+	CHECK_EQ( ADC_GetBlockSeq(), 0 );
+	CHECK_EQ( ADC_GetBlock( 0, usBuf ), 0 );
+	CHECK_EQ( ADC_Get( ADC_Channel_8, usBuf, 4 ), 0 );
+}
+
+static void test_halves( void )
+{
+	uint16_t usBuf[ ADC_SAMPLE_TIMES ];
+	uint32_t ulCh, ulRow, ulSeq;
+
+	prvFillHalf( 0, DMA1_IT_HT1 | DMA1_IT_GL1 );
+	ulSeq = ADC_GetBlock( ADC_CH_INDEX( ADC_Channel_11 ), usBuf );
+	CHECK_EQ( ulSeq, 1 );
+	for( ulRow = 0; ulRow < ADC_BLOCK_SAMPLES; ulRow++ )
+	{
+		CHECK_EQ( usBuf[ ulRow ], usSample( 0, ulRow, 3 ) );
+	}
+	for( ulCh = 0; ulCh < ADC_CHANNEL; ulCh++ )
+	{
+		CHECK_EQ( ADC_GetFiltered( ulCh ), usMean( 0, ulCh ) );
+	}
+
+	/* a transfer complete with the half transfer still pending reads the second half */
+	prvFillHalf( 1, DMA1_IT_TC1 | DMA1_IT_HT1 | DMA1_IT_GL1 );
+	CHECK_EQ( ADC_GetBlockSeq(), 2 );
+	CHECK_EQ( DMA1->ISR & ( DMA1_IT_TC1 | DMA1_IT_HT1 ), 0 );
+	CHECK_EQ( ADC_GetBlock( 9, usBuf ), 2 );
+	CHECK_EQ( usBuf[ 0 ], usSample( 1, 0, 9 ) );
+	CHECK_EQ( ADC_GetFiltered( 0 ), usMean( 1, 0 ) );
+
+	/* ADC_Get() caps at one block */
+	CHECK_EQ( ADC_Get( ADC_Channel_8, usBuf, ADC_SAMPLE_TIMES ), ADC_BLOCK_SAMPLES );
+	CHECK_EQ( ADC_Get( ADC_Channel_9, usBuf, 3 ), 3 );
+	CHECK_EQ( usBuf[ 2 ], usSample( 1, 2, 1 ) );
+
+	/* out of range columns read nothing */
+	CHECK_EQ( ADC_GetBlock( ADC_CHANNEL, usBuf ), 0 );
+	CHECK_EQ( ADC_GetFiltered( ADC_CHANNEL ), 0 );
+}
+
+static uint32_t ulHookHalf, ulHookCalls;
+
+static void prvHook( uint32_t ulHalf )
+{
+	ulHookHalf = ulHalf;
+	ulHookCalls++;
+}
+
+static void test_hook_and_spurious( void )
+{
+	ADC_SetBlockHook( prvHook );
+	prvFillHalf( 0, DMA1_IT_HT1 | DMA1_IT_GL1 );
+	CHECK_EQ( ulHookCalls, 1 );
+	CHECK_EQ( ulHookHalf, 0 );
+
+	/* only the global flag: no block, no hook */
+	prvFillHalf( 1, DMA1_IT_GL1 );
+	CHECK_EQ( ulHookCalls, 1 );
+	CHECK_EQ( ADC_GetBlockSeq(), 3 );
+	ADC_SetBlockHook( NULL );
+}
+
+int main( void )
+{
+	vHostPeriphReset();
+	test_before_first_block();
+	test_halves();
+	test_hook_and_spurious();
+	return TEST_RESULT();
+}
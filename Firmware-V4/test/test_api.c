@@ -0,0 +1,279 @@
+/*
+ * /api/state and /api/stream of webserver/httpd-api.c, fetched over TCP from
+ * the uIP task on the ENC28J60 model.  Each answer must carry the register
+ * image as it stood, whole whatever MSS the client offers, and a stream
+ * must give one line per control period without gaps.  The benchmark is in
+ * simulated time, where a frame through the controller costs a tick.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "mb_reg_map.h"
+#include "modbus.h"
+#include "httpd-api.h"
+
+#include "host.h"
+#include "test.h"
+#include "net_peer.h"
+
+#define FIELDS		"seq,st_l,vset_l,iset_l,v_l,i_l,st_r,vset_r,iset_r,v_r,i_r,pump_hz,vac,t00,t01,t10,t11\n"
+
+static char cBody[ 16384 ];
+
+/* The image for sample k, a vacuum of 3.2e-4 mbar. */
+static void prvSetImage( unsigned k )
+{
+	float fVac = 3.2e-4f;
+	uint32_t ulBits;
+
+	memcpy( &ulBits, &fVac, sizeof( ulBits ) );
+	eMBRegInput_Write( MB_HV_ST_L, 1 );
+	eMBRegInput_Write( MB_VOL_SET_L_ST, 5000 + k );
+	eMBRegInput_Write( MB_CUR_SET_L_ST, 300 );
+	eMBRegInput_Write( MB_VOL_FB_L, 4990 + k );
+	eMBRegInput_Write( MB_CUR_FB_L, 299 );
+	eMBRegInput_Write( MB_HV_ST_R, 0 );
+	eMBRegInput_Write( MB_VOL_SET_R_ST, 0 );
+	eMBRegInput_Write( MB_CUR_SET_R_ST, 0 );
+	eMBRegInput_Write( MB_VOL_FB_R, 3 );
+	eMBRegInput_Write( MB_CUR_FB_R, 65535 );
+	eMBRegInput_Write( MB_MPUMP_FREQ, 400 + k % 100 );
+	eMBRegInput_Write( MB_VMETER0, ( USHORT ) ( ulBits >> 16 ) );
+	eMBRegInput_Write( MB_VMETER1, ( USHORT ) ulBits );
+	eMBRegInput_Write( MB_TEMP00, ( USHORT ) -123 );
+	eMBRegInput_Write( MB_TEMP01, 250 + k );
+	eMBRegInput_Write( MB_TEMP10, 0 );
+	eMBRegInput_Write( MB_TEMP11, 65535 );
+}
+
+/* A sample of that image as JSON or as a CSV row. */
+static void prvExpect( char *pcBuf, unsigned long ulSeq, unsigned k, int iCsv )
+{
+	if( iCsv )
+	{
+		sprintf( pcBuf, "%lu,1,%u,300,%u,299,0,0,0,3,65535,%u,3.20e-4,-123,%u,0,-1\n",
+				 ulSeq, 5000 + k, 4990 + k, 400 + k % 100, 250 + k );
+	}
+	else
+	{
+		sprintf( pcBuf, "{\"seq\":%lu,\"st_l\":1,\"vset_l\":%u,\"iset_l\":300,\"v_l\":%u,\"i_l\":299,"
+				 "\"st_r\":0,\"vset_r\":0,\"iset_r\":0,\"v_r\":3,\"i_r\":65535,\"pump_hz\":%u,"
+				 "\"vac\":3.20e-4,\"t00\":-123,\"t01\":%u,\"t10\":0,\"t11\":-1}\n",
+				 ulSeq, 5000 + k, 4990 + k, 400 + k % 100, 250 + k );
+	}
+}
+
+/* GET pcPath, the body into cBody; 0 when the answer is not a whole 200. */
+static unsigned prvGet( const char *pcPath, uint16_t usMss, const char *pcType, unsigned long *pulSegments, unsigned *puMax )
+{
+	static char cResp[ sizeof( cBody ) + 512 ];
+	char cReq[ 64 ];
+	xPeerTcp xConn = { 0 };
+	char *pcBody;
+
+	xConn.usMss = usMss;
+	xConn.pucRx = ( uint8_t * ) cResp;
+	xConn.uRxMax = sizeof( cResp ) - 1;
+	if( !iPeerConnect( &xConn, 80 ) )
+	{
+		return 0;
+	}
+	sprintf( cReq, "GET %s HTTP/1.0\r\n\r\n", pcPath );
+	vPeerTcpSend( &xConn, cReq, strlen( cReq ) );
+	CHECK( iPeerTcpWait( &xConn, 5000 ) );
+	vPeerTcpAbort( &xConn );
+	cResp[ xConn.ulRxBytes < sizeof( cResp ) ? xConn.ulRxBytes : sizeof( cResp ) - 1 ] = 0;
+	if( pulSegments != NULL )
+	{
+		*pulSegments = xConn.ulSegments;
+		*puMax = xConn.uMaxSegment;
+	}
+
+	pcBody = strstr( cResp, "\r\n\r\n" );
+	if( strncmp( cResp, "HTTP/1.0 200 OK\r\n", 17 ) != 0 || pcBody == NULL || strstr( cResp, pcType ) == NULL )
+	{
+		return 0;
+	}
+	strcpy( cBody, pcBody + 4 );
+	return strlen( cBody );
+}
+
+/* The image as written, in JSON and CSV, with the headers on their own
+ * when a tiny MSS leaves no room. */
+static void test_state( void )
+{
+	static const uint16_t usMss[] = { 0, 536, 64, 24 };
+	char cExpect[ 512 ];
+	unsigned long ulSeq, ulSegments;
+	unsigned i, uMax;
+
+	vPeerStart();
+	prvSetImage( 7 );
+	for( i = 0; i < sizeof( usMss ) / sizeof( usMss[ 0 ] ); i++ )
+	{
+		CHECK( prvGet( "/api/state", usMss[ i ], "application/json", &ulSegments, &uMax ) > 0 );
+		ulSeq = strtoul( cBody + 7, NULL, 10 );
+		prvExpect( cExpect, ulSeq, 7, 0 );
+		CHECK( strcmp( cBody, cExpect ) == 0 );
+		/* no segment beyond what the client can take */
+		CHECK( uMax <= ( usMss[ i ] ? usMss[ i ] : PEER_MSS ) );
+
+		CHECK( prvGet( "/api/state.csv", usMss[ i ], "text/csv", NULL, NULL ) > 0 );
+		CHECK( strncmp( cBody, FIELDS, strlen( FIELDS ) ) == 0 );
+		prvExpect( cExpect, ulSeq, 7, 1 );
+		CHECK( strcmp( cBody + strlen( FIELDS ), cExpect ) == 0 );
+	}
+	CHECK( prvGet( "/api/nothing", 0, "", NULL, NULL ) == 0 );
+	CHECK_EQ( xPeer.ulBadFrames, 0 );
+}
+
+/* One line per sample, in order and each with the image of its period;
+ * two streams at once, a third request gets a single sample. */
+static void test_stream( void )
+{
+	static char cRx[ 2 ][ 1501 * 256 ];
+	xPeerTcp xConn[ 3 ] = { { 0 } };
+	char cReq[] = "GET /api/stream HTTP/1.0\r\n\r\n", cExpect[ 512 ];
+	unsigned long ulFirst = 0, ulSeq;
+	unsigned k, c;
+	char *pcLine;
+
+	vPeerStart();
+	prvSetImage( 0 );
+	for( c = 0; c < 2; c++ )
+	{
+		xConn[ c ].pucRx = ( uint8_t * ) cRx[ c ];
+		xConn[ c ].uRxMax = sizeof( cRx[ c ] ) - 1;
+		CHECK( iPeerConnect( &xConn[ c ], 80 ) );
+		vPeerTcpSend( &xConn[ c ], cReq, sizeof( cReq ) - 1 );
+	}
+	vHostRun( 50 );
+
+	/* the third one is answered and closed */
+	CHECK( iPeerConnect( &xConn[ 2 ], 80 ) );
+	vPeerTcpSend( &xConn[ 2 ], cReq, sizeof( cReq ) - 1 );
+	CHECK( iPeerTcpWait( &xConn[ 2 ], 1000 ) );
+	vPeerTcpAbort( &xConn[ 2 ] );
+
+	/* a control period of 20 ms, for 30 s: the idle abort must not hit */
+	for( k = 1; k <= 1500; k++ )
+	{
+		prvSetImage( k );
+		httpd_api_sample();
+		vHostRun( 20 );
+	}
+
+	for( c = 0; c < 2; c++ )
+	{
+		CHECK_EQ( xConn[ c ].iState, PEER_OPEN );
+		CHECK( xConn[ c ].ulRxBytes < sizeof( cRx[ c ] ) );
+		cRx[ c ][ xConn[ c ].ulRxBytes < sizeof( cRx[ c ] ) ? xConn[ c ].ulRxBytes : sizeof( cRx[ c ] ) - 1 ] = 0;
+		pcLine = strstr( cRx[ c ], "\r\n\r\n" );
+		CHECK( pcLine != NULL );
+		if( pcLine == NULL )
+		{
+			continue;
+		}
+		pcLine += 4;
+		/* the sample taken at the request, then one per period */
+		ulFirst = strtoul( pcLine + 7, NULL, 10 );
+		pcLine = strchr( pcLine, '\n' ) + 1;
+		for( k = 1; k <= 1500 && pcLine != NULL && *pcLine; k++ )
+		{
+			ulSeq = strtoul( pcLine + 7, NULL, 10 );
+			CHECK_EQ( ulSeq, ulFirst + k );
+			prvExpect( cExpect, ulSeq, k, 0 );
+			CHECK( strncmp( pcLine, cExpect, strlen( cExpect ) ) == 0 );
+			pcLine = strchr( pcLine, '\n' );
+			pcLine = pcLine != NULL ? pcLine + 1 : NULL;
+		}
+		CHECK_EQ( k, 1501 );
+		vPeerTcpAbort( &xConn[ c ] );
+	}
+
+	/* the slots are free again */
+	vHostRun( 1000 );
+	xConn[ 0 ].ulRxBytes = 0;
+	CHECK( iPeerConnect( &xConn[ 0 ], 80 ) );
+	vPeerTcpSend( &xConn[ 0 ], cReq, sizeof( cReq ) - 1 );
+	vHostRun( 50 );
+	httpd_api_sample();
+	vHostRun( 50 );
+	CHECK_EQ( xConn[ 0 ].iState, PEER_OPEN );
+	cRx[ 0 ][ xConn[ 0 ].ulRxBytes < sizeof( cRx[ 0 ] ) ? xConn[ 0 ].ulRxBytes : sizeof( cRx[ 0 ] ) - 1 ] = 0;
+	pcLine = strstr( cRx[ 0 ], "\r\n\r\n" );
+	CHECK( pcLine != NULL && strchr( pcLine, '\n' ) != NULL && strchr( strchr( pcLine + 4, '\n' ) + 1, '\n' ) != NULL );
+	vPeerTcpAbort( &xConn[ 0 ] );
+	CHECK_EQ( xPeer.ulBadFrames, 0 );
+}
+
+/* Requests per second one client after another, and the size of a sample. */
+static void test_bench( void )
+{
+	static char cRx[ 501 * 256 ];
+	portTickType xStart;
+	unsigned long ulBytes = 0, ulSegments, ulLines = 0;
+	unsigned n, uMax;
+	xPeerTcp xConn = { 0 };
+	char cReq[] = "GET /api/stream HTTP/1.0\r\n\r\n";
+	char *pcLine;
+
+	vPeerStart();
+	xStart = xTaskGetTickCount();
+	for( n = 0; n < 200; n++ )
+	{
+		prvSetImage( n );
+		ulBytes += prvGet( "/api/state", 0, "application/json", &ulSegments, &uMax );
+	}
+	xStart = xTaskGetTickCount() - xStart;
+	CHECK( xStart > 0 );
+	printf( "/api/state: %lu requests/s, %lu byte samples in %lu segment(s)\n",
+			200000UL / ( unsigned long ) xStart, ulBytes / n, ulSegments );
+
+	xConn.pucRx = ( uint8_t * ) cRx;
+	xConn.uRxMax = sizeof( cRx ) - 1;
+	CHECK( iPeerConnect( &xConn, 80 ) );
+	vPeerTcpSend( &xConn, cReq, sizeof( cReq ) - 1 );
+	vHostRun( 50 );
+	xStart = xTaskGetTickCount();
+	for( n = 0; n < 500; n++ )
+	{
+		prvSetImage( n );
+		httpd_api_sample();
+		vHostRun( 10 );
+	}
+	xStart = xTaskGetTickCount() - xStart;
+	cRx[ xConn.ulRxBytes < sizeof( cRx ) ? xConn.ulRxBytes : sizeof( cRx ) - 1 ] = 0;
+	pcLine = strstr( cRx, "\r\n\r\n" );
+	CHECK( pcLine != NULL );
+	if( pcLine != NULL )
+	{
+		pcLine += 3;
+		ulBytes = xConn.ulRxBytes - ( unsigned long ) ( pcLine + 1 - cRx );
+	}
+	while( pcLine != NULL && ( pcLine = strchr( pcLine + 1, '\n' ) ) != NULL )
+	{
+		ulLines++;
+	}
+	/* the sample at the request, then one a period */
+	CHECK_EQ( ulLines, 1 + 500 );
+	if( ulLines > 1 )
+	{
+		printf( "/api/stream: %lu samples/s at a 10 ms period, %lu bytes a sample\n",
+				( ulLines - 1 ) * 1000UL / ( unsigned long ) xStart, ulBytes / ulLines );
+	}
+	vPeerTcpAbort( &xConn );
+}
+
+int main( void )
+{
+	test_state();
+	test_stream();
+	test_bench();
+	return TEST_RESULT();
+}
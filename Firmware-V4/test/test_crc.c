@@ -0,0 +1,141 @@
+/*
+ * The Modbus CRC16 of mbcrc.c: known answers, the slicing-by-4 path against
+ * a bit at a time reference on every length and split, and how fast it is
+ * against the byte-wise table it replaced.
+ */
+
+#include <stdio.h>
+#include <time.h>
+
+#include "port.h"
+#include "mbcrc.h"
+
+#include "test.h"
+
+/* The polynomial as the Modbus specification gives it. */
+static USHORT usCRCBitwise( const UCHAR *pucData, USHORT usLen )
+{
+	USHORT usCRC = 0xFFFF;
+	int i;
+
+	while( usLen-- )
+	{
+		usCRC ^= *pucData++;
+		for( i = 0; i < 8; i++ )
+		{
+			usCRC = ( usCRC & 1 ) ? ( usCRC >> 1 ) ^ 0xA001 : usCRC >> 1;
+		}
+	}
+	return usCRC;
+}
+
+/* The classic freemodbus loop, one table lookup per byte. */
+static USHORT usCRCBytewise( const UCHAR *pucData, USHORT usLen )
+{
+	USHORT usCRC = MB_CRC16_INIT;
+
+	while( usLen-- )
+	{
+		usCRC = MB_CRC16_BYTE( usCRC, *pucData++ );
+	}
+	return usCRC;
+}
+
+static void test_known_answers( void )
+{
+	/* read 10 holding registers from slave 1, and the example of the spec */
+	UCHAR ucRead[] = { 0x01, 0x03, 0x00, 0x00, 0x00, 0x0A, 0xC5, 0xCD };
+	UCHAR ucSpec[] = { 0x11, 0x03, 0x00, 0x6B, 0x00, 0x03, 0x76, 0x87 };
+
+	CHECK_EQ( usMBCRC16( ( UCHAR * ) "123456789", 9 ), 0x4B37 );
+	CHECK_EQ( usMBCRC16( ucRead, 0 ), 0xFFFF );
+	CHECK_EQ( usMBCRC16( ucRead, 6 ), 0xCDC5 );
+	CHECK_EQ( usMBCRC16( ucSpec, 6 ), 0x8776 );
+
+	/* a frame with its CRC, low byte first, leaves no residue */
+	CHECK_EQ( usMBCRC16( ucRead, 8 ), 0 );
+	CHECK_EQ( usMBCRC16( ucSpec, 8 ), 0 );
+	ucSpec[ 3 ] ^= 0x10;
+	CHECK( usMBCRC16( ucSpec, 8 ) != 0 );
+}
+
+static void test_against_reference( void )
+{
+	static UCHAR ucBuf[ 300 ];
+	USHORT usLen, usSplit, usCRC;
+	unsigned long ulOffset;
+
+	for( usLen = 0; usLen < sizeof( ucBuf ); usLen++ )
+	{
+		ucBuf[ usLen ] = ( UCHAR ) ulTestRand();
+	}
+
+	/* every length from every alignment */
+	for( ulOffset = 0; ulOffset < 4; ulOffset++ )
+	{
+		for( usLen = 0; usLen <= 256; usLen++ )
+		{
+			CHECK_EQ( usMBCRC16( ucBuf + ulOffset, usLen ), usCRCBitwise( ucBuf + ulOffset, usLen ) );
+		}
+	}
+
+	/* a frame fed in two pieces, as the receive path folds it */
+	for( usSplit = 0; usSplit <= 64; usSplit++ )
+	{
+		usCRC = usMBCRC16Update( MB_CRC16_INIT, ucBuf, usSplit );
+		usCRC = usMBCRC16Update( usCRC, ucBuf + usSplit, 64 - usSplit );
+		CHECK_EQ( usCRC, usCRCBitwise( ucBuf, 64 ) );
+		CHECK_EQ( usCRCBytewise( ucBuf, usSplit + 1 ), usCRCBitwise( ucBuf, usSplit + 1 ) );
+	}
+}
+
+static double dSeconds( void )
+{
+	struct timespec xNow;
+
+	clock_gettime( CLOCK_MONOTONIC, &xNow );
+	return xNow.tv_sec + xNow.tv_nsec / 1e9;
+}
+
+/* Not a check, the numbers depend on the host.  256 bytes is the longest RTU frame. */
+static void bench( void )
+{
+	static UCHAR ucFrame[ 256 ];
+	const unsigned long ulRounds = 20000;
+	volatile USHORT usSink = 0;
+	unsigned long i;
+	double dT0, dByte, dSlice;
+
+	for( i = 0; i < sizeof( ucFrame ); i++ )
+	{
+		ucFrame[ i ] = ( UCHAR ) ulTestRand();
+	}
+
+	dT0 = dSeconds();
+	for( i = 0; i < ulRounds; i++ )
+	{
+		usSink ^= usCRCBytewise( ucFrame, sizeof( ucFrame ) );
+	}
+	dByte = dSeconds() - dT0;
+
+	dT0 = dSeconds();
+	for( i = 0; i < ulRounds; i++ )
+	{
+		usSink ^= usMBCRC16( ucFrame, sizeof( ucFrame ) );
+	}
+	dSlice = dSeconds() - dT0;
+
+	printf( "crc16 %u byte frames: byte-wise %.0f MB/s, slicing-by-4 %.0f MB/s\n",
+			( unsigned ) sizeof( ucFrame ),
+			ulRounds * sizeof( ucFrame ) / dByte / 1e6, ulRounds * sizeof( ucFrame ) / dSlice / 1e6 );
+	CHECK_EQ( usSink, 0 );
+}
+
+int main( void )
+{
+	vTestSeed( 9 );
+	test_known_answers();
+	test_against_reference();
+	bench();
+	return TEST_RESULT();
+}
@@ -0,0 +1,175 @@
+/*
+ * Widget frames across the panel's two pages.  main_win_draw() leaves the
+ * same screen in both, and with WIDGET_DOUBLE_BUFFER every flush draws
+ * into the page that is not shown, flips once and leaves both pages equal,
+ * so no pixel of a frame goes into the page on the screen.  WidgetStats
+ * counts what was drawn.  test_dbuf_single builds the same file against
+ * widgets that draw into the page shown, the bench line of the two is the
+ * cost of the second page.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+#include "stm32f10x.h"
+#include "fonts.h"
+#include "lcd.h"
+#include "widget.h"
+#include "window.h"
+#include "win_main.h"
+#include "gl_696h.h"
+#include "modbus.h"
+
+#include "host.h"
+#include "test.h"
+#include "lcd_model.h"
+
+#define PAGE_FILL		0xAAAA
+#define REFRESHES		120
+
+#define LCD_MODEL_WRITTEN()		( ( xLcd.ucPageReg >> 3 ) & 1 )
+
+/* lcd.c and win_main.c, called from WinTask. */
+void prvConfigureLCD( void );
+void main_win_draw( void );
+void main_win_refresh( void );
+
+static uint16_t usScreen[ LCD_MODEL_HEIGHT ][ LCD_MODEL_WIDTH ];
+
+static int prvPagesEqual( void )
+{
+	return memcmp( xLcd.usPage[ 0 ], xLcd.usPage[ 1 ], sizeof( xLcd.usPage[ 0 ] ) ) == 0;
+}
+
+static void prvReadings( unsigned long ulNoise )
+{
+	hvsl.vol_fb = ( unsigned short ) ( 5000 + ulNoise % 1001 );
+	hvsl.cur_fb = ( unsigned short ) ( 3000 + ulNoise % 97 );
+	hvsr.vol_fb = ( unsigned short ) ( 4000 + ulNoise % 577 );
+	hvsr.cur_fb = 2000;
+	vmeter = 2.5f;
+	eMBRegInput_Write( MB_MPUMP_FREQ, 820 );
+}
+
+static void prvStart( void )
+{
+	vHostReset();
+	vLcdModelReset( PAGE_FILL );
+	prvConfigureLCD();
+	hvsl.vol_set = 5000;
+	hvsl.cur_set = 3000;
+	hvsr.vol_set = 4000;
+	hvsr.cur_set = 2000;
+	prvReadings( 0 );
+	vLcdModelCount();
+	main_win_draw();
+}
+
+/* The static screen goes into both pages, the one shown last. */
+static void test_draw( void )
+{
+	unsigned long ulBlank = 0;
+	unsigned x, y;
+
+	prvStart();
+	CHECK( prvPagesEqual() );
+	CHECK_EQ( xLcd.ulShownPixels, 0 );
+	CHECK_EQ( LCD_MODEL_WRITTEN(), LCD_MODEL_SHOWN() );
+	for( y = 0; y < LCD_MODEL_HEIGHT; y++ )
+	{
+		for( x = 0; x < LCD_MODEL_WIDTH; x++ )
+		{
+			ulBlank += xLcd.usPage[ 0 ][ y ][ x ] == PAGE_FILL;
+		}
+	}
+	CHECK( ulBlank < LCD_MODEL_WIDTH * LCD_MODEL_HEIGHT / 2 );
+	CHECK_EQ( xLcd.ulErrors + xLcd.ulOutside + xLcd.ulOffPanel, 0 );
+	printf( "main_win_draw(): %lu px, %lu us bus\n", xLcd.ulPixels, ulLcdModelNs() / 1000 );
+}
+
+/* Every frame: what the stats say was drawn was drawn, into the page it
+   should go to, and the screen is what a redraw gives. */
+static void test_frames( void )
+{
+	unsigned long ulPixels = 0, ulShown = 0, ulNs = 0, ulEmpty = 0;
+	uint32_t ulWritten;
+	sWidgetStats xBefore;
+	unsigned i, uShown;
+
+	prvStart();
+	main_win_refresh();
+	Widget_Flush( win_main.psWidgets );
+	vHostRun( 1000 );
+
+	vTestSeed( 25 );
+	for( i = 0; i < REFRESHES; i++ )
+	{
+		xBefore = WidgetStats;
+		uShown = LCD_MODEL_SHOWN();
+		vLcdModelCount();
+		prvReadings( ulTestRand() );
+		main_win_refresh();
+		ulWritten = Widget_Flush( win_main.psWidgets );
+
+		CHECK_EQ( ulWritten, xLcd.ulPixels );
+		CHECK_EQ( WidgetStats.frames, xBefore.frames + ( ulWritten > 0 ) );
+		CHECK_EQ( WidgetStats.pixels, xBefore.pixels + ulWritten );
+		CHECK_EQ( WidgetStats.budget_cuts, xBefore.budget_cuts );
+		CHECK( WidgetStats.max_frame_us >= WidgetStats.frame_us );
+		if( ulWritten > 0 )
+		{
+			CHECK_EQ( WidgetStats.frame_pixels, ulWritten );
+		}
+		CHECK_EQ( LCD_MODEL_WRITTEN(), LCD_MODEL_SHOWN() );
+#if WIDGET_DOUBLE_BUFFER
+		CHECK_EQ( xLcd.ulShownPixels, 0 );
+		CHECK_EQ( WidgetStats.flips, xBefore.flips + ( ulWritten > 0 ) );
+		CHECK_EQ( LCD_MODEL_SHOWN(), uShown ^ ( ulWritten > 0 ) );
+		CHECK( prvPagesEqual() );
+#else
+		CHECK_EQ( xLcd.ulShownPixels, ulWritten );
+		CHECK_EQ( WidgetStats.flips, xBefore.flips );
+		CHECK_EQ( LCD_MODEL_SHOWN(), uShown );
+#endif
+		CHECK_EQ( xLcd.ulErrors + xLcd.ulOutside + xLcd.ulOffPanel, 0 );
+		ulPixels += ulWritten;
+		ulShown += xLcd.ulShownPixels;
+		ulNs += ulLcdModelNs();
+		ulEmpty += ulWritten == 0;
+		vHostRun( 500 );
+	}
+	CHECK( ulEmpty < REFRESHES / 10 );
+
+	/* nothing changed, no frame */
+	xBefore = WidgetStats;
+	vLcdModelCount();
+	main_win_refresh();
+	CHECK_EQ( Widget_Flush( win_main.psWidgets ), 0 );
+	CHECK_EQ( xLcd.ulStores, 0 );
+	CHECK_EQ( WidgetStats.frames, xBefore.frames );
+	CHECK_EQ( WidgetStats.flips, xBefore.flips );
+
+	/* the page shown is a full redraw of the widgets */
+	memcpy( usScreen, xLcd.usPage[ LCD_MODEL_SHOWN() ], sizeof( usScreen ) );
+	Widget_Invalidate( win_main.psWidgets );
+	Widget_Flush( win_main.psWidgets );
+	CHECK( memcmp( usScreen, xLcd.usPage[ LCD_MODEL_SHOWN() ], sizeof( usScreen ) ) == 0 );
+#if WIDGET_DOUBLE_BUFFER
+	CHECK( prvPagesEqual() );
+#endif
+
+	printf( "%s, %u refreshes: %5lu px, %4lu us bus a refresh, %5lu px into the page shown\n",
+			WIDGET_DOUBLE_BUFFER ? "double buffered" : "single page", REFRESHES, ulPixels / REFRESHES,
+			ulNs / REFRESHES / 1000, ulShown / REFRESHES );
+}
+
+int main( void )
+{
+	test_draw();
+	test_frames();
+	return TEST_RESULT();
+}
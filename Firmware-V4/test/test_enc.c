@@ -0,0 +1,181 @@
+/*
+ * webserver/enc28j60.c against a register model of the controller: frames
+ * come out of the receive ring whole whether they are read by hand or by
+ * DMA, go into the transmit buffer as given, and a DMA burst that does not
+ * finish drops its frame instead of passing on what was in the buffer.
+ */
+
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+
+#include "stm32f10x.h"
+#include "enc28j60.h"
+#include "netbuf.h"
+
+#include "host.h"
+#include "test.h"
+#include "enc_model.h"
+
+extern xSemaphoreHandle xEMACSemaphore;
+
+/* the longest frame that fits a pool buffer, and the DMA threshold */
+#define FRAME_MAX	( netBUF_SIZE < 1514 ? netBUF_SIZE : 1514 )
+#define DMA_MIN		32
+
+static void prvStart( void )
+{
+	vHostReset();
+	vHostPeriphReset();
+	vEncModelInit();
+	vHostAddTickHook( vEncModelTick );
+	CHECK_EQ( eth_init( NULL ), 1 );
+	memset( &xNetStats, 0, sizeof( xNetStats ) );
+	xNetStats.usFree = netBUF_COUNT;
+}
+
+/* The next frame uIP would get, checked against the pattern it was sent
+ * with; 0 when there is none. */
+static int prvTake( unsigned uLen, uint8_t ucSeed )
+{
+	xNetBuf *pxBuf;
+	unsigned i;
+	int iOk;
+
+	if( xQueueReceive( xNetRxQueue, &pxBuf, 0 ) != pdTRUE )
+	{
+		return 0;
+	}
+	iOk = pxBuf != NULL && pxBuf->usLength == uLen;
+	for( i = 0; iOk && i < uLen; i++ )
+	{
+		iOk = pxBuf->ucData[ i ] == ( uint8_t ) ( ucSeed + i );
+	}
+	CHECK( iOk );
+	vNetBufFree( pxBuf );
+	return 1;
+}
+
+/* Batches of 1 to 3 frames of every size through the ring, wrapping it many
+ * times, and a reply to each. */
+static void test_rx_tx( void )
+{
+	static uint8_t ucReply[ 1514 ];
+	unsigned uLen[ 3 ], uBatch, n, i;
+	uint8_t ucSeed[ 3 ];
+	unsigned long ulFrames = 0;
+
+	prvStart();
+	for( n = 0; n < 600; n++ )
+	{
+		uBatch = 1 + n % 3;
+		for( i = 0; i < uBatch; i++ )
+		{
+			uLen[ i ] = ( n & 3 ) == 0 ? 14 + ulTestRand() % DMA_MIN : 60 + ulTestRand() % ( FRAME_MAX - 59 );
+			ucSeed[ i ] = ( uint8_t ) ulTestRand();
+			CHECK( iEncModelInject( uLen[ i ], ucSeed[ i ] ) );
+		}
+		CHECK_EQ( eth_rx(), uBatch );
+		for( i = 0; i < uBatch; i++ )
+		{
+			CHECK( prvTake( uLen[ i ], ucSeed[ i ] ) );
+		}
+		ulFrames += uBatch;
+
+		for( i = 0; i < uLen[ 0 ]; i++ )
+		{
+			ucReply[ i ] = ( uint8_t ) ( ucSeed[ 0 ] ^ i );
+		}
+		CHECK_EQ( eth_send( ucReply, uLen[ 0 ] ), 0 );
+		CHECK_EQ( xEnc.uTxLen, uLen[ 0 ] );
+		CHECK( memcmp( xEnc.ucTx, ucReply, uLen[ 0 ] ) == 0 );
+	}
+	CHECK_EQ( xEnc.ulTxFrames, 600 );
+	CHECK( xEnc.ulBursts > ulFrames / 2 );
+	CHECK_EQ( xEnc.ulRxDropped, 0 );
+	CHECK_EQ( xEnc.ulErrors, 0 );
+	CHECK_EQ( xNetStats.ulSpiErrors, 0 );
+}
+
+/* A receive burst that stops halfway drops its frame and resets the ring,
+ * the frames behind it are lost with it and the next ones come through. */
+static void test_rx_stall( void )
+{
+	unsigned i;
+
+	prvStart();
+	for( i = 0; i < 3; i++ )
+	{
+		CHECK( iEncModelInject( 200, ( uint8_t ) ( 10 * i ) ) );
+	}
+	xEnc.uStall = 1;
+	CHECK_EQ( eth_rx(), 0 );
+	CHECK_EQ( xNetStats.ulSpiErrors, 1 );
+	CHECK( !prvTake( 200, 0 ) );
+
+	/* the receiver stays in reset for a while, then starts over */
+	vHostRun( 20 );
+	CHECK_EQ( eth_rx(), 0 );
+	CHECK_EQ( xEnc.ucReg[ 1 ][ 0x19 ], 0 );
+	for( i = 0; i < 3; i++ )
+	{
+		CHECK( iEncModelInject( 300 + i, ( uint8_t ) ( 7 * i ) ) );
+	}
+	CHECK_EQ( eth_rx(), 3 );
+	for( i = 0; i < 3; i++ )
+	{
+		CHECK( prvTake( 300 + i, ( uint8_t ) ( 7 * i ) ) );
+	}
+	CHECK_EQ( xEnc.ulErrors, 0 );
+}
+
+/* A transmit burst that times out is not sent, and its completion coming
+ * in late does not cut the next burst short. */
+static void test_tx_late( void )
+{
+	static uint8_t ucFrame[ 600 ];
+	unsigned i;
+
+	prvStart();
+	for( i = 0; i < sizeof( ucFrame ); i++ )
+	{
+		ucFrame[ i ] = ( uint8_t ) ( i * 7 );
+	}
+	xEnc.uStall = 1;
+	xEnc.iLateIrq = 1;
+	CHECK_EQ( eth_send( ucFrame, 400 ), -1 );
+	CHECK_EQ( xEnc.ulTxFrames, 0 );
+	CHECK_EQ( xNetStats.ulSpiErrors, 1 );
+
+	vHostRun( 1 );
+	CHECK_EQ( eth_send( ucFrame + 1, 500 ), 0 );
+	CHECK_EQ( xEnc.ulTxFrames, 1 );
+	CHECK_EQ( xEnc.uTxLen, 500 );
+	CHECK( memcmp( xEnc.ucTx, ucFrame + 1, 500 ) == 0 );
+
+	/* and the same for a receive burst */
+	xEnc.uStall = 1;
+	CHECK( iEncModelInject( 100, 1 ) );
+	CHECK_EQ( eth_rx(), 0 );
+	vHostRun( 20 );
+	eth_rx();
+	CHECK( iEncModelInject( 700, 2 ) );
+	CHECK_EQ( eth_rx(), 1 );
+	CHECK( prvTake( 700, 2 ) );
+	CHECK_EQ( xNetStats.ulSpiErrors, 2 );
+	CHECK_EQ( xEnc.ulErrors, 0 );
+}
+
+int main( void )
+{
+	vTestSeed( 15 );
+	vNetBufInit();
+	vSemaphoreCreateBinary( xEMACSemaphore );
+	test_rx_tx();
+	test_rx_stall();
+	test_tx_late();
+	return TEST_RESULT();
+}
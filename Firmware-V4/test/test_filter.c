@@ -0,0 +1,192 @@
+/*
+ * filter.c against qsort() on random windows, and the timing of the
+ * trimmed mean against the exchange sort it replaced.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "stm32f10x.h"
+#include "adc.h"
+#include "filter.h"
+
+#include "test.h"
+
+#define RUNS	200000
+
+static int prvCmp( const void *pv1, const void *pv2 )
+{
+	return ( int ) *( const uint16_t * ) pv1 - ( int ) *( const uint16_t * ) pv2;
+}
+
+/* Small ranges make ties, the case partitioning gets wrong. */
+static void prvRandom( uint16_t *pusDat, uint16_t usLen )
+{
+	uint16_t i, usRange = ( ulTestRand() & 1 ) ? 4096 : 1 + ulTestRand() % 8;
+
+	for( i = 0; i < usLen; i++ )
+	{
+		pusDat[ i ] = ( uint16_t ) ( ulTestRand() % usRange );
+	}
+}
+
+static void test_select_and_trim( void )
+{
+	uint16_t usDat[ FILTER_MAX_WINDOW ], usWork[ FILTER_MAX_WINDOW ], usSorted[ FILTER_MAX_WINDOW ];
+	uint16_t usLen, usK, usTrim, usN, i;
+	uint32_t ulSum;
+	long lRun;
+
+	for( lRun = 0; lRun < RUNS; lRun++ )
+	{
+		usLen = 1 + ulTestRand() % FILTER_MAX_WINDOW;
+		prvRandom( usDat, usLen );
+		memcpy( usSorted, usDat, sizeof( usDat ) );
+		qsort( usSorted, usLen, sizeof( uint16_t ), prvCmp );
+
+		usK = ulTestRand() % usLen;
+		memcpy( usWork, usDat, sizeof( usDat ) );
+		CHECK_EQ( select_nth16( usWork, usLen, usK ), usSorted[ usK ] );
+		for( i = 0; i < usLen; i++ )
+		{
+			if( ( i < usK && usWork[ i ] > usWork[ usK ] ) || ( i > usK && usWork[ i ] < usWork[ usK ] ) )
+			{
+				CHECK( !"select_nth16 left the window unpartitioned" );
+				break;
+			}
+		}
+
+		usTrim = ulTestRand() % ( usLen / 2 + 2 );
+		usN = usTrim * 2 >= usLen ? usLen - ( usLen - 1 ) / 2 * 2 : usLen - 2 * usTrim;
+		for( ulSum = 0, i = ( usLen - usN ) / 2; i < ( usLen - usN ) / 2 + usN; i++ )
+		{
+			ulSum += usSorted[ i ];
+		}
+		memcpy( usWork, usDat, sizeof( usDat ) );
+		CHECK_EQ( trimmed_mean16( usWork, usLen, usTrim ), ulSum / usN );
+		if( iTestFailures > 10 )
+		{
+			return;
+		}
+	}
+}
+
+static void test_median_window( void )
+{
+	uint16_t usRing[ FILTER_MAX_WINDOW ], usSortedWin[ FILTER_MAX_WINDOW ];
+	uint16_t usHist[ RUNS / 10 ], usSorted[ FILTER_MAX_WINDOW ];
+	uint16_t usSize, usN, i;
+	MEDIAN_FILTER xMf;
+	long lRun, lStart;
+
+	for( usSize = 1; usSize <= FILTER_MAX_WINDOW; usSize += 3 )
+	{
+		median_init( &xMf, usRing, usSortedWin, usSize );
+		prvRandom( usHist, RUNS / 10 );
+		for( lRun = 0; lRun < RUNS / 10; lRun++ )
+		{
+			lStart = lRun + 1 > usSize ? lRun + 1 - usSize : 0;
+			usN = ( uint16_t ) ( lRun + 1 - lStart );
+			for( i = 0; i < usN; i++ )
+			{
+				usSorted[ i ] = usHist[ lStart + i ];
+			}
+			qsort( usSorted, usN, sizeof( uint16_t ), prvCmp );
+			CHECK_EQ( median_update( &xMf, usHist[ lRun ] ), usSorted[ usN / 2 ] );
+			if( iTestFailures > 10 )
+			{
+				return;
+			}
+		}
+	}
+}
+
+static void test_queue( void )
+{
+	uint16_t usBuf[ 8 ], usOut[ 8 ], i;
+	QUEUE xQ;
+
+	init_queue( &xQ, usBuf, 8 );
+	CHECK_EQ( queue_count( &xQ ), 0 );
+	CHECK_EQ( queue_median16( &xQ ), 0 );
+	for( i = 1; i <= 10; i++ )
+	{
+		CHECK_EQ( enqueue( &xQ, i * 10 ), i >= 8 );
+	}
+	/* seven kept, oldest first */
+	CHECK_EQ( queue_copy16( &xQ, usOut, 8 ), 7 );
+	CHECK_EQ( usOut[ 0 ], 40 );
+	CHECK_EQ( usOut[ 6 ], 100 );
+	CHECK_EQ( queue_copy16( &xQ, usOut, 3 ), 3 );
+	CHECK_EQ( usOut[ 0 ], 80 );
+	CHECK_EQ( queue_median16( &xQ ), 70 );
+	CHECK_EQ( queue_trimmed_mean16( &xQ, 2 ), 70 );
+	/* the filters read the ring, they do not sort it */
+	CHECK_EQ( queue_copy16( &xQ, usOut, 8 ), 7 );
+	CHECK_EQ( usOut[ 0 ], 40 );
+}
+
+static void test_ema( void )
+{
+	EMA_FILTER xEf;
+	uint16_t usY = 0;
+	int i;
+
+	ema_init( &xEf, 3 );
+	CHECK_EQ( ema_update( &xEf, 1000 ), 1000 );
+	for( i = 0; i < 200; i++ )
+	{
+		usY = ema_update( &xEf, 2000 );
+	}
+	CHECK( usY >= 1992 && usY <= 2000 );
+}
+
+/* Not checked, printed for the record. */
+static void bench( void )
+{
+	uint16_t usDat[ 1024 ][ ADC_SAMPLE_TIMES ], usWork[ ADC_SAMPLE_TIMES ];
+	volatile uint32_t ulSink = 0;
+	clock_t xT0, xT1, xT2;
+	int i, r;
+
+	for( i = 0; i < 1024; i++ )
+	{
+		prvRandom( usDat[ i ], ADC_SAMPLE_TIMES );
+	}
+	xT0 = clock();
+	for( r = 0; r < 50; r++ )
+	{
+		for( i = 0; i < 1024; i++ )
+		{
+			memcpy( usWork, usDat[ i ], sizeof( usWork ) );
+			exchange_sort16( usWork, ADC_SAMPLE_TIMES );
+			ulSink += get_average16( usWork + 4, ADC_SAMPLE_TIMES - 8 );
+		}
+	}
+	xT1 = clock();
+	for( r = 0; r < 50; r++ )
+	{
+		for( i = 0; i < 1024; i++ )
+		{
+			memcpy( usWork, usDat[ i ], sizeof( usWork ) );
+			ulSink += trimmed_mean16( usWork, ADC_SAMPLE_TIMES, 4 );
+		}
+	}
+	xT2 = clock();
+	printf( "%lu windows of %lu: exchange sort %.0f ns, trimmed mean %.0f ns\n",
+			50UL * 1024, ADC_SAMPLE_TIMES,
+			( double ) ( xT1 - xT0 ) * 1e9 / CLOCKS_PER_SEC / ( 50 * 1024 ),
+			( double ) ( xT2 - xT1 ) * 1e9 / CLOCKS_PER_SEC / ( 50 * 1024 ) );
+}
+
+int main( void )
+{
+	vTestSeed( 2002 );
+	test_select_and_trim();
+	test_median_window();
+	test_queue();
+	test_ema();
+	bench();
+	return TEST_RESULT();
+}
@@ -0,0 +1,269 @@
+/*
+ * The ROM filesystem from makefsdata and the way httpd serves it, fetched
+ * over TCP from the uIP task on the ENC28J60 model.  Every stored name must
+ * be found through the sorted index and nothing else; a gzipped file goes
+ * out as stored with Content-Encoding: gzip and a strong ETag, a client
+ * holding that tag gets a 304, one that rules gzip out a 406.  The
+ * benchmark counts the segments uIP sends for a page, before the split of
+ * uIP_Task.c doubles the larger ones on the wire.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "netbuf.h"
+#include "httpd-fs.h"
+#include "httpd-fsdata.h"
+
+#include "host.h"
+#include "test.h"
+#include "net_peer.h"
+
+/* makefsdata links the files from the last name back to the first. */
+extern const struct httpd_fsdata_file file_tcp_shtml[];
+
+static char cResp[ 16384 ];
+static unsigned uResp;
+static unsigned long ulSent;		/* segments uIP sent for the answer */
+
+/* The request, in two segments when pcSecond is set; the answer goes to
+ * cResp, 0 when the device did not close the connection. */
+static int prvGet( uint16_t usMss, const char *pcFirst, const char *pcSecond )
+{
+	xPeerTcp xConn = { 0 };
+	unsigned long ulSplit;
+	int iDone;
+
+	xConn.usMss = usMss;
+	xConn.pucRx = ( uint8_t * ) cResp;
+	xConn.uRxMax = sizeof( cResp ) - 1;
+	if( !iPeerConnect( &xConn, 80 ) )
+	{
+		return 0;
+	}
+	ulSplit = xNetStats.ulTxSplit;
+	vPeerTcpSend( &xConn, pcFirst, strlen( pcFirst ) );
+	if( pcSecond != NULL )
+	{
+		vHostRun( 20 );
+		vPeerTcpSend( &xConn, pcSecond, strlen( pcSecond ) );
+	}
+	iDone = iPeerTcpWait( &xConn, 5000 );
+	vPeerTcpAbort( &xConn );
+	uResp = xConn.ulRxBytes < sizeof( cResp ) ? ( unsigned ) xConn.ulRxBytes : sizeof( cResp ) - 1;
+	cResp[ uResp ] = 0;
+	ulSent = xConn.ulSegments - ( xNetStats.ulTxSplit - ulSplit );
+	return iDone;
+}
+
+/* The body of the answer and its length. */
+static const char *prvBody( unsigned *puLen )
+{
+	const char *pcBody = strstr( cResp, "\r\n\r\n" );
+
+	if( pcBody == NULL )
+	{
+		*puLen = 0;
+		return cResp + uResp;
+	}
+	pcBody += 4;
+	*puLen = uResp - ( unsigned ) ( pcBody - cResp );
+	return pcBody;
+}
+
+/* The header line starting with pcName, up to its end, or "". */
+static const char *prvHeader( const char *pcName )
+{
+	static char cLine[ 128 ];
+	const char *pcEnd = strstr( cResp, "\r\n\r\n" ), *p = strstr( cResp, pcName );
+	unsigned n = 0;
+
+	cLine[ 0 ] = 0;
+	if( p != NULL && pcEnd != NULL && p < pcEnd )
+	{
+		while( p[ n ] != '\r' && n < sizeof( cLine ) - 1 )
+		{
+			cLine[ n ] = p[ n ];
+			n++;
+		}
+		cLine[ n ] = 0;
+	}
+	return cLine;
+}
+
+/* FNV-1a over the stored bytes, the tag makefsdata writes. */
+static unsigned long prvFnv( const char *pcData, int iLen )
+{
+	unsigned long ulHash = 0x811c9dc5UL;
+
+	while( iLen-- > 0 )
+	{
+		ulHash ^= ( unsigned char ) *pcData++;
+		ulHash = ( ulHash * 0x01000193UL ) & 0xffffffffUL;
+	}
+	return ulHash;
+}
+
+/* Every file in the list through httpd_fs_open(), in sorted order, and the
+ * names that are not there miss. */
+static void test_index( void )
+{
+	static const char *pcMiss[] = { "", "/", "/4", "/404.htm", "/404.html2", "/index", "/io.shtm",
+									"/tcp.shtmlx", "/zzz", "/A.html", "/index.html/" };
+	const struct httpd_fsdata_file *pxFile;
+	struct httpd_fs_file xFile;
+	const char *pcLast = NULL;
+	unsigned uFiles = 0, i;
+
+	httpd_fs_init();
+	for( pxFile = file_tcp_shtml; pxFile != NULL; pxFile = pxFile->next )
+	{
+		if( pcLast != NULL )
+		{
+			CHECK( strcmp( pxFile->name, pcLast ) < 0 );
+		}
+		pcLast = pxFile->name;
+		uFiles++;
+
+		memset( &xFile, 0, sizeof( xFile ) );
+		CHECK( httpd_fs_open( pxFile->name, &xFile ) );
+		CHECK( xFile.data == pxFile->data );
+		CHECK_EQ( xFile.len, pxFile->len );
+		CHECK_EQ( xFile.etag, pxFile->etag );
+		CHECK_EQ( xFile.flags, pxFile->flags );
+		CHECK( pxFile->etag == 0 || pxFile->etag == prvFnv( pxFile->data, pxFile->len ) );
+		/* no stray terminator counted in the length */
+		CHECK( pxFile->len > 0 && pxFile->data[ pxFile->len ] == 0 );
+		CHECK_EQ( httpd_fs_count( ( char * ) pxFile->name ), 1 );
+	}
+	CHECK( uFiles >= 7 );
+	for( i = 0; i < sizeof( pcMiss ) / sizeof( pcMiss[ 0 ] ); i++ )
+	{
+		CHECK( !httpd_fs_open( pcMiss[ i ], &xFile ) );
+	}
+	CHECK_EQ( httpd_fs_count( "/nothing" ), 0 );
+}
+
+/* The gzipped page as stored, with its tag, and the ways to ask for it. */
+static void test_gzip( void )
+{
+	static const uint16_t usMss[] = { 0, 536, 128, 48 };
+	struct httpd_fs_file xFile;
+	const char *pcBody;
+	char cTag[ 64 ], cReq[ 256 ];
+	unsigned uLen, i;
+
+	vPeerStart();
+	CHECK( httpd_fs_open( "/index.html", &xFile ) );
+	CHECK( xFile.flags & HTTPD_FS_GZIP );
+	CHECK( xFile.etag != 0 );
+	sprintf( cTag, "ETag: \"%08lx\"", xFile.etag );
+
+	for( i = 0; i < sizeof( usMss ) / sizeof( usMss[ 0 ] ); i++ )
+	{
+		CHECK( prvGet( usMss[ i ], "GET /index.html HTTP/1.0\r\nAccept-Encoding: gzip, deflate\r\n\r\n", NULL ) );
+		CHECK( strncmp( cResp, "HTTP/1.0 200 OK\r\n", 17 ) == 0 );
+		CHECK( strcmp( prvHeader( "Content-Encoding:" ), "Content-Encoding: gzip" ) == 0 );
+		CHECK( strcmp( prvHeader( "ETag:" ), cTag ) == 0 );
+		CHECK( strcmp( prvHeader( "Cache-Control:" ), "Cache-Control: max-age=300" ) == 0 );
+		CHECK( strcmp( prvHeader( "Content-type:" ), "Content-type: text/html" ) == 0 );
+		pcBody = prvBody( &uLen );
+		CHECK_EQ( uLen, ( unsigned ) xFile.len );
+		CHECK( uLen == ( unsigned ) xFile.len && memcmp( pcBody, xFile.data, uLen ) == 0 );
+		CHECK( ( unsigned char ) pcBody[ 0 ] == 0x1f && ( unsigned char ) pcBody[ 1 ] == 0x8b );
+	}
+
+	/* no Accept-Encoding at all takes anything */
+	CHECK( prvGet( 0, "GET / HTTP/1.0\r\n\r\n", NULL ) );
+	CHECK( strcmp( prvHeader( "Content-Encoding:" ), "Content-Encoding: gzip" ) == 0 );
+	pcBody = prvBody( &uLen );
+	CHECK_EQ( uLen, ( unsigned ) xFile.len );
+
+	/* gzip ruled out, only the gzipped copy is stored */
+	CHECK( prvGet( 0, "GET /index.html HTTP/1.0\r\nAccept-Encoding: identity\r\n\r\n", NULL ) );
+	CHECK( strncmp( cResp, "HTTP/1.0 406 Not Acceptable\r\n", 29 ) == 0 );
+	CHECK( strcmp( prvHeader( "Content-Encoding:" ), "" ) == 0 );
+	CHECK( strcmp( prvHeader( "ETag:" ), "" ) == 0 );
+
+	/* the client's copy is current, also when the tag comes in a second segment */
+	sprintf( cReq, "GET /index.html HTTP/1.0\r\nAccept-Encoding: gzip\r\nIf-None-Match: \"%08lx\"\r\n\r\n", xFile.etag );
+	CHECK( prvGet( 0, cReq, NULL ) );
+	CHECK( strncmp( cResp, "HTTP/1.0 304 Not Modified\r\n", 27 ) == 0 );
+	CHECK( strcmp( prvHeader( "ETag:" ), cTag ) == 0 );
+	pcBody = prvBody( &uLen );
+	CHECK_EQ( uLen, 0 );
+	CHECK( prvGet( 0, "GET /index.html HTTP/1.0\r\nAccept-Encoding: gzip\r\nIf-None", strstr( cReq, "-Match" ) ) );
+	CHECK( strncmp( cResp, "HTTP/1.0 304 Not Modified\r\n", 27 ) == 0 );
+
+	/* a stale tag gets the page */
+	sprintf( cReq, "GET /index.html HTTP/1.0\r\nIf-None-Match: \"%08lx\"\r\n\r\n", xFile.etag ^ 1 );
+	CHECK( prvGet( 0, cReq, NULL ) );
+	CHECK( strncmp( cResp, "HTTP/1.0 200 OK\r\n", 17 ) == 0 );
+	pcBody = prvBody( &uLen );
+	CHECK_EQ( uLen, ( unsigned ) xFile.len );
+	CHECK_EQ( xPeer.ulBadFrames, 0 );
+}
+
+/* Scripts and the 404 page are sent plain and without a tag. */
+static void test_plain( void )
+{
+	struct httpd_fs_file xFile;
+	const char *pcBody;
+	unsigned uLen;
+
+	vPeerStart();
+	CHECK( prvGet( 0, "GET /nothing.html HTTP/1.0\r\nAccept-Encoding: gzip\r\n\r\n", NULL ) );
+	CHECK( strncmp( cResp, "HTTP/1.0 404 Not found\r\n", 24 ) == 0 );
+	CHECK( strcmp( prvHeader( "Content-Encoding:" ), "" ) == 0 );
+	CHECK( httpd_fs_open( "/404.html", &xFile ) );
+	pcBody = prvBody( &uLen );
+	CHECK( uLen == ( unsigned ) xFile.len && memcmp( pcBody, xFile.data, uLen ) == 0 );
+
+	CHECK( prvGet( 0, "GET /tcp.shtml HTTP/1.0\r\nAccept-Encoding: gzip\r\nIf-None-Match: \"00000000\"\r\n\r\n", NULL ) );
+	CHECK( strncmp( cResp, "HTTP/1.0 200 OK\r\n", 17 ) == 0 );
+	CHECK( strcmp( prvHeader( "Content-Encoding:" ), "" ) == 0 );
+	CHECK( strcmp( prvHeader( "ETag:" ), "" ) == 0 );
+	CHECK( strstr( cResp, "%!" ) == NULL );
+	CHECK_EQ( xPeer.ulBadFrames, 0 );
+}
+
+/* Bytes and segments for the gzipped page against the file it was made
+ * from, whose size is in the gzip trailer. */
+static void test_bench( void )
+{
+	static const uint16_t usMss[] = { 0, 536, 256 };
+	struct httpd_fs_file xFile;
+	const unsigned char *pucTail;
+	unsigned long ulRaw;
+	unsigned uLen, uHead, uMss, i;
+
+	vPeerStart();
+	CHECK( httpd_fs_open( "/index.html", &xFile ) );
+	pucTail = ( const unsigned char * ) xFile.data + xFile.len - 4;
+	ulRaw = pucTail[ 0 ] | ( pucTail[ 1 ] << 8 ) | ( ( unsigned long ) pucTail[ 2 ] << 16 ) | ( ( unsigned long ) pucTail[ 3 ] << 24 );
+	CHECK( ulRaw > ( unsigned long ) xFile.len );
+	for( i = 0; i < sizeof( usMss ) / sizeof( usMss[ 0 ] ); i++ )
+	{
+		uMss = usMss[ i ] ? usMss[ i ] : PEER_MSS;
+		CHECK( prvGet( usMss[ i ], "GET /index.html HTTP/1.0\r\nAccept-Encoding: gzip\r\n\r\n", NULL ) );
+		prvBody( &uLen );
+		uHead = uResp - uLen;
+		/* the headers and the body share segments */
+		CHECK_EQ( ulSent, ( uResp + uMss - 1 ) / uMss );
+		printf( "/index.html at MSS %u: %u bytes gzipped from %lu, %lu segment(s); stored plain %lu\n",
+				uMss, uLen, ulRaw, ulSent, ( uHead + ulRaw + uMss - 1 ) / uMss );
+	}
+}
+
+int main( void )
+{
+	test_index();
+	test_gzip();
+	test_plain();
+	test_bench();
+	return TEST_RESULT();
+}
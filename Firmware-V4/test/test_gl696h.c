@@ -0,0 +1,35 @@
+/*
+ * Boot vGL696H_Task as main() does and let it run: the lanes come up, every
+ * periodic job keeps its rate and the stat job publishes the counters.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "stm32f10x.h"
+#include "gl_696h.h"
+#include "mb_reg_map.h"
+#include "modbus.h"
+
+#include "host.h"
+#include "test.h"
+
+int main( void )
+{
+	USHORT usStat[ SCHED_STAT_JOBS * SCHED_STAT_REGS ];
+
+	vHostReset();
+	vHostPeriphReset();
+	xTaskCreate( vGL696H_Task, ( signed char * ) "GL696H", 256, NULL, tskIDLE_PRIORITY + 5, NULL );
+	vHostRun( 10 * configTICK_RATE_HZ );
+
+	eMBRegInput_ReadBlock( MB_SCHED_STAT, usStat, SCHED_STAT_JOBS * SCHED_STAT_REGS );
+	/* the 10 ms gun loops never miss their deadline */
+	CHECK_EQ( usStat[ 0 * SCHED_STAT_REGS + SCHED_STAT_OVERRUN ], 0 );
+	CHECK_EQ( usStat[ 1 * SCHED_STAT_REGS + SCHED_STAT_OVERRUN ], 0 );
+	CHECK_EQ( usStat[ 2 * SCHED_STAT_REGS + SCHED_STAT_OVERRUN ], 0 );
+	/* ctl and io wake every 10 ms, slow every 2 s */
+	CHECK( xHostStats.ulSwitches >= 2 * 10 * configTICK_RATE_HZ / 10 );
+
+	return TEST_RESULT();
+}
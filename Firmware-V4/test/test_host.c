@@ -0,0 +1,184 @@
+/*
+ * The host kernel stand-ins: delays, timeouts, priorities and the test
+ * waiting on a task.
+ */
+
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+
+#include "host.h"
+#include "test.h"
+
+static xQueueHandle xQueue;
+static xSemaphoreHandle xSem;
+static char cLog[ 16 ];
+static int iLog;
+static int iTicks;
+static portTickType xWoke;
+
+static void prvTicker( void *pvParameters )
+{
+	portTickType xLast = xTaskGetTickCount();
+
+	( void ) pvParameters;
+	for( ;; )
+	{
+		vTaskDelayUntil( &xLast, 10 );
+		iTicks++;
+	}
+}
+
+static void test_delay( void )
+{
+	vHostReset();
+	iTicks = 0;
+	xTaskCreate( prvTicker, ( signed char * ) "tick", 128, NULL, 1, NULL );
+	vHostRun( 105 );
+	CHECK_EQ( iTicks, 10 );
+	CHECK_EQ( xTaskGetTickCount(), 105 );
+}
+
+static void prvWaiter( void *pvParameters )
+{
+	int i;
+
+	( void ) pvParameters;
+	if( xQueueReceive( xQueue, &i, 50 ) != pdPASS )
+	{
+		xWoke = xTaskGetTickCount();
+	}
+	for( ;; )
+	{
+		vTaskDelay( 1000 );
+	}
+}
+
+static void test_timeout( void )
+{
+	vHostReset();
+	xQueue = xQueueCreate( 1, sizeof( int ) );
+	xWoke = 0;
+	xTaskCreate( prvWaiter, ( signed char * ) "wait", 128, NULL, 1, NULL );
+	vHostRun( 200 );
+	CHECK_EQ( xWoke, 50 );
+	CHECK_EQ( xHostStats.ulTimeouts, 1 );
+	vQueueDelete( xQueue );
+}
+
+static void prvHigh( void *pvParameters )
+{
+	int i;
+
+	( void ) pvParameters;
+	for( ;; )
+	{
+		xQueueReceive( xQueue, &i, portMAX_DELAY );
+		cLog[ iLog++ ] = 'H';
+	}
+}
+
+static void prvLow( void *pvParameters )
+{
+	int i = 0;
+
+	( void ) pvParameters;
+	cLog[ iLog++ ] = 'l';
+	xQueueSend( xQueue, &i, 0 );
+	cLog[ iLog++ ] = 'l';
+	for( ;; )
+	{
+		vTaskDelay( 1000 );
+	}
+}
+
+/* A send that wakes a higher priority task hands it the CPU at once. */
+static void test_preempt( void )
+{
+	vHostReset();
+	xQueue = xQueueCreate( 1, sizeof( int ) );
+	iLog = 0;
+	xTaskCreate( prvHigh, ( signed char * ) "high", 128, NULL, 3, NULL );
+	xTaskCreate( prvLow, ( signed char * ) "low", 128, NULL, 1, NULL );
+	vHostRun( 1 );
+	cLog[ iLog ] = 0;
+	CHECK( strcmp( cLog, "lHl" ) == 0 );
+	vQueueDelete( xQueue );
+}
+
+static void prvSender( void *pvParameters )
+{
+	int i = 42;
+
+	( void ) pvParameters;
+	vTaskDelay( 30 );
+	xQueueSend( xQueue, &i, 0 );
+	for( ;; )
+	{
+		vTaskDelay( 1000 );
+	}
+}
+
+/* The test blocks on a queue, the tasks run until one fills it. */
+static void test_main_waits( void )
+{
+	int i = 0;
+
+	vHostReset();
+	xQueue = xQueueCreate( 1, sizeof( int ) );
+	xTaskCreate( prvSender, ( signed char * ) "send", 128, NULL, 1, NULL );
+	CHECK( xQueueReceive( xQueue, &i, portMAX_DELAY ) == pdPASS );
+	CHECK_EQ( i, 42 );
+	CHECK_EQ( xTaskGetTickCount(), 30 );
+	CHECK( xQueueReceive( xQueue, &i, 5 ) != pdPASS );
+	CHECK_EQ( xTaskGetTickCount(), 35 );
+	vQueueDelete( xQueue );
+}
+
+static void prvIsr( void )
+{
+	signed portBASE_TYPE xWoken = pdFALSE;
+
+	if( xTaskGetTickCount() % 7 == 0 )
+	{
+		xSemaphoreGiveFromISR( xSem, &xWoken );
+	}
+}
+
+static void prvIsrTask( void *pvParameters )
+{
+	( void ) pvParameters;
+	for( ;; )
+	{
+		xSemaphoreTake( xSem, portMAX_DELAY );
+		iTicks++;
+		xWoke = xTaskGetTickCount();
+	}
+}
+
+/* A tick hook plays the interrupt. */
+static void test_hook( void )
+{
+	vHostReset();
+	vSemaphoreCreateBinary( xSem );
+	xSemaphoreTake( xSem, 0 );
+	iTicks = 0;
+	vHostAddTickHook( prvIsr );
+	xTaskCreate( prvIsrTask, ( signed char * ) "isr", 128, NULL, 2, NULL );
+	vHostRun( 71 );
+	CHECK_EQ( iTicks, 10 );
+	CHECK_EQ( xWoke, 70 );
+}
+
+int main( void )
+{
+	test_delay();
+	test_timeout();
+	test_preempt();
+	test_main_waits();
+	test_hook();
+	return TEST_RESULT();
+}
@@ -0,0 +1,281 @@
+/*
+ * The gun loops against a model of the HV supply.  hv_vol_task() and
+ * hv_cur_task() run every 10 ms as the hvl job does; the model reads the
+ * DAC compare registers of TIM3 and answers through the ADC scan table and
+ * its DMA interrupt.  The PI regulator is measured against the step ladder
+ * it replaces, on a fast and a slow supply with the gain off either way.
+ * Then the auto stop powers the gun down while its loops keep running.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "stm32f10x.h"
+#include "adc.h"
+#include "gl_696h.h"
+#include "mb_reg_map.h"
+#include "modbus.h"
+
+#include "host.h"
+#include "test.h"
+
+int32_t gl_696h_init( void );
+int32_t hv_vol_task( HVS *hvs );
+int32_t hv_cur_task( HVS *hvs );
+int32_t auto_ctl_task( void );
+void DMA1_Channel1_IRQHandler( void );
+
+#define STEP_MS			10
+#define VOL_SET			10000		/* V */
+#define CUR_SET			1500		/* uA */
+
+typedef struct
+{
+	const char *pcName;
+	double dGain;		/* output per volt asked for on the voltage DAC */
+	double dTauV;		/* s, output filter and cable */
+	double dTauI;		/* s, cathode heating */
+	double dV;			/* V */
+	double dI;			/* uA */
+} xSupply;
+
+/* A block write from the host, through the Modbus callback. */
+static void prvHostWrite( USHORT usReg, const USHORT *pusRegs, USHORT usNRegs )
+{
+	UCHAR ucFrame[ 2 * ( MB_CUR_PI_INTERVAL + 1 ) ];
+	USHORT i;
+
+	for( i = 0; i < usNRegs; i++ )
+	{
+		ucFrame[ 2 * i ] = ( UCHAR ) ( pusRegs[ i ] >> 8 );
+		ucFrame[ 2 * i + 1 ] = ( UCHAR ) pusRegs[ i ];
+	}
+	eMBRegHoldingCB( ucFrame, REG_HOLDING_START + usReg, usNRegs, MB_REG_WRITE );
+}
+
+/* The parameters the host software writes at start up, as in hv_init(). */
+static void prvLoadParams( uint16_t usKp, uint16_t usKi, uint16_t usCurKp, uint16_t usCurKi )
+{
+	USHORT usRegs[ MB_VOL_KFF - MB_VOL_MAX + 1 ];
+
+	#define P( reg )	usRegs[ ( reg ) - MB_VOL_MAX ]
+	eMBRegHolding_ReadBlock( MB_VOL_MAX, usRegs, MB_VOL_KFF - MB_VOL_MAX + 1 );
+	P( MB_VOL_MAX ) = 15000;
+	P( MB_VOL_SCALE ) = 5;
+	P( MB_VOL_ERR_RATE ) = 5;
+	P( MB_VOL_STEP ) = 10;
+	P( MB_VOL_STEP_INTERVAL ) = 200;
+	P( MB_VOL_STEP_TIMEOUT ) = 10000;
+	P( MB_VOL_LEVEL1 ) = 1000;
+	P( MB_CURRRENT_MAX ) = 3000;
+	P( MB_CUR_SCALE ) = 1;
+	P( MB_CUR_ERR_RATE ) = 40;
+	P( MB_CUR_STEP ) = 1;
+	P( MB_CUR_STEP_INTERVAL ) = 10000;
+	P( MB_CUR_STEP_TIMEOUT ) = 30000;
+	P( MB_CUR_CTL_START ) = 1300;
+	P( MB_VOL_KP ) = usKp;
+	P( MB_VOL_KI ) = usKi;
+	P( MB_CUR_KP ) = usCurKp;
+	P( MB_CUR_KI ) = usCurKi;
+	P( MB_VOL_SET_L ) = 0;
+	P( MB_CUR_SET_L ) = 0;
+	#undef P
+	prvHostWrite( MB_VOL_MAX, usRegs, MB_VOL_KFF - MB_VOL_MAX + 1 );
+}
+
+static double prvDacmV( uint16_t usCCR )
+{
+	return usCCR * 3300.0 / 1023.0;
+}
+
+static uint16_t prvAdc( double dmV )
+{
+	long lAdc = ( long ) ( dmV * 4095.0 / 5000.0 + 0.5 ) + ( long ) ( ulTestRand() % 5 ) - 2;
+
+	return ( uint16_t ) ( lAdc < 0 ? 0 : lAdc > 4095 ? 4095 : lAdc );
+}
+
+/* 10 ms of the supply, then one scan block and one pass of the gun loops. */
+static void prvStep( xSupply *pxSupply )
+{
+	static uint32_t ulHalf;
+	double dDt = STEP_MS / 1000.0;
+	double dVt, dIt;
+	uint32_t ulRow;
+
+	/* emission needs the field, the beam loads the supply */
+	dIt = pxSupply->dV > 1000 ? prvDacmV( TIM3->CCR3 ) * 0.6 : 0;
+	dVt = pxSupply->dGain * prvDacmV( TIM3->CCR1 ) * hvsl.vol_scale - pxSupply->dI * 0.2;
+	if( dVt < 0 )
+	{
+		dVt = 0;
+	}
+	pxSupply->dV += ( dVt - pxSupply->dV ) * dDt / pxSupply->dTauV;
+	pxSupply->dI += ( dIt - pxSupply->dI ) * dDt / pxSupply->dTauI;
+
+	for( ulRow = 0; ulRow < ADC_BLOCK_SAMPLES; ulRow++ )
+	{
+		ADC_ConvertedValueTab[ ulHalf * ADC_BLOCK_SAMPLES + ulRow ][ ADC_CH_INDEX( ADC_Channel_8 ) ] =
+			prvAdc( pxSupply->dV / 5 );
+		ADC_ConvertedValueTab[ ulHalf * ADC_BLOCK_SAMPLES + ulRow ][ ADC_CH_INDEX( ADC_Channel_12 ) ] =
+			prvAdc( pxSupply->dI );
+	}
+	DMA1->ISR |= ulHalf ? DMA1_IT_TC1 | DMA1_IT_GL1 : DMA1_IT_HT1 | DMA1_IT_GL1;
+	DMA1_Channel1_IRQHandler();
+	DMA1->ISR &= ~DMA1->IFCR;
+	DMA1->IFCR = 0;
+	ulHalf ^= 1;
+
+	system_tick += STEP_MS;
+	hv_vol_task( &hvsl );
+	hv_cur_task( &hvsl );
+}
+
+typedef struct
+{
+	uint32_t ulSettle;		/* ms to stay within the band */
+	long lOvershoot;		/* past the set point, in its unit */
+} xStepResult;
+
+/* Step the set point at 0 and run for ulMs, the band is in 1/1000. */
+static xStepResult xRunStep( xSupply *pxSupply, USHORT usReg, USHORT usSet,
+							 const double *pdOut, uint32_t ulBand, uint32_t ulMs )
+{
+	xStepResult xResult = { 0, 0 };
+	uint32_t ulT;
+	double dErr;
+
+	prvHostWrite( usReg, &usSet, 1 );
+	for( ulT = STEP_MS; ulT <= ulMs; ulT += STEP_MS )
+	{
+		prvStep( pxSupply );
+		dErr = *pdOut - usSet;
+		if( dErr > xResult.lOvershoot )
+		{
+			xResult.lOvershoot = ( long ) dErr;
+		}
+		if( dErr * 1000 > ( double ) usSet * ulBand || -dErr * 1000 > ( double ) usSet * ulBand )
+		{
+			xResult.ulSettle = ulT;
+		}
+	}
+	return xResult;
+}
+
+static void prvStart( xSupply *pxSupply, int iPI )
+{
+	vHostReset();
+	vHostPeriphReset();
+	memset( ( void * ) ADC_ConvertedValueTab, 0, sizeof( ADC_ConvertedValueTab ) );
+	system_tick = 0;
+	gl_696h_init();
+	if( iPI )
+	{
+		/* the defaults hv_init() seeded */
+		prvLoadParams( eMBRegHolding_Read( MB_VOL_KP ), eMBRegHolding_Read( MB_VOL_KI ),
+					   eMBRegHolding_Read( MB_CUR_KP ), eMBRegHolding_Read( MB_CUR_KI ) );
+	}
+	else
+	{
+		prvLoadParams( 0, 0, 0, 0 );
+	}
+	pxSupply->dV = pxSupply->dI = 0;
+}
+
+/* The auto stop with the gun at its set point.  The host puts the set
+   points back after the sequence zeroed them, so the gun is still driving
+   when the sequence gives up waiting for the voltage to fall.  The sequence
+   runs on slow_lane and the hvl job preempts it; here the job runs between
+   the sequence steps, and a pass of the current loop comes between the
+   power off being posted and the job applying it. */
+static void test_auto_off( void )
+{
+	static xSupply xSupply = { "auto off", 1.0, 0.1, 1.0 };
+	static const USHORT usSet[ 2 ] = { VOL_SET, CUR_SET };
+	uint16_t usSt;
+	uint32_t ulCCR = 0, ulRun, ulT;
+
+	prvStart( &xSupply, 1 );
+	xRunStep( &xSupply, MB_VOL_SET_L, VOL_SET, &xSupply.dV, 10, 30000 );
+	xRunStep( &xSupply, MB_CUR_SET_L, CUR_SET, &xSupply.dI, 50, 60000 );
+	CHECK( TIM3->CCR3 != 0 );
+
+	eMBRegHolding_Write( MB_SYS_AUTOCTL, SYS_AUTO_OFF );
+	for( ulRun = 0; ulRun < 10 && ( hvsl.st & HV_ENABLE ); ulRun++ )
+	{
+		usSt = hvsl.st;
+		ulCCR = TIM3->CCR3;
+		auto_ctl_task();
+		/* the sequence only posts, the gun is as it was */
+		CHECK_EQ( hvsl.st, usSt );
+		CHECK_EQ( TIM3->CCR3, ulCCR );
+
+		hv_cur_task( &hvsl );
+		GPIOA->BSRR = 0;
+		for( ulT = 0; ulT < ( ulRun == 0 ? 60000 : 1000 ); ulT += STEP_MS )
+		{
+			prvStep( &xSupply );
+			if( ulRun == 0 && ulT == 0 )
+			{
+				CHECK_EQ( eMBRegHolding_Read( MB_VOL_SET_L ), 0 );
+				prvHostWrite( MB_VOL_SET_L, usSet, 2 );
+			}
+		}
+	}
+	CHECK( ulCCR != 0 );
+	CHECK_EQ( hvsl.st & HV_ENABLE, 0 );
+	CHECK_EQ( eMBRegInput_Read( MB_HV_ST_L ) & HV_ENABLE, 0 );
+	CHECK_EQ( TIM3->CCR3, 0 );
+	CHECK( GPIOA->BSRR & GPIO_Pin_4 );		/* PWR_0 off */
+
+	/* and the loops leave it there */
+	for( ulT = 0; ulT < 10000; ulT += STEP_MS )
+	{
+		prvStep( &xSupply );
+	}
+	CHECK_EQ( TIM3->CCR3, 0 );
+	CHECK_EQ( hvsl.st & HV_ENABLE, 0 );
+}
+
+int main( void )
+{
+	static xSupply xSupplies[] = {
+		{ "fast, low",	0.9, 0.1, 1.0 },
+		{ "fast, high",	1.1, 0.1, 1.0 },
+		{ "slow, low",	0.9, 0.5, 3.0 },
+		{ "slow, high",	1.1, 0.5, 3.0 },
+	};
+	xStepResult xVol[ 2 ], xCur[ 2 ];
+	uint32_t i;
+	int iPI;
+
+	vTestSeed( 696 );
+	printf( "%-11s %-6s %9s %9s %9s %9s\n", "supply", "", "V settle", "V over", "I settle", "I over" );
+	for( i = 0; i < sizeof( xSupplies ) / sizeof( xSupplies[ 0 ] ); i++ )
+	{
+		for( iPI = 0; iPI < 2; iPI++ )
+		{
+			prvStart( &xSupplies[ i ], iPI );
+			/* 10 kV to within 1 %, then the beam to within 5 % */
+			xVol[ iPI ] = xRunStep( &xSupplies[ i ], MB_VOL_SET_L, VOL_SET, &xSupplies[ i ].dV, 10, 30000 );
+			xCur[ iPI ] = xRunStep( &xSupplies[ i ], MB_CUR_SET_L, CUR_SET, &xSupplies[ i ].dI, 50, 600000 );
+			printf( "%-11s %-6s %7lums %7ldV %7lums %6lduA\n", xSupplies[ i ].pcName,
+					iPI ? "PI" : "ladder", ( unsigned long ) xVol[ iPI ].ulSettle, xVol[ iPI ].lOvershoot,
+					( unsigned long ) xCur[ iPI ].ulSettle, xCur[ iPI ].lOvershoot );
+		}
+
+		/* the PI settles where the ladder does, and no later */
+		CHECK( xVol[ 1 ].ulSettle < 30000 );
+		CHECK( xCur[ 1 ].ulSettle < 600000 );
+		CHECK( xVol[ 1 ].ulSettle <= xVol[ 0 ].ulSettle );
+		CHECK( xCur[ 1 ].ulSettle <= xCur[ 0 ].ulSettle );
+		/* without the ladder's overshoot */
+		CHECK( xVol[ 1 ].lOvershoot <= VOL_SET / 100 );
+		CHECK( xVol[ 1 ].lOvershoot <= xVol[ 0 ].lOvershoot || xVol[ 1 ].lOvershoot == 0 );
+		CHECK( xCur[ 1 ].lOvershoot <= CUR_SET / 20 );
+	}
+	test_auto_off();
+
+	return TEST_RESULT();
+}
@@ -0,0 +1,409 @@
+/*
+ * The CJK glyph index makefont builds into fontdata.h and LCD_GetHz()'s
+ * binary search in it.  Every character in a string literal under app/
+ * and windows/ that hzk3232.h has is in the 32x32 font and draws as its
+ * bitmap there, characters with one bitmap share one glyph, and every
+ * other GB2312 code finds the blank glyph.  The bench times the lookups of
+ * the main window's text against the linear memcmp() scan of hzk3232.h
+ * LCD_GetHz() did before.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <dirent.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "stm32f10x.h"
+#include "fonts.h"
+#include "lcd.h"
+
+#include "host.h"
+#include "test.h"
+#include "lcd_model.h"
+
+/* makefont's input, the table LCD_GetHz() used to scan: hzk3232.h in
+   gb32.c. */
+struct typFNT_GB32
+{
+	signed char Index[ 2 ];
+	char Msk[ 128 ];
+};
+
+extern const struct typFNT_GB32 *const pxGB_32;
+extern const unsigned uGB_32Entries;
+
+#define GB_32				pxGB_32
+#define GB_32_ENTRIES		uGB_32Entries
+#define CODE( p )			( ( uint16_t ) ( ( ( uint8_t ) ( p )[ 0 ] << 8 ) | ( uint8_t ) ( p )[ 1 ] ) )
+#define REPEAT				20000
+
+/* lcd.c and win_main.c */
+uint16_t LCD_GetHz( const char *ch, sFONT *font );
+void prvConfigureLCD( void );
+void main_win_draw( void );
+
+static uint8_t ucUsed[ 0x10000 / 8 ];
+static unsigned uUsed;
+
+static void prvUse( uint16_t usCode )
+{
+	if( !( ucUsed[ usCode >> 3 ] & ( 1 << ( usCode & 7 ) ) ) )
+	{
+		ucUsed[ usCode >> 3 ] |= ( uint8_t ) ( 1 << ( usCode & 7 ) );
+		uUsed++;
+	}
+}
+
+static int prvUsed( uint16_t usCode )
+{
+	return ( ucUsed[ usCode >> 3 ] >> ( usCode & 7 ) ) & 1;
+}
+
+/* The GB2312 codes in the string literals of a file, comments and
+   character constants skipped, as makefont reads them.  pxEach, when
+   given, gets every code in order. */
+static void prvScan( const char *pcPath, void ( *pxEach )( uint16_t usCode ) )
+{
+	static char cData[ 256 * 1024 ];
+	FILE *pxFile = fopen( pcPath, "rb" );
+	size_t n, i;
+	uint8_t c;
+
+	CHECK( pxFile != NULL );
+	if( pxFile == NULL )
+	{
+		return;
+	}
+	n = fread( cData, 1, sizeof( cData ) - 1, pxFile );
+	fclose( pxFile );
+	cData[ n ] = 0;
+	for( i = 0; i < n; i++ )
+	{
+		if( cData[ i ] == '/' && cData[ i + 1 ] == '*' )
+		{
+			for( i += 2; i < n && !( cData[ i ] == '*' && cData[ i + 1 ] == '/' ); i++ )
+			{
+			}
+			i++;
+		}
+		else if( cData[ i ] == '/' && cData[ i + 1 ] == '/' )
+		{
+			for( ; i < n && cData[ i ] != '\n'; i++ )
+			{
+			}
+		}
+		else if( cData[ i ] == '\'' || cData[ i ] == '"' )
+		{
+			const char cEnd = cData[ i ];
+
+			for( i++; i < n && cData[ i ] != cEnd && cData[ i ] != '\n'; i++ )
+			{
+				c = ( uint8_t ) cData[ i ];
+				if( c == '\\' )
+				{
+					i++;
+				}
+				else if( cEnd == '"' && c >= 0xA1 && c <= 0xFE && ( uint8_t ) cData[ i + 1 ] >= 0xA1 &&
+						 ( uint8_t ) cData[ i + 1 ] <= 0xFE )
+				{
+					if( pxEach != NULL )
+					{
+						pxEach( CODE( &cData[ i ] ) );
+					}
+					prvUse( CODE( &cData[ i ] ) );
+					i++;
+				}
+			}
+		}
+	}
+}
+
+static void prvScanDir( const char *pcDir )
+{
+	char cPath[ 512 ];
+	struct dirent *pxEnt;
+	DIR *pxDir;
+	size_t n;
+
+	snprintf( cPath, sizeof( cPath ), "%s/%s", GL696_SOURCE_DIR, pcDir );
+	pxDir = opendir( cPath );
+	CHECK( pxDir != NULL );
+	while( pxDir != NULL && ( pxEnt = readdir( pxDir ) ) != NULL )
+	{
+		n = strlen( pxEnt->d_name );
+		if( n < 3 || ( strcmp( pxEnt->d_name + n - 2, ".c" ) != 0 && strcmp( pxEnt->d_name + n - 2, ".h" ) != 0 ) ||
+			strstr( pxEnt->d_name, "hzk" ) != NULL || strstr( pxEnt->d_name, "fontdata" ) != NULL )
+		{
+			continue;
+		}
+		snprintf( cPath, sizeof( cPath ), "%s/%s/%s", GL696_SOURCE_DIR, pcDir, pxEnt->d_name );
+		prvScan( cPath, NULL );
+	}
+	if( pxDir != NULL )
+	{
+		closedir( pxDir );
+	}
+}
+
+/* The first hzk3232.h entry of a code, as makefont takes it. */
+static const struct typFNT_GB32 *prvBitmap( uint16_t usCode )
+{
+	unsigned i;
+
+	for( i = 0; i < GB_32_ENTRIES; i++ )
+	{
+		if( CODE( GB_32[ i ].Index ) == usCode )
+		{
+			return &GB_32[ i ];
+		}
+	}
+	return NULL;
+}
+
+/* LCD_GetHz() before the index, without running off the table; the
+   entries it compared in *puProbes. */
+static const char *prvLinearHz( const char *ch, unsigned *puProbes )
+{
+	unsigned i;
+
+	for( i = 0; i < GB_32_ENTRIES; i++ )
+	{
+		if( memcmp( ch, GB_32[ i ].Index, 2 ) == 0 )
+		{
+			break;
+		}
+	}
+	*puProbes = i + 1;
+	return i < GB_32_ENTRIES ? GB_32[ i ].Msk : NULL;
+}
+
+/* The probes of the binary search for a code. */
+static unsigned prvIndexProbes( uint16_t usCode )
+{
+	unsigned uLow = 0, uHigh = CH_Font32x32.count, uMid, uProbes = 0;
+
+	while( uLow < uHigh )
+	{
+		uMid = ( uLow + uHigh ) / 2;
+		uProbes++;
+		if( CH_Font32x32.index[ uMid ].Code == usCode )
+		{
+			break;
+		}
+		if( CH_Font32x32.index[ uMid ].Code < usCode )
+		{
+			uLow = uMid + 1;
+		}
+		else
+		{
+			uHigh = uMid;
+		}
+	}
+	return uProbes;
+}
+
+static double prvNow( void )
+{
+	struct timespec xNow;
+
+	clock_gettime( CLOCK_MONOTONIC, &xNow );
+	return xNow.tv_sec * 1e9 + xNow.tv_nsec;
+}
+
+/* The index holds the characters used that hzk3232.h has, sorted. */
+static void test_index( void )
+{
+	const sHZINDEX *pxIndex = CH_Font32x32.index;
+	sFONT *pxEmpty[] = { &CH_Font16x16, &CH_Font20x20, &CH_Font24x24 };
+	unsigned i, j, uNotUsed = 0, uMissing = 0;
+	char cCh[ 2 ];
+
+	prvScanDir( "app" );
+	prvScanDir( "windows" );
+	CHECK( uUsed > 50 );
+
+	for( i = 0; i < CH_Font32x32.count; i++ )
+	{
+		CHECK( i == 0 || pxIndex[ i - 1 ].Code < pxIndex[ i ].Code );
+		uNotUsed += !prvUsed( pxIndex[ i ].Code );
+		CHECK( pxIndex[ i ].Glyph > 0 );
+	}
+	CHECK_EQ( uNotUsed, 0 );
+
+	/* every GB2312 code: its glyph or the blank one */
+	for( i = 0xA1; i <= 0xFE; i++ )
+	{
+		for( j = 0xA1; j <= 0xFE; j++ )
+		{
+			uint16_t usGlyph = 0;
+			unsigned k;
+
+			cCh[ 0 ] = ( char ) i;
+			cCh[ 1 ] = ( char ) j;
+			for( k = 0; k < CH_Font32x32.count; k++ )
+			{
+				if( pxIndex[ k ].Code == CODE( cCh ) )
+				{
+					usGlyph = pxIndex[ k ].Glyph;
+				}
+			}
+			CHECK_EQ( LCD_GetHz( cCh, &CH_Font32x32 ), usGlyph );
+			if( prvUsed( CODE( cCh ) ) )
+			{
+				CHECK_EQ( usGlyph > 0, prvBitmap( CODE( cCh ) ) != NULL );
+				uMissing += usGlyph == 0;
+			}
+			for( k = 0; k < sizeof( pxEmpty ) / sizeof( pxEmpty[ 0 ] ); k++ )
+			{
+				CHECK_EQ( LCD_GetHz( cCh, pxEmpty[ k ] ), 0 );
+			}
+		}
+	}
+	CHECK_EQ( CH_Font32x32.count + uMissing, uUsed );
+	printf( "%u characters in the sources, %u of them not in hzk3232.h draw blank\n", uUsed, uMissing );
+}
+
+/* Each character draws as its hzk3232.h bitmap; two share a glyph when,
+   and only when, their bitmaps are the same. */
+static void test_glyphs( void )
+{
+	const sHZINDEX *pxIndex = CH_Font32x32.index;
+	const struct typFNT_GB32 *pxA, *pxB;
+	unsigned i, j, x, y, uBad = 0, uShared = 0;
+	char cStr[ 3 ] = { 0 };
+	int iSet;
+
+	vHostReset();
+	vLcdModelReset( 0xAAAA );
+	prvConfigureLCD();
+	LCD_SetBackColor( Black );
+	LCD_SetTextColor( White );
+	LCD_SetFont_CH( &CH_Font32x32 );
+	for( i = 0; i < CH_Font32x32.count; i++ )
+	{
+		pxA = prvBitmap( pxIndex[ i ].Code );
+		CHECK( pxA != NULL );
+		if( pxA == NULL )
+		{
+			continue;
+		}
+		cStr[ 0 ] = ( char ) ( pxIndex[ i ].Code >> 8 );
+		cStr[ 1 ] = ( char ) pxIndex[ i ].Code;
+		LCD_SetCursor( 100, 100 );
+		LCD_DisplayString( cStr );
+		for( y = 0; y < 32; y++ )
+		{
+			for( x = 0; x < 32; x++ )
+			{
+				iSet = ( ( uint8_t ) pxA->Msk[ y * 4 + x / 8 ] >> ( 7 - x % 8 ) ) & 1;
+				uBad += xLcd.usPage[ 0 ][ 101 + y ][ 100 + x ] != ( iSet ? White : Black );
+			}
+		}
+		for( j = 0; j < i; j++ )
+		{
+			pxB = prvBitmap( pxIndex[ j ].Code );
+			if( pxB != NULL )
+			{
+				CHECK_EQ( pxIndex[ i ].Glyph == pxIndex[ j ].Glyph, memcmp( pxA->Msk, pxB->Msk, 128 ) == 0 );
+				uShared += pxIndex[ i ].Glyph == pxIndex[ j ].Glyph;
+			}
+		}
+	}
+	CHECK_EQ( uBad, 0 );
+
+	/* an unknown character draws blank and takes its cell */
+	LCD_SetCursor( 100, 100 );
+	LCD_DisplayString( "\xA1\xA1" );
+	CHECK_EQ( LCD_GetCursorX(), 132 );
+	for( y = 0; y < 32; y++ )
+	{
+		for( x = 0; x < 32; x++ )
+		{
+			uBad += xLcd.usPage[ 0 ][ 101 + y ][ 100 + x ] != Black;
+		}
+	}
+	CHECK_EQ( uBad, 0 );
+	printf( "GB_32: %u characters used, %u in hzk3232.h, %u sharing a glyph\n", CH_Font32x32.count,
+			GB_32_ENTRIES, uShared );
+}
+
+static char cMainText[ 512 ][ 2 ];
+static unsigned uMainText;
+
+static void prvMainText( uint16_t usCode )
+{
+	if( uMainText < 512 )
+	{
+		cMainText[ uMainText ][ 0 ] = ( char ) ( usCode >> 8 );
+		cMainText[ uMainText ][ 1 ] = ( char ) usCode;
+		uMainText++;
+	}
+}
+
+/* The main window's characters looked up both ways, and drawn. */
+static void test_bench( void )
+{
+	unsigned long ulLinear = 0, ulIndex = 0, ulSum = 0;
+	unsigned uMaxLinear = 0, uMaxIndex = 0, uProbes, i, r;
+	double fStart, fLinearNs, fIndexNs;
+	const char *pcMask;
+
+	prvScan( GL696_SOURCE_DIR "/windows/win_main.c", prvMainText );
+	CHECK( uMainText > 50 );
+	for( i = 0; i < uMainText; i++ )
+	{
+		pcMask = prvLinearHz( cMainText[ i ], &uProbes );
+		CHECK( pcMask != NULL );
+		ulLinear += uProbes;
+		uMaxLinear = uProbes > uMaxLinear ? uProbes : uMaxLinear;
+		uProbes = prvIndexProbes( CODE( cMainText[ i ] ) );
+		ulIndex += uProbes;
+		uMaxIndex = uProbes > uMaxIndex ? uProbes : uMaxIndex;
+	}
+	CHECK( uMaxIndex <= 8 );
+
+	fStart = prvNow();
+	for( r = 0; r < REPEAT; r++ )
+	{
+		for( i = 0; i < uMainText; i++ )
+		{
+			ulSum += ( unsigned long ) prvLinearHz( cMainText[ i ], &uProbes );
+		}
+	}
+	fLinearNs = ( prvNow() - fStart ) / REPEAT / uMainText;
+	fStart = prvNow();
+	for( r = 0; r < REPEAT; r++ )
+	{
+		for( i = 0; i < uMainText; i++ )
+		{
+			ulSum += LCD_GetHz( cMainText[ i ], &CH_Font32x32 );
+		}
+	}
+	fIndexNs = ( prvNow() - fStart ) / REPEAT / uMainText;
+	CHECK( ulSum != 0 );
+
+	vHostReset();
+	vLcdModelReset( 0xAAAA );
+	prvConfigureLCD();
+	vLcdModelCount();
+	main_win_draw();
+	CHECK_EQ( xLcd.ulErrors + xLcd.ulOutside, 0 );
+
+	printf( "main window, %u CJK characters: linear scan %.1f probes (%u max) %.1f ns, index %.1f probes (%u max) "
+			"%.1f ns a lookup\n",
+			uMainText, ( double ) ulLinear / uMainText, uMaxLinear, fLinearNs, ( double ) ulIndex / uMainText,
+			uMaxIndex, fIndexNs );
+	printf( "main_win_draw(): %lu pixels, %lu us bus into both pages\n", xLcd.ulPixels, ulLcdModelNs() / 1000 );
+}
+
+int main( void )
+{
+	test_index();
+	test_glyphs();
+	test_bench();
+	return TEST_RESULT();
+}
@@ -0,0 +1,53 @@
+/*
+ * The auto start sequence sends pump commands that wait on the serial line.
+ * It must not hold up the telemetry or the gun loops.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "stm32f10x.h"
+#include "gl_696h.h"
+#include "mb_reg_map.h"
+#include "modbus.h"
+
+#include "host.h"
+#include "rig.h"
+#include "test.h"
+
+/* the job table order, see gl_696h.c */
+enum { JOB_HVL = 0, JOB_HVR, JOB_ADC, JOB_TELEM, JOB_SEQ, JOB_STAT, JOB_MPUMP, JOB_MOTOR };
+
+int main( void )
+{
+	uint32_t ulJob;
+
+	vRigStart();
+	vHostRun( 1000 );
+
+	/* the gauge powers up 10 s after the start, the pump follows */
+	vRigWriteHolding( MB_SYS_AUTOCTL, SYS_AUTO_ON );
+	vHostRun( 20 * configTICK_RATE_HZ );
+	CHECK( eMBRegInput_Read( MB_MPUMP_ST ) & MPUMP_RUN );
+	CHECK_EQ( xBench.ulPumpCmds[ 0x83 ], 1 );		/* high speed */
+	CHECK_EQ( xBench.ulPumpCmds[ 0x81 ], 1 );		/* start */
+	CHECK( !( eMBRegHolding_Read( MB_SYS_AUTOCTL ) & SYS_AUTO_ON ) );	/* done, not re-armed */
+
+	/* and the auto stop */
+	vRigWriteHolding( MB_SYS_AUTOCTL, SYS_AUTO_OFF );
+	vHostRun( 20 * configTICK_RATE_HZ );
+	CHECK( !( eMBRegInput_Read( MB_MPUMP_ST ) & MPUMP_RUN ) );
+	CHECK( xBench.ulPumpCmds[ 0x80 ] >= 1 );		/* stop */
+
+	vHostRun( 1000 );
+	for( ulJob = JOB_HVL; ulJob <= JOB_STAT; ulJob++ )
+	{
+		if( ulJob != JOB_SEQ )
+		{
+			CHECK_EQ( usRigOverruns( ulJob ), 0 );
+		}
+	}
+	CHECK( usRigJitter( JOB_TELEM ) <= 10 );
+
+	return TEST_RESULT();
+}
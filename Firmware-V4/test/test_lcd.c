@@ -0,0 +1,214 @@
+/*
+ * The LCD bus of app/lcd.c on the panel model: clear, fills, bursts and
+ * text land on the panel as drawn, every store is made in a critical
+ * section and no section holds more than one LCD_BURST_CHUNK of pixels.
+ * The bench prints the bus time of each workload.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "fonts.h"
+#include "lcd.h"
+
+#include "host.h"
+#include "test.h"
+#include "lcd_model.h"
+
+/* A chunk of 32 pixels of two different bytes: two data stores and two
+   strobes a pixel, plus the three register writes and CS of a text row. */
+#define SECTION_MAX			( 32 * 6 + 3 * 4 + 33 + 4 )
+
+#define POWER_ON			0xAAAA
+
+static void prvStart( void )
+{
+	vHostReset();
+	vLcdModelReset( POWER_ON );
+	LCD_Init();
+	LCD_SET_PAGE( LCD_WRITE_PAGE0 | LCD_DISPLAY_PAGE0 );
+	vLcdModelCount();
+}
+
+/* The counts every workload has to keep to. */
+static void prvCheckBus( void )
+{
+	CHECK_EQ( xLcd.ulErrors, 0 );
+	CHECK_EQ( xLcd.ulOutside, 0 );
+	CHECK_EQ( xLcd.ulOffPanel, 0 );
+	CHECK( xLcd.ulSectionMax <= SECTION_MAX );
+}
+
+static void prvReport( const char *pcName )
+{
+	printf( "%-24s %8lu pixels %8lu strobes %7lu sections, %6lu us bus, longest %4lu stores %5lu ns\n", pcName,
+			xLcd.ulPixels, xLcd.ulStrobes, xLcd.ulSections, ulLcdModelNs() / 1000, xLcd.ulSectionMax,
+			ulLcdModelSectionNs() );
+}
+
+/* Pixels in the rectangle on page uPage that are not usColor. */
+static unsigned long prvRectOff( unsigned uPage, unsigned x, unsigned y, unsigned w, unsigned h, uint16_t usColor )
+{
+	unsigned long ulOff = 0;
+	unsigned i, j;
+
+	for( j = y; j < y + h; j++ )
+	{
+		for( i = x; i < x + w; i++ )
+		{
+			ulOff += xLcd.usPage[ uPage ][ j ][ i ] != usColor;
+		}
+	}
+	return ulOff;
+}
+
+/* The whole page in one color, the other page as it was. */
+static void test_clear( void )
+{
+	static const uint16_t usColor[] = { Black, 0x1234 };
+	unsigned i;
+
+	prvStart();
+	for( i = 0; i < 2; i++ )
+	{
+		vLcdModelCount();
+		LCD_SetBackColor( usColor[ i ] );
+		LCD_Clear();
+		CHECK_EQ( prvRectOff( 0, 0, 0, LCD_SCR_WIDTH, LCD_SCR_HIGH, usColor[ i ] ), 0 );
+		CHECK_EQ( prvRectOff( 1, 0, 0, LCD_SCR_WIDTH, LCD_SCR_HIGH, POWER_ON ), 0 );
+		CHECK_EQ( xLcd.ulPixels, LCD_SCR_WIDTH * LCD_SCR_HIGH );
+		/* a row is the cursor and 20 chunks, then the cursor home */
+		CHECK_EQ( xLcd.ulSections, LCD_SCR_HIGH * ( 3 + LCD_SCR_WIDTH / 32 ) + 3 );
+		prvCheckBus();
+		prvReport( i == 0 ? "clear, black" : "clear, 0x1234" );
+	}
+
+	/* into the other page */
+	LCD_SET_PAGE( LCD_WRITE_PAGE1 | LCD_DISPLAY_PAGE0 );
+	LCD_SetBackColor( Blue );
+	LCD_Clear();
+	CHECK_EQ( prvRectOff( 1, 0, 0, LCD_SCR_WIDTH, LCD_SCR_HIGH, Blue ), 0 );
+	CHECK_EQ( prvRectOff( 0, 0, 0, LCD_SCR_WIDTH, LCD_SCR_HIGH, 0x1234 ), 0 );
+}
+
+/* FillRun and WriteRAMBurst over the rows above the ninth bit and the
+   columns above the eighth, lengths that do not end on a chunk. */
+static void test_fill( void )
+{
+	uint16_t usRun[ 300 ];
+	unsigned x, y, uBad;
+
+	prvStart();
+	LCD_SetBackColor( Black );
+	LCD_Clear();
+
+	vLcdModelCount();
+	for( y = 250; y < 350; y++ )
+	{
+		LCD_SetCursor( 200, y );
+		LCD_FillRun( Magenta, 201 );
+	}
+	CHECK_EQ( prvRectOff( 0, 200, 250, 201, 100, Magenta ), 0 );
+	CHECK_EQ( prvRectOff( 0, 199, 249, 203, 1, Black ), 0 );
+	CHECK_EQ( prvRectOff( 0, 199, 350, 203, 1, Black ), 0 );
+	CHECK_EQ( prvRectOff( 0, 199, 250, 1, 100, Black ), 0 );
+	CHECK_EQ( prvRectOff( 0, 401, 250, 1, 100, Black ), 0 );
+	prvCheckBus();
+	prvReport( "fill 201x100, FillRun" );
+
+	for( x = 0; x < 300; x++ )
+	{
+		usRun[ x ] = ( uint16_t ) ( x * 0x0123 + 0x4321 );
+	}
+	vLcdModelCount();
+	for( y = 100; y < 200; y++ )
+	{
+		LCD_SetCursor( 330, y );
+		LCD_WriteRAMBurst( usRun, 300 );
+	}
+	for( uBad = 0, y = 100; y < 200; y++ )
+	{
+		uBad += memcmp( &xLcd.usPage[ 0 ][ y ][ 330 ], usRun, sizeof( usRun ) ) != 0;
+	}
+	CHECK_EQ( uBad, 0 );
+	CHECK_EQ( xLcd.usPage[ 0 ][ 100 ][ 329 ], Black );
+	CHECK_EQ( xLcd.usPage[ 0 ][ 100 ][ 630 ], Black );
+	prvCheckBus();
+	prvReport( "burst 300x100" );
+
+	/* single pixels */
+	vLcdModelCount();
+	LCD_SetCursor( 639, 479 );
+	LCD_FillRun( Red, 1 );
+	LCD_SetCursor( 0, 0 );
+	LCD_FillRun( Green, 1 );
+	CHECK_EQ( xLcd.usPage[ 0 ][ 479 ][ 639 ], Red );
+	CHECK_EQ( xLcd.usPage[ 0 ][ 0 ][ 0 ], Green );
+	CHECK_EQ( xLcd.ulPixels, 2 );
+	prvCheckBus();
+}
+
+/* Text: a glyph is a box of its size in the two colors, one line below
+   the cursor, and draws the same wherever it is.  The background is not
+   the cleared screen's, so the box shows. */
+static void test_text( void )
+{
+	static const char cLine[] = "HV 1234.5 kV  I 12.34 mA  AUTO";
+	const unsigned w = 12, h = 24, n = sizeof( cLine ) - 1;
+	unsigned long ulText = 0;
+	unsigned i, x, y, uDiff = 0;
+	uint16_t usPixel;
+
+	prvStart();
+	LCD_SetBackColor( Black );
+	LCD_Clear();
+	LCD_SetBackColor( Blue );
+	LCD_SetTextColor( Orange );
+	LCD_SetFont_EN( &EN_Font12x24 );
+	LCD_SetFont_CH( &CH_Font24x24 );
+
+	vLcdModelCount();
+	LCD_SetCursor( 0, 300 );
+	for( i = 0; i < 4; i++ )
+	{
+		LCD_DisplayString( cLine );
+		LCD_DisplayString( "\n" );
+	}
+	CHECK_EQ( LCD_GetCursorY(), 300 + 4 * h );
+	CHECK_EQ( xLcd.ulPixels, 4 * n * w * h );
+	prvCheckBus();
+	prvReport( "text, 4 lines 12x24" );
+
+	for( y = 0; y < h; y++ )
+	{
+		for( x = 0; x < n * w; x++ )
+		{
+			usPixel = xLcd.usPage[ 0 ][ 301 + y ][ x ];
+			CHECK( usPixel == Blue || usPixel == Orange );
+			ulText += usPixel == Orange;
+			uDiff += xLcd.usPage[ 0 ][ 301 + 3 * h + y ][ x ] != usPixel;
+		}
+	}
+	CHECK( ulText > n * 20 );
+	CHECK_EQ( uDiff, 0 );
+	CHECK_EQ( prvRectOff( 0, 0, 300, LCD_SCR_WIDTH, 1, Black ), 0 );
+	CHECK_EQ( prvRectOff( 0, 0, 301 + 4 * h, LCD_SCR_WIDTH, 1, Black ), 0 );
+	CHECK_EQ( prvRectOff( 0, n * w, 301, LCD_SCR_WIDTH - n * w, 4 * h, Black ), 0 );
+
+	/* the cursor moves by the glyph */
+	LCD_SetCursor( 600, 10 );
+	LCD_DisplayAscii( '8' );
+	CHECK_EQ( LCD_GetCursorX(), 600 + w );
+	CHECK_EQ( LCD_GetCursorY(), 10 );
+}
+
+int main( void )
+{
+	test_clear();
+	test_fill();
+	test_text();
+	return TEST_RESULT();
+}
@@ -0,0 +1,86 @@
+/*
+ * The side effects of holding register writes run in the task that serves
+ * the request, the Modbus or the uIP task.  None of them may sleep there;
+ * a pump command is handed to the mpump job on the slow lane instead.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "stm32f10x.h"
+#include "gl_696h.h"
+#include "mb_reg_map.h"
+#include "modbus.h"
+
+#include "host.h"
+#include "rig.h"
+#include "test.h"
+
+/* the job table order, see gl_696h.c */
+enum { JOB_HVL = 0, JOB_HVR, JOB_ADC, JOB_TELEM, JOB_SEQ, JOB_STAT, JOB_MPUMP, JOB_MOTOR };
+
+#define HOOKED( start, count, hook )	start,
+static const uint16_t usHooked[] = { MB_HOLDING_REGIONS( HOOKED ) };
+
+/* Every hooked register, written as it stands, returns within the tick. */
+static void test_no_sleep( void )
+{
+	portTickType xStart;
+	uint32_t i;
+
+	vRigStart();
+	vHostRun( 1000 );
+	for( i = 0; i < sizeof( usHooked ) / sizeof( usHooked[ 0 ] ); i++ )
+	{
+		xStart = xTaskGetTickCount();
+		vRigWriteHolding( usHooked[ i ], eMBRegHolding_Read( usHooked[ i ] ) );
+		CHECK_EQ( xTaskGetTickCount(), xStart );
+	}
+}
+
+/* A pump command from the host goes out from the slow lane right away. */
+static void test_pump_command( void )
+{
+	portTickType xStart;
+	uint32_t ulJob;
+
+	vRigStart();
+	vRigWriteHolding( MB_VMETER_CTL, VMETER_PWR_ON );
+	vHostRun( 1000 );
+	eMBRegInput_Write( MB_POWERPUMP_ST, POWER_ON );
+
+	xStart = xTaskGetTickCount();
+	vRigWriteHolding( MB_MPUMP_CTL, MPUMP_PWR_ON | MPUMP_HIGH_SP | MPUMP_RUN );
+	CHECK_EQ( xTaskGetTickCount(), xStart );
+	vHostRun( 1000 );
+
+	CHECK( eMBRegInput_Read( MB_MPUMP_ST ) & MPUMP_RUN );
+	CHECK_EQ( xBench.ulPumpCmds[ 0x83 ], 1 );		/* high speed */
+	CHECK_EQ( xBench.ulPumpCmds[ 0x81 ], 1 );		/* start */
+	CHECK( xBench.ulPumpCmdTick[ 0x83 ] - xStart <= 10 );
+	/* the 100 ms the pump gets after each command */
+	CHECK( xBench.ulPumpCmdTick[ 0x81 ] - xStart <= 120 );
+
+	/* and the stop, written just as the 2 s status poll goes out */
+	vHostRun( 2000 - xTaskGetTickCount() % 2000 );
+	xStart = xTaskGetTickCount();
+	vRigWriteHolding( MB_MPUMP_CTL, MPUMP_STOP );
+	CHECK_EQ( xTaskGetTickCount(), xStart );
+	vHostRun( 5000 );
+	CHECK( !( eMBRegInput_Read( MB_MPUMP_ST ) & MPUMP_RUN ) );
+	/* at worst behind a status request, which has its 100 ms too */
+	CHECK( xBench.ulPumpCmdTick[ 0x80 ] - xStart <= 150 );
+	CHECK( xBench.ulPumpCmds[ 0x84 ] >= 3 );		/* status */
+
+	for( ulJob = JOB_HVL; ulJob <= JOB_STAT; ulJob++ )
+	{
+		CHECK_EQ( usRigOverruns( ulJob ), 0 );
+	}
+}
+
+int main( void )
+{
+	test_no_sleep();
+	test_pump_command();
+	return TEST_RESULT();
+}
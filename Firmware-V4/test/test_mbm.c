@@ -0,0 +1,335 @@
+/*
+ * The Modbus RTU master of app/mb_master.c on COM2 against a simulated
+ * slave: reads land in the input register image, writes go out as the spec
+ * frames them or as the temperature controller takes them, bad replies are
+ * retried and counted, broadcast reads are refused, and a poll table scans
+ * close to line rate.
+ */
+
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "stm32f10x.h"
+#include "serials.h"
+#include "mb_reg_map.h"
+#include "modbus.h"
+#include "mbcrc.h"
+#include "mb_master.h"
+
+#include "host.h"
+#include "test.h"
+#include "uart_model.h"
+
+#define SLAVE		0x11
+#define SLAVE_REGS	64
+
+typedef struct
+{
+	uint16_t usReg[ SLAVE_REGS ];
+	unsigned long ulFrames;
+	unsigned long ulBadCRC;
+	unsigned uDrop;				/* answer nothing to this many requests */
+	unsigned uCorrupt;			/* answer this many with a bad CRC */
+	unsigned uLegacy;			/* 0x10 without the byte count, low byte first */
+	uint8_t ucLast[ 64 ];		/* last request as it came off the line */
+	unsigned uLastLen;
+} xSlave;
+
+static xUartModel xUart;
+static xSlave xDev;
+static MBM_MASTER xMaster;
+
+static void prvReply( xUartModel *pxUart, uint8_t *pucReply, unsigned uLen )
+{
+	USHORT usCRC = usMBCRC16( pucReply, ( USHORT ) uLen );
+
+	pucReply[ uLen++ ] = ( uint8_t ) usCRC;
+	pucReply[ uLen++ ] = ( uint8_t ) ( usCRC >> 8 );
+	if( xDev.uCorrupt )
+	{
+		xDev.uCorrupt--;
+		pucReply[ uLen - 1 ] ^= 0x5A;
+	}
+	vUartModelSend( pxUart, pucReply, uLen );
+}
+
+static void prvSlave( xUartModel *pxUart, const uint8_t *pucFrame, unsigned uLen )
+{
+	uint8_t ucReply[ 64 ];
+	unsigned uAddr, uCount, i;
+
+	xDev.ulFrames++;
+	memcpy( xDev.ucLast, pucFrame, uLen < sizeof( xDev.ucLast ) ? uLen : sizeof( xDev.ucLast ) );
+	xDev.uLastLen = uLen;
+	if( uLen < 8 || usMBCRC16( ( UCHAR * ) pucFrame, ( USHORT ) uLen ) != 0 )
+	{
+		xDev.ulBadCRC++;
+		return;
+	}
+	if( pucFrame[ 0 ] != SLAVE )
+	{
+		return;
+	}
+	if( xDev.uDrop )
+	{
+		xDev.uDrop--;
+		return;
+	}
+
+	uAddr = ( pucFrame[ 2 ] << 8 ) | pucFrame[ 3 ];
+	uCount = ( pucFrame[ 4 ] << 8 ) | pucFrame[ 5 ];
+	ucReply[ 0 ] = SLAVE;
+	ucReply[ 1 ] = pucFrame[ 1 ];
+	switch( pucFrame[ 1 ] )
+	{
+		case MBM_READ_HOLDING:
+		case MBM_READ_INPUT:
+			if( uAddr + uCount > SLAVE_REGS )
+			{
+				break;
+			}
+			ucReply[ 2 ] = ( uint8_t ) ( uCount * 2 );
+			for( i = 0; i < uCount; i++ )
+			{
+				ucReply[ 3 + i * 2 ] = ( uint8_t ) ( xDev.usReg[ uAddr + i ] >> 8 );
+				ucReply[ 4 + i * 2 ] = ( uint8_t ) xDev.usReg[ uAddr + i ];
+			}
+			prvReply( pxUart, ucReply, 3 + uCount * 2 );
+			return;
+		case MBM_WRITE_SINGLE:
+			if( uAddr >= SLAVE_REGS )
+			{
+				break;
+			}
+			xDev.usReg[ uAddr ] = ( uint16_t ) uCount;
+			memcpy( ucReply + 2, pucFrame + 2, 4 );
+			prvReply( pxUart, ucReply, 6 );
+			return;
+		case MBM_WRITE_MULTIPLE:
+			if( xDev.uLegacy )
+			{
+				if( uAddr + uCount > SLAVE_REGS || uLen != 8 + uCount * 2 )
+				{
+					break;
+				}
+				for( i = 0; i < uCount; i++ )
+				{
+					xDev.usReg[ uAddr + i ] = pucFrame[ 6 + i * 2 ] | ( pucFrame[ 7 + i * 2 ] << 8 );
+				}
+				memcpy( ucReply + 2, pucFrame + 2, 4 );
+				prvReply( pxUart, ucReply, 6 );
+				return;
+			}
+			if( uAddr + uCount > SLAVE_REGS || pucFrame[ 6 ] != uCount * 2 || uLen != 9 + uCount * 2 )
+			{
+				break;
+			}
+			for( i = 0; i < uCount; i++ )
+			{
+				xDev.usReg[ uAddr + i ] = ( pucFrame[ 7 + i * 2 ] << 8 ) | pucFrame[ 8 + i * 2 ];
+			}
+			memcpy( ucReply + 2, pucFrame + 2, 4 );
+			prvReply( pxUart, ucReply, 6 );
+			return;
+		default:
+			break;
+	}
+	/* illegal data address */
+	ucReply[ 1 ] |= 0x80;
+	ucReply[ 2 ] = 0x02;
+	prvReply( pxUart, ucReply, 3 );
+}
+
+static void prvTick( void )
+{
+	vUartModelTick( &xUart );
+}
+
+static void prvStart( eBaud eRate, unsigned long ulBaud )
+{
+	xComPortHandle xPort;
+
+	vHostReset();
+	vHostPeriphReset();
+	memset( &xDev, 0, sizeof( xDev ) );
+	xPort = xSerialPortInit( serCOM2, eRate, serNO_PARITY, serBITS_8, serSTOP_1, 256 );
+	vUartModelInit( &xUart, serCOM2, ulBaud );
+	xUart.pxPeer = prvSlave;
+	vHostAddTickHook( prvTick );
+	CHECK_EQ( mbm_init( &xMaster, xPort, ulBaud ), 0 );
+}
+
+static unsigned long ulDone;
+
+static void prvDone( MBM_REQ *pxReq )
+{
+	( void ) pxReq;
+	ulDone++;
+}
+
+/* A read poll and a block write, process values in and set points out. */
+static void test_read_write( void )
+{
+	static MBM_REQ xRead = { SLAVE, MBM_READ_HOLDING, 0x0000, 4, MB_TEMP00, 200, 100, 2 };
+	static MBM_REQ xWrite = { SLAVE, MBM_WRITE_MULTIPLE, 0x0038, 4, MB_TEMP_SET00, 200, 100, 2 };
+	static const uint8_t ucWire[] = { SLAVE, 0x10, 0x00, 0x38, 0x00, 0x04, 0x08,
+									  0x01, 0x2C, 0x01, 0x90, 0x00, 0x00, 0xFF, 0xFF };
+	USHORT usSet[ 4 ] = { 300, 400, 0, 0xFFFF };
+	USHORT usGot[ 4 ];
+
+	prvStart( ser19200, 19200 );
+	xDev.usReg[ 0 ] = 251;
+	xDev.usReg[ 1 ] = 0x1234;
+	xDev.usReg[ 2 ] = 0;
+	xDev.usReg[ 3 ] = 0xBEEF;
+	eMBRegHolding_WriteBlock( MB_TEMP_SET00, usSet, 4 );
+	CHECK_EQ( mbm_add_poll( &xMaster, &xRead ), 0 );
+	CHECK_EQ( mbm_add_poll( &xMaster, &xWrite ), 0 );
+	xTaskCreate( mbm_task, ( signed char * ) "mbm", 256, &xMaster, 2, NULL );
+	vHostRun( 1000 );
+
+	eMBRegInput_ReadBlock( MB_TEMP00, usGot, 4 );
+	CHECK_EQ( usGot[ 0 ], 251 );
+	CHECK_EQ( usGot[ 1 ], 0x1234 );
+	CHECK_EQ( usGot[ 3 ], 0xBEEF );
+	/* both every 200 ms, give or take the first round */
+	CHECK( xRead.ok >= 4 && xRead.ok <= 6 );
+	CHECK( xWrite.ok >= 4 && xWrite.ok <= 6 );
+	CHECK_EQ( xRead.errors + xRead.timeouts + xWrite.errors + xWrite.timeouts, 0 );
+	CHECK_EQ( xDev.ulBadCRC, 0 );
+
+	/* the set points went out with a byte count, high byte first */
+	CHECK_EQ( xDev.usReg[ 0x38 ], 300 );
+	CHECK_EQ( xDev.usReg[ 0x3B ], 0xFFFF );
+	vHostRun( 200 - xTaskGetTickCount() % 200 + 100 );
+	CHECK_EQ( xDev.uLastLen, sizeof( ucWire ) + 2 );
+	CHECK( memcmp( xDev.ucLast, ucWire, sizeof( ucWire ) ) == 0 );
+}
+
+/* The temperature controller's own 0x10, and a slave that only takes
+   that turns the spec frame away. */
+static void test_legacy( void )
+{
+	static MBM_REQ xWrite = { SLAVE, MBM_WRITE_MULTIPLE, 0x0038, 4, MB_TEMP_SET00, 0, 100, 0, MBM_OPT_LEGACY_10 };
+	static MBM_REQ xSpec = { SLAVE, MBM_WRITE_MULTIPLE, 0x0038, 4, MB_TEMP_SET00, 0, 100, 0 };
+	static const uint8_t ucWire[] = { SLAVE, 0x10, 0x00, 0x38, 0x00, 0x04,
+									  0x2C, 0x01, 0x90, 0x01, 0x00, 0x00, 0xFF, 0xFF };
+	USHORT usSet[ 4 ] = { 300, 400, 0, 0xFFFF };
+
+	prvStart( ser19200, 19200 );
+	xDev.uLegacy = 1;
+	eMBRegHolding_WriteBlock( MB_TEMP_SET00, usSet, 4 );
+	xTaskCreate( mbm_task, ( signed char * ) "mbm", 256, &xMaster, 2, NULL );
+
+	CHECK_EQ( mbm_submit( &xMaster, &xWrite, 0 ), 0 );
+	vHostRun( 200 );
+	CHECK_EQ( xWrite.status, MBM_OK );
+	CHECK_EQ( xDev.uLastLen, sizeof( ucWire ) + 2 );
+	CHECK( memcmp( xDev.ucLast, ucWire, sizeof( ucWire ) ) == 0 );
+	CHECK_EQ( xDev.usReg[ 0x38 ], 300 );
+	CHECK_EQ( xDev.usReg[ 0x39 ], 400 );
+	CHECK_EQ( xDev.usReg[ 0x3B ], 0xFFFF );
+
+	CHECK_EQ( mbm_submit( &xMaster, &xSpec, 0 ), 0 );
+	vHostRun( 200 );
+	CHECK_EQ( xSpec.status, MBM_EXCEPTION );
+}
+
+/* Nobody answers a broadcast, a read of one is refused up front. */
+static void test_broadcast( void )
+{
+	static MBM_REQ xRead = { 0, MBM_READ_HOLDING, 0x0000, 4, MB_TEMP00, 0, 50, 0 };
+	static MBM_REQ xInput = { 0, MBM_READ_INPUT, 0x0000, 4, MB_TEMP00, 0, 50, 0 };
+	static MBM_REQ xWrite = { 0, MBM_WRITE_SINGLE, 0x0000, 1, MB_TEMP_SET00, 0, 50, 0 };
+
+	prvStart( ser19200, 19200 );
+	xTaskCreate( mbm_task, ( signed char * ) "mbm", 256, &xMaster, 2, NULL );
+	CHECK_EQ( mbm_submit( &xMaster, &xRead, 0 ), -1 );
+	CHECK_EQ( mbm_submit( &xMaster, &xInput, 0 ), -1 );
+	CHECK_EQ( mbm_add_poll( &xMaster, &xRead ), -1 );
+	CHECK_EQ( mbm_add_poll( &xMaster, &xInput ), -1 );
+	CHECK_EQ( xMaster.poll_count, 0 );
+
+	CHECK_EQ( mbm_submit( &xMaster, &xWrite, 0 ), 0 );
+	vHostRun( 200 );
+	CHECK_EQ( xWrite.status, MBM_OK );
+	CHECK_EQ( xDev.ulFrames, 1 );
+}
+
+/* Lost and corrupted replies are retried, an exception is not. */
+static void test_errors( void )
+{
+	static MBM_REQ xReq = { SLAVE, MBM_READ_INPUT, 0x0000, 2, MB_TEMP00, 0, 50, 2 };
+	static MBM_REQ xBad = { SLAVE, MBM_READ_INPUT, SLAVE_REGS - 1, 2, MB_TEMP00, 0, 50, 2 };
+	static MBM_REQ xGone = { SLAVE + 1, MBM_WRITE_SINGLE, 0x0000, 1, MB_TEMP_SET00, 0, 50, 1 };
+
+	prvStart( ser19200, 19200 );
+	xTaskCreate( mbm_task, ( signed char * ) "mbm", 256, &xMaster, 2, NULL );
+	xReq.done = xBad.done = xGone.done = prvDone;
+	ulDone = 0;
+
+	/* one lost, one corrupted, the third try gets through */
+	xDev.uDrop = 1;
+	xDev.uCorrupt = 1;
+	xDev.usReg[ 1 ] = 77;
+	CHECK_EQ( mbm_submit( &xMaster, &xReq, 0 ), 0 );
+	vHostRun( 500 );
+	CHECK_EQ( xReq.status, MBM_OK );
+	CHECK_EQ( xReq.ok, 1 );
+	CHECK_EQ( xDev.ulFrames, 3 );
+	CHECK_EQ( eMBRegInput_Read( MB_TEMP00 + 1 ), 77 );
+
+	/* past the end of the slave's map */
+	CHECK_EQ( mbm_submit( &xMaster, &xBad, 0 ), 0 );
+	vHostRun( 500 );
+	CHECK_EQ( xBad.status, MBM_EXCEPTION );
+	CHECK_EQ( xBad.exception, 2 );
+	CHECK_EQ( xBad.errors, 1 );
+	CHECK_EQ( xDev.ulFrames, 4 );
+
+	/* nobody at that address, the first try and one retry time out */
+	CHECK_EQ( mbm_submit( &xMaster, &xGone, 0 ), 0 );
+	vHostRun( 500 );
+	CHECK_EQ( xGone.status, MBM_TIMEOUT );
+	CHECK_EQ( xGone.timeouts, 1 );
+	CHECK_EQ( xDev.ulFrames, 6 );
+	CHECK_EQ( ulDone, 3 );
+}
+
+/* Back to back 4 register reads for 10 s against what the line can carry. */
+static void bench( eBaud eRate, unsigned long ulBaud )
+{
+	static MBM_REQ xPoll = { SLAVE, MBM_READ_HOLDING, 0x0000, 4, MB_TEMP00, 0, 100, 0 };
+	unsigned long ulLine;
+
+	prvStart( eRate, ulBaud );
+	xPoll.ok = xPoll.errors = xPoll.timeouts = 0;
+	CHECK_EQ( mbm_add_poll( &xMaster, &xPoll ), 0 );
+	xTaskCreate( mbm_task, ( signed char * ) "mbm", 256, &xMaster, 2, NULL );
+	vHostRun( 10 * configTICK_RATE_HZ );
+
+	/* an 8 byte request and a 13 byte reply, 11 bits a character, and a
+	t3.5 gap before each, 1750 us above 19200 */
+	ulLine = 1000000UL / ( 231000000UL / ulBaud + 2 * ( ulBaud > 19200 ? 1750 : 38500000UL / ulBaud ) );
+	printf( "%6lu baud: %lu polls/s, the line carries %lu\n", ulBaud, ( unsigned long ) xPoll.ok / 10, ulLine );
+	CHECK_EQ( xPoll.errors + xPoll.timeouts, 0 );
+	if( ulBaud <= 19200 )
+	{
+		/* above that the 1 ms tick rounds the gaps up */
+		CHECK( xPoll.ok / 10 * 100 >= ulLine * 85 );
+	}
+}
+
+int main( void )
+{
+	test_read_write();
+	test_errors();
+	test_legacy();
+	test_broadcast();
+	bench( ser9600, 9600 );
+	bench( ser19200, 19200 );
+	bench( ser115200, 115200 );
+	return TEST_RESULT();
+}
@@ -0,0 +1,335 @@
+/*
+ * Two RTU slaves and the TCP slave of freemodbus served at the same time,
+ * each from its own task and sMBControl.  Slave A runs on USART1 and TIM2
+ * through the port's own interrupt handlers; slave B on USART3 and TIM7,
+ * whose vectors driver/serial.c owns in this build, so the test raises its
+ * frame callbacks the way prvvMBPortSerialISR() would.  A master on each
+ * line and two pipelining TCP clients ask at once for 10 s; every answer
+ * must match the register images and each instance's function table.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "stm32f10x.h"
+#include "port.h"
+#include "mb.h"
+#include "modbus.h"
+#include "mbcrc.h"
+#include "mb_reg_map.h"
+#include "uip.h"
+
+#include "host.h"
+#include "test.h"
+#include "uart_model.h"
+
+void TIM2_IRQHandler( void );
+
+/* uip.c has these, uip.h only its macros */
+extern void *uip_sappdata;
+extern u16_t uip_slen;
+
+#define RUN_TICKS			( 10 * configTICK_RATE_HZ )
+#define FUNC_CUSTOM			0x41
+#define TCP_CLIENTS			2
+#define TCP_PIPELINE		4
+
+typedef struct
+{
+	xUartModel xUart;
+	xMBRTUSlave *pxSlave;
+	UCHAR ucFunc;
+	USHORT usAddr, usCount;
+	unsigned long ulOk, ulBad;
+} xLine;
+
+static xMBRTUSlave xSlaveA = { 0, 0x11, 115200, MB_PAR_NONE };
+static xMBRTUSlave xSlaveB = { 2, 0x22, 9600, MB_PAR_NONE };
+static xLine xLineA, xLineB;
+static unsigned long ulTcpOk, ulTcpBad;
+
+static USHORT usHolding( unsigned uAddr )
+{
+	return ( USHORT ) ( uAddr * 3 + 1 );
+}
+
+static USHORT usInput( unsigned uAddr )
+{
+	return ( USHORT ) ( 0x8000 | uAddr * 5 );
+}
+
+/* Only slave B knows it, the others answer it with an exception. */
+static eMBException eCustom( UCHAR *pucFrame, USHORT *pusLength )
+{
+	pucFrame[ 1 ] = 0x42;
+	*pusLength = 2;
+	return MB_EX_NONE;
+}
+
+/* A request PDU at pucPdu, returns its length. */
+static unsigned uRequest( UCHAR *pucPdu, UCHAR *pucFunc, USHORT *pusAddr, USHORT *pusCount )
+{
+	unsigned uPick = ulTestRand() % 10;
+
+	*pucFunc = uPick < 5 ? MB_FUNC_READ_HOLDING_REGISTER : uPick < 9 ? MB_FUNC_READ_INPUT_REGISTER : FUNC_CUSTOM;
+	*pusAddr = ( USHORT ) ( ulTestRand() % ( REG_INPUT_NREGS - 8 ) );
+	*pusCount = ( USHORT ) ( 1 + ulTestRand() % 8 );
+	pucPdu[ 0 ] = *pucFunc;
+	pucPdu[ 1 ] = ( UCHAR ) ( *pusAddr >> 8 );
+	pucPdu[ 2 ] = ( UCHAR ) *pusAddr;
+	pucPdu[ 3 ] = 0;
+	pucPdu[ 4 ] = ( UCHAR ) *pusCount;
+	return 5;
+}
+
+/* The answer PDU to a request, from an instance that does or does not have
+ * the custom function.  Returns its length or 0 if it is wrong. */
+static unsigned uCheckPdu( const UCHAR *pucPdu, unsigned uLen, UCHAR ucFunc, USHORT usAddr, USHORT usCount, int iCustom )
+{
+	unsigned i, uValue;
+
+	if( ucFunc == FUNC_CUSTOM )
+	{
+		if( iCustom )
+		{
+			return uLen >= 2 && pucPdu[ 0 ] == FUNC_CUSTOM && pucPdu[ 1 ] == 0x42 ? 2 : 0;
+		}
+		return uLen >= 2 && pucPdu[ 0 ] == ( FUNC_CUSTOM | MB_FUNC_ERROR ) && pucPdu[ 1 ] == MB_EX_ILLEGAL_FUNCTION ? 2 : 0;
+	}
+	if( uLen < 2 + usCount * 2U || pucPdu[ 0 ] != ucFunc || pucPdu[ 1 ] != usCount * 2 )
+	{
+		return 0;
+	}
+	for( i = 0; i < usCount; i++ )
+	{
+		uValue = ( pucPdu[ 2 + i * 2 ] << 8 ) | pucPdu[ 3 + i * 2 ];
+		if( uValue != ( ucFunc == MB_FUNC_READ_HOLDING_REGISTER ? usHolding( usAddr + i ) : usInput( usAddr + i ) ) )
+		{
+			return 0;
+		}
+	}
+	return 2 + usCount * 2;
+}
+
+/* ---- RTU masters --------------------------------------------------------- */
+
+static void prvAsk( xLine *pxLine )
+{
+	UCHAR ucFrame[ 8 ];
+	USHORT usCRC;
+
+	ucFrame[ 0 ] = pxLine->pxSlave->ucAddress;
+	uRequest( ucFrame + 1, &pxLine->ucFunc, &pxLine->usAddr, &pxLine->usCount );
+	usCRC = usMBCRC16( ucFrame, 6 );
+	ucFrame[ 6 ] = ( UCHAR ) usCRC;
+	ucFrame[ 7 ] = ( UCHAR ) ( usCRC >> 8 );
+	vUartModelSend( &pxLine->xUart, ucFrame, sizeof( ucFrame ) );
+}
+
+static void prvMaster( xUartModel *pxUart, const uint8_t *pucFrame, unsigned uLen )
+{
+	xLine *pxLine = pxUart->pvArg;
+
+	if( uLen >= 5 && usMBCRC16( ( UCHAR * ) pucFrame, ( USHORT ) uLen ) == 0 &&
+		pucFrame[ 0 ] == pxLine->pxSlave->ucAddress &&
+		uCheckPdu( pucFrame + 1, uLen - 3, pxLine->ucFunc, pxLine->usAddr, pxLine->usCount, pxLine == &xLineB ) == uLen - 3 )
+	{
+		pxLine->ulOk++;
+	}
+	else
+	{
+		pxLine->ulBad++;
+	}
+	prvAsk( pxLine );
+}
+
+/* USART3's vector is driver/serial.c's, this is the Modbus port's body. */
+static void prvUsart3Irq( void )
+{
+	sMBControl *sMBC = &xSlaveB.xMBC;
+
+	if( ( USART3->CR1 & USART_CR1_TXEIE ) && USART_GetITStatus( USART3, USART_IT_TXE ) )
+	{
+		sMBC->pxMBFrameCBTransmitterEmpty( sMBC );
+	}
+	if( ( USART3->CR1 & USART_CR1_RXNEIE ) && USART_GetITStatus( USART3, USART_IT_RXNE ) )
+	{
+		sMBC->pxMBFrameCBByteReceived( sMBC );
+	}
+}
+
+static void prvTim7Irq( void )
+{
+	xSlaveB.xMBC.pxMBPortCBTimerExpired( &xSlaveB.xMBC );
+}
+
+/* The counter runs at the prescaled clock, the update interrupt fires at
+ * the auto reload value. */
+static void prvTimer( TIM_TypeDef *pxTim, void ( *pxIrq )( void ) )
+{
+	if( !( pxTim->CR1 & TIM_CR1_CEN ) || !( pxTim->DIER & TIM_IT_Update ) )
+	{
+		return;
+	}
+	pxTim->CNT += configCPU_CLOCK_HZ / ( pxTim->PSC + 1 ) / configTICK_RATE_HZ;
+	if( pxTim->CNT >= pxTim->ARR )
+	{
+		pxTim->CNT = 0;
+		pxTim->SR |= TIM_IT_Update;
+		pxIrq();
+		pxTim->SR &= ~TIM_IT_Update;
+	}
+}
+
+static void prvTick( void )
+{
+	vUartModelTick( &xLineA.xUart );
+	vUartModelTick( &xLineB.xUart );
+	prvTimer( TIM2, TIM2_IRQHandler );
+	prvTimer( TIM7, prvTim7Irq );
+}
+
+/* ---- TCP clients, from a stand-in for the uIP task ----------------------- */
+
+static UCHAR ucSend[ UIP_BUFSIZE ];
+
+static void prvTcpCall( int iConn, u8_t ucFlags, void *pvData, u16_t usLen )
+{
+	uip_conn = &uip_conns[ iConn ];
+	uip_flags = ucFlags;
+	uip_appdata = pvData;
+	uip_sappdata = ucSend;
+	uip_len = usLen;
+	uip_slen = 0;
+	modbus_tcp_appcall();
+}
+
+/* Each client sends four requests in one segment and checks the answers,
+ * which may come back over several callbacks, before the next batch. */
+static void prvUipTask( void *pvParameters )
+{
+	static UCHAR ucSeg[ TCP_PIPELINE * 12 ];
+	UCHAR ucFunc[ TCP_CLIENTS ][ TCP_PIPELINE ];
+	USHORT usAddr[ TCP_CLIENTS ][ TCP_PIPELINE ], usCount[ TCP_CLIENTS ][ TCP_PIPELINE ];
+	unsigned uAnswered[ TCP_CLIENTS ] = { TCP_PIPELINE, TCP_PIPELINE };
+	u8_t ucAck[ TCP_CLIENTS ] = { 0, 0 };
+	unsigned uBatch[ TCP_CLIENTS ] = { 0, 0 };
+	unsigned uTid = 0, uPos, uLen, k;
+	int iConn;
+
+	( void ) pvParameters;
+	modbus_tcp_init();
+	for( iConn = 0; iConn < TCP_CLIENTS; iConn++ )
+	{
+		uip_conns[ iConn ].mss = UIP_TCP_MSS;
+		prvTcpCall( iConn, UIP_CONNECTED, NULL, 0 );
+	}
+
+	for( ;; )
+	{
+		for( iConn = 0; iConn < TCP_CLIENTS; iConn++ )
+		{
+			uLen = 0;
+			if( uAnswered[ iConn ] == TCP_PIPELINE && !uip_stopped( &uip_conns[ iConn ] ) )
+			{
+				for( k = 0; k < TCP_PIPELINE; k++, uLen += 12 )
+				{
+					ucSeg[ uLen + 0 ] = ( UCHAR ) ( ( uTid + k ) >> 8 );
+					ucSeg[ uLen + 1 ] = ( UCHAR ) ( uTid + k );
+					ucSeg[ uLen + 2 ] = ucSeg[ uLen + 3 ] = ucSeg[ uLen + 4 ] = 0;
+					ucSeg[ uLen + 5 ] = 6;
+					ucSeg[ uLen + 6 ] = 1;
+					uRequest( ucSeg + uLen + 7, &ucFunc[ iConn ][ k ], &usAddr[ iConn ][ k ], &usCount[ iConn ][ k ] );
+				}
+				uAnswered[ iConn ] = 0;
+			}
+			prvTcpCall( iConn, ( u8_t ) ( ucAck[ iConn ] | ( uLen ? UIP_NEWDATA : UIP_POLL ) ), ucSeg, ( u16_t ) uLen );
+			if( uLen )
+			{
+				uBatch[ iConn ] = uTid;
+				uTid += TCP_PIPELINE;
+			}
+			ucAck[ iConn ] = uip_slen ? UIP_ACKDATA : 0;
+
+			for( uPos = 0; uPos + 7 < uip_slen && uAnswered[ iConn ] < TCP_PIPELINE; uPos += 7 + uLen )
+			{
+				k = uAnswered[ iConn ]++;
+				uLen = ( ( ucSend[ uPos + 4 ] << 8 ) | ucSend[ uPos + 5 ] ) - 1;
+				if( ( ( ucSend[ uPos ] << 8 ) | ucSend[ uPos + 1 ] ) == ( ( uBatch[ iConn ] + k ) & 0xFFFF ) &&
+					ucSend[ uPos + 6 ] == 1 &&
+					uCheckPdu( ucSend + uPos + 7, uLen, ucFunc[ iConn ][ k ], usAddr[ iConn ][ k ], usCount[ iConn ][ k ], 0 ) == uLen )
+				{
+					ulTcpOk++;
+				}
+				else
+				{
+					ulTcpBad++;
+				}
+			}
+		}
+		vTaskDelay( 1 );
+	}
+}
+
+/* Share of the time the line carried a character, in percent. */
+static unsigned long ulBusy( xLine *pxLine )
+{
+	return ( pxLine->xUart.ulRxBytes + pxLine->xUart.ulTxBytes ) * 10 * 100 /
+		   ( pxLine->xUart.ulBaud * ( RUN_TICKS / configTICK_RATE_HZ ) );
+}
+
+int main( void )
+{
+	USHORT usRegs[ REG_INPUT_NREGS ];
+	unsigned i;
+
+	vTestSeed( 12 );
+	vHostReset();
+	vHostPeriphReset();
+	for( i = 0; i < REG_INPUT_NREGS; i++ )
+	{
+		usRegs[ i ] = usHolding( i );
+	}
+	eMBRegHolding_WriteBlock( 0, usRegs, REG_INPUT_NREGS );
+	for( i = 0; i < REG_INPUT_NREGS; i++ )
+	{
+		usRegs[ i ] = usInput( i );
+	}
+	eMBRegInput_WriteBlock( 0, usRegs, REG_INPUT_NREGS );
+
+	vUartModelInit( &xLineA.xUart, serCOM1, xSlaveA.ulBaudRate );
+	vUartModelInit( &xLineB.xUart, serCOM3, xSlaveB.ulBaudRate );
+	xLineB.xUart.pxIrq = prvUsart3Irq;
+	xLineA.pxSlave = &xSlaveA;
+	xLineB.pxSlave = &xSlaveB;
+	xLineA.xUart.pvArg = &xLineA;
+	xLineB.xUart.pvArg = &xLineB;
+	xLineA.xUart.pxPeer = xLineB.xUart.pxPeer = prvMaster;
+	vHostAddTickHook( prvTick );
+
+	xTaskCreate( vMBRTUSlaveTask, ( signed char * ) "FMB-A", configMINIMAL_STACK_SIZE * 2, &xSlaveA, 2, NULL );
+	xTaskCreate( vMBRTUSlaveTask, ( signed char * ) "FMB-B", configMINIMAL_STACK_SIZE * 2, &xSlaveB, 2, NULL );
+	xTaskCreate( prvUipTask, ( signed char * ) "uIP", configMINIMAL_STACK_SIZE * 2, NULL, 2, NULL );
+
+	/* the slaves are up, B learns the custom function and the masters start */
+	vHostRun( 10 );
+	CHECK_EQ( eMBRegisterCB( &xSlaveB.xMBC, FUNC_CUSTOM, eCustom ), MB_ENOERR );
+	prvAsk( &xLineA );
+	prvAsk( &xLineB );
+	vHostRun( RUN_TICKS );
+
+	printf( "RTU A %6lu baud: %lu/s, line busy %lu%%\n", xSlaveA.ulBaudRate, xLineA.ulOk / 10, ulBusy( &xLineA ) );
+	printf( "RTU B %6lu baud: %lu/s, line busy %lu%%\n", xSlaveB.ulBaudRate, xLineB.ulOk / 10, ulBusy( &xLineB ) );
+	printf( "TCP, %d clients: %lu/s\n", TCP_CLIENTS, ulTcpOk / 10 );
+	printf( "all three: %lu transactions/s\n", ( xLineA.ulOk + xLineB.ulOk + ulTcpOk ) / 10 );
+	CHECK_EQ( xLineA.ulBad + xLineB.ulBad + ulTcpBad, 0 );
+	CHECK( xLineA.ulOk > 0 && xLineB.ulOk > 0 && ulTcpOk > 0 );
+	/* at 9600 the t3.5 gaps are what is left, at 115200 the 1 ms tick
+	rounds the 1.75 ms gap up and the line cannot be judged */
+	CHECK( ulBusy( &xLineB ) >= 60 );
+
+	return TEST_RESULT();
+}
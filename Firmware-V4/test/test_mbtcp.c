@@ -0,0 +1,335 @@
+/*
+ * Modbus TCP answered inside the uIP callback, freemodbus/port/porttcp.c.
+ * The test plays uIP: it calls modbus_tcp_appcall() for a connection with
+ * the flags and segment uip_process() would, and takes what the callback
+ * hands to uip_send().  Several clients pipeline requests over randomly cut
+ * segments, ACK late and ask for retransmits; every answer must come back
+ * whole, in transaction ID order and with the register image's values.
+ */
+
+#include <string.h>
+#include <time.h>
+
+#include "port.h"
+#include "mb.h"
+#include "modbus.h"
+#include "uip.h"
+
+#include "test.h"
+
+#define MAX_OUTSTANDING		160		/* more than a full segment of requests */
+#define MB_TCP_BUF_SIZE		( 256 + 7 )
+#define FUNC_UNKNOWN		0x41
+
+/* uip.c has these, uip.h only its macros */
+extern void *uip_sappdata;
+extern u16_t uip_slen;
+
+static UCHAR ucSend[ UIP_BUFSIZE ];
+
+static void prvCall( int iConn, u8_t ucFlags, void *pvData, u16_t usLen )
+{
+	uip_conn = &uip_conns[ iConn ];
+	uip_flags = ucFlags;
+	uip_appdata = pvData;
+	uip_sappdata = ucSend;
+	uip_len = usLen;
+	uip_slen = 0;
+	modbus_tcp_appcall();
+}
+
+static unsigned uRequest( UCHAR *pucBuf, unsigned uTid, UCHAR ucFunc, unsigned uAddr, unsigned uCount )
+{
+	UCHAR ucReq[ 12 ] = { 0, 0, 0, 0, 0, 6, 1, 0, 0, 0, 0, 0 };
+
+	ucReq[ 0 ] = ( UCHAR ) ( uTid >> 8 );
+	ucReq[ 1 ] = ( UCHAR ) uTid;
+	ucReq[ 7 ] = ucFunc;
+	ucReq[ 8 ] = ( UCHAR ) ( uAddr >> 8 );
+	ucReq[ 9 ] = ( UCHAR ) uAddr;
+	ucReq[ 11 ] = ( UCHAR ) uCount;
+	memcpy( pucBuf, ucReq, sizeof( ucReq ) );
+	return sizeof( ucReq );
+}
+
+static USHORT usHolding( unsigned uAddr )
+{
+	return ( USHORT ) ( uAddr * 3 + 1 );
+}
+
+/* One answer at pucAns, returns its length or 0 if it is not the answer
+ * to a read of uCount registers at uAddr, or the exception for ucFunc. */
+static unsigned uCheckAnswer( const UCHAR *pucAns, unsigned uTid, UCHAR ucFunc, unsigned uAddr, unsigned uCount )
+{
+	unsigned uLen = 6 + ( ( pucAns[ 4 ] << 8 ) | pucAns[ 5 ] );
+	unsigned i;
+
+	if( ( ( pucAns[ 0 ] << 8 ) | pucAns[ 1 ] ) != ( uTid & 0xFFFF ) || pucAns[ 2 ] || pucAns[ 3 ] || pucAns[ 6 ] != 1 )
+	{
+		return 0;
+	}
+	if( ucFunc != MB_FUNC_READ_HOLDING_REGISTER )
+	{
+		return ( uLen == 9 && pucAns[ 7 ] == ( ucFunc | MB_FUNC_ERROR ) && pucAns[ 8 ] == MB_EX_ILLEGAL_FUNCTION ) ? uLen : 0;
+	}
+	if( uLen != 9 + uCount * 2 || pucAns[ 7 ] != ucFunc || pucAns[ 8 ] != uCount * 2 )
+	{
+		return 0;
+	}
+	for( i = 0; i < uCount; i++ )
+	{
+		if( ( ( pucAns[ 9 + i * 2 ] << 8 ) | pucAns[ 10 + i * 2 ] ) != usHolding( uAddr + i ) )
+		{
+			return 0;
+		}
+	}
+	return uLen;
+}
+
+static void prvStart( void )
+{
+	USHORT usRegs[ 128 ];
+	unsigned i;
+
+	for( i = 0; i < 128; i++ )
+	{
+		usRegs[ i ] = usHolding( i );
+	}
+	eMBRegHolding_WriteBlock( 0, usRegs, 128 );
+
+	memset( uip_conns, 0, sizeof( uip_conns ) );
+	modbus_tcp_init();
+	for( i = 0; i < UIP_CONNS; i++ )
+	{
+		uip_conns[ i ].mss = UIP_TCP_MSS;
+		prvCall( i, UIP_CONNECTED, NULL, 0 );
+	}
+}
+
+/* A request that arrives a byte at a time is answered once, when whole. */
+static void test_split( void )
+{
+	UCHAR ucReq[ 12 ];
+	unsigned uLen, i;
+
+	prvStart();
+	uLen = uRequest( ucReq, 0x1234, MB_FUNC_READ_HOLDING_REGISTER, 10, 3 );
+	for( i = 0; i < uLen - 1; i++ )
+	{
+		prvCall( 0, UIP_NEWDATA, ucReq + i, 1 );
+		CHECK_EQ( uip_slen, 0 );
+	}
+	prvCall( 0, UIP_NEWDATA, ucReq + i, 1 );
+	CHECK_EQ( uip_slen, 15 );
+	CHECK_EQ( uCheckAnswer( ucSend, 0x1234, MB_FUNC_READ_HOLDING_REGISTER, 10, 3 ), 15 );
+
+	/* nothing more until the ACK, then nothing at all */
+	prvCall( 0, UIP_POLL, NULL, 0 );
+	CHECK_EQ( uip_slen, 0 );
+	prvCall( 0, UIP_ACKDATA, NULL, 0 );
+	CHECK_EQ( uip_slen, 0 );
+}
+
+/* A length that no Modbus frame has resets the connection. */
+static void test_bad_header( void )
+{
+	UCHAR ucReq[ 12 ];
+
+	prvStart();
+	uRequest( ucReq, 1, MB_FUNC_READ_HOLDING_REGISTER, 0, 1 );
+	ucReq[ 5 ] = 1;
+	prvCall( 2, UIP_NEWDATA, ucReq, sizeof( ucReq ) );
+	CHECK_EQ( uip_flags, UIP_ABORT );
+	CHECK_EQ( uip_slen, 0 );
+}
+
+typedef struct
+{
+	UCHAR ucStream[ 4096 ];		/* requests not yet delivered */
+	unsigned uStreamLen;
+	unsigned uNextTid, uExpectTid;
+	UCHAR ucFunc[ MAX_OUTSTANDING ];
+	unsigned uAddr[ MAX_OUTSTANDING ], uCount[ MAX_OUTSTANDING ];
+	unsigned long ulAsked[ MAX_OUTSTANDING ];	/* callback the request was complete in */
+	unsigned uAskedTid;
+	unsigned long ulDelivered;
+	unsigned long ulCalls;
+	UCHAR ucInFlight[ UIP_TCP_MSS ];
+	unsigned uInFlight;
+} xClient;
+
+static xClient xClients[ UIP_CONNS ];
+static unsigned long ulLatency[ 64 ];		/* callbacks from request to answer */
+
+/* Every client keeps up to 160 requests outstanding and the test cuts their
+ * stream at random, up to full segments, ACKs two sends in three and asks
+ * for a resend now and then.  With the pool taken a segment is held back
+ * mostly whole, far past one frame buffer.  Also the benchmark: transactions
+ * per callback and per second. */
+static void test_pipeline( void )
+{
+	static UCHAR ucSeg[ UIP_TCP_MSS ];
+	unsigned long ulDone = 0, ulCalls = 0, ulSum, ulP99 = 0, ulMax = 0, ulHeld = 0;
+	unsigned uSeg, uPos, uLen, k, i;
+	struct timespec xT0, xT1;
+	xClient *pxC;
+	u8_t ucFlags;
+	int iConn, iFail = 0;
+	double dSeconds;
+
+	prvStart();
+	memset( xClients, 0, sizeof( xClients ) );
+	memset( ulLatency, 0, sizeof( ulLatency ) );
+	clock_gettime( CLOCK_MONOTONIC, &xT0 );
+
+	while( ulCalls < 300000 && !iFail )
+	{
+		iConn = ulTestRand() % UIP_CONNS;
+		pxC = &xClients[ iConn ];
+		ucFlags = 0;
+		uSeg = 0;
+
+		if( uip_stopped( &uip_conns[ iConn ] ) )
+		{
+			/* uIP holds new data back, the periodic poll comes through */
+			if( !pxC->uInFlight )
+			{
+				ucFlags |= UIP_POLL;
+			}
+		}
+		else
+		{
+			while( pxC->uNextTid - pxC->uExpectTid < MAX_OUTSTANDING && pxC->uStreamLen < UIP_TCP_MSS )
+			{
+				k = pxC->uNextTid % MAX_OUTSTANDING;
+				pxC->ucFunc[ k ] = ulTestRand() % 50 ? MB_FUNC_READ_HOLDING_REGISTER : FUNC_UNKNOWN;
+				pxC->uAddr[ k ] = ulTestRand() % 100;
+				pxC->uCount[ k ] = 1 + ulTestRand() % 20;
+				pxC->uStreamLen += uRequest( pxC->ucStream + pxC->uStreamLen, pxC->uNextTid++ & 0xFFFF,
+											 pxC->ucFunc[ k ], pxC->uAddr[ k ], pxC->uCount[ k ] );
+			}
+			if( pxC->uStreamLen )
+			{
+				uSeg = 1 + ulTestRand() % pxC->uStreamLen;
+				if( uSeg > UIP_TCP_MSS )
+				{
+					uSeg = UIP_TCP_MSS;
+				}
+				memcpy( ucSeg, pxC->ucStream, uSeg );
+				memmove( pxC->ucStream, pxC->ucStream + uSeg, pxC->uStreamLen - uSeg );
+				pxC->uStreamLen -= uSeg;
+				ucFlags |= UIP_NEWDATA;
+			}
+		}
+		if( pxC->uInFlight && ulTestRand() % 3 )
+		{
+			ucFlags |= UIP_ACKDATA;
+		}
+		else if( pxC->uInFlight && ulTestRand() % 20 == 0 )
+		{
+			ucFlags |= UIP_REXMIT;
+		}
+		if( !ucFlags )
+		{
+			continue;
+		}
+
+		prvCall( iConn, ucFlags, ucSeg, uSeg );
+		ulCalls++;
+		pxC->ulCalls++;
+		if( uip_flags == UIP_ABORT )
+		{
+			fprintf( stderr, "conn %d aborted\n", iConn );
+			iFail = 1;
+			break;
+		}
+
+		/* stopped on a segment longer than a frame buffer, it was kept */
+		if( uSeg > MB_TCP_BUF_SIZE && uip_stopped( &uip_conns[ iConn ] ) )
+		{
+			ulHeld++;
+		}
+
+		/* the requests this segment completed */
+		pxC->ulDelivered += uSeg;
+		while( pxC->uAskedTid != pxC->uNextTid && ( pxC->uAskedTid + 1 ) * 12UL <= pxC->ulDelivered )
+		{
+			pxC->ulAsked[ pxC->uAskedTid++ % MAX_OUTSTANDING ] = pxC->ulCalls;
+		}
+
+		if( ucFlags & UIP_ACKDATA )
+		{
+			pxC->uInFlight = 0;
+		}
+		if( uip_slen == 0 )
+		{
+			continue;
+		}
+		if( ucFlags & UIP_REXMIT )
+		{
+			/* the same bytes again */
+			CHECK_EQ( uip_slen, pxC->uInFlight );
+			CHECK( memcmp( ucSend, pxC->ucInFlight, pxC->uInFlight ) == 0 );
+			continue;
+		}
+		if( pxC->uInFlight )
+		{
+			fprintf( stderr, "conn %d sent with a segment in flight\n", iConn );
+			iFail = 1;
+			break;
+		}
+		memcpy( pxC->ucInFlight, ucSend, uip_slen );
+		pxC->uInFlight = uip_slen;
+
+		for( uPos = 0; uPos < uip_slen; uPos += uLen )
+		{
+			k = pxC->uExpectTid % MAX_OUTSTANDING;
+			uLen = uCheckAnswer( ucSend + uPos, pxC->uExpectTid, pxC->ucFunc[ k ], pxC->uAddr[ k ], pxC->uCount[ k ] );
+			if( uLen == 0 || uPos + uLen > uip_slen )
+			{
+				fprintf( stderr, "conn %d: bad answer to transaction %u\n", iConn, pxC->uExpectTid );
+				iFail = 1;
+				break;
+			}
+			i = pxC->ulCalls - pxC->ulAsked[ k ];
+			ulLatency[ i < 63 ? i : 63 ]++;
+			pxC->uExpectTid++;
+			ulDone++;
+		}
+	}
+
+	clock_gettime( CLOCK_MONOTONIC, &xT1 );
+	dSeconds = ( xT1.tv_sec - xT0.tv_sec ) + ( xT1.tv_nsec - xT0.tv_nsec ) / 1e9;
+	CHECK( !iFail );
+	CHECK( ulDone > ulCalls );
+	CHECK( ulHeld > 0 );
+
+	for( ulSum = 0, i = 0; i < 64; i++ )
+	{
+		ulSum += ulLatency[ i ];
+		if( ulLatency[ i ] )
+		{
+			ulMax = i;
+		}
+		if( ulP99 == 0 && ulSum * 100 >= ulDone * 99 )
+		{
+			ulP99 = i;
+		}
+	}
+	printf( "%d clients: %lu transactions in %lu callbacks, %.1f a callback, %.0f/s on the host\n",
+			UIP_CONNS, ulDone, ulCalls, ( double ) ulDone / ulCalls, ulDone / dSeconds );
+	printf( "%lu segments over %u bytes held back with the connection stopped\n", ulHeld, MB_TCP_BUF_SIZE );
+	printf( "callbacks on the connection from request to answer: p99 %lu, max %lu%s\n",
+			ulP99, ulMax, ulMax == 63 ? "+" : "" );
+	/* three buffers for five clients, none of them is starved */
+	CHECK( ulMax < 63 );
+}
+
+int main( void )
+{
+	vTestSeed( 502 );
+	test_split();
+	test_bad_header();
+	test_pipeline();
+	return TEST_RESULT();
+}
@@ -0,0 +1,160 @@
+/*
+ * The frame pool between the ENC28J60 driver task and the uIP task, with
+ * the whole stack booted on the controller model.  A burst from the wire is
+ * answered frame for frame while the answers are still going out.  Frames
+ * the pool can not take wait in the controller's ring, and only those that
+ * do not fit there are lost, and counted.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+#include "netbuf.h"
+
+#include "host.h"
+#include "test.h"
+#include "net_peer.h"
+
+/* Every buffer back on the free list and nothing left in the ring. */
+static void prvCheckIdle( void )
+{
+	vHostRun( 100 );
+	CHECK_EQ( xNetStats.usFree, netBUF_COUNT );
+	CHECK_EQ( uxQueueMessagesWaiting( xNetRxQueue ), 0 );
+	CHECK_EQ( uxQueueMessagesWaiting( xNetTxQueue ), 0 );
+	CHECK_EQ( xPeer.ulBadFrames, 0 );
+}
+
+/* Three times the pool in one go, every ping answered. */
+static void test_burst( void )
+{
+	portTickType xStart, xDone = 0;
+	unsigned uRound, i;
+	unsigned long ulSent = 0;
+
+	vPeerStart();
+	for( uRound = 0; uRound < 5; uRound++ )
+	{
+		xStart = xTaskGetTickCount();
+		for( i = 0; i < netBUF_COUNT * 3; i++ )
+		{
+			vPeerPing( ( uint16_t ) ulSent++, 200 );
+		}
+		while( xPeer.ulPingReplies < ulSent && xTaskGetTickCount() - xStart < 1000 )
+		{
+			vHostRun( 1 );
+		}
+		if( xTaskGetTickCount() - xStart > xDone )
+		{
+			xDone = xTaskGetTickCount() - xStart;
+		}
+	}
+	CHECK_EQ( xPeer.ulPingReplies, ulSent );
+	CHECK_EQ( xPeer.ulDropped, 0 );
+	CHECK_EQ( xNetStats.ulRxOverflow, 0 );
+	CHECK_EQ( xNetStats.usMaxUsed, netBUF_COUNT );
+	CHECK( xNetStats.ulRxDeferred > 0 );
+	CHECK_EQ( xNetStats.ulTxNoBuf, 0 );
+	prvCheckIdle();
+	printf( "burst of %d pings: answered within %lu ms, RX queue %u deep, TX queue %u deep, %lu deferrals\n",
+			netBUF_COUNT * 3, ( unsigned long ) xDone, xNetStats.usRxMaxQueued, xNetStats.usTxMaxQueued,
+			xNetStats.ulRxDeferred );
+}
+
+/* More than the ring holds: the rest is lost at the controller, counted,
+ * and every frame that made it in is answered. */
+static void test_overflow( void )
+{
+	unsigned i;
+
+	vPeerStart();
+	for( i = 0; i < 20; i++ )
+	{
+		vPeerPing( ( uint16_t ) i, 1000 );
+	}
+	vHostRun( 500 );
+	CHECK( xPeer.ulDropped > 0 );
+	CHECK_EQ( xPeer.ulPingReplies, 20 - xPeer.ulDropped );
+	CHECK( xNetStats.ulRxOverflow > 0 );
+	prvCheckIdle();
+
+	/* and the next ones come through as before */
+	for( i = 0; i < 4; i++ )
+	{
+		vPeerPing( ( uint16_t ) ( 100 + i ), 1000 );
+	}
+	vHostRun( 100 );
+	CHECK_EQ( xPeer.ulPingReplies, 24 - xPeer.ulDropped );
+}
+
+/* A page goes out while pings keep coming; nothing waits for the page and
+ * the pool counters it shows are the ones the pool keeps. */
+static void test_page_under_load( void )
+{
+	static char cPage[ 8192 ];
+	static const char cGet[] = "GET /stats.shtml HTTP/1.0\r\n\r\n";
+	xPeerTcp xConn = { 0 };
+	unsigned long ulNum[ 64 ];
+	unsigned uNums = 0, i;
+	char *pcPre, *pcEnd;
+
+	vPeerStart();
+	xConn.pucRx = ( uint8_t * ) cPage;
+	xConn.uRxMax = sizeof( cPage ) - 1;
+	CHECK( iPeerConnect( &xConn, 80 ) );
+	vPeerTcpSend( &xConn, cGet, sizeof( cGet ) - 1 );
+	for( i = 0; i < 200 && xConn.iState == PEER_OPEN; i++ )
+	{
+		vPeerPing( ( uint16_t ) i, 300 );
+		vHostRun( 5 );
+	}
+	CHECK( iPeerTcpWait( &xConn, 2000 ) );
+	vHostRun( 20 );
+	CHECK_EQ( xPeer.ulPingReplies, i );
+	CHECK_EQ( xPeer.ulDropped, 0 );
+	cPage[ xConn.ulRxBytes < sizeof( cPage ) ? xConn.ulRxBytes : sizeof( cPage ) - 1 ] = 0;
+	CHECK( strncmp( cPage, "HTTP/1.0 200 OK", 15 ) == 0 );
+
+	/* the pool block is the last ten numbers of the page */
+	CHECK( strstr( cPage, "%! net-stats" ) == NULL );
+	pcEnd = strstr( cPage, "</pre></table>" );
+	pcPre = pcEnd;
+	while( pcPre != NULL && pcPre > cPage && strncmp( pcPre, "<pre>", 5 ) != 0 )
+	{
+		pcPre--;
+	}
+	CHECK( pcEnd != NULL && pcPre > cPage );
+	if( pcEnd != NULL && pcPre > cPage )
+	{
+		for( pcPre += 5; pcPre < pcEnd && uNums < 64; )
+		{
+			ulNum[ uNums++ ] = strtoul( pcPre, &pcPre, 10 );
+			while( pcPre < pcEnd && *pcPre != '\n' )
+			{
+				pcPre++;
+			}
+			pcPre++;
+		}
+	}
+	CHECK( uNums >= 10 );
+	if( uNums >= 10 )
+	{
+		CHECK_EQ( ulNum[ uNums - 10 ], netBUF_COUNT );
+		CHECK( ulNum[ uNums - 9 ] >= 2 && ulNum[ uNums - 9 ] <= netBUF_COUNT );
+		CHECK( ulNum[ uNums - 6 ] > i );					/* RX frames */
+	}
+	prvCheckIdle();
+}
+
+int main( void )
+{
+	test_burst();
+	test_overflow();
+	test_page_under_load();
+	return TEST_RESULT();
+}
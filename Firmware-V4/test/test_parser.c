@@ -0,0 +1,204 @@
+/*
+ * The vacuum gauge and FD110A parsers fed byte streams as they come off
+ * the line: noise, restarts, replies to other commands, bad checksums and
+ * random input.
+ */
+
+#include <math.h>
+#include <string.h>
+
+#include "dev_parser.h"
+
+#include "test.h"
+
+static int prvFeedV( VMETER_PARSER *p, const char *pcIn, VMETER_EVENT *pxEv, int iMax )
+{
+	int n = 0;
+	int32_t r;
+
+	while( *pcIn )
+	{
+		r = vmeter_parse( p, ( uint8_t ) *pcIn++, &pxEv[ n ] );
+		if( r == PARSE_EVENT && n < iMax )
+		{
+			n++;
+		}
+	}
+	return n;
+}
+
+static void test_vmeter( void )
+{
+	VMETER_PARSER p;
+	VMETER_EVENT ev[ 8 ];
+
+	vmeter_parser_init( &p );
+	/* noise, then pirani only: the ion field reads "----" */
+	CHECK_EQ( prvFeedV( &p, "xx\r\n*23-1----", ev, 8 ), 1 );
+	CHECK_EQ( ev[ 0 ].source, VMETER_SRC_PIRANI );
+	CHECK( fabs( ev[ 0 ].pressure - 0.23f ) < 1e-6 );
+
+	/* ion wins while it reads */
+	CHECK_EQ( prvFeedV( &p, "*23-152-3", ev, 8 ), 1 );
+	CHECK_EQ( ev[ 0 ].source, VMETER_SRC_ION );
+	CHECK( fabs( ev[ 0 ].pressure - 5.2e-3f ) < 1e-9 );
+
+	/* a head inside a body starts over, the cut frame is not an error */
+	CHECK_EQ( prvFeedV( &p, "*12*10+2----", ev, 8 ), 1 );
+	CHECK( fabs( ev[ 0 ].pressure - 100.0f ) < 1e-3 );
+	CHECK_EQ( p.errors, 0 );
+
+	/* neither gauge reads */
+	CHECK_EQ( prvFeedV( &p, "*?-------", ev, 8 ), 0 );
+	CHECK_EQ( p.errors, 1 );
+	CHECK_EQ( p.frames, 3 );
+
+	/* back to back, no separator */
+	CHECK_EQ( prvFeedV( &p, "*10+0----*20+0----*30+0----", ev, 8 ), 3 );
+	CHECK( fabs( ev[ 2 ].pressure - 3.0f ) < 1e-6 );
+}
+
+static unsigned prvMpumpFrame( uint8_t *pucOut, uint8_t ucCmd, uint8_t ucSt, uint16_t usFreq, uint16_t usVol, uint16_t usCur )
+{
+	uint8_t ucXor = 0;
+	unsigned i;
+
+	pucOut[ 0 ] = FD110A_FRAME_HEAD;
+	pucOut[ 1 ] = ucCmd;
+	pucOut[ 2 ] = FD110A_STATUS_LEN;
+	pucOut[ 3 ] = ucSt;
+	pucOut[ 4 ] = usFreq / 100;
+	pucOut[ 5 ] = usFreq % 100;
+	pucOut[ 6 ] = usVol / 100;
+	pucOut[ 7 ] = usVol % 100;
+	pucOut[ 8 ] = usCur / 100;
+	pucOut[ 9 ] = usCur % 100;
+	for( i = 1; i < 10; i++ )
+	{
+		ucXor ^= pucOut[ i ];
+	}
+	pucOut[ 10 ] = ucXor;
+	return 11;
+}
+
+static void test_mpump( void )
+{
+	MPUMP_PARSER p;
+	MPUMP_EVENT ev;
+	uint8_t ucBuf[ 64 ];
+	unsigned uLen, i;
+	int n;
+
+	mpump_parser_init( &p );
+
+	/* a doubled head and a reply to another command in front */
+	uLen = 0;
+	ucBuf[ uLen++ ] = 0x00;
+	ucBuf[ uLen++ ] = FD110A_FRAME_HEAD;
+	uLen += prvMpumpFrame( ucBuf + uLen, 0x92, 1, 1, 1, 1 );
+	uLen += prvMpumpFrame( ucBuf + uLen, FD110A_STATUS_CMD, 3, 1234, 5678, 910 );
+	for( n = 0, i = 0; i < uLen; i++ )
+	{
+		if( mpump_parse( &p, ucBuf[ i ], &ev ) == PARSE_EVENT )
+		{
+			n++;
+		}
+	}
+	CHECK_EQ( n, 1 );
+	CHECK_EQ( ev.st, 3 );
+	CHECK_EQ( ev.freq, 1234 );
+	CHECK_EQ( ev.vol, 5678 );
+	CHECK_EQ( ev.cur, 910 );
+
+	/* a bad checksum drops the frame, the next one is read */
+	uLen = prvMpumpFrame( ucBuf, FD110A_STATUS_CMD, 1, 100, 200, 300 );
+	ucBuf[ 10 ] ^= 0x40;
+	uLen += prvMpumpFrame( ucBuf + uLen, FD110A_STATUS_CMD, 2, 400, 500, 600 );
+	for( n = 0, i = 0; i < uLen; i++ )
+	{
+		int32_t r = mpump_parse( &p, ucBuf[ i ], &ev );
+
+		if( i == 10 )
+		{
+			CHECK_EQ( r, PARSE_ERROR );
+		}
+		n += r == PARSE_EVENT;
+	}
+	CHECK_EQ( n, 1 );
+	CHECK_EQ( ev.freq, 400 );
+	CHECK_EQ( p.errors, 1 );
+	CHECK_EQ( p.frames, 2 );
+}
+
+/* Frames between random bytes that hold no head: every frame comes out. */
+static void test_mpump_stream( void )
+{
+	MPUMP_PARSER p;
+	MPUMP_EVENT ev;
+	uint8_t ucFrame[ 11 ], ucByte;
+	unsigned uFrame, uNoise, i, uGot = 0, uBad = 0;
+
+	mpump_parser_init( &p );
+	for( uFrame = 0; uFrame < 10000; uFrame++ )
+	{
+		for( uNoise = ulTestRand() % 20; uNoise > 0; uNoise-- )
+		{
+			do
+			{
+				ucByte = ( uint8_t ) ulTestRand();
+			} while( ucByte == FD110A_FRAME_HEAD );
+			mpump_parse( &p, ucByte, &ev );
+		}
+		prvMpumpFrame( ucFrame, FD110A_STATUS_CMD, uFrame & 0xff, uFrame % 10000, 9999 - uFrame % 10000, uFrame % 100 );
+		for( i = 0; i < 11; i++ )
+		{
+			if( mpump_parse( &p, ucFrame[ i ], &ev ) == PARSE_EVENT )
+			{
+				uGot++;
+				uBad += ev.freq != uFrame % 10000 || ev.cur != uFrame % 100;
+			}
+		}
+	}
+	CHECK_EQ( uGot, 10000 );
+	CHECK_EQ( uBad, 0 );
+}
+
+/* Random bytes: no crash, every frame counted as decoded or dropped. */
+static void test_fuzz( void )
+{
+	VMETER_PARSER v;
+	VMETER_EVENT ve;
+	MPUMP_PARSER m;
+	MPUMP_EVENT me;
+	unsigned long ulV = 0, ulM = 0, i;
+	uint8_t ucByte;
+
+	vmeter_parser_init( &v );
+	mpump_parser_init( &m );
+	for( i = 0; i < 1000000; i++ )
+	{
+		/* lean on the head and the digits so frames do happen */
+		ucByte = ( uint8_t ) ulTestRand();
+		if( ( ucByte & 7 ) == 0 )
+		{
+			ucByte = ( ucByte & 8 ) ? VMETER_HEAD : FD110A_FRAME_HEAD;
+		}
+		ulV += vmeter_parse( &v, ucByte, &ve ) != PARSE_NONE;
+		ulM += mpump_parse( &m, ucByte, &me ) != PARSE_NONE;
+		CHECK( v.pos <= VMETER_BODY_LEN );
+		CHECK( m.pos <= FD110A_STATUS_LEN );
+	}
+	CHECK_EQ( ulV, v.frames + v.errors );
+	CHECK_EQ( ulM, m.frames + m.errors );
+	CHECK( v.frames + v.errors > 0 );
+}
+
+int main( void )
+{
+	vTestSeed( 2005 );
+	test_vmeter();
+	test_mpump();
+	test_mpump_stream();
+	test_fuzz();
+	return TEST_RESULT();
+}
@@ -0,0 +1,115 @@
+/*
+ * The sequence-counted register images.  A second thread stands in for the
+ * writing task on the other side of a preemption: every block it commits
+ * holds one value in all registers, a reader must never see two.
+ */
+
+#include <pthread.h>
+#include <string.h>
+
+#include "modbus.h"
+
+#include "test.h"
+
+#define BLOCK		32
+#define READS		200000
+
+static volatile int iDone;
+static volatile ULONG ulCommits;
+
+static void *prvWriter( void *pvArg )
+{
+	USHORT usRegs[ BLOCK ];
+	volatile int iGap;
+	ULONG i;
+
+	( void ) pvArg;
+	while( !iDone )
+	{
+		for( i = 0; i < BLOCK; i++ )
+		{
+			usRegs[ i ] = ( USHORT ) ( ulCommits + 1 );
+		}
+		eMBRegInput_WriteBlock( 0, usRegs, BLOCK );
+		ulCommits++;
+		/* a little time between commits, as the tasks have */
+		for( iGap = 0; iGap < ( int ) ( ulCommits & 63 ); iGap++ )
+		{
+		}
+	}
+	return NULL;
+}
+
+static int prvTorn( const USHORT *pusRegs )
+{
+	int i;
+
+	for( i = 1; i < BLOCK; i++ )
+	{
+		if( pusRegs[ i ] != pusRegs[ 0 ] )
+		{
+			return 1;
+		}
+	}
+	return 0;
+}
+
+static void test_snapshot_under_writes( void )
+{
+	USHORT usRegs[ BLOCK ];
+	UCHAR ucFrame[ BLOCK * 2 ];
+	pthread_t xThread;
+	long lReads, lTorn = 0;
+	int i;
+
+	pthread_create( &xThread, NULL, prvWriter, NULL );
+	for( lReads = 0; lReads < READS; lReads += 2 )
+	{
+		eMBRegInput_ReadBlock( 0, usRegs, BLOCK );
+		lTorn += prvTorn( usRegs );
+
+		CHECK_EQ( eMBRegInputCB( ucFrame, REG_INPUT_START, BLOCK ), MB_ENOERR );
+		for( i = 0; i < BLOCK; i++ )
+		{
+			usRegs[ i ] = ( USHORT ) ( ( ucFrame[ i * 2 ] << 8 ) | ucFrame[ i * 2 + 1 ] );
+		}
+		lTorn += prvTorn( usRegs );
+	}
+	iDone = 1;
+	pthread_join( xThread, NULL );
+
+	printf( "%ld snapshots during %lu commits\n", lReads, ( unsigned long ) ulCommits );
+	CHECK_EQ( lTorn, 0 );
+	CHECK_EQ( eMBRegInput_Read( BLOCK - 1 ), ( USHORT ) ulCommits );
+}
+
+static void test_bounds_and_byte_order( void )
+{
+	UCHAR ucFrame[ 4 ] = { 0x12, 0x34, 0xAB, 0xCD };
+	USHORT usRegs[ 2 ];
+
+	/* 40200 and 40201, no side effect there */
+	CHECK_EQ( eMBRegHoldingCB( ucFrame, REG_HOLDING_START + 199, 2, MB_REG_WRITE ), MB_ENOERR );
+	CHECK_EQ( eMBRegHolding_Read( 199 ), 0x1234 );
+	CHECK_EQ( eMBRegHolding_Read( 200 ), 0xABCD );
+	CHECK( eMBRegHolding_ReadBlock( 199, usRegs, 2 ) );
+	CHECK_EQ( usRegs[ 1 ], 0xABCD );
+
+	memset( ucFrame, 0, sizeof( ucFrame ) );
+	CHECK_EQ( eMBRegHoldingCB( ucFrame, REG_HOLDING_START + 199, 2, MB_REG_READ ), MB_ENOERR );
+	CHECK_EQ( ucFrame[ 0 ], 0x12 );
+	CHECK_EQ( ucFrame[ 3 ], 0xCD );
+
+	CHECK_EQ( eMBRegHoldingCB( ucFrame, REG_HOLDING_START + REG_HOLDING_NREGS - 1, 2, MB_REG_READ ), MB_ENOREG );
+	CHECK_EQ( eMBRegInputCB( ucFrame, 0, 1 ), MB_ENOREG );
+	CHECK( !eMBRegHolding_WriteBlock( REG_HOLDING_NREGS - 1, usRegs, 2 ) );
+	CHECK( !eMBRegInput_ReadBlock( REG_INPUT_NREGS, usRegs, 1 ) );
+	CHECK_EQ( eMBRegInput_Read( REG_INPUT_NREGS ), 0 );
+}
+
+int main( void )
+{
+	test_snapshot_under_writes();
+	test_bounds_and_byte_order();
+	return TEST_RESULT();
+}
@@ -0,0 +1,471 @@
+/*
+ * The run length glyphs of fontdata.h and LCD_DrawChar() on the panel
+ * model.  Every EN glyph decodes to its bitmap in ascii*.h and draws as
+ * it, in colors whose two bytes are the same and in ones where they are
+ * not.  Random glyphs encoded the way makefont does cover what the fonts
+ * may not: runs of 15 and more, a run the width of the glyph, repeats of
+ * more than 16 rows and every width up to LCD_BURST_CHUNK.  The bench
+ * prints glyphs a second against drawing the bitmaps a row at a time with
+ * LCD_SetCursor() and LCD_WriteRAMBurst(), as before, and the flash the
+ * fonts take either way.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "stm32f10x.h"
+#include "fonts.h"
+#include "lcd.h"
+
+#include "host.h"
+#include "test.h"
+#include "lcd_model.h"
+
+#define GLYPHS				95
+#define MAX_W				32
+#define MAX_H				48
+#define BPR( w )			( ( ( w ) + 7 ) >> 3 )
+#define BIT( p, w, x, y )	( ( ( p )[ ( y ) * BPR( w ) + ( x ) / 8 ] >> ( 7 - ( x ) % 8 ) ) & 1 )
+#define X0					100
+#define Y0					100
+
+/* lcd.c */
+void LCD_DrawChar( const uint8_t *rle, uint16_t width, uint16_t height );
+void prvConfigureLCD( void );
+
+/* ascii.c and gb32.c, makefont's input */
+struct typFNT_GB32
+{
+	signed char Index[ 2 ];
+	char Msk[ 128 ];
+};
+
+extern const unsigned char *const pucAscii[ 4 ];
+extern const unsigned uAsciiSize[ 4 ];
+extern const struct typFNT_GB32 *const pxGB_32;
+extern const unsigned uGB_32Entries;
+
+static sFONT *const pxEn[ 4 ] = { &EN_Font8x16, &EN_Font10x20, &EN_Font12x24, &EN_Font16x32 };
+
+/* What the decoder met. */
+static struct
+{
+	unsigned long ulRepeats, ulLongRepeats, ulLongRuns, ulFullRuns, ulRows;
+} xSeen;
+
+/* The codes of a glyph, as makefont's rle(). */
+static unsigned prvEncode( const uint8_t *pucMask, unsigned w, unsigned h, uint8_t *pucOut )
+{
+	static uint8_t ucCode[ 4096 ];
+	const uint8_t *pucPrev = NULL, *pucRow;
+	unsigned n = 0, x, y, uRepeat = 0, uRun, i;
+	int iColor, iPixel;
+
+	for( y = 0; y < h; y++ )
+	{
+		pucRow = pucMask + y * BPR( w );
+		if( pucPrev != NULL && memcmp( pucRow, pucPrev, BPR( w ) ) == 0 )
+		{
+			if( ++uRepeat == 16 )
+			{
+				ucCode[ n++ ] = 0;
+				ucCode[ n++ ] = 0;
+				ucCode[ n++ ] = 15;
+				uRepeat = 0;
+			}
+			continue;
+		}
+		if( uRepeat )
+		{
+			ucCode[ n++ ] = 0;
+			ucCode[ n++ ] = 0;
+			ucCode[ n++ ] = ( uint8_t ) ( uRepeat - 1 );
+			uRepeat = 0;
+		}
+		uRun = 0;
+		iColor = 0;
+		for( x = 0; x <= w; x++ )
+		{
+			iPixel = x < w ? BIT( pucMask, w, x, y ) : -1;
+			if( iPixel == iColor )
+			{
+				uRun++;
+				continue;
+			}
+			for( ; uRun >= 15; uRun -= 15 )
+			{
+				ucCode[ n++ ] = 15;
+			}
+			ucCode[ n++ ] = ( uint8_t ) uRun;
+			uRun = 1;
+			iColor ^= 1;
+		}
+		pucPrev = pucRow;
+	}
+	if( uRepeat )
+	{
+		ucCode[ n++ ] = 0;
+		ucCode[ n++ ] = 0;
+		ucCode[ n++ ] = ( uint8_t ) ( uRepeat - 1 );
+	}
+	if( n & 1 )
+	{
+		ucCode[ n++ ] = 0;
+	}
+	for( i = 0; i < n / 2; i++ )
+	{
+		pucOut[ i ] = ( uint8_t ) ( ucCode[ 2 * i ] << 4 | ucCode[ 2 * i + 1 ] );
+	}
+	return n / 2;
+}
+
+static unsigned prvCode( const uint8_t *pucRle, unsigned *puNibble )
+{
+	unsigned uCode = ( pucRle[ *puNibble / 2 ] >> ( *puNibble & 1 ? 0 : 4 ) ) & 15;
+
+	( *puNibble )++;
+	return uCode;
+}
+
+static unsigned prvRun( const uint8_t *pucRle, unsigned *puNibble )
+{
+	unsigned uRun = 0, uCode;
+
+	do
+	{
+		uCode = prvCode( pucRle, puNibble );
+		uRun += uCode;
+	} while( uCode == 15 );
+	if( uRun >= 15 )
+	{
+		xSeen.ulLongRuns++;
+	}
+	return uRun;
+}
+
+/* A glyph back to its bitmap, from the format as makefont describes it;
+   the bytes it takes. */
+static unsigned prvDecode( const uint8_t *pucRle, unsigned w, unsigned h, uint8_t *pucMask )
+{
+	unsigned uNibble = 0, y = 0, x, uRun, uRepeat, i;
+	int iColor;
+
+	memset( pucMask, 0, BPR( w ) * h );
+	while( y < h )
+	{
+		const unsigned uStart = uNibble;
+
+		if( prvCode( pucRle, &uNibble ) == 0 && prvCode( pucRle, &uNibble ) == 0 )
+		{
+			uRepeat = prvCode( pucRle, &uNibble ) + 1;
+			xSeen.ulRepeats++;
+			xSeen.ulLongRepeats += uRepeat == 16;
+			for( i = 0; i < uRepeat && y < h; i++, y++ )
+			{
+				CHECK( y > 0 );
+				if( y > 0 )
+				{
+					memcpy( pucMask + y * BPR( w ), pucMask + ( y - 1 ) * BPR( w ), BPR( w ) );
+				}
+			}
+			continue;
+		}
+		uNibble = uStart;
+		for( x = 0, iColor = 0; x < w; x += uRun, iColor ^= 1 )
+		{
+			uRun = prvRun( pucRle, &uNibble );
+			CHECK( x + uRun <= w );
+			xSeen.ulFullRuns += uRun == w;
+			for( i = x; i < x + uRun && i < w; i++ )
+			{
+				pucMask[ y * BPR( w ) + i / 8 ] |= ( uint8_t ) ( iColor << ( 7 - i % 8 ) );
+			}
+		}
+		xSeen.ulRows++;
+		y++;
+	}
+	return ( uNibble + 1 ) / 2;
+}
+
+/* The glyph drawn at X0, Y0 is the bitmap, in text and background. */
+static unsigned long prvDrawnOff( const uint8_t *pucMask, unsigned w, unsigned h, uint16_t usText, uint16_t usBack )
+{
+	unsigned long ulOff = 0;
+	unsigned x, y;
+
+	for( y = 0; y < h; y++ )
+	{
+		for( x = 0; x < w; x++ )
+		{
+			ulOff += xLcd.usPage[ 0 ][ Y0 + 1 + y ][ X0 + x ] != ( BIT( pucMask, w, x, y ) ? usText : usBack );
+		}
+	}
+	return ulOff;
+}
+
+/* The old LCD_DrawChar(): each row a cursor move and a burst of the
+   colors. */
+static void prvBitmapChar( const uint8_t *pucMask, unsigned w, unsigned h, uint16_t usText, uint16_t usBack )
+{
+	uint16_t usRow[ MAX_W ];
+	uint16_t x0 = LCD_GetCursorX(), y0 = LCD_GetCursorY();
+	unsigned x, y;
+
+	for( y = 0; y < h; y++ )
+	{
+		for( x = 0; x < w; x++ )
+		{
+			usRow[ x ] = BIT( pucMask, w, x, y ) ? usText : usBack;
+		}
+		LCD_SetCursor( x0, ( uint16_t ) ( y0 + 1 + y ) );
+		LCD_WriteRAMBurst( usRow, w );
+	}
+	LCD_SetCursor( ( uint16_t ) ( x0 + w ), y0 );
+}
+
+static void prvStart( void )
+{
+	vHostReset();
+	vLcdModelReset( 0xAAAA );
+	prvConfigureLCD();
+	vLcdModelCount();
+}
+
+/* Every EN glyph is its ascii*.h bitmap, decoded and drawn. */
+static void test_fonts( void )
+{
+	static const uint16_t usColors[][ 2 ] = { { White, Black }, { Orange, 0x1234 } };
+	uint8_t ucMask[ MAX_W / 8 * MAX_H ];
+	unsigned f, g, c, uSize;
+	unsigned long ulBad = 0, ulDrawn = 0;
+	const uint8_t *pucBitmap;
+	sFONT *pxFont;
+
+	prvStart();
+	for( f = 0; f < 4; f++ )
+	{
+		pxFont = pxEn[ f ];
+		uSize = BPR( pxFont->Width ) * pxFont->Height;
+		CHECK( uAsciiSize[ f ] >= GLYPHS * uSize );
+		LCD_SetFont_EN( pxFont );
+		for( g = 0; g < GLYPHS; g++ )
+		{
+			pucBitmap = pucAscii[ f ] + g * uSize;
+			prvDecode( &pxFont->table[ pxFont->offset[ g ] ], pxFont->Width, pxFont->Height, ucMask );
+			ulBad += memcmp( ucMask, pucBitmap, uSize ) != 0;
+			for( c = 0; c < 2; c++ )
+			{
+				LCD_SetTextColor( usColors[ c ][ 0 ] );
+				LCD_SetBackColor( usColors[ c ][ 1 ] );
+				LCD_SetCursor( X0, Y0 );
+				LCD_DisplayAscii( ( int8_t ) ( ' ' + g ) );
+				ulDrawn += prvDrawnOff( pucBitmap, pxFont->Width, pxFont->Height, usColors[ c ][ 0 ],
+										usColors[ c ][ 1 ] ) != 0;
+				CHECK_EQ( LCD_GetCursorX(), X0 + pxFont->Width );
+				CHECK_EQ( LCD_GetCursorY(), Y0 );
+			}
+		}
+	}
+	CHECK_EQ( ulBad, 0 );
+	CHECK_EQ( ulDrawn, 0 );
+	CHECK_EQ( xLcd.ulErrors + xLcd.ulOutside + xLcd.ulOffPanel, 0 );
+	printf( "fonts: %lu rows, %lu repeats (%lu of 16 rows), %lu runs of 15 or more, %lu runs the width\n", xSeen.ulRows,
+			xSeen.ulRepeats, xSeen.ulLongRepeats, xSeen.ulLongRuns, xSeen.ulFullRuns );
+}
+
+/* Random glyphs made of repeated rows, solid rows and long runs. */
+static void test_random( void )
+{
+	uint8_t ucMask[ MAX_W / 8 * MAX_H ], ucBack[ MAX_W / 8 * MAX_H ], ucRle[ 2048 ];
+	unsigned long ulBad = 0, ulDrawn = 0;
+	unsigned n, w, h, x, y, uLen;
+
+	memset( &xSeen, 0, sizeof( xSeen ) );
+	vTestSeed( 24 );
+	prvStart();
+	LCD_SetTextColor( Green );
+	LCD_SetBackColor( Black );
+	for( n = 0; n < 3000; n++ )
+	{
+		w = n % 32 + 1;
+		h = ulTestRand() % MAX_H + 1;
+		memset( ucMask, 0, sizeof( ucMask ) );
+		/* every fourth glyph mostly the same row, for repeats of 16 */
+		for( y = 0; y < h; y++ )
+		{
+			if( y > 0 && ulTestRand() % 100 < ( n % 4 == 0 ? 95u : 33u ) )
+			{
+				memcpy( ucMask + y * BPR( w ), ucMask + ( y - 1 ) * BPR( w ), BPR( w ) );
+				continue;
+			}
+			switch( ulTestRand() % 4 )
+			{
+				case 0:
+					/* a run from a random place to the end */
+					for( x = ulTestRand() % w; x < w; x++ )
+					{
+						ucMask[ y * BPR( w ) + x / 8 ] |= ( uint8_t ) ( 0x80 >> ( x % 8 ) );
+					}
+					break;
+				case 1:
+					break;
+				default:
+					for( x = 0; x < w; x++ )
+					{
+						ucMask[ y * BPR( w ) + x / 8 ] |= ( uint8_t ) ( ( ulTestRand() & 1 ) << ( 7 - x % 8 ) );
+					}
+					break;
+			}
+		}
+		uLen = prvEncode( ucMask, w, h, ucRle );
+		CHECK_EQ( prvDecode( ucRle, w, h, ucBack ), uLen );
+		ulBad += memcmp( ucMask, ucBack, BPR( w ) * h ) != 0;
+
+		LCD_SetCursor( X0, Y0 );
+		LCD_DrawChar( ucRle, ( uint16_t ) w, ( uint16_t ) h );
+		ulDrawn += prvDrawnOff( ucMask, w, h, Green, Black ) != 0;
+	}
+	CHECK_EQ( ulBad, 0 );
+	CHECK_EQ( ulDrawn, 0 );
+	CHECK( xSeen.ulLongRepeats > 0 && xSeen.ulLongRuns > 0 && xSeen.ulFullRuns > 0 );
+	CHECK_EQ( xLcd.ulErrors + xLcd.ulOutside + xLcd.ulOffPanel, 0 );
+}
+
+/* Lines of glyphs drawn both ways, the same pixels; glyphs a second. */
+static void prvBench( const char *pcName, sFONT *pxFont, const uint8_t *const *ppucMasks, const uint16_t *pusGlyphs,
+					  unsigned uCount, uint16_t usBack )
+{
+	static uint16_t usBitmap[ LCD_MODEL_HEIGHT ][ LCD_MODEL_WIDTH ];
+	const unsigned w = pxFont->Width, h = pxFont->Height, uPerLine = LCD_SCR_WIDTH / w, uLines = 8;
+	unsigned long ulNs[ 2 ], ulSections[ 2 ];
+	unsigned m, i, l;
+
+	prvStart();
+	for( m = 0; m < 2; m++ )
+	{
+		LCD_SetTextColor( White );
+		LCD_SetBackColor( usBack );
+		vLcdModelCount();
+		for( l = 0; l < uLines; l++ )
+		{
+			LCD_SetCursor( 0, ( uint16_t ) ( l * h ) );
+			for( i = 0; i < uPerLine; i++ )
+			{
+				const unsigned g = ( l * uPerLine + i ) % uCount;
+
+				if( m == 0 )
+				{
+					prvBitmapChar( ppucMasks[ g ], w, h, White, usBack );
+				}
+				else
+				{
+					LCD_DrawChar( &pxFont->table[ pxFont->offset[ pusGlyphs[ g ] ] ], ( uint16_t ) w, ( uint16_t ) h );
+				}
+			}
+		}
+		ulNs[ m ] = ulLcdModelNs();
+		ulSections[ m ] = xLcd.ulSections;
+		CHECK_EQ( xLcd.ulErrors + xLcd.ulOutside + xLcd.ulOffPanel, 0 );
+		if( m == 0 )
+		{
+			memcpy( usBitmap, xLcd.usPage[ 0 ], sizeof( usBitmap ) );
+			vLcdModelReset( 0xAAAA );
+			prvConfigureLCD();
+		}
+	}
+	CHECK( memcmp( usBitmap, xLcd.usPage[ 0 ], sizeof( usBitmap ) ) == 0 );
+	CHECK( ulNs[ 1 ] < ulNs[ 0 ] );
+	printf( "%-22s bitmap+burst %6.0f glyph/s, %3lu sections; runs %6.0f glyph/s, %3lu sections\n", pcName,
+			1e9 * uPerLine * uLines / ulNs[ 0 ], ulSections[ 0 ] / ( uPerLine * uLines ),
+			1e9 * uPerLine * uLines / ulNs[ 1 ], ulSections[ 1 ] / ( uPerLine * uLines ) );
+}
+
+static void test_bench( void )
+{
+	const uint8_t *pucMasks[ 256 ];
+	uint16_t usGlyphs[ 256 ];
+	unsigned f, i, n;
+
+	/* digits */
+	for( f = 0; f < 4; f += 3 )
+	{
+		const unsigned uSize = BPR( pxEn[ f ]->Width ) * pxEn[ f ]->Height;
+
+		for( i = 0; i < 10; i++ )
+		{
+			usGlyphs[ i ] = ( uint16_t ) ( '0' - ' ' + i );
+			pucMasks[ i ] = pucAscii[ f ] + usGlyphs[ i ] * uSize;
+		}
+		prvBench( f == 0 ? "8x16 digits, black" : "16x32 digits, black", pxEn[ f ], pucMasks, usGlyphs, 10, Black );
+		if( f == 3 )
+		{
+			prvBench( "16x32 digits, 0x1234", pxEn[ f ], pucMasks, usGlyphs, 10, 0x1234 );
+		}
+	}
+
+	/* the CJK characters of the screens */
+	for( i = n = 0; i < CH_Font32x32.count; i++ )
+	{
+		const uint16_t usCode = CH_Font32x32.index[ i ].Code;
+		unsigned k;
+
+		for( k = 0; k < uGB_32Entries; k++ )
+		{
+			if( ( ( uint8_t ) pxGB_32[ k ].Index[ 0 ] << 8 | ( uint8_t ) pxGB_32[ k ].Index[ 1 ] ) == usCode )
+			{
+				pucMasks[ n ] = ( const uint8_t * ) pxGB_32[ k ].Msk;
+				usGlyphs[ n++ ] = CH_Font32x32.index[ i ].Glyph;
+				break;
+			}
+		}
+	}
+	CHECK_EQ( n, CH_Font32x32.count );
+	prvBench( "32x32 CJK, black", &CH_Font32x32, pucMasks, usGlyphs, n, Black );
+}
+
+/* The bytes of a font's runs, offsets and index against its bitmaps. */
+static void prvSize( const char *pcName, sFONT *pxFont, unsigned uGlyphs, unsigned long ulBitmaps )
+{
+	uint8_t ucMask[ MAX_W / 8 * MAX_H ];
+	unsigned long ulRle = 0;
+	unsigned g;
+
+	for( g = 0; g < uGlyphs; g++ )
+	{
+		const unsigned uLen = prvDecode( &pxFont->table[ pxFont->offset[ g ] ], pxFont->Width, pxFont->Height, ucMask );
+
+		/* the glyphs follow each other */
+		CHECK( g + 1 == uGlyphs || pxFont->offset[ g ] + uLen == pxFont->offset[ g + 1 ] );
+		ulRle = pxFont->offset[ g ] + uLen;
+	}
+	ulRle += 2 * uGlyphs + sizeof( sHZINDEX ) * pxFont->count;
+	printf( "%-10s %5lu bytes as bitmaps, %5lu as runs\n", pcName, ulBitmaps, ulRle );
+}
+
+static void test_size( void )
+{
+	static const char *const pcNames[ 4 ] = { "8x16", "10x20", "12x24", "16x32" };
+	unsigned f, i, uGlyphs = 0;
+
+	for( f = 0; f < 4; f++ )
+	{
+		prvSize( pcNames[ f ], pxEn[ f ], GLYPHS, GLYPHS * BPR( pxEn[ f ]->Width ) * pxEn[ f ]->Height );
+	}
+	for( i = 0; i < CH_Font32x32.count; i++ )
+	{
+		uGlyphs = CH_Font32x32.index[ i ].Glyph + 1u > uGlyphs ? CH_Font32x32.index[ i ].Glyph + 1u : uGlyphs;
+	}
+	prvSize( "GB 32x32", &CH_Font32x32, uGlyphs, uGB_32Entries * sizeof( pxGB_32[ 0 ] ) );
+}
+
+int main( void )
+{
+	test_fonts();
+	test_random();
+	test_bench();
+	test_size();
+	return TEST_RESULT();
+}
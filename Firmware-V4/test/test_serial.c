@@ -0,0 +1,183 @@
+/*
+ * driver/serial.c against a modelled line: COM2 through the DMA rings,
+ * COM3 through RXNE/TXE.  Bytes must arrive whole and in order, and the
+ * reader must be woken per burst, not per byte.
+ */
+
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "stm32f10x.h"
+#include "serials.h"
+
+#include "host.h"
+#include "test.h"
+#include "uart_model.h"
+
+#define RX_BYTES	20000
+
+static xUartModel xUart;
+static xComPortHandle xPort;
+static uint8_t ucSent[ RX_BYTES ], ucGot[ RX_BYTES ];
+static unsigned uGot;
+static unsigned long ulWakes;
+
+static void prvTick( void )
+{
+	vUartModelTick( &xUart );
+}
+
+static void prvReader( void *pvParameters )
+{
+	portBASE_TYPE xLen;
+
+	( void ) pvParameters;
+	for( ;; )
+	{
+		xLen = xSerialGet( xPort, ucGot + uGot, RX_BYTES - uGot > 64 ? 64 : RX_BYTES - uGot, 50 );
+		uGot += xLen;
+		ulWakes++;
+		if( uGot == RX_BYTES )
+		{
+			vTaskDelay( portMAX_DELAY );
+		}
+	}
+}
+
+/* Random bursts at 115200 with pauses, the ring is 256 bytes. */
+static void test_rx( eCOMPort ePort )
+{
+	unsigned uPos, uLen, i;
+
+	vHostReset();
+	vHostPeriphReset();
+	xPort = xSerialPortInit( ePort, ser115200, serNO_PARITY, serBITS_8, serSTOP_1, 256 );
+	CHECK( xPort != NULL );
+	vUartModelInit( &xUart, ePort, 115200 );
+	vHostAddTickHook( prvTick );
+	xTaskCreate( prvReader, ( signed char * ) "rx", 256, NULL, 2, NULL );
+
+	uGot = 0;
+	ulWakes = 0;
+	for( i = 0; i < RX_BYTES; i++ )
+	{
+		ucSent[ i ] = ( uint8_t ) ulTestRand();
+	}
+	for( uPos = 0; uPos < RX_BYTES; uPos += uLen )
+	{
+		uLen = 1 + ulTestRand() % 300;
+		if( uLen > RX_BYTES - uPos )
+		{
+			uLen = RX_BYTES - uPos;
+		}
+		vUartModelSend( &xUart, ucSent + uPos, uLen );
+		vHostRun( uLen / 11 + 1 + ulTestRand() % 20 );
+	}
+	vHostRun( 100 );
+
+	CHECK_EQ( uGot, RX_BYTES );
+	CHECK( memcmp( ucSent, ucGot, RX_BYTES ) == 0 );
+	CHECK_EQ( xPort->ulRxCount, RX_BYTES );
+	printf( "COM%d rx: %lu bytes, %lu interrupts, %lu reads\n", ePort + 1, xUart.ulRxBytes, xUart.ulIrqs, ulWakes );
+	if( ePort == serCOM2 )
+	{
+		/* a wake per half ring or idle line, the byte queue took one per byte */
+		CHECK( xUart.ulIrqs * 16 < RX_BYTES );
+	}
+}
+
+static uint8_t ucPeerGot[ 8192 ];
+static unsigned uPeerGot, uPeerFrames;
+
+static void prvPeer( xUartModel *pxUart, const uint8_t *pucFrame, unsigned uLen )
+{
+	( void ) pxUart;
+	if( uPeerGot + uLen <= sizeof( ucPeerGot ) )
+	{
+		memcpy( ucPeerGot + uPeerGot, pucFrame, uLen );
+	}
+	uPeerGot += uLen;
+	uPeerFrames++;
+}
+
+static void prvWriter( void *pvParameters )
+{
+	unsigned i;
+
+	( void ) pvParameters;
+	for( i = 0; i < 40; i++ )
+	{
+		vSerialPut( xPort, ucSent + i * 150, 150 );
+		vTaskDelay( 20 );
+	}
+	vTaskDelay( portMAX_DELAY );
+}
+
+/* 150 byte frames through a 256 byte ring, every other one wraps. */
+static void test_tx( eCOMPort ePort )
+{
+	vHostReset();
+	vHostPeriphReset();
+	xPort = xSerialPortInit( ePort, ser115200, serNO_PARITY, serBITS_8, serSTOP_1, 256 );
+	vUartModelInit( &xUart, ePort, 115200 );
+	xUart.pxPeer = prvPeer;
+	uPeerGot = uPeerFrames = 0;
+	vHostAddTickHook( prvTick );
+	xTaskCreate( prvWriter, ( signed char * ) "tx", 256, NULL, 2, NULL );
+	vHostRun( 1000 );
+
+	CHECK_EQ( uPeerGot, 40 * 150 );
+	CHECK_EQ( uPeerFrames, 40 );
+	CHECK( memcmp( ucSent, ucPeerGot, 40 * 150 ) == 0 );
+	CHECK_EQ( xPort->ulTxCount, 40 * 150 );
+	CHECK_EQ( xPort->usTxSpan, 0 );
+	printf( "COM%d tx: %lu bytes, %lu interrupts\n", ePort + 1, xUart.ulTxBytes, xUart.ulIrqs );
+}
+
+static void prvSpanReader( void *pvParameters )
+{
+	const unsigned portCHAR *pucData;
+	unsigned portSHORT usLen;
+
+	( void ) pvParameters;
+	for( ;; )
+	{
+		usLen = xSerialReadSpan( xPort, &pucData, 50 );
+		if( usLen > 0 )
+		{
+			memcpy( ucGot + uGot, pucData, usLen );
+			uGot += usLen;
+			vSerialReadSpanDone( xPort, usLen );
+		}
+	}
+}
+
+/* The zero copy reader sees the wrap as two spans. */
+static void test_read_span( void )
+{
+	vHostReset();
+	vHostPeriphReset();
+	xPort = xSerialPortInit( serCOM2, ser115200, serNO_PARITY, serBITS_8, serSTOP_1, 256 );
+	vUartModelInit( &xUart, serCOM2, 115200 );
+	vHostAddTickHook( prvTick );
+	uGot = 0;
+	xTaskCreate( prvSpanReader, ( signed char * ) "span", 256, NULL, 2, NULL );
+	vUartModelSend( &xUart, ucSent, 1000 );
+	vHostRun( 200 );
+	CHECK_EQ( uGot, 1000 );
+	CHECK( memcmp( ucSent, ucGot, 1000 ) == 0 );
+	CHECK( !xSerialIsArrive( xPort ) );
+}
+
+int main( void )
+{
+	vTestSeed( 2004 );
+	test_rx( serCOM2 );
+	test_rx( serCOM3 );
+	test_tx( serCOM2 );
+	test_tx( serCOM3 );
+	test_read_span();
+	return TEST_RESULT();
+}
@@ -0,0 +1,221 @@
+/*
+ * TCP throughput of the uIP task against a client with delayed ACK, on the
+ * ENC28J60 model.  uIP keeps one segment unacknowledged, so a client that
+ * ACKs every second segment at once and a lone one after a timeout holds
+ * each whole segment for that timeout; uIP_Task.c splits the larger ones
+ * in two to draw the ACK at once.  test_split is the firmware as built,
+ * test_split_whole the same with uipSPLIT_MIN_DATA raised so every segment
+ * goes whole, for the comparison.  Both must deliver the same bytes, also
+ * when a segment is lost and uIP sends it again.
+ *
+ * The 20 KB response is a Modbus/TCP poll cycle: 80 reads of 125 holding
+ * registers, asked for in batches of 20.  Time is simulated, a frame
+ * through the controller costs a tick.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "mb.h"
+#include "modbus.h"
+#include "netbuf.h"
+#include "httpd-fs.h"
+
+#include "host.h"
+#include "test.h"
+#include "net_peer.h"
+
+#ifdef uipSPLIT_MIN_DATA
+	#define SPLIT			0
+	#define VARIANT			"whole"
+#else
+	#define SPLIT			1
+	#define VARIANT			"split"
+#endif
+
+#define MB_PORT				502
+#define READS				80
+#define BATCH				20
+#define REGS				125
+#define ANSWER				( 9 + REGS * 2 )
+
+static uint8_t ucRx[ READS * ANSWER + 2048 ];
+
+static USHORT usHolding( unsigned uAddr )
+{
+	return ( USHORT ) ( uAddr * 3 + 1 );
+}
+
+static void prvSetImage( void )
+{
+	USHORT usRegs[ REGS ];
+	unsigned i;
+
+	for( i = 0; i < REGS; i++ )
+	{
+		usRegs[ i ] = usHolding( i );
+	}
+	eMBRegHolding_WriteBlock( 0, usRegs, REGS );
+}
+
+/* The answers in ucRx, in transaction order; 1 when all are right. */
+static int prvCheckAnswers( void )
+{
+	const uint8_t *pucAns;
+	unsigned n, i;
+
+	for( n = 0; n < READS; n++ )
+	{
+		pucAns = ucRx + n * ANSWER;
+		if( ( ( pucAns[ 0 ] << 8 ) | pucAns[ 1 ] ) != n || ( ( pucAns[ 4 ] << 8 ) | pucAns[ 5 ] ) != ANSWER - 6 ||
+			pucAns[ 7 ] != MB_FUNC_READ_HOLDING_REGISTER || pucAns[ 8 ] != REGS * 2 )
+		{
+			return 0;
+		}
+		for( i = 0; i < REGS; i++ )
+		{
+			if( ( ( pucAns[ 9 + i * 2 ] << 8 ) | pucAns[ 10 + i * 2 ] ) != usHolding( i ) )
+			{
+				return 0;
+			}
+		}
+	}
+	return 1;
+}
+
+/* The poll cycle against a client that delays its ACK by xAckDelay, losing
+ * data segment ulLose; the ticks it took, 0 when it did not complete. */
+static portTickType prvPollCycle( portTickType xAckDelay, unsigned long ulLose )
+{
+	uint8_t ucReq[ BATCH * 12 ];
+	xPeerTcp xConn = { 0 };
+	portTickType xStart, xTicks;
+	unsigned n, b;
+
+	xConn.xAckDelay = xAckDelay;
+	xConn.ulLose = ulLose;
+	xConn.pucRx = ucRx;
+	xConn.uRxMax = sizeof( ucRx );
+	memset( ucRx, 0, sizeof( ucRx ) );
+	if( !iPeerConnect( &xConn, MB_PORT ) )
+	{
+		return 0;
+	}
+	xStart = xTaskGetTickCount();
+	for( b = 0; b < READS; b += BATCH )
+	{
+		for( n = 0; n < BATCH; n++ )
+		{
+			const uint8_t ucOne[ 12 ] = { ( uint8_t ) ( ( b + n ) >> 8 ), ( uint8_t ) ( b + n ), 0, 0, 0, 6, 1,
+										  MB_FUNC_READ_HOLDING_REGISTER, 0, 0, 0, REGS };
+
+			memcpy( ucReq + n * 12, ucOne, 12 );
+		}
+		vPeerTcpSend( &xConn, ucReq, sizeof( ucReq ) );
+		while( xConn.ulRxBytes < ( b + BATCH ) * ( unsigned long ) ANSWER && xConn.iState == PEER_OPEN &&
+			   xTaskGetTickCount() - xStart < 60000 )
+		{
+			vHostRun( 1 );
+		}
+	}
+	xTicks = xConn.xLast - xStart + 1;
+	CHECK_EQ( xConn.ulRxBytes, READS * ( unsigned long ) ANSWER );
+	vPeerTcpAbort( &xConn );
+	return xConn.ulRxBytes == READS * ( unsigned long ) ANSWER ? xTicks : 0;
+}
+
+/* The 20 KB cycle with and without delayed ACK, and a lost segment. */
+static void test_modbus( void )
+{
+	static const portTickType xDelay[] = { 0, 40, 200 };
+	portTickType xTicks[ 3 ];
+	unsigned long ulSplit;
+	unsigned i;
+
+	vPeerStart();
+	prvSetImage();
+	for( i = 0; i < 3; i++ )
+	{
+		ulSplit = xNetStats.ulTxSplit;
+		xTicks[ i ] = prvPollCycle( xDelay[ i ], 0 );
+		CHECK( xTicks[ i ] > 0 );
+		CHECK( prvCheckAnswers() );
+		CHECK( SPLIT ? xNetStats.ulTxSplit > ulSplit : xNetStats.ulTxSplit == ulSplit );
+		if( xTicks[ i ] > 0 )
+		{
+			printf( "%s, %lu byte Modbus/TCP cycle, delayed ACK %3lu ms: %5lu ms, %4lu KB/s\n", VARIANT,
+					READS * ( unsigned long ) ANSWER, ( unsigned long ) xDelay[ i ], ( unsigned long ) xTicks[ i ],
+					READS * ( unsigned long ) ANSWER * 1000UL / 1024UL / ( unsigned long ) xTicks[ i ] );
+		}
+	}
+	if( SPLIT )
+	{
+		/* the delay costs next to nothing */
+		CHECK( xTicks[ 2 ] < xTicks[ 0 ] * 2 );
+	}
+	else
+	{
+		/* every lone segment waits it out */
+		CHECK( xTicks[ 2 ] > xTicks[ 0 ] * 10 );
+	}
+
+	/* a lost half, and a lost segment in the middle of a batch */
+	CHECK( prvPollCycle( 200, 1 ) > 0 );
+	CHECK( prvCheckAnswers() );
+	CHECK( prvPollCycle( 0, 7 ) > 0 );
+	CHECK( prvCheckAnswers() );
+	CHECK_EQ( xPeer.ulBadFrames, 0 );
+}
+
+/* A static page over a small MSS, every segment lost once in turn: the
+ * body is the stored one every time. */
+static void test_page( void )
+{
+	static const char cGet[] = "GET /index.html HTTP/1.0\r\n\r\n";
+	struct httpd_fs_file xFile;
+	xPeerTcp xConn;
+	unsigned long ulLose, ulSegments = 0;
+	const uint8_t *pucBody;
+
+	vPeerStart();
+	CHECK( httpd_fs_open( "/index.html", &xFile ) );
+	for( ulLose = 0; ulLose <= ulSegments; ulLose++ )
+	{
+		memset( &xConn, 0, sizeof( xConn ) );
+		xConn.usMss = 128;
+		xConn.xAckDelay = 200;
+		xConn.ulLose = ulLose;
+		xConn.pucRx = ucRx;
+		xConn.uRxMax = sizeof( ucRx ) - 1;
+		CHECK( iPeerConnect( &xConn, 80 ) );
+		vPeerTcpSend( &xConn, cGet, sizeof( cGet ) - 1 );
+		CHECK( iPeerTcpWait( &xConn, 10000 ) );
+		vPeerTcpAbort( &xConn );
+		if( ulLose == 0 )
+		{
+			ulSegments = xConn.ulSegments;
+			CHECK( ulSegments > 3 );
+		}
+		ucRx[ xConn.ulRxBytes < sizeof( ucRx ) ? xConn.ulRxBytes : sizeof( ucRx ) - 1 ] = 0;
+		pucBody = ( const uint8_t * ) strstr( ( const char * ) ucRx, "\r\n\r\n" );
+		CHECK( pucBody != NULL );
+		if( pucBody != NULL )
+		{
+			pucBody += 4;
+			CHECK_EQ( xConn.ulRxBytes - ( unsigned long ) ( pucBody - ucRx ), ( unsigned long ) xFile.len );
+			CHECK( memcmp( pucBody, xFile.data, xFile.len ) == 0 );
+		}
+	}
+	CHECK_EQ( xPeer.ulBadFrames, 0 );
+}
+
+int main( void )
+{
+	test_modbus();
+	test_page();
+	return TEST_RESULT();
+}
@@ -0,0 +1,346 @@
+/*
+ * Modbus/UDP and the discovery responder of webserver/udpd.c, on the uIP
+ * task and the ENC28J60 model.  Every datagram gets its answer back at the
+ * port it came from, with the register image's values, however many
+ * senders interleave; discovery answers a broadcast with the unit's
+ * address and state, and broadcasts the answer to a sender that is not on
+ * our subnet.  The benchmark polls the same registers over UDP, over one
+ * Modbus/TCP connection and with a connection per poll, in simulated time
+ * where a frame through the controller costs a tick.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "mb.h"
+#include "mb_reg_map.h"
+#include "modbus.h"
+#include "udpd.h"
+
+#include "host.h"
+#include "test.h"
+#include "net_peer.h"
+
+#define MB_PORT				502
+#define READ_ADDR			MB_VOL_SET_L_ST
+#define READ_COUNT			10
+#define SENDERS				24
+
+static USHORT usInput( unsigned uAddr )
+{
+	return ( USHORT ) ( uAddr * 7 + 3 );
+}
+
+static void prvSetImage( void )
+{
+	unsigned i;
+
+	for( i = 0; i < READ_COUNT; i++ )
+	{
+		eMBRegInput_Write( READ_ADDR + i, usInput( READ_ADDR + i ) );
+	}
+}
+
+/* An MBAP framed request for uCount registers at uAddr, its length. */
+static unsigned prvRequest( uint8_t *pucReq, unsigned uTid, uint8_t ucFunc, unsigned uAddr, unsigned uCount )
+{
+	const uint8_t ucReq[ 12 ] = { ( uint8_t ) ( uTid >> 8 ), ( uint8_t ) uTid, 0, 0, 0, 6, 1, ucFunc,
+								  ( uint8_t ) ( uAddr >> 8 ), ( uint8_t ) uAddr,
+								  ( uint8_t ) ( uCount >> 8 ), ( uint8_t ) uCount };
+
+	memcpy( pucReq, ucReq, sizeof( ucReq ) );
+	return sizeof( ucReq );
+}
+
+/* 1 when pucAns is the answer to transaction uTid reading the registers. */
+static int prvReadAnswer( const uint8_t *pucAns, unsigned uLen, unsigned uTid )
+{
+	unsigned i;
+
+	if( uLen != 9 + READ_COUNT * 2 || ( ( pucAns[ 0 ] << 8 ) | pucAns[ 1 ] ) != ( uTid & 0xFFFF ) ||
+		pucAns[ 2 ] || pucAns[ 3 ] || ( ( pucAns[ 4 ] << 8 ) | pucAns[ 5 ] ) != uLen - 6 ||
+		pucAns[ 6 ] != 1 || pucAns[ 7 ] != MB_FUNC_READ_INPUT_REGISTER || pucAns[ 8 ] != READ_COUNT * 2 )
+	{
+		return 0;
+	}
+	for( i = 0; i < READ_COUNT; i++ )
+	{
+		if( ( ( pucAns[ 9 + i * 2 ] << 8 ) | pucAns[ 10 + i * 2 ] ) != usInput( READ_ADDR + i ) )
+		{
+			return 0;
+		}
+	}
+	return 1;
+}
+
+/* Run until a datagram comes back, at most xTicks. */
+static int prvUdpWait( xPeerDatagram *pxDatagram, portTickType xTicks )
+{
+	portTickType xStart = xTaskGetTickCount();
+
+	while( !iPeerUdpRecv( pxDatagram ) )
+	{
+		if( xTaskGetTickCount() - xStart >= xTicks )
+		{
+			return 0;
+		}
+		vHostRun( 1 );
+	}
+	return 1;
+}
+
+/* Run until the connection has taken ulBytes, at most xTicks. */
+static int prvTcpWait( xPeerTcp *pxConn, unsigned long ulBytes, portTickType xTicks )
+{
+	portTickType xStart = xTaskGetTickCount();
+
+	while( pxConn->ulRxBytes < ulBytes )
+	{
+		if( xTaskGetTickCount() - xStart >= xTicks || pxConn->iState != PEER_OPEN )
+		{
+			return 0;
+		}
+		vHostRun( 1 );
+	}
+	return 1;
+}
+
+/* Requests from many ports at once, each answer to its sender; a write is
+ * seen by the next read and requests that are not Modbus are dropped. */
+static void test_modbus( void )
+{
+	static xPeerDatagram xAns;
+	uint8_t ucReq[ 16 ];
+	unsigned uLen, i, uSeen = 0;
+	uint8_t ucSeen[ SENDERS ] = { 0 };
+
+	vPeerStart();
+	prvSetImage();
+	for( i = 0; i < SENDERS; i++ )
+	{
+		uLen = prvRequest( ucReq, 0x100 + i, MB_FUNC_READ_INPUT_REGISTER, READ_ADDR, READ_COUNT );
+		vPeerUdpSend( ( uint16_t ) ( 40000 + i ), MB_PORT, 0, ucReq, uLen );
+	}
+	while( prvUdpWait( &xAns, 200 ) )
+	{
+		i = xAns.usDstPort - 40000;
+		CHECK_EQ( xAns.usSrcPort, MB_PORT );
+		CHECK( !xAns.iBroadcast );
+		CHECK( i < SENDERS && !ucSeen[ i ] );
+		CHECK( prvReadAnswer( xAns.ucData, xAns.uLen, 0x100 + i ) );
+		if( i < SENDERS )
+		{
+			ucSeen[ i ] = 1;
+		}
+		uSeen++;
+	}
+	CHECK_EQ( uSeen, SENDERS );
+
+	/* write single register, then read it back */
+	uLen = prvRequest( ucReq, 7, MB_FUNC_WRITE_REGISTER, MB_VOL_SET_L, 4321 );
+	vPeerUdpSend( 40000, MB_PORT, 0, ucReq, uLen );
+	CHECK( prvUdpWait( &xAns, 200 ) );
+	CHECK( xAns.uLen == uLen && memcmp( xAns.ucData, ucReq, uLen ) == 0 );
+	CHECK_EQ( eMBRegHolding_Read( MB_VOL_SET_L ), 4321 );
+
+	/* an unknown function gets the exception */
+	uLen = prvRequest( ucReq, 8, 0x41, 0, 1 );
+	vPeerUdpSend( 40000, MB_PORT, 0, ucReq, uLen );
+	CHECK( prvUdpWait( &xAns, 200 ) );
+	CHECK( xAns.uLen == 9 && xAns.ucData[ 7 ] == ( 0x41 | MB_FUNC_ERROR ) && xAns.ucData[ 8 ] == MB_EX_ILLEGAL_FUNCTION );
+
+	/* a wrong length, a protocol ID other than 0, a stray byte: no answer */
+	uLen = prvRequest( ucReq, 9, MB_FUNC_READ_INPUT_REGISTER, READ_ADDR, READ_COUNT );
+	vPeerUdpSend( 40000, MB_PORT, 0, ucReq, uLen - 1 );
+	ucReq[ 3 ] = 1;
+	vPeerUdpSend( 40000, MB_PORT, 0, ucReq, uLen );
+	vPeerUdpSend( 40000, MB_PORT, 0, ucReq, 1 );
+	CHECK( !prvUdpWait( &xAns, 100 ) );
+	CHECK_EQ( xPeer.ulBadFrames, 0 );
+	CHECK_EQ( xPeer.ulUdpLost, 0 );
+}
+
+/* The answer to a query, its fields checked; 0 when none came. */
+static int prvDiscover( xPeerDatagram *pxAns, int iBroadcast, unsigned long ulServed )
+{
+	char cLine[ PEER_MSS + 1 ], cExpect[ 128 ];
+
+	if( !prvUdpWait( pxAns, 100 ) )
+	{
+		return 0;
+	}
+	CHECK_EQ( pxAns->usSrcPort, UDPD_DISCOVER_PORT );
+	CHECK_EQ( pxAns->iBroadcast, iBroadcast );
+	memcpy( cLine, pxAns->ucData, pxAns->uLen );
+	cLine[ pxAns->uLen ] = 0;
+	sprintf( cExpect, "{\"ip\":\"%d.%d.%d.%d\",\"mac\":\"%02x:%02x:%02x:%02x:%02x:%02x\",\"fw\":\"%s\",",
+			 configIP_ADDR0, configIP_ADDR1, configIP_ADDR2, configIP_ADDR3,
+			 configMAC_ADDR0, configMAC_ADDR1, configMAC_ADDR2, configMAC_ADDR3, configMAC_ADDR4, configMAC_ADDR5,
+			 configFW_VERSION );
+	CHECK( strncmp( cLine, cExpect, strlen( cExpect ) ) == 0 );
+	CHECK( strstr( cLine, "\"st_l\":1,\"st_r\":0,\"mpump\":2," ) != NULL );
+	sprintf( cExpect, "\"mbudp\":%lu}\n", ulServed );
+	CHECK( pxAns->uLen > strlen( cExpect ) && strcmp( cLine + pxAns->uLen - strlen( cExpect ), cExpect ) == 0 );
+	return 1;
+}
+
+/* A broadcast query answered to the sender, or to everyone when the
+ * sender is not on our subnet; anything else on the port is ignored. */
+static void test_discovery( void )
+{
+	static const uint8_t ucAway[ 4 ] = { 10, 0, 0, 5 }, ucNone[ 4 ] = { 0, 0, 0, 0 };
+	static xPeerDatagram xAns;
+	uint8_t ucReq[ 16 ];
+	unsigned uLen, i;
+
+	vPeerStart();
+	eMBRegInput_Write( MB_HV_ST_L, 1 );
+	eMBRegInput_Write( MB_HV_ST_R, 0 );
+	eMBRegInput_Write( MB_MPUMP_ST, 2 );
+
+	vPeerUdpSend( 50000, UDPD_DISCOVER_PORT, 1, UDPD_DISCOVER_QUERY, strlen( UDPD_DISCOVER_QUERY ) );
+	CHECK( prvDiscover( &xAns, 0, 0 ) );
+	CHECK_EQ( xAns.usDstPort, 50000 );
+
+	/* served Modbus/UDP requests are counted */
+	for( i = 0; i < 3; i++ )
+	{
+		uLen = prvRequest( ucReq, i, MB_FUNC_READ_INPUT_REGISTER, READ_ADDR, READ_COUNT );
+		vPeerUdpSend( 40000, MB_PORT, 0, ucReq, uLen );
+		CHECK( prvUdpWait( &xAns, 100 ) );
+	}
+	/* one that is not answered is not counted */
+	vPeerUdpSend( 40000, MB_PORT, 0, ucReq, uLen - 1 );
+	vHostRun( 20 );
+	vPeerUdpSend( 50001, UDPD_DISCOVER_PORT, 0, "GL696?v1", 8 );
+	CHECK( prvDiscover( &xAns, 0, 3 ) );
+	CHECK_EQ( xAns.usDstPort, 50001 );
+
+	vPeerUdpBroadcastFrom( ucAway, 50002, UDPD_DISCOVER_PORT, UDPD_DISCOVER_QUERY, strlen( UDPD_DISCOVER_QUERY ) );
+	CHECK( prvDiscover( &xAns, 1, 3 ) );
+	CHECK_EQ( xAns.usDstPort, 50002 );
+	vPeerUdpBroadcastFrom( ucNone, 50003, UDPD_DISCOVER_PORT, UDPD_DISCOVER_QUERY, strlen( UDPD_DISCOVER_QUERY ) );
+	CHECK( prvDiscover( &xAns, 1, 3 ) );
+
+	/* and the next sender on our subnet is answered directly again */
+	vPeerUdpSend( 50004, UDPD_DISCOVER_PORT, 1, UDPD_DISCOVER_QUERY, strlen( UDPD_DISCOVER_QUERY ) );
+	CHECK( prvDiscover( &xAns, 0, 3 ) );
+
+	vPeerUdpSend( 50000, UDPD_DISCOVER_PORT, 1, "GL69", 4 );
+	vPeerUdpSend( 50000, UDPD_DISCOVER_PORT, 1, "hello?", 6 );
+	vPeerUdpSend( 50000, UDPD_DISCOVER_PORT + 1, 1, UDPD_DISCOVER_QUERY, strlen( UDPD_DISCOVER_QUERY ) );
+	CHECK( !prvUdpWait( &xAns, 100 ) );
+	CHECK_EQ( xPeer.ulBadFrames, 0 );
+}
+
+/* Polls per second and frames per poll, one poller at a time. */
+static void test_bench( void )
+{
+	static xPeerDatagram xAns;
+	static uint8_t ucRx[ 64 ];
+	xPeerTcp xConn = { 0 };
+	uint8_t ucReq[ 16 ];
+	unsigned uLen, n, uPolls = 500;
+	unsigned long ulFrames;
+	portTickType xStart;
+	int iOk = 1;
+
+	vPeerStart();
+	prvSetImage();
+
+	xStart = xTaskGetTickCount();
+	ulFrames = xPeer.ulFramesIn + xPeer.ulFramesOut;
+	for( n = 0; n < uPolls && iOk; n++ )
+	{
+		uLen = prvRequest( ucReq, n, MB_FUNC_READ_INPUT_REGISTER, READ_ADDR, READ_COUNT );
+		vPeerUdpSend( 40000, MB_PORT, 0, ucReq, uLen );
+		iOk = prvUdpWait( &xAns, 100 ) && prvReadAnswer( xAns.ucData, xAns.uLen, n );
+	}
+	CHECK( iOk );
+	xStart = xTaskGetTickCount() - xStart;
+	if( iOk )
+	{
+		printf( "Modbus/UDP:           %4lu polls/s, %lu frames a poll\n",
+				uPolls * 1000UL / ( unsigned long ) ( xStart ? xStart : 1 ),
+				( xPeer.ulFramesIn + xPeer.ulFramesOut - ulFrames ) / uPolls );
+	}
+
+	/* SENDERS masters at once, more than UIP_CONNS could hold over TCP */
+	xStart = xTaskGetTickCount();
+	for( n = 0; n < 20 && iOk; n++ )
+	{
+		for( uLen = 0; uLen < SENDERS; uLen++ )
+		{
+			vPeerUdpSend( ( uint16_t ) ( 40000 + uLen ), MB_PORT, 0, ucReq,
+						  prvRequest( ucReq, uLen, MB_FUNC_READ_INPUT_REGISTER, READ_ADDR, READ_COUNT ) );
+		}
+		for( uLen = 0; uLen < SENDERS && iOk; uLen++ )
+		{
+			iOk = prvUdpWait( &xAns, 100 ) && prvReadAnswer( xAns.ucData, xAns.uLen, xAns.usDstPort - 40000 );
+		}
+	}
+	CHECK( iOk );
+	xStart = xTaskGetTickCount() - xStart;
+	if( iOk )
+	{
+		printf( "Modbus/UDP, %d at once: %4lu polls/s\n", SENDERS,
+				20UL * SENDERS * 1000UL / ( unsigned long ) ( xStart ? xStart : 1 ) );
+	}
+
+	/* one connection kept open */
+	xConn.pucRx = ucRx;
+	xConn.uRxMax = 0;
+	CHECK( iPeerConnect( &xConn, MB_PORT ) );
+	xStart = xTaskGetTickCount();
+	ulFrames = xPeer.ulFramesIn + xPeer.ulFramesOut;
+	for( n = 0; n < uPolls && iOk; n++ )
+	{
+		uLen = prvRequest( ucReq, n, MB_FUNC_READ_INPUT_REGISTER, READ_ADDR, READ_COUNT );
+		vPeerTcpSend( &xConn, ucReq, uLen );
+		iOk = prvTcpWait( &xConn, ( n + 1 ) * ( 9 + READ_COUNT * 2UL ), 1000 );
+	}
+	CHECK( iOk );
+	xStart = xTaskGetTickCount() - xStart;
+	if( iOk )
+	{
+		printf( "Modbus/TCP, kept:     %4lu polls/s, %lu frames a poll\n",
+				uPolls * 1000UL / ( unsigned long ) ( xStart ? xStart : 1 ),
+				( xPeer.ulFramesIn + xPeer.ulFramesOut - ulFrames ) / uPolls );
+	}
+	vPeerTcpAbort( &xConn );
+
+	/* a connection per poll */
+	uPolls = 100;
+	xStart = xTaskGetTickCount();
+	ulFrames = xPeer.ulFramesIn + xPeer.ulFramesOut;
+	for( n = 0; n < uPolls && iOk; n++ )
+	{
+		memset( &xConn, 0, sizeof( xConn ) );
+		iOk = iPeerConnect( &xConn, MB_PORT );
+		uLen = prvRequest( ucReq, n, MB_FUNC_READ_INPUT_REGISTER, READ_ADDR, READ_COUNT );
+		vPeerTcpSend( &xConn, ucReq, uLen );
+		iOk = iOk && prvTcpWait( &xConn, 9 + READ_COUNT * 2UL, 1000 );
+		vPeerTcpAbort( &xConn );
+	}
+	CHECK( iOk );
+	xStart = xTaskGetTickCount() - xStart;
+	if( iOk )
+	{
+		printf( "Modbus/TCP, per poll: %4lu polls/s, %lu frames a poll\n",
+				uPolls * 1000UL / ( unsigned long ) ( xStart ? xStart : 1 ),
+				( xPeer.ulFramesIn + xPeer.ulFramesOut - ulFrames ) / uPolls );
+	}
+	CHECK_EQ( xPeer.ulBadFrames, 0 );
+}
+
+int main( void )
+{
+	test_modbus();
+	test_discovery();
+	test_bench();
+	return TEST_RESULT();
+}
@@ -0,0 +1,201 @@
+/*
+ * The holding register watches of the gun loops: only what the host writes
+ * marks them, a loop publishing its own set points does not, and a gun
+ * reloads just the parameters that were written.  What the operator enters
+ * on the panel counts as a host write.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+#include "stm32f10x.h"
+#include "window.h"
+#include "gl_696h.h"
+#include "mb_reg_map.h"
+#include "modbus.h"
+
+#include "host.h"
+#include "rig.h"
+#include "test.h"
+
+/* A field the gun keeps until the host writes its register. */
+#define MARK	12345
+
+/* win_main.c, called from WinTask. */
+void main_win_msg( HIDMessage *msg );
+
+/* What the host software writes before it sets a gun going. */
+static void prvHostParams( void )
+{
+	vRigWriteHolding( MB_VOL_SCALE, 5 );
+	vRigWriteHolding( MB_VOL_STEP_INTERVAL, 200 );
+	vRigWriteHolding( MB_CUR_SCALE, 1 );
+	vRigWriteHolding( MB_CUR_STEP_INTERVAL, 10000 );
+}
+
+/* Ten seconds of both guns regulating mark nothing and reload nothing. */
+static void test_loop_writes( void )
+{
+	static xMBRegWatch xWatch = { MB_VOL_MAX, MB_CUR_PI_INTERVAL - MB_VOL_MAX + 1, NULL, NULL };
+	ULONG ulDirty[ MB_REG_WATCH_WORDS ];
+	USHORT usReg;
+
+	vRigStart();
+	CHECK( eMBRegHolding_Watch( &xWatch ) );
+	prvHostParams();
+	vRigWriteHolding( MB_VOL_SET_L, 5000 );
+	vRigWriteHolding( MB_VOL_SET_R, 5000 );
+	vHostRun( 1000 );
+	eMBRegHolding_TakeDirtyMap( &xWatch, ulDirty );
+	hvsl.vol_max = MARK;
+	hvsr.cur_kp = MARK;
+
+	vHostRun( 10000 );
+	CHECK( !eMBRegHolding_TakeDirtyMap( &xWatch, ulDirty ) );
+	CHECK_EQ( hvsl.vol_max, MARK );
+	CHECK_EQ( hvsr.cur_kp, MARK );
+
+	/* and a host write marks just its register */
+	vRigWriteHolding( MB_CUR_KI, 3 );
+	CHECK( eMBRegHolding_TakeDirtyMap( &xWatch, ulDirty ) );
+	for( usReg = 0; usReg < REG_HOLDING_NREGS; usReg++ )
+	{
+		CHECK_EQ( MB_REG_DIRTY( ulDirty, usReg ), usReg == MB_CUR_KI );
+	}
+}
+
+/* A host write lands in both guns on the next pass, and nothing else does. */
+static void test_host_write( void )
+{
+	vRigStart();
+	prvHostParams();
+	vHostRun( 1000 );
+	hvsl.vol_max = MARK;
+	hvsr.vol_max = MARK;
+
+	vRigWriteHolding( MB_VOL_STEP, 77 );
+	vHostRun( 20 );
+	CHECK_EQ( hvsl.vol_step, 77 );
+	CHECK_EQ( hvsr.vol_step, 77 );
+	CHECK_EQ( hvsl.vol_max, MARK );
+	CHECK_EQ( hvsr.vol_max, MARK );
+
+	/* a set point is one gun's */
+	vRigWriteHolding( MB_VOL_SET_L, 5000 );
+	vHostRun( 20 );
+	CHECK_EQ( hvsl.vol_set, 5000 );
+	CHECK_EQ( hvsr.vol_set, 0 );
+	/* echoed at the next voltage step */
+	vHostRun( 200 );
+	CHECK_EQ( eMBRegInput_Read( MB_VOL_SET_L_ST ), 5000 );
+	CHECK_EQ( eMBRegHolding_Read( MB_VOL_SET_L ), 5000 );
+	CHECK_EQ( hvsl.vol_max, MARK );
+}
+
+/* The auto sequence starts on a power command, off zeroes the set points
+ * in the guns and in the holding image alike. */
+static void test_sequence( void )
+{
+	portTickType xStart;
+
+	vRigStart();
+	prvHostParams();
+	vHostRun( 1500 - xTaskGetTickCount() % 1000 );
+	xStart = xTaskGetTickCount();
+	vRigWriteHolding( MB_POWERPUMP_CTL, POWER_ON );
+	while( eMBRegInput_Read( MB_POWERPUMP_ST ) != POWERPUMP_PWR_ON && xTaskGetTickCount() - xStart < 1000 )
+	{
+		vHostRun( 1 );
+	}
+	CHECK( xTaskGetTickCount() - xStart <= 10 );
+
+	vRigWriteHolding( MB_VOL_SET_L, 5000 );
+	vRigWriteHolding( MB_CUR_SET_R, 300 );
+	vHostRun( 20 );
+	CHECK_EQ( hvsl.vol_set, 5000 );
+	CHECK_EQ( hvsr.cur_set, 300 );
+
+	vRigWriteHolding( MB_POWERPUMP_CTL, POWER_OFF );
+	vHostRun( 2000 );
+	CHECK_EQ( hvsl.vol_set, 0 );
+	CHECK_EQ( hvsr.cur_set, 0 );
+	CHECK_EQ( eMBRegHolding_Read( MB_VOL_SET_L ), 0 );
+	CHECK_EQ( eMBRegHolding_Read( MB_CUR_SET_R ), 0 );
+}
+
+/* A touch on the panel, pressed or let go, inside the button at x, y. */
+static void prvTouch( uint16_t usId, uint16_t usX, uint16_t usY )
+{
+	HIDMessage xTouch = { 0 };
+
+	xTouch.type = HID_TOUCHSCREEN;
+	xTouch.id = usId;
+	xTouch.x = usX + 20;
+	xTouch.y = usY + 10;
+	main_win_msg( &xTouch );
+}
+
+/* A read of one holding register through the Modbus callback, as FC03. */
+static USHORT usHostRead( USHORT usReg )
+{
+	UCHAR ucReg[ 2 ];
+
+	eMBRegHoldingCB( ucReg, REG_HOLDING_START + usReg, 1, MB_REG_READ );
+	return ( USHORT ) ( ( ucReg[ 0 ] << 8 ) | ucReg[ 1 ] );
+}
+
+/* The panel's set point steps reach the gun and the host reads them back,
+ * its start button runs the sequence at once. */
+static void test_panel( void )
+{
+	portTickType xStart;
+
+	vRigStart();
+	prvHostParams();
+	/* the register image outlives the restart, end the stop left running */
+	vRigWriteHolding( MB_SYS_AUTOCTL, 0 );
+	/* the panel steps up to these */
+	vRigWriteHolding( MB_VOL_MAX, 15000 );
+	vRigWriteHolding( MB_CURRRENT_MAX, 3000 );
+	vHostRun( 1000 );
+
+	/* left voltage, UP three times */
+	prvTouch( HID_TC_DOWN, 16 * 10, 32 * 4 );
+	prvTouch( HID_TC_DOWN, 16 * 23, 32 * 9 );
+	prvTouch( HID_TC_DOWN, 16 * 23, 32 * 9 );
+	prvTouch( HID_TC_DOWN, 16 * 23, 32 * 9 );
+	CHECK_EQ( usHostRead( MB_VOL_SET_L ), 300 );
+	vHostRun( 20 );
+	CHECK_EQ( hvsl.vol_set, 300 );
+	/* right current UP twice and DOWN once, the left gun keeps its own */
+	prvTouch( HID_TC_DOWN, 16 * 25, 32 * 5 );
+	prvTouch( HID_TC_DOWN, 16 * 23, 32 * 9 );
+	prvTouch( HID_TC_DOWN, 16 * 23, 32 * 9 );
+	prvTouch( HID_TC_DOWN, 16 * 30, 32 * 9 );
+	vHostRun( 20 );
+	CHECK_EQ( hvsr.cur_set, 100 );
+	CHECK_EQ( usHostRead( MB_CUR_SET_R ), 100 );
+	CHECK_EQ( hvsl.vol_set, 300 );
+
+	/* between two periodic runs of the sequence */
+	vHostRun( 1500 - xTaskGetTickCount() % 1000 );
+	xStart = xTaskGetTickCount();
+	prvTouch( HID_TC_DOWN, 16 * 5, 32 * 9 );
+	prvTouch( HID_TC_UP, 16 * 5, 32 * 9 );
+	CHECK_EQ( usHostRead( MB_SYS_AUTOCTL ), SYS_AUTO_EN | SYS_AUTO_ON );
+	while( eMBRegInput_Read( MB_POWERPUMP_ST ) != POWERPUMP_PWR_ON && xTaskGetTickCount() - xStart < 1000 )
+	{
+		vHostRun( 1 );
+	}
+	CHECK( xTaskGetTickCount() - xStart <= 10 );
+}
+
+int main( void )
+{
+	test_loop_writes();
+	test_host_write();
+	test_sequence();
+	test_panel();
+	return TEST_RESULT();
+}
@@ -0,0 +1,275 @@
+/*
+ * The retained widgets of windows/widget.c and the main window on the
+ * panel model.  The number formats match printf's, a flush draws only the
+ * cells that changed and what it draws ends up as a full redraw would,
+ * also when the bus budget cuts a frame short.  The bench prints the
+ * pixels and bus time of a refresh against repainting every reading, as
+ * main_win_refresh() did before.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+#include "stm32f10x.h"
+#include "fonts.h"
+#include "lcd.h"
+#include "widget.h"
+#include "window.h"
+#include "win_main.h"
+#include "gl_696h.h"
+#include "modbus.h"
+
+#include "host.h"
+#include "test.h"
+#include "lcd_model.h"
+
+#define CELL_PX			( 16 * 32 * 2 )
+#define READINGS		20
+
+/* lcd.c and win_main.c, called from WinTask. */
+void prvConfigureLCD( void );
+void main_win_draw( void );
+void main_win_refresh( void );
+void main_win_msg( HIDMessage *msg );
+
+static uint16_t usScreen[ LCD_MODEL_HEIGHT ][ LCD_MODEL_WIDTH ];
+
+/* WinTask's loop: a flush every 10 ms. */
+static void prvRun( unsigned uMs )
+{
+	for( ; uMs >= 10; uMs -= 10 )
+	{
+		Widget_Flush( win_main.psWidgets );
+		vHostRun( 10 );
+	}
+}
+
+static void prvReadings( unsigned long ulNoise )
+{
+	hvsl.vol_fb = ( unsigned short ) ( 5000 + ulNoise % 101 );
+	hvsl.cur_fb = ( unsigned short ) ( 3000 + ulNoise % 13 );
+	hvsr.vol_fb = ( unsigned short ) ( 4000 + ulNoise % 57 );
+	hvsr.cur_fb = 2000;
+	vmeter = 2.5f;
+	eMBRegInput_Write( MB_MPUMP_FREQ, 820 );
+}
+
+static void prvStart( void )
+{
+	vHostReset();
+	vLcdModelReset( 0xAAAA );
+	prvConfigureLCD();
+	hvsl.vol_set = 5000;
+	hvsl.cur_set = 3000;
+	hvsr.vol_set = 4000;
+	hvsr.cur_set = 2000;
+	prvReadings( 0 );
+	main_win_draw();
+	main_win_refresh();
+	prvRun( 2000 );
+}
+
+/* Both pages hold what a redraw of every widget draws. */
+static int prvSameAsRedraw( void )
+{
+	int iSame;
+
+	memcpy( usScreen, xLcd.usPage[ LCD_MODEL_SHOWN() ], sizeof( usScreen ) );
+	iSame = memcmp( usScreen, xLcd.usPage[ !LCD_MODEL_SHOWN() ], sizeof( usScreen ) ) == 0;
+	Widget_Invalidate( win_main.psWidgets );
+	prvRun( 2000 );
+	return iSame && memcmp( usScreen, xLcd.usPage[ LCD_MODEL_SHOWN() ], sizeof( usScreen ) ) == 0;
+}
+
+/* Widget_SetFixed() and Widget_SetSci() against printf. */
+static void test_format( void )
+{
+	static const struct
+	{
+		unsigned long ulDiv;
+		int iDecimals, iWidth;
+	} xFmt[] = { { 1000, 1, 2 }, { 10000, 2, 1 }, { 1, 0, 3 }, { 100, 2, 6 } };
+	char cWant[ 32 ];
+	sWidget xW;
+	unsigned long ulValue;
+	unsigned i, n, uBad = 0;
+	float fValue;
+
+	vTestSeed( 22 );
+	for( i = 0; i < sizeof( xFmt ) / sizeof( xFmt[ 0 ] ); i++ )
+	{
+		for( n = 0; n < 20000; n++ )
+		{
+			ulValue = n < 100 ? n : ulTestRand() & 0xFFFF;
+			Widget_Init( &xW, 0, 0, 8, White );
+			Widget_SetFixed( &xW, ulValue, xFmt[ i ].ulDiv, xFmt[ i ].iDecimals, xFmt[ i ].iWidth );
+			/* halves round up, printf rounds the binary value */
+			snprintf( cWant, sizeof( cWant ), "%*.*f", xFmt[ i ].iWidth, xFmt[ i ].iDecimals,
+					  ( double ) ulValue / xFmt[ i ].ulDiv + 1e-9 );
+			memset( cWant + strlen( cWant ), ' ', 8 - strlen( cWant ) );
+			cWant[ 8 ] = 0;
+			uBad += strcmp( xW.text, cWant ) != 0;
+		}
+	}
+	CHECK_EQ( uBad, 0 );
+
+	/* four digits, printf rounds a tie by the binary value that is just
+	   above or below it */
+	for( n = 0; n < 20000; n++ )
+	{
+		ulValue = ulTestRand() % 9000 + 1000;
+		if( ulValue % 10 == 5 )
+		{
+			continue;
+		}
+		fValue = ( float ) ( ulValue / 1000.0 );
+		for( i = ulTestRand() % 12; i > 0; i-- )
+		{
+			fValue /= 10;
+		}
+		Widget_Init( &xW, 0, 0, 8, White );
+		Widget_SetSci( &xW, fValue );
+		snprintf( cWant, sizeof( cWant ), "%.2E", fValue );
+		uBad += strcmp( xW.text, cWant ) != 0;
+	}
+	CHECK_EQ( uBad, 0 );
+
+	/* a CJK character that does not fit is left out whole */
+	Widget_Init( &xW, 0, 0, 5, White );
+	Widget_SetText( &xW, "AB\xC6\xF4\xB6\xAF" );
+	CHECK( strcmp( xW.text, "AB\xC6\xF4 " ) == 0 );
+}
+
+/* One changed digit is one cell, the same value is nothing, a CJK
+   character is two. */
+static void test_dirty( void )
+{
+	HIDMessage xTouch = { 0 };
+	sWidget xW;
+
+	prvStart();
+	CHECK( prvSameAsRedraw() );
+
+	vLcdModelCount();
+	main_win_refresh();
+	CHECK_EQ( Widget_Flush( win_main.psWidgets ), 0 );
+	CHECK_EQ( xLcd.ulStores, 0 );
+
+	/* 5.0 kV to 5.1 */
+	hvsl.vol_fb = 5100;
+	main_win_refresh();
+	CHECK_EQ( Widget_Flush( win_main.psWidgets ), CELL_PX );
+	CHECK_EQ( xLcd.ulPixels, CELL_PX );
+	/* to 15.1, the text moves right by a cell */
+	hvsl.vol_fb = 15100;
+	vLcdModelCount();
+	main_win_refresh();
+	CHECK_EQ( Widget_Flush( win_main.psWidgets ), 4 * CELL_PX );
+	CHECK_EQ( xLcd.ulPixels, 4 * CELL_PX );
+	CHECK_EQ( xLcd.ulErrors + xLcd.ulOutside + xLcd.ulOffPanel, 0 );
+
+	/* touching a setpoint turns the whole field red on the refresh it
+	   asks for, touching elsewhere turns it back */
+	xTouch.type = HID_TOUCHSCREEN;
+	xTouch.id = HID_TC_DOWN;
+	xTouch.x = 16 * 10 + 20;
+	xTouch.y = 32 * 4 + 10;
+	main_win_msg( &xTouch );
+	main_win_refresh();
+	CHECK_EQ( Widget_Flush( win_main.psWidgets ), 5 * CELL_PX );
+	xTouch.id = HID_TC_UP;
+	xTouch.x = 600;
+	main_win_msg( &xTouch );
+	CHECK_EQ( Widget_Flush( win_main.psWidgets ), 5 * CELL_PX );
+	CHECK( prvSameAsRedraw() );
+
+	/* 值 to 止 changes the second byte only, the glyph is drawn whole */
+	Widget_Init( &xW, 16, 400, 4, White );
+	Widget_SetText( &xW, "\xD6\xB5" "AB" );
+	CHECK_EQ( Widget_Flush( &xW ), 4 * CELL_PX );
+	Widget_SetText( &xW, "\xD6\xB9" "AB" );
+	CHECK_EQ( Widget_Flush( &xW ), 2 * CELL_PX );
+	memcpy( usScreen, xLcd.usPage[ LCD_MODEL_SHOWN() ], sizeof( usScreen ) );
+	Widget_Invalidate( &xW );
+	CHECK_EQ( Widget_Flush( &xW ), 4 * CELL_PX );
+	CHECK( memcmp( usScreen, xLcd.usPage[ LCD_MODEL_SHOWN() ], sizeof( usScreen ) ) == 0 );
+}
+
+/* Noisy readings at 2 Hz, and every reading repainted as before. */
+static void test_refresh( void )
+{
+	unsigned long ulDirty = 0, ulDirtyNs = 0, ulFull = 0, ulFullNs = 0;
+	psWidget pxReadings;
+	unsigned i;
+
+	prvStart();
+	/* the button captions come first in the list, the old refresh did
+	   not draw them */
+	pxReadings = win_main.psWidgets->next->next->next;
+	vTestSeed( 2 );
+	for( i = 0; i < READINGS; i++ )
+	{
+		vLcdModelCount();
+		prvReadings( ulTestRand() );
+		main_win_refresh();
+		prvRun( 500 );
+		ulDirty += xLcd.ulPixels;
+		ulDirtyNs += ulLcdModelNs();
+
+		vLcdModelCount();
+		Widget_Invalidate( pxReadings );
+		prvRun( 500 );
+		ulFull += xLcd.ulPixels;
+		ulFullNs += ulLcdModelNs();
+	}
+	CHECK( ulDirty * 4 < ulFull );
+	CHECK( prvSameAsRedraw() );
+	printf( "%u refreshes: readings repainted %6lu px, %4lu us bus; changed cells %6lu px, %4lu us bus\n", READINGS,
+			ulFull / READINGS, ulFullNs / READINGS / 1000, ulDirty / READINGS, ulDirtyNs / READINGS / 1000 );
+}
+
+/* Every reading changing every 10 ms: no second takes more than the
+   budget, what is cut is drawn later. */
+static void test_budget( void )
+{
+	unsigned long ulMaxPx = 0, ulMaxNs = 0, ulCuts;
+	unsigned s, i;
+
+	prvStart();
+	ulCuts = WidgetStats.budget_cuts;
+	vTestSeed( 3 );
+	for( s = 0; s < 3; s++ )
+	{
+		vLcdModelCount();
+		for( i = 0; i < 100; i++ )
+		{
+			prvReadings( ulTestRand() );
+			eMBRegInput_Write( MB_MPUMP_FREQ, ( USHORT ) ( ulTestRand() % 1000 ) );
+			vmeter = ( float ) ( ulTestRand() % 100000 ) / 7.0f;
+			main_win_refresh();
+			prvRun( 10 );
+		}
+		ulMaxPx = xLcd.ulPixels > ulMaxPx ? xLcd.ulPixels : ulMaxPx;
+		ulMaxNs = ulLcdModelNs() > ulMaxNs ? ulLcdModelNs() : ulMaxNs;
+	}
+	CHECK( ulMaxPx <= WIDGET_PIXEL_BUDGET );
+	CHECK( ulMaxNs <= WIDGET_BUS_MS_PER_SEC * 1000000UL );
+	CHECK( WidgetStats.budget_cuts > ulCuts );
+	prvRun( 2000 );
+	CHECK( prvSameAsRedraw() );
+	printf( "all readings every 10 ms: %lu px, %lu us bus in the busiest second, budget %lu px, %u ms\n", ulMaxPx,
+			ulMaxNs / 1000, ( unsigned long ) WIDGET_PIXEL_BUDGET, WIDGET_BUS_MS_PER_SEC );
+}
+
+int main( void )
+{
+	test_format();
+	test_dirty();
+	test_refresh();
+	test_budget();
+	return TEST_RESULT();
+}
@@ -0,0 +1,247 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "stm32f10x.h"
+
+#include "uart_model.h"
+
+void USART1_IRQHandler( void );
+void USART2_IRQHandler( void );
+void USART3_IRQHandler( void );
+void DMA1_Channel6_IRQHandler( void );
+void DMA1_Channel7_IRQHandler( void );
+
+#define DMA_CCR_EN_		( 1UL << 0 )
+#define DMA_CCR_TCIE_	( 1UL << 1 )
+#define DMA_CCR_HTIE_	( 1UL << 2 )
+#define DMA_GIF			1UL
+#define DMA_TCIF		2UL
+#define DMA_HTIF		4UL
+
+#define SR_TXE			( 1U << 7 )
+#define SR_RXNE			( 1U << 5 )
+#define SR_IDLE			( 1U << 4 )
+#define CR1_TXEIE		( 1U << 7 )
+#define CR1_RXNEIE		( 1U << 5 )
+#define CR1_IDLEIE		( 1U << 4 )
+
+/* Ten bits a character, credit is counted in baud per tick. */
+#define CHAR_CREDIT		( 10UL * configTICK_RATE_HZ )
+
+static USART_TypeDef *prvUsart( xUartModel *pxUart )
+{
+	return pxUart->ePort == serCOM1 ? USART1 : pxUart->ePort == serCOM2 ? USART2 : USART3;
+}
+
+static void prvUsartIrq( xUartModel *pxUart )
+{
+	pxUart->ulIrqs++;
+	if( pxUart->pxIrq != NULL )
+	{
+		pxUart->pxIrq();
+	}
+	else if( pxUart->ePort == serCOM1 )
+	{
+		USART1_IRQHandler();
+	}
+	else if( pxUart->ePort == serCOM2 )
+	{
+		USART2_IRQHandler();
+	}
+	else
+	{
+		USART3_IRQHandler();
+	}
+}
+
+/* Flags of DMA1 channel ulCh, the handler clears them through IFCR. */
+static void prvDmaIrq( xUartModel *pxUart, unsigned ulCh, uint32_t ulFlags )
+{
+	DMA1->ISR |= ( ulFlags | DMA_GIF ) << ( 4 * ( ulCh - 1 ) );
+	pxUart->ulIrqs++;
+	if( ulCh == 6 )
+	{
+		DMA1_Channel6_IRQHandler();
+	}
+	else
+	{
+		DMA1_Channel7_IRQHandler();
+	}
+	DMA1->ISR &= ~DMA1->IFCR;
+	DMA1->IFCR = 0;
+}
+
+void vUartModelInit( xUartModel *pxUart, eCOMPort ePort, unsigned long ulBaud )
+{
+	if( ePort != serCOM1 && ePort != serCOM2 && ePort != serCOM3 )
+	{
+		fprintf( stderr, "uart_model: COM%d is not modelled\n", ePort + 1 );
+		abort();
+	}
+	memset( pxUart, 0, sizeof( *pxUart ) );
+	pxUart->ePort = ePort;
+	pxUart->ulBaud = ulBaud;
+}
+
+void vUartModelSend( xUartModel *pxUart, const void *pvData, unsigned uLen )
+{
+	const uint8_t *pucData = pvData;
+
+	while( uLen-- > 0 )
+	{
+		pxUart->ucIn[ pxUart->uInHead++ % UART_MODEL_BUF ] = *pucData++;
+	}
+}
+
+static void prvRxByte( xUartModel *pxUart, uint8_t ucByte )
+{
+	USART_TypeDef *xUSART = prvUsart( pxUart );
+	DMA_Channel_TypeDef *xDma = DMA1_Channel6;
+
+	pxUart->ulRxBytes++;
+	if( pxUart->ePort == serCOM2 )
+	{
+		if( !( xDma->CCR & DMA_CCR_EN_ ) )
+		{
+			return;		/* lost, as on the wire */
+		}
+		if( pxUart->uRxLen == 0 )
+		{
+			pxUart->uRxLen = xDma->CNDTR;
+		}
+		*( uint8_t * ) ( uintptr_t ) ( xDma->CMAR + pxUart->uRxLen - xDma->CNDTR ) = ucByte;
+		if( --xDma->CNDTR == 0 )
+		{
+			xDma->CNDTR = pxUart->uRxLen;
+			if( xDma->CCR & DMA_CCR_TCIE_ )
+			{
+				prvDmaIrq( pxUart, 6, DMA_TCIF );
+			}
+		}
+		else if( xDma->CNDTR == pxUart->uRxLen / 2 && ( xDma->CCR & DMA_CCR_HTIE_ ) )
+		{
+			prvDmaIrq( pxUart, 6, DMA_HTIF );
+		}
+	}
+	else
+	{
+		xUSART->DR = ucByte;
+		xUSART->SR |= SR_RXNE;
+		if( xUSART->CR1 & CR1_RXNEIE )
+		{
+			prvUsartIrq( pxUart );
+		}
+		xUSART->SR &= ~SR_RXNE;
+	}
+}
+
+/* One byte out of the device, 0 if it has nothing to send. */
+static int prvTxByte( xUartModel *pxUart )
+{
+	USART_TypeDef *xUSART = prvUsart( pxUart );
+	DMA_Channel_TypeDef *xDma = DMA1_Channel7;
+	uint8_t ucByte;
+
+	if( pxUart->ePort == serCOM2 )
+	{
+		if( !( xDma->CCR & DMA_CCR_EN_ ) || xDma->CNDTR == 0 )
+		{
+			return 0;
+		}
+		if( xDma->CMAR != pxUart->ulTxLastMar || xDma->CNDTR != pxUart->uTxLastNdtr )
+		{
+			/* the driver started a new span */
+			pxUart->ulTxBase = xDma->CMAR;
+			pxUart->uTxLen = xDma->CNDTR;
+		}
+		ucByte = *( uint8_t * ) ( uintptr_t ) ( pxUart->ulTxBase + pxUart->uTxLen - xDma->CNDTR );
+		xDma->CNDTR--;
+		pxUart->ulTxLastMar = xDma->CMAR;
+		pxUart->uTxLastNdtr = xDma->CNDTR;
+		if( xDma->CNDTR == 0 && ( xDma->CCR & DMA_CCR_TCIE_ ) )
+		{
+			prvDmaIrq( pxUart, 7, DMA_TCIF );
+		}
+	}
+	else
+	{
+		if( !( xUSART->CR1 & CR1_TXEIE ) )
+		{
+			return 0;
+		}
+		xUSART->DR = 0xFFFF;
+		xUSART->SR |= SR_TXE;
+		prvUsartIrq( pxUart );
+		xUSART->SR &= ~SR_TXE;
+		if( xUSART->DR == 0xFFFF )
+		{
+			return 0;
+		}
+		ucByte = ( uint8_t ) xUSART->DR;
+	}
+	pxUart->ulTxBytes++;
+	if( pxUart->uOut < UART_MODEL_BUF )
+	{
+		pxUart->ucOut[ pxUart->uOut++ ] = ucByte;
+	}
+	return 1;
+}
+
+void vUartModelTick( xUartModel *pxUart )
+{
+	USART_TypeDef *xUSART = prvUsart( pxUart );
+	int iSent;
+
+	/* device receives */
+	pxUart->ulRxCredit += pxUart->ulBaud;
+	if( pxUart->uInTail == pxUart->uInHead )
+	{
+		pxUart->ulRxCredit = pxUart->ulRxCredit < CHAR_CREDIT ? pxUart->ulRxCredit : CHAR_CREDIT;
+		if( pxUart->iRxActive && ( pxUart->ulRxIdle += pxUart->ulBaud ) >= CHAR_CREDIT )
+		{
+			pxUart->iRxActive = 0;
+			xUSART->SR |= SR_IDLE;
+			if( xUSART->CR1 & CR1_IDLEIE )
+			{
+				prvUsartIrq( pxUart );
+			}
+			xUSART->SR &= ~SR_IDLE;
+		}
+	}
+	while( pxUart->ulRxCredit >= CHAR_CREDIT && pxUart->uInTail != pxUart->uInHead )
+	{
+		pxUart->ulRxCredit -= CHAR_CREDIT;
+		pxUart->iRxActive = 1;
+		pxUart->ulRxIdle = 0;
+		prvRxByte( pxUart, pxUart->ucIn[ pxUart->uInTail++ % UART_MODEL_BUF ] );
+	}
+
+	/* device transmits */
+	pxUart->ulTxCredit += pxUart->ulBaud;
+	iSent = 0;
+	while( pxUart->ulTxCredit >= CHAR_CREDIT && prvTxByte( pxUart ) )
+	{
+		pxUart->ulTxCredit -= CHAR_CREDIT;
+		iSent = 1;
+	}
+	if( iSent )
+	{
+		pxUart->ulTxIdle = 0;
+	}
+	else
+	{
+		pxUart->ulTxCredit = pxUart->ulTxCredit < CHAR_CREDIT ? pxUart->ulTxCredit : CHAR_CREDIT;
+		if( pxUart->uOut > 0 && ( pxUart->ulTxIdle += pxUart->ulBaud ) >= CHAR_CREDIT )
+		{
+			unsigned uLen = pxUart->uOut;
+
+			pxUart->uOut = 0;
+			pxUart->ulTxIdle = 0;
+			if( pxUart->pxPeer != NULL )
+			{
+				pxUart->pxPeer( pxUart, pxUart->ucOut, uLen );
+			}
+		}
+	}
+}
@@ -0,0 +1,56 @@
+#ifndef UART_MODEL_H
+#define UART_MODEL_H
+
+/*
+ * The far end of a serial line, for driver/serial.c.  Called from a tick
+ * hook it moves bytes at the line's baud rate: into the receive DMA ring or
+ * through RXNE, out of the transmit DMA span or through TXE, and raises the
+ * HT/TC, IDLE and TXE interrupts the way the USART and DMA1 do.  COM2 runs
+ * on DMA; COM1, the Modbus slave port, and COM3 on RXNE/TXE.  pxIrq, if set
+ * after vUartModelInit(), is raised instead of the port's own handler, for a
+ * USART whose vector belongs to another driver in this build.
+ *
+ * Whatever the device sends is handed to pxPeer once the line has been
+ * quiet for a character time; the peer answers with vUartModelSend().
+ */
+
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+#include "serials.h"
+
+#define UART_MODEL_BUF		4096
+
+typedef struct xUART_MODEL xUartModel;
+
+struct xUART_MODEL
+{
+	void ( *pxPeer )( xUartModel *pxUart, const uint8_t *pucFrame, unsigned uLen );
+	void *pvArg;
+	void ( *pxIrq )( void );
+
+	/* read only for the tests */
+	unsigned long ulRxBytes;		/* to the device */
+	unsigned long ulTxBytes;		/* from the device */
+	unsigned long ulIrqs;			/* interrupts raised */
+
+	/* model state */
+	eCOMPort ePort;
+	unsigned long ulBaud;
+	unsigned long ulRxCredit, ulTxCredit, ulRxIdle, ulTxIdle;
+	uint8_t ucIn[ UART_MODEL_BUF ];
+	unsigned uInHead, uInTail;
+	uint8_t ucOut[ UART_MODEL_BUF ];
+	unsigned uOut;
+	unsigned uRxLen;
+	uint32_t ulTxBase, ulTxLastMar;
+	unsigned uTxLen, uTxLastNdtr;
+	int iRxActive;
+};
+
+/* After xSerialPortInit(), the USART registers are set up by then. */
+void vUartModelInit( xUartModel *pxUart, eCOMPort ePort, unsigned long ulBaud );
+void vUartModelSend( xUartModel *pxUart, const void *pvData, unsigned uLen );
+void vUartModelTick( xUartModel *pxUart );
+
+#endif
@@ -0,0 +1,46 @@
+/*
+ * Stand-ins for the calls windows/win_main.c makes into the window task
+ * and the touch screen.  windows/window.c does not build with gcc
+ * (pCurWin is declared extern in window.h and static in the file), and the
+ * tests call the window functions themselves, as WinTask would.
+ */
+
+#include "FreeRTOS.h"
+#include "queue.h"
+
+#include "stm32f10x.h"
+#include "window.h"
+#include "touchscreen.h"
+
+/* As in window.c. */
+portBASE_TYPE Button_Check( sButton *btn, uint16_t num, HIDMessage *msg )
+{
+	uint16_t i;
+
+	if( msg->type != HID_TOUCHSCREEN )
+	{
+		return 0;
+	}
+	for( i = 0; i < num; i++ )
+	{
+		if( msg->x >= btn[ i ].x && msg->x <= btn[ i ].x + btn[ i ].width && msg->y >= btn[ i ].y &&
+			msg->y <= btn[ i ].y + btn[ i ].height )
+		{
+			return btn[ i ].msg_id;
+		}
+	}
+	return 0;
+}
+
+/* The test refreshes the window when it wants to. */
+portBASE_TYPE Win_PutWinMsg( uint16_t winid )
+{
+	( void ) winid;
+	return pdTRUE;
+}
+
+portBASE_TYPE TouchScreen_Calibrate( portBASE_TYPE cmd )
+{
+	( void ) cmd;
+	return pdTRUE;
+}
@@ -18,11 +18,14 @@
 /* FreeRTOS.org includes. */
 #include "FreeRTOS.h"
 #include "task.h"
+#include "semphr.h"
 
 /* Library includes. */
 #include "stm32f10x.h"
 #include "touchscreen.h"
 #include "spi.h"
+#include "enc28j60.h"
+#include "netbuf.h"
 
 /*
  * type define
@@ -152,6 +155,9 @@
 #define PHY_REG_PHCON1 0x00
 #define PHY_REG_PHCON2 0x10
 #define PHY_REG_PHLCON 0x14
+#define PHY_REG_PHSTAT2 0x11
+#define PHY_REG_PHIE 0x12
+#define PHY_REG_PHIR 0x13
 
 
 
@@ -280,6 +286,12 @@
  */
 #define ENC_PHSTAT1_LLSTAT 0x0004
 
+/*
+ * PHIE Bits
+ */
+#define ENC_PHIE_PLNKIE 0x0010
+#define ENC_PHIE_PGEIE  0x0002
+
 
 #define FAILSAFE_VALUE 5000
 
@@ -304,6 +316,27 @@
 #define ENC_INTERRUPT	GPIO_Pin_3	/* PE.03 */
 #define ENC_WOL			GPIO_Pin_2	/* PE.02 */
 
+#define ENC_INT_LINE	EXTI_Line3
+
+/* wait on the INT pin instead of polling the controller */
+#define CONFIG_USE_IRQ
+
+/*
+ * RBM/WBM bursts of ENC_DMA_MIN bytes or more go through DMA1 channel 4
+ * (SPI2_RX) and 5 (SPI2_TX).  Those channels also serve USART1, which
+ * driver/serial.c leaves off (USE_USART1).
+ */
+#ifndef ENC_SPI_DMA
+#define ENC_SPI_DMA		1
+#endif
+#define ENC_DMA_RX		DMA1_Channel4
+#define ENC_DMA_TX		DMA1_Channel5
+#define ENC_DMA_MIN		32
+#define ENC_DMA_TIMEOUT	( 20 / portTICK_RATE_MS )
+
+/* reads of ECON1 while waiting for the previous frame to leave */
+#define ENC_TX_WAIT		1000
+
 #define eth_getenv_enetaddr(name,mac) \
 		do { \
 			mac[0] = configMAC_ADDR0;\
@@ -327,23 +360,20 @@
 #define spi_write(byte) (u8)SPI_Send(SPI2,byte)
 #define spi_read()		spi_write(0xff)
 
-
-void uvIP_packge_proc(unsigned char * buffer, unsigned short length);
-#define NetReceive uvIP_packge_proc
-
 static unsigned char encReadReg (unsigned char regNo);
 static void encWriteReg (unsigned char regNo, unsigned char data);
 static void encWriteRegRetry (unsigned char regNo, unsigned char data, int c);
-static void encReadBuff (unsigned short length, unsigned char *pBuff);
-static void encWriteBuff (unsigned short length, unsigned char *pBuff);
+static int encReadBuff (unsigned short length, unsigned char *pBuff);
+static int encWriteBuff (unsigned short length, unsigned char *pBuff);
 static void encBitSet (unsigned char regNo, unsigned char data);
 static void encBitClr (unsigned char regNo, unsigned char data);
+static void encBank (unsigned char b);
 static void encReset (void);
 static void encInit (unsigned char *pEthAddr);
 static unsigned short phyRead (unsigned char addr);
 static void phyWrite(unsigned char, unsigned short);
-static void encPoll (void);
-static void encRx (void);
+static int encPoll (void);
+static int encRx (unsigned char count);
 
 #define m_nic_read(reg) encReadReg(reg)
 #define m_nic_write(reg, data) encWriteReg(reg, data)
@@ -357,14 +387,28 @@ static void encRx (void);
 /* bit field clear */
 #define m_nic_bfc(reg, data) encBitClr(reg, data)
 
-static unsigned char bank = 0;	/* current bank in enc28j60 */
-static unsigned char next_pointer_lsb;
-static unsigned char next_pointer_msb;
+/* select bank, no SPI traffic when it is already selected */
+#define m_nic_bank(b) encBank(b)
+
+static unsigned char bank = 0;	/* current bank in enc28j60, kept in step with ECON1 */
+static unsigned short next_pointer;	/* start of the next frame in the receive ring */
+static unsigned short read_pointer;	/* where ERDPT stands after the last RBM */
+static unsigned char link_event;
+static unsigned char rx_deferred;	/* packets left in the ring, pool empty */
+static unsigned char rx_masked;		/* EIE.PKTIE cleared for rx_deferred */
+
+static unsigned char rxResetPending = 0;
+static portTickType rxResetTick;
 
-static unsigned char buffer[ENC_MAX_FRM_LEN];
-static int rxResetCounter = 0;
+/* let the receiver settle before it is released from reset */
+#define RX_RESET_TIME ( 10 / portTICK_RATE_MS )
 
-#define RX_RESET_COUNTER 1000;
+static unsigned short enc_spi_cr1;	/* SPI2 CR1 as enc_cfg_spi() left it */
+
+#if ENC_SPI_DMA
+static xSemaphoreHandle xEncDmaDone = NULL;
+static unsigned char ucDmaDummy;
+#endif
 
 
 #if 0
@@ -411,7 +455,155 @@ void enc_cfg_spi(void)
   
   /* SPI1 enable */
   SPI_Cmd(SPI2, ENABLE);
+
+  enc_spi_cr1 = SPI2->CR1;
+}
+
+/*
+ * Take the bus and pull CS.  SPI2 is shared with the touch panel and the
+ * serial flash, it is only reprogrammed when one of them left another setup.
+ */
+static void encSelect (void)
+{
+	spi_lock ();
+	if (SPI2->CR1 != enc_spi_cr1)
+		enc_cfg_spi ();
+	enc_enable ();
+}
+
+static void encDeselect (void)
+{
+	enc_disable ();
+	spi_unlock ();
+}
+
+#if ENC_SPI_DMA
+static void encDmaInit (void)
+{
+	NVIC_InitTypeDef NVIC_InitStructure;
+
+	RCC_AHBPeriphClockCmd (RCC_AHBPeriph_DMA1, ENABLE);
+
+	if (xEncDmaDone == NULL) {
+		vSemaphoreCreateBinary (xEncDmaDone);
+		xSemaphoreTake (xEncDmaDone, 0);
+	}
+
+	NVIC_InitStructure.NVIC_IRQChannel = DMA1_Channel4_IRQn;
+	NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = configLIBRARY_KERNEL_INTERRUPT_PRIORITY;
+	NVIC_InitStructure.NVIC_IRQChannelSubPriority = 0;
+	NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
+	NVIC_Init (&NVIC_InitStructure);
+}
+
+static void encDmaChannel (DMA_Channel_TypeDef *xChannel, uint32_t ulDir,
+			   unsigned char *pBuf, unsigned short length)
+{
+	DMA_InitTypeDef DMA_InitStructure;
+
+	DMA_DeInit (xChannel);
+	DMA_InitStructure.DMA_PeripheralBaseAddr = (uint32_t) &SPI2->DR;
+	DMA_InitStructure.DMA_MemoryBaseAddr = (uint32_t) (pBuf != NULL ? pBuf : &ucDmaDummy);
+	DMA_InitStructure.DMA_DIR = ulDir;
+	DMA_InitStructure.DMA_BufferSize = length;
+	DMA_InitStructure.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
+	DMA_InitStructure.DMA_MemoryInc = (pBuf != NULL) ? DMA_MemoryInc_Enable : DMA_MemoryInc_Disable;
+	DMA_InitStructure.DMA_PeripheralDataSize = DMA_PeripheralDataSize_Byte;
+	DMA_InitStructure.DMA_MemoryDataSize = DMA_MemoryDataSize_Byte;
+	DMA_InitStructure.DMA_Mode = DMA_Mode_Normal;
+	/* RX above TX so a received byte is always taken before the next one */
+	DMA_InitStructure.DMA_Priority = (ulDir == DMA_DIR_PeripheralSRC) ? DMA_Priority_VeryHigh : DMA_Priority_High;
+	DMA_InitStructure.DMA_M2M = DMA_M2M_Disable;
+	DMA_Init (xChannel, &DMA_InitStructure);
+}
+
+/*
+ * Clock length bytes through SPI2 with CS already low and sleep until the
+ * last one is back.  pTx NULL sends filler, pRx NULL drops what comes in.
+ * Returns -1 when the burst did not finish in ENC_DMA_TIMEOUT, the
+ * controller then stands somewhere inside it.
+ */
+static int encDmaXfer (unsigned char *pTx, unsigned char *pRx, unsigned short length)
+{
+	int ret = 0;
+
+	/* a completion that came in after the last timeout would end this
+	   burst before it started */
+	xSemaphoreTake (xEncDmaDone, 0);
+
+	encDmaChannel (ENC_DMA_RX, DMA_DIR_PeripheralSRC, pRx, length);
+	encDmaChannel (ENC_DMA_TX, DMA_DIR_PeripheralDST, pTx, length);
+	DMA_ITConfig (ENC_DMA_RX, DMA_IT_TC, ENABLE);
+
+	/* a stale RXNE would shift the whole burst by one */
+	(void) SPI_I2S_ReceiveData (SPI2);
+
+	DMA_Cmd (ENC_DMA_RX, ENABLE);
+	DMA_Cmd (ENC_DMA_TX, ENABLE);
+	SPI_I2S_DMACmd (SPI2, SPI_I2S_DMAReq_Rx | SPI_I2S_DMAReq_Tx, ENABLE);
+
+	if (xSemaphoreTake (xEncDmaDone, ENC_DMA_TIMEOUT) != pdTRUE) {
+		xNetStats.ulSpiErrors++;
+		ret = -1;
+	}
+
+	SPI_I2S_DMACmd (SPI2, SPI_I2S_DMAReq_Rx | SPI_I2S_DMAReq_Tx, DISABLE);
+	DMA_Cmd (ENC_DMA_TX, DISABLE);
+	DMA_Cmd (ENC_DMA_RX, DISABLE);
+	return ret;
+}
+
+void DMA1_Channel4_IRQHandler (void)
+{
+portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+
+	DMA_ClearITPendingBit (DMA1_IT_GL4);
+	xSemaphoreGiveFromISR (xEncDmaDone, &xHigherPriorityTaskWoken);
+	portEND_SWITCHING_ISR (xHigherPriorityTaskWoken);
+}
+#endif
+
+#ifdef CONFIG_USE_IRQ
+/*
+ * INT is active low and held while an enabled EIR flag is set.  encPoll()
+ * drops EIE.INTIE while it works and sets it again on the way out, so any
+ * flag still pending then gives a fresh falling edge.
+ */
+static void encIntInit (void)
+{
+	EXTI_InitTypeDef EXTI_InitStructure;
+	NVIC_InitTypeDef NVIC_InitStructure;
+
+	RCC_APB2PeriphClockCmd (RCC_APB2Periph_AFIO, ENABLE);
+
+	/* Connect EXTI Line to GPIO Pin */
+	GPIO_EXTILineConfig (GPIO_PortSourceGPIOE, GPIO_PinSource3);
+
+	EXTI_InitStructure.EXTI_Line	= ENC_INT_LINE;
+	EXTI_InitStructure.EXTI_Mode 	= EXTI_Mode_Interrupt;
+	EXTI_InitStructure.EXTI_Trigger = EXTI_Trigger_Falling;
+	EXTI_InitStructure.EXTI_LineCmd = ENABLE;
+	EXTI_Init (&EXTI_InitStructure);
+
+	NVIC_InitStructure.NVIC_IRQChannel = EXTI3_IRQn;
+	NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = configLIBRARY_KERNEL_INTERRUPT_PRIORITY;
+	NVIC_InitStructure.NVIC_IRQChannelSubPriority = 0;
+	NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
+	NVIC_Init (&NVIC_InitStructure);
+}
+
+void EXTI3_IRQHandler (void)
+{
+extern xSemaphoreHandle xEMACSemaphore;
+portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+
+	EXTI_ClearITPendingBit (ENC_INT_LINE);
+
+	/* Ensure the uIP task is not blocked as the controller wants service. */
+	xSemaphoreGiveFromISR (xEMACSemaphore, &xHigherPriorityTaskWoken);
+	portEND_SWITCHING_ISR (xHigherPriorityTaskWoken);
 }
+#endif
 
 
 /*-----------------------------------------------------------------------------
@@ -461,8 +653,15 @@ int eth_init (bd_t * bis)
 	enc_reset_en();
 	vTaskDelay( 100 / portTICK_RATE_MS ); /* Delay 100 ms */
 	enc_reset_dis();
+	bank = 0;
 
 	enc_cfg_spi ();
+#if ENC_SPI_DMA
+	encDmaInit ();
+#endif
+#ifdef CONFIG_USE_IRQ
+	encIntInit ();
+#endif
 
 	/* taken from the Linux driver - dangerous stuff here! */
 	/* Wait for CLKRDY to become set (i.e., check that we can communicate with
@@ -493,16 +692,48 @@ unsigned char eth_check_link()
 	return 0;
 }
 
+/*-----------------------------------------------------------------------------
+ * Returns 1 while the previous frame is still going out.
+ */
+unsigned char eth_tx_busy (void)
+{
+	return (m_nic_read (CTL_REG_ECON1) & ENC_ECON1_TXRTS) ? 1 : 0;
+}
+
+/*-----------------------------------------------------------------------------
+ * Returns 1 once after the PHY reported a link change through INT.
+ */
+unsigned char eth_link_event (void)
+{
+	unsigned char ev = link_event;
+
+	link_event = 0;
+	return ev;
+}
+
 
+/*
+ * Returns -1 when the frame did not make it into the transmit buffer, it is
+ * dropped and the next one starts over at ETXST.
+ */
 int eth_send (volatile void *packet, int length)
 {
+	int i;
+
 	/* check frame length, etc. */
 	/* TODO: */
-	
-	/* switch to bank 0 */
-	m_nic_bfc (CTL_REG_ECON1, (ENC_ECON1_BSEL1 | ENC_ECON1_BSEL0));
 
-	/* set EWRPT */
+	/* the previous frame has to be on the wire before its buffer is reused */
+	for (i = 0; i < ENC_TX_WAIT; i++) {
+		if ((m_nic_read (CTL_REG_ECON1) & ENC_ECON1_TXRTS) == 0)
+			break;
+	}
+	if (i == ENC_TX_WAIT)
+		m_nic_bfc (CTL_REG_ECON1, ENC_ECON1_TXRTS);
+
+	m_nic_bank (0);
+
+	/* set EWRPT, ETXST is fixed by encInit() */
 	m_nic_write (CTL_REG_EWRPTL, (ENC_TX_BUF_START & 0xff));
 	m_nic_write (CTL_REG_EWRPTH, (ENC_TX_BUF_START >> 8));
 
@@ -510,12 +741,9 @@ int eth_send (volatile void *packet, int length)
 	m_nic_write (CTL_REG_ETXNDL, (length + ENC_TX_BUF_START) & 0xFF);
 	m_nic_write (CTL_REG_ETXNDH, (length + ENC_TX_BUF_START) >> 8);
 
-	/* set ETXST */
-	m_nic_write (CTL_REG_ETXSTL, ENC_TX_BUF_START & 0xFF);
-	m_nic_write (CTL_REG_ETXSTH, ENC_TX_BUF_START >> 8);
-
 	/* write packet */
-	m_nic_write_data (length, (unsigned char *) packet);
+	if (m_nic_write_data (length, (unsigned char *) packet) != 0)
+		return -1;
 
 	/* taken from the Linux driver */
 	/* Verify that the internal transmit logic has not been altered by excessive
@@ -545,7 +773,8 @@ static void encReceiverReset (void)
 	econ1 = m_nic_read (CTL_REG_ECON1);
 	if ((econ1 & ENC_ECON1_RXRST) == 0) {
 		m_nic_bfs (CTL_REG_ECON1, ENC_ECON1_RXRST);
-		rxResetCounter = RX_RESET_COUNTER;
+		rxResetTick = xTaskGetTickCount ();
+		rxResetPending = 1;
 	}
 }
 
@@ -554,23 +783,41 @@ static void encReceiverReset (void)
  */
 static void encReceiverResetCallback (void)
 {
+	unsigned char i;
+
 	m_nic_bfc (CTL_REG_ECON1, ENC_ECON1_RXRST);
+
+	/* start the ring over as encInit() sets it up, what it held is lost */
+	m_nic_bank (0);
+	m_nic_write (CTL_REG_ERXSTL, (ENC_RX_BUF_START & 0xFF));
+	m_nic_write (CTL_REG_ERXSTH, (ENC_RX_BUF_START >> 8));
+	m_nic_write (CTL_REG_ERDPTL, (ENC_RX_BUF_START & 0xFF));
+	m_nic_write (CTL_REG_ERDPTH, (ENC_RX_BUF_START >> 8));
+	m_nic_write (CTL_REG_ERXRDPTL, (ENC_RX_BUF_END & 0xFF));
+	m_nic_write (CTL_REG_ERXRDPTH, (ENC_RX_BUF_END >> 8));
+	next_pointer = ENC_RX_BUF_START;
+	read_pointer = ENC_RX_BUF_START;
+
+	m_nic_bank (1);
+	for (i = m_nic_read (CTL_REG_EPKTCNT); i > 0; i--)
+		m_nic_bfs (CTL_REG_ECON2, ENC_ECON2_PKTDEC);
+
 	m_nic_bfs (CTL_REG_ECON1, ENC_ECON1_RXEN);	/* enable receive */
 }
 
 /*-----------------------------------------------------------------------------
- * Check for received packets. Call NetReceive for each packet. The return
- * value is ignored by the caller.
+ * Drain the receive ring into pool buffers queued for the uIP task. Returns
+ * the number of packets taken off the controller.
  */
 int eth_rx (void)
 {
-	if (rxResetCounter > 0 && --rxResetCounter == 0) {
+	if (rxResetPending &&
+	    (portTickType) (xTaskGetTickCount () - rxResetTick) >= RX_RESET_TIME) {
+		rxResetPending = 0;
 		encReceiverResetCallback ();
 	}
 
-	encPoll ();
-
-	return 0;
+	return encPoll ();
 }
 
 void eth_halt (void)
@@ -580,82 +827,123 @@ void eth_halt (void)
 
 /*****************************************************************************/
 
-static void encPoll (void)
+static int encPoll (void)
 {
 	unsigned char eir_reg;
-	volatile unsigned char estat_reg;
 	unsigned char pkt_cnt;
+	int frames = 0;
 
 #ifdef CONFIG_USE_IRQ
 	/* clear global interrupt enable bit in enc28j60 */
 	m_nic_bfc (CTL_REG_EIE, ENC_EIE_INTIE);
 #endif
-	estat_reg = m_nic_read (CTL_REG_ESTAT);
-
 	eir_reg = m_nic_read (CTL_REG_EIR);
 
-	if (eir_reg & ENC_EIR_TXIF) {
-		/* clear TXIF bit in EIR */
-		m_nic_bfc (CTL_REG_EIR, ENC_EIR_TXIF);
+	if (eir_reg & ENC_EIR_RXERIF)
+		xNetStats.ulRxOverflow++;
+
+	if (eir_reg & ENC_EIR_LINKIF) {
+		/* reading PHIR clears LINKIF */
+		phyRead (PHY_REG_PHIR);
+		link_event = 1;
 	}
 
 	/* We have to use pktcnt and not pktif bit, see errata pt. 6 */
-
-	/* move to bank 1 */
-	m_nic_bfc (CTL_REG_ECON1, ENC_ECON1_BSEL1);
-	m_nic_bfs (CTL_REG_ECON1, ENC_ECON1_BSEL0);
-
-	/* read pktcnt */
+	m_nic_bank (1);
 	pkt_cnt = m_nic_read (CTL_REG_EPKTCNT);
 
-	if (pkt_cnt > 0) {
-		if ((eir_reg & ENC_EIR_PKTIF) == 0) {
-			/*printf("encPoll: pkt cnt > 0, but pktif not set\n"); */
-		}
-		encRx ();
-		/* clear PKTIF bit in EIR, this should not need to be done but it
-		   seems like we get problems if we do not */
-		m_nic_bfc (CTL_REG_EIR, ENC_EIR_PKTIF);
+	/* take everything that is there, and whatever came in meanwhile */
+	rx_deferred = 0;
+	while (pkt_cnt > 0) {
+		frames += encRx (pkt_cnt);
+		if (rxResetPending || rx_deferred)
+			break;
+		m_nic_bank (1);
+		pkt_cnt = m_nic_read (CTL_REG_EPKTCNT);
 	}
 
-	if (eir_reg & ENC_EIR_RXERIF) {
-		//printf ("encPoll: rx error\n");
-		m_nic_bfc (CTL_REG_EIR, ENC_EIR_RXERIF);
-	}
-	if (eir_reg & ENC_EIR_TXERIF) {
-		//printf ("encPoll: tx error\n");
-	//	m_nic_bfc (CTL_REG_EIR, ENC_EIR_TXERIF);
-	}
+	/* clear PKTIF bit in EIR, this should not need to be done but it
+	   seems like we get problems if we do not */
+	if (frames > 0)
+		eir_reg |= ENC_EIR_PKTIF;
+	eir_reg &= (ENC_EIR_PKTIF | ENC_EIR_TXIF | ENC_EIR_RXERIF);
+	if (eir_reg)
+		m_nic_bfc (CTL_REG_EIR, eir_reg);
 
 #ifdef CONFIG_USE_IRQ
+	/* PKTIF stays set while packets wait, mask it until the pool has room
+	   again or INT would never let go */
+	if (rx_deferred != rx_masked) {
+		rx_masked = rx_deferred;
+		if (rx_masked)
+			m_nic_bfc (CTL_REG_EIE, ENC_EIE_PKTIE);
+		else
+			m_nic_bfs (CTL_REG_EIE, ENC_EIE_PKTIE);
+	}
+
 	/* set global interrupt enable bit in enc28j60 */
 	m_nic_bfs (CTL_REG_EIE, ENC_EIE_INTIE);
 #endif
+
+	return frames;
 }
 
-static void encRx (void)
+/* ERDPT wraps from ERXND to ERXST on its own while reading */
+static unsigned short encRxAdvance (unsigned short ptr, unsigned short n)
 {
+	ptr += n;
+	if (ptr > ENC_RX_BUF_END)
+		ptr -= (ENC_RX_BUF_END - ENC_RX_BUF_START + 1);
+	return ptr;
+}
+
+/*
+ * Read count packets out of the receive ring. ERDPT is only rewritten when
+ * it does not already stand on the next packet, i.e. after odd lengths and
+ * dropped packets.
+ */
+static int encRx (unsigned char count)
+{
+	unsigned char header[6];
 	unsigned short pkt_len;
 	unsigned short copy_len;
 	unsigned short status;
-	unsigned char eir_reg;
-	unsigned char pkt_cnt = 0;
 	unsigned short rxbuf_rdpt;
+	xNetBuf *pxBuf;
+	int frames = 0;
 
-	/* switch to bank 0 */
-	m_nic_bfc (CTL_REG_ECON1, (ENC_ECON1_BSEL1 | ENC_ECON1_BSEL0));
+	do {
+		/* with the pool empty the packet stays in the controller's ring
+		   until vNetBufFree() wakes us again */
+		pxBuf = pxNetBufAlloc ();
+		if (pxBuf == NULL) {
+			rx_deferred = 1;
+			xNetStats.ulRxDeferred++;
+			break;
+		}
 
-	m_nic_write (CTL_REG_ERDPTL, next_pointer_lsb);
-	m_nic_write (CTL_REG_ERDPTH, next_pointer_msb);
+		/* a PHY read or eth_send() may have left another bank selected */
+		m_nic_bank (0);
 
-	do {
-		m_nic_read_data (6, buffer);
-		next_pointer_lsb = buffer[0];
-		next_pointer_msb = buffer[1];
-		pkt_len = buffer[2];
-		pkt_len |= (unsigned short) buffer[3] << 8;
-		status = buffer[4];
-		status |= (unsigned short) buffer[5] << 8;
+		if (read_pointer != next_pointer) {
+			m_nic_write (CTL_REG_ERDPTL, next_pointer & 0xFF);
+			m_nic_write (CTL_REG_ERDPTH, next_pointer >> 8);
+			read_pointer = next_pointer;
+		}
+
+		/* a burst cut short leaves ERDPT anywhere in the ring */
+		if (m_nic_read_data (6, header) != 0) {
+			vNetBufFree (pxBuf);
+			encReceiverReset ();
+			break;
+		}
+		read_pointer = encRxAdvance (read_pointer, 6);
+		next_pointer = header[0];
+		next_pointer |= (unsigned short) header[1] << 8;
+		pkt_len = header[2];
+		pkt_len |= (unsigned short) header[3] << 8;
+		status = header[4];
+		status |= (unsigned short) header[5] << 8;
 
 		if (pkt_len <= ENC_MAX_FRM_LEN)
 			copy_len = pkt_len;
@@ -667,110 +955,71 @@ static void encRx (void)
 
 		/* taken from the Linux driver */
 		/* check if next pointer is resonable */
-		if ((((unsigned int)next_pointer_msb << 8) |
-			(unsigned int)next_pointer_lsb) >= ENC_TX_BUF_START)
+		if (next_pointer >= ENC_TX_BUF_START)
 			copy_len = 0;
 
-		if (copy_len > 0) {
-			m_nic_read_data (copy_len, buffer);
+		/* a good packet too long for uIP is skipped, not an error */
+		if (copy_len > netBUF_SIZE)
+			xNetStats.ulRxTooLong++;
+		if (copy_len > 0 && copy_len <= netBUF_SIZE) {
+			if (m_nic_read_data (copy_len, pxBuf->ucData) != 0) {
+				vNetBufFree (pxBuf);
+				encReceiverReset ();
+				break;
+			}
+			read_pointer = encRxAdvance (read_pointer, copy_len);
+			pxBuf->usLength = copy_len;
+		} else {
+			vNetBufFree (pxBuf);
+			pxBuf = NULL;
 		}
 
-		/* advance read pointer to next pointer */
-		m_nic_write (CTL_REG_ERDPTL, next_pointer_lsb);
-		m_nic_write (CTL_REG_ERDPTH, next_pointer_msb);
-
-		/* decrease packet counter */
-		m_nic_bfs (CTL_REG_ECON2, ENC_ECON2_PKTDEC);
-
 		/* taken from the Linux driver */
 		/* Only odd values should be written to ERXRDPTL,
 		 * see errata B4 pt.13
 		 */
-		rxbuf_rdpt = (next_pointer_msb << 8 | next_pointer_lsb) - 1;
-		if ((rxbuf_rdpt < (m_nic_read(CTL_REG_ERXSTH) << 8 |
-				m_nic_read(CTL_REG_ERXSTL))) || (rxbuf_rdpt >
-				(m_nic_read(CTL_REG_ERXNDH) << 8 |
-				m_nic_read(CTL_REG_ERXNDL)))) {
-			m_nic_write(CTL_REG_ERXRDPTL, m_nic_read(CTL_REG_ERXNDL));
-			m_nic_write(CTL_REG_ERXRDPTH, m_nic_read(CTL_REG_ERXNDH));
-		} else {
-			m_nic_write(CTL_REG_ERXRDPTL, rxbuf_rdpt & 0xFF);
-			m_nic_write(CTL_REG_ERXRDPTH, rxbuf_rdpt >> 8);
-		}
-
-		/* move to bank 1 */
-		m_nic_bfc (CTL_REG_ECON1, ENC_ECON1_BSEL1);
-		m_nic_bfs (CTL_REG_ECON1, ENC_ECON1_BSEL0);
+		rxbuf_rdpt = next_pointer - 1;
+		if (rxbuf_rdpt < ENC_RX_BUF_START || rxbuf_rdpt > ENC_RX_BUF_END)
+			rxbuf_rdpt = ENC_RX_BUF_END;
+		m_nic_write (CTL_REG_ERXRDPTL, rxbuf_rdpt & 0xFF);
+		m_nic_write (CTL_REG_ERXRDPTH, rxbuf_rdpt >> 8);
 
-		/* read pktcnt */
-		pkt_cnt = m_nic_read (CTL_REG_EPKTCNT);
-
-		/* switch to bank 0 */
-		m_nic_bfc (CTL_REG_ECON1,
-			   (ENC_ECON1_BSEL1 | ENC_ECON1_BSEL0));
+		/* decrease packet counter */
+		m_nic_bfs (CTL_REG_ECON2, ENC_ECON2_PKTDEC);
 
 		if (copy_len == 0) {
-			eir_reg = m_nic_read (CTL_REG_EIR);
+			/* the ring can not be trusted any more */
 			encReceiverReset ();
-			//printf ("eth_rx: copy_len=0\n");
-			continue;
+			break;
 		}
 
-		NetReceive ((unsigned char *) buffer, pkt_len);
+		if (pxBuf != NULL)
+			vNetBufQueueRx (pxBuf);
+		frames++;
+	} while (--count);
 
-		eir_reg = m_nic_read (CTL_REG_EIR);
-	} while (pkt_cnt);	/* Use EPKTCNT not EIR.PKTIF flag, see errata pt. 6 */
+	return frames;
 }
 
 static void encWriteReg (unsigned char regNo, unsigned char data)
 {
-	spi_lock ();
-	enc_cfg_spi ();
-	enc_enable ();
+	encSelect ();
 
 	spi_write (0x40 | regNo);	/* write in regNo */
 	spi_write (data);
 
-	enc_disable ();
-	enc_enable ();
-
-	spi_write (0x1f);	/* write reg 0x1f */
-
-	enc_disable ();
-	spi_unlock ();
+	encDeselect ();
 }
 
 static void encWriteRegRetry (unsigned char regNo, unsigned char data, int c)
 {
-	unsigned char readback;
 	int i;
 
-	spi_lock ();
-
 	for (i = 0; i < c; i++) {
-		enc_cfg_spi ();
-		enc_enable ();
-
-		spi_write (0x40 | regNo);	/* write in regNo */
-		spi_write (data);
-
-		enc_disable ();
-		enc_enable ();
-
-		spi_write (0x1f);	/* write reg 0x1f */
-
-		enc_disable ();
-
-		spi_unlock ();	/* we must unlock spi first */
-
-		readback = encReadReg (regNo);
-
-		spi_lock ();
-
-		if (readback == data)
+		encWriteReg (regNo, data);
+		if (encReadReg (regNo) == data)
 			break;
 	}
-	spi_unlock ();
 
 	if (i == c) {
 		//printf ("enc28j60: write reg %d failed\n", regNo);
@@ -781,16 +1030,7 @@ static unsigned char encReadReg (unsigned char regNo)
 {
 	unsigned char rxByte;
 
-	spi_lock ();
-	enc_cfg_spi ();
-	enc_enable ();
-
-	spi_write (0x1f);	/* read reg 0x1f */
-
-	bank = spi_read () & 0x3;
-
-	enc_disable ();
-	enc_enable ();
+	encSelect ();
 
 	spi_write (regNo);
 	rxByte = spi_read ();
@@ -802,20 +1042,26 @@ static unsigned char encReadReg (unsigned char regNo)
 		rxByte = spi_read ();
 	}
 
-	enc_disable ();
-	spi_unlock ();
+	encDeselect ();
 
 	return rxByte;
 }
 
-static void encReadBuff (unsigned short length, unsigned char *pBuff)
+/* Both return 0, or -1 when a DMA burst was cut short. */
+static int encReadBuff (unsigned short length, unsigned char *pBuff)
 {
-	spi_lock ();
-	enc_cfg_spi ();
-	enc_enable ();
+	int ret = 0;
+
+	encSelect ();
 
 	spi_write (0x20 | 0x1a);	/* read buffer memory */
 
+#if ENC_SPI_DMA
+	if (length >= ENC_DMA_MIN) {
+		ret = encDmaXfer (NULL, pBuff, length);
+		length = 0;
+	}
+#endif
 	while (length--) {
 		if (pBuff != NULL)
 			*pBuff++ = spi_read ();
@@ -823,76 +1069,90 @@ static void encReadBuff (unsigned short length, unsigned char *pBuff)
 			spi_write (0);
 	}
 
-	enc_disable ();
-	spi_unlock ();
+	encDeselect ();
+	return ret;
 }
 
-static void encWriteBuff (unsigned short length, unsigned char *pBuff)
+static int encWriteBuff (unsigned short length, unsigned char *pBuff)
 {
-	spi_lock ();
-	enc_cfg_spi ();
-	enc_enable ();
+	int ret = 0;
+
+	encSelect ();
 
 	spi_write (0x60 | 0x1a);	/* write buffer memory */
 
 	spi_write (0x00);	/* control byte */
 
+#if ENC_SPI_DMA
+	if (length >= ENC_DMA_MIN) {
+		ret = encDmaXfer (pBuff, NULL, length);
+		length = 0;
+	}
+#endif
 	while (length--)
 		spi_write (*pBuff++);
 
-	enc_disable ();
-	spi_unlock ();
+	encDeselect ();
+	return ret;
 }
 
 static void encBitSet (unsigned char regNo, unsigned char data)
 {
-	spi_lock ();
-	enc_cfg_spi ();
-	enc_enable ();
+	encSelect ();
 
 	spi_write (0x80 | regNo);	/* bit field set */
 	spi_write (data);
 
-	enc_disable ();
-	spi_unlock ();
+	encDeselect ();
 }
 
 static void encBitClr (unsigned char regNo, unsigned char data)
 {
-	spi_lock ();
-	enc_cfg_spi ();
-	enc_enable ();
+	encSelect ();
 
 	spi_write (0xA0 | regNo);	/* bit field clear */
 	spi_write (data);
 
-	enc_disable ();
-	spi_unlock ();
+	encDeselect ();
+}
+
+/*
+ * Switch ECON1.BSEL to bank b, touching only the bits that differ from the
+ * cached bank.
+ */
+static void encBank (unsigned char b)
+{
+	if (b == bank)
+		return;
+	if (bank & ~b)
+		m_nic_bfc (CTL_REG_ECON1, bank & ~b);
+	if (b & ~bank)
+		m_nic_bfs (CTL_REG_ECON1, b & ~bank);
+	bank = b;
 }
 
 static void encReset (void)
 {
-	spi_lock ();
-	enc_cfg_spi ();
-	enc_enable ();
+	encSelect ();
 
 	spi_write (0xff);	/* soft reset */
 
-	enc_disable ();
-	spi_unlock ();
+	encDeselect ();
+
+	/* soft reset clears ECON1 */
+	bank = 0;
 
 	/* sleep 1 ms. See errata pt. 2 */
 	vTaskDelay( 1 / portTICK_RATE_MS ); /* Delay 1 ms */
 }
 
-
 static void encInit (unsigned char *pEthAddr)
 {
 	unsigned short phid1 = 0;
 	unsigned short phid2 = 0;
 
 	/* switch to bank 0 */
-	m_nic_bfc (CTL_REG_ECON1, (ENC_ECON1_BSEL1 | ENC_ECON1_BSEL0));
+	m_nic_bank (0);
 
 	/*
 	 * Setup the buffer space. The reset values are valid for the
@@ -910,8 +1170,12 @@ static void encInit (unsigned char *pEthAddr)
 	m_nic_write_retry (CTL_REG_ERDPTL, (ENC_RX_BUF_START & 0xFF), 1);
 	m_nic_write_retry (CTL_REG_ERDPTH, (ENC_RX_BUF_START >> 8), 1);
 
-	next_pointer_lsb = (ENC_RX_BUF_START & 0xFF);
-	next_pointer_msb = (ENC_RX_BUF_START >> 8);
+	next_pointer = ENC_RX_BUF_START;
+	read_pointer = ENC_RX_BUF_START;
+
+	/* the transmit buffer never moves, eth_send() only sets its end */
+	m_nic_write (CTL_REG_ETXSTL, ENC_TX_BUF_START & 0xFF);
+	m_nic_write (CTL_REG_ETXSTH, ENC_TX_BUF_START >> 8);
 
 	/* verify identification */
 	phid1 = phyRead (PHY_REG_PHID1);
@@ -933,8 +1197,7 @@ static void encInit (unsigned char *pEthAddr)
 	/* Pull MAC out of Reset */
 
 	/* switch to bank 2 */
-	m_nic_bfc (CTL_REG_ECON1, ENC_ECON1_BSEL0);
-	m_nic_bfs (CTL_REG_ECON1, ENC_ECON1_BSEL1);
+	m_nic_bank (2);
 
 	/* enable MAC to receive frames */
 	/* added some bits from the Linux driver */
@@ -977,7 +1240,7 @@ static void encInit (unsigned char *pEthAddr)
 	/* set MAC address */
 
 	/* switch to bank 3 */
-	m_nic_bfs (CTL_REG_ECON1, (ENC_ECON1_BSEL0 | ENC_ECON1_BSEL1));
+	m_nic_bank (3);
 
 	m_nic_write_retry (CTL_REG_MAADR0, pEthAddr[5], 1);
 	m_nic_write_retry (CTL_REG_MAADR1, pEthAddr[4], 1);
@@ -1009,12 +1272,17 @@ static void encInit (unsigned char *pEthAddr)
 	 */
 
 #ifdef CONFIG_USE_IRQ
-	/* enable interrupts */
-	m_nic_bfs (CTL_REG_EIE, ENC_EIE_PKTIE);
-	m_nic_bfs (CTL_REG_EIE, ENC_EIE_TXIE);
-	m_nic_bfs (CTL_REG_EIE, ENC_EIE_RXERIE);
-	m_nic_bfs (CTL_REG_EIE, ENC_EIE_TXERIE);
-	m_nic_bfs (CTL_REG_EIE, ENC_EIE_INTIE);
+	/* link changes raise LINKIF through the PHY */
+	phyWrite (PHY_REG_PHIE, ENC_PHIE_PGEIE | ENC_PHIE_PLNKIE);
+	phyRead (PHY_REG_PHIR);
+
+	/* enable interrupts, TXIF wakes the driver task for the next queued
+	   frame, TXERIF is handled by eth_send() */
+	link_event = 0;
+	rx_deferred = 0;
+	rx_masked = 0;
+	m_nic_bfs (CTL_REG_EIE, ENC_EIE_PKTIE | ENC_EIE_RXERIE | ENC_EIE_TXIE |
+			ENC_EIE_LINKIE | ENC_EIE_INTIE);
 #endif
 }
 
@@ -1036,8 +1304,7 @@ static unsigned short phyRead (unsigned char addr)
 	unsigned short ret = 0;
 
 	/* move to bank 2 */
-	m_nic_bfc (CTL_REG_ECON1, ENC_ECON1_BSEL0);
-	m_nic_bfs (CTL_REG_ECON1, ENC_ECON1_BSEL1);
+	m_nic_bank (2);
 
 	/* write address to MIREGADR */
 	m_nic_write (CTL_REG_MIREGADR, addr);
@@ -1047,8 +1314,7 @@ static unsigned short phyRead (unsigned char addr)
 
 	/* taken from the Linux driver */
 	/* move to bank 3 */
-	m_nic_bfs(CTL_REG_ECON1, ENC_ECON1_BSEL0);
-	m_nic_bfs(CTL_REG_ECON1, ENC_ECON1_BSEL1);
+	m_nic_bank (3);
 
 	/* poll MISTAT.BUSY bit until operation is complete */
 	while ((m_nic_read (CTL_REG_MISTAT) & ENC_MISTAT_BUSY) != 0) {
@@ -1063,8 +1329,7 @@ static unsigned short phyRead (unsigned char addr)
 
 	/* taken from the Linux driver */
 	/* move to bank 2 */
-	m_nic_bfc(CTL_REG_ECON1, ENC_ECON1_BSEL0);
-	m_nic_bfs(CTL_REG_ECON1, ENC_ECON1_BSEL1);
+	m_nic_bank (2);
 
 	/* clear MICMD.MIIRD */
 	m_nic_write (CTL_REG_MICMD, 0);
@@ -1093,8 +1358,7 @@ static unsigned short phyRead (unsigned char addr)
 static void phyWrite(unsigned char addr, unsigned short data)
 {
 	/* move to bank 2 */
-	m_nic_bfc(CTL_REG_ECON1, ENC_ECON1_BSEL0);
-	m_nic_bfs(CTL_REG_ECON1, ENC_ECON1_BSEL1);
+	m_nic_bank (2);
 
 	/* write address to MIREGADR */
 	m_nic_write(CTL_REG_MIREGADR, addr);
@@ -1103,8 +1367,7 @@ static void phyWrite(unsigned char addr, unsigned short data)
 	m_nic_write(CTL_REG_MIWRH, data >> 8);
 
 	/* move to bank 3 */
-	m_nic_bfs(CTL_REG_ECON1, ENC_ECON1_BSEL0);
-	m_nic_bfs(CTL_REG_ECON1, ENC_ECON1_BSEL1);
+	m_nic_bank (3);
 
 	/* poll MISTAT.BUSY bit until operation is complete */
 	while((m_nic_read(CTL_REG_MISTAT) & ENC_MISTAT_BUSY) != 0) {
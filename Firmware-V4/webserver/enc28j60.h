@@ -0,0 +1,40 @@
+#ifndef ENC28J60__H
+#define ENC28J60__H
+
+/*
+ * Reset and set up the ENC28J60 on SPI2.  Returns 0 when the controller does
+ * not answer.
+ */
+int eth_init( unsigned char *bis );
+
+/*
+ * Read the PHY link status, returns 1 when the link is up.
+ */
+unsigned char eth_check_link( void );
+
+/*
+ * Returns 1 once after the PHY reported a link change.
+ */
+unsigned char eth_link_event( void );
+
+/*
+ * Move every packet waiting in the controller into pool buffers queued on
+ * xNetRxQueue and return how many there were.  xEMACSemaphore is given from
+ * the INT pin whenever there is work for this call.
+ */
+int eth_rx( void );
+
+/*
+ * Copy length bytes into the controller and start the transmission.
+ */
+int eth_send( volatile void *packet, int length );
+
+/*
+ * Returns 1 while the previous frame is still going out.  Its end raises
+ * INT, so a caller can wait on xEMACSemaphore instead of polling.
+ */
+unsigned char eth_tx_busy( void );
+
+void eth_halt( void );
+
+#endif
@@ -32,3 +32,15 @@ extern const char http_gif[5];
 extern const char http_jpg[5];
 extern const char http_text[5];
 extern const char http_txt[5];
+extern const char http_content_type_json[35];
+extern const char http_content_type_csv[27];
+extern const char http_api[6];
+extern const char http_csv[5];
+extern const char http_header_304[94];
+extern const char http_header_406[96];
+extern const char http_accept_encoding[17];
+extern const char http_if_none_match[15];
+extern const char http_gzip[5];
+extern const char http_content_encoding_gzip[25];
+extern const char http_etag[7];
+extern const char http_cache_control[29];
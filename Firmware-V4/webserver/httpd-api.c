@@ -0,0 +1,399 @@
+#include "FreeRTOS.h"
+#include "uip.h"
+#include "psock.h"
+#include "httpd.h"
+#include "httpd-api.h"
+#include "http-strings.h"
+#include "netbuf.h"
+#include "modbus.h"
+
+#include <string.h>
+
+#define ISO_nl      0x0a
+#define ISO_period  0x2e
+
+#define API_SEQ    0  /* sample number, counts control periods */
+#define API_U16    1
+#define API_S16    2
+#define API_FLOAT  3  /* two registers, high half first */
+
+/* Longest field: 7 character name, quotes and colon, a 10 digit number,
+   the separator and the braces. */
+#define API_FIELD_MAX 24
+
+#define API_HEAD_MAX  (sizeof(http_header_200) + sizeof(http_content_type_json))
+
+struct api_field {
+  const char *name;
+  unsigned char reg;
+  unsigned char kind;
+};
+
+static const struct api_field fields[] = {
+  { "seq",     0,                API_SEQ },
+  { "st_l",    MB_HV_ST_L,       API_U16 },
+  { "vset_l",  MB_VOL_SET_L_ST,  API_U16 },
+  { "iset_l",  MB_CUR_SET_L_ST,  API_U16 },
+  { "v_l",     MB_VOL_FB_L,      API_U16 },
+  { "i_l",     MB_CUR_FB_L,      API_U16 },
+  { "st_r",    MB_HV_ST_R,       API_U16 },
+  { "vset_r",  MB_VOL_SET_R_ST,  API_U16 },
+  { "iset_r",  MB_CUR_SET_R_ST,  API_U16 },
+  { "v_r",     MB_VOL_FB_R,      API_U16 },
+  { "i_r",     MB_CUR_FB_R,      API_U16 },
+  { "pump_hz", MB_MPUMP_FREQ,    API_U16 },
+  { "vac",     MB_VMETER0,       API_FLOAT },
+  { "t00",     MB_TEMP00,        API_S16 },
+  { "t01",     MB_TEMP01,        API_S16 },
+  { "t10",     MB_TEMP10,        API_S16 },
+  { "t11",     MB_TEMP11,        API_S16 },
+};
+
+#define API_NFIELDS (sizeof(fields) / sizeof(fields[0]))
+
+static volatile unsigned long sample_seq;
+static unsigned long polled_seq;
+static volatile unsigned char streams;
+
+/*---------------------------------------------------------------------------*/
+static unsigned char
+field_regs(unsigned char f)
+{
+  switch(fields[f].kind) {
+  case API_SEQ:
+    return 0;
+  case API_FLOAT:
+    return 2;
+  default:
+    return 1;
+  }
+}
+/*---------------------------------------------------------------------------*/
+static unsigned short *
+field_val(struct httpd_state *s, unsigned char f)
+{
+  unsigned char i, n = 0;
+
+  for(i = 0; i < f; i++) {
+    n += field_regs(i);
+  }
+  return &s->apival[n];
+}
+/*---------------------------------------------------------------------------*/
+static void
+take_sample(struct httpd_state *s)
+{
+  unsigned char f;
+
+  s->apiseq = sample_seq;
+  for(f = 0; f < API_NFIELDS; f++) {
+    if(field_regs(f) > 0) {
+      eMBRegInput_ReadBlock(fields[f].reg, field_val(s, f), field_regs(f));
+    }
+  }
+}
+/*---------------------------------------------------------------------------*/
+static char *
+put_str(char *p, const char *str)
+{
+  while(*str) {
+    *p++ = *str++;
+  }
+  return p;
+}
+/*---------------------------------------------------------------------------*/
+static char *
+put_uint(char *p, unsigned long n)
+{
+  char digits[10];
+  unsigned char i = 0;
+
+  do {
+    digits[i++] = '0' + n % 10;
+    n /= 10;
+  } while(n > 0);
+  while(i > 0) {
+    *p++ = digits[--i];
+  }
+  return p;
+}
+/*---------------------------------------------------------------------------*/
+static char *
+put_int(char *p, long n)
+{
+  if(n < 0) {
+    *p++ = '-';
+    n = -n;
+  }
+  return put_uint(p, n);
+}
+/*---------------------------------------------------------------------------*/
+/* Three significant digits, d.dde[-]x, enough for a vacuum gauge. */
+static char *
+put_float(char *p, float v)
+{
+  unsigned short n;
+  int e = 0;
+
+  if(v != v || v > 1e30f || v < -1e30f) {
+    return put_str(p, "null");
+  }
+  if(v < 0) {
+    *p++ = '-';
+    v = -v;
+  }
+  if(v < 1e-30f) {
+    return put_str(p, "0");
+  }
+  while(v >= 10.0f) {
+    v /= 10.0f;
+    e++;
+  }
+  while(v < 1.0f) {
+    v *= 10.0f;
+    e--;
+  }
+  n = (unsigned short)(v * 100.0f + 0.5f);
+  if(n >= 1000) {
+    n /= 10;
+    e++;
+  }
+  *p++ = '0' + n / 100;
+  *p++ = '.';
+  *p++ = '0' + n / 10 % 10;
+  *p++ = '0' + n % 10;
+  *p++ = 'e';
+  return put_int(p, e);
+}
+/*---------------------------------------------------------------------------*/
+static char *
+put_value(char *p, struct httpd_state *s, unsigned char f)
+{
+  unsigned short *v = field_val(s, f);
+  unsigned long bits;
+  float fv;
+
+  switch(fields[f].kind) {
+  case API_SEQ:
+    return put_uint(p, s->apiseq);
+  case API_S16:
+    return put_int(p, (short)v[0]);
+  case API_FLOAT:
+    bits = ((unsigned long)v[0] << 16) | v[1];
+    memcpy(&fv, &bits, sizeof(fv));
+    return put_float(p, fv);
+  default:
+    return put_uint(p, v[0]);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static const char *
+api_type(struct httpd_state *s)
+{
+  return (s->api & HTTPD_API_CSV) ? http_content_type_csv : http_content_type_json;
+}
+/*---------------------------------------------------------------------------*/
+/* Fill one segment from s->apifield on, the fields that fit go in whole.
+   A retransmission calls this again and gets the same bytes, the sample is
+   kept in s->apival until the segment is acked. */
+static unsigned short
+generate_fields(void *state)
+{
+  struct httpd_state *s = (struct httpd_state *)state;
+  char *p = (char *)uip_appdata;
+  char *end = p + uip_mss();
+  unsigned char f = s->apifield;
+  unsigned char csv = s->api & HTTPD_API_CSV;
+  unsigned char names = s->api & HTTPD_API_NAMES;
+
+  if(s->api & HTTPD_API_HEAD) {
+    p = put_str(p, http_header_200);
+    p = put_str(p, api_type(s));
+  }
+
+  for(; f < API_NFIELDS && end - p >= API_FIELD_MAX; f++) {
+    if(f == 0 && !csv) {
+      *p++ = '{';
+    }
+    if(names || !csv) {
+      if(!csv) {
+        *p++ = '"';
+      }
+      p = put_str(p, fields[f].name);
+      if(!csv) {
+        *p++ = '"';
+        *p++ = ':';
+      }
+    }
+    if(!names) {
+      p = put_value(p, s, f);
+    }
+    if(f < API_NFIELDS - 1) {
+      *p++ = ',';
+    } else {
+      if(!csv) {
+        *p++ = '}';
+      }
+      *p++ = ISO_nl;
+    }
+  }
+  s->apinext = f;
+
+  return (unsigned short)(p - (char *)uip_appdata);
+}
+/*---------------------------------------------------------------------------*/
+/* The headers alone, from s->count on, for a peer with a very small MSS. */
+static unsigned short
+generate_head(void *state)
+{
+  struct httpd_state *s = (struct httpd_state *)state;
+  const char *type = api_type(s);
+  char *p = (char *)uip_appdata;
+  unsigned short i = s->count, hlen = strlen(http_header_200);
+  unsigned short n = 0;
+
+  while(n < uip_mss()) {
+    if(i < hlen) {
+      p[n] = http_header_200[i];
+    } else if(type[i - hlen] != 0) {
+      p[n] = type[i - hlen];
+    } else {
+      break;
+    }
+    i++;
+    n++;
+  }
+  s->len = n;
+
+  return n;
+}
+/*---------------------------------------------------------------------------*/
+static
+PT_THREAD(send_fields(struct httpd_state *s))
+{
+  PSOCK_BEGIN(&s->sout);
+
+  /* The headers ride in the first segment unless the peer's MSS leaves no
+     room for a field after them. */
+  if((s->api & HTTPD_API_HEAD) && uip_mss() < API_HEAD_MAX + API_FIELD_MAX) {
+    /* An empty segment is never acked, stop after the last byte. */
+    s->count = 0;
+    do {
+      PSOCK_GENERATOR_SEND(&s->sout, generate_head, s);
+      s->count += s->len;
+    } while(s->count < strlen(http_header_200) + strlen(api_type(s)));
+    s->api &= ~HTTPD_API_HEAD;
+  }
+
+  s->apifield = 0;
+  do {
+    PSOCK_GENERATOR_SEND(&s->sout, generate_fields, s);
+    s->apifield = s->apinext;
+    s->api &= ~HTTPD_API_HEAD;
+  } while(s->apifield < API_NFIELDS);
+
+  PSOCK_END(&s->sout);
+}
+/*---------------------------------------------------------------------------*/
+/* Nonzero when s->filename is one of ours, the mode goes in s->api. */
+int
+httpd_api_open(struct httpd_state *s)
+{
+  char *name = s->filename + 5;
+  char *ext;
+  unsigned char csv = 0;
+  int len;
+
+  s->api = 0;
+  if(strncmp(s->filename, http_api, 5) != 0) {
+    return 0;
+  }
+  ext = strchr(name, ISO_period);
+  len = (int)strcspn(name, ".?");
+  if(ext != NULL && strncmp(ext, http_csv, 4) == 0) {
+    csv = HTTPD_API_CSV;
+  }
+
+  if(len == 6 && strncmp(name, "stream", 6) == 0) {
+    if(streams < HTTPD_API_STREAMS) {
+      streams++;
+      s->api = HTTPD_API_STREAM;
+    } else {
+      s->api = HTTPD_API_STATE;
+    }
+  } else if(len == 5 && strncmp(name, "state", 5) == 0) {
+    s->api = HTTPD_API_STATE;
+  } else {
+    return 0;
+  }
+  s->api |= csv | HTTPD_API_HEAD;
+  if(csv) {
+    s->api |= HTTPD_API_NAMES;
+  }
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+void
+httpd_api_close(struct httpd_state *s)
+{
+  if(s->api & HTTPD_API_STREAM) {
+    streams--;
+  }
+  s->api = 0;
+}
+/*---------------------------------------------------------------------------*/
+PT_THREAD(httpd_api(struct httpd_state *s))
+{
+  PT_BEGIN(&s->scriptpt);
+
+  if(s->api & HTTPD_API_NAMES) {
+    PT_WAIT_THREAD(&s->scriptpt, send_fields(s));
+    s->api &= ~HTTPD_API_NAMES;
+  }
+
+  do {
+    take_sample(s);
+    PT_WAIT_THREAD(&s->scriptpt, send_fields(s));
+    if(!(s->api & HTTPD_API_STREAM)) {
+      break;
+    }
+
+    /* Polls while waiting count towards the idle abort in httpd_appcall(),
+       a sample sent is activity. */
+    s->timer = 0;
+    PT_WAIT_UNTIL(&s->scriptpt, sample_seq != s->apiseq);
+  } while(1);
+
+  PT_END(&s->scriptpt);
+}
+/*---------------------------------------------------------------------------*/
+void
+httpd_api_sample(void)
+{
+  sample_seq++;
+  if(streams > 0) {
+    vNetBufWakeRx();
+  }
+}
+/*---------------------------------------------------------------------------*/
+int
+httpd_api_poll(void)
+{
+  unsigned long seq = sample_seq;
+
+  if(streams == 0 || seq == polled_seq) {
+    return 0;
+  }
+  polled_seq = seq;
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+int
+httpd_api_streaming(struct uip_conn *conn)
+{
+  struct httpd_state *s = (struct httpd_state *)&conn->appstate;
+
+  return conn->tcpstateflags == UIP_ESTABLISHED &&
+    conn->lport == HTONS(80) && (s->api & HTTPD_API_STREAM);
+}
+/*---------------------------------------------------------------------------*/
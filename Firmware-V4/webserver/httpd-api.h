@@ -0,0 +1,44 @@
+/*
+ * Live telemetry for the web server.
+ *
+ *   /api/state       one sample as JSON, then close
+ *   /api/stream      one JSON line per control period until the client goes
+ *   /api/state.csv   the same as CSV, a header row then the sample
+ *   /api/stream.csv  the same as CSV, a header row then one row per period
+ *
+ * The text is generated straight from the input register image into
+ * uip_appdata, one MSS at a time.
+ */
+
+#ifndef __HTTPD_API_H__
+#define __HTTPD_API_H__
+
+#include "uip.h"
+#include "psock.h"
+#include "httpd.h"
+
+/* s->api */
+#define HTTPD_API_STATE   (1<<0)
+#define HTTPD_API_STREAM  (1<<1)
+#define HTTPD_API_CSV     (1<<2)
+#define HTTPD_API_HEAD    (1<<3)  /* response headers still to go */
+#define HTTPD_API_NAMES   (1<<4)  /* CSV header row still to go */
+
+/* Streams open at once, the rest of the connections stay for pages and
+   Modbus/TCP.  Further /api/stream requests get a single sample. */
+#define HTTPD_API_STREAMS 2
+
+int httpd_api_open(struct httpd_state *s);
+void httpd_api_close(struct httpd_state *s);
+PT_THREAD(httpd_api(struct httpd_state *s));
+
+/* Called by the control task once per period after the register image is
+   up to date, wakes the uIP task while a stream is open. */
+void httpd_api_sample(void);
+
+/* Called by the uIP task, nonzero when a sample was published since the
+   last call and a stream is open. */
+int httpd_api_poll(void);
+int httpd_api_streaming(struct uip_conn *conn);
+
+#endif /* __HTTPD_API_H__ */
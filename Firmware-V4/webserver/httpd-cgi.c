@@ -50,6 +50,7 @@
 #include "httpd.h"
 #include "httpd-cgi.h"
 #include "httpd-fs.h"
+#include "netbuf.h"
 
 #include <stdio.h>
 #include <string.h>
@@ -188,6 +189,19 @@ generate_net_stats(void *arg)
 		  "%5u\n", ((uip_stats_t *)&uip_stat)[s->count]);
 }
 
+static unsigned short
+generate_pool_stats(void *arg)
+{
+  ( void ) arg;
+  return snprintf((char *)uip_appdata, UIP_APPDATA_SIZE,
+		  "%5u\n%5u\n%5u\n%5u\n%5lu\n%5lu\n%5lu\n%5lu\n%5lu\n%5lu\n",
+		  netBUF_COUNT, xNetStats.usMaxUsed,
+		  xNetStats.usRxMaxQueued, xNetStats.usTxMaxQueued,
+		  xNetStats.ulRxFrames, xNetStats.ulTxFrames,
+		  xNetStats.ulRxDeferred, xNetStats.ulRxOverflow,
+		  xNetStats.ulRxTooLong, xNetStats.ulTxNoBuf);
+}
+
 static
 PT_THREAD(net_stats(struct httpd_state *s, char *ptr))
 {
@@ -203,6 +217,8 @@ PT_THREAD(net_stats(struct httpd_state *s, char *ptr))
 
 #endif /* UIP_STATISTICS */
 
+  PSOCK_GENERATOR_SEND(&s->sout, generate_pool_stats, s);
+
   PSOCK_END(&s->sout);
 }
 /*---------------------------------------------------------------------------*/
@@ -48,54 +48,72 @@ static u16_t count[HTTPD_FS_NUMFILES];
 #endif /* HTTPD_FS_STATISTICS */
 
 /*-----------------------------------------------------------------------------------*/
-static u8_t
+/* Order a requested name against a stored one.  The request may go on with
+   a query string or the rest of the request line, those end the name. */
+static int
 httpd_fs_strcmp(const char *str1, const char *str2)
 {
   u8_t i;
+  char c;
   i = 0;
  loop:
 
-  if(str2[i] == 0 ||
-     str1[i] == '\r' ||
-     str1[i] == '\n') {
-    return 0;
+  c = str1[i];
+  if(c == '?' || c == ' ' || c == '\r' || c == '\n') {
+    c = 0;
   }
 
-  if(str1[i] != str2[i]) {
-    return 1;
+  if(c != str2[i]) {
+    return (unsigned char)c - (unsigned char)str2[i];
+  }
+  if(c == 0) {
+    return 0;
   }
-
 
   ++i;
   goto loop;
 }
 /*-----------------------------------------------------------------------------------*/
+/* Index of name in httpd_fs_index, -1 when there is no such file. */
+static int
+httpd_fs_find(const char *name)
+{
+  int lo = 0, hi = HTTPD_FS_NUMFILES - 1, mid, c;
+
+  while(lo <= hi) {
+    mid = (lo + hi) / 2;
+    c = httpd_fs_strcmp(name, httpd_fs_index[mid]->name);
+    if(c == 0) {
+      return mid;
+    }
+    if(c < 0) {
+      hi = mid - 1;
+    } else {
+      lo = mid + 1;
+    }
+  }
+  return -1;
+}
+/*-----------------------------------------------------------------------------------*/
 int
 httpd_fs_open(const char *name, struct httpd_fs_file *file)
 {
-#if HTTPD_FS_STATISTICS
-  u16_t i = 0;
-#endif /* HTTPD_FS_STATISTICS */
-  struct httpd_fsdata_file_noconst *f;
+  const struct httpd_fsdata_file *f;
+  int i;
 
-  for(f = (struct httpd_fsdata_file_noconst *)HTTPD_FS_ROOT;
-      f != NULL;
-      f = (struct httpd_fsdata_file_noconst *)f->next) {
-
-    if(httpd_fs_strcmp(name, f->name) == 0) {
-      file->data = f->data;
-      file->len = f->len;
-#if HTTPD_FS_STATISTICS
-      ++count[i];
-#endif /* HTTPD_FS_STATISTICS */
-      return 1;
-    }
+  i = httpd_fs_find(name);
+  if(i < 0) {
+    return 0;
+  }
+  f = httpd_fs_index[i];
+  file->data = (char *)f->data;
+  file->len = f->len;
+  file->etag = f->etag;
+  file->flags = f->flags;
 #if HTTPD_FS_STATISTICS
-    ++i;
+  ++count[i];
 #endif /* HTTPD_FS_STATISTICS */
-
-  }
-  return 0;
+  return 1;
 }
 /*-----------------------------------------------------------------------------------*/
 void
@@ -113,20 +131,13 @@ httpd_fs_init(void)
 u16_t httpd_fs_count
 (char *name)
 {
-  struct httpd_fsdata_file_noconst *f;
-  u16_t i;
-
-  i = 0;
-  for(f = (struct httpd_fsdata_file_noconst *)HTTPD_FS_ROOT;
-      f != NULL;
-      f = (struct httpd_fsdata_file_noconst *)f->next) {
+  int i;
 
-    if(httpd_fs_strcmp(name, f->name) == 0) {
-      return count[i];
-    }
-    ++i;
+  i = httpd_fs_find(name);
+  if(i < 0) {
+    return 0;
   }
-  return 0;
+  return count[i];
 }
 #endif /* HTTPD_FS_STATISTICS */
 /*-----------------------------------------------------------------------------------*/
@@ -37,9 +37,14 @@
 
 #define HTTPD_FS_STATISTICS 1
 
+/* httpd_fs_file.flags, set by makefsdata */
+#define HTTPD_FS_GZIP 1   /* data is gzipped, send Content-Encoding: gzip */
+
 struct httpd_fs_file {
   char *data;
   int len;
+  unsigned long etag;     /* 0 for scripts, their output changes */
+  unsigned char flags;
 };
 
 /* file must be allocated by caller and will be filled in
@@ -22,47 +22,37 @@ static const char data_404_html[] = {
 static const char data_index_html[] = {
 	/* /index.html */
 	0x2f, 0x69, 0x6e, 0x64, 0x65, 0x78, 0x2e, 0x68, 0x74, 0x6d, 0x6c, 0,
-	0x3c, 0x21, 0x44, 0x4f, 0x43, 0x54, 0x59, 0x50, 0x45, 0x20, 
-	0x48, 0x54, 0x4d, 0x4c, 0x20, 0x50, 0x55, 0x42, 0x4c, 0x49, 
-	0x43, 0x20, 0x22, 0x2d, 0x2f, 0x2f, 0x57, 0x33, 0x43, 0x2f, 
-	0x2f, 0x44, 0x54, 0x44, 0x20, 0x48, 0x54, 0x4d, 0x4c, 0x20, 
-	0x34, 0x2e, 0x30, 0x31, 0x20, 0x54, 0x72, 0x61, 0x6e, 0x73, 
-	0x69, 0x74, 0x69, 0x6f, 0x6e, 0x61, 0x6c, 0x2f, 0x2f, 0x45, 
-	0x4e, 0x22, 0x20, 0x22, 0x68, 0x74, 0x74, 0x70, 0x3a, 0x2f, 
-	0x2f, 0x77, 0x77, 0x77, 0x2e, 0x77, 0x33, 0x2e, 0x6f, 0x72, 
-	0x67, 0x2f, 0x54, 0x52, 0x2f, 0x68, 0x74, 0x6d, 0x6c, 0x34, 
-	0x2f, 0x6c, 0x6f, 0x6f, 0x73, 0x65, 0x2e, 0x64, 0x74, 0x64, 
-	0x22, 0x3e, 0xa, 0x3c, 0x68, 0x74, 0x6d, 0x6c, 0x3e, 0xa, 
-	0x20, 0x20, 0x3c, 0x68, 0x65, 0x61, 0x64, 0x3e, 0xa, 0x20, 
-	0x20, 0x20, 0x20, 0x3c, 0x74, 0x69, 0x74, 0x6c, 0x65, 0x3e, 
-	0x46, 0x72, 0x65, 0x65, 0x52, 0x54, 0x4f, 0x53, 0x2e, 0x6f, 
-	0x72, 0x67, 0x20, 0x75, 0x49, 0x50, 0x20, 0x57, 0x45, 0x42, 
-	0x20, 0x73, 0x65, 0x72, 0x76, 0x65, 0x72, 0x20, 0x64, 0x65, 
-	0x6d, 0x6f, 0x3c, 0x2f, 0x74, 0x69, 0x74, 0x6c, 0x65, 0x3e, 
-	0xa, 0x20, 0x20, 0x3c, 0x2f, 0x68, 0x65, 0x61, 0x64, 0x3e, 
-	0xa, 0x20, 0x20, 0x3c, 0x42, 0x4f, 0x44, 0x59, 0x20, 0x6f, 
-	0x6e, 0x4c, 0x6f, 0x61, 0x64, 0x3d, 0x22, 0x77, 0x69, 0x6e, 
-	0x64, 0x6f, 0x77, 0x2e, 0x73, 0x65, 0x74, 0x54, 0x69, 0x6d, 
-	0x65, 0x6f, 0x75, 0x74, 0x28, 0x26, 0x71, 0x75, 0x6f, 0x74, 
-	0x3b, 0x6c, 0x6f, 0x63, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x2e, 
-	0x68, 0x72, 0x65, 0x66, 0x3d, 0x27, 0x69, 0x6e, 0x64, 0x65, 
-	0x78, 0x2e, 0x73, 0x68, 0x74, 0x6d, 0x6c, 0x27, 0x26, 0x71, 
-	0x75, 0x6f, 0x74, 0x3b, 0x2c, 0x31, 0x30, 0x30, 0x29, 0x22, 
-	0x3e, 0xa, 0x3c, 0x66, 0x6f, 0x6e, 0x74, 0x20, 0x66, 0x61, 
-	0x63, 0x65, 0x3d, 0x22, 0x61, 0x72, 0x69, 0x61, 0x6c, 0x22, 
-	0x3e, 0xa, 0x4c, 0x6f, 0x61, 0x64, 0x69, 0x6e, 0x67, 0x20, 
-	0x69, 0x6e, 0x64, 0x65, 0x78, 0x2e, 0x73, 0x68, 0x74, 0x6d, 
-	0x6c, 0x2e, 0x20, 0x20, 0x43, 0x6c, 0x69, 0x63, 0x6b, 0x20, 
-	0x3c, 0x61, 0x20, 0x68, 0x72, 0x65, 0x66, 0x3d, 0x22, 0x69, 
-	0x6e, 0x64, 0x65, 0x78, 0x2e, 0x73, 0x68, 0x74, 0x6d, 0x6c, 
-	0x22, 0x3e, 0x68, 0x65, 0x72, 0x65, 0x3c, 0x2f, 0x61, 0x3e, 
-	0x20, 0x69, 0x66, 0x20, 0x6e, 0x6f, 0x74, 0x20, 0x61, 0x75, 
-	0x74, 0x6f, 0x6d, 0x61, 0x74, 0x69, 0x63, 0x61, 0x6c, 0x6c, 
-	0x79, 0x20, 0x72, 0x65, 0x64, 0x69, 0x72, 0x65, 0x63, 0x74, 
-	0x65, 0x64, 0x2e, 0xa, 0x3c, 0x2f, 0x66, 0x6f, 0x6e, 0x74, 
-	0x3e, 0xa, 0x3c, 0x2f, 0x66, 0x6f, 0x6e, 0x74, 0x3e, 0xa, 
-	0x3c, 0x2f, 0x62, 0x6f, 0x64, 0x79, 0x3e, 0xa, 0x3c, 0x2f, 
-	0x68, 0x74, 0x6d, 0x6c, 0x3e, 0xa, 0xa, 0};
+	0x1f, 0x8b, 0x8, 00, 00, 00, 00, 00, 00, 0xff, 
+	0x4d, 0x50, 0x4d, 0x4f, 0xc2, 0x40, 0x10, 0xbd, 0xf7, 0x57, 
+	0x8c, 0x7b, 0x10, 0x4d, 0x74, 0x17, 0x2, 0x27, 0x5d, 0x7a, 
+	0xa0, 0xc5, 0x48, 0x82, 0x42, 0xb0, 0x86, 0x70, 0x5c, 0xbb, 
+	0x53, 0xba, 0x71, 0xdb, 0xd1, 0xed, 0xd6, 0xca, 0xbf, 0xa7, 
+	0x6b, 0x63, 0xc2, 0x69, 0x26, 0xef, 0x6b, 0x5e, 0x46, 0x5e, 
+	0xa5, 0x9b, 0x24, 0x3b, 0x6c, 0x97, 0xf0, 0x9c, 0xbd, 0xac, 
+	0x61, 0xfb, 0xbe, 0x58, 0xaf, 0x12, 0x60, 0xf7, 0x42, 0xec, 
+	0xa7, 0x89, 0x10, 0x69, 0x96, 0xe, 0xc4, 0x8c, 0x8f, 0x27, 
+	0x90, 0x39, 0x55, 0x37, 0xc6, 0x1b, 0xaa, 0x95, 0x15, 0x62, 
+	0xf9, 0xca, 0x80, 0x95, 0xde, 0x7f, 0x3d, 0x8, 0xd1, 0x75, 
+	0x1d, 0xef, 0xa6, 0x9c, 0xdc, 0x51, 0x64, 0x3b, 0x51, 0xfa, 
+	0xca, 0xce, 0x84, 0x25, 0x6a, 0x90, 0x6b, 0xaf, 0x59, 0x1c, 
+	0xc9, 00, 0xc5, 0x11, 0x80, 0x2c, 0x51, 0xe9, 0xb0, 0xf4, 
+	0xab, 0x37, 0xde, 0x62, 0xfc, 0xe4, 0x10, 0x77, 0xd9, 0xe6, 
+	0x2d, 0x98, 0xa1, 0x5d, 0x6d, 0x61, 0xbf, 0x5c, 0x40, 0x83, 
+	0xee, 0x7, 0x1d, 0x68, 0xac, 0x48, 0x8a, 0x41, 0x17, 0xcc, 
+	0xe2, 0xdf, 0x2d, 0x17, 0x9b, 0xf4, 00, 0x54, 0xaf, 0x49, 
+	0xe9, 0x39, 0xeb, 0x4c, 0xad, 0xa9, 0xe3, 0xd, 0xfa, 0xcc, 
+	0x54, 0x48, 0xad, 0xbf, 0xb9, 0xfe, 0x6e, 0xc9, 0x3f, 0x5a, 
+	0xca, 0x55, 0x68, 0xcb, 0x4b, 0x87, 0xc5, 0x7c, 0xd4, 0xab, 
+	0xf0, 0x97, 0x37, 0xa1, 0xca, 0x68, 0x10, 0xdc, 0x4d, 0xc6, 
+	0xe3, 0xdb, 0x50, 0xaf, 0xa0, 0xda, 0x43, 0xa1, 0x72, 0x9c, 
+	0x33, 0xe5, 0x8c, 0xb2, 0x3d, 0x16, 0xa2, 0x4d, 0x7d, 0x84, 
+	0xb, 0x17, 0x7, 0x48, 0xac, 0xc9, 0x3f, 0x41, 0x2a, 0xf8, 
+	0x8b, 0x64, 0x17, 0x24, 0x8b, 0x4b, 0x74, 0x28, 0x85, 0x8a, 
+	0xc1, 0x14, 0x50, 0x93, 0x7, 0xd5, 0x7a, 0xaa, 0xfa, 0x2, 
+	0xb9, 0xb2, 0xf6, 0x4, 0xe, 0xb5, 0x71, 0x98, 0x7b, 0xd4, 
+	0x3c, 0x92, 0x22, 0x1c, 0x8c, 0x2f, 0xe6, 0x7, 0xe9, 0x53, 
+	0x98, 0xc3, 0x9f, 0xa2, 0x33, 0x95, 0xda, 0xf0, 0x9b, 0x97, 
+	0x1, 00, 00, 0};
 
 static const char data_index_shtml[] = {
 	/* /index.shtml */
@@ -452,15 +442,46 @@ static const char data_stats_shtml[] = {
 	0x43, 0x6f, 0x6e, 0x6e, 0x65, 0x63, 0x74, 0x69, 0x6f, 0x6e, 
 	0x20, 0x61, 0x74, 0x74, 0x65, 0x6d, 0x70, 0x74, 0x73, 0x20, 
 	0x74, 0x6f, 0x20, 0x63, 0x6c, 0x6f, 0x73, 0x65, 0x64, 0x20, 
-	0x70, 0x6f, 0x72, 0x74, 0x73, 0xa, 0x3c, 0x2f, 0x70, 0x72, 
-	0x65, 0x3e, 0x3c, 0x2f, 0x66, 0x6f, 0x6e, 0x74, 0x3e, 0x3c, 
-	0x2f, 0x74, 0x64, 0x3e, 0x3c, 0x74, 0x64, 0x3e, 0x3c, 0x70, 
-	0x72, 0x65, 0x3e, 0x25, 0x21, 0x20, 0x6e, 0x65, 0x74, 0x2d, 
-	0x73, 0x74, 0x61, 0x74, 0x73, 0xa, 0x3c, 0x2f, 0x70, 0x72, 
-	0x65, 0x3e, 0x3c, 0x2f, 0x74, 0x61, 0x62, 0x6c, 0x65, 0x3e, 
-	0xa, 0x3c, 0x2f, 0x66, 0x6f, 0x6e, 0x74, 0x3e, 0xa, 0x3c, 
-	0x2f, 0x62, 0x6f, 0x64, 0x79, 0x3e, 0xa, 0x3c, 0x2f, 0x68, 
-	0x74, 0x6d, 0x6c, 0x3e, 0xa, 0};
+	0x70, 0x6f, 0x72, 0x74, 0x73, 0xa, 0x42, 0x75, 0x66, 0x66, 
+	0x65, 0x72, 0x73, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x50, 
+	0x6f, 0x6f, 0x6c, 0x20, 0x73, 0x69, 0x7a, 0x65, 0xa, 0x20, 
+	0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+	0x20, 0x20, 0x4d, 0x6f, 0x73, 0x74, 0x20, 0x69, 0x6e, 0x20, 
+	0x75, 0x73, 0x65, 0xa, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+	0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x52, 0x58, 0x20, 
+	0x71, 0x75, 0x65, 0x75, 0x65, 0x20, 0x68, 0x69, 0x67, 0x68, 
+	0x2d, 0x77, 0x61, 0x74, 0x65, 0x72, 0xa, 0x20, 0x20, 0x20, 
+	0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+	0x54, 0x58, 0x20, 0x71, 0x75, 0x65, 0x75, 0x65, 0x20, 0x68, 
+	0x69, 0x67, 0x68, 0x2d, 0x77, 0x61, 0x74, 0x65, 0x72, 0xa, 
+	0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+	0x20, 0x20, 0x20, 0x46, 0x72, 0x61, 0x6d, 0x65, 0x73, 0x20, 
+	0x72, 0x65, 0x63, 0x65, 0x69, 0x76, 0x65, 0x64, 0xa, 0x20, 
+	0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+	0x20, 0x20, 0x46, 0x72, 0x61, 0x6d, 0x65, 0x73, 0x20, 0x73, 
+	0x65, 0x6e, 0x74, 0xa, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+	0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x52, 0x58, 0x20, 
+	0x68, 0x65, 0x6c, 0x64, 0x20, 0x62, 0x61, 0x63, 0x6b, 0x2c, 
+	0x20, 0x6e, 0x6f, 0x20, 0x62, 0x75, 0x66, 0x66, 0x65, 0x72, 
+	0xa, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+	0x20, 0x20, 0x20, 0x20, 0x52, 0x58, 0x20, 0x6c, 0x6f, 0x73, 
+	0x74, 0x2c, 0x20, 0x63, 0x6f, 0x6e, 0x74, 0x72, 0x6f, 0x6c, 
+	0x6c, 0x65, 0x72, 0x20, 0x66, 0x75, 0x6c, 0x6c, 0xa, 0x20, 
+	0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+	0x20, 0x20, 0x52, 0x58, 0x20, 0x64, 0x72, 0x6f, 0x70, 0x70, 
+	0x65, 0x64, 0x2c, 0x20, 0x74, 0x6f, 0x6f, 0x20, 0x6c, 0x6f, 
+	0x6e, 0x67, 0xa, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+	0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x54, 0x58, 0x20, 0x64, 
+	0x72, 0x6f, 0x70, 0x70, 0x65, 0x64, 0x2c, 0x20, 0x6e, 0x6f, 
+	0x20, 0x62, 0x75, 0x66, 0x66, 0x65, 0x72, 0xa, 0x3c, 0x2f, 
+	0x70, 0x72, 0x65, 0x3e, 0x3c, 0x2f, 0x66, 0x6f, 0x6e, 0x74, 
+	0x3e, 0x3c, 0x2f, 0x74, 0x64, 0x3e, 0x3c, 0x74, 0x64, 0x3e, 
+	0x3c, 0x70, 0x72, 0x65, 0x3e, 0x25, 0x21, 0x20, 0x6e, 0x65, 
+	0x74, 0x2d, 0x73, 0x74, 0x61, 0x74, 0x73, 0xa, 0x3c, 0x2f, 
+	0x70, 0x72, 0x65, 0x3e, 0x3c, 0x2f, 0x74, 0x61, 0x62, 0x6c, 
+	0x65, 0x3e, 0xa, 0x3c, 0x2f, 0x66, 0x6f, 0x6e, 0x74, 0x3e, 
+	0xa, 0x3c, 0x2f, 0x62, 0x6f, 0x64, 0x79, 0x3e, 0xa, 0x3c, 
+	0x2f, 0x68, 0x74, 0x6d, 0x6c, 0x3e, 0xa, 0};
 
 static const char data_tcp_shtml[] = {
 	/* /tcp.shtml */
@@ -538,20 +559,31 @@ static const char data_tcp_shtml[] = {
 	0x2f, 0x62, 0x6f, 0x64, 0x79, 0x3e, 0xa, 0x3c, 0x2f, 0x68, 
 	0x74, 0x6d, 0x6c, 0x3e, 0xa, 0xa, 0};
 
-const struct httpd_fsdata_file file_404_html[] = {{NULL, data_404_html, data_404_html + 10, sizeof(data_404_html) - 10, 0}};
+const struct httpd_fsdata_file file_404_html[] = {{NULL, data_404_html, data_404_html + 10, sizeof(data_404_html) - 11, 0xbebb2b04, 0, 0}};
 
-const struct httpd_fsdata_file file_index_html[] = {{file_404_html, data_index_html, data_index_html + 12, sizeof(data_index_html) - 12, 0}};
+const struct httpd_fsdata_file file_index_html[] = {{file_404_html, data_index_html, data_index_html + 12, sizeof(data_index_html) - 13, 0x888cb26c, HTTPD_FS_GZIP, 0}};
 
-const struct httpd_fsdata_file file_index_shtml[] = {{file_index_html, data_index_shtml, data_index_shtml + 13, sizeof(data_index_shtml) - 13, 0}};
+const struct httpd_fsdata_file file_index_shtml[] = {{file_index_html, data_index_shtml, data_index_shtml + 13, sizeof(data_index_shtml) - 14, 0, 0, 0}};
 
-const struct httpd_fsdata_file file_io_shtml[] = {{file_index_shtml, data_io_shtml, data_io_shtml + 10, sizeof(data_io_shtml) - 10, 0}};
+const struct httpd_fsdata_file file_io_shtml[] = {{file_index_shtml, data_io_shtml, data_io_shtml + 10, sizeof(data_io_shtml) - 11, 0, 0, 0}};
 
-const struct httpd_fsdata_file file_runtime_shtml[] = {{file_io_shtml, data_runtime_shtml, data_runtime_shtml + 15, sizeof(data_runtime_shtml) - 15, 0}};
+const struct httpd_fsdata_file file_runtime_shtml[] = {{file_io_shtml, data_runtime_shtml, data_runtime_shtml + 15, sizeof(data_runtime_shtml) - 16, 0, 0, 0}};
 
-const struct httpd_fsdata_file file_stats_shtml[] = {{file_runtime_shtml, data_stats_shtml, data_stats_shtml + 13, sizeof(data_stats_shtml) - 13, 0}};
+const struct httpd_fsdata_file file_stats_shtml[] = {{file_runtime_shtml, data_stats_shtml, data_stats_shtml + 13, sizeof(data_stats_shtml) - 14, 0, 0, 0}};
 
-const struct httpd_fsdata_file file_tcp_shtml[] = {{file_stats_shtml, data_tcp_shtml, data_tcp_shtml + 11, sizeof(data_tcp_shtml) - 11, 0}};
+const struct httpd_fsdata_file file_tcp_shtml[] = {{file_stats_shtml, data_tcp_shtml, data_tcp_shtml + 11, sizeof(data_tcp_shtml) - 12, 0, 0, 0}};
 
 #define HTTPD_FS_ROOT file_tcp_shtml
 
 #define HTTPD_FS_NUMFILES 7
+
+/* Sorted by name for httpd_fs_open(). */
+static const struct httpd_fsdata_file *const httpd_fs_index[HTTPD_FS_NUMFILES] = {
+	file_404_html,
+	file_index_html,
+	file_index_shtml,
+	file_io_shtml,
+	file_runtime_shtml,
+	file_stats_shtml,
+	file_tcp_shtml,
+};
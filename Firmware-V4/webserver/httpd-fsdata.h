@@ -42,6 +42,8 @@ struct httpd_fsdata_file {
   const char *name;
   const char *data;
   const int len;
+  const unsigned long etag;
+  const unsigned char flags;
 #ifdef HTTPD_FS_STATISTICS
 #if HTTPD_FS_STATISTICS == 1
   u16_t count;
@@ -54,6 +56,8 @@ struct httpd_fsdata_file_noconst {
   char *name;
   char *data;
   int len;
+  unsigned long etag;
+  unsigned char flags;
 #ifdef HTTPD_FS_STATISTICS
 #if HTTPD_FS_STATISTICS == 1
   u16_t count;
@@ -59,6 +59,7 @@
 #include "httpd.h"
 #include "httpd-fs.h"
 #include "httpd-cgi.h"
+#include "httpd-api.h"
 #include "http-strings.h"
 
 #include <string.h>
@@ -73,6 +74,18 @@
 #define ISO_period  0x2e
 #define ISO_slash   0x2f
 #define ISO_colon   0x3a
+#define ISO_quote   0x22
+
+/* httpd_state.status, an index into statushdrs */
+#define STATUS_200  0
+#define STATUS_304  1
+#define STATUS_404  2
+#define STATUS_406  3
+#define STATUS_BODY 0x80  /* the file follows the headers */
+
+static const char *const statushdrs[] = {
+  http_header_200, http_header_304, http_header_404, http_header_406
+};
 
 
 /*---------------------------------------------------------------------------*/
@@ -96,11 +109,11 @@ PT_THREAD(send_file(struct httpd_state *s))
 {
   PSOCK_BEGIN(&s->sout);
   
-  do {
+  while(s->file.len > 0) {
     PSOCK_GENERATOR_SEND(&s->sout, generate_part_of_file, s);
     s->file.len -= s->len;
     s->file.data += s->len;
-  } while(s->file.len > 0);
+  }
       
   PSOCK_END(&s->sout);
 }
@@ -184,32 +197,112 @@ PT_THREAD(handle_script(struct httpd_state *s))
   PT_END(&s->scriptpt);
 }
 /*---------------------------------------------------------------------------*/
-static
-PT_THREAD(send_headers(struct httpd_state *s, const char *statushdr))
+static const char *
+content_type(struct httpd_state *s)
 {
   char *ptr;
 
-  PSOCK_BEGIN(&s->sout);
-
-  PSOCK_SEND_STR(&s->sout, statushdr);
-
+  if((s->status & ~STATUS_BODY) == STATUS_406) {
+    return http_content_type_plain;
+  }
   ptr = strrchr(s->filename, ISO_period);
   if(ptr == NULL) {
-    PSOCK_SEND_STR(&s->sout, http_content_type_binary);
+    return http_content_type_binary;
   } else if(strncmp(http_html, ptr, 5) == 0 ||
 	    strncmp(http_shtml, ptr, 6) == 0) {
-    PSOCK_SEND_STR(&s->sout, http_content_type_html);
+    return http_content_type_html;
   } else if(strncmp(http_css, ptr, 4) == 0) {
-    PSOCK_SEND_STR(&s->sout, http_content_type_css);
+    return http_content_type_css;
   } else if(strncmp(http_png, ptr, 4) == 0) {
-    PSOCK_SEND_STR(&s->sout, http_content_type_png);
+    return http_content_type_png;
   } else if(strncmp(http_gif, ptr, 4) == 0) {
-    PSOCK_SEND_STR(&s->sout, http_content_type_gif);
+    return http_content_type_gif;
   } else if(strncmp(http_jpg, ptr, 4) == 0) {
-    PSOCK_SEND_STR(&s->sout, http_content_type_jpg);
+    return http_content_type_jpg;
+  }
+  return http_content_type_plain;
+}
+/*---------------------------------------------------------------------------*/
+static char *
+put_str(char *p, const char *str)
+{
+  while(*str) {
+    *p++ = *str++;
+  }
+  return p;
+}
+/*---------------------------------------------------------------------------*/
+/* The whole header block is built each time and the part from s->count on
+   is sent.  With body set, the first bytes of the file fill the rest of the
+   segment that ends the headers. */
+static unsigned short
+generate_headers(void *state)
+{
+  struct httpd_state *s = (struct httpd_state *)state;
+  char *start = (char *)uip_appdata;
+  char *p = start;
+  unsigned char status = s->status & ~STATUS_BODY;
+  unsigned short len, room;
+  unsigned char i;
+
+  p = put_str(p, statushdrs[status]);
+  if((s->file.flags & HTTPD_FS_GZIP) &&
+     (status == STATUS_200 || status == STATUS_404)) {
+    p = put_str(p, http_content_encoding_gzip);
+  }
+  if(s->file.etag != 0 &&
+     (status == STATUS_200 || status == STATUS_304)) {
+    p = put_str(p, http_etag);
+    *p++ = ISO_quote;
+    for(i = 0; i < 8; i++) {
+      *p++ = "0123456789abcdef"[(s->file.etag >> (28 - 4 * i)) & 0xf];
+    }
+    *p++ = ISO_quote;
+    p = put_str(p, http_crnl);
+    p = put_str(p, http_cache_control);
+  }
+  if(status == STATUS_304) {
+    p = put_str(p, http_crnl);
   } else {
-    PSOCK_SEND_STR(&s->sout, http_content_type_plain);
+    p = put_str(p, content_type(s));
+  }
+
+  s->hdrlen = (unsigned short)(p - start);
+  len = s->hdrlen - s->count;
+  if(s->count > 0) {
+    memmove(start, start + s->count, len);
   }
+
+  s->len = 0;
+  if(len > uip_mss()) {
+    len = uip_mss();
+  } else if(s->status & STATUS_BODY) {
+    room = uip_mss() - len;
+    s->len = s->file.len < room ? s->file.len : room;
+    memcpy(start + len, s->file.data, s->len);
+  }
+
+  return len + s->len;
+}
+/*---------------------------------------------------------------------------*/
+static
+PT_THREAD(send_headers(struct httpd_state *s, unsigned char status))
+{
+  PSOCK_BEGIN(&s->sout);
+
+  s->status = status;
+  s->count = 0;
+  do {
+    PSOCK_GENERATOR_SEND(&s->sout, generate_headers, s);
+    if(s->hdrlen - s->count > uip_mss()) {
+      s->count += uip_mss();
+    } else {
+      s->count = s->hdrlen;
+    }
+    s->file.data += s->len;
+    s->file.len -= s->len;
+  } while(s->count < s->hdrlen);
+
   PSOCK_END(&s->sout);
 }
 /*---------------------------------------------------------------------------*/
@@ -220,23 +313,37 @@ PT_THREAD(handle_output(struct httpd_state *s))
   
   PT_BEGIN(&s->outputpt);
  
-  if(!httpd_fs_open(s->filename, &s->file)) {
+  if(httpd_api_open(s)) {
+    PT_INIT(&s->scriptpt);
+    PT_WAIT_THREAD(&s->outputpt, httpd_api(s));
+  } else if(!httpd_fs_open(s->filename, &s->file)) {
     httpd_fs_open(http_404_html, &s->file);
     strcpy(s->filename, http_404_html);
     PT_WAIT_THREAD(&s->outputpt,
-		   send_headers(s,
-		   http_header_404));
+		   send_headers(s, STATUS_404 | STATUS_BODY));
     PT_WAIT_THREAD(&s->outputpt,
 		   send_file(s));
-  } else {
+  } else if(s->file.etag != 0 && (s->reqflags & HTTPD_REQ_INM) &&
+	    s->inm == s->file.etag) {
+    /* The client's copy is current. */
     PT_WAIT_THREAD(&s->outputpt,
-		   send_headers(s,
-		   http_header_200));
+		   send_headers(s, STATUS_304));
+  } else if((s->file.flags & HTTPD_FS_GZIP) &&
+	    (s->reqflags & (HTTPD_REQ_AE | HTTPD_REQ_AE_GZIP)) == HTTPD_REQ_AE) {
+    /* Only the gzipped copy is stored and the client ruled gzip out, no
+       Accept-Encoding at all means anything goes. */
+    PT_WAIT_THREAD(&s->outputpt,
+		   send_headers(s, STATUS_406));
+  } else {
     ptr = strchr(s->filename, ISO_period);
     if(ptr != NULL && strncmp(ptr, http_shtml, 6) == 0) {
+      PT_WAIT_THREAD(&s->outputpt,
+		     send_headers(s, STATUS_200));
       PT_INIT(&s->scriptpt);
       PT_WAIT_THREAD(&s->outputpt, handle_script(s));
     } else {
+      PT_WAIT_THREAD(&s->outputpt,
+		     send_headers(s, STATUS_200 | STATUS_BODY));
       PT_WAIT_THREAD(&s->outputpt,
 		     send_file(s));
     }
@@ -245,6 +352,35 @@ PT_THREAD(handle_output(struct httpd_state *s))
   PT_END(&s->outputpt);
 }
 /*---------------------------------------------------------------------------*/
+/* The first tag of an If-None-Match list, in the form generate_headers()
+   writes it. */
+static char
+parse_etag(const char *p, unsigned long *tag)
+{
+  unsigned char i;
+  char c;
+
+  while(*p == ISO_space) {
+    ++p;
+  }
+  if(*p++ != ISO_quote) {
+    return 0;
+  }
+  *tag = 0;
+  for(i = 0; i < 8; i++) {
+    c = *p++;
+    if(c >= '0' && c <= '9') {
+      c -= '0';
+    } else if(c >= 'a' && c <= 'f') {
+      c -= 'a' - 10;
+    } else {
+      return 0;
+    }
+    *tag = (*tag << 4) | c;
+  }
+  return *p == ISO_quote;
+}
+/*---------------------------------------------------------------------------*/
 static
 PT_THREAD(handle_input(struct httpd_state *s))
 {
@@ -279,16 +415,37 @@ PT_THREAD(handle_input(struct httpd_state *s))
 
   /*  httpd_log_file(uip_conn->ripaddr, s->filename);*/
   
-  s->state = STATE_OUTPUT;
-
+  /* The answer depends on the headers, so output waits for the blank line
+     that ends them. */
+  s->reqflags = 0;
   while(1) {
     PSOCK_READTO(&s->sin, ISO_nl);
 
+    if(PSOCK_DATALEN(&s->sin) <= 2) {
+      break;
+    }
+    s->inputbuf[PSOCK_DATALEN(&s->sin) - 1] = 0;
+
     if(strncmp(s->inputbuf, http_referer, 8) == 0) {
       s->inputbuf[PSOCK_DATALEN(&s->sin) - 2] = 0;
       /*      httpd_log(&s->inputbuf[9]);*/
+    } else if(strncmp(s->inputbuf, http_accept_encoding, 16) == 0) {
+      s->reqflags |= HTTPD_REQ_AE;
+      if(strstr(&s->inputbuf[16], http_gzip) != NULL) {
+	s->reqflags |= HTTPD_REQ_AE_GZIP;
+      }
+    } else if(strncmp(s->inputbuf, http_if_none_match, 14) == 0) {
+      if(parse_etag(&s->inputbuf[14], &s->inm)) {
+	s->reqflags |= HTTPD_REQ_INM;
+      }
     }
   }
+
+  s->state = STATE_OUTPUT;
+
+  while(1) {
+    PSOCK_READTO(&s->sin, ISO_nl);
+  }
   
   PSOCK_END(&s->sin);
 }
@@ -311,12 +468,14 @@ httpd_appcall(void)
 	switch ( uip_conn->lport ){
 	case HTONS(80):
 		if(uip_closed() || uip_aborted() || uip_timedout()) {
+			httpd_api_close(s);
 		} else if(uip_connected()) {
 			PSOCK_INIT(&s->sin, s->inputbuf, sizeof(s->inputbuf) - 1);
 			PSOCK_INIT(&s->sout, s->inputbuf, sizeof(s->inputbuf) - 1);
 			
 			PT_INIT(&s->outputpt);
 			s->state = STATE_WAITING;
+			s->api = 0;
 			/*    timer_set(&s->timer, CLOCK_SECOND * 100);*/
 			s->timer = 0;
 			handle_connection(s);
@@ -324,6 +483,7 @@ httpd_appcall(void)
 			if(uip_poll()) {
 				++s->timer;
 				if(s->timer >= 20) {
+					httpd_api_close(s);
 					uip_abort();
 				}
 			} else {
@@ -38,6 +38,14 @@
 #include "psock.h"
 #include "httpd-fs.h"
 
+/* httpd_state.reqflags, from the request headers */
+#define HTTPD_REQ_AE       1  /* Accept-Encoding was sent */
+#define HTTPD_REQ_AE_GZIP  2  /* and it lists gzip */
+#define HTTPD_REQ_INM      4  /* If-None-Match, the tag is in inm */
+
+/* Registers one /api sample keeps per connection, see httpd-api.c. */
+#define HTTPD_API_NVALS 17
+
 struct httpd_state {
   unsigned char timer;
   struct psock sin, sout;
@@ -51,6 +59,14 @@ struct httpd_state {
   int scriptlen;
   
   unsigned short count;
+
+  unsigned char status, reqflags;
+  unsigned short hdrlen;
+  unsigned long inm;
+
+  unsigned char api, apifield, apinext;
+  unsigned long apiseq;
+  unsigned short apival[HTTPD_API_NVALS];
 };
 
 void httpd_init(void);
@@ -0,0 +1,151 @@
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+
+#include "netbuf.h"
+
+/*-----------------------------------------------------------*/
+
+static xNetBuf xNetBufs[ netBUF_COUNT ];
+static xNetBuf *pxNetFreeList = NULL;
+
+xNetBufStats xNetStats;
+xQueueHandle xNetRxQueue = NULL;
+xQueueHandle xNetTxQueue = NULL;
+
+/* A NULL is waiting on xNetRxQueue. */
+static volatile portBASE_TYPE xRxWakePending = pdFALSE;
+
+/* The driver task sleeps on this, see uIP_Task.c. */
+extern xSemaphoreHandle xEMACSemaphore;
+
+/*-----------------------------------------------------------*/
+
+void vNetBufInit( void )
+{
+portBASE_TYPE i;
+
+	pxNetFreeList = NULL;
+	for( i = 0; i < netBUF_COUNT; i++ )
+	{
+		xNetBufs[ i ].pxNext = pxNetFreeList;
+		pxNetFreeList = &xNetBufs[ i ];
+	}
+	xNetStats.usFree = netBUF_COUNT;
+
+	/* One slot more than the pool for the wake from vNetBufWakeRx(). */
+	xNetRxQueue = xQueueCreate( netBUF_COUNT + 1, sizeof( xNetBuf * ) );
+	xNetTxQueue = xQueueCreate( netBUF_COUNT, sizeof( xNetBuf * ) );
+}
+/*-----------------------------------------------------------*/
+
+xNetBuf *pxNetBufAlloc( void )
+{
+xNetBuf *pxBuf;
+
+	taskENTER_CRITICAL();
+	{
+		pxBuf = pxNetFreeList;
+		if( pxBuf != NULL )
+		{
+			pxNetFreeList = pxBuf->pxNext;
+			xNetStats.usFree--;
+			if( ( netBUF_COUNT - xNetStats.usFree ) > xNetStats.usMaxUsed )
+			{
+				xNetStats.usMaxUsed = netBUF_COUNT - xNetStats.usFree;
+			}
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return pxBuf;
+}
+/*-----------------------------------------------------------*/
+
+void vNetBufFree( xNetBuf *pxBuf )
+{
+portBASE_TYPE xWasEmpty;
+
+	taskENTER_CRITICAL();
+	{
+		xWasEmpty = ( pxNetFreeList == NULL );
+		pxBuf->pxNext = pxNetFreeList;
+		pxNetFreeList = pxBuf;
+		xNetStats.usFree++;
+	}
+	taskEXIT_CRITICAL();
+
+	if( xWasEmpty )
+	{
+		xSemaphoreGive( xEMACSemaphore );
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vNetBufQueueRx( xNetBuf *pxBuf )
+{
+unsigned short usWaiting;
+
+	/* The queue holds the whole pool, this can not fail. */
+	if( xQueueSend( xNetRxQueue, &pxBuf, 0 ) != pdPASS )
+	{
+		vNetBufFree( pxBuf );
+		return;
+	}
+	xNetStats.ulRxFrames++;
+	usWaiting = ( unsigned short ) uxQueueMessagesWaiting( xNetRxQueue );
+	if( usWaiting > xNetStats.usRxMaxQueued )
+	{
+		xNetStats.usRxMaxQueued = usWaiting;
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vNetBufWakeRx( void )
+{
+xNetBuf *pxNone = NULL;
+portBASE_TYPE xSend;
+
+	taskENTER_CRITICAL();
+	{
+		xSend = ( xRxWakePending == pdFALSE );
+		xRxWakePending = pdTRUE;
+	}
+	taskEXIT_CRITICAL();
+
+	if( xSend )
+	{
+		xQueueSend( xNetRxQueue, &pxNone, 0 );
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vNetBufWakeRxTaken( void )
+{
+	xRxWakePending = pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+void vNetBufQueueTx( xNetBuf *pxBuf )
+{
+unsigned short usWaiting;
+
+	/* The queue holds the whole pool, this can not fail. */
+	if( xQueueSend( xNetTxQueue, &pxBuf, 0 ) != pdPASS )
+	{
+		vNetBufFree( pxBuf );
+		return;
+	}
+	xNetStats.ulTxFrames++;
+	usWaiting = ( unsigned short ) uxQueueMessagesWaiting( xNetTxQueue );
+	if( usWaiting > xNetStats.usTxMaxQueued )
+	{
+		xNetStats.usTxMaxQueued = usWaiting;
+	}
+
+	/* Wake the driver task, it may be waiting on INT only. */
+	xSemaphoreGive( xEMACSemaphore );
+}
+/*-----------------------------------------------------------*/
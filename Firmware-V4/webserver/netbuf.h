@@ -0,0 +1,89 @@
+#ifndef NETBUF__H
+#define NETBUF__H
+
+#include "FreeRTOS.h"
+#include "queue.h"
+#include "uip.h"
+
+/*
+ * Fixed pool of frame buffers shared by the ENC28J60 driver task and the uIP
+ * task.  Received frames travel to uIP on xNetRxQueue, frames to send travel
+ * back on xNetTxQueue, and every buffer returns to the free list after use.
+ * While the pool is empty the driver leaves frames in the controller's own
+ * receive ring instead of dropping them.  Nothing here touches the heap once
+ * vNetBufInit() has run.
+ */
+
+/* Number of frame buffers in the pool. */
+#define netBUF_COUNT			4
+
+/* The largest frame uIP handles plus the CRC the controller reports. */
+#define netBUF_SIZE				( UIP_BUFSIZE + 4 )
+
+typedef struct xNET_BUF
+{
+	struct xNET_BUF *pxNext;
+	unsigned short usLength;
+	unsigned char ucData[ netBUF_SIZE ];
+} xNetBuf;
+
+typedef struct
+{
+	unsigned short usFree;			/* Buffers on the free list now. */
+	unsigned short usMaxUsed;		/* Most buffers out of the pool at once. */
+	unsigned short usRxMaxQueued;	/* Deepest the RX queue got. */
+	unsigned short usTxMaxQueued;	/* Deepest the TX queue got. */
+	unsigned long ulRxFrames;		/* Frames handed to uIP. */
+	unsigned long ulTxFrames;		/* Frames handed to the driver. */
+	unsigned long ulRxDeferred;		/* Times frames were left in the controller
+									for want of a buffer. */
+	unsigned long ulRxOverflow;		/* Controller ring overflows, frames lost. */
+	unsigned long ulRxTooLong;		/* Frames larger than netBUF_SIZE. */
+	unsigned long ulTxNoBuf;		/* uIP output dropped for want of a buffer. */
+	unsigned long ulTxSplit;		/* TCP segments sent as two. */
+	unsigned long ulSpiErrors;		/* Controller bursts cut short, the frame
+									was dropped. */
+} xNetBufStats;
+
+extern xNetBufStats xNetStats;
+extern xQueueHandle xNetRxQueue;
+extern xQueueHandle xNetTxQueue;
+
+/*
+ * Build the free list and the two queues.  Call once before either task
+ * touches a buffer.
+ */
+void vNetBufInit( void );
+
+/*
+ * Take a buffer off the free list, NULL when the pool is empty.
+ */
+xNetBuf *pxNetBufAlloc( void );
+
+/*
+ * Put a buffer back on the free list.  The driver task is woken when this
+ * ends a shortage, it may have frames waiting in the controller.
+ */
+void vNetBufFree( xNetBuf *pxBuf );
+
+/*
+ * Queue a received frame for the uIP task.
+ */
+void vNetBufQueueRx( xNetBuf *pxBuf );
+
+/*
+ * Wake the uIP task without a frame, it receives NULL from xNetRxQueue.  At
+ * most one wake is outstanding and the queue keeps a slot for it, so it never
+ * takes the place of a frame.  The uIP task calls vNetBufWakeRxTaken() when
+ * the NULL arrives.
+ */
+void vNetBufWakeRx( void );
+void vNetBufWakeRxTaken( void );
+
+/*
+ * Queue a frame for the driver task and wake it.  The buffer is freed and
+ * counted as a drop when the queue is full.
+ */
+void vNetBufQueueTx( xNetBuf *pxBuf );
+
+#endif
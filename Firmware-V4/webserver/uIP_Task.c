@@ -65,10 +65,15 @@
 /* uip includes. */
 #include "uip.h"
 #include "uip_arp.h"
+#include "uip_arch.h"
 #include "httpd.h"
+#include "httpd-api.h"
+#include "udpd.h"
 #include "timer.h"
 #include "clock-arch.h"
 #include "modbus.h"
+#include "enc28j60.h"
+#include "netbuf.h"
 
 /*-----------------------------------------------------------*/
 /* How long to wait before attempting to connect the MAC again. */
@@ -76,10 +81,32 @@
 
 /* Shortcut to the header within the Rx buffer. */
 #define xHeader ((struct uip_eth_hdr *) &uip_buf[ 0 ])
+#define xTCPHeader ((struct uip_tcpip_hdr *) &uip_buf[ UIP_LLH_LEN ])
 
 /* Standard constant. */
 #define uipTOTAL_FRAME_HEADER_SIZE	54
 
+/* Longest sleep between looks at the controller.  INT normally wakes the
+driver task first, this only bounds a missed PKTIF (errata pt. 6) and the
+receiver reset delay. */
+#define uipMAX_BLOCK_TIME			( 100 / portTICK_RATE_MS )
+
+/* The driver task only moves frames between the controller and the pool. */
+#define uipEMAC_STACK_SIZE			( configMINIMAL_STACK_SIZE * 2 )
+
+/* uIP keeps one segment per connection unacknowledged.  A peer with delayed
+ACK holds its ACK for a lone segment (200ms on Windows), so TCP data at least
+this long goes out as two segments, the second one draws the ACK at once.
+The host benchmark builds it with a larger value to send every segment whole. */
+#ifndef uipSPLIT_MIN_DATA
+	#define uipSPLIT_MIN_DATA			128
+#endif
+
+/* TCP flags, a segment carrying one of these is sent whole. */
+#define uipTCP_FIN					0x01
+#define uipTCP_SYN					0x02
+#define uipTCP_RST					0x04
+
 
 /*-----------------------------------------------------------*/
 
@@ -88,6 +115,46 @@
  */
 static void prvSetMACAddress( void );
 
+/*
+ * Owns the ENC28J60: brings the link up, moves received frames into pool
+ * buffers for the uIP task and feeds the transmitter from xNetTxQueue.
+ */
+static void prvEMACTask( void *pvParameters );
+
+/*
+ * Run one received frame through uIP and queue or free its buffer.
+ */
+static void prvProcessFrame( xNetBuf *pxBuf );
+
+/*
+ * Queue uip_buf, which lives in pxBuf, for transmission.
+ */
+static void prvSendFrame( xNetBuf *pxBuf );
+
+/*
+ * Cut the TCP data segment in pxBuf in two, the second half goes into a new
+ * buffer that is returned.  NULL when the frame is to be sent whole.
+ */
+static xNetBuf *prvSplitFrame( xNetBuf *pxBuf );
+
+/*
+ * Set the IP length from pxBuf->usLength, advance the sequence number by
+ * usOffset and redo both checksums.
+ */
+static void prvFixSegment( xNetBuf *pxBuf, unsigned short usOffset );
+
+/*
+ * uIP periodic processing, each connection that has output gets its own
+ * buffer from the pool.
+ */
+static void prvPeriodic( void );
+
+/*
+ * Poll the /api/stream connections as soon as the control task publishes a
+ * sample, instead of leaving them to the next periodic pass.
+ */
+static void prvPollStreams( void );
+
 /*
  * Port functions required by the uIP stack.
  */
@@ -96,13 +163,12 @@ clock_time_t clock_time( void );
 
 /*-----------------------------------------------------------*/
 
-/* The semaphore used by the ISR to wake the uIP task. */
+/* The semaphore used by the ISR and the uIP task to wake the driver task. */
 xSemaphoreHandle xEMACSemaphore;
 
 /* The buffer used by the uIP stack.  In this case the pointer is used to
-point to one of the Rx buffers. */
+point into whichever pool buffer is being processed. */
 unsigned char *uip_buf = NULL;
-unsigned char uip_pkg_checked = 0;
 
 /*-----------------------------------------------------------*/
 
@@ -117,84 +183,247 @@ clock_time_t clock_time( void )
 	return xTaskGetTickCount();
 }
 /*-----------------------------------------------------------*/
-void uvIP_packge_proc(unsigned char * buffer, unsigned short length)
+static void prvFixSegment( xNetBuf *pxBuf, unsigned short usOffset )
+{
+unsigned short usIPLength = pxBuf->usLength - UIP_LLH_LEN;
+
+	uip_buf = pxBuf->ucData;
+	xTCPHeader->len[ 0 ] = usIPLength >> 8;
+	xTCPHeader->len[ 1 ] = usIPLength & 0xff;
+
+	if( usOffset > 0 )
+	{
+		uip_add32( xTCPHeader->seqno, usOffset );
+		memcpy( xTCPHeader->seqno, uip_acc32, sizeof( uip_acc32 ) );
+	}
+
+	xTCPHeader->tcpchksum = 0;
+	xTCPHeader->tcpchksum = ~( uip_tcpchksum() );
+	xTCPHeader->ipchksum = 0;
+	xTCPHeader->ipchksum = ~( uip_ipchksum() );
+}
+/*-----------------------------------------------------------*/
+
+static xNetBuf *prvSplitFrame( xNetBuf *pxBuf )
+{
+xNetBuf *pxSecond;
+unsigned short usData, usFirst;
+const unsigned short usHeaders = UIP_LLH_LEN + UIP_TCPIP_HLEN;
+
+	/* uip-split.c does this for full size segments only, in place, which
+	leaves out the smaller ones httpd and Modbus/TCP send most of the time.
+	With the pool only the second half has to be copied. */
+	uip_buf = pxBuf->ucData;
+	if( ( xHeader->type != htons( UIP_ETHTYPE_IP ) ) ||
+		( xTCPHeader->proto != UIP_PROTO_TCP ) ||
+		( xTCPHeader->tcpoffset != ( 5 << 4 ) ) ||
+		( ( xTCPHeader->flags & ( uipTCP_FIN | uipTCP_SYN | uipTCP_RST ) ) != 0 ) ||
+		( pxBuf->usLength < usHeaders + uipSPLIT_MIN_DATA ) )
+	{
+		return NULL;
+	}
+
+	pxSecond = pxNetBufAlloc();
+	if( pxSecond == NULL )
+	{
+		return NULL;
+	}
+
+	/* On a retransmission uIP builds the whole segment again and it is
+	split the same way.  An ACK for the first half alone is ignored by uIP,
+	the connection moves on when both are acknowledged. */
+	usData = pxBuf->usLength - usHeaders;
+	usFirst = usData / 2;
+	memcpy( pxSecond->ucData, pxBuf->ucData, usHeaders );
+	memcpy( pxSecond->ucData + usHeaders, pxBuf->ucData + usHeaders + usFirst, usData - usFirst );
+	pxSecond->usLength = usHeaders + usData - usFirst;
+	pxBuf->usLength = usHeaders + usFirst;
+
+	prvFixSegment( pxBuf, 0 );
+	prvFixSegment( pxSecond, usFirst );
+	xNetStats.ulTxSplit++;
+
+	return pxSecond;
+}
+/*-----------------------------------------------------------*/
+
+static void prvSendFrame( xNetBuf *pxBuf )
 {
-	uip_buf = buffer;
-	uip_len = length;
-
-	uip_pkg_checked = 0;
-	if( ( uip_len > 0 ) && ( uip_buf != NULL ) ){
-		//uip_pkg_checked = 1;
-		/* Standard uIP loop taken from the uIP manual. */
-		if( xHeader->type == htons( UIP_ETHTYPE_IP ) )
+xNetBuf *pxSecond;
+
+	pxBuf->usLength = uip_len;
+	pxSecond = prvSplitFrame( pxBuf );
+	vNetBufQueueTx( pxBuf );
+	if( pxSecond != NULL )
+	{
+		vNetBufQueueTx( pxSecond );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvProcessFrame( xNetBuf *pxBuf )
+{
+	uip_buf = pxBuf->ucData;
+	uip_len = pxBuf->usLength;
+
+	/* Standard uIP loop taken from the uIP manual. */
+	if( xHeader->type == htons( UIP_ETHTYPE_IP ) )
+	{
+		uip_arp_ipin();
+		uip_input();
+
+#if UIP_UDP
+		/* Answers are addressed through the UDP sockets. */
+		udpd_done();
+#endif /* UIP_UDP */
+
+		/* If the above function invocation resulted in data that
+		should be sent out on the network, the global variable
+		uip_len is set to a value > 0. */
+		if( uip_len > 0 )
 		{
-			uip_arp_ipin();
-			uip_input();
-	
-			/* If the above function invocation resulted in data that
-			should be sent out on the network, the global variable
-			uip_len is set to a value > 0. */
-			if( uip_len > 0 )
+			uip_arp_out();
+			prvSendFrame( pxBuf );
+			return;
+		}
+	}
+	else if( xHeader->type == htons( UIP_ETHTYPE_ARP ) )
+	{
+		uip_arp_arpin();
+
+		/* If the above function invocation resulted in data that
+		should be sent out on the network, the global variable
+		uip_len is set to a value > 0. */
+		if( uip_len > 0 )
+		{
+			prvSendFrame( pxBuf );
+			return;
+		}
+	}
+
+	vNetBufFree( pxBuf );
+}
+/*-----------------------------------------------------------*/
+
+static void prvPeriodic( void )
+{
+portBASE_TYPE i;
+xNetBuf *pxBuf = NULL;
+
+	for( i = 0; i < UIP_CONNS; i++ )
+	{
+		if( pxBuf == NULL )
+		{
+			/* Connections left out now are polled on the next pass. */
+			pxBuf = pxNetBufAlloc();
+			if( pxBuf == NULL )
 			{
-				uip_arp_out();
-				eth_send(uip_buf,uip_len);
-				uip_buf = NULL;
+				xNetStats.ulTxNoBuf++;
+				return;
 			}
+			uip_buf = pxBuf->ucData;
 		}
-		else if( xHeader->type == htons( UIP_ETHTYPE_ARP ) )
+
+		uip_periodic( i );
+
+		/* If the above function invocation resulted in data that
+		should be sent out on the network, the global variable
+		uip_len is set to a value > 0. */
+		if( uip_len > 0 )
 		{
-			uip_arp_arpin();
-	
-			/* If the above function invocation resulted in data that
-			should be sent out on the network, the global variable
-			uip_len is set to a value > 0. */
-			if( uip_len > 0 )
+			uip_arp_out();
+			prvSendFrame( pxBuf );
+			pxBuf = NULL;
+		}
+	}
+
+#if UIP_UDP
+	for( i = 0; i < UIP_UDP_CONNS; i++ )
+	{
+		if( pxBuf == NULL )
+		{
+			pxBuf = pxNetBufAlloc();
+			if( pxBuf == NULL )
 			{
-				eth_send(uip_buf,uip_len);
-				uip_buf = NULL;
+				xNetStats.ulTxNoBuf++;
+				return;
 			}
+			uip_buf = pxBuf->ucData;
+		}
+
+		uip_udp_periodic( i );
+
+		/* If the above function invocation resulted in data that
+		should be sent out on the network, the global variable
+		uip_len is set to a value > 0. */
+		if( uip_len > 0 )
+		{
+			uip_arp_out();
+			prvSendFrame( pxBuf );
+			pxBuf = NULL;
 		}
 	}
+#endif /* UIP_UDP */
+
+	if( pxBuf != NULL )
+	{
+		vNetBufFree( pxBuf );
+	}
 }
+/*-----------------------------------------------------------*/
 
-void vuIP_Task( void *pvParameters )
+static void prvPollStreams( void )
 {
 portBASE_TYPE i;
-uip_ipaddr_t xIPAddr;
-struct timer periodic_timer, arp_timer;
-
-	( void ) pvParameters;
+xNetBuf *pxBuf = NULL;
 
-	/* Create the semaphore used by the ISR to wake this task. */
-	vSemaphoreCreateBinary( xEMACSemaphore );
+	for( i = 0; i < UIP_CONNS; i++ )
+	{
+		if( httpd_api_streaming( &uip_conns[ i ] ) == 0 )
+		{
+			continue;
+		}
 
-	/* Initialise the uIP stack. */
-	timer_set( &periodic_timer, configTICK_RATE_HZ / 2 );
-	timer_set( &arp_timer, configTICK_RATE_HZ * 10 );
-	uip_init();
-	uip_ipaddr( xIPAddr, configIP_ADDR0, configIP_ADDR1, configIP_ADDR2, configIP_ADDR3 );
-	uip_sethostaddr( xIPAddr );
-	uip_ipaddr( xIPAddr, configNET_MASK0, configNET_MASK1, configNET_MASK2, configNET_MASK3 );
-	uip_setnetmask( xIPAddr );
-	
-	httpd_init();
-	modbus_tcp_init();
+		if( pxBuf == NULL )
+		{
+			pxBuf = pxNetBufAlloc();
+			if( pxBuf == NULL )
+			{
+				/* The periodic pass picks the sample up. */
+				xNetStats.ulTxNoBuf++;
+				return;
+			}
+			uip_buf = pxBuf->ucData;
+		}
 
+		uip_poll_conn( &uip_conns[ i ] );
+		if( uip_len > 0 )
+		{
+			uip_arp_out();
+			prvSendFrame( pxBuf );
+			pxBuf = NULL;
+		}
+	}
 
-	/* Initialise the MAC. */
-	/*while( xEthInitialise() != pdPASS )
+	if( pxBuf != NULL )
 	{
-		vTaskDelay( uipINIT_WAIT );
-	}*/
-	
-	
+		vNetBufFree( pxBuf );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvEMACTask( void *pvParameters )
+{
+portBASE_TYPE i;
+xNetBuf *pxTx = NULL;
+
+	( void ) pvParameters;
+
 	for( ;; ){
 	
 		if ( eth_init(0) == 0 )
 			continue;
 			
-		prvSetMACAddress();
-
 		i = 0;
 		do {
 			if ( eth_check_link() )
@@ -210,61 +439,108 @@ struct timer periodic_timer, arp_timer;
 		
 		for( ;; )
 		{
-			/* Is there received data ready to be processed? */
+			/* Take every packet the controller holds, the uIP task works
+			on them while this task goes on with the next ones. */
 			eth_rx();
+
+			/* Hand the transmitter the next frame once the last one is
+			out, its end raises INT and wakes us again. */
+			if( pxTx == NULL )
+			{
+				xQueueReceive( xNetTxQueue, &pxTx, 0 );
+			}
+			if( ( pxTx != NULL ) && ( eth_tx_busy() == 0 ) )
+			{
+				eth_send( pxTx->ucData, pxTx->usLength );
+				vNetBufFree( pxTx );
+				pxTx = NULL;
+				continue;
+			}
+
+			/* Sleep until the ENC28J60 pulls INT, which gives the semaphore
+			from the EXTI handler, or the uIP task queues a frame. */
+			xSemaphoreTake( xEMACSemaphore, uipMAX_BLOCK_TIME );
+
+			/* The PHY reports link changes through INT, so the link
+			only has to be read back after one. */
+			if( eth_link_event() && ( eth_check_link() == 0 ) ){
+				break;							
+			}					
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vuIP_Task( void *pvParameters )
+{
+uip_ipaddr_t xIPAddr;
+struct timer periodic_timer, arp_timer;
+portTickType xBlockTime;
+xNetBuf *pxBuf;
+
+	( void ) pvParameters;
+
+	/* Create the semaphore used by the ISR to wake the driver task, and the
+	buffer pool the two tasks share. */
+	vSemaphoreCreateBinary( xEMACSemaphore );
+	vNetBufInit();
+
+	/* Initialise the uIP stack. */
+	timer_set( &periodic_timer, configTICK_RATE_HZ / 2 );
+	timer_set( &arp_timer, configTICK_RATE_HZ * 10 );
+	uip_init();
+	uip_ipaddr( xIPAddr, configIP_ADDR0, configIP_ADDR1, configIP_ADDR2, configIP_ADDR3 );
+	uip_sethostaddr( xIPAddr );
+	uip_ipaddr( xIPAddr, configNET_MASK0, configNET_MASK1, configNET_MASK2, configNET_MASK3 );
+	uip_setnetmask( xIPAddr );
+	prvSetMACAddress();
 	
-			if( uip_pkg_checked	) {
+	httpd_init();
+	modbus_tcp_init();
+#if UIP_UDP
+	udpd_init();
+#endif /* UIP_UDP */
+
+	xTaskCreate( prvEMACTask, ( signed char * ) "EMAC", uipEMAC_STACK_SIZE, NULL, uxTaskPriorityGet( NULL ), NULL );
+
+	for( ;; )
+	{
+		/* Wait for a frame from the driver task, but no longer than the
+		periodic timer allows. */
+		xBlockTime = periodic_timer.start + periodic_timer.interval - clock_time();
+		if( xBlockTime > configTICK_RATE_HZ )
+		{
+			/* Already expired. */
+			xBlockTime = 0;
+		}
+		if( xQueueReceive( xNetRxQueue, &pxBuf, xBlockTime ) == pdPASS )
+		{
+			if( pxBuf != NULL )
+			{
+				prvProcessFrame( pxBuf );
 			}
 			else
 			{
-				if( ( timer_expired( &periodic_timer ) ) && ( uip_buf != NULL ) )
-				{
-					timer_reset( &periodic_timer );
-					for( i = 0; i < UIP_CONNS; i++ )
-					{
-						uip_periodic( i );
-	
-						/* If the above function invocation resulted in data that
-						should be sent out on the network, the global variable
-						uip_len is set to a value > 0. */
-						if( uip_len > 0 )
-						{
-							uip_arp_out();
-							eth_send(uip_buf,uip_len);
-						}
-					}
-
-				#if UIP_UDP
-				    for(i = 0; i < UIP_UDP_CONNS; i++) {
-						uip_udp_periodic(i);
-						/* If the above function invocation resulted in data that
-						   should be sent out on the network, the global variable
-						   uip_len is set to a value > 0. */
-						if(uip_len > 0) {
-							uip_arp_out();
-						  	eth_send(uip_buf,uip_len);
-						}
-					}
-				#endif /* UIP_UDP */	
-					/* Call the ARP timer function every 10 seconds. */
-					if( timer_expired( &arp_timer ) )
-					{
-						timer_reset( &arp_timer );
-						uip_arp_timer();
-					}
-				}
-				else
-				{
-					/* We did not receive a packet, and there was no periodic
-					processing to perform.  Block for a fixed period.  If a packet
-					is received during this period we will be woken by the ISR
-					giving us the Semaphore. */
-					xSemaphoreTake( xEMACSemaphore, configTICK_RATE_HZ / 100 );
-					//vTaskDelay( 10 / portTICK_RATE_MS );
-					if ( eth_check_link() == 0 ){
-						break;							
-					}					
-				}
+				/* Woken by httpd_api_sample(). */
+				vNetBufWakeRxTaken();
+			}
+		}
+
+		if( httpd_api_poll() )
+		{
+			prvPollStreams();
+		}
+
+		if( timer_expired( &periodic_timer ) )
+		{
+			timer_reset( &periodic_timer );
+			prvPeriodic();
+
+			/* Call the ARP timer function every 10 seconds. */
+			if( timer_expired( &arp_timer ) )
+			{
+				timer_reset( &arp_timer );
+				uip_arp_timer();
 			}
 		}
 	}
@@ -0,0 +1,123 @@
+#include "FreeRTOS.h"
+#include "uip.h"
+#include "uip_arp.h"
+#include "udpd.h"
+#include "modbus.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define UDPBUF ((struct uip_udpip_hdr *)&uip_buf[UIP_LLH_LEN])
+
+#define MB_UDP_PORT 502
+
+static const uip_ipaddr_t all_ones = {0xffff, 0xffff};
+
+/* uip.c has this, uip.h only the macro that sets it */
+extern u16_t uip_slen;
+
+/*---------------------------------------------------------------------------*/
+static struct uip_udp_conn *
+find_port(u16_t port)
+{
+  struct uip_udp_conn *c;
+
+  for(c = &uip_udp_conns[0]; c < &uip_udp_conns[UIP_UDP_CONNS]; c++) {
+    if(c->lport == port) {
+      return c;
+    }
+  }
+  return NULL;
+}
+/*---------------------------------------------------------------------------*/
+static void
+discover(void)
+{
+  struct uip_udp_conn *mb = find_port(HTONS(MB_UDP_PORT));
+  int len;
+
+  if(uip_datalen() < sizeof(UDPD_DISCOVER_QUERY) - 1 ||
+     memcmp(uip_appdata, UDPD_DISCOVER_QUERY,
+            sizeof(UDPD_DISCOVER_QUERY) - 1) != 0) {
+    return;
+  }
+
+  len = snprintf((char *)uip_appdata, UIP_APPDATA_SIZE,
+                 "{\"ip\":\"%u.%u.%u.%u\","
+                 "\"mac\":\"%02x:%02x:%02x:%02x:%02x:%02x\","
+                 "\"fw\":\"%s\","
+                 "\"st_l\":%u,\"st_r\":%u,\"mpump\":%u,\"vmeter\":%u,"
+                 "\"auto\":%u,\"mbudp\":%lu}\n",
+                 uip_ipaddr1(uip_hostaddr), uip_ipaddr2(uip_hostaddr),
+                 uip_ipaddr3(uip_hostaddr), uip_ipaddr4(uip_hostaddr),
+                 uip_ethaddr.addr[0], uip_ethaddr.addr[1], uip_ethaddr.addr[2],
+                 uip_ethaddr.addr[3], uip_ethaddr.addr[4], uip_ethaddr.addr[5],
+                 configFW_VERSION,
+                 eMBRegInput_Read(MB_HV_ST_L), eMBRegInput_Read(MB_HV_ST_R),
+                 eMBRegInput_Read(MB_MPUMP_ST), eMBRegInput_Read(MB_VMETER_ST),
+                 eMBRegInput_Read(MB_SYS_AUTOCTL_ST),
+                 mb != NULL ? mb->appstate.requests : 0UL);
+  if(len > 0 && len < UIP_APPDATA_SIZE) {
+    /* A tool on another subnet, or one that has no address yet, is not
+       reachable through the router, it hears the broadcast. */
+    if(!uip_ipaddr_maskcmp(UDPBUF->srcipaddr, uip_hostaddr, uip_netmask)) {
+      uip_ipaddr_copy(uip_udp_conn->ripaddr, all_ones);
+    }
+    uip_udp_send(len);
+  }
+}
+/*---------------------------------------------------------------------------*/
+void
+udpd_init(void)
+{
+  struct uip_udp_conn *c;
+
+  for(c = &uip_udp_conns[0]; c < &uip_udp_conns[UIP_UDP_CONNS]; c++) {
+    c->appstate.requests = 0;
+  }
+  modbus_udp_init();
+
+  c = uip_udp_new(NULL, 0);
+  if(c != NULL) {
+    uip_udp_bind(c, HTONS(UDPD_DISCOVER_PORT));
+  }
+}
+/*---------------------------------------------------------------------------*/
+void
+udpd_appcall(void)
+{
+  if(!uip_newdata()) {
+    return;
+  }
+
+  /* uIP sends the answer to the socket's remote address and port. */
+  uip_udp_conn->rport = UDPBUF->srcport;
+  uip_ipaddr_copy(uip_udp_conn->ripaddr, UDPBUF->srcipaddr);
+
+  switch(uip_udp_conn->lport) {
+  case HTONS(MB_UDP_PORT):
+    modbus_udp_appcall();
+    break;
+  case HTONS(UDPD_DISCOVER_PORT):
+    discover();
+    break;
+  default:
+    break;
+  }
+  /* Served, not merely received. */
+  if(uip_slen > 0) {
+    uip_udp_conn->appstate.requests++;
+  }
+}
+/*---------------------------------------------------------------------------*/
+void
+udpd_done(void)
+{
+  struct uip_udp_conn *c;
+
+  for(c = &uip_udp_conns[0]; c < &uip_udp_conns[UIP_UDP_CONNS]; c++) {
+    c->rport = 0;
+    uip_ipaddr(c->ripaddr, 0, 0, 0, 0);
+  }
+}
+/*---------------------------------------------------------------------------*/
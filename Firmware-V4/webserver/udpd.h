@@ -0,0 +1,33 @@
+/*
+ * UDP services.
+ *
+ *   502    Modbus/UDP, MBAP framed requests answered from the register image
+ *   30303  discovery, a datagram starting with UDPD_DISCOVER_QUERY, sent to
+ *          the unit or to 255.255.255.255, is answered with one JSON line:
+ *          {"ip":"192.168.1.11","mac":"00:12:13:10:15:11","fw":"0.1",
+ *           "st_l":0,"st_r":0,"mpump":0,"vmeter":0,"auto":0,"mbudp":0}
+ *          sent back to the querying port, broadcast when the sender is not
+ *          on our subnet
+ *
+ * Included from uip-conf.h through webserver.h, so nothing from uIP here.
+ */
+
+#ifndef __UDPD_H__
+#define __UDPD_H__
+
+#define UDPD_DISCOVER_PORT  30303
+#define UDPD_DISCOVER_QUERY "GL696?"
+
+struct udpd_state {
+  unsigned long requests;
+};
+
+void udpd_init(void);
+void udpd_appcall(void);
+
+/* Called by the uIP task after uip_input(), an answer is addressed through
+   the socket's remote address and port, this opens them up again for the
+   next sender. */
+void udpd_done(void);
+
+#endif /* __UDPD_H__ */
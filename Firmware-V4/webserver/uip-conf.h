@@ -113,7 +113,7 @@ typedef unsigned short uip_stats_t;
  *
  * \hideinitializer
  */
-#define UIP_CONF_BYTE_ORDER      LITTLE_ENDIAN
+#define UIP_CONF_BYTE_ORDER      UIP_LITTLE_ENDIAN
 
 /**
  * Logging on or off
@@ -127,7 +127,21 @@ typedef unsigned short uip_stats_t;
  *
  * \hideinitializer
  */
-#define UIP_CONF_UDP             0
+#define UIP_CONF_UDP             1
+
+/**
+ * Number of UDP sockets, Modbus/UDP and discovery
+ *
+ * \hideinitializer
+ */
+#define UIP_CONF_UDP_CONNS       2
+
+/**
+ * Take UDP sent to 255.255.255.255, discovery queries come that way
+ *
+ * \hideinitializer
+ */
+#define UIP_CONF_BROADCAST       1
 
 /**
  * UDP checksums on or off
@@ -45,5 +45,12 @@ typedef struct httpd_state uip_tcp_appstate_t;
 #define UIP_APPCALL     httpd_appcall
 #endif
 
+#include "udpd.h"
+
+typedef struct udpd_state uip_udp_appstate_t;
+#ifndef UIP_UDP_APPCALL
+#define UIP_UDP_APPCALL udpd_appcall
+#endif
+
 
 #endif /* __WEBSERVER_H__ */
@@ -0,0 +1,308 @@
+/* Includes ------------------------------------------------------------------*/
+
+#include "string.h"
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "stm32f10x.h"
+#include "lcd.h"
+#include "fonts.h"
+#include "widget.h"
+
+
+/* Private typedef -----------------------------------------------------------*/
+
+typedef struct
+{
+	psWidget w;
+	uint8_t first;
+	uint8_t count;
+} sDirtyRect;
+
+/* Private define ------------------------------------------------------------*/
+
+#define IS_HZ(c)	( (uint8_t)(c) > 0xA0 )
+
+#if WIDGET_DOUBLE_BUFFER
+#define WIDGET_PAGES	2
+#else
+#define WIDGET_PAGES	1
+#endif
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+
+static sDirtyRect dirty[WIDGET_DIRTY_MAX];
+static uint32_t budget_left = WIDGET_PIXEL_BUDGET;
+static portTickType budget_start;
+
+sWidgetStats WidgetStats;
+
+/* Private function prototypes -----------------------------------------------*/
+/* Private functions ---------------------------------------------------------*/
+
+/* Cell i is the second half of a CJK character in s. */
+static portBASE_TYPE Widget_HzTail(const char* s, uint8_t i)
+{
+	uint8_t j;
+
+	for(j=0;j<i;j++){
+		if ( IS_HZ(s[j]) && s[j+1] != 0 )
+			j++;
+	}
+	return j > i;
+}
+
+static portBASE_TYPE Widget_CellChanged(psWidget w, uint8_t i)
+{
+	return w->shown[i] != w->text[i];
+}
+
+/* Microseconds from the tick count and SysTick, fine enough to time a frame
+   shorter than a tick.  Wraps, only differences are meaningful. */
+static uint32_t Widget_Microseconds(void)
+{
+	portTickType ticks;
+	uint32_t count;
+
+	do {
+		ticks = xTaskGetTickCount();
+		count = SysTick->LOAD - SysTick->VAL;
+	} while ( ticks != xTaskGetTickCount() );
+	return ticks * ( 1000000 / configTICK_RATE_HZ ) + count / ( configCPU_CLOCK_HZ / 1000000 );
+}
+
+/* Draws the first n dirty rectangles into the page written now. */
+static void Widget_DrawRects(uint8_t n, sFONT* font)
+{
+	char str[WIDGET_TEXT_MAX+1];
+	psWidget w;
+	uint8_t i;
+
+	for(i=0;i<n;i++){
+		w = dirty[i].w;
+		memcpy(str, &w->text[dirty[i].first], dirty[i].count);
+		str[dirty[i].count] = 0;
+		LCD_SetTextColor(w->color);
+		LCD_SetCursor(w->x + dirty[i].first * font->Width, w->y);
+		LCD_DisplayString(str);
+	}
+}
+
+void Widget_Init(psWidget w, uint16_t x, uint16_t y, uint8_t cells, uint16_t color)
+{
+	if ( cells > WIDGET_TEXT_MAX )
+		cells = WIDGET_TEXT_MAX;
+	w->x = x;
+	w->y = y;
+	w->cells = cells;
+	w->color = color;
+	memset(w->text, ' ', cells);
+	w->text[cells] = 0;
+	memset(w->shown, 0, sizeof(w->shown));
+	w->next = NULL;
+}
+
+void Widget_Link(psWidget* list, psWidget w)
+{
+	w->next = *list;
+	*list = w;
+}
+
+void Widget_SetText(psWidget w, const char* text)
+{
+	uint8_t i;
+
+	for(i=0;i<w->cells && text[i] != 0;i++)
+		w->text[i] = text[i];
+	/* A CJK character cut in half would eat the padding. */
+	if ( i == w->cells && text[i] != 0 && IS_HZ(w->text[i-1]) && !Widget_HzTail(w->text, i-1) )
+		i--;
+	for(;i<w->cells;i++)
+		w->text[i] = ' ';
+}
+
+/* value/div with decimals digits after the point, rounded, right aligned to
+   at least width characters like printf("%*.*f").  value * 10^decimals has
+   to fit in 32 bits, the register values are 16 bit. */
+void Widget_SetFixed(psWidget w, uint32_t value, uint32_t div, uint8_t decimals, uint8_t width)
+{
+	char str[12], *p = &str[sizeof(str)-1];
+	uint32_t scale = 1;
+	uint8_t i;
+
+	for(i=0;i<decimals;i++)
+		scale *= 10;
+	value = (value * scale + div / 2) / div;
+
+	*p = 0;
+	for(i=0;i<decimals;i++){
+		*--p = '0' + value % 10;
+		value /= 10;
+	}
+	if ( decimals )
+		*--p = '.';
+	do {
+		*--p = '0' + value % 10;
+		value /= 10;
+	} while ( value );
+	while ( &str[sizeof(str)-1] - p < width && p > str )
+		*--p = ' ';
+
+	Widget_SetText(w, p);
+}
+
+/* printf("%.2E") without the floating point printf. */
+void Widget_SetSci(psWidget w, float value)
+{
+	char str[12];
+	int8_t exp = 0;
+	uint16_t m;
+
+	if ( value < 0 )
+		value = 0;
+	if ( value > 0 ){
+		while ( value >= 10.0f ){
+			value /= 10.0f;
+			exp++;
+		}
+		while ( value < 1.0f ){
+			value *= 10.0f;
+			exp--;
+		}
+	}
+	m = (uint16_t)(value * 100.0f + 0.5f);
+	if ( m >= 1000 ){
+		m /= 10;
+		exp++;
+	}
+
+	str[0] = '0' + m / 100;
+	str[1] = '.';
+	str[2] = '0' + m / 10 % 10;
+	str[3] = '0' + m % 10;
+	str[4] = 'E';
+	str[5] = exp < 0 ? '-' : '+';
+	if ( exp < 0 )
+		exp = -exp;
+	str[6] = '0' + exp / 10;
+	str[7] = '0' + exp % 10;
+	str[8] = 0;
+
+	Widget_SetText(w, str);
+}
+
+void Widget_SetColor(psWidget w, uint16_t color)
+{
+	if ( w->color != color ){
+		w->color = color;
+		memset(w->shown, 0, sizeof(w->shown));
+	}
+}
+
+/* The screen under the widgets was drawn over, draw all of them again. */
+void Widget_Invalidate(psWidget list)
+{
+	for(;list!=NULL;list=list->next)
+		memset(list->shown, 0, sizeof(list->shown));
+}
+
+/*
+ * Collects the changed cells of every widget in the list as one rectangle
+ * per run and draws them, as long as this second's budget lasts.  Cells
+ * that did not fit stay different from shown[] and are found again by the
+ * next flush.  Returns the pixels written, in both pages.
+ */
+uint32_t Widget_Flush(psWidget list)
+{
+	sFONT* font = LCD_GetFont_EN();
+	uint32_t cell_px = (uint32_t)font->Width * font->Height * WIDGET_PAGES;
+	uint32_t written = 0, start;
+	uint16_t text_color;
+	uint8_t n = 0, i, first, count, afford, cut = 0;
+	portTickType now = xTaskGetTickCount();
+	psWidget w;
+
+	if ( now - budget_start >= configTICK_RATE_HZ ){
+		budget_start = now;
+		budget_left = WIDGET_PIXEL_BUDGET;
+	}
+
+	for(w=list;w!=NULL && n<WIDGET_DIRTY_MAX;w=w->next){
+		for(i=0;i<w->cells && n<WIDGET_DIRTY_MAX;){
+			if ( !Widget_CellChanged(w, i) ){
+				i++;
+				continue;
+			}
+			first = i;
+			while ( i < w->cells && Widget_CellChanged(w, i) )
+				i++;
+			/* A CJK glyph is drawn whole, in the old text and in the new. */
+			if ( Widget_HzTail(w->text, first) || Widget_HzTail(w->shown, first) )
+				first--;
+			if ( i < w->cells && (Widget_HzTail(w->text, i) || Widget_HzTail(w->shown, i)) )
+				i++;
+			if ( n > 0 && dirty[n-1].w == w && dirty[n-1].first + dirty[n-1].count >= first ){
+				dirty[n-1].count = i - dirty[n-1].first;
+			} else {
+				dirty[n].w = w;
+				dirty[n].first = first;
+				dirty[n].count = i - first;
+				n++;
+			}
+		}
+	}
+
+	/* What the budget affords, cut at a whole glyph. */
+	for(i=0;i<n;i++){
+		w = dirty[i].w;
+		first = dirty[i].first;
+		count = dirty[i].count;
+
+		afford = budget_left / cell_px < count ? budget_left / cell_px : count;
+		if ( afford < count && Widget_HzTail(w->text, first + afford) )
+			afford--;
+		if ( afford < count )
+			cut = 1;
+		if ( afford == 0 )
+			break;
+		dirty[i].count = afford;
+		budget_left -= afford * cell_px;
+		written += afford * cell_px;
+	}
+	n = i;
+	if ( cut )
+		WidgetStats.budget_cuts++;
+	if ( n == 0 )
+		return 0;
+
+	start = Widget_Microseconds();
+	text_color = LCD_GetTextColor();
+#if WIDGET_DOUBLE_BUFFER
+	LCD_DrawHidden();
+	Widget_DrawRects(n, font);
+	LCD_Flip();
+	Widget_DrawRects(n, font);
+	LCD_DrawShown();
+	WidgetStats.flips++;
+#else
+	Widget_DrawRects(n, font);
+#endif
+	LCD_SetTextColor(text_color);
+
+	for(i=0;i<n;i++){
+		w = dirty[i].w;
+		memcpy(&w->shown[dirty[i].first], &w->text[dirty[i].first], dirty[i].count);
+	}
+
+	WidgetStats.frames++;
+	WidgetStats.pixels += written;
+	WidgetStats.frame_pixels = written;
+	WidgetStats.frame_us = Widget_Microseconds() - start;
+	if ( WidgetStats.frame_us > WidgetStats.max_frame_us )
+		WidgetStats.max_frame_us = WidgetStats.frame_us;
+
+	return written;
+}
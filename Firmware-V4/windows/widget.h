@@ -0,0 +1,72 @@
+/*
+ * Retained text widgets.
+ *
+ * A widget is a run of glyph cells on one text line, a cell is one glyph of
+ * the current EN font and a CJK character takes two.  Labels, numeric fields
+ * and button captions are all widgets, the setters only change the text the
+ * widget wants to show.  Widget_Flush() compares it with what is on the
+ * screen, collects the changed cells into one rectangle per run and redraws
+ * only those cells, within a bus time budget per second.
+ *
+ * With WIDGET_DOUBLE_BUFFER a flush is a frame: the cells are drawn into the
+ * page that is not shown, the pages are flipped and the same cells are drawn
+ * again into the page that was shown, so both pages hold the frame and the
+ * panel never shows a half drawn number.  The static parts of a window have
+ * to be drawn into both pages.
+ */
+
+
+#ifndef __widget_h__
+#define __widget_h__
+
+#include "FreeRTOS.h"
+
+#define WIDGET_TEXT_MAX		16
+#define WIDGET_DIRTY_MAX	16
+
+#ifndef WIDGET_DOUBLE_BUFFER
+#define WIDGET_DOUBLE_BUFFER	1
+#endif
+
+/* Bus time the widgets may take from the other tasks in each second, and
+   the pixels LCD_DrawChar() draws as text in a millisecond (test_widget on
+   the bus model, 16x32 readings on black).  What does not fit is drawn in
+   the next second. */
+#define WIDGET_BUS_MS_PER_SEC	40
+#define WIDGET_PIXELS_PER_MS	5800
+#define WIDGET_PIXEL_BUDGET		( (uint32_t)WIDGET_BUS_MS_PER_SEC * WIDGET_PIXELS_PER_MS )
+
+typedef struct S_WIDGET
+{
+	uint16_t x,y;
+	uint8_t cells;
+	uint16_t color;
+	char text[WIDGET_TEXT_MAX+1];		/* wanted, padded with spaces */
+	char shown[WIDGET_TEXT_MAX+1];		/* on the screen, 0 is unknown */
+	struct S_WIDGET* next;
+} sWidget,*psWidget;
+
+/* For profiling, frames are flushes that drew something. */
+typedef struct
+{
+	uint32_t frames;
+	uint32_t flips;
+	uint32_t pixels;			/* all frames, both pages */
+	uint32_t frame_pixels;		/* last frame */
+	uint32_t frame_us;			/* last frame, from the first cell to the last */
+	uint32_t max_frame_us;
+	uint32_t budget_cuts;		/* frames that left cells for the next second */
+} sWidgetStats;
+
+extern sWidgetStats WidgetStats;
+
+void Widget_Init(psWidget w, uint16_t x, uint16_t y, uint8_t cells, uint16_t color);
+void Widget_Link(psWidget* list, psWidget w);
+void Widget_SetText(psWidget w, const char* text);
+void Widget_SetFixed(psWidget w, uint32_t value, uint32_t div, uint8_t decimals, uint8_t width);
+void Widget_SetSci(psWidget w, float value);
+void Widget_SetColor(psWidget w, uint16_t color);
+void Widget_Invalidate(psWidget list);
+uint32_t Widget_Flush(psWidget list);
+
+#endif
@@ -12,6 +12,7 @@
 #include "stm32f10x.h"
 #include "window.h"
 #include "win_main.h"
+#include "widget.h"
 
 #include "lcd.h"
 #include "fonts.h"
@@ -39,6 +40,17 @@ static sButton btns[] = {
 
 
 
+#define TEXT_COLOR	0x421F
+#define CELL_W		16
+
+/* Setpoints at their buttons, readings, then the button captions; each
+   field leaves the leading blank of its button to the static layout. */
+static sWidget wgt_set[4];
+static sWidget wgt_fb[4];
+static sWidget wgt_vmeter;
+static sWidget wgt_mpump;
+static sWidget wgt_btn[3];
+
 static portBASE_TYPE page=0;    
 uint32_t hv_set_flag=0;
 uint32_t hv_ctrl_flag=0;
@@ -52,10 +64,80 @@ void main_win_msg(HIDMessage* msg);
 
 
 sWindow win_main = {
-	main_win_msg,0,0
+	main_win_msg,0,0,NULL
 };
 
 
+static void main_win_widgets(void)
+{
+	uint16_t i;
+
+	if ( win_main.psWidgets != NULL )
+		return;
+
+	for(i=0;i<4;i++){
+		Widget_Init(&wgt_set[i],btns[i].x+CELL_W,btns[i].y,5,TEXT_COLOR);
+		Widget_Link(&win_main.psWidgets,&wgt_set[i]);
+	}
+	Widget_Init(&wgt_fb[0],CELL_W*18,32*4+2,5,TEXT_COLOR);
+	Widget_Init(&wgt_fb[1],CELL_W*18,32*5+2,5,TEXT_COLOR);
+	Widget_Init(&wgt_fb[2],CELL_W*33,32*4+2,5,TEXT_COLOR);
+	Widget_Init(&wgt_fb[3],CELL_W*33,32*5+2,5,TEXT_COLOR);
+	for(i=0;i<4;i++)
+		Widget_Link(&win_main.psWidgets,&wgt_fb[i]);
+	Widget_Init(&wgt_vmeter,CELL_W*9,32*6+2,8,TEXT_COLOR);
+	Widget_Link(&win_main.psWidgets,&wgt_vmeter);
+	Widget_Init(&wgt_mpump,CELL_W*31,32*6+2,5,TEXT_COLOR);
+	Widget_Link(&win_main.psWidgets,&wgt_mpump);
+
+	for(i=0;i<3;i++){
+		Widget_Init(&wgt_btn[i],btns[BTN_UP-1+i].x,btns[BTN_UP-1+i].y+16,7,TEXT_COLOR);
+		Widget_Link(&win_main.psWidgets,&wgt_btn[i]);
+	}
+	Widget_SetText(&wgt_btn[BTN_UP-BTN_UP],btns[BTN_UP-1].text);
+	Widget_SetText(&wgt_btn[BTN_DOWN-BTN_UP],btns[BTN_DOWN-1].text);
+}
+
+static void main_win_setpoints(void)
+{
+	uint16_t set[4];
+	uint16_t i;
+
+	portENTER_CRITICAL();
+	set[0] = hvsl.vol_set;
+	set[1] = hvsl.cur_set;
+	set[2] = hvsr.vol_set;
+	set[3] = hvsr.cur_set;
+	portEXIT_CRITICAL();
+
+	for(i=0;i<4;i++){
+		if ( i & 1 )
+			Widget_SetFixed(&wgt_set[i],set[i],10000,2,1);
+		else
+			Widget_SetFixed(&wgt_set[i],set[i],1000,1,2);
+		Widget_SetColor(&wgt_set[i],i+1 == hv_set_flag ? Red : TEXT_COLOR);
+	}
+}
+
+//one UP/DOWN step of a set point. It goes in as a host write would, the
+//gun's job loads it from there and FC03 reads back what the panel set
+static void main_win_step_set(uint16_t addr,uint16_t max,uint16_t btn)
+{
+	uint16_t set = eMBRegHolding_Read(addr);
+
+	if ( btn == BTN_UP )
+		set = set+100 > max ? max : set+100;
+	else
+		set = set > 100 ? set - 100 : 0;
+	eMBRegHolding_WriteNotify(addr,&set,1);
+}
+
+static void main_win_start_stop(void)
+{
+	Widget_SetText(&wgt_btn[BTN_START_STOP-BTN_UP],hv_start_stop ? " ͣ ֹ " : "   ");
+}
+
+
 void main_win_draw(void)
 {
 //	char str[64];
@@ -66,12 +148,14 @@ void main_win_draw(void)
 	LCD_SetFont_EN(&EN_Font16x32);
 	LCD_SetFont_CH(&CH_Font32x32);
 
-//	for(i=0;i<2;i++)
+	/* Into both pages, the widgets flip between them.  The hidden one
+	   first, the old screen stays up until the new one is complete. */
+	for(i=0;i<2;i++)
 	{
-		//if ( i )
-			LCD_SET_PAGE(LCD_WRITE_PAGE0 | LCD_DISPLAY_PAGE1);
-		//else
-		//	LCD_SET_PAGE(LCD_WRITE_PAGE1 | LCD_DISPLAY_PAGE0);
+		if ( i )
+			LCD_Flip();
+		else
+			LCD_DrawHidden();
 	
 		LCD_SetCursor(x=2,y=2);
 		LCD_DisplayString("         AL-901              \r\n\r\n");
@@ -91,78 +175,47 @@ void main_win_draw(void)
 		LCD_DisplayString("   ҵӼι˾    \r\n");
 		LCD_DisplayString("  ͷ绰: 010-12345678 13812345678   \r\n");
 	}
-	LCD_SET_PAGE(LCD_WRITE_PAGE0 | LCD_DISPLAY_PAGE0);
+	LCD_DrawShown();
 	
 	//LCD_DrawRect(0,0,LCD_SCR_WIDTH,LCD_SCR_HIGH);
+
+	main_win_widgets();
+	main_win_start_stop();
+	Widget_Invalidate(win_main.psWidgets);
 }
 
 void main_win_refresh(void)
 {
-	char str[32];
-	uint16_t sample;
-	uint16_t x,y,i;
-	static uint32_t page = 0;
-
-	for(i=1;i<5;i++){
-		portENTER_CRITICAL();
-		if ( i == BTN_HVL_SETV )
-			sprintf(str," %2.1f ",(float)hvsl.vol_set/1000);
-		else if ( i == BTN_HVL_SETC )
-			sprintf(str," %1.2f ",(float)hvsl.cur_set/10000);
-		else if ( i == BTN_HVR_SETV )
-			sprintf(str," %2.1f ",(float)hvsr.vol_set/1000);
-		else if ( i == BTN_HVR_SETC )
-			sprintf(str," %1.2f ",(float)hvsr.cur_set/10000);
-		portEXIT_CRITICAL();
-		if ( i == hv_set_flag )
-			LCD_SetTextColor(Red);
-		LCD_SetCursor(btns[i-1].x,btns[i-1].y);
-		LCD_DisplayString(str);
-		LCD_SetTextColor( 0x421F );
-	}
-	
-	portENTER_CRITICAL();
-	sprintf(str," %2.1f ",(float)hvsl.vol_fb/1000);
-	portEXIT_CRITICAL();
-	LCD_SetCursor(16*17,32*4+2);
-	LCD_DisplayString(str);
+	uint16_t fb[4];
+	uint16_t mpump;
+	float vm;
+	uint16_t i;
 
-	portENTER_CRITICAL();
-	sprintf(str," %1.2f ",(float)hvsl.cur_fb/10000);
-	portEXIT_CRITICAL();
-	LCD_SetCursor(16*17,32*5+2);
-	LCD_DisplayString(str);
+	main_win_setpoints();
 
 	portENTER_CRITICAL();
-	sprintf(str," %2.1f ",(float)hvsr.vol_fb/1000);
+	fb[0] = hvsl.vol_fb;
+	fb[1] = hvsl.cur_fb;
+	fb[2] = hvsr.vol_fb;
+	fb[3] = hvsr.cur_fb;
+	vm = vmeter;
+	mpump = eMBRegInput_Read(MB_MPUMP_FREQ);
 	portEXIT_CRITICAL();
-	LCD_SetCursor(16*32,32*4+2);
-	LCD_DisplayString(str);
 
-	portENTER_CRITICAL();
-	sprintf(str," %1.2f ",(float)hvsr.cur_fb/10000);
-	portEXIT_CRITICAL();
-	LCD_SetCursor(16*32,32*5+2);
-	LCD_DisplayString(str);
-	
-	portENTER_CRITICAL();
-	sprintf(str," %.2E  ",(float)vmeter/1000);
-	portEXIT_CRITICAL();
-	LCD_SetCursor(16*8,32*6+2);
-	LCD_DisplayString(str);
-
-	portENTER_CRITICAL();
-	sprintf(str," %3d ",usRegInputBuf[MB_MPUMP_FREQ]);
-	portEXIT_CRITICAL();
-	LCD_SetCursor(16*30,32*6+2);
-	LCD_DisplayString(str);
+	for(i=0;i<4;i++){
+		if ( i & 1 )
+			Widget_SetFixed(&wgt_fb[i],fb[i],10000,2,1);
+		else
+			Widget_SetFixed(&wgt_fb[i],fb[i],1000,1,2);
+	}
+	Widget_SetSci(&wgt_vmeter,vm/1000);
+	Widget_SetFixed(&wgt_mpump,mpump,1,0,3);
 }
 
 
 void main_win_msg(HIDMessage* msg)
 {
 	uint8_t dev_code;
-	char str[32];
 	uint32_t i;
 
 	if ( msg->type == HID_WINDOW ){
@@ -184,6 +237,7 @@ void main_win_msg(HIDMessage* msg)
 	} else if ( msg->type == HID_KEYBOARD ) { 
 	} else if ( msg->type == HID_TOUCHSCREEN ) { 
 		uint16_t btn;
+		uint16_t reg;
 
 		if ( msg->id == HID_TC_CALIBRATE ){
 			TouchScreen_Calibrate(1);
@@ -201,118 +255,41 @@ void main_win_msg(HIDMessage* msg)
 				hv_ctrl_flag = btn;
 				
 				if ( hv_set_flag ) {
-					portENTER_CRITICAL();
 					switch( hv_set_flag ){
-					case BTN_HVL_SETV:	
-						if ( btn == BTN_UP )
-							hvsl.vol_set = hvsl.vol_set+100 > hvsl.vol_max ? hvsl.vol_max : hvsl.vol_set+100;
-						else
-							hvsl.vol_set = hvsl.vol_set > 100 ? hvsl.vol_set - 100 : 0;
-						sprintf(str," %2.1f ",(float)hvsl.vol_set/1000);
-						break;
-					case BTN_HVL_SETC:	
-						if ( btn == BTN_UP )
-							hvsl.cur_set = hvsl.cur_set+100 > hvsl.cur_max ? hvsl.cur_max : hvsl.cur_set+100;
-						else
-							hvsl.cur_set = hvsl.cur_set > 100 ? hvsl.cur_set - 100 : 0;
-						sprintf(str," %1.2f ",(float)hvsl.cur_set/10000);
-						break;
-					case BTN_HVR_SETV:	
-						if ( btn == BTN_UP )
-							hvsr.vol_set = hvsr.vol_set+100 > hvsr.vol_max ? hvsr.vol_max : hvsr.vol_set+100;
-						else
-							hvsr.vol_set = hvsr.vol_set > 100 ? hvsr.vol_set - 100 : 0;
-						sprintf(str," %2.1f ",(float)hvsr.vol_set/1000);
-						break;
-					case BTN_HVR_SETC:
-						if ( btn == BTN_UP )
-							hvsr.cur_set = hvsr.cur_set+100 > hvsr.cur_max ? hvsr.cur_max : hvsr.cur_set+100;
-						else
-							hvsr.cur_set = hvsr.cur_set > 100 ? hvsr.cur_set - 100 : 0;
-						sprintf(str," %1.2f ",(float)hvsr.cur_set/10000);
-						break;
+					case BTN_HVL_SETV:	main_win_step_set(MB_VOL_SET_L,hvsl.vol_max,btn);	break;
+					case BTN_HVL_SETC:	main_win_step_set(MB_CUR_SET_L,hvsl.cur_max,btn);	break;
+					case BTN_HVR_SETV:	main_win_step_set(MB_VOL_SET_R,hvsr.vol_max,btn);	break;
+					case BTN_HVR_SETC:	main_win_step_set(MB_CUR_SET_R,hvsr.cur_max,btn);	break;
 					default :	break;
 					}
-					portEXIT_CRITICAL();
-
-					LCD_SetTextColor(Red);
-					LCD_SetCursor(btns[hv_set_flag-1].x,btns[hv_set_flag-1].y);
-					LCD_DisplayString(str);
+					main_win_setpoints();
 				}					
-				LCD_SetTextColor(Red);
-				LCD_SetCursor(btns[btn-1].x,btns[btn-1].y+16);
-				LCD_DisplayString(btns[btn-1].text);
-				LCD_SetTextColor( 0x421F );
+				Widget_SetColor(&wgt_btn[btn-BTN_UP],Red);
 			} else if ( msg->id == HID_TC_UP ){
-				LCD_SetCursor(btns[btn-1].x,btns[btn-1].y+16);
-				LCD_DisplayString(btns[btn-1].text);
+				Widget_SetColor(&wgt_btn[btn-BTN_UP],TEXT_COLOR);
 			}	
 		} else if ( btn == BTN_START_STOP ){
 			if ( msg->id == HID_TC_DOWN ){
-				LCD_SetTextColor(Red);
 				if ( hv_start_stop ){
 					hv_start_stop = 0;
-					LCD_SetCursor(btns[btn-1].x,btns[btn-1].y+16);
-					LCD_DisplayString("   ");
-					portENTER_CRITICAL();
-					usRegHoldingBuf[MB_SYS_AUTOCTL] = SYS_AUTO_EN | SYS_AUTO_OFF;
-					portEXIT_CRITICAL();
+					reg = SYS_AUTO_EN | SYS_AUTO_OFF;
 				} else {
 					hv_start_stop = 1;
-					LCD_SetCursor(btns[btn-1].x,btns[btn-1].y+16);
-					LCD_DisplayString(" ͣ ֹ ");
-					portENTER_CRITICAL();
-					usRegHoldingBuf[MB_SYS_AUTOCTL] = SYS_AUTO_EN | SYS_AUTO_ON;
-					portEXIT_CRITICAL();
+					reg = SYS_AUTO_EN | SYS_AUTO_ON;
 				}
-				LCD_SetTextColor( 0x421F );
+				eMBRegHolding_WriteNotify(MB_SYS_AUTOCTL,&reg,1);
+				main_win_start_stop();
+				Widget_SetColor(&wgt_btn[BTN_START_STOP-BTN_UP],Red);
 				Win_PutWinMsg(MSG_WIN_REFRESH);
 			} else if ( msg->id == HID_TC_UP ){
-				if ( hv_start_stop ){
-					LCD_SetCursor(btns[BTN_START_STOP-1].x,btns[BTN_START_STOP-1].y+16);
-					LCD_DisplayString(" ͣ ֹ ");
-				} else {
-					LCD_SetCursor(btns[BTN_START_STOP-1].x,btns[BTN_START_STOP-1].y+16);
-					LCD_DisplayString("   ");
-				}
+				Widget_SetColor(&wgt_btn[BTN_START_STOP-BTN_UP],TEXT_COLOR);
 			}	
 		} else {
 			if ( msg->id == HID_TC_UP ){
-				if ( hv_set_flag > 0 ){
-					portENTER_CRITICAL();
-					if ( hv_set_flag == BTN_HVL_SETV )
-						sprintf(str," %2.1f ",(float)hvsl.vol_set/1000);
-					else if ( hv_set_flag == BTN_HVL_SETC )
-						sprintf(str," %1.2f ",(float)hvsl.cur_set/10000);
-					else if ( hv_set_flag == BTN_HVR_SETV )
-						sprintf(str," %2.1f ",(float)hvsr.vol_set/1000);
-					else if ( hv_set_flag == BTN_HVR_SETC )
-						sprintf(str," %1.2f ",(float)hvsr.cur_set/10000);
-					portEXIT_CRITICAL();
-					
-					LCD_SetCursor(btns[hv_set_flag-1].x,btns[hv_set_flag-1].y);
-					LCD_DisplayString(str);
-					hv_set_flag = 0;
-				}
-				
-				LCD_SetCursor(btns[BTN_UP-1].x,btns[BTN_UP-1].y+16);
-				LCD_DisplayString(btns[BTN_UP-1].text);
-				LCD_SetCursor(btns[BTN_DOWN-1].x,btns[BTN_DOWN-1].y+16);
-				LCD_DisplayString(btns[BTN_DOWN-1].text);
-
-				if ( hv_start_stop ){
-					LCD_SetCursor(btns[BTN_START_STOP-1].x,btns[BTN_START_STOP-1].y+16);
-					LCD_DisplayString(" ͣ ֹ ");
-				} else {
-					LCD_SetCursor(btns[BTN_START_STOP-1].x,btns[BTN_START_STOP-1].y+16);
-					LCD_DisplayString("   ");
-				}
-				
-				/*LCD_SetCursor(btns[BTN_UP-1].x,btns[BTN_UP-1].y);
-				LCD_DisplayString("       ");
-				LCD_SetCursor(btns[BTN_DOWN-1].x,btns[BTN_DOWN-1].y);
-				LCD_DisplayString("       ");
-				*/
+				hv_set_flag = 0;
+				main_win_setpoints();
+				for(i=0;i<3;i++)
+					Widget_SetColor(&wgt_btn[i],TEXT_COLOR);
 			}
 		}
 	}
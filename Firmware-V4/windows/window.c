@@ -334,6 +334,10 @@ portTASK_FUNCTION( WinTask, pvParameters )
 			refresh_time = xLastWakeTime;
 			Win_PutWinMsg(MSG_WIN_REFRESH);
 		}
+		/* Draws what the window changed in its widgets, or what was left
+		   over when the budget ran out. */
+		if ( pCurWin->psWidgets )
+			Widget_Flush( pCurWin->psWidgets );
 
 		vTaskDelayUntil( &xLastWakeTime, WIN_IDLE_TIME );
 	}
@@ -8,6 +8,7 @@
 #define __window_h__
 
 #include "FreeRTOS.h"
+#include "widget.h"
 
 #define WINDOW_SEC 			100
 #define WIN_REFRESH_TIME 	(configTICK_RATE_HZ/2)
@@ -110,6 +111,7 @@ typedef struct _SWINDOW_{
 	void (*Dispatch)(HIDMessage* msg);
 	psMenuItem psMenu;
 	uint8_t curMenu;
+	psWidget psWidgets;
 } sWindow,*psWindow;
 
 